@@ -5,6 +5,79 @@
 
 namespace jsb
 {
+    namespace
+    {
+        // the embedded bundles decompressed once and shared by all environments (including workers) in this process,
+        // the entries are never removed, so the data can be referenced by the JS strings without copying
+        struct SharedPresetSources
+        {
+            struct Entry
+            {
+                internal::PresetSource source;
+                const char* data;
+                size_t length;
+                bool is_ascii;
+            };
+
+            Mutex mutex;
+            HashMap<String, std::unique_ptr<Entry>> entries;
+
+            static SharedPresetSources& get_shared()
+            {
+                static SharedPresetSources sources;
+                return sources;
+            }
+
+            const Entry* get(const internal::PresetSource& p_source)
+            {
+                MutexLock lock(mutex);
+                if (const HashMap<String, std::unique_ptr<Entry>>::Iterator it = entries.find(p_source.get_filename()); it != entries.end())
+                {
+                    return it->value.get();
+                }
+
+                std::unique_ptr<Entry> entry = std::make_unique<Entry>();
+                entry->source = p_source;
+                entry->data = entry->source.get_data(entry->length);
+                if (!entry->data)
+                {
+                    return nullptr;
+                }
+                entry->is_ascii = true;
+                for (size_t i = 0; i < entry->length; ++i)
+                {
+                    if ((uint8_t) entry->data[i] >= 0x80)
+                    {
+                        entry->is_ascii = false;
+                        break;
+                    }
+                }
+                const Entry* rval = entry.get();
+                entries.insert(p_source.get_filename(), std::move(entry));
+                return rval;
+            }
+        };
+    }
+
+#if JSB_WITH_CODE_CACHE
+    namespace
+    {
+        // the compiled embedded bundles shared by all environments (including workers) in this process,
+        // the data is isolate-independent, so only the first environment pays for compiling them from source.
+        struct PresetCodeCache
+        {
+            Mutex mutex;
+            HashMap<String, Vector<uint8_t>> entries;
+
+            static PresetCodeCache& get_shared()
+            {
+                static PresetCodeCache cache;
+                return cache;
+            }
+        };
+    }
+#endif
+
     bool AMDModuleLoader::load(Environment* p_env, JavaScriptModule& p_module)
     {
         typedef v8::Local<v8::Value> LocalValue;
@@ -76,15 +149,15 @@ namespace jsb
 
     Error AMDModuleLoader::load_source(Environment* p_env, const internal::PresetSource& p_source)
     {
-        size_t len;
-        const char* str = p_source.get_data(len);
-        if (!str) return ERR_FILE_NOT_FOUND;
-        jsb_check(len == (size_t)(int) len);
-        load_source(p_env, str, (int) len, p_source.get_filename(), true);
+        if (!p_source.is_valid()) return ERR_FILE_NOT_FOUND;
+        const SharedPresetSources::Entry* entry = SharedPresetSources::get_shared().get(p_source);
+        if (!entry) return ERR_FILE_NOT_FOUND;
+        jsb_check(entry->length == (size_t)(int) entry->length);
+        load_source(p_env, entry->data, (int) entry->length, p_source.get_filename(), true, true, entry->is_ascii);
         return OK;
     }
 
-    void AMDModuleLoader::load_source(Environment* p_env, const char* p_source, int p_len, const String& p_name, bool p_internal)
+    void AMDModuleLoader::load_source(Environment* p_env, const char* p_source, int p_len, const String& p_name, bool p_internal, bool p_shared_code_cache, bool p_static_one_byte)
     {
         jsb_check(strstr(p_source, "(function(define){") == p_source);
 
@@ -95,7 +168,36 @@ namespace jsb
         v8::Context::Scope context_scope(context);
 
         impl::TryCatch try_catch(isolate);
+#if JSB_WITH_CODE_CACHE
+        v8::MaybeLocal<v8::Value> func_maybe;
+        if (p_shared_code_cache)
+        {
+            PresetCodeCache& shared = PresetCodeCache::get_shared();
+            Vector<uint8_t> cached_data;
+            Vector<uint8_t> new_cached_data;
+            {
+                MutexLock lock(shared.mutex);
+                if (const HashMap<String, Vector<uint8_t>>::Iterator it = shared.entries.find(p_name); it != shared.entries.end())
+                {
+                    cached_data = it->value;
+                }
+            }
+            func_maybe = impl::Helper::compile_function(context, p_source, p_len, p_name, cached_data, &new_cached_data, p_static_one_byte);
+            if (!new_cached_data.is_empty())
+            {
+                MutexLock lock(shared.mutex);
+                shared.entries.insert(p_name, new_cached_data);
+            }
+        }
+        else
+        {
+            func_maybe = impl::Helper::compile_function(context, p_source, p_len, p_name);
+        }
+#else
+        jsb_unused(p_shared_code_cache);
+        jsb_unused(p_static_one_byte);
         const v8::MaybeLocal<v8::Value> func_maybe = impl::Helper::compile_function(context, p_source, p_len, p_name);
+#endif
         if (try_catch.has_caught())
         {
             JSB_LOG(Error, "%s", BridgeHelper::get_exception(try_catch));
@@ -29,8 +29,11 @@ namespace jsb
             internal_ = internal;
         }
 
+        // the embedded presets are decompressed and compiled once per process, and reused by the other environments (see JSB_WITH_CODE_CACHE)
         static Error load_source(Environment* p_env, const internal::PresetSource& p_source);
-        static void load_source(Environment* p_env, const char* p_source, int p_len, const String& p_name, bool p_internal = false);
+
+        // `p_static_one_byte`: the source is pure ASCII and lives until the process exits, V8 references it as an external string
+        static void load_source(Environment* p_env, const char* p_source, int p_len, const String& p_name, bool p_internal = false, bool p_shared_code_cache = false, bool p_static_one_byte = false);
     };
 
 }
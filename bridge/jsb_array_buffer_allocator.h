@@ -24,6 +24,14 @@ namespace jsb
         {
             memfree(data);
         }
+
+        // the allocator is shared by all environments,
+        // because the backing store of a SharedArrayBuffer may outlive the isolate which allocated it.
+        static const std::shared_ptr<ArrayBufferAllocator>& get_shared()
+        {
+            static const std::shared_ptr<ArrayBufferAllocator> allocator = std::make_shared<ArrayBufferAllocator>();
+            return allocator;
+        }
     };
 }
 
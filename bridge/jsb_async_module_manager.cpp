@@ -69,19 +69,80 @@ namespace jsb
         if (!!manager.loader_)
         {
             const v8::Local<v8::Promise::Resolver> resolver = v8::Promise::Resolver::New(context).ToLocalChecked();
-            const AsyncModuleToken token = manager.modules_.add({ module_id, v8::Global<v8::Promise::Resolver>(isolate, resolver) });
+            const AsyncModuleToken token = manager.modules_.add({ module_id, String(), v8::Global<v8::Promise::Resolver>(isolate, resolver) });
             const AsyncModuleHandle handle(env->id(), token);
             
             manager.loader_->import(*env, module_id, handle);
             info.GetReturnValue().Set(resolver->GetPromise());
             return;
         }
-        jsb_throw(isolate, "no async module loader");
+
+        // no async module loader, read the source in background and load it in `update` when it's ready
+        {
+            const v8::Local<v8::Promise::Resolver> resolver = v8::Promise::Resolver::New(context).ToLocalChecked();
+            const AsyncModuleToken token = manager.modules_.add({ module_id, env->prefetch_module(module_id), v8::Global<v8::Promise::Resolver>(isolate, resolver) });
+            manager.prefetching_.push_back(token);
+            info.GetReturnValue().Set(resolver->GetPromise());
+        }
 #else
         jsb_throw(isolate, "not implemented yet");
 #endif
     }
 
+    void AsyncModuleManager::update(Environment* p_env)
+    {
+#if JSB_SUPPORT_ASYNC_MODULE_LOADER
+        if (prefetching_.is_empty())
+        {
+            return;
+        }
+
+        v8::Isolate* isolate = p_env->get_isolate();
+        const Environment::BridgeScope bridge_scope(p_env);
+        const v8::Local<v8::Context> context = p_env->get_context();
+
+        const ModulePrefetcher& prefetcher = p_env->get_module_prefetcher();
+        bool handled = false;
+        for (uint32_t index = 0; index < prefetching_.size(); )
+        {
+            const AsyncModuleToken token = prefetching_[index];
+            v8::Local<v8::Promise::Resolver> resolver;
+            StringName module_id;
+            {
+                MutexLock lock(modules_mutex_);
+                auto pointer = modules_.get_value_scoped(token);
+                if (!prefetcher.is_ready(pointer->asset_path))
+                {
+                    ++index;
+                    continue;
+                }
+                resolver = pointer->resolver.Get(isolate);
+                module_id = pointer->module_id;
+                pointer = nullptr;
+                modules_.remove_at(token);
+            }
+            prefetching_.remove_at_unordered(index);
+            handled = true;
+
+            JavaScriptModule* module;
+            if (p_env->load(module_id, &module) != OK || !module)
+            {
+                // the error has been logged in `load`
+                resolver->Reject(context, impl::Helper::new_string(isolate, jsb_format("failed to load module %s", module_id))).Check();
+                continue;
+            }
+            resolver->Resolve(context, module->module.Get(isolate)).Check();
+        }
+
+        if (handled)
+        {
+            p_env->notify_microtasks_run();
+        }
+#else
+        jsb_unused(p_env);
+#endif
+    }
+
     void AsyncModuleManager::_mark_as_handled(const v8::Local<v8::Context>& p_context, AsyncModuleToken p_token, bool p_is_fulfill, const v8::Local<v8::Value>& p_value)
     {
 #if JSB_SUPPORT_ASYNC_MODULE_LOADER
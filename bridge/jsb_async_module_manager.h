@@ -14,6 +14,9 @@ namespace jsb
         {
             StringName module_id;
 
+            // the source file being prefetched (only if no async module loader is set)
+            String asset_path;
+
 #if JSB_SUPPORT_ASYNC_MODULE_LOADER
             /** a Promise created by `import`. */
             v8::Global<v8::Promise::Resolver> resolver;
@@ -36,6 +39,9 @@ namespace jsb
         
         internal::SArray<ModuleInfo, AsyncModuleToken> modules_;
 
+        // the imports handled by prefetching the modules in background (if no async module loader is set)
+        LocalVector<AsyncModuleToken> prefetching_;
+
     public:
         AsyncModuleManager() = default;
         ~AsyncModuleManager();
@@ -54,6 +60,12 @@ namespace jsb
 
         /** */
         void set_loader(const std::shared_ptr<IAsyncModuleLoader>& p_loader);
+
+        /** [env thread only] complete the imports which are prefetched */
+        void update(Environment* p_env);
+
+        /** [env thread only] whether any import is waiting for prefetching (it can only be polled in `update`) */
+        bool is_prefetching() const { return !prefetching_.is_empty(); }
         
     };
 }
@@ -0,0 +1,99 @@
+#include "jsb_binding_counters.h"
+
+#if JSB_WITH_BINDING_COUNTERS
+#include "jsb_environment.h"
+#include "jsb_shared_variant_info.h"
+
+namespace jsb
+{
+    const char* BindingCounters::get_kind_name(Kind p_kind)
+    {
+        switch (p_kind)
+        {
+        case KIND_METHOD_BIND: return "method";
+        case KIND_PROPERTY_GET: return "get";
+        case KIND_PROPERTY_SET: return "set";
+        case KIND_UTILITY_FUNC: return "utility";
+        case KIND_BUILTIN_METHOD: return "builtin";
+        default: return "unknown";
+        }
+    }
+
+    void BindingCounters::collect(Environment* p_env, LocalVector<Entry>& r_entries) const
+    {
+        const internal::VariantInfoCollection& collection = p_env->get_variant_info_collection();
+        const SharedVariantInfo& shared_info = SharedVariantInfo::get();
+
+        // the shared info only maps names to indices, the counters are mapped back here
+        HashMap<int, String> utility_names;
+        if (!counts_[KIND_UTILITY_FUNC].is_empty())
+        {
+            List<StringName> names;
+            Variant::get_utility_function_list(&names);
+            for (const StringName& name : names)
+            {
+                utility_names.insert(shared_info.find_utility_func_index(name), name);
+            }
+        }
+        HashMap<int, Pair<Variant::Type, StringName>> builtin_names;
+        if (!counts_[KIND_BUILTIN_METHOD].is_empty())
+        {
+            for (int type = Variant::NIL + 1; type < Variant::VARIANT_MAX; ++type)
+            {
+                List<StringName> names;
+                Variant::get_builtin_method_list((Variant::Type) type, &names);
+                for (const StringName& name : names)
+                {
+                    builtin_names.insert(shared_info.find_method_index((Variant::Type) type, name), { (Variant::Type) type, name });
+                }
+            }
+        }
+
+        for (int kind = 0; kind < KIND_NUM; ++kind)
+        {
+            const LocalVector<uint64_t>& counts = counts_[kind];
+            for (uint32_t index = 0; index < counts.size(); ++index)
+            {
+                if (counts[index] == 0) continue;
+                Entry entry = { (Kind) kind, String(), String(), counts[index] };
+                switch (kind)
+                {
+                case KIND_METHOD_BIND:
+                    if (index >= (uint32_t) collection.method_binds.size()) continue;
+                    entry.class_name = collection.method_binds[index].method_bind->get_instance_class();
+                    entry.name = collection.method_binds[index].method_bind->get_name();
+                    break;
+                case KIND_PROPERTY_GET:
+                case KIND_PROPERTY_SET:
+                    {
+                        if (index >= (uint32_t) collection.properties2.size()) continue;
+                        const internal::FPropertyInfo2& property_info = collection.properties2[index];
+                        const MethodBind* method_bind = kind == KIND_PROPERTY_GET ? property_info.getter_func : property_info.setter_func;
+                        entry.class_name = method_bind->get_instance_class();
+                        entry.name = jsb_format("%s(%d)", method_bind->get_name(), property_info.index);
+                    }
+                    break;
+                case KIND_UTILITY_FUNC:
+                    if (const String* name = utility_names.getptr((int) index)) entry.name = *name;
+                    break;
+                case KIND_BUILTIN_METHOD:
+                    if (const Pair<Variant::Type, StringName>* pair = builtin_names.getptr((int) index))
+                    {
+                        entry.class_name = Variant::get_type_name(pair->first);
+                        entry.name = pair->second;
+                    }
+                    break;
+                default: break;
+                }
+                r_entries.push_back(entry);
+            }
+        }
+
+        struct Comparator
+        {
+            bool operator()(const Entry& a, const Entry& b) const { return a.count > b.count; }
+        };
+        r_entries.sort_custom<Comparator>();
+    }
+}
+#endif
@@ -0,0 +1,72 @@
+#ifndef GODOTJS_BINDING_COUNTERS_H
+#define GODOTJS_BINDING_COUNTERS_H
+#include "jsb_bridge_pch.h"
+
+#if JSB_WITH_BINDING_COUNTERS
+#   define JSB_COUNT_BINDING(Env, Kind, Index) (Env)->get_binding_counters().hit(::jsb::BindingCounters::Kind, Index)
+#else
+#   define JSB_COUNT_BINDING(Env, Kind, Index) (void) 0
+#endif
+
+#if JSB_WITH_BINDING_COUNTERS
+namespace jsb
+{
+    class Environment;
+
+    /**
+     * The number of calls through each reflected binding of an environment (see `jsb.get_binding_counters`).
+     * The counters are indexed by the same index carried in `info.Data()` of the callbacks,
+     * so that counting a call is a single increment, the names are only resolved on collecting.
+     */
+    class BindingCounters
+    {
+    public:
+        enum Kind : uint8_t
+        {
+            // methods of godot object classes (including getters/setters of plain properties)
+            KIND_METHOD_BIND,
+            // getters/setters of indexed properties (getter2/setter2)
+            KIND_PROPERTY_GET,
+            KIND_PROPERTY_SET,
+            KIND_UTILITY_FUNC,
+            // methods of Variant types
+            KIND_BUILTIN_METHOD,
+            KIND_NUM,
+        };
+
+        struct Entry
+        {
+            Kind kind;
+            // the owner class (empty for utility functions)
+            String class_name;
+            String name;
+            uint64_t count;
+        };
+
+        jsb_force_inline void hit(Kind p_kind, int32_t p_index)
+        {
+            LocalVector<uint64_t>& counts = counts_[p_kind];
+            if (jsb_unlikely((uint32_t) p_index >= counts.size()))
+            {
+                counts.resize(next_power_of_2((uint32_t) p_index + 1));
+            }
+            ++counts[p_index];
+        }
+
+        void reset()
+        {
+            for (LocalVector<uint64_t>& counts : counts_) counts.clear();
+        }
+
+        // all bindings called at least once, ranked by the number of calls
+        void collect(Environment* p_env, LocalVector<Entry>& r_entries) const;
+
+        static const char* get_kind_name(Kind p_kind);
+
+    private:
+        LocalVector<uint64_t> counts_[KIND_NUM];
+    };
+}
+#endif
+
+#endif
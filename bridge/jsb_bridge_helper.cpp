@@ -82,4 +82,17 @@ namespace jsb
         stacktrace = Environment::wrap(p_catch.get_isolate())->get_source_map_cache().process_source_position(stacktrace, &r_position);
         return stacktrace;
     }
+
+    void BridgeHelper::log_exception(const impl::TryCatch& p_catch, const char* p_title)
+    {
+        if (!internal::Settings::is_async_symbolication())
+        {
+            JSB_LOG(Error, "%s%s", p_title, get_exception(p_catch));
+            return;
+        }
+        String message;
+        String stacktrace;
+        p_catch.get_message(&message, &stacktrace);
+        Environment::wrap(p_catch.get_isolate())->get_source_map_cache().report(p_title + message, stacktrace);
+    }
 }
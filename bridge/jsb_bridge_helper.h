@@ -49,6 +49,9 @@ namespace jsb
 
         // Get stacktrace info from exception
         static String get_stacktrace(const impl::TryCatch& p_catch, internal::SourcePosition& r_position);
+
+        // Log the exception as an error (symbolicated in background if `async_symbolication` enabled)
+        static void log_exception(const impl::TryCatch& p_catch, const char* p_title);
     };
 }
 #endif
@@ -1,6 +1,17 @@
 #include "jsb_bridge_module_loader.h"
 #include "jsb_type_convert.h"
 #include "jsb_editor_utility_funcs.h"
+#include "jsb_bulk_data.h"
+#include "jsb_bulk_math.h"
+#include "jsb_bulk_physics.h"
+#include "jsb_bulk_rendering.h"
+#include "jsb_bulk_transform.h"
+#include "jsb_server_queries.h"
+#include "jsb_file_io.h"
+#include "jsb_instance_pool.h"
+#include "jsb_signal_awaiter.h"
+#include "jsb_threaded_loads.h"
+#include "jsb_input_snapshot.h"
 #include "jsb_callable.h"
 #include "jsb_object_bindings.h"
 
@@ -40,6 +51,7 @@ namespace jsb
             const int argc = info.Length();
             int func_arg_index;
             ObjectID caller_id = {};
+            NativeObjectID caller_handle = {};
             switch (argc)
             {
             case 1:
@@ -54,7 +66,9 @@ namespace jsb
                         return;
                     }
 
-                    caller_id = ((Object*) obj_var)->get_instance_id();
+                    Object* caller = obj_var;
+                    caller_id = caller->get_instance_id();
+                    caller_handle = env->try_get_object_id(caller);
                     func_arg_index = 1;
                 }
                 break;
@@ -71,7 +85,7 @@ namespace jsb
             const EnvironmentID env_id = env->id();
             const v8::Local<v8::Function> js_func = info[func_arg_index].As<v8::Function>();
             const ObjectCacheID callback_id = env->get_cached_function(js_func);
-            const Variant callable = Callable(memnew(JSCallable(caller_id, env_id, callback_id)));
+            const Variant callable = Callable(memnew(JSCallable(caller_id, env_id, callback_id, caller_handle)));
             v8::Local<v8::Value> rval;
             if (!TypeConvert::gd_var_to_js(isolate, context, callable, rval))
             {
@@ -99,6 +113,42 @@ namespace jsb
                 impl::Helper::to_string_opt(isolate, target->Get(context, jsb_name(environment, name))));
         }
 
+        // function add_script_batched(constructor: GObjectConstructor): void;
+        void _add_script_batched(const v8::FunctionCallbackInfo<v8::Value>& info)
+        {
+            v8::Isolate* isolate = info.GetIsolate();
+            v8::HandleScope handle_scope(isolate);
+            v8::Local<v8::Context> context = isolate->GetCurrentContext();
+            if (info.Length() != 1 || !info[0]->IsObject())
+            {
+                jsb_throw(isolate, "bad param");
+                return;
+            }
+            Environment* environment = Environment::wrap(isolate);
+            const v8::Local<v8::Object> target = info[0].As<v8::Object>();
+            target->Set(context, jsb_symbol(environment, ClassBatchedScript), v8::Boolean::New(isolate, true)).Check();
+            JSB_LOG(VeryVerbose, "script %s (batched)",
+                impl::Helper::to_string_opt(isolate, target->Get(context, jsb_name(environment, name))));
+        }
+
+        // function add_script_cached_exports(constructor: GObjectConstructor): void;
+        void _add_script_cached_exports(const v8::FunctionCallbackInfo<v8::Value>& info)
+        {
+            v8::Isolate* isolate = info.GetIsolate();
+            v8::HandleScope handle_scope(isolate);
+            v8::Local<v8::Context> context = isolate->GetCurrentContext();
+            if (info.Length() != 1 || !info[0]->IsObject())
+            {
+                jsb_throw(isolate, "bad param");
+                return;
+            }
+            Environment* environment = Environment::wrap(isolate);
+            const v8::Local<v8::Object> target = info[0].As<v8::Object>();
+            target->Set(context, jsb_symbol(environment, ClassCachedExports), v8::Boolean::New(isolate, true)).Check();
+            JSB_LOG(VeryVerbose, "script %s (cached exports)",
+                impl::Helper::to_string_opt(isolate, target->Get(context, jsb_name(environment, name))));
+        }
+
         template <typename Lambda>
         constexpr void _return_result(const v8::FunctionCallbackInfo<v8::Value>& info, Variant::Type type, Variant& identifier, Lambda get_result)
         {
@@ -179,6 +229,179 @@ namespace jsb
             environment->notify_microtasks_run();
         }
 
+        // the names of console severities in the order of ELogSeverity (starting from VeryVerbose)
+        constexpr const char* kConsoleSeverityNames[] = { "all", "verbose", "debug", "info", "log", "trace", "warning", "error" };
+
+        // function set_console_min_severity(severity: ConsoleSeverity): void;
+        void _set_console_min_severity(const v8::FunctionCallbackInfo<v8::Value>& info)
+        {
+            v8::Isolate* isolate = info.GetIsolate();
+            const String name = impl::Helper::to_string(isolate, info[0]);
+            for (int index = 0; index < (int) std::size(kConsoleSeverityNames); ++index)
+            {
+                if (name == kConsoleSeverityNames[index])
+                {
+                    Environment::wrap(isolate)->set_console_min_severity((internal::ELogSeverity::Type) (internal::ELogSeverity::VeryVerbose + index));
+                    return;
+                }
+            }
+            jsb_throw(isolate, "unknown console severity");
+        }
+
+#if JSB_WITH_TRACE_EVENTS
+        void _trace_events_start(const v8::FunctionCallbackInfo<v8::Value>& info)
+        {
+            internal::TraceEvents::start();
+        }
+
+        void _trace_events_stop(const v8::FunctionCallbackInfo<v8::Value>& info)
+        {
+            internal::TraceEvents::stop();
+        }
+
+        // function save(path: string): boolean;
+        void _trace_events_save(const v8::FunctionCallbackInfo<v8::Value>& info)
+        {
+            v8::Isolate* isolate = info.GetIsolate();
+            const String path = impl::Helper::to_string(isolate, info[0]);
+            if (path.is_empty())
+            {
+                jsb_throw(isolate, "bad path");
+                return;
+            }
+            info.GetReturnValue().Set(v8::Boolean::New(isolate, internal::TraceEvents::save(path) == OK));
+        }
+#endif
+
+#if JSB_BENCHMARK
+        // function get_benchmark_scopes(): BenchmarkScope[];
+        void _get_benchmark_scopes(const v8::FunctionCallbackInfo<v8::Value>& info)
+        {
+            v8::Isolate* isolate = info.GetIsolate();
+            const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+            LocalVector<internal::BenchmarkSite::Snapshot> snapshots;
+            internal::BenchmarkSite::collect(snapshots);
+
+            const v8::Local<v8::Array> array = v8::Array::New(isolate, (int) snapshots.size());
+            for (uint32_t index = 0; index < snapshots.size(); ++index)
+            {
+                const internal::BenchmarkSite::Snapshot& snapshot = snapshots[index];
+                const v8::Local<v8::Object> item = v8::Object::New(isolate);
+                item->Set(context, impl::Helper::new_string_ascii(isolate, "name"), impl::Helper::new_string(isolate, snapshot.name)).Check();
+                item->Set(context, impl::Helper::new_string_ascii(isolate, "parent"), v8::Int32::New(isolate, snapshot.parent)).Check();
+                item->Set(context, impl::Helper::new_string_ascii(isolate, "depth"), v8::Int32::New(isolate, snapshot.depth)).Check();
+                item->Set(context, impl::Helper::new_string_ascii(isolate, "count"), v8::Number::New(isolate, (double) snapshot.count)).Check();
+                item->Set(context, impl::Helper::new_string_ascii(isolate, "total_usec"), v8::Number::New(isolate, (double) snapshot.total_usec)).Check();
+                item->Set(context, impl::Helper::new_string_ascii(isolate, "max_usec"), v8::Number::New(isolate, (double) snapshot.max_usec)).Check();
+                item->Set(context, impl::Helper::new_string_ascii(isolate, "p99_usec"), v8::Number::New(isolate, (double) snapshot.p99_usec)).Check();
+                array->Set(context, index, item).Check();
+            }
+            info.GetReturnValue().Set(array);
+        }
+#endif
+
+#if JSB_WITH_BINDING_COUNTERS
+        // function get_binding_counters(limit?: number, reset?: boolean): BindingCounter[];
+        void _get_binding_counters(const v8::FunctionCallbackInfo<v8::Value>& info)
+        {
+            v8::Isolate* isolate = info.GetIsolate();
+            const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+            Environment* env = Environment::wrap(isolate);
+            LocalVector<BindingCounters::Entry> entries;
+            env->get_binding_counters().collect(env, entries);
+            if (info.Length() > 1 && info[1]->BooleanValue(isolate))
+            {
+                env->get_binding_counters().reset();
+            }
+
+            uint32_t num = entries.size();
+            if (info.Length() > 0 && info[0]->IsNumber())
+            {
+                num = MIN(num, (uint32_t) MAX(0, info[0]->Int32Value(context).FromMaybe(0)));
+            }
+            const v8::Local<v8::Array> array = v8::Array::New(isolate, (int) num);
+            for (uint32_t index = 0; index < num; ++index)
+            {
+                const BindingCounters::Entry& entry = entries[index];
+                const v8::Local<v8::Object> item = v8::Object::New(isolate);
+                item->Set(context, impl::Helper::new_string_ascii(isolate, "kind"), impl::Helper::new_string_ascii(isolate, BindingCounters::get_kind_name(entry.kind))).Check();
+                item->Set(context, impl::Helper::new_string_ascii(isolate, "class_name"), impl::Helper::new_string(isolate, entry.class_name)).Check();
+                item->Set(context, impl::Helper::new_string_ascii(isolate, "name"), impl::Helper::new_string(isolate, entry.name)).Check();
+                item->Set(context, impl::Helper::new_string_ascii(isolate, "count"), v8::Number::New(isolate, (double) entry.count)).Check();
+                array->Set(context, index, item).Check();
+            }
+            info.GetReturnValue().Set(array);
+        }
+#endif
+
+        // function prewarm_classes(class_names?: string[], budget_usec?: number): number;
+        void _prewarm_classes(const v8::FunctionCallbackInfo<v8::Value>& info)
+        {
+            v8::Isolate* isolate = info.GetIsolate();
+            const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+            Environment* environment = Environment::wrap(isolate);
+            if (info.Length() > 0 && !info[0]->IsUndefined())
+            {
+                if (!info[0]->IsArray())
+                {
+                    jsb_throw(isolate, "bad class names");
+                    return;
+                }
+                const v8::Local<v8::Array> names_val = info[0].As<v8::Array>();
+                PackedStringArray class_names;
+                for (uint32_t index = 0, len = names_val->Length(); index < len; ++index)
+                {
+                    v8::Local<v8::Value> item;
+                    if (!names_val->Get(context, index).ToLocal(&item) || !item->IsString())
+                    {
+                        jsb_throw(isolate, "bad class name");
+                        return;
+                    }
+                    class_names.push_back(impl::Helper::to_string(isolate, item));
+                }
+                environment->prewarm_classes(class_names);
+            }
+            const int64_t budget_usec = info.Length() > 1 && info[1]->IsNumber() ? (int64_t) info[1].As<v8::Number>()->Value() : 0;
+            info.GetReturnValue().Set(v8::Int32::New(isolate, environment->flush_prewarm_classes((uint64_t) MAX(budget_usec, (int64_t) 0))));
+        }
+
+        // function preload(path: string, type_hint?: string): Resource;
+        void _preload(const v8::FunctionCallbackInfo<v8::Value>& info)
+        {
+            v8::Isolate* isolate = info.GetIsolate();
+            const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+            if (info.Length() == 0 || !info[0]->IsString())
+            {
+                jsb_throw(isolate, "bad path");
+                return;
+            }
+            const String path = impl::Helper::to_string(isolate, info[0]);
+            const String type_hint = info.Length() > 1 && info[1]->IsString() ? impl::Helper::to_string(isolate, info[1]) : String();
+
+            Error err;
+            const Ref<Resource> resource = Environment::wrap(isolate)->get_resource_cache().get(path, type_hint, err);
+            if (err != OK)
+            {
+                impl::Helper::throw_error(isolate, jsb_format("failed to preload %s (%s)", path, jsb_ext_error_string(err)));
+                return;
+            }
+            v8::Local<v8::Value> rval;
+            if (!TypeConvert::gd_var_to_js(isolate, context, resource, rval))
+            {
+                jsb_throw(isolate, "bad resource");
+                return;
+            }
+            info.GetReturnValue().Set(rval);
+        }
+
+        // function get_console_min_severity(): ConsoleSeverity;
+        void _get_console_min_severity(const v8::FunctionCallbackInfo<v8::Value>& info)
+        {
+            v8::Isolate* isolate = info.GetIsolate();
+            const int index = Environment::wrap(isolate)->get_console_min_severity() - internal::ELogSeverity::VeryVerbose;
+            info.GetReturnValue().Set(impl::Helper::new_string_ascii(isolate, kConsoleSeverityNames[CLAMP(index, 0, (int) std::size(kConsoleSeverityNames) - 1)]));
+        }
+
         // function add_script_rpc(prototype: GObject, property_key: string, config: {
         //     rpc_mode?: MultiplayerAPI.RPCMode,
         //     call_local?: boolean,
@@ -565,6 +788,16 @@ namespace jsb
             jsb_obj->Set(context, impl::Helper::new_string_ascii(isolate, "to_array_buffer"), JSB_NEW_FUNCTION(context, _to_array_buffer, {})).Check();
             jsb_obj->Set(context, impl::Helper::new_string_ascii(isolate, "set_async_module_loader"), JSB_NEW_FUNCTION(context, AsyncModuleManager::_set_async_module_loader, {})).Check();
             jsb_obj->Set(context, impl::Helper::new_string_ascii(isolate, "$import"), JSB_NEW_FUNCTION(context, AsyncModuleManager::_import, {})).Check();
+            jsb_obj->Set(context, impl::Helper::new_string_ascii(isolate, "set_console_min_severity"), JSB_NEW_FUNCTION(context, _set_console_min_severity, {})).Check();
+            jsb_obj->Set(context, impl::Helper::new_string_ascii(isolate, "get_console_min_severity"), JSB_NEW_FUNCTION(context, _get_console_min_severity, {})).Check();
+            jsb_obj->Set(context, impl::Helper::new_string_ascii(isolate, "prewarm_classes"), JSB_NEW_FUNCTION(context, _prewarm_classes, {})).Check();
+            jsb_obj->Set(context, impl::Helper::new_string_ascii(isolate, "preload"), JSB_NEW_FUNCTION(context, _preload, {})).Check();
+#if JSB_BENCHMARK
+            jsb_obj->Set(context, impl::Helper::new_string_ascii(isolate, "get_benchmark_scopes"), JSB_NEW_FUNCTION(context, _get_benchmark_scopes, {})).Check();
+#endif
+#if JSB_WITH_BINDING_COUNTERS
+            jsb_obj->Set(context, impl::Helper::new_string_ascii(isolate, "get_binding_counters"), JSB_NEW_FUNCTION(context, _get_binding_counters, {})).Check();
+#endif
 
             // jsb.internal
             {
@@ -579,6 +812,8 @@ namespace jsb
                 internal_obj->Set(context, impl::Helper::new_string_ascii(isolate, "add_script_property"), JSB_NEW_FUNCTION(context, _add_script_property, {})).Check();
                 internal_obj->Set(context, impl::Helper::new_string_ascii(isolate, "add_script_ready"), JSB_NEW_FUNCTION(context, _add_script_ready, {})).Check();
                 internal_obj->Set(context, impl::Helper::new_string_ascii(isolate, "add_script_tool"), JSB_NEW_FUNCTION(context, _add_script_tool, {})).Check();
+                internal_obj->Set(context, impl::Helper::new_string_ascii(isolate, "add_script_batched"), JSB_NEW_FUNCTION(context, _add_script_batched, {})).Check();
+                internal_obj->Set(context, impl::Helper::new_string_ascii(isolate, "add_script_cached_exports"), JSB_NEW_FUNCTION(context, _add_script_cached_exports, {})).Check();
                 internal_obj->Set(context, impl::Helper::new_string_ascii(isolate, "add_script_icon"), JSB_NEW_FUNCTION(context, _add_script_icon, {})).Check();
                 internal_obj->Set(context, impl::Helper::new_string_ascii(isolate, "add_script_rpc"), JSB_NEW_FUNCTION(context, _add_script_rpc, {})).Check();
                 internal_obj->Set(context, impl::Helper::new_string_ascii(isolate, "set_script_doc"), JSB_NEW_FUNCTION(context, _set_script_doc, {})).Check();
@@ -603,6 +838,55 @@ namespace jsb
                 }
             }
 
+#if JSB_WITH_TRACE_EVENTS
+            // 'jsb.trace_events'
+            {
+                v8::Local<v8::Object> trace_obj = v8::Object::New(isolate);
+
+                jsb_obj->Set(context, impl::Helper::new_string_ascii(isolate, "trace_events"), trace_obj).Check();
+                trace_obj->Set(context, impl::Helper::new_string_ascii(isolate, "start"), JSB_NEW_FUNCTION(context, _trace_events_start, {})).Check();
+                trace_obj->Set(context, impl::Helper::new_string_ascii(isolate, "stop"), JSB_NEW_FUNCTION(context, _trace_events_stop, {})).Check();
+                trace_obj->Set(context, impl::Helper::new_string_ascii(isolate, "save"), JSB_NEW_FUNCTION(context, _trace_events_save, {})).Check();
+            }
+#endif
+
+            // 'jsb.math'
+            BulkMath::expose(isolate, context, jsb_obj);
+
+            // 'jsb.data'
+            BulkData::expose(isolate, context, jsb_obj);
+
+#if !JSB_WITH_WEB
+            // 'jsb.physics'
+            BulkPhysics::expose(isolate, context, jsb_obj);
+
+            // 'jsb.rendering'
+            BulkRendering::expose(isolate, context, jsb_obj);
+
+            // 'jsb.transforms'
+            BulkTransform::expose(isolate, context, jsb_obj);
+
+            // 'jsb.servers'
+            ServerQueries::expose(isolate, context, jsb_obj);
+
+            // 'jsb.fs'
+            AsyncFileIO::expose(isolate, context, jsb_obj);
+#endif
+
+            // 'jsb.pool'
+            InstancePool::expose(isolate, context, jsb_obj);
+
+            // 'jsb.await_signal', 'jsb.next_frame', 'jsb.next_physics_frame'
+            SignalAwaiter::expose(isolate, context, jsb_obj);
+
+            // 'jsb.load_threaded'
+            ThreadedLoads::expose(isolate, context, jsb_obj);
+
+#if !JSB_WITH_WEB
+            // 'jsb.input'
+            InputSnapshots::expose(isolate, context, jsb_obj);
+#endif
+
             // internal 'jsb.editor'
             EditorUtilityFuncs::expose(isolate, context, jsb_obj);
         }
@@ -2,8 +2,11 @@
 #define GODOTJS_PCH_H
 
 #include <memory>
+#include <optional>
 #include <cstdint>
 #include <unordered_map>
+#include <condition_variable>
+#include <thread>
 
 #include "../jsb.config.h"
 #include "../jsb.gen.h"
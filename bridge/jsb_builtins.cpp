@@ -56,40 +56,57 @@ namespace jsb
         }
     }
 
-    void Builtins::_require(const v8::FunctionCallbackInfo<v8::Value>& info)
+    namespace
     {
-        JSB_BENCHMARK_SCOPE(JSRealm, _require);
-        v8::Isolate* isolate = info.GetIsolate();
-        v8::Local<v8::Context> context = isolate->GetCurrentContext();
-
-        if (info.Length() != 1)
+        void require_module(const v8::FunctionCallbackInfo<v8::Value>& info, const v8::Local<v8::Value>& p_parent, const v8::Local<v8::Value>& p_module)
         {
-            jsb_throw(isolate, "bad argument");
-            return;
+            v8::Isolate* isolate = info.GetIsolate();
+            v8::Local<v8::Context> context = isolate->GetCurrentContext();
+
+            if (!p_module->IsString())
+            {
+                jsb_throw(isolate, "bad argument");
+                return;
+            }
+
+            const String parent_id = impl::Helper::to_string(isolate, p_parent);
+            const String module_id = impl::Helper::to_string(isolate, p_module);
+            Environment* env = Environment::wrap(context);
+
+            // the impl should return an empty string for null or undefined value
+            jsb_check(!p_parent->IsNullOrUndefined() || parent_id.is_empty());
+
+            if (const JavaScriptModule* module = env->_load_module(parent_id, module_id))
+            {
+                info.GetReturnValue().Set(module->exports);
+                return;
+            }
+            JSB_LOG(Error, "can not load module '%s' (with parent '%s')", module_id, parent_id);
         }
+    }
 
-        const v8::Local<v8::Value> arg0 = info[0];
-        if (!arg0->IsString())
+    void Builtins::_require(const v8::FunctionCallbackInfo<v8::Value>& info)
+    {
+        JSB_BENCHMARK_SCOPE(JSRealm, _require);
+        if (info.Length() != 1)
         {
-            jsb_throw(isolate, "bad argument");
+            jsb_throw(info.GetIsolate(), "bad argument");
             return;
         }
 
         // read parent module id from magic data
-        const String parent_id = impl::Helper::to_string(isolate, info.Data());
-        const String module_id = impl::Helper::to_string(isolate, arg0);
-        Environment* env = Environment::wrap(context);
-
-        // the impl should return an empty string for null or undefined value
-        jsb_check(!info.Data()->IsNullOrUndefined() || parent_id.is_empty());
-        jsb_check(!arg0->IsNullOrUndefined() || module_id.is_empty());
+        require_module(info, info.Data(), info[0]);
+    }
 
-        if (const JavaScriptModule* module = env->_load_module(parent_id, module_id))
+    void Builtins::_require_from(const v8::FunctionCallbackInfo<v8::Value>& info)
+    {
+        JSB_BENCHMARK_SCOPE(JSRealm, _require);
+        if (info.Length() != 2 || !info[0]->IsString())
         {
-            info.GetReturnValue().Set(module->exports);
+            jsb_throw(info.GetIsolate(), "bad argument");
             return;
         }
-        JSB_LOG(Error, "can not load module '%s' (with parent '%s')", module_id, parent_id);
+        require_module(info, info[0], info[1]);
     }
 
 }
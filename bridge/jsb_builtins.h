@@ -8,6 +8,9 @@ namespace jsb
     {
     public:
         static void _require(const v8::FunctionCallbackInfo<v8::Value>& info);
+
+        // `load(parent_id, module_id)`, shared by the `require` closures of all modules (see `Environment::_new_require_func`)
+        static void _require_from(const v8::FunctionCallbackInfo<v8::Value>& info);
         static void _define(const v8::FunctionCallbackInfo<v8::Value>& info);
 
     };
@@ -0,0 +1,147 @@
+#include "jsb_bulk_data.h"
+#include "jsb_type_convert.h"
+
+#include "core/io/marshalls.h"
+
+namespace jsb
+{
+    namespace
+    {
+        // [js] function parse_json(text: string | ArrayBuffer): any;
+        void _parse_json(const v8::FunctionCallbackInfo<v8::Value>& info)
+        {
+            v8::Isolate* isolate = info.GetIsolate();
+            const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+            v8::Local<v8::Value> rval;
+            if (info[0]->IsString())
+            {
+                const CharString text = impl::Helper::to_string(isolate, info[0]).utf8();
+                if (!impl::Helper::parse_json(isolate, context, (const uint8_t*) text.ptr(), (size_t) text.length()).ToLocal(&rval))
+                {
+                    // the error thrown by the parser is kept
+                    return;
+                }
+            }
+#if !JSB_WITH_WEB
+            else if (info[0]->IsArrayBuffer())
+            {
+                // a terminated copy is required by the parser
+                const v8::Local<v8::ArrayBuffer> buffer = info[0].As<v8::ArrayBuffer>();
+                const size_t len = buffer->ByteLength();
+                internal::ScratchArena::Scope scratch;
+                uint8_t* text = scratch.alloc<uint8_t>(len + 1);
+                if (len) memcpy(text, buffer->Data(), len);
+                text[len] = 0;
+                if (!impl::Helper::parse_json(isolate, context, text, len).ToLocal(&rval))
+                {
+                    return;
+                }
+            }
+#endif
+            else
+            {
+                jsb_throw(isolate, "string or ArrayBuffer expected at 0");
+                return;
+            }
+            info.GetReturnValue().Set(rval);
+        }
+
+        // [js] function to_variant(value: any): any;
+        void _to_variant(const v8::FunctionCallbackInfo<v8::Value>& info)
+        {
+            v8::Isolate* isolate = info.GetIsolate();
+            const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+            Variant value;
+            v8::Local<v8::Value> rval;
+            if (!TypeConvert::js_to_gd_var_deep(isolate, context, info[0], value)
+                || !TypeConvert::gd_var_to_js(isolate, context, value, rval))
+            {
+                jsb_throw(isolate, "bad value at 0");
+                return;
+            }
+            info.GetReturnValue().Set(rval);
+        }
+
+        // [js] function from_variant(value: any): any;
+        void _from_variant(const v8::FunctionCallbackInfo<v8::Value>& info)
+        {
+            v8::Isolate* isolate = info.GetIsolate();
+            const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+            Variant value;
+            v8::Local<v8::Value> rval;
+            if (!TypeConvert::js_to_gd_var(isolate, context, info[0], value)
+                || !TypeConvert::gd_var_to_js_deep(isolate, context, value, rval))
+            {
+                jsb_throw(isolate, "bad value at 0");
+                return;
+            }
+            info.GetReturnValue().Set(rval);
+        }
+
+#if !JSB_WITH_WEB
+        // [js] function var_to_bytes(value: any, full_objects?: boolean): ArrayBuffer;
+        void _var_to_bytes(const v8::FunctionCallbackInfo<v8::Value>& info)
+        {
+            v8::Isolate* isolate = info.GetIsolate();
+            const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+            Variant value;
+            if (!TypeConvert::js_to_gd_var_deep(isolate, context, info[0], value))
+            {
+                jsb_throw(isolate, "bad value at 0");
+                return;
+            }
+            const bool full_objects = info.Length() > 1 && info[1]->BooleanValue(isolate);
+            int len = 0;
+            if (encode_variant(value, nullptr, len, full_objects) != OK)
+            {
+                jsb_throw(isolate, "failed to encode the value");
+                return;
+            }
+            const v8::Local<v8::ArrayBuffer> buffer = v8::ArrayBuffer::New(isolate, len);
+            if (len) encode_variant(value, (uint8_t*) buffer->Data(), len, full_objects);
+            info.GetReturnValue().Set(buffer);
+        }
+
+        // [js] function bytes_to_var(buffer: ArrayBuffer, allow_objects?: boolean): any;
+        void _bytes_to_var(const v8::FunctionCallbackInfo<v8::Value>& info)
+        {
+            v8::Isolate* isolate = info.GetIsolate();
+            const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+            if (!info[0]->IsArrayBuffer())
+            {
+                jsb_throw(isolate, "ArrayBuffer expected at 0");
+                return;
+            }
+            const v8::Local<v8::ArrayBuffer> buffer = info[0].As<v8::ArrayBuffer>();
+            const bool allow_objects = info.Length() > 1 && info[1]->BooleanValue(isolate);
+            Variant value;
+            v8::Local<v8::Value> rval;
+            if (decode_variant(value, (const uint8_t*) buffer->Data(), (int) buffer->ByteLength(), nullptr, allow_objects) != OK)
+            {
+                jsb_throw(isolate, "failed to decode the buffer");
+                return;
+            }
+            if (!TypeConvert::gd_var_to_js_deep(isolate, context, value, rval))
+            {
+                jsb_throw(isolate, "failed to convert the decoded value");
+                return;
+            }
+            info.GetReturnValue().Set(rval);
+        }
+#endif
+    }
+
+    void BulkData::expose(v8::Isolate* isolate, v8::Local<v8::Context> context, v8::Local<v8::Object> jsb_obj)
+    {
+        v8::Local<v8::Object> data_obj = v8::Object::New(isolate);
+
+        jsb_obj->Set(context, impl::Helper::new_string_ascii(isolate, "data"), data_obj).Check();
+        data_obj->Set(context, impl::Helper::new_string_ascii(isolate, "parse_json"), JSB_NEW_FUNCTION(context, _parse_json, {})).Check();
+        data_obj->Set(context, impl::Helper::new_string_ascii(isolate, "to_variant"), JSB_NEW_FUNCTION(context, _to_variant, {})).Check();
+        data_obj->Set(context, impl::Helper::new_string_ascii(isolate, "from_variant"), JSB_NEW_FUNCTION(context, _from_variant, {})).Check();
+#if !JSB_WITH_WEB
+        data_obj->Set(context, impl::Helper::new_string_ascii(isolate, "var_to_bytes"), JSB_NEW_FUNCTION(context, _var_to_bytes, {})).Check();
+        data_obj->Set(context, impl::Helper::new_string_ascii(isolate, "bytes_to_var"), JSB_NEW_FUNCTION(context, _bytes_to_var, {})).Check();
+#endif
+    }
+}
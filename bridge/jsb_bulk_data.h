@@ -0,0 +1,13 @@
+#ifndef GODOTJS_BULK_DATA_H
+#define GODOTJS_BULK_DATA_H
+#include "jsb_bridge_pch.h"
+
+namespace jsb
+{
+    // JSON and binary serialized data (`jsb.data`), converted between JS values and Dictionary/Array in one native pass
+    struct BulkData
+    {
+        static void expose(v8::Isolate* isolate, v8::Local<v8::Context> context, v8::Local<v8::Object> jsb_obj);
+    };
+}
+#endif
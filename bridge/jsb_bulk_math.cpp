@@ -0,0 +1,233 @@
+#include "jsb_bulk_math.h"
+#include "jsb_type_convert.h"
+
+namespace jsb
+{
+    namespace
+    {
+        // the element loops are kept branch-free over the raw storage so that they're auto-vectorized by the compiler
+
+        template<typename TVector, typename TTransform>
+        void transform_points_impl(const TTransform& p_xform, const TVector* p_src, TVector* p_dst, int64_t p_count)
+        {
+            for (int64_t i = 0; i < p_count; ++i)
+            {
+                p_dst[i] = p_xform.xform(p_src[i]);
+            }
+        }
+
+        template<typename TVector>
+        void lerp_impl(const TVector* p_from, const TVector* p_to, real_t p_weight, TVector* p_dst, int64_t p_count)
+        {
+            for (int64_t i = 0; i < p_count; ++i)
+            {
+                p_dst[i] = p_from[i] + (p_to[i] - p_from[i]) * p_weight;
+            }
+        }
+
+        template<typename TVector>
+        void distances_impl(const TVector* p_src, const TVector& p_point, float* p_dst, int64_t p_count)
+        {
+            for (int64_t i = 0; i < p_count; ++i)
+            {
+                p_dst[i] = (float) p_src[i].distance_to(p_point);
+            }
+        }
+
+        template<typename TVector>
+        void bounds_impl(const TVector* p_src, int64_t p_count, TVector& r_min, TVector& r_max)
+        {
+            r_min = r_max = p_src[0];
+            for (int64_t i = 1; i < p_count; ++i)
+            {
+                r_min = r_min.min(p_src[i]);
+                r_max = r_max.max(p_src[i]);
+            }
+        }
+
+        // the packed array is shared with the JS value if it's already a Variant of the expected type (no copy until written)
+        bool get_arg(v8::Isolate* isolate, const v8::Local<v8::Context>& context, const v8::FunctionCallbackInfo<v8::Value>& info, int p_index, Variant::Type p_type, Variant& r_value)
+        {
+            if (!TypeConvert::js_to_gd_var(isolate, context, info[p_index], p_type, r_value))
+            {
+                jsb_throw(isolate, jsb_format("bad param at %d", p_index));
+                return false;
+            }
+            return true;
+        }
+
+        void set_return(v8::Isolate* isolate, const v8::Local<v8::Context>& context, const v8::FunctionCallbackInfo<v8::Value>& info, const Variant& p_value)
+        {
+            v8::Local<v8::Value> rval;
+            if (!TypeConvert::gd_var_to_js(isolate, context, p_value, rval))
+            {
+                jsb_throw(isolate, "failed to translate return value");
+                return;
+            }
+            info.GetReturnValue().Set(rval);
+        }
+
+        // [js] function transform_points(xform: Transform3D, points: PackedVector3Array): PackedVector3Array;
+        // [js] function transform_points(xform: Transform2D, points: PackedVector2Array): PackedVector2Array;
+        void _transform_points(const v8::FunctionCallbackInfo<v8::Value>& info)
+        {
+            v8::Isolate* isolate = info.GetIsolate();
+            const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+            Variant xform;
+            if (!TypeConvert::js_to_gd_var(isolate, context, info[0], xform))
+            {
+                jsb_throw(isolate, "bad param at 0");
+                return;
+            }
+
+            Variant points;
+            if (xform.get_type() == Variant::TRANSFORM3D)
+            {
+                if (!get_arg(isolate, context, info, 1, Variant::PACKED_VECTOR3_ARRAY, points)) return;
+                const PackedVector3Array& src = *VariantInternal::get_vector3_array(&points);
+                PackedVector3Array dst;
+                dst.resize(src.size());
+                transform_points_impl(*VariantInternal::get_transform(&xform), src.ptr(), dst.ptrw(), src.size());
+                set_return(isolate, context, info, dst);
+                return;
+            }
+            if (xform.get_type() == Variant::TRANSFORM2D)
+            {
+                if (!get_arg(isolate, context, info, 1, Variant::PACKED_VECTOR2_ARRAY, points)) return;
+                const PackedVector2Array& src = *VariantInternal::get_vector2_array(&points);
+                PackedVector2Array dst;
+                dst.resize(src.size());
+                transform_points_impl(*VariantInternal::get_transform2d(&xform), src.ptr(), dst.ptrw(), src.size());
+                set_return(isolate, context, info, dst);
+                return;
+            }
+            jsb_throw(isolate, "Transform3D or Transform2D expected");
+        }
+
+        // [js] function lerp_arrays<T extends PackedVector2Array | PackedVector3Array>(from: T, to: T, weight: number): T;
+        void _lerp_arrays(const v8::FunctionCallbackInfo<v8::Value>& info)
+        {
+            v8::Isolate* isolate = info.GetIsolate();
+            const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+            Variant from;
+            if (!TypeConvert::js_to_gd_var(isolate, context, info[0], from))
+            {
+                jsb_throw(isolate, "bad param at 0");
+                return;
+            }
+            double weight;
+            if (!info[2]->NumberValue(context).To(&weight))
+            {
+                jsb_throw(isolate, "bad param at 2");
+                return;
+            }
+
+            Variant to;
+            if (!get_arg(isolate, context, info, 1, from.get_type(), to)) return;
+            if (from.get_type() == Variant::PACKED_VECTOR3_ARRAY)
+            {
+                const PackedVector3Array& a = *VariantInternal::get_vector3_array(&from);
+                const PackedVector3Array& b = *VariantInternal::get_vector3_array(&to);
+                if (a.size() != b.size()) { jsb_throw(isolate, "arrays of different sizes"); return; }
+                PackedVector3Array dst;
+                dst.resize(a.size());
+                lerp_impl(a.ptr(), b.ptr(), (real_t) weight, dst.ptrw(), a.size());
+                set_return(isolate, context, info, dst);
+                return;
+            }
+            if (from.get_type() == Variant::PACKED_VECTOR2_ARRAY)
+            {
+                const PackedVector2Array& a = *VariantInternal::get_vector2_array(&from);
+                const PackedVector2Array& b = *VariantInternal::get_vector2_array(&to);
+                if (a.size() != b.size()) { jsb_throw(isolate, "arrays of different sizes"); return; }
+                PackedVector2Array dst;
+                dst.resize(a.size());
+                lerp_impl(a.ptr(), b.ptr(), (real_t) weight, dst.ptrw(), a.size());
+                set_return(isolate, context, info, dst);
+                return;
+            }
+            jsb_throw(isolate, "PackedVector3Array or PackedVector2Array expected");
+        }
+
+        // [js] function distances_to(points: PackedVector3Array, point: Vector3): PackedFloat32Array;
+        // [js] function distances_to(points: PackedVector2Array, point: Vector2): PackedFloat32Array;
+        void _distances_to(const v8::FunctionCallbackInfo<v8::Value>& info)
+        {
+            v8::Isolate* isolate = info.GetIsolate();
+            const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+            Variant points;
+            if (!TypeConvert::js_to_gd_var(isolate, context, info[0], points))
+            {
+                jsb_throw(isolate, "bad param at 0");
+                return;
+            }
+
+            Variant point;
+            PackedFloat32Array dst;
+            if (points.get_type() == Variant::PACKED_VECTOR3_ARRAY)
+            {
+                if (!get_arg(isolate, context, info, 1, Variant::VECTOR3, point)) return;
+                const PackedVector3Array& src = *VariantInternal::get_vector3_array(&points);
+                dst.resize(src.size());
+                distances_impl(src.ptr(), *VariantInternal::get_vector3(&point), dst.ptrw(), src.size());
+                set_return(isolate, context, info, dst);
+                return;
+            }
+            if (points.get_type() == Variant::PACKED_VECTOR2_ARRAY)
+            {
+                if (!get_arg(isolate, context, info, 1, Variant::VECTOR2, point)) return;
+                const PackedVector2Array& src = *VariantInternal::get_vector2_array(&points);
+                dst.resize(src.size());
+                distances_impl(src.ptr(), *VariantInternal::get_vector2(&point), dst.ptrw(), src.size());
+                set_return(isolate, context, info, dst);
+                return;
+            }
+            jsb_throw(isolate, "PackedVector3Array or PackedVector2Array expected");
+        }
+
+        // [js] function aabb_of(points: PackedVector3Array): AABB;
+        // [js] function aabb_of(points: PackedVector2Array): Rect2;
+        void _aabb_of(const v8::FunctionCallbackInfo<v8::Value>& info)
+        {
+            v8::Isolate* isolate = info.GetIsolate();
+            const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+            Variant points;
+            if (!TypeConvert::js_to_gd_var(isolate, context, info[0], points))
+            {
+                jsb_throw(isolate, "bad param at 0");
+                return;
+            }
+
+            if (points.get_type() == Variant::PACKED_VECTOR3_ARRAY)
+            {
+                const PackedVector3Array& src = *VariantInternal::get_vector3_array(&points);
+                if (src.is_empty()) { set_return(isolate, context, info, ::AABB()); return; }
+                Vector3 min, max;
+                bounds_impl(src.ptr(), src.size(), min, max);
+                set_return(isolate, context, info, ::AABB(min, max - min));
+                return;
+            }
+            if (points.get_type() == Variant::PACKED_VECTOR2_ARRAY)
+            {
+                const PackedVector2Array& src = *VariantInternal::get_vector2_array(&points);
+                if (src.is_empty()) { set_return(isolate, context, info, Rect2()); return; }
+                Vector2 min, max;
+                bounds_impl(src.ptr(), src.size(), min, max);
+                set_return(isolate, context, info, Rect2(min, max - min));
+                return;
+            }
+            jsb_throw(isolate, "PackedVector3Array or PackedVector2Array expected");
+        }
+    }
+
+    void BulkMath::expose(v8::Isolate* isolate, v8::Local<v8::Context> context, v8::Local<v8::Object> jsb_obj)
+    {
+        const v8::Local<v8::Object> math_obj = v8::Object::New(isolate);
+        jsb_obj->Set(context, impl::Helper::new_string_ascii(isolate, "math"), math_obj).Check();
+
+        math_obj->Set(context, impl::Helper::new_string_ascii(isolate, "transform_points"), JSB_NEW_FUNCTION(context, _transform_points, {})).Check();
+        math_obj->Set(context, impl::Helper::new_string_ascii(isolate, "lerp_arrays"), JSB_NEW_FUNCTION(context, _lerp_arrays, {})).Check();
+        math_obj->Set(context, impl::Helper::new_string_ascii(isolate, "distances_to"), JSB_NEW_FUNCTION(context, _distances_to, {})).Check();
+        math_obj->Set(context, impl::Helper::new_string_ascii(isolate, "aabb_of"), JSB_NEW_FUNCTION(context, _aabb_of, {})).Check();
+    }
+}
@@ -0,0 +1,13 @@
+#ifndef GODOTJS_BULK_MATH_H
+#define GODOTJS_BULK_MATH_H
+#include "jsb_bridge_pch.h"
+
+namespace jsb
+{
+    // batched math operations on packed vector arrays (`jsb.math`), each of them crosses the JS/C++ boundary only once
+    struct BulkMath
+    {
+        static void expose(v8::Isolate* isolate, v8::Local<v8::Context> context, v8::Local<v8::Object> jsb_obj);
+    };
+}
+#endif
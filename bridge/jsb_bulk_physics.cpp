@@ -0,0 +1,251 @@
+#include "jsb_bulk_physics.h"
+#include "jsb_type_convert.h"
+
+#if !JSB_WITH_WEB
+#if __has_include("servers/physics_3d/physics_server_3d.h")
+#   include "servers/physics_3d/physics_server_3d.h"
+#else
+#   include "servers/physics_server_3d.h"
+#endif
+#if __has_include("servers/physics_2d/physics_server_2d.h")
+#   include "servers/physics_2d/physics_server_2d.h"
+#else
+#   include "servers/physics_server_2d.h"
+#endif
+
+#if defined(_3D_DISABLED) || defined(PHYSICS_3D_DISABLED)
+#   define JSB_BULK_PHYSICS_3D 0
+#else
+#   define JSB_BULK_PHYSICS_3D 1
+#endif
+#if defined(PHYSICS_2D_DISABLED)
+#   define JSB_BULK_PHYSICS_2D 0
+#else
+#   define JSB_BULK_PHYSICS_2D 1
+#endif
+
+namespace jsb
+{
+    namespace
+    {
+        // a typed view of an ArrayBuffer argument, `r_count` elements of `TElement[p_stride]`
+        template<typename TElement>
+        bool get_buffer_arg(v8::Isolate* isolate, const v8::FunctionCallbackInfo<v8::Value>& info, int p_index, size_t p_stride, TElement*& r_data, size_t& r_count)
+        {
+            if (!info[p_index]->IsArrayBuffer())
+            {
+                jsb_throw(isolate, jsb_format("ArrayBuffer expected at %d", p_index));
+                return false;
+            }
+            const v8::Local<v8::ArrayBuffer> buffer = info[p_index].As<v8::ArrayBuffer>();
+            const size_t size = buffer->ByteLength();
+            if (size % (sizeof(TElement) * p_stride) != 0)
+            {
+                jsb_throw(isolate, jsb_format("bad buffer size at %d", p_index));
+                return false;
+            }
+            r_data = (TElement*) buffer->Data();
+            r_count = size / (sizeof(TElement) * p_stride);
+            return true;
+        }
+
+        // an optional output buffer for at least `p_count` elements
+        template<typename TElement>
+        bool get_output_arg(v8::Isolate* isolate, const v8::FunctionCallbackInfo<v8::Value>& info, int p_index, size_t p_stride, size_t p_count, TElement*& r_data)
+        {
+            r_data = nullptr;
+            if (info.Length() <= p_index || info[p_index]->IsNullOrUndefined())
+            {
+                return true;
+            }
+            size_t count;
+            if (!get_buffer_arg(isolate, info, p_index, p_stride, r_data, count))
+            {
+                return false;
+            }
+            if (count < p_count)
+            {
+                jsb_throw(isolate, jsb_format("buffer too small at %d", p_index));
+                return false;
+            }
+            return true;
+        }
+
+        // the collision mask of all rays (number), or of each ray (ArrayBuffer of Uint32)
+        bool get_mask_arg(v8::Isolate* isolate, const v8::Local<v8::Context>& context, const v8::FunctionCallbackInfo<v8::Value>& info, int p_index, size_t p_count, uint32_t& r_mask, const uint32_t*& r_masks)
+        {
+            r_mask = UINT32_MAX;
+            r_masks = nullptr;
+            if (info.Length() <= p_index || info[p_index]->IsUndefined())
+            {
+                return true;
+            }
+            if (info[p_index]->IsArrayBuffer())
+            {
+                return get_output_arg(isolate, info, p_index, 1, p_count, r_masks);
+            }
+            if (!info[p_index]->Uint32Value(context).To(&r_mask))
+            {
+                jsb_throw(isolate, jsb_format("bad collision mask at %d", p_index));
+                return false;
+            }
+            return true;
+        }
+
+        bool get_space_arg(v8::Isolate* isolate, const v8::Local<v8::Context>& context, const v8::FunctionCallbackInfo<v8::Value>& info, RID& r_space)
+        {
+            Variant space;
+            if (!TypeConvert::js_to_gd_var(isolate, context, info[0], Variant::RID, space) || space.get_type() != Variant::RID || !((RID) space).is_valid())
+            {
+                jsb_throw(isolate, "bad space");
+                return false;
+            }
+            r_space = space;
+            return true;
+        }
+
+#if JSB_BULK_PHYSICS_3D
+        // [js] function intersect_rays_3d(space: RID, rays: ArrayBuffer, hits: ArrayBuffer, colliders?: ArrayBuffer | null, collision_mask?: number | ArrayBuffer, collide_with_areas?: boolean): number;
+        void _intersect_rays_3d(const v8::FunctionCallbackInfo<v8::Value>& info)
+        {
+            v8::Isolate* isolate = info.GetIsolate();
+            const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+            RID space;
+            if (!get_space_arg(isolate, context, info, space)) return;
+            PhysicsDirectSpaceState3D* state = PhysicsServer3D::get_singleton()->space_get_direct_state(space);
+            if (!state)
+            {
+                jsb_throw(isolate, "space state is not accessible");
+                return;
+            }
+
+            // rays: (from.xyz, to.xyz) hits: (position.xyz, normal.xyz) colliders: instance id
+            const float* rays;
+            size_t count;
+            float* hits;
+            size_t hit_capacity;
+            uint64_t* colliders;
+            uint32_t mask;
+            const uint32_t* masks;
+            if (!get_buffer_arg(isolate, info, 1, 6, rays, count)
+                || !get_buffer_arg(isolate, info, 2, 6, hits, hit_capacity)
+                || !get_output_arg(isolate, info, 3, 1, count, colliders)
+                || !get_mask_arg(isolate, context, info, 4, count, mask, masks))
+            {
+                return;
+            }
+            if (hit_capacity < count)
+            {
+                jsb_throw(isolate, "buffer too small at 2");
+                return;
+            }
+
+            PhysicsDirectSpaceState3D::RayParameters parameters;
+            parameters.collide_with_areas = info.Length() > 5 && info[5]->BooleanValue(isolate);
+            int32_t hit_count = 0;
+            for (size_t index = 0; index < count; ++index)
+            {
+                const float* ray = rays + index * 6;
+                float* hit = hits + index * 6;
+                parameters.from = Vector3(ray[0], ray[1], ray[2]);
+                parameters.to = Vector3(ray[3], ray[4], ray[5]);
+                parameters.collision_mask = masks ? masks[index] : mask;
+
+                PhysicsDirectSpaceState3D::RayResult result;
+                if (state->intersect_ray(parameters, result))
+                {
+                    hit[0] = (float) result.position.x; hit[1] = (float) result.position.y; hit[2] = (float) result.position.z;
+                    hit[3] = (float) result.normal.x; hit[4] = (float) result.normal.y; hit[5] = (float) result.normal.z;
+                    if (colliders) colliders[index] = (uint64_t) result.collider_id;
+                    ++hit_count;
+                }
+                else
+                {
+                    memset(hit, 0, sizeof(float) * 6);
+                    if (colliders) colliders[index] = 0;
+                }
+            }
+            info.GetReturnValue().Set(hit_count);
+        }
+#endif
+
+#if JSB_BULK_PHYSICS_2D
+        // [js] function intersect_rays_2d(space: RID, rays: ArrayBuffer, hits: ArrayBuffer, colliders?: ArrayBuffer | null, collision_mask?: number | ArrayBuffer, collide_with_areas?: boolean): number;
+        void _intersect_rays_2d(const v8::FunctionCallbackInfo<v8::Value>& info)
+        {
+            v8::Isolate* isolate = info.GetIsolate();
+            const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+            RID space;
+            if (!get_space_arg(isolate, context, info, space)) return;
+            PhysicsDirectSpaceState2D* state = PhysicsServer2D::get_singleton()->space_get_direct_state(space);
+            if (!state)
+            {
+                jsb_throw(isolate, "space state is not accessible");
+                return;
+            }
+
+            // rays: (from.xy, to.xy) hits: (position.xy, normal.xy) colliders: instance id
+            const float* rays;
+            size_t count;
+            float* hits;
+            size_t hit_capacity;
+            uint64_t* colliders;
+            uint32_t mask;
+            const uint32_t* masks;
+            if (!get_buffer_arg(isolate, info, 1, 4, rays, count)
+                || !get_buffer_arg(isolate, info, 2, 4, hits, hit_capacity)
+                || !get_output_arg(isolate, info, 3, 1, count, colliders)
+                || !get_mask_arg(isolate, context, info, 4, count, mask, masks))
+            {
+                return;
+            }
+            if (hit_capacity < count)
+            {
+                jsb_throw(isolate, "buffer too small at 2");
+                return;
+            }
+
+            PhysicsDirectSpaceState2D::RayParameters parameters;
+            parameters.collide_with_areas = info.Length() > 5 && info[5]->BooleanValue(isolate);
+            int32_t hit_count = 0;
+            for (size_t index = 0; index < count; ++index)
+            {
+                const float* ray = rays + index * 4;
+                float* hit = hits + index * 4;
+                parameters.from = Vector2(ray[0], ray[1]);
+                parameters.to = Vector2(ray[2], ray[3]);
+                parameters.collision_mask = masks ? masks[index] : mask;
+
+                PhysicsDirectSpaceState2D::RayResult result;
+                if (state->intersect_ray(parameters, result))
+                {
+                    hit[0] = (float) result.position.x; hit[1] = (float) result.position.y;
+                    hit[2] = (float) result.normal.x; hit[3] = (float) result.normal.y;
+                    if (colliders) colliders[index] = (uint64_t) result.collider_id;
+                    ++hit_count;
+                }
+                else
+                {
+                    memset(hit, 0, sizeof(float) * 4);
+                    if (colliders) colliders[index] = 0;
+                }
+            }
+            info.GetReturnValue().Set(hit_count);
+        }
+#endif
+    }
+
+    void BulkPhysics::expose(v8::Isolate* isolate, v8::Local<v8::Context> context, v8::Local<v8::Object> jsb_obj)
+    {
+        v8::Local<v8::Object> physics_obj = v8::Object::New(isolate);
+
+        jsb_obj->Set(context, impl::Helper::new_string_ascii(isolate, "physics"), physics_obj).Check();
+#if JSB_BULK_PHYSICS_3D
+        physics_obj->Set(context, impl::Helper::new_string_ascii(isolate, "intersect_rays_3d"), JSB_NEW_FUNCTION(context, _intersect_rays_3d, {})).Check();
+#endif
+#if JSB_BULK_PHYSICS_2D
+        physics_obj->Set(context, impl::Helper::new_string_ascii(isolate, "intersect_rays_2d"), JSB_NEW_FUNCTION(context, _intersect_rays_2d, {})).Check();
+#endif
+    }
+}
+#endif
@@ -0,0 +1,15 @@
+#ifndef GODOTJS_BULK_PHYSICS_H
+#define GODOTJS_BULK_PHYSICS_H
+#include "jsb_bridge_pch.h"
+
+#if !JSB_WITH_WEB
+namespace jsb
+{
+    // batched ray queries on a physics space (`jsb.physics`), the rays and the results are read/written in ArrayBuffers shared with JS
+    struct BulkPhysics
+    {
+        static void expose(v8::Isolate* isolate, v8::Local<v8::Context> context, v8::Local<v8::Object> jsb_obj);
+    };
+}
+#endif
+#endif
@@ -0,0 +1,61 @@
+#include "jsb_bulk_rendering.h"
+#include "jsb_type_convert.h"
+
+#include "servers/rendering_server.h"
+
+#if !JSB_WITH_WEB
+namespace jsb
+{
+    namespace
+    {
+        // RenderingServer keeps a reference to the buffer if the command is queued (threaded rendering),
+        // it's recycled if released (otherwise `ptrw` copies on write), so that it's not reallocated on every frame.
+        // the ArrayBuffer can't be the storage itself since JS writes would be visible to the shared (COW) copies.
+        thread_local Vector<float> scratch_buffer_;
+
+        // [js] function multimesh_set_buffer(multimesh: RID, buffer: ArrayBuffer): void;
+        void _multimesh_set_buffer(const v8::FunctionCallbackInfo<v8::Value>& info)
+        {
+            v8::Isolate* isolate = info.GetIsolate();
+            const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+            Variant multimesh;
+            if (!TypeConvert::js_to_gd_var(isolate, context, info[0], Variant::RID, multimesh) || multimesh.get_type() != Variant::RID)
+            {
+                jsb_throw(isolate, "bad multimesh");
+                return;
+            }
+            if (!info[1]->IsArrayBuffer())
+            {
+                jsb_throw(isolate, "ArrayBuffer expected at 1");
+                return;
+            }
+            const v8::Local<v8::ArrayBuffer> buffer = info[1].As<v8::ArrayBuffer>();
+            const size_t size = buffer->ByteLength();
+            if (size % sizeof(float) != 0)
+            {
+                jsb_throw(isolate, "bad buffer size at 1");
+                return;
+            }
+
+            const int count = (int) (size / sizeof(float));
+            if (scratch_buffer_.size() != count)
+            {
+                scratch_buffer_.resize(count);
+            }
+            if (count != 0)
+            {
+                memcpy(scratch_buffer_.ptrw(), buffer->Data(), size);
+            }
+            RenderingServer::get_singleton()->multimesh_set_buffer(multimesh, scratch_buffer_);
+        }
+    }
+
+    void BulkRendering::expose(v8::Isolate* isolate, v8::Local<v8::Context> context, v8::Local<v8::Object> jsb_obj)
+    {
+        v8::Local<v8::Object> rendering_obj = v8::Object::New(isolate);
+
+        jsb_obj->Set(context, impl::Helper::new_string_ascii(isolate, "rendering"), rendering_obj).Check();
+        rendering_obj->Set(context, impl::Helper::new_string_ascii(isolate, "multimesh_set_buffer"), JSB_NEW_FUNCTION(context, _multimesh_set_buffer, {})).Check();
+    }
+}
+#endif
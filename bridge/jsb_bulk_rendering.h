@@ -0,0 +1,15 @@
+#ifndef GODOTJS_BULK_RENDERING_H
+#define GODOTJS_BULK_RENDERING_H
+#include "jsb_bridge_pch.h"
+
+#if !JSB_WITH_WEB
+namespace jsb
+{
+    // RenderingServer buffer writes from ArrayBuffers (`jsb.rendering`), without converting them into packed arrays through Variant
+    struct BulkRendering
+    {
+        static void expose(v8::Isolate* isolate, v8::Local<v8::Context> context, v8::Local<v8::Object> jsb_obj);
+    };
+}
+#endif
+#endif
@@ -0,0 +1,196 @@
+#include "jsb_bulk_transform.h"
+#include "jsb_type_convert.h"
+
+#include "scene/2d/node_2d.h"
+#ifndef _3D_DISABLED
+#   include "scene/3d/node_3d.h"
+#endif
+
+#if !JSB_WITH_WEB
+namespace jsb
+{
+    namespace
+    {
+        // 3D: 12 floats per node in the layout of MultiMesh buffers (row-major 3x4, the origin in the last column),
+        //     so that the same buffer can be passed to `jsb.rendering.multimesh_set_buffer`
+        // 2D: 6 floats per node in the layout of Transform2D (columns[0], columns[1], origin)
+        constexpr size_t kFloatsPerTransform3D = 12;
+        constexpr size_t kFloatsPerTransform2D = 6;
+
+        bool get_args(v8::Isolate* isolate, const v8::FunctionCallbackInfo<v8::Value>& info, size_t p_stride, v8::Local<v8::Array>& r_nodes, float*& r_data)
+        {
+            if (!info[0]->IsArray())
+            {
+                jsb_throw(isolate, "Array expected at 0");
+                return false;
+            }
+            if (!info[1]->IsArrayBuffer())
+            {
+                jsb_throw(isolate, "ArrayBuffer expected at 1");
+                return false;
+            }
+            r_nodes = info[0].As<v8::Array>();
+            const v8::Local<v8::ArrayBuffer> buffer = info[1].As<v8::ArrayBuffer>();
+            if (buffer->ByteLength() < (size_t) r_nodes->Length() * p_stride * sizeof(float))
+            {
+                jsb_throw(isolate, "buffer too small at 1");
+                return false;
+            }
+            r_data = (float*) buffer->Data();
+            return true;
+        }
+
+        // null (or not a node of the expected type) is skipped
+        template<typename TNode>
+        TNode* get_node(v8::Isolate* isolate, const v8::Local<v8::Context>& context, const v8::Local<v8::Array>& p_nodes, uint32_t p_index)
+        {
+            v8::Local<v8::Value> element;
+            Object* obj = nullptr;
+            if (!p_nodes->Get(context, p_index).ToLocal(&element) || !element->IsObject() || !TypeConvert::js_to_gd_obj(isolate, context, element, obj))
+            {
+                return nullptr;
+            }
+            return Object::cast_to<TNode>(obj);
+        }
+
+        // not global if the node is out of tree (as `get_global_transform` fails otherwise)
+        jsb_force_inline bool is_global(const Node* p_node, bool p_global) { return p_global && p_node->is_inside_tree(); }
+
+#ifndef _3D_DISABLED
+        // [js] function read_3d(nodes: Node3D[], buffer: ArrayBuffer, global?: boolean): number;
+        void _read_3d(const v8::FunctionCallbackInfo<v8::Value>& info)
+        {
+            v8::Isolate* isolate = info.GetIsolate();
+            const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+            v8::Local<v8::Array> nodes;
+            float* data;
+            if (!get_args(isolate, info, kFloatsPerTransform3D, nodes, data)) return;
+
+            const bool global = info.Length() < 3 || info[2]->IsUndefined() || info[2]->BooleanValue(isolate);
+            const uint32_t count = nodes->Length();
+            int32_t processed = 0;
+            for (uint32_t index = 0; index < count; ++index)
+            {
+                const Node3D* node = get_node<Node3D>(isolate, context, nodes, index);
+                if (!node) continue;
+
+                const Transform3D xform = is_global(node, global) ? node->get_global_transform() : node->get_transform();
+                float* dst = data + index * kFloatsPerTransform3D;
+                for (int row = 0; row < 3; ++row)
+                {
+                    dst[row * 4 + 0] = (float) xform.basis.rows[row].x;
+                    dst[row * 4 + 1] = (float) xform.basis.rows[row].y;
+                    dst[row * 4 + 2] = (float) xform.basis.rows[row].z;
+                    dst[row * 4 + 3] = (float) xform.origin[row];
+                }
+                ++processed;
+            }
+            info.GetReturnValue().Set(processed);
+        }
+
+        // [js] function write_3d(nodes: Node3D[], buffer: ArrayBuffer, global?: boolean): number;
+        void _write_3d(const v8::FunctionCallbackInfo<v8::Value>& info)
+        {
+            v8::Isolate* isolate = info.GetIsolate();
+            const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+            v8::Local<v8::Array> nodes;
+            float* data;
+            if (!get_args(isolate, info, kFloatsPerTransform3D, nodes, data)) return;
+
+            const bool global = info.Length() < 3 || info[2]->IsUndefined() || info[2]->BooleanValue(isolate);
+            const uint32_t count = nodes->Length();
+            int32_t processed = 0;
+            for (uint32_t index = 0; index < count; ++index)
+            {
+                Node3D* node = get_node<Node3D>(isolate, context, nodes, index);
+                if (!node) continue;
+
+                const float* src = data + index * kFloatsPerTransform3D;
+                Transform3D xform;
+                for (int row = 0; row < 3; ++row)
+                {
+                    xform.basis.rows[row] = Vector3(src[row * 4 + 0], src[row * 4 + 1], src[row * 4 + 2]);
+                    xform.origin[row] = src[row * 4 + 3];
+                }
+                if (is_global(node, global)) node->set_global_transform(xform);
+                else node->set_transform(xform);
+                ++processed;
+            }
+            info.GetReturnValue().Set(processed);
+        }
+#endif
+
+        // [js] function read_2d(nodes: Node2D[], buffer: ArrayBuffer, global?: boolean): number;
+        void _read_2d(const v8::FunctionCallbackInfo<v8::Value>& info)
+        {
+            v8::Isolate* isolate = info.GetIsolate();
+            const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+            v8::Local<v8::Array> nodes;
+            float* data;
+            if (!get_args(isolate, info, kFloatsPerTransform2D, nodes, data)) return;
+
+            const bool global = info.Length() < 3 || info[2]->IsUndefined() || info[2]->BooleanValue(isolate);
+            const uint32_t count = nodes->Length();
+            int32_t processed = 0;
+            for (uint32_t index = 0; index < count; ++index)
+            {
+                const Node2D* node = get_node<Node2D>(isolate, context, nodes, index);
+                if (!node) continue;
+
+                const Transform2D xform = is_global(node, global) ? node->get_global_transform() : node->get_transform();
+                float* dst = data + index * kFloatsPerTransform2D;
+                for (int column = 0; column < 3; ++column)
+                {
+                    dst[column * 2 + 0] = (float) xform.columns[column].x;
+                    dst[column * 2 + 1] = (float) xform.columns[column].y;
+                }
+                ++processed;
+            }
+            info.GetReturnValue().Set(processed);
+        }
+
+        // [js] function write_2d(nodes: Node2D[], buffer: ArrayBuffer, global?: boolean): number;
+        void _write_2d(const v8::FunctionCallbackInfo<v8::Value>& info)
+        {
+            v8::Isolate* isolate = info.GetIsolate();
+            const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+            v8::Local<v8::Array> nodes;
+            float* data;
+            if (!get_args(isolate, info, kFloatsPerTransform2D, nodes, data)) return;
+
+            const bool global = info.Length() < 3 || info[2]->IsUndefined() || info[2]->BooleanValue(isolate);
+            const uint32_t count = nodes->Length();
+            int32_t processed = 0;
+            for (uint32_t index = 0; index < count; ++index)
+            {
+                Node2D* node = get_node<Node2D>(isolate, context, nodes, index);
+                if (!node) continue;
+
+                const float* src = data + index * kFloatsPerTransform2D;
+                Transform2D xform;
+                for (int column = 0; column < 3; ++column)
+                {
+                    xform.columns[column] = Vector2(src[column * 2 + 0], src[column * 2 + 1]);
+                }
+                if (is_global(node, global)) node->set_global_transform(xform);
+                else node->set_transform(xform);
+                ++processed;
+            }
+            info.GetReturnValue().Set(processed);
+        }
+    }
+
+    void BulkTransform::expose(v8::Isolate* isolate, v8::Local<v8::Context> context, v8::Local<v8::Object> jsb_obj)
+    {
+        v8::Local<v8::Object> transforms_obj = v8::Object::New(isolate);
+
+        jsb_obj->Set(context, impl::Helper::new_string_ascii(isolate, "transforms"), transforms_obj).Check();
+#ifndef _3D_DISABLED
+        transforms_obj->Set(context, impl::Helper::new_string_ascii(isolate, "read_3d"), JSB_NEW_FUNCTION(context, _read_3d, {})).Check();
+        transforms_obj->Set(context, impl::Helper::new_string_ascii(isolate, "write_3d"), JSB_NEW_FUNCTION(context, _write_3d, {})).Check();
+#endif
+        transforms_obj->Set(context, impl::Helper::new_string_ascii(isolate, "read_2d"), JSB_NEW_FUNCTION(context, _read_2d, {})).Check();
+        transforms_obj->Set(context, impl::Helper::new_string_ascii(isolate, "write_2d"), JSB_NEW_FUNCTION(context, _write_2d, {})).Check();
+    }
+}
+#endif
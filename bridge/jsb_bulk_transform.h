@@ -0,0 +1,15 @@
+#ifndef GODOTJS_BULK_TRANSFORM_H
+#define GODOTJS_BULK_TRANSFORM_H
+#include "jsb_bridge_pch.h"
+
+#if !JSB_WITH_WEB
+namespace jsb
+{
+    // read/write the transforms of many nodes at once (`jsb.transforms`), the transforms are packed in an ArrayBuffer shared with JS
+    struct BulkTransform
+    {
+        static void expose(v8::Isolate* isolate, v8::Local<v8::Context> context, v8::Local<v8::Object> jsb_obj);
+    };
+}
+#endif
+#endif
@@ -12,25 +12,30 @@ namespace jsb
         jsb::ObjectCacheID callback_id_;
         jsb::EnvironmentID env_id_;
 
+        // the JS binding handle of `object_id_` when the callable created, it saves the address lookup on calls if still valid
+        jsb::NativeObjectID object_handle_;
+
     public:
         static bool _compare_equal(const CallableCustom* p_a, const CallableCustom* p_b)
         {
             // types are already ensured by `Callable::operator==` with the comparator function pointers before calling
             const JSCallable* js_cc_a = (const JSCallable*)p_a;
             const JSCallable* js_cc_b = (const JSCallable*)p_b;
-            return js_cc_a->callback_id_ == js_cc_b->callback_id_;
+            return js_cc_a->callback_id_ == js_cc_b->callback_id_ && js_cc_a->env_id_ == js_cc_b->env_id_;
         }
 
         static bool _compare_less(const CallableCustom* p_a, const CallableCustom* p_b)
         {
             const JSCallable* js_cc_a = (const JSCallable*)p_a;
             const JSCallable* js_cc_b = (const JSCallable*)p_b;
-            return js_cc_a->callback_id_ < js_cc_b->callback_id_;
+            return js_cc_a->callback_id_ != js_cc_b->callback_id_
+                ? js_cc_a->callback_id_ < js_cc_b->callback_id_
+                : js_cc_a->env_id_ < js_cc_b->env_id_;
             // return !_compare_equal(p_a, p_b) && p_a < p_b;
         }
 
-        JSCallable(ObjectID p_object_id, jsb::EnvironmentID p_env_id, jsb::ObjectCacheID p_callback_id)
-            : object_id_(p_object_id), callback_id_(p_callback_id), env_id_(p_env_id)
+        JSCallable(ObjectID p_object_id, jsb::EnvironmentID p_env_id, jsb::ObjectCacheID p_callback_id, jsb::NativeObjectID p_object_handle = {})
+            : object_id_(p_object_id), callback_id_(p_callback_id), env_id_(p_env_id), object_handle_(p_object_handle)
         {
         }
 
@@ -70,11 +70,15 @@ namespace jsb
         p_class_info->native_class_name = environment->get_native_class(p_class_info->native_class_id)->name;
         jsb_check(internal::VariantUtil::is_valid_name(p_class_info->native_class_name));
         p_class_info->js_class.Reset(isolate, class_obj);
+        p_class_info->crossbind_target.Reset();
         p_class_info->js_class_name = environment->get_string_name(class_obj->Get(p_context, jsb_name(environment, name)).ToLocalChecked().As<v8::String>());
         p_class_info->methods.clear();
         p_class_info->signals.clear();
         p_class_info->properties.clear();
+        p_class_info->property_order.clear();
+        p_class_info->property_slot_accessors.clear();
         p_class_info->rpc_config.clear();
+        p_class_info->rpc_methods.clear();
         p_class_info->method_cache.clear();
         p_class_info->flags = ScriptClassFlags::None;
 
@@ -161,6 +165,89 @@ namespace jsb
             }
         }
 
+        // godot virtuals (lookup through the prototype chain, inherited methods are also resolved)
+        p_class_info->implemented_virtual_methods = 0;
+        for (int index = 0; index < ScriptVirtualMethod::kNum; ++index)
+        {
+            const ScriptVirtualMethod::Type vm = (ScriptVirtualMethod::Type) index;
+            const StringName exposed_name = internal::NamingUtil::get_member_name(ScriptVirtualMethod::get_name(vm));
+            v8::Global<v8::Function>& slot = p_class_info->virtual_methods[index];
+            if (v8::Local<v8::Value> method; prototype->Get(p_context, environment->get_string_value(exposed_name)).ToLocal(&method) && method->IsFunction())
+            {
+                slot.Reset(isolate, method.As<v8::Function>());
+                p_class_info->implemented_virtual_methods |= 1u << index;
+            }
+            else
+            {
+                slot.Reset();
+            }
+        }
+
+        // @onready properties (the collection is added on the prototype by `add_script_ready`)
+        p_class_info->onready_entries.clear();
+        if (v8::Local<v8::Value> val; prototype->Get(p_context, jsb_symbol(environment, ClassImplicitReadyFuncs)).ToLocal(&val) && val->IsArray())
+        {
+            const v8::Local<v8::Array> collection = val.As<v8::Array>();
+            const uint32_t len = collection->Length();
+            p_class_info->onready_entries.resize(len);
+            uint32_t num = 0;
+            for (uint32_t index = 0; index < len; ++index)
+            {
+                v8::Local<v8::Value> element;
+                v8::Local<v8::Value> element_name;
+                v8::Local<v8::Value> element_value;
+                if (!collection->Get(p_context, index).ToLocal(&element) || !element->IsObject()
+                    || !element.As<v8::Object>()->Get(p_context, jsb_name(environment, name)).ToLocal(&element_name) || !element_name->IsString()
+                    || !element.As<v8::Object>()->Get(p_context, jsb_name(environment, evaluator)).ToLocal(&element_value))
+                {
+                    continue;
+                }
+
+                ScriptClassInfo::OnReadyEntry& entry = p_class_info->onready_entries[num];
+                if (element_value->IsString())
+                {
+                    entry.path = NodePath(impl::Helper::to_string(isolate, element_value));
+                }
+                else if (element_value->IsFunction())
+                {
+                    entry.evaluator.Reset(isolate, element_value.As<v8::Function>());
+                }
+                else
+                {
+                    continue;
+                }
+                entry.name.Reset(isolate, element_name.As<v8::String>());
+                ++num;
+            }
+            p_class_info->onready_entries.resize(num);
+        }
+
+        // rpc methods, incoming calls are dispatched by `Environment::call_script_method` without the method cache
+        if (!p_class_info->rpc_config.is_empty())
+        {
+            const Array rpc_keys = p_class_info->rpc_config.keys();
+            LocalVector<StringName> rpc_names;
+            rpc_names.reserve(rpc_keys.size());
+            for (int index = 0, num = rpc_keys.size(); index < num; ++index)
+            {
+                rpc_names.push_back(rpc_keys[index]);
+            }
+            rpc_names.sort_custom<StringName::AlphCompare>();
+
+            p_class_info->rpc_methods.resize(rpc_names.size());
+            for (uint32_t index = 0; index < rpc_names.size(); ++index)
+            {
+                ScriptClassInfo::RPCMethod& rpc_method = p_class_info->rpc_methods[index];
+                rpc_method.name = rpc_names[index];
+                const StringName exposed_name = internal::NamingUtil::get_script_method_name(rpc_method.name);
+                if (v8::Local<v8::Value> method; prototype->Get(p_context, environment->get_string_value(exposed_name)).ToLocal(&method) && method->IsFunction())
+                {
+                    rpc_method.function.Reset(isolate, method.As<v8::Function>());
+                }
+                JSB_LOG(VeryVerbose, "... rpc %s (id: %d)", rpc_method.name, index);
+            }
+        }
+
         // tool (@tool_)
         {
             const bool is_tool = class_obj->HasOwnProperty(p_context, jsb_symbol(environment, ClassToolScript)).FromMaybe(false);
@@ -170,6 +257,24 @@ namespace jsb
             }
         }
 
+        // batched (@batched)
+        {
+            const bool is_batched = class_obj->HasOwnProperty(p_context, jsb_symbol(environment, ClassBatchedScript)).FromMaybe(false);
+            if (is_batched)
+            {
+                p_class_info->flags = (ScriptClassFlags::Type) (p_class_info->flags | ScriptClassFlags::Batched);
+            }
+        }
+
+        // cached exports (@cached_exports)
+        {
+            const bool is_cached_exports = class_obj->HasOwnProperty(p_context, jsb_symbol(environment, ClassCachedExports)).FromMaybe(false);
+            if (is_cached_exports)
+            {
+                p_class_info->flags = (ScriptClassFlags::Type) (p_class_info->flags | ScriptClassFlags::CachedExports);
+            }
+        }
+
         // icon (@icon)
         {
             if (v8::Local<v8::Value> val; class_obj->Get(p_context, jsb_symbol(environment, ClassIcon)).ToLocal(&val))
@@ -224,6 +329,19 @@ namespace jsb
                     property_info.hint_string = impl::Helper::to_string(isolate, obj->Get(context, jsb_name(environment, hint_string)).ToLocalChecked());
                     property_info.usage = BridgeHelper::to_enum<PropertyUsageFlags>(context, obj->Get(context, jsb_name(environment, usage)), PROPERTY_USAGE_DEFAULT) | PROPERTY_USAGE_SCRIPT_VARIABLE;
 
+                    // the literal default value captured at decorator time (if any)
+                    if (v8::Local<v8::Value> default_value; obj->Get(context, jsb_name(environment, default)).ToLocal(&default_value) && !default_value->IsUndefined())
+                    {
+                        if (TypeConvert::js_to_gd_var(isolate, context, default_value, property_info.type, property_info.default_value))
+                        {
+                            property_info.has_literal_default = true;
+                        }
+                        else
+                        {
+                            JSB_LOG(Warning, "bad default value of property %s, it'll be evaluated with the class default object", property_info.name);
+                        }
+                    }
+
                     v8::Local<v8::Value> cache;
 
                     if (obj->Get(context, jsb_name(environment, cache)).ToLocal(&cache))
@@ -241,6 +359,13 @@ namespace jsb
                     JSB_LOG(VeryVerbose, "... property %s: %s", property_info.name, Variant::get_type_name(property_info.type));
                 }
             }
+
+            // the fixed order to apply the pending property values of instances (see Environment::set_script_property_value_deferred)
+            for (auto& it : p_class_info->properties)
+            {
+                it.value.index = p_class_info->property_order.size();
+                p_class_info->property_order.push_back(&it.value);
+            }
         }
     }
 
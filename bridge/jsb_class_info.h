@@ -76,9 +76,12 @@ namespace jsb
         impl::Class clazz;
     };
 
+    // the registry of native classes (chunked, the class info is never moved after added)
+    typedef internal::SArray<NativeClassInfo, NativeClassID, internal::ChunkedAllocator<>> NativeClassInfoArray;
+
     // Safe pointer of NativeClassInfo
-    typedef internal::SArray<NativeClassInfo, NativeClassID>::Pointer NativeClassInfoPtr;
-    typedef internal::SArray<NativeClassInfo, NativeClassID>::ConstPointer NativeClassInfoConstPtr;
+    typedef NativeClassInfoArray::Pointer NativeClassInfoPtr;
+    typedef NativeClassInfoArray::ConstPointer NativeClassInfoConstPtr;
 
     struct ClassRegister;
     typedef NativeClassInfoPtr (*ClassRegisterFunc)(const ClassRegister& p_register, NativeClassID* r_class_id);
@@ -156,11 +159,17 @@ namespace jsb
 
         ScriptPropertyDoc doc;
 
-        // valid only if _Evaluated flag is set in ScriptClassInfo.flags
+        // valid only if _Evaluated flag is set in ScriptClassInfo.flags (or `has_literal_default` is true)
         Variant default_value;
 
+        // the default value is given in the @export annotation (`default`), no need to evaluate it with a CDO
+        bool has_literal_default = false;
+
         bool cache;
 
+        // position in the declaration order of the properties of the class (see ScriptClassInfo::property_order)
+        uint32_t index = 0;
+
         explicit operator PropertyInfo() const
         {
             return { type, name, hint, hint_string, usage, class_name };
@@ -179,9 +188,57 @@ namespace jsb
 
             // (INTERNAL USE ONLY) whether the default value of properties are evaluated or not
             _Evaluated = 1 << 2,
+
+            // `_process` of all instances are dispatched at once per frame (see Environment::_flush_batched_process)
+            Batched = 1 << 3,
+
+            // all exported properties are cached by script instances (see GodotJSScriptInstance::get)
+            CachedExports = 1 << 4,
         };
     }
 
+    // fixed indices of the frequently called godot virtuals (see jsb_script_virtual_methods.def.h)
+    namespace ScriptVirtualMethod
+    {
+        enum Type : uint8_t
+        {
+#pragma push_macro("DEF")
+#   undef DEF
+#   define DEF(Name) VM##Name,
+#   include "../internal/jsb_script_virtual_methods.def.h"
+#pragma pop_macro("DEF")
+            kNum,
+        };
+        static_assert(kNum <= 32);
+
+        // get the index of a godot virtual method, or `kNum` if it's not listed.
+        // it's a linear search with pointer comparisons of StringName, no hashing involved.
+        jsb_force_inline Type find(const StringName& p_name)
+        {
+#pragma push_macro("DEF")
+#   undef DEF
+#   define DEF(Name) if (p_name == jsb_string_name(Name)) return VM##Name;
+#   include "../internal/jsb_script_virtual_methods.def.h"
+#pragma pop_macro("DEF")
+            return kNum;
+        }
+
+        jsb_force_inline const StringName& get_name(Type p_index)
+        {
+            switch (p_index)
+            {
+#pragma push_macro("DEF")
+#   undef DEF
+#   define DEF(Name) case VM##Name: return jsb_string_name(Name);
+#   include "../internal/jsb_script_virtual_methods.def.h"
+#pragma pop_macro("DEF")
+            default: break;
+            }
+            static const StringName empty;
+            return empty;
+        }
+    }
+
     // exchange internal javascript class (object) information.
     struct StatelessScriptClassInfo
     {
@@ -208,7 +265,7 @@ namespace jsb
 
         HashMap<StringName, ScriptMethodInfo> methods;
         HashMap<StringName, ScriptSignalInfo> signals;
-        HashMap<StringName, ScriptPropertyInfo> properties;
+        internal::FlatMap<StringName, ScriptPropertyInfo> properties;
 
         ScriptClassFlags::Type flags = ScriptClassFlags::None;
 
@@ -217,6 +274,8 @@ namespace jsb
 
         jsb_force_inline bool is_tool() const { return flags & ScriptClassFlags::Tool; }
         jsb_force_inline bool is_abstract() const { return flags & ScriptClassFlags::Abstract; }
+        jsb_force_inline bool is_batched() const { return flags & ScriptClassFlags::Batched; }
+        jsb_force_inline bool is_cached_exports() const { return flags & ScriptClassFlags::CachedExports; }
     };
 
     struct ScriptClassInfo : StatelessScriptClassInfo
@@ -232,7 +291,60 @@ namespace jsb
         // for constructor access
         v8::Global<v8::Object> js_class;
 
-        internal::TypeGen<StringName, v8::Global<v8::Function>>::UnorderedMap method_cache;
+        // (created on the first crossbind) the `new.target` inheriting `js_class.prototype`, only reused by the non-nested crossbinds
+        v8::Global<v8::Function> crossbind_target;
+
+        internal::FlatMap<StringName, v8::Global<v8::Function>> method_cache;
+
+        // resolved at parse time (including the inherited ones from the base script classes), empty if not implemented
+        v8::Global<v8::Function> virtual_methods[ScriptVirtualMethod::kNum];
+
+        // bitmask of the non-empty `virtual_methods`, checked before entering any JS scope
+        uint32_t implemented_virtual_methods = 0;
+
+        jsb_force_inline bool has_virtual_method(ScriptVirtualMethod::Type p_index) const { return implemented_virtual_methods & (1u << p_index); }
+
+        struct OnReadyEntry
+        {
+            // the property to assign
+            v8::Global<v8::String> name;
+
+            // the node path to resolve if it's not evaluated by a function
+            NodePath path;
+            v8::Global<v8::Function> evaluator;
+        };
+
+        // the @onready properties resolved at parse time, evaluated and assigned in `Environment::call_script_prelude`
+        LocalVector<OnReadyEntry> onready_entries;
+
+        struct RPCMethod
+        {
+            StringName name;
+            v8::Global<v8::Function> function;
+        };
+
+        // the methods in `rpc_config` resolved at parse time, the index is the id of the method (sorted by name as SceneRPCInterface does)
+        LocalVector<RPCMethod> rpc_methods;
+
+        // get the id of an rpc method, or -1 if it's not. it's a linear search with pointer comparisons of StringName (as ScriptVirtualMethod::find)
+        jsb_force_inline int find_rpc_method(const StringName& p_name) const
+        {
+            for (uint32_t index = 0, num = rpc_methods.size(); index < num; ++index)
+            {
+                if (rpc_methods[index].name == p_name) return (int) index;
+            }
+            return -1;
+        }
+
+        // the exported properties in declaration order (pointing to the elements of `properties`), resolved at parse time
+        LocalVector<const ScriptPropertyInfo*> property_order;
+
+        // [exported_property_slots] the getter and setter (at index * 2 and index * 2 + 1) of each slotted property, created on demand
+        LocalVector<v8::Global<v8::Function>> property_slot_accessors;
+
+        // [batched only] instances enqueued by `_process` in the current frame
+        Vector<NativeObjectID> batched_objects;
+        double batched_delta = 0;
 
         static void instantiate(Environment* p_env, const StringName& p_module_id, const v8::Local<v8::Object>& p_self);
 
@@ -240,9 +352,12 @@ namespace jsb
 
     };
 
+    // the registry of script classes (chunked, the class info is never moved after added)
+    typedef internal::SArray<ScriptClassInfo, ScriptClassID, internal::ChunkedAllocator<>> ScriptClassInfoArray;
+
     // Safe pointer of ScriptClassInfo
-    typedef internal::SArray<ScriptClassInfo, ScriptClassID>::Pointer ScriptClassInfoPtr;
-    typedef internal::SArray<ScriptClassInfo, ScriptClassID>::ConstPointer ScriptClassInfoConstPtr;
+    typedef ScriptClassInfoArray::Pointer ScriptClassInfoPtr;
+    typedef ScriptClassInfoArray::ConstPointer ScriptClassInfoConstPtr;
 
 }
 
@@ -1,6 +1,8 @@
 #include "jsb_debugger.h"
 #include "jsb_environment.h"
 #include "core/io/tcp_server.h"
+#include "core/os/semaphore.h"
+#include "../internal/jsb_thread_util.h"
 
 #if JSB_WITH_DEBUGGER
 #if JSB_WITH_LWS && JSB_WITH_V8
@@ -61,24 +63,22 @@ namespace jsb
         }
     }
 
+    class JavaScriptDebuggerImpl;
+
+    // [isolate thread] the inspector session of the connected client, messages are sent through the I/O thread
     class JSInspectorChannel : public v8_inspector::V8Inspector::Channel
     {
-        v8::Isolate* isolate_;
-        lws* wsi_; // active wsi
-        Vector<Ref<StreamPeerBuffer>> _send_queue;
+        JavaScriptDebuggerImpl* debugger_;
+        uint32_t connection_;
         std::unique_ptr<v8_inspector::V8InspectorSession> session_;
 
-        Ref<StreamPeerBuffer> recv_buffer_;
-
     public:
-        JSInspectorChannel(lws* p_wsi, v8::Isolate* p_isolate, v8_inspector::V8Inspector& p_inspector)
-        : isolate_(p_isolate), wsi_(p_wsi)
+        JSInspectorChannel(JavaScriptDebuggerImpl* p_debugger, uint32_t p_connection, v8_inspector::V8Inspector& p_inspector)
+        : debugger_(p_debugger), connection_(p_connection)
         {
             v8_inspector::StringView state;
             v8_inspector::V8Inspector::ClientTrustLevel trust_level = v8_inspector::V8Inspector::ClientTrustLevel::kFullyTrusted;
             session_ = p_inspector.connect(kContextGroupId, this, state, trust_level);
-            recv_buffer_.instantiate();
-            recv_buffer_->resize(kMaxRecvBufSize);
         }
 
         virtual ~JSInspectorChannel() override
@@ -89,76 +89,23 @@ namespace jsb
                 session_->resume();
                 session_.reset();
             }
-            // lws_close_reason(wsi_, LWS_CLOSE_STATUS_NORMAL, nullptr, 0);
         }
 
-        bool operator==(lws* wsi) const { return wsi_ == wsi; }
-        bool operator!=(lws* wsi) const { return wsi_ != wsi; }
-
-        bool on_received(const unsigned char* p_buf, size_t p_len)
+        void dispatch(v8::Isolate* p_isolate, const Vector<uint8_t>& p_message)
         {
             jsb_check(session_);
-            jsb_check(p_len < (size_t)kMaxRecvBufSize);
-            if (lws_is_first_fragment(wsi_))
-            {
-                recv_buffer_->seek(0);
-            }
-            const int new_len = recv_buffer_->get_position() + (int) p_len;
-            if (new_len > recv_buffer_->get_size())
-            {
-                recv_buffer_->resize(new_len);
-            }
-
-            recv_buffer_->put_data(p_buf, (int) p_len);
-            if (lws_is_final_fragment(wsi_))
-            {
-                const bool is_binary = lws_frame_is_binary(wsi_) == 1;
-                if (is_binary) { JSB_DEBUGGER_LOG(Verbose, "receive binary message: %d", recv_buffer_->get_position()); }
-                else { JSB_DEBUGGER_LOG(Verbose, "receive text message: %s", String::utf8((const char*) recv_buffer_->get_data_array().ptr(), recv_buffer_->get_position())); }
-
-                v8::Isolate* isolate = isolate_;
-                v8::Isolate::Scope isolate_scope(isolate);
-                v8::HandleScope handle_scope(isolate);
-                const impl::TryCatch try_catch(isolate);
-
-                v8_inspector::StringView message(recv_buffer_->get_data_array().ptr(), recv_buffer_->get_position());
-                session_->dispatchProtocolMessage(message);
-                if (try_catch.has_caught())
-                {
-                    JSB_DEBUGGER_LOG(Error, "dispatchProtocolMessage failed: %s", BridgeHelper::get_exception(try_catch));
-                }
+            JSB_DEBUGGER_LOG(Verbose, "receive text message: %s", String::utf8((const char*) p_message.ptr(), p_message.size()));
 
-                if (!_send_queue.is_empty())
-                {
-                    lws_callback_on_writable(wsi_);
-                }
-            }
-            return true;
-        }
+            v8::Isolate::Scope isolate_scope(p_isolate);
+            v8::HandleScope handle_scope(p_isolate);
+            const impl::TryCatch try_catch(p_isolate);
 
-        // wsi is ready to write
-        bool flush()
-        {
-            if (!_send_queue.is_empty())
+            const v8_inspector::StringView message(p_message.ptr(), p_message.size());
+            session_->dispatchProtocolMessage(message);
+            if (try_catch.has_caught())
             {
-                Ref<StreamPeerBuffer> buffer = _send_queue[0];
-                const int len =  buffer->get_position() - LWS_PRE;
-                const int sent = lws_write(wsi_, buffer->get_data_array().ptrw() + LWS_PRE, len, LWS_WRITE_TEXT);
-                if (sent != len)
-                {
-                    JSB_DEBUGGER_LOG(Error, "connection write error, %d bytes in buf but only %d sent", len, sent);
-                    return false;
-                }
-
-                JSB_DEBUGGER_LOG(VeryVerbose, "send message: %d bytes", len);
-                _send_queue.remove_at(0);
-                if (!_send_queue.is_empty())
-                {
-                    JSB_DEBUGGER_LOG(VeryVerbose, "messages in queue to be sent: %d", _send_queue.size());
-                    lws_callback_on_writable(wsi_);
-                }
+                JSB_DEBUGGER_LOG(Error, "dispatchProtocolMessage failed: %s", BridgeHelper::get_exception(try_catch));
             }
-            return true;
         }
 
         virtual void sendResponse(int callId, std::unique_ptr<v8_inspector::StringBuffer> message) override { send_message(message->string()); }
@@ -166,35 +113,14 @@ namespace jsb
         virtual void flushProtocolNotifications() override {}
 
     private:
-        void send_message(const v8_inspector::StringView& view)
-        {
-            if (view.is8Bit())
-            {
-                _notify_send(view.characters8(), view.length());
-            }
-            else
-            {
-                const CharString encoded = String::utf16((const char16_t*) view.characters16(), (int) view.length()).utf8();
-                _notify_send((const uint8_t*) encoded.ptr(), encoded.length());
-            }
-        }
-
-        void _notify_send(const uint8_t* p_buf, size_t p_len)
-        {
-            jsb_check(wsi_);
-            jsb_check(p_len < kMaxSendBufSize);
-            const int rlen = (int) p_len + LWS_PRE;
-            Ref<StreamPeerBuffer> buffer;
-            buffer.instantiate();
-            buffer->resize(rlen);
-            buffer->seek(LWS_PRE);
-            buffer->put_data(p_buf, (int) p_len);
-            jsb_check((int) p_len + LWS_PRE == buffer->get_position());
-            _send_queue.append(buffer);
-            lws_callback_on_writable(wsi_);
-        }
+        void send_message(const v8_inspector::StringView& view);
     };
 
+    /**
+     * The inspector socket is serviced on a dedicated I/O thread, the isolate thread only handles complete protocol messages.
+     * Received messages are dispatched with `v8::Isolate::RequestInterrupt` (if JS is running) or in `update` (a flag check if nothing pending),
+     * and the outgoing messages are written by the I/O thread (woken up by `lws_cancel_service`).
+     */
     class JavaScriptDebuggerImpl : public v8_inspector::V8InspectorClient
     {
         static void _lws_log_callback(int level, const char* msg)
@@ -209,16 +135,45 @@ namespace jsb
             ECS_PAUSED,
         };
 
+        // a pending interrupt may outlive the debugger (no way to cancel), it's ignored if the target is already destroyed
+        struct InterruptToken
+        {
+            JavaScriptDebuggerImpl* target;
+        };
+
         v8::Isolate* isolate_;
         std::unique_ptr<v8_inspector::V8Inspector> inspector_;
         uint16_t port_;
 
         lws_protocols protocols_[2] = { {}, {} };
         lws_context* wss_;
-        std::unique_ptr<JSInspectorChannel> channel_;
 
+        // [isolate thread]
         EClientState state_;
         int context_index_;
+        std::unique_ptr<JSInspectorChannel> channel_;
+        uint32_t channel_connection_ = 0;
+        bool dispatching_ = false;
+        std::shared_ptr<InterruptToken> interrupt_token_;
+
+        // [I/O thread]
+        Thread io_thread_;
+        lws* wsi_ = nullptr;
+        Vector<uint8_t> recv_buffer_;
+
+        // shared between the I/O thread and the isolate thread
+        BinaryMutex lock_;
+        bool connected_ = false;
+        // increased on every connection change, the messages of the previous connections are dropped
+        uint32_t connection_ = 0;
+        Vector<Vector<uint8_t>> inbox_;
+        List<Vector<uint8_t>> outbox_;
+
+        std::atomic<bool> quit_ = false;
+        std::atomic<bool> pending_ = false;
+        std::atomic<bool> interrupt_requested_ = false;
+        std::atomic<bool> paused_ = false;
+        Semaphore pause_semaphore_;
 
     public:
         JavaScriptDebuggerImpl(v8::Isolate* p_isolate, uint16_t p_port)
@@ -230,6 +185,13 @@ namespace jsb
 
         virtual ~JavaScriptDebuggerImpl() override
         {
+            if (io_thread_.is_started())
+            {
+                quit_.store(true);
+                lws_cancel_service(wss_);
+                io_thread_.wait_to_finish();
+            }
+            if (interrupt_token_) interrupt_token_->target = nullptr;
             channel_.reset();
             lws_context_destroy(wss_);
         }
@@ -266,6 +228,13 @@ namespace jsb
                 inspector_ = v8_inspector::V8Inspector::create(isolate, this);
                 state_ = ECS_READY;
                 wss_ = lws_create_context(&context_creation_info);
+                if (wss_)
+                {
+                    interrupt_token_ = std::make_shared<InterruptToken>(InterruptToken { this });
+                    Thread::Settings settings;
+                    settings.priority = Thread::PRIORITY_LOW;
+                    io_thread_.start(&_io_thread_run, this, settings);
+                }
                 JSB_DEBUGGER_LOG(Debug, "devtools://devtools/bundled/inspector.html?v8only=true&ws=127.0.0.1:%d/1", port_);
             }
             else
@@ -275,23 +244,51 @@ namespace jsb
             }
         }
 
+        // [isolate thread] only a flag check if no message pending
         void update()
         {
-            if (jsb_unlikely(state_ == ECS_NONE)) return;
+            if (jsb_likely(!pending_.load(std::memory_order_acquire))) return;
+            if (dispatching_) return;
+
+            dispatching_ = true;
+            _dispatch_messages();
+            dispatching_ = false;
+        }
 
-            lws_service(wss_, -1);
-            lws_callback_on_writable_all_protocol(wss_, protocols_);
+        // [isolate thread]
+        void post_message(uint32_t p_connection, const uint8_t* p_buf, size_t p_len)
+        {
+            jsb_check(p_len < kMaxSendBufSize);
+            Vector<uint8_t> buffer;
+            buffer.resize((int) p_len + LWS_PRE);
+            memcpy(buffer.ptrw() + LWS_PRE, p_buf, p_len);
+            {
+                MutexLock lock(lock_);
+                if (!connected_ || p_connection != connection_) return;
+                outbox_.push_back(std::move(buffer));
+            }
+            lws_cancel_service(wss_);
         }
 
         virtual void runMessageLoopOnPause(int contextGroupId) override
         {
             if (state_ == ECS_READY)
             {
+                // no dispatching from interrupts while paused (the scripts evaluated on the paused frame may run them)
+                const bool was_dispatching = dispatching_;
+                dispatching_ = true;
                 state_ = ECS_PAUSED;
                 while (state_ == ECS_PAUSED)
                 {
-                    update();
+                    _dispatch_messages();
+                    if (state_ != ECS_PAUSED) break;
+
+                    // sleep until a message arrives (or the connection changes)
+                    paused_.store(true);
+                    if (!pending_.load()) pause_semaphore_.wait();
+                    paused_.store(false);
                 }
+                dispatching_ = was_dispatching;
             }
         }
 
@@ -332,28 +329,187 @@ namespace jsb
         }
 
     private:
+        // [isolate thread] apply the connection change and dispatch all received messages
+        void _dispatch_messages()
+        {
+            pending_.store(false);
+
+            Vector<Vector<uint8_t>> messages;
+            bool connected;
+            uint32_t connection;
+            {
+                MutexLock lock(lock_);
+                messages = std::move(inbox_);
+                inbox_.clear();
+                connected = connected_;
+                connection = connection_;
+            }
+
+            if (connection != channel_connection_)
+            {
+                channel_connection_ = connection;
+                channel_.reset();
+                if (connected)
+                {
+                    JSB_DEBUGGER_LOG(VeryVerbose, "new connection established");
+                    channel_ = std::make_unique<JSInspectorChannel>(this, connection, *inspector_);
+                }
+            }
+            for (const Vector<uint8_t>& message : messages)
+            {
+                // the connection may be changed by a nested dispatch (in the message loop on pause)
+                if (!channel_ || channel_connection_ != connection) break;
+                channel_->dispatch(isolate_, message);
+            }
+        }
+
+        // [I/O thread] notify the isolate thread about new messages (or a connection change)
+        void _notify_pending()
+        {
+            pending_.store(true);
+            if (paused_.load())
+            {
+                pause_semaphore_.post();
+            }
+            else if (!interrupt_requested_.exchange(true))
+            {
+                // dispatched as soon as possible even if a long running script is blocking the game loop
+                isolate_->RequestInterrupt(&_on_interrupt, memnew(std::shared_ptr<InterruptToken>(interrupt_token_)));
+            }
+        }
+
+        static void _on_interrupt(v8::Isolate* isolate, void* data)
+        {
+            std::shared_ptr<InterruptToken>* token = (std::shared_ptr<InterruptToken>*) data;
+            if (JavaScriptDebuggerImpl* impl = (*token)->target)
+            {
+                impl->interrupt_requested_.store(false);
+                impl->update();
+            }
+            memdelete(token);
+        }
+
+        static void _io_thread_run(void* p_userdata)
+        {
+            JavaScriptDebuggerImpl* impl = (JavaScriptDebuggerImpl*) p_userdata;
+            ThreadUtil::set_name("jsb.debugger");
+            while (!impl->quit_.load())
+            {
+                // block until any socket event or lws_cancel_service
+                if (lws_service(impl->wss_, 0) < 0) break;
+            }
+        }
+
+        // [I/O thread]
         void _on_lws_close(lws* wsi)
         {
-            if (channel_ && *channel_ == wsi)
+            if (wsi_ == wsi)
             {
                 JSB_DEBUGGER_LOG(Verbose, "connection closed");
-                channel_.reset();
+                wsi_ = nullptr;
+                {
+                    MutexLock lock(lock_);
+                    connected_ = false;
+                    ++connection_;
+                    inbox_.clear();
+                    outbox_.clear();
+                }
+                _notify_pending();
             }
         }
 
+        // [I/O thread]
         bool _on_lws_open(lws* wsi)
         {
-            if (channel_)
+            if (wsi_)
             {
                 JSB_DEBUGGER_LOG(Warning, "last channel not closed");
                 return false;
             }
 
-            JSB_DEBUGGER_LOG(VeryVerbose, "new connection established");
-            channel_ = std::make_unique<JSInspectorChannel>(wsi, isolate_, *inspector_);
+            wsi_ = wsi;
+            {
+                MutexLock lock(lock_);
+                connected_ = true;
+                ++connection_;
+            }
+            _notify_pending();
             return true;
         }
 
+        // [I/O thread]
+        bool _on_lws_receive(const unsigned char* p_buf, size_t p_len)
+        {
+            jsb_check(p_len < (size_t)kMaxRecvBufSize);
+            if (lws_is_first_fragment(wsi_))
+            {
+                recv_buffer_.clear();
+            }
+            const int offset = recv_buffer_.size();
+            recv_buffer_.resize(offset + (int) p_len);
+            memcpy(recv_buffer_.ptrw() + offset, p_buf, p_len);
+
+            if (lws_is_final_fragment(wsi_))
+            {
+                if (lws_frame_is_binary(wsi_) == 1)
+                {
+                    JSB_DEBUGGER_LOG(Verbose, "ignore binary message: %d", recv_buffer_.size());
+                    recv_buffer_.clear();
+                    return true;
+                }
+                {
+                    MutexLock lock(lock_);
+                    inbox_.push_back(std::move(recv_buffer_));
+                }
+                recv_buffer_ = Vector<uint8_t>();
+                _notify_pending();
+            }
+            return true;
+        }
+
+        // [I/O thread] wsi is ready to write
+        bool _on_lws_writable()
+        {
+            Vector<uint8_t> buffer;
+            bool more;
+            {
+                MutexLock lock(lock_);
+                if (outbox_.is_empty()) return true;
+                buffer = std::move(outbox_.front()->get());
+                outbox_.pop_front();
+                more = !outbox_.is_empty();
+            }
+
+            const int len = buffer.size() - LWS_PRE;
+            const int sent = lws_write(wsi_, buffer.ptrw() + LWS_PRE, len, LWS_WRITE_TEXT);
+            if (sent != len)
+            {
+                JSB_DEBUGGER_LOG(Error, "connection write error, %d bytes in buf but only %d sent", len, sent);
+                return false;
+            }
+            JSB_DEBUGGER_LOG(VeryVerbose, "send message: %d bytes", len);
+            if (more)
+            {
+                lws_callback_on_writable(wsi_);
+            }
+            return true;
+        }
+
+        // [I/O thread] woken up by lws_cancel_service
+        void _on_lws_wait_cancelled()
+        {
+            if (!wsi_) return;
+            bool has_outgoing;
+            {
+                MutexLock lock(lock_);
+                has_outgoing = !outbox_.is_empty();
+            }
+            if (has_outgoing)
+            {
+                lws_callback_on_writable(wsi_);
+            }
+        }
+
         static int _v8_protocol_callback(lws* wsi, lws_callback_reasons reason, void* user, void* in, size_t len)
         {
             lws_context* ctx = lws_get_context(wsi);
@@ -369,13 +525,13 @@ namespace jsb
                 }
                 return 0;
             case LWS_CALLBACK_RECEIVE:
-                if (!impl->channel_ || *impl->channel_ != wsi)
+                if (impl->wsi_ != wsi)
                 {
                     JSB_DEBUGGER_LOG(Error, "unexpected connection");
                     lws_close_reason(wsi, LWS_CLOSE_STATUS_UNEXPECTED_CONDITION, nullptr, 0);
                     return -1;
                 }
-                if (!impl->channel_->on_received((unsigned char*) in, len))
+                if (!impl->_on_lws_receive((unsigned char*) in, len))
                 {
                     JSB_DEBUGGER_LOG(Error, "failed to receive");
                     lws_close_reason(wsi, LWS_CLOSE_STATUS_ABNORMAL_CLOSE, nullptr, 0);
@@ -386,7 +542,7 @@ namespace jsb
                 return 0;
             case LWS_CALLBACK_CLIENT_WRITEABLE:
             case LWS_CALLBACK_SERVER_WRITEABLE:
-                if (!impl->channel_ || *impl->channel_ != wsi || !impl->channel_->flush())
+                if (impl->wsi_ != wsi || !impl->_on_lws_writable())
                 {
                     JSB_DEBUGGER_LOG(Error, "failed to flush");
                     lws_close_reason(wsi, LWS_CLOSE_STATUS_ABNORMAL_CLOSE, nullptr, 0);
@@ -451,8 +607,10 @@ namespace jsb
             case LWS_CALLBACK_CLIENT_RECEIVE:
                 JSB_DEBUGGER_LOG(Error, "unexpected %d", reason);
                 return -1;
+            case LWS_CALLBACK_EVENT_WAIT_CANCELLED:
+                impl->_on_lws_wait_cancelled();
+                return 0;
             default:
-                // LWS_CALLBACK_EVENT_WAIT_CANCELLED 71
                 // LWS_CALLBACK_PROTOCOL_INIT 27
                 // LWS_CALLBACK_GET_THREAD_ID 31
                 JSB_DEBUGGER_LOG(VeryVerbose, "unhandled %d", reason);
@@ -460,6 +618,19 @@ namespace jsb
             }
         }
     };
+
+    void JSInspectorChannel::send_message(const v8_inspector::StringView& view)
+    {
+        if (view.is8Bit())
+        {
+            debugger_->post_message(connection_, view.characters8(), view.length());
+        }
+        else
+        {
+            const CharString encoded = String::utf16((const char16_t*) view.characters16(), (int) view.length()).utf8();
+            debugger_->post_message(connection_, (const uint8_t*) encoded.ptr(), encoded.length());
+        }
+    }
 }
 #else
 namespace jsb
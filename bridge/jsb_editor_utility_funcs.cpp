@@ -836,90 +836,125 @@ namespace jsb
         return class_info_obj;
     }
 
-    static void _get_class_doc(const v8::FunctionCallbackInfo<v8::Value>& info)
+    // the doc of a class in the same shape of `jsb.editor.ClassDoc` (only strings in it, so it can be transferred as a JSON text at once)
+    static Dictionary encode_class_doc(const DocData::ClassDoc& class_doc)
     {
-        v8::Isolate* isolate = info.GetIsolate();
-        v8::HandleScope handle_scope(isolate);
-        v8::Local<v8::Context> context = isolate->GetCurrentContext();
+        Dictionary class_doc_dict;
 
-        const String name = impl::Helper::to_string(isolate, info[0]);
-        if (const DocData::ClassDoc* ptr = EditorHelp::get_doc_data()->class_list.getptr(name))
-        {
-            const DocData::ClassDoc& class_doc = *ptr;
-            v8::Local<v8::Object> class_doc_obj = v8::Object::New(isolate);
+        // doc:class<brief>
+        class_doc_dict["brief_description"] = class_doc.brief_description;
 
-            // doc:class<brief>
-            set_field(isolate, context, class_doc_obj, JSB_GET_FIELD_NAME_PRESET(class_doc, brief_description));
-
-            // doc:constants
+        // doc:constants
+        {
+            Dictionary constants_dict;
+            for (const DocData::ConstantDoc& constant_doc : class_doc.constants)
             {
-                JSB_HANDLE_SCOPE(isolate);
+                Dictionary constant_dict;
+                constant_dict["description"] = constant_doc.description;
+                constants_dict[internal::NamingUtil::get_constant_name(constant_doc.name)] = constant_dict;
+            }
+            class_doc_dict["constants"] = constants_dict;
+        }
 
-                v8::Local<v8::Object> constants_obj = v8::Object::New(isolate);
-                set_field(isolate, context, class_doc_obj, "constants", constants_obj);
-                for (const DocData::ConstantDoc& constant_doc : class_doc.constants)
-                {
-                    JSB_HANDLE_SCOPE(isolate);
-                    v8::Local<v8::Object> constant_obj = v8::Object::New(isolate);
-                    String constant_name = internal::NamingUtil::get_constant_name(constant_doc.name);
-                    constants_obj->Set(context, impl::Helper::new_string(isolate, constant_name), constant_obj).Check();
+        // doc:methods
+        {
+            Dictionary methods_dict;
+            for (const DocData::MethodDoc& method_doc : class_doc.methods)
+            {
+                Dictionary method_dict;
+                method_dict["description"] = method_doc.description;
+                methods_dict[internal::NamingUtil::get_member_name(method_doc.name)] = method_dict;
+            }
+            class_doc_dict["methods"] = methods_dict;
+        }
 
-                    set_field(isolate, context, constant_obj, "description", constant_doc.description);
-                }
+        // doc:properties
+        {
+            Dictionary properties_dict;
+            for (const DocData::PropertyDoc& property_doc : class_doc.properties)
+            {
+                Dictionary property_dict;
+                property_dict["description"] = property_doc.description;
+                properties_dict[internal::NamingUtil::get_member_name(property_doc.name)] = property_dict;
             }
+            class_doc_dict["properties"] = properties_dict;
+        }
 
-            // doc:methods
+        // doc:signals
+        {
+            Dictionary signals_dict;
+            for (const DocData::MethodDoc& signal_doc : class_doc.signals)
             {
-                JSB_HANDLE_SCOPE(isolate);
+                Dictionary signal_dict;
+                signal_dict["description"] = signal_doc.description;
+                signals_dict[internal::NamingUtil::get_member_name(signal_doc.name)] = signal_dict;
+            }
+            class_doc_dict["signals"] = signals_dict;
+        }
 
-                v8::Local<v8::Object> methods_obj = v8::Object::New(isolate);
-                set_field(isolate, context, class_doc_obj, "methods", methods_obj);
-                for (const DocData::MethodDoc& method_doc : class_doc.methods)
-                {
-                    JSB_HANDLE_SCOPE(isolate);
-                    v8::Local<v8::Object> method_obj = v8::Object::New(isolate);
-                    String method_name = internal::NamingUtil::get_member_name(method_doc.name);
-                    methods_obj->Set(context, impl::Helper::new_string(isolate, method_name), method_obj).Check();
+        return class_doc_dict;
+    }
 
-                    set_field(isolate, context, method_obj, "description", method_doc.description);
-                }
-            }
+    // build the whole object graph from a JSON text in a single call, instead of setting the fields one by one through the bridge
+    static v8::MaybeLocal<v8::Value> parse_json_payload(v8::Isolate* isolate, const v8::Local<v8::Context>& context, const Variant& payload)
+    {
+        const CharString json = JSON::stringify(payload, "", false).utf8();
+        return impl::Helper::parse_json(isolate, context, (const uint8_t*) json.ptr(), (size_t) json.length());
+    }
 
-            // doc:properties
-            {
-                JSB_HANDLE_SCOPE(isolate);
-                v8::Local<v8::Object> properties_obj = v8::Object::New(isolate);
-                set_field(isolate, context, class_doc_obj, "properties", properties_obj);
-                for (const DocData::PropertyDoc& property_doc : class_doc.properties)
-                {
-                    JSB_HANDLE_SCOPE(isolate);
-                    v8::Local<v8::Object> property_obj = v8::Object::New(isolate);
-                    String property_name = internal::NamingUtil::get_member_name(property_doc.name);
-                    properties_obj->Set(context, impl::Helper::new_string(isolate, property_name), property_obj).Check();
+    static void _get_class_doc(const v8::FunctionCallbackInfo<v8::Value>& info)
+    {
+        v8::Isolate* isolate = info.GetIsolate();
+        v8::HandleScope handle_scope(isolate);
+        v8::Local<v8::Context> context = isolate->GetCurrentContext();
 
-                    set_field(isolate, context, property_obj, "description", property_doc.description);
-                }
+        const String name = impl::Helper::to_string(isolate, info[0]);
+        if (const DocData::ClassDoc* ptr = EditorHelp::get_doc_data()->class_list.getptr(name))
+        {
+            v8::Local<v8::Value> class_doc_obj;
+            if (parse_json_payload(isolate, context, encode_class_doc(*ptr)).ToLocal(&class_doc_obj))
+            {
+                info.GetReturnValue().Set(class_doc_obj);
             }
+        }
+    }
 
-            // doc:signals
-            {
-                JSB_HANDLE_SCOPE(isolate);
+    // the docs of all the given classes in one call: { [class_name]: ClassDoc } (classes without doc are omitted)
+    static void _get_class_docs(const v8::FunctionCallbackInfo<v8::Value>& info)
+    {
+        v8::Isolate* isolate = info.GetIsolate();
+        v8::HandleScope handle_scope(isolate);
+        v8::Local<v8::Context> context = isolate->GetCurrentContext();
 
-                v8::Local<v8::Object> signals_obj = v8::Object::New(isolate);
-                set_field(isolate, context, class_doc_obj, "signals", signals_obj);
-                for (const DocData::MethodDoc& signal_doc : class_doc.signals)
-                {
-                    JSB_HANDLE_SCOPE(isolate);
-                    v8::Local<v8::Object> signal_obj = v8::Object::New(isolate);
-                    String signal_name = internal::NamingUtil::get_member_name(signal_doc.name);
-                    signals_obj->Set(context, impl::Helper::new_string(isolate, signal_name), signal_obj).Check();
+        if (info.Length() != 1 || !info[0]->IsArray())
+        {
+            jsb_throw(isolate, "bad class names");
+            return;
+        }
 
-                    set_field(isolate, context, signal_obj, "description", signal_doc.description);
-                }
+        const auto& class_list = EditorHelp::get_doc_data()->class_list;
+        v8::Local<v8::Array> names = info[0].As<v8::Array>();
+        Dictionary class_docs_dict;
+        for (uint32_t index = 0, num = names->Length(); index < num; ++index)
+        {
+            v8::Local<v8::Value> name_val;
+            if (!names->Get(context, index).ToLocal(&name_val) || !name_val->IsString()) continue;
+
+            const String name = impl::Helper::to_string(isolate, name_val);
+            if (const DocData::ClassDoc* ptr = class_list.getptr(name))
+            {
+                class_docs_dict[name] = encode_class_doc(*ptr);
             }
+        }
 
-            info.GetReturnValue().Set(class_doc_obj);
+        // all docs are transferred as a single JSON text (tens of thousands of fields for the whole ClassDB)
+        v8::Local<v8::Value> class_docs_obj;
+        if (!parse_json_payload(isolate, context, class_docs_dict).ToLocal(&class_docs_obj))
+        {
+            jsb_throw(isolate, "failed to transfer class docs");
+            return;
         }
+        info.GetReturnValue().Set(class_docs_obj);
     }
 
     static void _get_classes(const v8::FunctionCallbackInfo<v8::Value>& info)
@@ -1101,6 +1136,7 @@ namespace jsb
 
         jsb_obj->Set(context, impl::Helper::new_string_ascii(isolate, "editor"), editor_obj).Check();
         editor_obj->Set(context, impl::Helper::new_string_ascii(isolate, "get_class_doc"), JSB_NEW_FUNCTION(context, _get_class_doc, {})).Check();
+        editor_obj->Set(context, impl::Helper::new_string_ascii(isolate, "get_class_docs"), JSB_NEW_FUNCTION(context, _get_class_docs, {})).Check();
         editor_obj->Set(context, impl::Helper::new_string_ascii(isolate, "get_classes"), JSB_NEW_FUNCTION(context, _get_classes, {})).Check();
         editor_obj->Set(context, impl::Helper::new_string_ascii(isolate, "get_global_constants"), JSB_NEW_FUNCTION(context, _get_global_constants, {})).Check();
         editor_obj->Set(context, impl::Helper::new_string_ascii(isolate, "get_singletons"), JSB_NEW_FUNCTION(context, _get_singletons, {})).Check();
@@ -10,6 +10,10 @@
 #include "jsb_type_convert.h"
 #include "jsb_class_register.h"
 #include "jsb_worker.h"
+#include "jsb_worker_task.h"
+#include "jsb_server_queries.h"
+#include "jsb_file_io.h"
+#include "jsb_web_worker.h"
 #include "jsb_essentials.h"
 #include "jsb_amd_module_loader.h"
 
@@ -17,6 +21,7 @@
 #include "../internal/jsb_class_util.h"
 #include "../internal/jsb_variant_util.h"
 #include "../internal/jsb_settings.h"
+#include "../internal/jsb_module_archive.h"
 #include "../jsb_project_preset.h"
 
 #ifdef TOOLS_ENABLED
@@ -33,27 +38,10 @@
 #include "modules/GodotJS/weaver/jsb_script_instance.h"
 #include "modules/GodotJS/weaver/jsb_script_language.h"
 
-#if !JSB_WITH_STATIC_BINDINGS
 #include "jsb_primitive_bindings_reflect.h"
-#define register_primitive_bindings(param) register_primitive_bindings_reflect(param)
-#else
-#include "jsb_primitive_bindings_static.h"
-#define register_primitive_bindings(param) register_primitive_bindings_static(param)
-#endif
 
 namespace jsb
 {
-#if JSB_V8_CPPGC
-    // for cppgc wrapper descriptor
-    enum
-    {
-        kWrapperTypeIndex,
-        kWrapperInstanceIndex,
-        kWrapperFieldCount,
-    };
-    namespace { const uint16_t kWrapperID = 1; }
-#endif
-
     struct EnvironmentStore
     {
         std::vector<std::shared_ptr<Environment>> get_list()
@@ -173,16 +161,13 @@ namespace jsb
                 // p_binding must equal to the return value of `create_callback`
                 jsb_check(p_instance == p_binding);
 
-                // must check before async, InstanceBindingCallback need to know whether the object should die or not if it's a ref-counted object.
-                if (env->verify_object(p_binding))
-                {
-                    // Note: Our pointer to the native Godot object is about to become invalid. We must IMMEDIATELY
-                    //       remove this pointer/address from our data structures. It's not safe to post a message and
-                    //       do this work on the environment's thread, because another Godot object may be allocated at
-                    //       the same address before our message is handled. This is not hypothetical, it was observed
-                    //       in practice several times.
-                    env->free_object(p_binding, FinalizationType::None);
-                }
+                // Note: Our pointer to the native Godot object is about to become invalid. We must IMMEDIATELY
+                //       remove this pointer/address from our data structures. It's not safe to post a message and
+                //       do this work on the environment's thread, because another Godot object may be allocated at
+                //       the same address before our message is handled. This is not hypothetical, it was observed
+                //       in practice several times.
+                // `free_object` silently skips the unregistered pointers, no need to verify it at first (one lookup less).
+                env->free_object(p_binding, FinalizationType::None);
             }
         }
 
@@ -209,6 +194,17 @@ namespace jsb
 
     namespace
     {
+#if JSB_THREADING
+        // a copy of the arguments of a script method called from another thread (see AsyncCall::TYPE_SCRIPT_CALL)
+        struct DeferredScriptCall
+        {
+            ScriptClassID class_id;
+            NativeObjectID object_id;
+            StringName method;
+            Vector<Variant> args;
+        };
+#endif
+
 #if JSB_PRINT_GC_TIME
         uint64_t gc_ticks = 0;
 
@@ -217,16 +213,91 @@ namespace jsb
             if (const OS* os = OS::get_singleton())
             {
                 gc_ticks = os->get_ticks_msec();
+                if (Environment* env = Environment::wrap(isolate)) env->on_gc_begin();
             }
         }
 
         void OnPostGCCallback(v8::Isolate* isolate, v8::GCType type, v8::GCCallbackFlags flags)
         {
+            if (Environment* env = Environment::wrap(isolate); env && OS::get_singleton())
+            {
+                env->on_gc_end();
+            }
             JSB_LOG(VeryVerbose, "v8 gc time %dms type:%d flags:%d",
                 OS::get_singleton() ? OS::get_singleton()->get_ticks_msec() - gc_ticks : -1, type, flags);
         }
 #endif
 
+        // StringNames is shared by all environments, the replacements only depend on the settings which require a restart
+        void add_exposed_name_replacements(internal::StringNames& names)
+        {
+            // Populate StringNames replacement list so that classes can be lazily loaded by their exposed class name.
+            if (internal::Settings::get_camel_case_bindings_enabled())
+            {
+                List<StringName> exposed_class_list = internal::NamingUtil::get_exposed_original_class_list();
+
+                for (auto it = exposed_class_list.begin(); it != exposed_class_list.end(); ++it)
+                {
+                    String exposed_name = internal::NamingUtil::get_class_name(*it);
+
+                    if (exposed_name != *it)
+                    {
+                        names.add_replacement(*it, exposed_name);
+                    }
+                }
+
+                List<Engine::Singleton> singleton_list;
+                Engine::get_singleton()->get_singletons(&singleton_list);
+
+                for (auto it = singleton_list.begin(); it != singleton_list.end(); ++it)
+                {
+                    String exposed_name = internal::NamingUtil::get_class_name(it->name);
+
+                    if (exposed_name != it->name)
+                    {
+                        names.add_replacement(it->name, exposed_name);
+                    }
+                }
+
+                Vector<String> reserved_words = GodotJSScriptLanguage::get_singleton()->get_reserved_words();
+
+                List<StringName> utility_function_list;
+                Variant::get_utility_function_list(&utility_function_list);
+
+                for (auto it = utility_function_list.begin(); it != utility_function_list.end(); ++it)
+                {
+                    String exposed_name = internal::NamingUtil::get_member_name(*it);
+
+                    if (reserved_words.find(exposed_name) >= 0)
+                    {
+                        exposed_name = internal::NamingUtil::get_member_name("godot_" + exposed_name);
+                    }
+
+                    if (exposed_name != *it)
+                    {
+                        names.add_replacement(*it, exposed_name);
+                    }
+                }
+
+                const int constant_count = CoreConstants::get_global_constant_count();
+                for (int index = 0; index < constant_count; ++index)
+                {
+                    const StringName enum_name = CoreConstants::get_global_constant_enum(index);
+                    String exposed_name = internal::NamingUtil::get_class_name(enum_name);
+
+                    if (reserved_words.find(exposed_name) >= 0)
+                    {
+                        exposed_name = internal::NamingUtil::get_member_name("godot_" + exposed_name);
+                    }
+
+                    if (exposed_name != enum_name)
+                    {
+                        names.add_replacement(enum_name, exposed_name);
+                    }
+                }
+            }
+        }
+
         void PromiseRejectCallback_(v8::PromiseRejectMessage message)
         {
             if (message.GetEvent() != v8::kPromiseRejectWithNoHandler)
@@ -249,13 +320,25 @@ namespace jsb
         JSB_BENCHMARK_SCOPE(JSEnvironment, Construct);
         impl::GlobalInitialize::init();
         v8::Isolate::CreateParams create_params;
-        create_params.array_buffer_allocator = &allocator_;
+#if JSB_WITH_V8
+        create_params.array_buffer_allocator_shared = ArrayBufferAllocator::get_shared();
+#else
+        create_params.array_buffer_allocator = ArrayBufferAllocator::get_shared().get();
+#endif
+#if JSB_WITH_V8
+        if (p_params.max_heap_size_mb != 0)
+        {
+            const size_t max_size = (size_t) p_params.max_heap_size_mb * 1024 * 1024;
+            create_params.constraints.ConfigureDefaultsFromHeapSize(MIN((size_t) p_params.initial_heap_size_mb * 1024 * 1024, max_size), max_size);
+        }
+        else if (p_params.initial_heap_size_mb != 0)
+        {
+            create_params.constraints.set_initial_old_generation_size_in_bytes((size_t) p_params.initial_heap_size_mb * 1024 * 1024);
+        }
+#endif
 #if JSB_V8_CPPGC
-        // old version:
-        cpp_heap_ = v8::CppHeap::Create(impl::GlobalInitialize::get_platform(),
-            v8::CppHeapCreateParams({}, v8::WrapperDescriptor(kWrapperTypeIndex, kWrapperInstanceIndex, kWrapperID)));
-        // new version:
-        // cpp_heap_ = v8::CppHeap::Create(impl::GlobalInitialize::get_platform(), v8::CppHeapCreateParams({}));
+        // the wrappables are attached with v8::Object::Wrap, no wrapper descriptor (internal fields) needed
+        cpp_heap_ = v8::CppHeap::Create(impl::GlobalInitialize::get_platform(), v8::CppHeapCreateParams({}));
         create_params.cpp_heap = cpp_heap_.get();
 #endif
 
@@ -265,6 +348,21 @@ namespace jsb
         isolate_ = v8::Isolate::New(create_params);
         isolate_->SetData(kIsolateEmbedderData, this);
         isolate_->SetPromiseRejectCallback(PromiseRejectCallback_);
+        // blocking on Atomics.wait() is only allowed in workers, it would stall the engine loop otherwise
+        isolate_->SetAllowAtomicsWait(p_params.type == Type::Worker);
+        if (p_params.max_heap_size_mb != 0)
+        {
+#if JSB_WITH_V8
+            isolate_->AddNearHeapLimitCallback(&_near_heap_limit_callback, this);
+            // the headroom granted in `_near_heap_limit_callback` is taken back after the heap shrinks
+            isolate_->AutomaticallyRestoreInitialHeapLimit(0.5);
+#elif JSB_WITH_QUICKJS
+            heap_limit_ = (size_t) p_params.max_heap_size_mb * 1024 * 1024;
+            impl::Helper::set_memory_limit(isolate_, heap_limit_);
+#else
+            JSB_LOG(Warning, "max_heap_size_mb is not supported by the current backend");
+#endif
+        }
 #if JSB_PRINT_GC_TIME
         isolate_->AddGCPrologueCallback(&OnPreGCCallback);
         isolate_->AddGCEpilogueCallback(&OnPostGCCallback);
@@ -309,83 +407,55 @@ namespace jsb
                     module_cache_.init(isolate_, cache_obj);
                 }
 
-                internal::StringNames& names = internal::StringNames::get_singleton();
-
-                // Populate StringNames replacement list so that classes can be lazily loaded by their exposed class name.
-                if (internal::Settings::get_camel_case_bindings_enabled())
+#if JSB_WITH_ESSENTIALS
+                timer_budget_usec_ = internal::Settings::get_timer_frame_budget_usec();
+#endif
+                microtask_checkpoint_per_call_batch_ = internal::Settings::is_microtask_checkpoint_per_call_batch();
+                exported_property_slots_ = internal::Settings::is_exported_property_slots();
+                console_min_severity_ = internal::Settings::get_console_min_severity();
+                weak_engine_object_wrappers_ = internal::Settings::is_weak_engine_object_wrappers();
+                defer_threaded_script_calls_ = internal::Settings::is_defer_threaded_script_calls();
+                prefetch_module_dependencies_ = internal::Settings::is_prefetch_module_dependencies();
+#if JSB_WITH_WATCHDOG
+                if (const uint32_t budget_msec = internal::Settings::get_script_call_budget_msec(); budget_msec != 0)
                 {
-                    List<StringName> exposed_class_list = internal::NamingUtil::get_exposed_original_class_list();
-
-                    for (auto it = exposed_class_list.begin(); it != exposed_class_list.end(); ++it)
-                    {
-                        String exposed_name = internal::NamingUtil::get_class_name(*it);
-
-                        if (exposed_name != *it)
-                        {
-                            names.add_replacement(*it, exposed_name);
-                        }
-                    }
-
-                    List<Engine::Singleton> singleton_list;
-                    Engine::get_singleton()->get_singletons(&singleton_list);
-
-                    for (auto it = singleton_list.begin(); it != singleton_list.end(); ++it)
-                    {
-                        String exposed_name = internal::NamingUtil::get_class_name(it->name);
-
-                        if (exposed_name != it->name)
-                        {
-                            names.add_replacement(it->name, exposed_name);
-                        }
-                    }
-
-                    Vector<String> reserved_words = GodotJSScriptLanguage::get_singleton()->get_reserved_words();
-
-                    List<StringName> utility_function_list;
-                    Variant::get_utility_function_list(&utility_function_list);
-
-                    for (auto it = utility_function_list.begin(); it != utility_function_list.end(); ++it)
-                    {
-                        String exposed_name = internal::NamingUtil::get_member_name(*it);
-
-                        if (reserved_words.find(exposed_name) >= 0)
-                        {
-                            exposed_name = internal::NamingUtil::get_member_name("godot_" + exposed_name);
-                        }
-
-                        if (exposed_name != *it)
-                        {
-                            names.add_replacement(*it, exposed_name);
-                        }
-                    }
-
-                    const int constant_count = CoreConstants::get_global_constant_count();
-                    for (int index = 0; index < constant_count; ++index)
-                    {
-                        const StringName enum_name = CoreConstants::get_global_constant_enum(index);
-                        String exposed_name = internal::NamingUtil::get_class_name(enum_name);
-
-                        if (reserved_words.find(exposed_name) >= 0)
-                        {
-                            exposed_name = internal::NamingUtil::get_member_name("godot_" + exposed_name);
-                        }
+                    watchdog_budget_usec_ = (uint64_t) budget_msec * 1000;
+                    impl::Helper::set_as_interruptible(isolate_);
+                    Watchdog::register_(this);
+                }
+#endif
+#if JSB_WITH_QUICKJS
+                if (const uint32_t threshold_kb = internal::Settings::get_gc_malloc_threshold_kb(); threshold_kb != 0 && impl::Helper::get_malloc_size(isolate_) != 0)
+                {
+                    gc_malloc_threshold_ = (size_t) threshold_kb * 1024;
+                    gc_malloc_base_ = impl::Helper::get_malloc_size(isolate_);
 
-                        if (exposed_name != enum_name)
-                        {
-                            names.add_replacement(enum_name, exposed_name);
-                        }
-                    }
+                    // the automatic collection would only be triggered on memory spikes in the middle of a frame
+                    impl::Helper::set_gc_threshold(isolate_, gc_malloc_base_ + gc_malloc_threshold_ * 4);
                 }
+#endif
+#if JSB_WITH_V8
+                idle_gc_min_slack_usec_ = internal::Settings::get_idle_gc_min_slack_usec();
+#endif
+
+                // done once per process (it would be a waste of time to repeat it in workers)
+                internal::StringNames::get_singleton().add_exposed_replacements_once(&add_exposed_name_replacements);
 
-#if !JSB_WITH_WEB && !JSB_WITH_JAVASCRIPTCORE
+#if !JSB_WITH_WEB
                 Worker::register_(context, global);
+#else
+                WebWorker::register_(context, global);
 #endif
                 Essentials::register_(context, global);
-                register_primitive_bindings(this);
+                register_primitive_bindings_reflect(this);
             }
 
             //TODO call `start_debugger` at different stages for Editor/Game Runtimes.
-            start_debugger(p_params.debugger_port);
+            // nothing to do without a port (the port is never assigned to workers and shadow environments)
+            if (p_params.debugger_port != 0)
+            {
+                start_debugger(p_params.debugger_port);
+            }
         }
     }
 
@@ -404,6 +474,8 @@ namespace jsb
 #if JSB_WITH_ESSENTIALS
         timer_tags_.tags.clear();
         timer_manager_.clear_all();
+        animation_frame_callbacks_.clear();
+        physics_frame_callbacks_.clear();
 #endif
 
         for (IModuleResolver* resolver : module_resolvers_)
@@ -417,7 +489,11 @@ namespace jsb
             async_module_manager_ = nullptr;
         }
 
-        for (KeyValue<StringName, IModuleLoader*>& pair : module_loaders_)
+        // the pending streaming tasks reference the isolate
+        module_prefetcher_.clear();
+        resource_cache_.clear();
+
+        for (auto& pair : module_loaders_)
         {
             memdelete(pair.value);
             pair.value = nullptr;
@@ -427,6 +503,7 @@ namespace jsb
         string_name_cache_.clear();
 
         // cleanup all class templates (must do after objects cleaned up)
+        godot_object_classes_.clear();
         native_classes_.clear();
 
         isolate_->Dispose();
@@ -437,7 +514,11 @@ namespace jsb
 
     void Environment::init()
     {
-        jsb::DefaultModuleResolver& resolver = this->add_module_resolver<jsb::DefaultModuleResolver>()
+        // modules packed in the archive by the exporter (if any) are preferred over the individual files
+        const internal::ModuleArchive* archive = internal::ModuleArchive::get_packaged();
+        jsb::DefaultModuleResolver& resolver = (archive
+            ? this->add_module_resolver<jsb::ArchiveModuleResolver>(archive)
+            : this->add_module_resolver<jsb::DefaultModuleResolver>())
             .add_search_path(jsb::internal::Settings::get_jsb_out_res_path()) // default path of js source (results of compiled ts, at '.godot/GodotJS' by default)
             .add_search_path("res://") // use the root directory as custom lib path by default
             .add_search_path("res://node_modules") // so far, it's the only supported path for node_modules in GodotJS
@@ -449,14 +530,19 @@ namespace jsb
             "the embedded '%s' not found, run 'scons' again to refresh all *.gen.cpp sources", kRuntimeBundleFile);
         static constexpr char kEditorBundleFile[] = "jsb.editor.bundle.js";
 #ifdef TOOLS_ENABLED
-        jsb_ensuref(AMDModuleLoader::load_source(this, GodotJSProjectPreset::get_source_ed(kEditorBundleFile)) == OK,
-            "the embedded '%s' not found, run 'scons' again to refresh all *.gen.cpp sources", kEditorBundleFile);
-#else
+        // the editor scripts only run in the main environment (and the shadow environments evaluating the scripts for the editor),
+        // workers never use them, so they're spawned as fast as in runtime-only builds
+        if ((flags_ & EF_Worker) == 0)
+        {
+            jsb_ensuref(AMDModuleLoader::load_source(this, GodotJSProjectPreset::get_source_ed(kEditorBundleFile)) == OK,
+                "the embedded '%s' not found, run 'scons' again to refresh all *.gen.cpp sources", kEditorBundleFile);
+            return;
+        }
+#endif
         // Users may consume editor APIs in codegen functions. However, we want to permit regular ES6 import syntax.
         // We provide a dummy module that can be imported (but not used) in runtime-only builds.
         static constexpr char kDummyModule[] = u8"(function(define){define('jsb.editor.codegen',[],function(){return{}})})";
         AMDModuleLoader::load_source(this, kDummyModule, sizeof(kDummyModule) - 1, kEditorBundleFile);
-#endif
 
     }
 
@@ -464,7 +550,15 @@ namespace jsb
     {
         JSB_LOG(Verbose, "disposing Environment %s", (uintptr_t) id());
 
+#if JSB_WITH_WATCHDOG
+        if (watchdog_budget_usec_)
+        {
+            Watchdog::unregister(this);
+            watchdog_budget_usec_ = 0;
+        }
+#endif
         flags_ |= EF_PreDispose;
+        pending_property_values_.clear();
         // destroy context
         {
             v8::Isolate* isolate = this->isolate_;
@@ -475,6 +569,11 @@ namespace jsb
             function_refs_.clear();
             while (!function_bank_.is_empty()) function_bank_.remove_last();
             // function_bank_.clear();
+            while (!pending_tasks_.is_empty()) pending_tasks_.remove_last();
+            threaded_loads_.clear();
+#if !JSB_WITH_WEB
+            input_snapshots_.clear();
+#endif
 
 #if JSB_WITH_DEBUGGER
             debugger_.on_context_destroyed(context);
@@ -483,9 +582,12 @@ namespace jsb
             context->SetAlignedPointerInEmbedderData(kContextEmbedderData, nullptr);
 
             module_cache_.deinit();
+            require_factory_.Reset();
+            reflect_construct_.Reset();
             context_.Reset();
         }
 
+        batched_classes_.clear();
         while (!script_classes_.is_empty())
         {
             const ScriptClassID id = script_classes_.get_first_index();
@@ -507,6 +609,9 @@ namespace jsb
             JSB_LOG(VeryVerbose, " - %s", (uintptr_t) pointer);
             free_object(pointer, FinalizationType::Default /* Force? */);
         }
+        // both buffers may be pending
+        release_deferred_refs();
+        release_deferred_refs();
 
         variant_allocator_.drain();
         flags_ |= EF_PostDispose;
@@ -515,19 +620,40 @@ namespace jsb
 
     void Environment::update(uint64_t p_delta_msecs)
     {
+        _flush_batched_process();
+        _end_call_batch();
+
+#if !JSB_WITH_WEB
+        if (!input_snapshots_.is_empty())
+        {
+            const BridgeScope bridge_scope(this);
+            input_snapshots_.update(isolate_);
+        }
+#endif
+
 #if JSB_WITH_ESSENTIALS
         if (timer_manager_.tick(p_delta_msecs))
         {
-            v8::Isolate::Scope isolate_scope(isolate_);
-            v8::HandleScope handle_scope(isolate_);
+            const BridgeScope bridge_scope(this);
 
             //TODO be able to handle the uncaught exceptions in env (instead of being swallowed in the timer invocation).
             //     we need to forward it to onerror (if the current env is the master of a worker)
-            if (timer_manager_.invoke_timers(isolate_))
+            if (timer_manager_.invoke_timers(isolate_, timer_budget_usec_))
             {
                 notify_microtasks_run();
             }
         }
+        _end_call_batch();
+
+        if (!animation_frame_callbacks_.is_empty())
+        {
+            const BridgeScope bridge_scope(this);
+
+            // the timestamp (in milliseconds) is the same for all callbacks of this frame
+            animation_frame_callbacks_.invoke(isolate_, context_.Get(isolate_), (double) OS::get_singleton()->get_ticks_usec() / 1000.0);
+            notify_microtasks_run();
+            _end_call_batch();
+        }
 #endif
 
         // handle messages from workers
@@ -535,8 +661,7 @@ namespace jsb
             std::vector<Message>& messages = inbox_.swap();
             if (!messages.empty())
             {
-                v8::Isolate::Scope isolate_scope(isolate_);
-                v8::HandleScope handle_scope(isolate_);
+                const BridgeScope bridge_scope(this);
                 const v8::Local<v8::Context> context = context_.Get(isolate_);
 
                 for (const Message& message : messages)
@@ -544,150 +669,463 @@ namespace jsb
                     _on_worker_message(context, message);
                 }
                 messages.clear();
+                _end_call_batch();
             }
         }
 
         exec_async_calls();
+        release_deferred_refs();
 
-        // quickjs delayed the free op after all HandleScope left, we need to swap the free op list manually explicitly.
-        // otherwise, object may leak until next evacuation of HandleScope.
-#if JSB_WITH_QUICKJS || JSB_WITH_JAVASCRIPTCORE
-        isolate_->PerformMicrotaskCheckpoint();
-#else
-        if (flags_ & EF_MicrotaskCheckpoint)
+        if (async_module_manager_)
         {
-            flags_ &= ~EF_MicrotaskCheckpoint;
-            isolate_->PerformMicrotaskCheckpoint();
+            async_module_manager_->update(this);
+        }
+
+        if (!threaded_loads_.is_empty())
+        {
+            threaded_loads_.update(this);
         }
-#endif
+
+        perform_microtask_checkpoint();
 
 #if JSB_WITH_DEBUGGER
         debugger_.update();
 #endif
-        variant_allocator_.drain();
-    }
+        variant_allocator_.drain(JSB_VARIANT_DRAIN_BUDGET);
+        source_map_cache_.update();
 
-    // handle async calls (from InstanceBindingCallbacks)
-    void Environment::exec_async_calls()
-    {
-#if JSB_THREADING
-        std::vector<AsyncCall>& calls = async_calls_.swap();
-        if (!calls.empty())
+#if JSB_WITH_QUICKJS
+        // after all the frame work of this environment
+        if (gc_malloc_threshold_ != 0)
+        {
+            _run_scheduled_gc();
+        }
+
+        // quickjs has no callback near the limit, the allocated size is checked once per frame (only if tracked)
+        if (heap_limit_ != 0)
         {
-            for (const AsyncCall& call : calls)
+            const size_t allocated_size = impl::Helper::get_malloc_size(isolate_);
+            if (allocated_size > MAX(heap_limit_ / 10 * 9, heap_pressure_size_))
             {
-                exec_async_call(call.type_, call.binding_);
+                memory_pressure_ = true;
             }
-            calls.clear();
         }
 #endif
+        if (jsb_unlikely(memory_pressure_))
+        {
+            memory_pressure_ = false;
+            _on_memory_pressure();
+        }
     }
 
-    void Environment::exec_async_call(AsyncCall::Type p_type, void* p_binding)
+    void Environment::notify_frame_idle(uint64_t p_frame_ticks)
     {
-        switch (p_type)
+        if (prewarm_index_ < prewarm_classes_.size())
         {
-        case AsyncCall::TYPE_REF:       reference_object(p_binding, true); break;
-        case AsyncCall::TYPE_DEREF:     reference_object(p_binding, false); break;
-        case AsyncCall::TYPE_GC_FREE:   free_object(p_binding, FinalizationType::Default); break;
-        case AsyncCall::TYPE_TRANSFER_:
+            uint64_t budget_usec = JSB_PREWARM_CLASSES_FRAME_BUDGET_USEC;
+            if (const int max_fps = Engine::get_singleton()->get_max_fps(); max_fps > 0)
             {
-                //TODO need a better way to control lifetime of TransferData?
-                TransferData* transfer_data = (TransferData*) p_binding;
-                {
-                    v8::Isolate::Scope isolate_scope(isolate_);
-                    v8::HandleScope handle_scope(isolate_);
-                    const v8::Local<v8::Context> context = context_.Get(isolate_);
-                    const v8::Context::Scope context_scope(context);
-                    _on_worker_transfer(context, transfer_data);
-                }
-                memdelete(transfer_data);
+                const uint64_t frame_usec = 1000000ULL / (uint64_t) max_fps;
+                const uint64_t spent_usec = OS::get_singleton()->get_ticks_usec() - p_frame_ticks;
+                budget_usec = MAX(budget_usec, frame_usec > spent_usec ? frame_usec - spent_usec : 0);
             }
-            break;
-        case AsyncCall::TYPE_GC_REQUEST: _on_gc_request(); break;
-        default: jsb_checkf(false, "unknown AsyncCall: %d", p_type); break;
+            // the idle GC below is no more than the time left after it
+            flush_prewarm_classes(budget_usec);
         }
-    }
 
-    bool Environment::add_async_call(AsyncCall::Type p_type, void* p_binding)
-    {
-#if JSB_THREADING
-        if (Thread::get_caller_id() != thread_id_)
+#if JSB_WITH_V8
+        if (idle_gc_min_slack_usec_ == 0)
         {
-            async_calls_.add(AsyncCall(p_type, p_binding));
-            return true;
+            return;
         }
-#endif
-        exec_async_call(p_type, p_binding);
-        return true;
-    }
 
-    void Environment::_on_worker_transfer(const v8::Local<v8::Context>& p_context, const TransferData* p_data)
-    {
-        jsb_check(p_data->source_worker_id);
-        if (!object_db_.has_object(p_data->source_worker_id))
+        // no slack time to spend if the frame rate is not capped
+        const int max_fps = Engine::get_singleton()->get_max_fps();
+        if (max_fps <= 0)
         {
-            JSB_LOG(Error, "invalid worker");
             return;
         }
 
-        //TODO 0. HOW TO HANDLE COMPLICATED SITUATIONS? SUCH AS NESTED OBJECTS?
-        jsb_nop();
-
-        transfer_in(*p_data);
-
-        // call 'ontransfer'
+        const uint64_t frame_usec = 1000000ULL / (uint64_t) max_fps;
+        const uint64_t spent_usec = OS::get_singleton()->get_ticks_usec() - p_frame_ticks;
+        if (spent_usec + idle_gc_min_slack_usec_ > frame_usec)
         {
-            ObjectHandleConstPtr handle = object_db_.try_get_object(p_data->source_worker_id);
-            const v8::Local<v8::Object> worker = handle->ref_.Get(isolate_).As<v8::Object>();
-            jsb_check(!worker.IsEmpty());
-            handle = nullptr;
+            return;
+        }
 
-            v8::Local<v8::Value> transferred_obj;
-            if (!TypeConvert::gd_var_to_js(isolate_, p_context, p_data->variant, transferred_obj) || transferred_obj.IsEmpty())
+        v8::HeapStatistics heap_stats;
+        isolate_->GetHeapStatistics(&heap_stats);
+        if (idle_gc_done_heap_size_ != 0)
+        {
+            // nothing to do until more objects are allocated
+            if (heap_stats.used_heap_size() <= idle_gc_done_heap_size_)
             {
-                JSB_LOG(Error, "failed to convert object to JS");
                 return;
             }
+            idle_gc_done_heap_size_ = 0;
+        }
 
-            v8::Local<v8::Value> callback;
-            if (!worker->Get(p_context, jsb_name(this, ontransfer)).ToLocal(&callback) || !callback->IsFunction())
-            {
-                JSB_LOG(Error, "ontransfer is not a function");
-                return;
-            }
+        // the deadline is based on the timebase of the platform
+        const double deadline = impl::GlobalInitialize::get_platform()->MonotonicallyIncreasingTime() + (double) (frame_usec - spent_usec) / 1000000.0;
+        if (isolate_->IdleNotificationDeadline(deadline))
+        {
+            isolate_->GetHeapStatistics(&heap_stats);
+            idle_gc_done_heap_size_ = MAX(heap_stats.used_heap_size(), (size_t) 1);
+        }
+#endif
+    }
 
-            const impl::TryCatch try_catch(isolate_);
-            const v8::Local<v8::Function> call = callback.As<v8::Function>();
-            const v8::MaybeLocal<v8::Value> rval = call->Call(p_context, v8::Undefined(isolate_), 1, &transferred_obj);
-            jsb_unused(rval);
-            if (try_catch.has_caught())
+    void Environment::perform_microtask_checkpoint()
+    {
+        // quickjs delayed the free op after all HandleScope left, we need to swap the free op list manually explicitly.
+        // otherwise, object may leak until next evacuation of HandleScope.
+        // it's a cheap no-op if there are no pending jobs and no postponed free ops.
+        // (web.impl processes the objects finalized by the browser here in batch)
+#if JSB_WITH_QUICKJS || JSB_WITH_JAVASCRIPTCORE || JSB_WITH_WEB
+        {
+            const uint64_t microtask_begin_usec = OS::get_singleton()->get_ticks_usec();
+            isolate_->PerformMicrotaskCheckpoint();
+            const uint64_t microtask_end_usec = OS::get_singleton()->get_ticks_usec();
+            counters_.microtask_time_usec += microtask_end_usec - microtask_begin_usec;
+            // not traced if nothing to do (it's called unconditionally)
+            if (microtask_end_usec != microtask_begin_usec)
             {
-                JSB_LOG(Error, "%s", BridgeHelper::get_exception(try_catch));
+                JSB_TRACE_COMPLETE("microtask_checkpoint", microtask_begin_usec, microtask_end_usec);
             }
         }
+#else
+        if (flags_ & EF_MicrotaskCheckpoint)
+        {
+            flags_ &= ~EF_MicrotaskCheckpoint;
+            const uint64_t microtask_begin_usec = OS::get_singleton()->get_ticks_usec();
+            isolate_->PerformMicrotaskCheckpoint();
+            const uint64_t microtask_end_usec = OS::get_singleton()->get_ticks_usec();
+            counters_.microtask_time_usec += microtask_end_usec - microtask_begin_usec;
+            JSB_TRACE_COMPLETE("microtask_checkpoint", microtask_begin_usec, microtask_end_usec);
+        }
+#endif
     }
 
-    void _invoke(Environment* p_env, const v8::Local<v8::Context>& p_context, const v8::Local<v8::Function>& p_callback, const Message* p_message)
+    void Environment::physics_update(double p_delta)
     {
-        v8::Isolate *isolate = p_env->get_isolate();
-
-#if !JSB_WITH_WEB && !JSB_WITH_JAVASCRIPTCORE
-        v8::Local<v8::Value> value;
-        if (p_message)
+#if JSB_WITH_ESSENTIALS
+        if (physics_frame_callbacks_.is_empty())
         {
-#if JSB_WITH_V8
-            Serialization::VariantDeserializerDelegate delegate(p_env, p_message->get_transfers());
-            v8::ValueDeserializer deserializer(isolate, p_message->get_buffer().ptr(), p_message->get_buffer().size(), &delegate);
-            delegate.SetSerializer(&deserializer);
+            return;
+        }
+
+        const BridgeScope bridge_scope(this);
+        physics_frame_callbacks_.invoke(isolate_, context_.Get(isolate_), p_delta);
+        notify_microtasks_run();
+
+        // run the microtasks in the same physics step, instead of deferring them to the next `update`
+        perform_microtask_checkpoint();
 #else
-            v8::ValueDeserializer deserializer(isolate, p_message->get_buffer().ptr(), p_message->get_buffer().size());
+        jsb_unused(p_delta);
 #endif
+    }
 
-            bool ok;
-            if (!deserializer.ReadHeader(p_context).To(&ok) || !ok)
-            {
-                JSB_LOG(Error, "failed to parse message header");
+    // handle async calls (from InstanceBindingCallbacks)
+    void Environment::exec_async_calls()
+    {
+#if JSB_THREADING
+        // take the whole batch out of the queue, the calls may post new ones (handled in the next update)
+        std::vector<AsyncCall> calls;
+        calls.swap(async_calls_.swap());
+
+        // a binding freed in this batch dominates the other operations on it (duplicated frees and reference changes are dropped)
+        HashSet<void*> freed_bindings;
+        bool gc_requested = false;
+        for (AsyncCall& call : calls)
+        {
+            switch (call.type_)
+            {
+            case AsyncCall::TYPE_GC_FREE:
+                if (freed_bindings.has(call.binding_)) call.type_ = AsyncCall::TYPE_NONE;
+                else freed_bindings.insert(call.binding_);
+                break;
+            case AsyncCall::TYPE_GC_REQUEST:
+                // coalesced into a single request after all other calls
+                gc_requested = true;
+                call.type_ = AsyncCall::TYPE_NONE;
+                break;
+            default: break;
+            }
+        }
+
+        // the net changes of references are applied before the other calls
+        {
+            LocalVector<KeyValue<void*, int32_t>> references;
+            {
+                MutexLock lock(pending_references_lock_);
+                if (!pending_references_.is_empty())
+                {
+                    references.reserve(pending_references_.size());
+                    for (const KeyValue<void*, int32_t>& kv : pending_references_)
+                    {
+                        // a REF followed by a DEREF cancels out
+                        if (kv.value != 0 && !freed_bindings.has(kv.key)) references.push_back(kv);
+                    }
+                    pending_references_.clear();
+                }
+            }
+            for (const KeyValue<void*, int32_t>& kv : references)
+            {
+                reference_object(kv.key, kv.value);
+            }
+        }
+
+        for (const AsyncCall& call : calls)
+        {
+            if (call.type_ != AsyncCall::TYPE_NONE)
+            {
+                exec_async_call(call.type_, call.binding_);
+            }
+        }
+        if (gc_requested)
+        {
+            exec_async_call(AsyncCall::TYPE_GC_REQUEST, nullptr);
+        }
+#endif
+    }
+
+#if JSB_WITH_WATCHDOG
+    void Environment::_disarm_watchdog()
+    {
+        uint64_t deadline = watchdog_deadline_usec_.load(std::memory_order_acquire);
+        while (true)
+        {
+            // the watchdog thread is requesting the interruption, wait for it to avoid terminating the next call
+            if (deadline == Watchdog::kFiring)
+            {
+                std::this_thread::yield();
+                deadline = watchdog_deadline_usec_.load(std::memory_order_acquire);
+                continue;
+            }
+            if (watchdog_deadline_usec_.compare_exchange_weak(deadline, 0, std::memory_order_acq_rel)) break;
+        }
+        if (deadline == Watchdog::kFired)
+        {
+            isolate_->CancelTerminateExecution();
+        }
+    }
+#endif
+
+    void Environment::release_deferred_refs()
+    {
+        std::vector<v8::Global<v8::Object>>& refs = deferred_refs_.swap();
+        if (!refs.empty())
+        {
+            JSB_LOG(VeryVerbose, "release %d deferred object references", (int) refs.size());
+            for (v8::Global<v8::Object>& ref : refs)
+            {
+                ref.Reset();
+            }
+            refs.clear();
+        }
+    }
+
+    void Environment::wake_up()
+    {
+        // only the first request since the last wake-up needs to notify
+        if (!wake_requested_.exchange(true, std::memory_order_acq_rel))
+        {
+            std::lock_guard lock(wake_mutex_);
+            wake_cv_.notify_one();
+        }
+    }
+
+    void Environment::wait_for_wake_up(uint64_t p_timeout_msec)
+    {
+        if (p_timeout_msec != 0)
+        {
+            std::unique_lock lock(wake_mutex_);
+            wake_cv_.wait_for(lock, std::chrono::milliseconds(p_timeout_msec),
+                [this] { return wake_requested_.load(std::memory_order_acquire); });
+        }
+        wake_requested_.store(false, std::memory_order_release);
+    }
+
+    uint64_t Environment::get_idle_time(uint64_t p_max_msec) const
+    {
+        uint64_t idle_time = p_max_msec;
+#if JSB_WITH_ESSENTIALS
+        idle_time = timer_manager_.get_next_delay(idle_time);
+        if (!animation_frame_callbacks_.is_empty())
+        {
+            idle_time = MIN(idle_time, (uint64_t) JSB_WORKER_POLL_INTERVAL);
+        }
+#endif
+        if (async_module_manager_ && async_module_manager_->is_prefetching())
+        {
+            idle_time = MIN(idle_time, (uint64_t) JSB_WORKER_POLL_INTERVAL);
+        }
+        return idle_time;
+    }
+
+    void Environment::exec_async_call(AsyncCall::Type p_type, void* p_binding)
+    {
+        switch (p_type)
+        {
+        case AsyncCall::TYPE_REF:       reference_object(p_binding, true); break;
+        case AsyncCall::TYPE_DEREF:     reference_object(p_binding, false); break;
+        case AsyncCall::TYPE_GC_FREE:   free_object(p_binding, FinalizationType::Default); break;
+#if JSB_V8_CPPGC
+        case AsyncCall::TYPE_GC_FREE_ID:
+            {
+                void* pointer = nullptr;
+                // release the handle (and the lock of object_db_) before freeing
+                if (const ObjectHandleConstPtr handle = object_db_.try_get_object(NativeObjectID((uint64_t)(uintptr_t) p_binding)))
+                {
+                    pointer = handle->pointer;
+                }
+                if (pointer) free_object(pointer, FinalizationType::Default);
+            }
+            break;
+#endif
+        case AsyncCall::TYPE_TRANSFER_:
+            {
+                //TODO need a better way to control lifetime of TransferData?
+                TransferData* transfer_data = (TransferData*) p_binding;
+                {
+                    const BridgeScope bridge_scope(this);
+                    const v8::Local<v8::Context> context = context_.Get(isolate_);
+                    _on_worker_transfer(context, transfer_data);
+                }
+                memdelete(transfer_data);
+            }
+            break;
+        case AsyncCall::TYPE_GC_REQUEST: _on_gc_request(); break;
+        case AsyncCall::TYPE_LOW_MEMORY: trim_memory(); break;
+#if !JSB_WITH_WEB
+        case AsyncCall::TYPE_TASK_DONE: WorkerTaskPool::on_task_done(this, (WorkerTask*) p_binding); break;
+        case AsyncCall::TYPE_SERVER_QUERY_DONE: ServerQueries::on_query_done(this, (ServerQuery*) p_binding); break;
+        case AsyncCall::TYPE_FILE_IO_DONE: AsyncFileIO::on_request_done(this, (FileRequest*) p_binding); break;
+#endif
+#if JSB_THREADING
+        case AsyncCall::TYPE_SCRIPT_CALL:
+            {
+                DeferredScriptCall* call = (DeferredScriptCall*) p_binding;
+                // the script class may be reloaded and the object may be gone since the call was queued
+                if (script_classes_.is_valid_index(call->class_id) && object_db_.has_object(call->object_id))
+                {
+                    const int argc = (int) call->args.size();
+                    internal::ScratchArena::Scope scratch;
+                    const Variant** argv = scratch.alloc<const Variant*>(argc);
+                    for (int index = 0; index < argc; ++index)
+                    {
+                        argv[index] = &call->args[index];
+                    }
+                    Callable::CallError error;
+                    call_script_method(call->class_id, call->object_id, call->method, argv, argc, error);
+                    if (error.error != Callable::CallError::CALL_OK && error.error != Callable::CallError::CALL_ERROR_INVALID_METHOD)
+                    {
+                        JSB_LOG(Error, "deferred script call %s failed (%d)", call->method, error.error);
+                    }
+                }
+                memdelete(call);
+            }
+            break;
+#endif
+        default: jsb_checkf(false, "unknown AsyncCall: %d", p_type); break;
+        }
+    }
+
+    bool Environment::add_async_call(AsyncCall::Type p_type, void* p_binding)
+    {
+#if JSB_THREADING
+        if (Thread::get_caller_id() != thread_id_)
+        {
+            if (p_type == AsyncCall::TYPE_REF || p_type == AsyncCall::TYPE_DEREF)
+            {
+                {
+                    MutexLock lock(pending_references_lock_);
+                    int32_t& delta = pending_references_[p_binding];
+                    delta += p_type == AsyncCall::TYPE_REF ? 1 : -1;
+                }
+                wake_up();
+                return true;
+            }
+            async_calls_.add(AsyncCall(p_type, p_binding));
+            wake_up();
+            return true;
+        }
+#endif
+        exec_async_call(p_type, p_binding);
+        return true;
+    }
+
+    void Environment::_on_worker_transfer(const v8::Local<v8::Context>& p_context, const TransferData* p_data)
+    {
+        jsb_check(p_data->source_worker_id);
+        if (!object_db_.has_object(p_data->source_worker_id))
+        {
+            JSB_LOG(Error, "invalid worker");
+            return;
+        }
+
+        //TODO 0. HOW TO HANDLE COMPLICATED SITUATIONS? SUCH AS NESTED OBJECTS?
+        jsb_nop();
+
+        transfer_in(*p_data);
+
+        // call 'ontransfer'
+        {
+            ObjectHandleConstPtr handle = object_db_.try_get_object(p_data->source_worker_id);
+            const v8::Local<v8::Object> worker = handle->ref_.Get(isolate_).As<v8::Object>();
+            jsb_check(!worker.IsEmpty());
+            handle = nullptr;
+
+            v8::Local<v8::Value> transferred_obj;
+            if (!TypeConvert::gd_var_to_js(isolate_, p_context, p_data->variant, transferred_obj) || transferred_obj.IsEmpty())
+            {
+                JSB_LOG(Error, "failed to convert object to JS");
+                return;
+            }
+
+            v8::Local<v8::Value> callback;
+            if (!worker->Get(p_context, jsb_name(this, ontransfer)).ToLocal(&callback) || !callback->IsFunction())
+            {
+                JSB_LOG(Error, "ontransfer is not a function");
+                return;
+            }
+
+            const impl::TryCatch try_catch(isolate_);
+            const v8::Local<v8::Function> call = callback.As<v8::Function>();
+            const v8::MaybeLocal<v8::Value> rval = call->Call(p_context, v8::Undefined(isolate_), 1, &transferred_obj);
+            jsb_unused(rval);
+            if (try_catch.has_caught())
+            {
+                JSB_LOG(Error, "%s", BridgeHelper::get_exception(try_catch));
+            }
+        }
+    }
+
+    // call `p_callback` with the value of `p_message` (or without arguments if no message),
+    // the elements of a batch are passed one by one if `p_spread` (`onmessage` for messages posted by `postMessages`)
+    void _invoke(Environment* p_env, const v8::Local<v8::Context>& p_context, const v8::Local<v8::Function>& p_callback, const Message* p_message, bool p_spread = false)
+    {
+        v8::Isolate *isolate = p_env->get_isolate();
+
+#if !JSB_WITH_WEB
+        v8::Local<v8::Value> value;
+        if (p_message)
+        {
+#if JSB_WITH_VARIANT_SERIALIZATION
+            Serialization::VariantDeserializerDelegate delegate(p_env, p_message->get_transfers(), p_message->get_backing_stores());
+            v8::ValueDeserializer deserializer(isolate, p_message->get_buffer().ptr(), p_message->get_buffer().size(), &delegate);
+            delegate.SetSerializer(&deserializer);
+#if JSB_WITH_V8
+            delegate.TransferArrayBuffers(isolate);
+#endif
+#else
+            v8::ValueDeserializer deserializer(isolate, p_message->get_buffer().ptr(), p_message->get_buffer().size());
+#endif
+
+            bool ok;
+            if (!deserializer.ReadHeader(p_context).To(&ok) || !ok)
+            {
+                JSB_LOG(Error, "failed to parse message header");
                 return;
             }
 
@@ -698,6 +1136,29 @@ namespace jsb
             }
         }
 
+        if (p_spread && value->IsArray())
+        {
+            const v8::Local<v8::Array> batch = value.As<v8::Array>();
+            const uint32_t len = batch->Length();
+            for (uint32_t index = 0; index < len; ++index)
+            {
+                v8::Local<v8::Value> element;
+                if (!batch->Get(p_context, index).ToLocal(&element))
+                {
+                    JSB_LOG(Error, "failed to read message %d of batch", index);
+                    return;
+                }
+                const impl::TryCatch try_catch(isolate);
+                const v8::MaybeLocal<v8::Value> rval = p_callback->Call(p_context, v8::Undefined(isolate), 1, &element);
+                jsb_unused(rval);
+                if (try_catch.has_caught())
+                {
+                    JSB_LOG(Error, "%s", BridgeHelper::get_exception(try_catch));
+                }
+            }
+            return;
+        }
+
         const impl::TryCatch try_catch(isolate);
         const v8::MaybeLocal<v8::Value> rval = p_message
             ? p_callback->Call(p_context, v8::Undefined(isolate), 1, &value)
@@ -714,6 +1175,7 @@ namespace jsb
 
     void Environment::_on_worker_message(const v8::Local<v8::Context>& p_context, const Message& p_message)
     {
+        JSB_TRACE_SCOPE("on_worker_message");
         jsb_check(p_message.get_id());
         ObjectHandleConstPtr handle = object_db_.try_get_object(p_message.get_id());
         if (!handle)
@@ -736,6 +1198,20 @@ namespace jsb
             }
             _invoke(this, p_context, callback.As<v8::Function>(), &p_message);
             break;
+        case Message::TYPE_MESSAGES:
+            // the whole batch in one call if `onmessages` is provided, otherwise one `onmessage` call per message
+            if (obj->Get(p_context, jsb_name(this, onmessages)).ToLocal(&callback) && callback->IsFunction())
+            {
+                _invoke(this, p_context, callback.As<v8::Function>(), &p_message);
+                break;
+            }
+            if (!obj->Get(p_context, jsb_name(this, onmessage)).ToLocal(&callback) || !callback->IsFunction())
+            {
+                JSB_LOG(Error, "onmessage is not a function");
+                return;
+            }
+            _invoke(this, p_context, callback.As<v8::Function>(), &p_message, true);
+            break;
         case Message::TYPE_READY:
             if (!obj->Get(p_context, jsb_name(this, onready)).ToLocal(&callback) || !callback->IsFunction())
             {
@@ -768,7 +1244,7 @@ namespace jsb
         return EnvironmentStore::get_shared().access();
     }
 
-    NativeObjectID Environment::bind_godot_object(NativeClassID p_class_id, Object* p_pointer, const v8::Local<v8::Object>& p_object)
+    NativeObjectID Environment::bind_godot_object(NativeClassID p_class_id, Object* p_pointer, const v8::Local<v8::Object>& p_object, bool p_weak)
     {
         // handle the shadow instance created by asynchronous ResourceLoader
         if (ScriptInstance* si = p_pointer->get_script_instance(); si && !si->is_placeholder())
@@ -817,7 +1293,14 @@ namespace jsb
             // otherwise, it will be strongly referenced in JS until all external references are released (unreference).
             external_rc = ref_counted->get_reference_count() - 1;
         }
+        else if (p_weak && weak_engine_object_wrappers_)
+        {
+            // the engine owns the object, the wrapper is recreated if it's requested again after collected
+            external_rc = 0;
+            weak_objects_.insert(p_pointer);
+        }
         const NativeObjectID object_id = bind_pointer(p_class_id, NativeClassType::GodotObject, (void*) p_pointer, p_object, external_rc);
+        ++counters_.object_bindings;
 
         p_pointer->get_instance_binding(this, gd_instance_binding_callbacks);
         return object_id;
@@ -838,15 +1321,16 @@ namespace jsb
         p_object->SetAlignedPointerInInternalFields(IF_ObjectFieldCount, indices, internal_fields);
 
         handle->class_id = p_class_id;
-#if JSB_DEBUG
-        handle->pointer = p_pointer;
-#endif
 
         jsb_v8_check(native_classes_.get_value(p_class_id).type == p_type);
         handle->ref_.Reset(isolate_, p_object);
+#if JSB_V8_CPPGC
+        // the object id is posted instead of the pointer, a stale finalization is ignored if the binding is already broken
+        impl::CppgcWrappable::wrap(isolate_, p_object, (void*)(uintptr_t) *object_id, 0, &object_wrappable_deleter, this);
+#endif
         if (p_external_rc == 0)
         {
-            handle->ref_.SetWeak(p_pointer, &object_gc_callback, v8::WeakCallbackType::kInternalFields);
+            set_weak_binding(handle->ref_, p_pointer);
         }
         else
         {
@@ -879,7 +1363,7 @@ namespace jsb
         return p_obj->GetAlignedPointerFromInternalField(IF_Pointer);
     }
 
-    bool Environment::reference_object(void* p_pointer, bool p_is_inc)
+    bool Environment::reference_object(void* p_pointer, int32_t p_delta)
     {
         check_internal_state();
         const ObjectHandlePtr object_handle = object_db_.try_get_object(p_pointer);
@@ -893,7 +1377,7 @@ namespace jsb
         // jsb_check(native_classes_.get_value(object_handle->class_id).type != NativeClassType::GodotPrimitive);
 
         // adding references
-        if (p_is_inc)
+        if (p_delta > 0)
         {
             if (object_handle->ref_count_ == 0)
             {
@@ -901,18 +1385,22 @@ namespace jsb
                 jsb_check(!object_handle->ref_.IsEmpty());
                 object_handle->ref_.ClearWeak();
             }
-            ++object_handle->ref_count_;
+            object_handle->ref_count_ += p_delta;
+            return true;
+        }
+        if (p_delta == 0)
+        {
             return true;
         }
 
         // removing references
         jsb_checkf(!object_handle->ref_.IsEmpty(), "removing references on dead values");
-        jsb_check(object_handle->ref_count_ > 0);
+        jsb_check(object_handle->ref_count_ >= -p_delta);
 
-        --object_handle->ref_count_;
+        object_handle->ref_count_ += p_delta;
         if (object_handle->ref_count_ == 0)
         {
-            object_handle->ref_.SetWeak(p_pointer, &object_gc_callback, v8::WeakCallbackType::kInternalFields);
+            set_weak_binding(object_handle->ref_, p_pointer);
         }
         return true;
     }
@@ -931,22 +1419,25 @@ namespace jsb
     void Environment::free_object(void* p_pointer, FinalizationType p_finalize)
     {
         check_internal_state();
-        ObjectHandlePtr object_handle = object_db_.try_get_object(p_pointer);
+        NativeClassID class_id;
+        uint32_t ref_count;
+        // hold it in a local variable to avoid gc too early
+        v8::Global<v8::Object> obj_ref;
 
         // avoid crash in the situation that `InstanceBindingCallbacks::free_callback` is called before JS object gc callback is called,
         // which makes the pointer already erased in `object_gc_callback`
-        if (jsb_unlikely(!object_handle))
+        if (jsb_unlikely(!object_db_.try_remove_object(p_pointer, class_id, ref_count, obj_ref)))
         {
             return;
         }
 
-#if JSB_DEBUG
-        jsb_check(object_handle->pointer == p_pointer);
+#if JSB_THREADING
+        {
+            // the address may be reused by another object, drop the pending changes of references
+            MutexLock lock(pending_references_lock_);
+            pending_references_.erase(p_pointer);
+        }
 #endif
-        const NativeClassID class_id = object_handle->class_id;
-        // hold it in a local variable to avoid gc too early
-        v8::Global<v8::Object> obj_ref = std::move(object_handle->ref_);
-
         //TODO do not clear the internal field if calling from JS GC
         // if (p_finalize != FinalizationType::None)
         // {
@@ -956,14 +1447,22 @@ namespace jsb
         //     clear_internal_field(isolate_, obj_ref);
         // }
 
-        object_handle = nullptr;
-        object_db_.remove_object(p_pointer);
-        obj_ref.Reset();
+        if (p_finalize == FinalizationType::None && ref_count != 0)
+        {
+            // the object is destroyed by godot (e.g. freeing a whole scene tree), the strong reference can not trigger any weak callback,
+            // so it's safe to postpone the release of it and do it in bulk in `release_deferred_refs` (on the environment thread)
+            deferred_refs_.add(std::move(obj_ref));
+        }
+        else
+        {
+            obj_ref.Reset();
+        }
 
         if (p_finalize != FinalizationType::None)
         {
             const NativeClassInfo& class_info = native_classes_.get_value(class_id);
-            const bool is_persistent = persistent_objects_.erase(p_pointer);
+            const bool is_weak = weak_objects_.erase(p_pointer);
+            const bool is_persistent = persistent_objects_.erase(p_pointer) || is_weak;
 
             JSB_LOG(VeryVerbose, "free_object class:%s(%d) addr:%d",
                 (String) class_info.name, class_id,
@@ -974,6 +1473,7 @@ namespace jsb
         }
         else
         {
+            weak_objects_.erase(p_pointer);
             jsb_check(!persistent_objects_.has(p_pointer));
             JSB_LOG(VeryVerbose, "(skip) free_object class_id:%d addr:%d", class_id, (uintptr_t) p_pointer);
         }
@@ -1000,44 +1500,215 @@ namespace jsb
         r_stats.cached_string_names = string_name_cache_.size();
         r_stats.persistent_objects = persistent_objects_.size();
         r_stats.allocated_variants = variant_allocator_.get_allocated_num();
+
+        r_stats.counters = counters_;
+        r_stats.counters.variant_allocs = variant_allocator_.get_total_allocs_num();
+        r_stats.counters.variant_frees = variant_allocator_.get_total_frees_num();
+        r_stats.counters.string_name_hits = string_name_cache_.get_hits();
+        r_stats.counters.string_name_misses = string_name_cache_.get_misses();
+        r_stats.counters.string_name_evictions = string_name_cache_.get_evictions();
+        r_stats.counters.bridge_calls = script_epoch_ - 1;
+    }
+
+    void Environment::get_heap_snapshot(HeapSnapshot& r_snapshot) const
+    {
+        check_internal_state();
+        r_snapshot.time_usec = OS::get_singleton()->get_ticks_usec();
+        impl::Helper::get_heap_summary(isolate_, r_snapshot.js_heap);
+
+        HashMap<uint32_t, int> indices;
+        object_db_.for_each_object([&](const ObjectHandleConst& p_handle)
+        {
+            int* index = indices.getptr(*p_handle.class_id);
+            if (!index)
+            {
+                String name = "(unknown)";
+                if (native_classes_.is_valid_index(p_handle.class_id))
+                {
+                    name = native_classes_.get_value(p_handle.class_id).name;
+                }
+                index = &indices.insert(*p_handle.class_id, r_snapshot.native_objects.size())->value;
+                r_snapshot.native_objects.append({ name });
+            }
+            HeapSnapshot::NativeClassEntry& entry = r_snapshot.native_objects.write[*index];
+            ++entry.objects;
+            if (p_handle.ref_count_ > 0) ++entry.strong;
+        });
+        struct ObjectsComparator
+        {
+            bool operator()(const HeapSnapshot::NativeClassEntry& a, const HeapSnapshot::NativeClassEntry& b) const { return a.objects > b.objects; }
+        };
+        r_snapshot.native_objects.sort_custom<ObjectsComparator>();
+
+        r_snapshot.cached_string_names = string_name_cache_.size();
+        r_snapshot.string_name_cache_capacity = StringNameCache::get_max_size();
+    }
+
+    internal::Index32 Environment::add_pending_task(const v8::Local<v8::Promise::Resolver>& p_resolver)
+    {
+        return pending_tasks_.add(v8::Global<v8::Promise::Resolver>(isolate_, p_resolver));
+    }
+
+    bool Environment::take_pending_task(internal::Index32 p_id, v8::Global<v8::Promise::Resolver>& r_resolver)
+    {
+        v8::Global<v8::Promise::Resolver>* resolver;
+        if (!pending_tasks_.try_get_value_pointer(p_id, resolver))
+        {
+            return false;
+        }
+        r_resolver = std::move(*resolver);
+        pending_tasks_.remove_at_checked(p_id);
+        return true;
     }
 
     ObjectCacheID Environment::get_cached_function(const v8::Local<v8::Function>& p_func)
     {
         v8::Isolate* isolate = get_isolate();
-        const auto& it = function_refs_.find(TWeakRef(isolate, p_func));
-        if (it != function_refs_.end())
+        const uint32_t hash = (uint32_t) p_func->GetIdentityHash();
+        for (auto [it, end] = function_refs_.equal_range(hash); it != end; ++it)
         {
             const ObjectCacheID callback_id = it->second;
             TStrongRef<v8::Function>& strong_ref = function_bank_.get_value(callback_id);
-            strong_ref.ref();
-            return callback_id;
+            if (strong_ref.object_ == p_func)
+            {
+                strong_ref.ref();
+                return callback_id;
+            }
         }
         const ObjectCacheID new_id = function_bank_.add(TStrongRef(isolate, p_func));
-        function_refs_.insert(std::pair(TWeakRef(isolate, p_func), new_id));
+        function_refs_.insert(std::pair(hash, new_id));
         return new_id;
     }
 
-    void Environment::scan_external_changes()
+#if JSB_SUPPORT_RELOAD && defined(TOOLS_ENABLED)
+    Vector<StringName> Environment::_get_reload_order(const Vector<StringName>& p_changed_modules) const
+    {
+        // reversed post-order of DFS along the edges from dependencies to dependents (cycles are broken at the first visited module)
+        Vector<StringName> post_order;
+        HashSet<StringName> visited;
+        LocalVector<Pair<StringName, bool>> stack;
+        for (int i = p_changed_modules.size() - 1; i >= 0; --i)
+        {
+            stack.push_back({ p_changed_modules[i], false });
+        }
+        while (!stack.is_empty())
+        {
+            const Pair<StringName, bool> top = stack[stack.size() - 1];
+            stack.remove_at(stack.size() - 1);
+            if (top.second)
+            {
+                post_order.append(top.first);
+                continue;
+            }
+            if (visited.has(top.first)) continue;
+            visited.insert(top.first);
+            stack.push_back({ top.first, true });
+            if (const JavaScriptModule* module = module_cache_.find(top.first))
+            {
+                for (const StringName& dependent : module->dependents)
+                {
+                    if (!visited.has(dependent)) stack.push_back({ dependent, false });
+                }
+            }
+        }
+        post_order.reverse();
+        return post_order;
+    }
+#endif
+
+    void Environment::scan_external_changes(Vector<StringName>* r_script_modules)
     {
         check_internal_state();
         Vector<StringName> requested_modules;
-        for (const KeyValue<StringName, JavaScriptModule*>& kv : module_cache_.modules_)
+
+        // new files may shadow the previously resolved ones (e.g. `foo.js` over `foo/index.js`), and the failed ones may exist now
+        DefaultModuleResolver::invalidate_resolution_caches();
+#if JSB_WITH_THREADED_SCRIPT_PRELOAD
+        ModulePrefetcher::clear_preloaded();
+#endif
+#if JSB_SUPPORT_RELOAD && defined(TOOLS_ENABLED)
+        if (!file_watcher_created_)
+        {
+            file_watcher_created_ = true;
+            file_watcher_ = internal::FileWatcher::create();
+        }
+        if (file_watcher_)
+        {
+            // only the notified files are checked (if no notification is lost)
+            HashSet<String> changed_paths;
+            const bool full_scan = !file_watcher_->poll(changed_paths);
+            for (const String& path : changed_paths)
+            {
+                const StringName* module_id = watched_paths_.getptr(path);
+                if (!module_id) continue;
+                JavaScriptModule* module = module_cache_.find(*module_id);
+                if (module && !module->script_class_id && module->mark_as_reloading())
+                {
+                    requested_modules.append(module->id);
+                }
+            }
+
+            // modules not watched yet (loaded since the last scan, or failed to watch) are checked as usual
+            for (const KeyValue<StringName, JavaScriptModule*>& kv : module_cache_.modules_)
+            {
+                JavaScriptModule* module = kv.value;
+                if (module->script_class_id) continue;
+                if (!full_scan && watched_modules_.has(module->id)) continue;
+                if (module->is_reloadable() && !watched_modules_.has(module->id))
+                {
+                    // watch it before checking, so that no change is missed in between
+                    const String path = ProjectSettings::get_singleton()->globalize_path(module->source_info.source_filepath);
+                    if (file_watcher_->add_directory(path.get_base_dir()))
+                    {
+                        watched_modules_.insert(module->id);
+                        watched_paths_.insert(path, module->id);
+                    }
+                }
+                if (module->mark_as_reloading())
+                {
+                    requested_modules.append(module->id);
+                }
+            }
+        }
+        else
+#endif
         {
-            JavaScriptModule* module = kv.value;
-            // skip script modules which are managed by the godot editor
-            if (module->script_class_id) continue;
-            if (module->mark_as_reloading())
+            for (const KeyValue<StringName, JavaScriptModule*>& kv : module_cache_.modules_)
             {
-                requested_modules.append(module->id);
+                JavaScriptModule* module = kv.value;
+                // skip script modules which are managed by the godot editor
+                if (module->script_class_id) continue;
+                if (module->mark_as_reloading())
+                {
+                    requested_modules.append(module->id);
+                }
             }
         }
 
+#if JSB_SUPPORT_RELOAD && defined(TOOLS_ENABLED)
+        // the dependents still hold the stale exports, only the affected subgraph is reloaded, and other modules are left untouched
+        const Vector<StringName> reload_order = _get_reload_order(requested_modules);
+        for (const StringName& id : reload_order)
+        {
+            JavaScriptModule* module = module_cache_.find(id);
+            if (!module) continue;
+            module->reload_requested = true;
+            if (module->script_class_id)
+            {
+                // reloaded by GodotJSScript (to rebind the instances)
+                if (r_script_modules) r_script_modules->append(id);
+                continue;
+            }
+            JSB_LOG(Verbose, "changed module check: %s", id);
+            load(id);
+        }
+#else
         for (const StringName& id : requested_modules)
         {
             JSB_LOG(Verbose, "changed module check: %s", id);
             load(id);
         }
+#endif
     }
 
     ModuleReloadResult::Type Environment::mark_as_reloading(const StringName& p_name)
@@ -1056,6 +1727,19 @@ namespace jsb
     }
 
     JavaScriptModule* Environment::_load_module(const String& p_parent_id, const String& p_module_id)
+    {
+        JavaScriptModule* module = _load_module_unrecorded(p_parent_id, p_module_id);
+#if JSB_SUPPORT_RELOAD && defined(TOOLS_ENABLED)
+        // record the dependency graph for reloading
+        if (module && !p_parent_id.is_empty() && module->id != StringName(p_parent_id))
+        {
+            module->dependents.insert(p_parent_id);
+        }
+#endif
+        return module;
+    }
+
+    JavaScriptModule* Environment::_load_module_unrecorded(const String& p_parent_id, const String& p_module_id)
     {
         JSB_BENCHMARK_SCOPE(JSRealm, _load_module);
         JavaScriptModule* existing_module = module_cache_.find(p_module_id);
@@ -1192,16 +1876,20 @@ namespace jsb
     {
         this->check_internal_state();
         v8::Isolate* isolate = get_isolate();
-        v8::Isolate::Scope isolate_scope(isolate);
-        v8::HandleScope handle_scope(isolate);
+        const BridgeScope bridge_scope(this);
         v8::Local<v8::Context> context = context_.Get(isolate);
-        v8::Context::Scope context_scope(context);
 
         // Can occur at runtime if object.set_script(...) is used, or in the editor due to hot-reloading etc.
         if (const NativeObjectID object_id = this->try_get_object_id(p_this))
         {
             JSB_LOG(Verbose, "crossbinding on previously bound object %d (addr:%d), rebind it to script class %d", object_id, (uintptr_t) p_this, p_class_id);
 
+            // the script instance keeps its state in the JS object, it must not be collected anymore
+            if (weak_objects_.erase(p_this))
+            {
+                reference_object(p_this, true);
+            }
+
             //TODO may not work in this way
             _rebind(isolate, context, p_this, p_class_id);
             return object_id;
@@ -1209,11 +1897,18 @@ namespace jsb
 
         StringName js_class_name;
         v8::Local<v8::Object> class_obj;
+        v8::Local<v8::Function> new_target;
 
+        // the `new.target` carries the object to bind, it can't be shared by the nested crossbinds (e.g. instantiating a scene in a constructor)
+        const bool reentered = crossbind_depth_ != 0;
         {
             const ScriptClassInfoPtr class_info = this->get_script_class(p_class_id);
             js_class_name = class_info->js_class_name;
             class_obj = class_info->js_class.Get(isolate);
+            if (!reentered && !class_info->crossbind_target.IsEmpty())
+            {
+                new_target = class_info->crossbind_target.Get(isolate);
+            }
             JSB_LOG(VeryVerbose, "crossbind %s %s(%d) %d", class_info->js_class_name, class_info->native_class_name, class_info->native_class_id, (uintptr_t) p_this);
             jsb_check(!class_obj->IsNullOrUndefined());
         }
@@ -1236,13 +1931,24 @@ namespace jsb
 
         const impl::TryCatch try_catch_run(isolate);
 
-        v8::Local<v8::Value> class_prototype = class_obj->Get(context, jsb_name(this, prototype)).ToLocalChecked();
-        v8::Local<v8::Function> new_target = impl::Helper::new_noop_function(isolate_, context);
-        new_target->Set(context, jsb_name(this, prototype), class_prototype).Check();
+        if (new_target.IsEmpty())
+        {
+            v8::Local<v8::Value> class_prototype = class_obj->Get(context, jsb_name(this, prototype)).ToLocalChecked();
+            new_target = impl::Helper::new_noop_function(isolate_, context);
+            new_target->Set(context, jsb_name(this, prototype), class_prototype).Check();
+            if (!reentered)
+            {
+                this->get_script_class(p_class_id)->crossbind_target.Reset(isolate, new_target);
+            }
+        }
         new_target->Set(context, jsb_symbol(this, ConstructorBindObject), v8::External::New(isolate, p_this)).Check();
 
-        v8::Local<v8::Object> reflect = context->Global()->Get(context, jsb_name(this, Reflect)).ToLocalChecked().As<v8::Object>();
-        v8::Local<v8::Function> reflect_construct = reflect->Get(context, jsb_name(this, construct)).ToLocalChecked().As<v8::Function>();
+        if (reflect_construct_.IsEmpty())
+        {
+            v8::Local<v8::Object> reflect = context->Global()->Get(context, jsb_name(this, Reflect)).ToLocalChecked().As<v8::Object>();
+            reflect_construct_.Reset(isolate, reflect->Get(context, jsb_name(this, construct)).ToLocalChecked().As<v8::Function>());
+        }
+        v8::Local<v8::Function> reflect_construct = reflect_construct_.Get(isolate);
 
         v8::Local<v8::Value> reflect_args[] = {
                 class_obj,
@@ -1250,7 +1956,9 @@ namespace jsb
                 new_target
         };
 
-        v8::MaybeLocal<v8::Value> constructed_value = reflect_construct->Call(context, reflect, 3, reflect_args);
+        ++crossbind_depth_;
+        v8::MaybeLocal<v8::Value> constructed_value = reflect_construct->Call(context, v8::Undefined(isolate), 3, reflect_args);
+        --crossbind_depth_;
 
         if (try_catch_run.has_caught())
         {
@@ -1266,9 +1974,83 @@ namespace jsb
             return {};
         }
 
+        if (exported_property_slots_)
+        {
+            _bind_property_slots(context, p_this, p_class_id);
+        }
         return this->try_get_object_id(p_this);
     }
 
+    void Environment::_bind_property_slots(const v8::Local<v8::Context>& p_context, Object* p_this, ScriptClassID p_class_id)
+    {
+        ScriptInstance* script_instance = p_this->get_script_instance();
+        if (!script_instance || script_instance->get_language() != GodotJSScriptLanguage::get_singleton()
+            || ((GodotJSScriptInstanceBase*) script_instance)->is_shadow())
+        {
+            return;
+        }
+
+        v8::Isolate* isolate = p_context->GetIsolate();
+        v8::Local<v8::Object> self;
+        if (!this->try_get_object(p_this, self))
+        {
+            return;
+        }
+
+        GodotJSScriptInstance* instance = (GodotJSScriptInstance*) script_instance;
+        const ScriptClassInfoPtr class_info = this->get_script_class(p_class_id);
+        const uint32_t num = class_info->property_order.size();
+        if (class_info->property_slot_accessors.size() != num * 2)
+        {
+            class_info->property_slot_accessors.resize(num * 2);
+        }
+
+        for (uint32_t index = 0; index < num; ++index)
+        {
+            const ScriptPropertyInfo& info = *class_info->property_order[index];
+
+            // only the types with value semantics in JS (a JS wrapper of a Vector2 mutated in place would not be written back to the slot),
+            // and the cached properties are already read without entering JS
+            switch (info.type)
+            {
+            case Variant::BOOL: case Variant::INT: case Variant::FLOAT:
+            case Variant::STRING: case Variant::STRING_NAME: case Variant::NODE_PATH: case Variant::OBJECT:
+                break;
+            default: continue;
+            }
+            if (info.cache) continue;
+
+            // only the plain fields (own writable data properties defined by the constructor), the accessors implemented in JS are kept as is
+            const v8::Local<v8::String> name = this->get_string_value(info.name);
+            v8::Local<v8::Value> descriptor;
+            v8::Local<v8::Value> writable;
+            v8::Local<v8::Value> value;
+            if (!self->GetOwnPropertyDescriptor(p_context, name).ToLocal(&descriptor) || !descriptor->IsObject()
+                || !descriptor.As<v8::Object>()->Get(p_context, jsb_name(this, writable)).ToLocal(&writable) || !writable->BooleanValue(isolate)
+                || !descriptor.As<v8::Object>()->Get(p_context, jsb_name(this, value)).ToLocal(&value))
+            {
+                continue;
+            }
+
+            Variant initial_value;
+            if (!TypeConvert::js_to_gd_var(isolate, p_context, value, info.type, initial_value))
+            {
+                continue;
+            }
+
+            v8::Global<v8::Function>& getter = class_info->property_slot_accessors[index * 2];
+            v8::Global<v8::Function>& setter = class_info->property_slot_accessors[index * 2 + 1];
+            if (getter.IsEmpty())
+            {
+                const v8::Local<v8::Int32> data = v8::Int32::New(isolate, (int32_t) (index << 8 | (uint32_t) info.type));
+                getter.Reset(isolate, JSB_NEW_FUNCTION(p_context, ObjectReflectBindingUtil::_godot_object_slot_property_get, data));
+                setter.Reset(isolate, JSB_NEW_FUNCTION(p_context, ObjectReflectBindingUtil::_godot_object_slot_property_set, data));
+            }
+            instance->bind_property_slot(index, num, initial_value);
+            self->SetAccessorProperty(name, getter.Get(isolate), setter.Get(isolate));
+        }
+    }
+
     void Environment::rebind(Object *p_this, ScriptClassID p_class_id)
     {
         //TODO a dirty but approaching solution for hot-reloading
@@ -1340,23 +2122,73 @@ namespace jsb
         deferred_class_post_binds_.clear();
     }
 
+    v8::Local<v8::Function> Environment::_get_require_factory()
+    {
+        if (!require_factory_.IsEmpty())
+        {
+            return require_factory_.Get(isolate_);
+        }
+
+        // a closure is much cheaper than a native function (no FunctionTemplate and SharedFunctionInfo instantiated per module),
+        // all `require` functions share a single native `load(parent_id, module_id)`
+        static constexpr char kRequireFactory[] =
+            "(function(load){return function(parent,cache,main){"
+            "function require(id){return load(parent,id)}"
+            "require.cache=cache;if(main!==null)require.main=main;return require}})";
+
+        const v8::Local<v8::Context> context = context_.Get(isolate_);
+        const impl::TryCatch try_catch(isolate_);
+        v8::Local<v8::Value> outer;
+        v8::Local<v8::Value> factory;
+        if (!impl::Helper::eval(context, kRequireFactory, (int) ::std::size(kRequireFactory) - 1, "jsb_require").ToLocal(&outer) || !outer->IsFunction())
+        {
+            JSB_LOG(Error, "failed to compile the require factory: %s", BridgeHelper::get_exception(try_catch));
+            return {};
+        }
+        v8::Local<v8::Value> argv[] = { JSB_NEW_FUNCTION(context, Builtins::_require_from, {}) };
+        if (!outer.As<v8::Function>()->Call(context, v8::Undefined(isolate_), ::std::size(argv), argv).ToLocal(&factory) || !factory->IsFunction())
+        {
+            JSB_LOG(Error, "failed to create the require factory: %s", BridgeHelper::get_exception(try_catch));
+            return {};
+        }
+        require_factory_.Reset(isolate_, factory.As<v8::Function>());
+        return factory.As<v8::Function>();
+    }
+
     v8::Local<v8::Function> Environment::_new_require_func(const String& p_module_id, bool p_expose_main)
     {
         const v8::Local<v8::Context> context = context_.Get(isolate_);
         const v8::Local<v8::String> module_id = impl::Helper::new_string(isolate_, p_module_id);
-        const v8::Local<v8::Function> require = JSB_NEW_FUNCTION(context, Builtins::_require, /* magic: module_id */ module_id);
+        v8::Local<v8::Value> main_module = v8::Null(isolate_);
         if (p_expose_main)
         {
-            if (v8::Local<v8::Object> main_module; _get_main_module(&main_module))
+            if (v8::Local<v8::Object> obj; _get_main_module(&obj))
             {
-                require->Set(context, jsb_name(this, main), main_module).Check();
+                main_module = obj;
             }
             else
             {
-                JSB_LOG(Log, "%s: require.main is not set due to main module not available", p_module_id);
-                require->Set(context, jsb_name(this, main), v8::Undefined(isolate_)).Check();
+                JSB_LOG(Verbose, "%s: require.main is not set due to main module not available", p_module_id);
+                main_module = v8::Undefined(isolate_);
             }
         }
+
+        if (const v8::Local<v8::Function> factory = _get_require_factory(); !factory.IsEmpty())
+        {
+            v8::Local<v8::Value> argv[] = { module_id, module_cache_.get_cache(isolate_), main_module };
+            v8::Local<v8::Value> require;
+            if (factory->Call(context, v8::Undefined(isolate_), ::std::size(argv), argv).ToLocal(&require) && require->IsFunction())
+            {
+                return require.As<v8::Function>();
+            }
+        }
+
+        // fallback to a standalone native function
+        const v8::Local<v8::Function> require = JSB_NEW_FUNCTION(context, Builtins::_require, /* magic: module_id */ module_id);
+        if (p_expose_main)
+        {
+            require->Set(context, jsb_name(this, main), main_module).Check();
+        }
         require->Set(context, jsb_name(this, cache), module_cache_.get_cache(isolate_)).Check();
         return require;
     }
@@ -1365,12 +2197,11 @@ namespace jsb
     Error Environment::load(const String& p_name, JavaScriptModule** r_module)
     {
         JSB_BENCHMARK_SCOPE(JSRealm, load);
+        JSB_TRACE_SCOPE("load_module", StringName(p_name));
         this->check_internal_state();
         v8::Isolate* isolate = get_isolate();
-        v8::Isolate::Scope isolate_scope(isolate);
-        v8::HandleScope handle_scope(isolate);
+        const BridgeScope bridge_scope(this);
         v8::Local<v8::Context> context = context_.Get(isolate);
-        v8::Context::Scope context_scope(context);
 
         const impl::TryCatch try_catch_run(isolate);
         JavaScriptModule* module = _load_module("", p_name);
@@ -1452,6 +2283,22 @@ namespace jsb
         return this->get_native_class(class_id);
     }
 
+    NativeClassInfoPtr Environment::expose_godot_object_class(const StringName& p_class_name, NativeClassID* r_class_id)
+    {
+        if (const NativeClassID* it = godot_object_classes_.getptr(p_class_name))
+        {
+            *r_class_id = *it;
+            return native_classes_.get_value_scoped(*it);
+        }
+
+        NativeClassInfoPtr class_info = expose_godot_object_class(ClassDB::classes.getptr(p_class_name), r_class_id);
+        if (class_info)
+        {
+            godot_object_classes_.insert(p_class_name, *r_class_id);
+        }
+        return class_info;
+    }
+
     void Environment::on_class_post_bind(const StringName& p_class_name, const v8::Local<v8::Function>& p_class)
     {
         if (_execution_deferred)
@@ -1466,10 +2313,8 @@ namespace jsb
     JSValueMove Environment::eval_source(const char* p_source, int p_length, const String& p_filename, Error& r_err)
     {
         JSB_BENCHMARK_SCOPE(JSRealm, eval_source);
-        v8::Isolate::Scope isolate_scope(isolate_);
-        v8::HandleScope handle_scope(isolate_);
+        const BridgeScope bridge_scope(this);
         const v8::Local<v8::Context> context = context_.Get(isolate_);
-        v8::Context::Scope context_scope(context);
 
         const impl::TryCatch try_catch_run(isolate_);
         const v8::MaybeLocal<v8::Value> maybe = impl::Helper::eval(context, p_source, p_length, p_filename);
@@ -1516,12 +2361,18 @@ namespace jsb
             TStrongRef<v8::Function>& strong_ref = function_bank_.get_value(p_func_id);
             if (strong_ref.unref())
             {
-                v8::Isolate* isolate = get_isolate();
-                v8::Isolate::Scope isolate_scope(isolate);
-                v8::HandleScope handle_scope(isolate);
                 if (jsb_likely(!strong_ref.object_.IsEmpty()))
                 {
-                    const size_t r = function_refs_.erase(TWeakRef(isolate, strong_ref.object_));
+                    size_t r = 0;
+                    for (auto [it, end] = function_refs_.equal_range((uint32_t) strong_ref.hash_); it != end; ++it)
+                    {
+                        if (it->second == p_func_id)
+                        {
+                            function_refs_.erase(it);
+                            r = 1;
+                            break;
+                        }
+                    }
                     jsb_unused(r);
                     jsb_check(r != 0);
                 }
@@ -1539,7 +2390,8 @@ namespace jsb
     Variant Environment::_call(v8::Isolate* isolate, const v8::Local<v8::Context>& context, const v8::Local<v8::Function>& p_func, const v8::Local<v8::Value>& p_self, const Variant** p_args, int p_argcount, Callable::CallError& r_error)
     {
         using LocalValue = v8::Local<v8::Value>;
-        LocalValue* argv = jsb_stackalloc(LocalValue, p_argcount);
+        internal::ScratchArena::Scope scratch;
+        LocalValue* argv = scratch.alloc<LocalValue>(p_argcount);
         for (int index = 0; index < p_argcount; ++index)
         {
             memnew_placement(&argv[index], LocalValue);
@@ -1561,7 +2413,7 @@ namespace jsb
         }
         if (try_catch_run.has_caught())
         {
-            JSB_LOG(Error, "exception thrown in function:\n%s", BridgeHelper::get_exception(try_catch_run));
+            BridgeHelper::log_exception(try_catch_run, "exception thrown in function:\n");
             r_error.error = Callable::CallError::CALL_ERROR_INVALID_METHOD;
             return {};
         }
@@ -1595,10 +2447,8 @@ namespace jsb
         }
 
         v8::Isolate* isolate = get_isolate();
-        v8::Isolate::Scope isolate_scope(isolate);
-        v8::HandleScope handle_scope(isolate);
+        const BridgeScope bridge_scope(this, true);
         const v8::Local<v8::Context> context = this->get_context();
-        v8::Context::Scope context_scope(context);
         const v8::Local<v8::Object> self = this->get_object(p_object_id);
         const v8::Local<v8::String> name = this->get_string_value(p_info.name);
         v8::Local<v8::Value> value;
@@ -1634,10 +2484,8 @@ namespace jsb
         }
 
         v8::Isolate* isolate = get_isolate();
-        v8::Isolate::Scope isolate_scope(isolate);
-        v8::HandleScope handle_scope(isolate);
+        const BridgeScope bridge_scope(this);
         const v8::Local<v8::Context> context = this->get_context();
-        v8::Context::Scope context_scope(context);
         const v8::Local<v8::Object> self = this->get_object(p_object_id);
         const v8::Local<v8::String> name = this->get_string_value(p_info.name);
         v8::Local<v8::Value> value;
@@ -1646,16 +2494,129 @@ namespace jsb
             return false;
         }
 
-        impl::TryCatch try_catch(isolate);
-        v8::Maybe<bool> set_result = self->Set(context, name, value);
+        impl::TryCatch try_catch(isolate);
+        v8::Maybe<bool> set_result = self->Set(context, name, value);
+
+        if (try_catch.has_caught())
+        {
+            JSB_LOG(Error, "Failed to set property '%s' on a %s: %s", p_info.name, p_info.class_name, jsb::BridgeHelper::get_exception(try_catch));
+            return false;
+        }
+
+        return set_result.IsJust();
+    }
+
+    bool Environment::set_script_property_value_deferred(NativeObjectID p_object_id, ScriptClassID p_class_id, const ScriptPropertyInfo& p_info, const Variant& p_val)
+    {
+        // apply immediately if called from scripts (the JS side may read it back at once)
+        if (bridge_scope_depth_ != 0)
+        {
+            return set_script_property_value(p_object_id, p_info, p_val);
+        }
+
+        // the property info may come from a script class parsed in another environment
+        const ScriptClassInfoPtr class_info = get_script_class(p_class_id);
+        if (p_info.index >= class_info->property_order.size() || class_info->property_order[p_info.index]->name != p_info.name)
+        {
+            return set_script_property_value(p_object_id, p_info, p_val);
+        }
+        pending_property_values_.push_back({ p_object_id, p_class_id, p_info.index, p_val });
+        return true;
+    }
+
+    bool Environment::get_script_property_values(NativeObjectID p_object_id, const LocalVector<const ScriptPropertyInfo*>& p_infos, LocalVector<Variant>& r_vals)
+    {
+        this->check_internal_state();
+        r_vals.resize(p_infos.size());
+        if (!this->object_db_.has_object(p_object_id))
+        {
+            return false;
+        }
+
+        v8::Isolate* isolate = get_isolate();
+        const BridgeScope bridge_scope(this, true);
+        const v8::Local<v8::Context> context = this->get_context();
+        const v8::Local<v8::Object> self = this->get_object(p_object_id);
+        for (uint32_t index = 0, num = p_infos.size(); index < num; ++index)
+        {
+            const ScriptPropertyInfo& info = *p_infos[index];
+            impl::TryCatch try_catch(isolate);
+            v8::Local<v8::Value> value;
+            if (!self->Get(context, this->get_string_value(info.name)).ToLocal(&value))
+            {
+                if (try_catch.has_caught())
+                {
+                    JSB_LOG(Error, "Failed to get property '%s' on a %s: %s", info.name, info.class_name, jsb::BridgeHelper::get_exception(try_catch));
+                }
+                continue;
+            }
+            if (!TypeConvert::js_to_gd_var(isolate, context, value, info.type, r_vals[index]))
+            {
+                JSB_LOG(Error, "Failed to get property '%s' on a %s: Failed to convert result to a Godot type", info.name, info.class_name);
+            }
+        }
+        return true;
+    }
+
+    void Environment::_apply_pending_property_values()
+    {
+        jsb_check(bridge_scope_depth_ > 0);
+        v8::Isolate* isolate = get_isolate();
+        const v8::Local<v8::Context> context = this->get_context();
+
+        // the setters may run anything (even if entered for reading properties)
+        ++script_epoch_;
+
+        // the values of an object are usually enqueued consecutively (the engine sets all properties of a node at once),
+        // each run of them is applied with the object resolved only once
+        const uint32_t num = pending_property_values_.size();
+        for (uint32_t begin = 0, end; begin < num; begin = end)
+        {
+            const NativeObjectID object_id = pending_property_values_[begin].object_id;
+            const ScriptClassID class_id = pending_property_values_[begin].class_id;
+            for (end = begin + 1; end < num && pending_property_values_[end].object_id == object_id && pending_property_values_[end].class_id == class_id; ++end) {}
+            if (!this->object_db_.has_object(object_id))
+            {
+                continue;
+            }
+
+            // stable insertion sort by the property index (the runs are short)
+            for (uint32_t i = begin + 1; i < end; ++i)
+            {
+                for (uint32_t j = i; j > begin && pending_property_values_[j - 1].index > pending_property_values_[j].index; --j)
+                {
+                    SWAP(pending_property_values_[j - 1], pending_property_values_[j]);
+                }
+            }
+
+            v8::HandleScope handle_scope(isolate);
+            const v8::Local<v8::Object> self = this->get_object(object_id);
+            const ScriptClassInfoPtr class_info = get_script_class(class_id);
+            for (uint32_t i = begin; i < end; ++i)
+            {
+                // only the last assignment of a property matters
+                const PendingPropertyValue& pending = pending_property_values_[i];
+                if (i + 1 < end && pending_property_values_[i + 1].index == pending.index) continue;
 
-        if (try_catch.has_caught())
-        {
-            JSB_LOG(Error, "Failed to set property '%s' on a %s: %s", p_info.name, p_info.class_name, jsb::BridgeHelper::get_exception(try_catch));
-            return false;
+                const ScriptPropertyInfo& info = *class_info->property_order[pending.index];
+                v8::Local<v8::Value> value;
+                if (!TypeConvert::gd_var_to_js(isolate, context, pending.value, info.type, value))
+                {
+                    JSB_LOG(Error, "Failed to set property '%s' on a %s: Failed to convert the value", info.name, info.class_name);
+                    continue;
+                }
+
+                impl::TryCatch try_catch(isolate);
+                if (self->Set(context, this->get_string_value(info.name), value).IsNothing() && try_catch.has_caught())
+                {
+                    JSB_LOG(Error, "Failed to set property '%s' on a %s: %s", info.name, info.class_name, jsb::BridgeHelper::get_exception(try_catch));
+                }
+            }
         }
 
-        return set_result.IsJust();
+        // nothing could be enqueued during applying (it's always in BridgeScope)
+        jsb_check(pending_property_values_.size() == num);
+        pending_property_values_.clear();
     }
 
     bool Environment::get_default_property_value(ScriptClassInfo& p_class_info, const StringName& p_name, Variant& r_val)
@@ -1680,6 +2641,21 @@ namespace jsb
         check_internal_state();
         p_class_info.flags = (ScriptClassFlags::Type) (p_class_info.flags | ScriptClassFlags::_Evaluated);
 
+        // constructing a CDO runs the constructor (with any side effects), avoid it if all default values are captured by the annotations
+        bool has_uncaptured = false;
+        for (const auto& prop_kv : p_class_info.properties)
+        {
+            if (!prop_kv.value.has_literal_default)
+            {
+                has_uncaptured = true;
+                break;
+            }
+        }
+        if (!has_uncaptured)
+        {
+            return;
+        }
+
         v8::Isolate* isolate = get_isolate();
         v8::Isolate::Scope isolate_scope(isolate);
         v8::HandleScope handle_scope(isolate);
@@ -1713,6 +2689,7 @@ namespace jsb
             {
                 v8::Local<v8::Value> value;
                 const ScriptPropertyInfo& prop_info = prop_kv.value;
+                if (prop_info.has_literal_default) continue;
 
                 // try read default value from CDO.
                 // pretend nothing's wrong if failed by constructing a default value in-place
@@ -1743,10 +2720,8 @@ namespace jsb
         jsb_checkf(ClassDB::is_parent_class(this->get_script_class(p_script_class_id)->native_class_name, jsb_string_name(Node)), "only Node has a prelude call");
 
         v8::Isolate* isolate = get_isolate();
-        v8::Isolate::Scope isolate_scope(isolate);
-        v8::HandleScope handle_scope(isolate);
+        const BridgeScope bridge_scope(this);
         const v8::Local<v8::Context> context = this->get_context();
-        v8::Context::Scope context_scope(context);
         const v8::Local<v8::Object> self = this->get_object(p_object_id);
 
         Variant unpacked;
@@ -1756,66 +2731,75 @@ namespace jsb
             return;
         }
 
-        // handle all @onready properties
-        v8::Local<v8::Value> val_test;
-        if (self->Get(context, jsb_symbol(this, ClassImplicitReadyFuncs)).ToLocal(&val_test) && val_test->IsArray())
+        // handle all @onready properties (resolved in `ScriptClassInfo::_parse_script_class`)
+        const Node* node = (Node*)(Object*) unpacked;
+        for (uint32_t index = 0; ; ++index)
         {
-            const v8::Local<v8::Array> collection = val_test.As<v8::Array>();
-            const uint32_t len = collection->Length();
-            const Node* node = (Node*)(Object*) unpacked;
-
-            for (uint32_t index = 0; index < len; ++index)
+            v8::Local<v8::String> element_name;
+            v8::Local<v8::Function> element_evaluator;
+            NodePath element_path;
             {
-                const v8::Local<v8::Object> element = collection->Get(context, index).ToLocalChecked().As<v8::Object>();
-                const v8::Local<v8::String> element_name = element->Get(context, jsb_name(this, name)).ToLocalChecked().As<v8::String>();
-                v8::Local<v8::Value> element_value = element->Get(context, jsb_name(this, evaluator)).ToLocalChecked();
+                const ScriptClassInfoPtr class_info = this->get_script_class(p_script_class_id);
+                if (index >= class_info->onready_entries.size())
+                {
+                    break;
+                }
+                const ScriptClassInfo::OnReadyEntry& entry = class_info->onready_entries[index];
+                element_name = entry.name.Get(isolate);
+                if (entry.evaluator.IsEmpty())
+                {
+                    element_path = entry.path;
+                }
+                else
+                {
+                    element_evaluator = entry.evaluator.Get(isolate);
+                }
+            }
 
-                if (element_value->IsString())
+            if (element_evaluator.IsEmpty())
+            {
+                Node* child_node = node->get_node(element_path);
+                if (!child_node)
                 {
-                    const String node_path_str = impl::Helper::to_string(isolate, element_value);
-                    Node* child_node = node->get_node(node_path_str);
-                    if (!child_node)
-                    {
-                        self->Set(context, element_name, v8::Null(isolate)).Check();
-                        return;
-                    }
-                    v8::Local<v8::Object> child_object;
-                    if (!TypeConvert::gd_obj_to_js(isolate, context, child_node, child_object))
-                    {
-                        JSB_LOG(Error, "failed to evaluate onready value for %s", node_path_str);
-                        return;
-                    }
-                    self->Set(context, element_name, child_object).Check();
+                    self->Set(context, element_name, v8::Null(isolate)).Check();
+                    return;
                 }
-                else if (element_value->IsFunction())
+                v8::Local<v8::Object> child_object;
+                if (!TypeConvert::gd_obj_to_js(isolate, context, child_node, child_object))
                 {
-                    v8::Local<v8::Value> argv[] = { self };
-                    const impl::TryCatch try_catch_run(isolate);
-                    v8::MaybeLocal<v8::Value> result = element_value.As<v8::Function>()->Call(context, self, std::size(argv), argv);
-                    if (try_catch_run.has_caught())
-                    {
-                        JSB_LOG(Warning, "something wrong when evaluating onready '%s'\n%s",
-                            impl::Helper::to_string(isolate, element_name),
-                            BridgeHelper::get_exception(try_catch_run));
-                        return;
-                    }
+                    JSB_LOG(Error, "failed to evaluate onready value for %s", (String) element_path);
+                    return;
+                }
+                self->Set(context, element_name, child_object).Check();
+            }
+            else
+            {
+                v8::Local<v8::Value> argv[] = { self };
+                const impl::TryCatch try_catch_run(isolate);
+                v8::MaybeLocal<v8::Value> result = element_evaluator->Call(context, self, std::size(argv), argv);
+                if (try_catch_run.has_caught())
+                {
+                    JSB_LOG(Warning, "something wrong when evaluating onready '%s'\n%s",
+                        impl::Helper::to_string(isolate, element_name),
+                        BridgeHelper::get_exception(try_catch_run));
+                    return;
+                }
 
-                    v8::Maybe<bool> assignment = result.IsEmpty()
-                        ? self->Set(context, element_name, v8::Local<v8::Value>(v8::Undefined(isolate)))
-                        : self->Set(context, element_name, result.ToLocalChecked());
-                    if (try_catch_run.has_caught())
-                    {
-                        JSB_LOG(Warning, "something wrong assigning onready result to '%s'\n%s",
-                            impl::Helper::to_string(isolate, element_name),
-                            BridgeHelper::get_exception(try_catch_run));
-                        return;
-                    }
-                    if (assignment.IsNothing())
-                    {
-                        JSB_LOG(Warning, "failed to assign onready result to '%s'\n%s",
-                            impl::Helper::to_string(isolate, element_name));
-                        return;
-                    }
+                v8::Maybe<bool> assignment = result.IsEmpty()
+                    ? self->Set(context, element_name, v8::Local<v8::Value>(v8::Undefined(isolate)))
+                    : self->Set(context, element_name, result.ToLocalChecked());
+                if (try_catch_run.has_caught())
+                {
+                    JSB_LOG(Warning, "something wrong assigning onready result to '%s'\n%s",
+                        impl::Helper::to_string(isolate, element_name),
+                        BridgeHelper::get_exception(try_catch_run));
+                    return;
+                }
+                if (assignment.IsNothing())
+                {
+                    JSB_LOG(Warning, "failed to assign onready result to '%s'\n%s",
+                        impl::Helper::to_string(isolate, element_name));
+                    return;
                 }
             }
         }
@@ -1827,33 +2811,60 @@ namespace jsb
         if (!p_object_id) return {};
         if (!is_caller_thread())
         {
+#if JSB_THREADING
+            if (defer_threaded_script_calls_)
+            {
+                DeferredScriptCall* call = memnew(DeferredScriptCall);
+                call->class_id = p_script_class_id;
+                call->object_id = p_object_id;
+                call->method = p_method;
+                call->args.resize(p_argc);
+                for (int index = 0; index < p_argc; ++index)
+                {
+                    call->args.write[index] = *p_argv[index];
+                }
+                add_async_call(AsyncCall::TYPE_SCRIPT_CALL, call);
+                r_error.error = Callable::CallError::CALL_OK;
+                return {};
+            }
+#endif
             JSB_LOG(Error, "can not call script method from a different thread");
             r_error.error = Callable::CallError::CALL_ERROR_INVALID_METHOD;
             return {};
         }
 
+        JSB_TRACE_SCOPE("call_script_method", p_method);
         v8::Isolate* isolate = get_isolate();
-        v8::Isolate::Scope isolate_scope(isolate);
-        v8::HandleScope handle_scope(isolate);
+        const BridgeScope bridge_scope(this);
         const v8::Local<v8::Context> context = this->get_context();
-        v8::Context::Scope context_scope(context);
 
         ScriptClassInfoPtr script_class_info = script_classes_.get_value_scoped(p_script_class_id);
-        const internal::TypeGen<StringName, v8::Global<v8::Function>>::UnorderedMapIt it = script_class_info->method_cache.find(p_method);
         v8::Local<v8::Function> method_func;
-        if (it == script_class_info->method_cache.end())
+
+        // fastpath for godot virtuals, they're resolved in a fixed-index table while parsing the script class
+        if (const ScriptVirtualMethod::Type vm = ScriptVirtualMethod::find(p_method); vm != ScriptVirtualMethod::kNum)
+        {
+            if (const v8::Global<v8::Function>& slot = script_class_info->virtual_methods[vm]; !slot.IsEmpty())
+            {
+                method_func = slot.Get(isolate);
+            }
+        }
+        // fastpath for incoming rpc, the functions are resolved in `rpc_methods` while parsing the script class
+        else if (const int rpc_id = script_class_info->find_rpc_method(p_method); rpc_id >= 0)
+        {
+            if (const v8::Global<v8::Function>& slot = script_class_info->rpc_methods[rpc_id].function; !slot.IsEmpty())
+            {
+                method_func = slot.Get(isolate);
+            }
+        }
+        else if (const v8::Global<v8::Function>* cached = script_class_info->method_cache.getptr(p_method);
+            !cached)
         {
             const v8::Local<v8::Object> class_obj = script_class_info->js_class.Get(isolate);
             const v8::Local<v8::Value> prototype = class_obj->Get(context, jsb_name(this, prototype)).ToLocalChecked();
             jsb_check(prototype->IsObject());
             v8::Local<v8::Value> method;
-            String exposed_name = p_method;
-
-            if (exposed_name.begins_with("_"))
-            {
-                exposed_name = internal::NamingUtil::get_member_name(exposed_name);
-            }
-
+            const StringName exposed_name = internal::NamingUtil::get_script_method_name(p_method);
             if (prototype.As<v8::Object>()->Get(context, this->get_string_value(exposed_name)).ToLocal(&method) && method->IsFunction())
             {
                 method_func = method.As<v8::Function>();
@@ -1867,7 +2878,7 @@ namespace jsb
         }
         else
         {
-            if (!it->second.IsEmpty()) method_func = it->second.Get(isolate);
+            if (!cached->IsEmpty()) method_func = cached->Get(isolate);
         }
         script_class_info = nullptr;
 
@@ -1892,6 +2903,78 @@ namespace jsb
         return _call(isolate, context, method_func, self, p_argv, p_argc, r_error);
     }
 
+    void Environment::enqueue_batched_process(ScriptClassID p_script_class_id, NativeObjectID p_object_id, double p_delta)
+    {
+        ScriptClassInfoPtr script_class_info = script_classes_.get_value_scoped(p_script_class_id);
+        if (script_class_info->batched_objects.is_empty())
+        {
+            batched_classes_.push_back(p_script_class_id);
+        }
+        script_class_info->batched_objects.push_back(p_object_id);
+        script_class_info->batched_delta = p_delta;
+    }
+
+    void Environment::_flush_batched_process()
+    {
+        if (batched_classes_.is_empty()) return;
+
+        v8::Isolate* isolate = get_isolate();
+        const BridgeScope bridge_scope(this);
+        const v8::Local<v8::Context> context = this->get_context();
+
+        // new instances may be enqueued while calling into JS, they are postponed to the next frame
+        const Vector<ScriptClassID> batched_classes = std::move(batched_classes_);
+        batched_classes_.clear();
+        for (const ScriptClassID class_id : batched_classes)
+        {
+            if (!script_classes_.is_valid_index(class_id)) continue;
+
+            ScriptClassInfoPtr script_class_info = script_classes_.get_value_scoped(class_id);
+            const Vector<NativeObjectID> objects = std::move(script_class_info->batched_objects);
+            script_class_info->batched_objects.clear();
+            const v8::Local<v8::Number> delta = v8::Number::New(isolate, script_class_info->batched_delta);
+            const v8::Local<v8::Object> class_obj = script_class_info->js_class.Get(isolate);
+            const v8::Global<v8::Function>& process_slot = script_class_info->virtual_methods[ScriptVirtualMethod::VM_process];
+            const v8::Local<v8::Function> process_func = process_slot.IsEmpty() ? v8::Local<v8::Function>() : process_slot.Get(isolate);
+            script_class_info = nullptr;
+
+            const impl::TryCatch try_catch_run(isolate);
+            v8::Local<v8::Value> batch_func;
+            if (class_obj->Get(context, get_string_value(internal::NamingUtil::get_member_name("_process_batch"))).ToLocal(&batch_func) && batch_func->IsFunction())
+            {
+                const v8::Local<v8::Array> instances = v8::Array::New(isolate, objects.size());
+                uint32_t num = 0;
+                for (const NativeObjectID object_id : objects)
+                {
+                    if (v8::Local<v8::Object> self; try_get_object(object_id, self))
+                    {
+                        instances->Set(context, num++, self).Check();
+                    }
+                }
+                v8::Local<v8::Value> argv[] = { instances, delta };
+                const v8::MaybeLocal<v8::Value> rval = batch_func.As<v8::Function>()->Call(context, class_obj, ::std::size(argv), argv);
+                jsb_unused(rval);
+            }
+            else if (!process_func.IsEmpty())
+            {
+                v8::Local<v8::Value> argv[] = { delta };
+                for (const NativeObjectID object_id : objects)
+                {
+                    if (v8::Local<v8::Object> self; try_get_object(object_id, self))
+                    {
+                        const v8::MaybeLocal<v8::Value> rval = process_func->Call(context, self, ::std::size(argv), argv);
+                        jsb_unused(rval);
+                        if (try_catch_run.has_caught()) break;
+                    }
+                }
+            }
+            if (try_catch_run.has_caught())
+            {
+                BridgeHelper::log_exception(try_catch_run, "exception thrown in batched process:\n");
+            }
+        }
+    }
+
     Variant Environment::call_function(void* p_pointer, ObjectCacheID p_func_id, const Variant** p_args, int p_argcount, Callable::CallError& r_error)
     {
         this->check_internal_state();
@@ -1901,11 +2984,10 @@ namespace jsb
             return {};
         }
 
+        JSB_TRACE_SCOPE("call_function", *p_func_id);
         v8::Isolate* isolate = get_isolate();
-        v8::Isolate::Scope isolate_scope(isolate);
-        v8::HandleScope handle_scope(isolate);
+        const BridgeScope bridge_scope(this);
         const v8::Local<v8::Context> context = this->get_context();
-        v8::Context::Scope context_scope(context);
 
         if (p_pointer)
         {
@@ -1931,6 +3013,76 @@ namespace jsb
         return _call(isolate, context, js_func.object_.Get(isolate), v8::Undefined(isolate), p_args, p_argcount, r_error);
     }
 
+    Variant Environment::call_function(void* p_pointer, NativeObjectID p_object_id, ObjectCacheID p_func_id, const Variant** p_args, int p_argcount, Callable::CallError& r_error)
+    {
+        this->check_internal_state();
+        if (!p_pointer || !p_object_id || !function_bank_.is_valid_index(p_func_id))
+        {
+            return call_function(p_pointer, p_func_id, p_args, p_argcount, r_error);
+        }
+
+        JSB_TRACE_SCOPE("call_function", *p_func_id);
+        v8::Isolate* isolate = get_isolate();
+        const BridgeScope bridge_scope(this);
+        const v8::Local<v8::Context> context = this->get_context();
+
+        // the handle is invalidated if the JS counterpart has been garbage collected (it'll be rebound with a new handle)
+        v8::Local<v8::Object> self;
+        if (!this->try_get_object(p_object_id, self))
+        {
+            return call_function(p_pointer, p_func_id, p_args, p_argcount, r_error);
+        }
+        const TStrongRef<v8::Function>& js_func = function_bank_.get_value(p_func_id);
+        jsb_check(js_func);
+        return _call(isolate, context, js_func.object_.Get(isolate), self, p_args, p_argcount, r_error);
+    }
+
+    namespace
+    {
+        // encode the script state into one buffer, return false if any value is not plain data (`r_buffer` is left empty)
+        bool pack_transfer_state(const List<Pair<StringName, Variant>>& p_state, Vector<uint8_t>& r_buffer)
+        {
+            int total = 0;
+            for (const Pair<StringName, Variant>& pair : p_state)
+            {
+                if (!internal::VariantUtil::is_plain_data(pair.second)) return false;
+                int len = 0;
+                if (encode_variant(String(pair.first), nullptr, len, false) != OK) return false;
+                total += len;
+                if (encode_variant(pair.second, nullptr, len, false) != OK) return false;
+                total += len;
+            }
+            r_buffer.resize(total);
+            uint8_t* ptr = r_buffer.ptrw();
+            for (const Pair<StringName, Variant>& pair : p_state)
+            {
+                int len = 0;
+                encode_variant(String(pair.first), ptr, len, false);
+                ptr += len;
+                encode_variant(pair.second, ptr, len, false);
+                ptr += len;
+            }
+            return true;
+        }
+
+        void unpack_transfer_state(const Vector<uint8_t>& p_buffer, ScriptInstance* p_script_instance)
+        {
+            const uint8_t* ptr = p_buffer.ptr();
+            int remaining = p_buffer.size();
+            while (remaining > 0)
+            {
+                Variant name, value;
+                int len = 0;
+                if (decode_variant(name, ptr, remaining, &len, false) != OK) break;
+                ptr += len; remaining -= len;
+                if (decode_variant(value, ptr, remaining, &len, false) != OK) break;
+                ptr += len; remaining -= len;
+                p_script_instance->set(name, value);
+            }
+            jsb_checkf(remaining == 0, "corrupted transfer state");
+        }
+    }
+
     void Environment::transfer_out(NativeObjectID p_worker_handle_id, int transfer_index, const Variant& p_variant, TransferData& r_transfer_data)
     {
         r_transfer_data.source_worker_id = p_worker_handle_id;
@@ -1950,6 +3102,12 @@ namespace jsb
                 script_instance->get_property_state(r_transfer_data.state);
                 r_transfer_data.script_path = script->get_path();
 
+                // move the plain data state in one buffer, the list is kept only if it references anything (e.g. objects transferred along)
+                if (pack_transfer_state(r_transfer_data.state, r_transfer_data.packed_state))
+                {
+                    r_transfer_data.state.clear();
+                }
+
                 obj->set_script_instance(nullptr);
             }
 
@@ -1989,6 +3147,10 @@ namespace jsb
                 jsb_check(script_instance);
 
                 // 3. restore the object state
+                if (!p_data.packed_state.is_empty())
+                {
+                    unpack_transfer_state(p_data.packed_state, script_instance);
+                }
                 for (const Pair<StringName, Variant>& pair : p_data.state)
                 {
                     script_instance->set(pair.first, pair.second);
@@ -2023,6 +3185,54 @@ namespace jsb
 #endif
     }
 
+    void Environment::_on_memory_pressure()
+    {
+        JSB_LOG(Warning, "the heap limit is nearly reached, releasing memory [env %s]", (uintptr_t) id());
+        on_gc_begin();
+        _on_gc_request();
+        on_gc_end();
+#if JSB_WITH_QUICKJS
+        // not checked again until it grows another 5% of the limit
+        heap_pressure_size_ = impl::Helper::get_malloc_size(isolate_) + heap_limit_ / 20;
+#endif
+    }
+
+#if JSB_WITH_V8
+    size_t Environment::_near_heap_limit_callback(void* p_data, size_t p_current_heap_limit, size_t p_initial_heap_limit)
+    {
+        // called in the middle of a gc, the memory is released in the next `update`
+        Environment* env = (Environment*) p_data;
+        env->memory_pressure_ = true;
+
+        // grant a quarter of the limit once to survive until then, it's restored after the heap shrinks (fatal OOM if reached again)
+        if (p_current_heap_limit > p_initial_heap_limit)
+        {
+            JSB_LOG(Error, "the heap limit is reached again (%d bytes)", (int64_t) p_current_heap_limit);
+            return p_current_heap_limit;
+        }
+        JSB_LOG(Warning, "the heap limit is nearly reached (%d bytes), raised temporarily", (int64_t) p_current_heap_limit);
+        return p_current_heap_limit + p_initial_heap_limit / 4;
+    }
+#endif
+
+#if JSB_WITH_QUICKJS
+    void Environment::_run_scheduled_gc()
+    {
+        if (impl::Helper::get_malloc_size(isolate_) < gc_malloc_base_ + gc_malloc_threshold_)
+        {
+            return;
+        }
+
+        on_gc_begin();
+        impl::Helper::run_gc(isolate_);
+        on_gc_end();
+
+        gc_malloc_base_ = impl::Helper::get_malloc_size(isolate_);
+        impl::Helper::set_gc_threshold(isolate_, gc_malloc_base_ + gc_malloc_threshold_ * 4);
+        JSB_LOG(VeryVerbose, "scheduled gc (allocated %d bytes after collection)", (int64_t) gc_malloc_base_);
+    }
+#endif
+
     void Environment::gc()
     {
         const auto list = EnvironmentStore::get_shared().get_list();
@@ -2035,6 +3245,57 @@ namespace jsb
         }
     }
 
+    void Environment::low_memory()
+    {
+        const auto list = EnvironmentStore::get_shared().get_list();
+        for (auto& it : list)
+        {
+            if (it->flags_ & EF_PreDispose) continue;
+
+            it->add_async_call(AsyncCall::TYPE_LOW_MEMORY, nullptr);
+        }
+    }
+
+    int64_t Environment::trim_memory()
+    {
+        check_internal_state();
+        const uint64_t begin_usec = OS::get_singleton()->get_ticks_usec();
+        const size_t heap_size = impl::Helper::get_used_heap_size(isolate_);
+
+        // the method lookups of script classes are resolved again on the next call
+        for (ScriptClassID id = script_classes_.get_first_index(); id; id = script_classes_.get_next_index(id))
+        {
+            script_classes_.get_value(id).method_cache.clear();
+        }
+        release_deferred_refs();
+
+        // the preloaded resources are loaded again on next `jsb.preload` if not referenced by scripts anymore
+        resource_cache_.clear();
+
+        // the parked nodes freed without being unparked
+        LocalVector<ObjectID> freed_nodes;
+        for (const ObjectID& id : parked_nodes_)
+        {
+            if (!jsb::compat::ObjectDB::get_instance(id)) freed_nodes.push_back(id);
+        }
+        for (const ObjectID& id : freed_nodes)
+        {
+            parked_nodes_.erase(id);
+        }
+
+        // the string name cache is shrunk and the source maps are released here
+        on_gc_begin();
+        _on_gc_request();
+        on_gc_end();
+
+        // the variants released by the gc are returned to the allocator at once (instead of the per-frame budget)
+        variant_allocator_.drain();
+
+        const int64_t reclaimed = heap_size != 0 ? (int64_t) heap_size - (int64_t) impl::Helper::get_used_heap_size(isolate_) : 0;
+        JSB_LOG(Log, "trimmed memory of env %s: %d bytes reclaimed in %dus", (uintptr_t) id(), reclaimed, OS::get_singleton()->get_ticks_usec() - begin_usec);
+        return reclaimed;
+    }
+
     AsyncModuleManager& Environment::get_async_module_manager()
     {
         check_internal_state();
@@ -2045,4 +3306,129 @@ namespace jsb
         return *async_module_manager_;
     }
 
+    String Environment::prefetch_module(const String& p_module_id)
+    {
+        check_internal_state();
+        if (module_cache_.find(p_module_id) || find_module_loader(p_module_id))
+        {
+            return String();
+        }
+
+        ModuleSourceInfo source_info;
+        IModuleResolver* resolver = find_module_resolver(p_module_id, source_info);
+        if (!resolver)
+        {
+            return String();
+        }
+        if (module_cache_.find(source_info.source_filepath))
+        {
+            return String();
+        }
+        resolver->prefetch(this, source_info.source_filepath);
+        return source_info.source_filepath;
+    }
+
+    void Environment::prefetch_dependencies(const String& p_parent_id, const uint8_t* p_source, size_t p_len)
+    {
+        if (!prefetch_module_dependencies_) return;
+
+        static constexpr char kRequire[] = "require(";
+        constexpr size_t kRequireLen = ::std::size(kRequire) - 1;
+        const char* str = (const char*) p_source;
+        const char* end = str + p_len;
+        const auto is_identifier_char = [](char c) { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == '$' || (uint8_t) c >= 0x80; };
+        String parent_dir;
+        while (true)
+        {
+            const char* found = (const char*) memchr(str, 'r', end - str);
+            if (!found || (size_t)(end - found) < kRequireLen + 2) break;
+            str = found + 1;
+            if (memcmp(found, kRequire, kRequireLen) != 0) continue;
+            // skip the identifiers ending with `require` (e.g. `_require(`)
+            if (found != (const char*) p_source && (is_identifier_char(found[-1]) || found[-1] == '.')) continue;
+
+            const char* literal = found + kRequireLen;
+            const char quote = *literal;
+            if (quote != '"' && quote != '\'') continue;
+            const char* literal_end = literal + 1;
+            while (literal_end < end && *literal_end != quote && *literal_end != '\\' && *literal_end != '\n') ++literal_end;
+            if (literal_end >= end || *literal_end != quote || literal_end == literal + 1) continue;
+            str = literal_end + 1;
+
+            String module_id;
+            module_id.parse_utf8(literal + 1, (int) (literal_end - literal - 1));
+            if (module_id.begins_with("./") || module_id.begins_with("../"))
+            {
+                if (parent_dir.is_empty()) parent_dir = internal::PathUtil::dirname(p_parent_id);
+                String normalized_id;
+                if (internal::PathUtil::extract(internal::PathUtil::combine(parent_dir, module_id), normalized_id) != OK || normalized_id.is_empty()) continue;
+                module_id = normalized_id;
+            }
+            prefetch_module(module_id);
+        }
+    }
+
+    void Environment::prewarm_classes(const PackedStringArray& p_class_names)
+    {
+        check_internal_state();
+        for (const String& class_name : p_class_names)
+        {
+            if (!internal::NamingUtil::is_original_class_exposed(class_name))
+            {
+                JSB_LOG(Verbose, "skip prewarming unknown class %s", class_name);
+                continue;
+            }
+            prewarm_classes_.push_back(class_name);
+        }
+    }
+
+    int Environment::flush_prewarm_classes(uint64_t p_budget_usec)
+    {
+        check_internal_state();
+        if (prewarm_index_ == prewarm_classes_.size())
+        {
+            return 0;
+        }
+
+        JSB_BENCHMARK_SCOPE(Environment, flush_prewarm_classes);
+        const BridgeScope bridge_scope(this);
+        const uint64_t begin_usec = OS::get_singleton()->get_ticks_usec();
+        while (prewarm_index_ < prewarm_classes_.size())
+        {
+            const StringName& class_name = prewarm_classes_[prewarm_index_++];
+            if (!godot_object_classes_.has(class_name))
+            {
+                NativeClassID class_id;
+                expose_godot_object_class(class_name, &class_id);
+            }
+            if (p_budget_usec != 0 && OS::get_singleton()->get_ticks_usec() - begin_usec >= p_budget_usec)
+            {
+                break;
+            }
+        }
+
+        const int left = (int) (prewarm_classes_.size() - prewarm_index_);
+        if (left == 0)
+        {
+            JSB_LOG(Verbose, "%d classes prewarmed", prewarm_classes_.size());
+            prewarm_classes_.clear();
+            prewarm_index_ = 0;
+        }
+        return left;
+    }
+
+    PackedStringArray Environment::get_exposed_godot_classes() const
+    {
+        // the class names are translated when exposed, look up the engine names in ClassDB
+        PackedStringArray class_names;
+        for (const KeyValue<StringName, ClassDB::ClassInfo>& pair : ClassDB::classes)
+        {
+            if (godot_classes_index_.has(internal::NamingUtil::get_class_name(pair.key)))
+            {
+                class_names.push_back(pair.key);
+            }
+        }
+        return class_names;
+    }
+
 }
@@ -11,6 +11,10 @@
 #include "jsb_statistics.h"
 #include "jsb_timer_tags.h"
 #include "jsb_timer_action.h"
+#include "jsb_frame_callbacks.h"
+#include "jsb_input_snapshot.h"
+#include "jsb_threaded_loads.h"
+#include "jsb_binding_counters.h"
 #include "jsb_object_handle.h"
 #include "jsb_module_loader.h"
 #include "jsb_module_resolver.h"
@@ -18,7 +22,9 @@
 #include "jsb_string_name_cache.h"
 #include "jsb_array_buffer_allocator.h"
 #include "jsb_type_convert.h"
+#include "jsb_watchdog.h"
 #include "../internal/jsb_internal.h"
+#include "core/io/marshalls.h"
 
 // get v8 string value from string name cache with the given name
 #define jsb_name(env, name) (env)->get_string_value(jsb_string_name(name))
@@ -41,6 +47,8 @@ namespace jsb
             ClassProperties,         // array of all @export annotations
             ClassImplicitReadyFuncs, // array of all @onready annotations
             ClassToolScript,         // @tool annotated scripts
+            ClassBatchedScript,      // @batched annotated scripts
+            ClassCachedExports,      // @cached_exports annotated scripts
             ClassIcon,               // @icon
             ClassRPCConfig,          // @rpc annotation for rpc functions
             Doc,
@@ -72,6 +80,9 @@ namespace jsb
                 // break the binding. free the managed native object.
                 TYPE_GC_FREE,
 
+                // same as TYPE_GC_FREE, but the binding is a NativeObjectID (posted by cppgc finalizers, the pointer may be reused before it's handled)
+                TYPE_GC_FREE_ID,
+
                 TYPE_REF,
                 TYPE_DEREF,
 
@@ -79,6 +90,21 @@ namespace jsb
 
                 // request a full gc from other threads
                 TYPE_GC_REQUEST,
+
+                // a `runTask` task started in this environment is done (binding is WorkerTask*)
+                TYPE_TASK_DONE,
+
+                // a `jsb.servers` query started in this environment is done (binding is ServerQuery*)
+                TYPE_SERVER_QUERY_DONE,
+
+                // a `jsb.fs` request started in this environment is done (binding is FileRequest*)
+                TYPE_FILE_IO_DONE,
+
+                // a script method called from another thread (binding is DeferredScriptCall*, see `defer_threaded_script_calls`)
+                TYPE_SCRIPT_CALL,
+
+                // the OS is low on memory, trim all caches (see `low_memory`)
+                TYPE_LOW_MEMORY,
             };
 
             Type type_;
@@ -108,6 +134,15 @@ namespace jsb
         friend struct InstanceBindingCallbacks;
         friend struct ClassRegister;
         friend struct EnvironmentStore;
+#if JSB_WITH_WATCHDOG
+        friend class Watchdog;
+#endif
+#if !JSB_WITH_WEB
+        // post the results back with async calls
+        friend class WorkerTaskPool;
+        friend class ServerQueries;
+        friend class AsyncFileIO;
+#endif
 
         //TODO remove this later
         friend struct ScriptClassInfo;
@@ -121,13 +156,35 @@ namespace jsb
         v8::Isolate* isolate_;
         v8::Global<v8::Context> context_;
 
-        ArrayBufferAllocator allocator_;
+        // (lazily created) `(parent_id, cache, main) => require`, see `_new_require_func`
+        v8::Global<v8::Function> require_factory_;
+
+        // (lazily cached) `Reflect.construct` for crossbind
+        v8::Global<v8::Function> reflect_construct_;
+
+        // the number of crossbinds in progress (constructors may instantiate other script objects)
+        uint32_t crossbind_depth_ = 0;
 
-        internal::DoubleBuffered<Message> inbox_;
+        // [multiple producers] messages posted from worker threads
+        internal::MPSCQueue<Message> inbox_;
+
+        // signaled when anything is posted to this environment from other threads (see `wait_for_wake_up`)
+        std::mutex wake_mutex_;
+        std::condition_variable wake_cv_;
+        std::atomic<bool> wake_requested_ = false;
 
 #if JSB_THREADING
-        internal::DoubleBuffered<AsyncCall> async_calls_;
+        // [multiple producers] posted without locking, coalesced by binding in `exec_async_calls`
+        internal::MPSCQueue<AsyncCall> async_calls_;
+
+        // net reference count changes of objects from other threads (TYPE_REF/TYPE_DEREF),
+        // they are coalesced by object and applied once in `exec_async_calls`
+        BinaryMutex pending_references_lock_;
+        HashMap<void*, int32_t> pending_references_;
 #endif
+
+        // strong references of the objects already destroyed by godot, released in bulk in `release_deferred_refs`
+        internal::DoubleBuffered<v8::Global<v8::Object>> deferred_refs_;
         
 #if JSB_V8_CPPGC
         std::unique_ptr<v8::CppHeap> cpp_heap_;
@@ -135,10 +192,14 @@ namespace jsb
         
         // indirect lookup
         // only godot object classes are mapped
-        HashMap<StringName, NativeClassID> godot_classes_index_;
+        internal::FlatMap<StringName, NativeClassID> godot_classes_index_;
+
+        // exposed godot object classes by the engine class name (`Object::get_class_name`),
+        // it saves the class name translation and lookups when binding existing godot objects
+        internal::FlatMap<StringName, NativeClassID> godot_object_classes_;
 
         // all exposed native classes
-        internal::SArray<NativeClassInfo, NativeClassID> native_classes_;
+        NativeClassInfoArray native_classes_;
 
         bool _execution_deferred = false;
 
@@ -149,22 +210,101 @@ namespace jsb
 
         //TODO all exported default classes inherit native godot class (directly or indirectly)
         // they're only collected on a module loaded
-        internal::SArray<ScriptClassInfo, ScriptClassID> script_classes_;
+        ScriptClassInfoArray script_classes_;
 
         StringNameCache string_name_cache_;
 
         ObjectDB object_db_;
         HashSet<void*> persistent_objects_;
 
+        // engine objects bound with weak wrappers (see `bind_godot_object`), they're never deleted on gc
+        HashSet<void*> weak_objects_;
+        bool weak_engine_object_wrappers_ = false;
+
+        // queue the script calls from other threads instead of failing them
+        bool defer_threaded_script_calls_ = false;
+
+        // prefetch the static dependencies of a module before evaluating it (see `prefetch_dependencies`)
+        bool prefetch_module_dependencies_ = false;
+
         internal::VariantAllocator variant_allocator_;
 
+        // num of the active BridgeScope
+        int bridge_scope_depth_ = 0;
+
+#if JSB_WITH_WATCHDOG
+        // the time budget of the outermost BridgeScope (0 if the watchdog is disabled)
+        uint64_t watchdog_budget_usec_ = 0;
+
+        // [watchdog thread] the time to interrupt the running call, see Watchdog
+        std::atomic<uint64_t> watchdog_deadline_usec_ = 0;
+#endif
+
+        // increased each time scripts may run (entering the outermost BridgeScope except for reading properties),
+        // the property values cached by script instances at an older epoch are considered outdated (0 is never used)
+        uint64_t script_epoch_ = 1;
+
+        // run microtasks after each batch of calls into JS in `update`, instead of only once at the end of it
+        bool microtask_checkpoint_per_call_batch_ = false;
+
+        // back the exported fields of script instances with native slots (see GodotJSScriptInstance::get_property_slot)
+        bool exported_property_slots_ = false;
+
+        // console messages under it are skipped before formatting the arguments
+        internal::ELogSeverity::Type console_min_severity_ = internal::ELogSeverity::VeryVerbose;
+
+        // script classes with batched `_process` calls pending
+        Vector<ScriptClassID> batched_classes_;
+
+        // exported property values assigned by the engine (e.g. when instantiating a scene) outside any script call,
+        // they're written to the JS objects in a single scope on entering the outermost BridgeScope
+        struct PendingPropertyValue
+        {
+            NativeObjectID object_id;
+            ScriptClassID class_id;
+            uint32_t index;
+            Variant value;
+        };
+        LocalVector<PendingPropertyValue> pending_property_values_;
+
+        // accumulated numbers for profiling (see get_statistics)
+        StatisticsCounters counters_;
+        uint64_t gc_begin_usec_ = 0;
+
+#if JSB_WITH_QUICKJS
+        // the cycle collection scheduled at the end of `update` (0 if not scheduled)
+        size_t gc_malloc_threshold_ = 0;
+        // allocated size right after the last scheduled collection
+        size_t gc_malloc_base_ = 0;
+
+        // (bytes) the memory limit of the runtime (0 if unlimited), and the allocated size checked against it for the next memory pressure
+        size_t heap_limit_ = 0;
+        size_t heap_pressure_size_ = 0;
+#endif
+
+        // set when the heap limit is nearly reached, the memory is released in the next `update`
+        bool memory_pressure_ = false;
+
+#if JSB_WITH_V8
+        // the idle time notification is sent at the end of the frame if the time left is not less than it (0 if disabled)
+        uint32_t idle_gc_min_slack_usec_ = 0;
+        // used heap size when V8 reported that nothing is left to do in idle time (0 if not reported)
+        size_t idle_gc_done_heap_size_ = 0;
+#endif
+
         // module_id => loader
-        HashMap<StringName, class IModuleLoader*> module_loaders_;
+        internal::FlatMap<StringName, class IModuleLoader*> module_loaders_;
         Vector<IModuleResolver*> module_resolvers_;
 
 #if JSB_WITH_ESSENTIALS
         JSTimerTags<uint64_t> timer_tags_;
         internal::TTimerManager<JavaScriptTimerAction> timer_manager_;
+        // timers not fired within the budget are deferred to the next update (0 for unlimited)
+        uint32_t timer_budget_usec_ = 0;
+
+        // requestAnimationFrame (invoked in `update`) and requestPhysicsFrame (invoked in `physics_update`)
+        FrameCallbacks animation_frame_callbacks_;
+        FrameCallbacks physics_frame_callbacks_;
 #endif
 
         // EnvironmentFlags
@@ -182,9 +322,49 @@ namespace jsb
         AsyncModuleManager* async_module_manager_ = nullptr;
         JavaScriptModuleCache module_cache_;
 
-        internal::TypeGen<TWeakRef<v8::Function>, internal::Index32>::UnorderedMap function_refs_; // backlink
+        // module sources being read (and parsed) in background
+        ModulePrefetcher module_prefetcher_;
+
+        // the resources preloaded by `jsb.preload`
+        internal::ResourceCache resource_cache_;
+
+        // the nodes parked by `jsb.pool.park` (the freed ones are pruned in `trim_memory`)
+        HashSet<ObjectID> parked_nodes_;
+
+#if !JSB_WITH_WEB
+        // `jsb.input` snapshots of action states
+        InputSnapshots input_snapshots_;
+#endif
+
+        // `jsb.load_threaded` requests waiting for ResourceLoader
+        ThreadedLoads threaded_loads_;
+
+#if JSB_WITH_BINDING_COUNTERS
+        BindingCounters binding_counters_;
+#endif
+
+        // godot classes (engine names) waiting to be bound in the frame idle time, consumed from `prewarm_index_`
+        LocalVector<StringName> prewarm_classes_;
+        uint32_t prewarm_index_ = 0;
+
+#if JSB_SUPPORT_RELOAD && defined(TOOLS_ENABLED)
+        // change notifications of module sources (null if not supported on the platform)
+        std::unique_ptr<internal::FileWatcher> file_watcher_;
+        bool file_watcher_created_ = false;
+        // modules checked by file watcher instead of polling
+        HashSet<StringName> watched_modules_;
+        // absolute path of the module source => module_id
+        HashMap<String, StringName> watched_paths_;
+#endif
+
+        // backlink, keyed by the identity hash (the candidates are compared with the functions in `function_bank_`),
+        // so that a lookup compares handles directly instead of allocating a weak handle of the function as the key
+        std::unordered_multimap<uint32_t, internal::Index32> function_refs_;
         internal::SArray<TStrongRef<v8::Function>, internal::Index32> function_bank_;
 
+        // promise resolvers of the `runTask` tasks and the signal/frame awaiters (see SignalAwaiter)
+        internal::SArray<v8::Global<v8::Promise::Resolver>, internal::Index32> pending_tasks_;
+
         struct DeferredClassRegister
         {
             NativeClassID id = {};
@@ -193,7 +373,7 @@ namespace jsb
             ClassRegisterFunc register_func = nullptr;
         };
 
-        HashMap<StringName, DeferredClassRegister> class_register_map_;
+        internal::FlatMap<StringName, DeferredClassRegister> class_register_map_;
         StringName godot_primitive_map_[Variant::VARIANT_MAX];
 
         internal::VariantInfoCollection variant_info_collection_;
@@ -216,6 +396,10 @@ namespace jsb
             int initial_object_slots = 0;
             int initial_script_slots = 0;
 
+            // heap sizing in megabytes (0 for the engine default), see Settings::get_max_heap_size_mb
+            uint32_t max_heap_size_mb = 0;
+            uint32_t initial_heap_size_mb = 0;
+
             // Port for the debugger. Disable if zero.
             uint16_t debugger_port = 0;
 
@@ -247,6 +431,47 @@ namespace jsb
             }
         };
 
+        // enter the isolate and context unless an outer BridgeScope of the same environment already did,
+        // so that the nested bridge calls (e.g. script => engine => signal => script) only open a HandleScope.
+        class BridgeScope
+        {
+            Environment* env_;
+            std::optional<v8::Isolate::Scope> isolate_scope_;
+            std::optional<v8::HandleScope> handle_scope_;
+            std::optional<v8::Context::Scope> context_scope_;
+
+        public:
+            // `p_read_only`: only for reading properties of script objects (the scripts are supposed to have no side effects)
+            explicit BridgeScope(Environment* p_env, bool p_read_only = false) : env_(p_env)
+            {
+                const bool outermost = env_->bridge_scope_depth_++ == 0;
+                if (outermost && !p_read_only) ++env_->script_epoch_;
+                if (outermost) isolate_scope_.emplace(env_->isolate_);
+                handle_scope_.emplace(env_->isolate_);
+                if (outermost)
+                {
+                    context_scope_.emplace(env_->context_.Get(env_->isolate_));
+#if JSB_WITH_WATCHDOG
+                    if (jsb_unlikely(env_->watchdog_budget_usec_)) env_->watchdog_deadline_usec_.store(OS::get_singleton()->get_ticks_usec() + env_->watchdog_budget_usec_, std::memory_order_relaxed);
+#endif
+                    if (jsb_unlikely(!env_->pending_property_values_.is_empty())) env_->_apply_pending_property_values();
+                }
+            }
+
+            ~BridgeScope()
+            {
+                if (--env_->bridge_scope_depth_ == 0)
+                {
+#if JSB_WITH_WATCHDOG
+                    if (jsb_unlikely(env_->watchdog_budget_usec_)) env_->_disarm_watchdog();
+#endif
+                }
+            }
+
+            BridgeScope(const BridgeScope&) = delete;
+            BridgeScope& operator=(const BridgeScope&) = delete;
+        };
+
         Environment(const CreateParams& p_params);
         ~Environment();
 
@@ -280,6 +505,9 @@ namespace jsb
 
         jsb_force_inline internal::VariantInfoCollection& get_variant_info_collection() { return variant_info_collection_; }
 
+        jsb_force_inline internal::ELogSeverity::Type get_console_min_severity() const { return console_min_severity_; }
+        jsb_force_inline void set_console_min_severity(internal::ELogSeverity::Type p_severity) { console_min_severity_ = p_severity; }
+
         void add_class_register(const Variant::Type p_type, const ClassRegisterFunc p_func)
         {
             jsb_check(!internal::VariantUtil::is_valid_name(godot_primitive_map_[p_type]));
@@ -309,15 +537,28 @@ namespace jsb
             return wrap(p_context)->function_pointers_[p_offset];
         }
 
+        // keep the resolver of a pending promise (`runTask`, signal and frame awaiters) until it's settled
+        internal::Index32 add_pending_task(const v8::Local<v8::Promise::Resolver>& p_resolver);
+
+        // take the resolver of a pending task, return false if it's not pending anymore (e.g. the environment is disposing)
+        bool take_pending_task(internal::Index32 p_id, v8::Global<v8::Promise::Resolver>& r_resolver);
+
         ObjectCacheID get_cached_function(const v8::Local<v8::Function>& p_func);
         bool release_function(ObjectCacheID p_func_id);
         Variant call_function(void* p_pointer, ObjectCacheID p_func_id, const Variant** p_args, int p_argcount, Callable::CallError &r_error);
 
+        // same as `call_function`, but try the JS binding handle of `p_pointer` (`p_object_id`, cached by the caller) before looking up the pointer
+        Variant call_function(void* p_pointer, NativeObjectID p_object_id, ObjectCacheID p_func_id, const Variant** p_args, int p_argcount, Callable::CallError &r_error);
+
         /**
          * This method will not throw any JS exception.
+         * If it's called from another thread with `defer_threaded_script_calls` enabled, the call is queued and nothing is returned.
          */
         Variant call_script_method(ScriptClassID p_script_class_id, NativeObjectID p_object_id, const StringName& p_method, const Variant** p_argv, int p_argc, Callable::CallError& r_error);
 
+        // defer `_process` of a batched script class instance, all of them are dispatched at once in the next `update`
+        void enqueue_batched_process(ScriptClassID p_script_class_id, NativeObjectID p_object_id, double p_delta);
+
         void transfer_out(NativeObjectID p_worker_handle_id, int transfer_index, const Variant& p_variant, TransferData& r_transfer_data);
         void transfer_in(const TransferData& p_data);
 
@@ -329,9 +570,18 @@ namespace jsb
         // [pseudo] transfer_to_host(worker, master, worker_handle, scene->instantiate());
         static void transfer_to_host(Environment* p_from, Environment* p_to, NativeObjectID p_worker_handle_id, const Variant& p_variant);
 
+        jsb_force_inline uint64_t get_script_epoch() const { return script_epoch_; }
+
         bool get_script_property_value(NativeObjectID p_object_id, const ScriptPropertyInfo& p_info, Variant& r_val);
         bool set_script_property_value(NativeObjectID p_object_id, const ScriptPropertyInfo& p_info, const Variant& p_val);
 
+        // same as `set_script_property_value`, but the value is only enqueued if not called from scripts,
+        // all pending values are converted and assigned at once (in the fixed order of `ScriptClassInfo::property_order`) before any script runs.
+        bool set_script_property_value_deferred(NativeObjectID p_object_id, ScriptClassID p_class_id, const ScriptPropertyInfo& p_info, const Variant& p_val);
+
+        // get the values of multiple properties of an object in a single scope, return false if the object is not available
+        bool get_script_property_values(NativeObjectID p_object_id, const LocalVector<const ScriptPropertyInfo*>& p_infos, LocalVector<Variant>& r_vals);
+
         // Get default property value of a script class.
         // Potential side effects: This procedure may construct a new CDO instance (the reason why an `Environment` is required).
         bool get_default_property_value(ScriptClassInfo& p_class_info, const StringName& p_name, Variant& r_val);
@@ -347,6 +597,57 @@ namespace jsb
          */
         AsyncModuleManager& get_async_module_manager();
 
+        jsb_force_inline ModulePrefetcher& get_module_prefetcher() { return module_prefetcher_; }
+        jsb_force_inline internal::ResourceCache& get_resource_cache() { return resource_cache_; }
+#if !JSB_WITH_WEB
+        jsb_force_inline InputSnapshots& get_input_snapshots() { return input_snapshots_; }
+#endif
+        jsb_force_inline ThreadedLoads& get_threaded_loads() { return threaded_loads_; }
+#if JSB_WITH_BINDING_COUNTERS
+        jsb_force_inline BindingCounters& get_binding_counters() { return binding_counters_; }
+#endif
+
+        // [jsb.pool] return false if it's already parked (or not parked for `remove_parked_node`)
+        jsb_force_inline bool add_parked_node(ObjectID p_id)
+        {
+            if (parked_nodes_.has(p_id)) return false;
+            parked_nodes_.insert(p_id);
+            return true;
+        }
+        jsb_force_inline bool remove_parked_node(ObjectID p_id) { return parked_nodes_.erase(p_id); }
+        jsb_force_inline bool is_parked_node(ObjectID p_id) const { return parked_nodes_.has(p_id); }
+
+        /**
+         * [env thread only]
+         * Start reading the source of a module in background without evaluating it, the following `load` will pick it up.
+         * \return the resolved asset path, empty if the module is not resolvable or already loaded
+         */
+        String prefetch_module(const String& p_module_id);
+
+        /**
+         * [env thread only]
+         * Prefetch the modules required with string literals (`require("x")`, as emitted for static imports) in the source of a module,
+         * the conditional ones are also fetched (but not evaluated). Nothing happens if `prefetch_module_dependencies` is disabled.
+         */
+        void prefetch_dependencies(const String& p_parent_id, const uint8_t* p_source, size_t p_len);
+
+        /**
+         * [env thread only]
+         * Queue godot classes (engine names) to be bound in the frame idle time, instead of the first time they're touched by scripts.
+         * Unknown and already exposed classes are skipped.
+         */
+        void prewarm_classes(const PackedStringArray& p_class_names);
+
+        /**
+         * [env thread only]
+         * Bind the queued classes until `p_budget_usec` is spent (at least one class is bound), or all of them if it's zero.
+         * \return the number of classes left in the queue
+         */
+        int flush_prewarm_classes(uint64_t p_budget_usec = 0);
+
+        // the engine names of the godot object classes exposed so far (including the base classes bound along with them)
+        PackedStringArray get_exposed_godot_classes() const;
+
         //NOTE AVOID USING THIS CALL, CONSIDERING REMOVING IT.
         //     eval from source
         JSValueMove eval_source(const char* p_source, int p_length, const String& p_filename, Error& r_err);
@@ -368,6 +669,9 @@ namespace jsb
 
         v8::Local<v8::Function> _new_require_func(const String& p_module_id, bool p_expose_main = true);
 
+        // the shared function which creates the `require` of a module (empty if failed to compile it)
+        v8::Local<v8::Function> _get_require_factory();
+
         bool _get_main_module(v8::Local<v8::Object>* r_main_module) const;
 
         // return nullptr if no register for `p_type_name`
@@ -375,6 +679,9 @@ namespace jsb
 
         NativeClassInfoPtr expose_godot_object_class(const ClassDB::ClassInfo* p_class_info, NativeClassID* r_class_id = nullptr);
 
+        // the same as `expose_godot_object_class(ClassDB::ClassInfo*)` but cached by the engine class name
+        NativeClassInfoPtr expose_godot_object_class(const StringName& p_class_name, NativeClassID* r_class_id);
+
         NativeClassInfoPtr expose_godot_primitive_class(const Variant::Type p_type, NativeClassID* r_class_id = nullptr)
         {
             jsb_check(internal::VariantUtil::is_valid_name(godot_primitive_map_[p_type]));
@@ -391,9 +698,10 @@ namespace jsb
         JavaScriptModule* _load_module(const String& p_parent_id, const String& p_module_id);
 
         // manually scan changes of modules,
-        // will reload IMMEDIATELY
+        // will reload IMMEDIATELY (along with all modules depending on them, in topological order)
         // (modules not attached with GodotJS script are not automatically reloaded by resource manager)
-        void scan_external_changes();
+        // `r_script_modules` (optional) is filled with the affected modules attached with GodotJS script, they're marked as reloading but not reloaded here
+        void scan_external_changes(Vector<StringName>* r_script_modules = nullptr);
 
         // request to reload a module,
         // will reload until next load.
@@ -421,15 +729,31 @@ namespace jsb
 #if JSB_WITH_ESSENTIALS
         jsb_force_inline internal::TTimerManager<JavaScriptTimerAction>& get_timer_manager() { return timer_manager_; }
         jsb_force_inline JSTimerTags<uint64_t>& get_timer_tags() { return timer_tags_; }
+        jsb_force_inline FrameCallbacks& get_animation_frame_callbacks() { return animation_frame_callbacks_; }
+        jsb_force_inline FrameCallbacks& get_physics_frame_callbacks() { return physics_frame_callbacks_; }
 #endif
 
         jsb_force_inline StringNameCache& get_string_name_cache() { return string_name_cache_; }
+        jsb_force_inline bool is_weak_engine_object_wrappers() const { return weak_engine_object_wrappers_; }
+        jsb_force_inline bool is_defer_threaded_script_calls() const { return defer_threaded_script_calls_; }
+
+        // only before any object is bound (it's read by other threads without lock)
+        jsb_force_inline void set_defer_threaded_script_calls(bool p_enabled) { defer_threaded_script_calls_ = p_enabled; }
+#if JSB_WITH_WATCHDOG
+        jsb_force_inline uint64_t get_watchdog_deadline() const { return watchdog_deadline_usec_.load(std::memory_order_acquire); }
+#endif
         jsb_force_inline v8::Local<v8::String> get_string_value(const StringName& p_name) { return string_name_cache_.get_string_value(isolate_, p_name); }
         jsb_force_inline StringName get_string_name(const v8::Local<v8::String>& p_value) { return string_name_cache_.get_string_name(isolate_, p_value); }
+        jsb_force_inline StringName get_string_name(const v8::Local<v8::String>& p_value, StringNameID& r_site) { return string_name_cache_.get_string_name(isolate_, p_value, r_site); }
 
         jsb_force_inline v8::Local<v8::Symbol> get_symbol(Symbols::Type p_type) const { return symbols_[p_type].Get(isolate_); }
 
-        NativeObjectID bind_godot_object(NativeClassID p_class_id, Object* p_pointer, const v8::Local<v8::Object>& p_object);
+        /**
+         * Bind a godot object with a JS object.
+         * \param p_weak bind the object weakly if it's not RefCounted, the binding is broken when the JS object is collected (the godot object is untouched).
+         *               only for the engine objects returned to JS, and effective only if `is_weak_engine_object_wrappers()`.
+         */
+        NativeObjectID bind_godot_object(NativeClassID p_class_id, Object* p_pointer, const v8::Local<v8::Object>& p_object, bool p_weak = false);
 
         // [low level binding] bind a C++ `p_pointer` with a JS `p_object`
         // p_type is redundant (could retrieve from class registry with p_class_id), but it's faster to pass it directly
@@ -443,6 +767,24 @@ namespace jsb
         {
             p_object->SetAlignedPointerInInternalField(IF_Pointer, p_pointer);
             impl::Helper::SetDeleter(p_pointer, p_object, _valuetype_deleter, this);
+            ++counters_.valuetype_bindings;
+        }
+
+        // bind a copy of `p_value` with a JS `p_object`.
+        // plain math primitives are stored inline in the JS object if JSB_INLINE_VALUETYPE_STORAGE is enabled.
+        jsb_force_inline void bind_valuetype_copy(const Variant& p_value, const v8::Local<v8::Object>& p_object)
+        {
+#if JSB_WITH_V8 && JSB_INLINE_VALUETYPE_STORAGE
+            if (internal::VariantUtil::is_trivial_storage_type(p_value.get_type()))
+            {
+                Variant* pointer = impl::Helper::new_inline_variant(p_object);
+                *pointer = p_value;
+                p_object->SetAlignedPointerInInternalField(IF_Pointer, pointer);
+                ++counters_.valuetype_bindings;
+                return;
+            }
+#endif
+            bind_valuetype(alloc_variant(p_value), p_object);
         }
 
         jsb_force_inline NativeObjectID try_get_object_id(void* p_pointer) const { return object_db_.try_get_object_id(p_pointer); }
@@ -486,28 +828,55 @@ namespace jsb
         void* get_verified_object(const v8::Local<v8::Object>& p_obj, NativeClassType::Type p_type) const;
 
         // return true if operation is successful
-        bool reference_object(void* p_pointer, bool p_is_inc);
+        bool reference_object(void* p_pointer, bool p_is_inc) { return reference_object(p_pointer, p_is_inc ? 1 : -1); }
+
+        // apply the net change `p_delta` of references
+        bool reference_object(void* p_pointer, int32_t p_delta);
         void mark_as_persistent_object(void* p_pointer);
 
         // request a full garbage collection
         static void gc();
+
+        // trim the memory of all environments (on their own threads), called on the memory warning of the OS
+        static void low_memory();
+
+        // release all the memory which can be recreated on demand, and run a full gc. return the number of bytes reclaimed (0 if unknown)
+        int64_t trim_memory();
         void set_battery_save_mode(bool p_enabled) { isolate_->SetBatterySaverMode(p_enabled); }
 
         void update(uint64_t p_delta_msecs);
 
+        // bind the prewarmed classes and let the runtime do the GC work in the time left of the current frame (which began at `p_frame_ticks`)
+        void notify_frame_idle(uint64_t p_frame_ticks);
+
+        // invoke the callbacks requested by requestPhysicsFrame (`p_delta` in seconds)
+        void physics_update(double p_delta);
+
+        // run pending microtasks (if any), QuickJS/JSC also flush the postponed free ops here
+        void perform_microtask_checkpoint();
+
         // [thread safe] it's OK to call this method before the evn inited.
         void post_message(Message&& p_message)
         {
             JSB_LOG(VeryVerbose, "inbox message %d: %d", p_message.get_id(), p_message.get_buffer().size());
             inbox_.add(std::move(p_message));
+            wake_up();
         }
 
+        // [thread safe] interrupt `wait_for_wake_up` (or let the next call return immediately if it's not waiting)
+        void wake_up();
+
+        // [env thread only] block the current thread until `wake_up` is called or the timeout (in milliseconds) is reached
+        void wait_for_wake_up(uint64_t p_timeout_msec);
+
+        // [env thread only] the time (in milliseconds) before `update` has anything to do without being woken up (at most `p_max_msec`)
+        uint64_t get_idle_time(uint64_t p_max_msec) const;
+
         class IModuleLoader* find_module_loader(const StringName& p_module_id) const
         {
-            const HashMap<StringName, class IModuleLoader*>::ConstIterator it = module_loaders_.find(p_module_id);
-            if (it != module_loaders_.end())
+            if (IModuleLoader* const* it = module_loaders_.getptr(p_module_id))
             {
-                return it->value;
+                return *it;
             }
             return nullptr;
         }
@@ -515,11 +884,11 @@ namespace jsb
         template<typename T, typename... ArgumentTypes>
         T& add_module_loader(const StringName& p_module_id, ArgumentTypes&&... p_args)
         {
-            if (const HashMap<StringName, IModuleLoader*>::Iterator& it = module_loaders_.find(p_module_id))
+            if (IModuleLoader** it = module_loaders_.getptr(p_module_id))
             {
                 JSB_LOG(Warning, "duplicated module loader %s", p_module_id);
-                memdelete(it->value);
-                module_loaders_.remove(it);
+                memdelete(*it);
+                module_loaders_.erase(p_module_id);
             }
             T* loader = memnew(T(std::forward<ArgumentTypes>(p_args)...));
             module_loaders_.insert(p_module_id, loader);
@@ -589,6 +958,23 @@ namespace jsb
 
         void get_statistics(Statistics& r_stats) const;
 
+        // the bound objects per native class and the JS heap summary of the runtime (slow, for the statistics viewer)
+        void get_heap_snapshot(HeapSnapshot& r_snapshot) const;
+
+        // the max number of objects/script classes registered in this environment (for sizing the registries on the next launch)
+        jsb_force_inline int get_object_slots_peak() const { return object_db_.get_peak_size(); }
+        jsb_force_inline int get_script_slots_peak() const { return script_classes_.size(); }
+
+        // [profiling] called by the gc prologue/epilogue callbacks
+        void on_gc_begin() { gc_begin_usec_ = OS::get_singleton()->get_ticks_usec(); }
+        void on_gc_end()
+        {
+            const uint64_t gc_end_usec = OS::get_singleton()->get_ticks_usec();
+            ++counters_.gc_count;
+            counters_.gc_time_usec += gc_end_usec - gc_begin_usec_;
+            JSB_TRACE_COMPLETE("gc", gc_begin_usec_, gc_end_usec);
+        }
+
         static std::shared_ptr<Environment> _access(void* p_runtime);
 
         // [unsafe] get the environment from the current thread
@@ -597,10 +983,45 @@ namespace jsb
 
     private:
         void exec_async_calls();
+
+        // release the references postponed by `free_object` (the buffers are swapped, call it twice to release all)
+        void release_deferred_refs();
+
+        // call `static _process_batch(instances, delta)` if provided, otherwise call `_process(delta)` of each instance in a single scope
+        void _flush_batched_process();
+
+        // write `pending_property_values_` to the JS objects (must be in a BridgeScope)
+        void _apply_pending_property_values();
+
+#if JSB_WITH_WATCHDOG
+        // leave the outermost BridgeScope, resume the isolate if the call is terminated by the watchdog
+        void _disarm_watchdog();
+#endif
+
+        jsb_force_inline void _end_call_batch()
+        {
+            if (microtask_checkpoint_per_call_batch_)
+            {
+                notify_microtasks_run();
+                perform_microtask_checkpoint();
+            }
+        }
+
         void exec_async_call(AsyncCall::Type p_type, void* p_binding);
 
         void _on_gc_request();
 
+        // release the caches and run a full gc if the heap limit is nearly reached
+        void _on_memory_pressure();
+
+#if JSB_WITH_V8
+        static size_t _near_heap_limit_callback(void* p_data, size_t p_current_heap_limit, size_t p_initial_heap_limit);
+#endif
+
+#if JSB_WITH_QUICKJS
+        void _run_scheduled_gc();
+#endif
+
         /**
          * @note execution order is not guaranteed
          */
@@ -611,6 +1032,16 @@ namespace jsb
 
         void _rebind(v8::Isolate* isolate, const v8::Local<v8::Context> context, Object* p_this, ScriptClassID p_class_id);
 
+        // move the exported fields of a newly constructed script instance into its native slots (see `exported_property_slots_`)
+        void _bind_property_slots(const v8::Local<v8::Context>& p_context, Object* p_this, ScriptClassID p_class_id);
+
+        JavaScriptModule* _load_module_unrecorded(const String& p_parent_id, const String& p_module_id);
+
+#if JSB_SUPPORT_RELOAD && defined(TOOLS_ENABLED)
+        // the changed modules and all modules depending on them (transitively), the dependencies always come before the dependents
+        Vector<StringName> _get_reload_order(const Vector<StringName>& p_changed_modules) const;
+#endif
+
         void _execute_class_post_bind(const StringName& p_class_name, const v8::Local<v8::Function>& p_class);
         void _execute_deferred();
 
@@ -630,6 +1061,25 @@ namespace jsb
             env->add_async_call(AsyncCall::TYPE_GC_FREE, info.GetParameter());
         }
 
+#if JSB_V8_CPPGC
+        // called when the cppgc wrappable of an object binding is finalized, `p_data` is the packed NativeObjectID
+        static void object_wrappable_deleter(void* p_data, size_t p_length, void* p_deleter_data)
+        {
+            ((Environment*) p_deleter_data)->add_async_call(AsyncCall::TYPE_GC_FREE_ID, p_data);
+        }
+#endif
+
+        // the binding becomes collectable by GC (until its ref_count_ increased again)
+        jsb_force_inline static void set_weak_binding(v8::Global<v8::Object>& p_ref, void* p_pointer)
+        {
+#if JSB_V8_CPPGC
+            // the native part is finalized by cppgc (see object_wrappable_deleter)
+            p_ref.SetWeak();
+#else
+            p_ref.SetWeak(p_pointer, &object_gc_callback, v8::WeakCallbackType::kInternalFields);
+#endif
+        }
+
         // a forward method for non-v8 implementations
         static void _valuetype_deleter(const v8::WeakCallbackInfo<void>& info)
         {
@@ -671,19 +1121,38 @@ namespace jsb
     };
 
 // TODO: Support other runtimes.
-#if JSB_WITH_V8
+#if JSB_WITH_VARIANT_SERIALIZATION
     namespace Serialization
     {
         enum class SerializationTag : uint8_t
         {
             kGodotVariantTransfer = 'V',
+
+            // a value type variant encoded in the message itself (no TransferData)
+            kGodotVariantInline = 'v',
         };
 
+        // the fixed size value types written with kGodotVariantInline
+        jsb_force_inline bool is_inline_variant_type(Variant::Type p_type)
+        {
+            switch (p_type)
+            {
+            case Variant::VECTOR2: case Variant::VECTOR2I: case Variant::RECT2: case Variant::RECT2I:
+            case Variant::VECTOR3: case Variant::VECTOR3I: case Variant::TRANSFORM2D: case Variant::VECTOR4:
+            case Variant::VECTOR4I: case Variant::PLANE: case Variant::QUATERNION: case Variant::AABB:
+            case Variant::BASIS: case Variant::TRANSFORM3D: case Variant::PROJECTION: case Variant::COLOR:
+                return true;
+            default:
+                return false;
+            }
+        }
+
         class VariantSerializerDelegate : public v8::ValueSerializer::Delegate
         {
         private:
             Environment* from_env_;
             internal::ReferentialVariantMap<TransferData>& transfers;
+            MessageBackingStores& backing_stores_;
 
             v8::ValueSerializer* serializer_ = nullptr;
 
@@ -692,9 +1161,11 @@ namespace jsb
         public:
             VariantSerializerDelegate(
                     Environment* p_from_env,
-                    internal::ReferentialVariantMap<TransferData>& p_transfers) :
+                    internal::ReferentialVariantMap<TransferData>& p_transfers,
+                    MessageBackingStores& p_backing_stores) :
                     from_env_(p_from_env),
-                    transfers(p_transfers)
+                    transfers(p_transfers),
+                    backing_stores_(p_backing_stores)
             {
                 clone_map.reserve(transfers.size());
 
@@ -709,10 +1180,12 @@ namespace jsb
                 serializer_ = serializer;
             }
 
+#if JSB_WITH_V8
             void ThrowDataCloneError(v8::Local<v8::String> p_message) override
             {
                 from_env_->get_isolate()->ThrowException(v8::Exception::Error(p_message));
             }
+#endif
 
             v8::Maybe<bool> WriteHostObject(v8::Isolate* p_isolate, v8::Local<v8::Object> p_object) override
             {
@@ -724,6 +1197,21 @@ namespace jsb
                 Variant variant;
                 TypeConvert::js_to_gd_var(p_isolate, context, p_object.As<v8::Value>(), variant);
 
+                if (is_inline_variant_type(variant.get_type()))
+                {
+                    uint8_t bytes[160];
+                    int len = 0;
+                    encode_variant(variant, nullptr, len);
+                    jsb_check(len <= (int) sizeof(bytes));
+                    encode_variant(variant, bytes, len);
+
+                    const uint8_t tag = (uint8_t) SerializationTag::kGodotVariantInline;
+                    serializer_->WriteRawBytes(&tag, sizeof(tag));
+                    serializer_->WriteUint32((uint32_t) len);
+                    serializer_->WriteRawBytes(bytes, len);
+                    return v8::Just(true);
+                }
+
                 const TransferData* transfer_data = transfers.getptr(variant);
 
                 if (!transfer_data)
@@ -735,7 +1223,7 @@ namespace jsb
 
                     if (!cloned)
                     {
-                        ThrowDataCloneError(v8::String::NewFromUtf8(p_isolate, "A Godot Object was passed that was not in the transfer list.", v8::NewStringType::kNormal).ToLocalChecked());
+                        jsb_throw(p_isolate, "A Godot Object was passed that was not in the transfer list.");
                         return v8::Nothing<bool>();
                     }
 
@@ -752,8 +1240,17 @@ namespace jsb
                 return v8::Just(true);
             }
 
-            v8::Maybe<uint32_t> GetSharedArrayBufferId(v8::Isolate* p_isolate, v8::Local<v8::SharedArrayBuffer> p_shared_array_buffer) override { return v8::Nothing<uint32_t>(); }
+#if JSB_WITH_V8
+            // the memory is not copied, the receiver creates a new SharedArrayBuffer over the same backing store
+            v8::Maybe<uint32_t> GetSharedArrayBufferId(v8::Isolate* p_isolate, v8::Local<v8::SharedArrayBuffer> p_shared_array_buffer) override
+            {
+                const uint32_t id = (uint32_t) backing_stores_.shared.size();
+                backing_stores_.shared.push_back(p_shared_array_buffer->GetBackingStore());
+                return v8::Just(id);
+            }
+
             v8::Maybe<uint32_t> GetWasmModuleTransferId(v8::Isolate* p_isolate, v8::Local<v8::WasmModuleObject> p_module) override { return v8::Nothing<uint32_t>(); }
+#endif
         };
 
         class VariantDeserializerDelegate : public v8::ValueDeserializer::Delegate
@@ -761,21 +1258,35 @@ namespace jsb
         private:
             Environment* to_env_;
             const std::vector<TransferData>& transferred_;
+            const MessageBackingStores& backing_stores_;
 
             v8::ValueDeserializer* deserializer_ = nullptr;
 
         public:
             VariantDeserializerDelegate(
                     Environment* p_to_env,
-                    const std::vector<TransferData>& p_transferred) :
+                    const std::vector<TransferData>& p_transferred,
+                    const MessageBackingStores& p_backing_stores) :
                     to_env_(p_to_env),
-                    transferred_(p_transferred) {}
+                    transferred_(p_transferred),
+                    backing_stores_(p_backing_stores) {}
 
             void SetSerializer(v8::ValueDeserializer* deserializer)
             {
                 this->deserializer_ = deserializer;
             }
 
+#if JSB_WITH_V8
+            // adopt the transferred ArrayBuffers, must be called before `ReadValue`
+            void TransferArrayBuffers(v8::Isolate* p_isolate)
+            {
+                for (uint32_t index = 0, num = (uint32_t) backing_stores_.transferred.size(); index < num; ++index)
+                {
+                    deserializer_->TransferArrayBuffer(index, v8::ArrayBuffer::New(p_isolate, backing_stores_.transferred[index]));
+                }
+            }
+#endif
+
             v8::MaybeLocal<v8::Object> ReadHostObject(v8::Isolate* p_isolate) override
             {
                 const uint8_t* bytes = nullptr;
@@ -785,6 +1296,22 @@ namespace jsb
                     return v8::MaybeLocal<v8::Object>();
                 }
 
+                if (bytes[0] == (uint8_t) SerializationTag::kGodotVariantInline)
+                {
+                    uint32_t len = 0;
+                    const uint8_t* data = nullptr;
+                    Variant variant;
+                    v8::Local<v8::Value> js_value;
+                    if (!deserializer_->ReadUint32(&len)
+                        || !deserializer_->ReadRawBytes(len, reinterpret_cast<const void**>(&data))
+                        || decode_variant(variant, data, (int) len) != OK
+                        || !TypeConvert::gd_var_to_js(to_env_->get_isolate(), to_env_->get_context(), variant, js_value))
+                    {
+                        return v8::MaybeLocal<v8::Object>();
+                    }
+                    return js_value.As<v8::Object>();
+                }
+
                 if (bytes[0] != (uint8_t)SerializationTag::kGodotVariantTransfer)
                 {
                     return v8::MaybeLocal<v8::Object>();
@@ -807,6 +1334,17 @@ namespace jsb
 
                 return js_value.As<v8::Object>();
             }
+
+#if JSB_WITH_V8
+            v8::MaybeLocal<v8::SharedArrayBuffer> GetSharedArrayBufferFromId(v8::Isolate* p_isolate, uint32_t p_clone_id) override
+            {
+                if (p_clone_id >= (uint32_t) backing_stores_.shared.size())
+                {
+                    return v8::MaybeLocal<v8::SharedArrayBuffer>();
+                }
+                return v8::SharedArrayBuffer::New(p_isolate, backing_stores_.shared[p_clone_id]);
+            }
+#endif
         };
     }
 #endif
@@ -26,6 +26,11 @@ namespace jsb
     void _print(const v8::FunctionCallbackInfo<v8::Value>& info)
     {
         if constexpr (ActiveSeverity < internal::ELogSeverity::JSB_MIN_LOG_LEVEL) return;
+        if constexpr (ActiveSeverity != internal::ELogSeverity::Assert)
+        {
+            // skip it before stringifying the arguments
+            if (ActiveSeverity < Environment::wrap(info.GetIsolate())->get_console_min_severity()) return;
+        }
 
         v8::Isolate* isolate = info.GetIsolate();
         StringBuilder sb;
@@ -108,18 +113,12 @@ namespace jsb
                 sb.append("\n");
                 sb.append(stacktrace);
             }
-            const String text = sb.as_string();
-            internal::IConsoleOutput::internal_write(ActiveSeverity, text);
-            print_line(text);
+            internal::IConsoleOutput::print(ActiveSeverity, sb.as_string());
             return;
         }
 
         // trivial prints
-        {
-            const String text = sb.as_string();
-            internal::IConsoleOutput::internal_write(ActiveSeverity, text);
-            print_line(text);
-        }
+        internal::IConsoleOutput::print(ActiveSeverity, sb.as_string());
     }
 
     template<InternalTimerType::Type TimerType>
@@ -154,18 +153,25 @@ namespace jsb
 
         if (argc > extra_arg_index)
         {
-            JavaScriptTimerAction action(v8::Global<v8::Function>(isolate, func), argc - extra_arg_index);
-            for (int index = extra_arg_index; index < argc; ++index)
+            const int action_argc = argc - extra_arg_index;
+            using LocalValue = v8::Local<v8::Value>;
+            LocalValue* argv = jsb_stackalloc(LocalValue, action_argc);
+            for (int index = 0; index < action_argc; ++index)
             {
-                action.store(index - extra_arg_index, v8::Global<v8::Value>(isolate, info[index]));
+                memnew_placement(&argv[index], LocalValue);
+                argv[index] = info[index + extra_arg_index];
             }
             Environment::wrap(isolate)->get_timer_manager().set_timer(handle,
-                std::move(action), rate, loop);
+                JavaScriptTimerAction(isolate, context, func, argv, action_argc), rate, loop);
+            for (int index = 0; index < action_argc; ++index)
+            {
+                argv[index].~LocalValue();
+            }
         }
         else
         {
             Environment::wrap(isolate)->get_timer_manager().set_timer(handle,
-                JavaScriptTimerAction(v8::Global<v8::Function>(isolate, func), 0), rate > 0 ? rate : 0, loop);
+                JavaScriptTimerAction(isolate, context, func, nullptr, 0), rate > 0 ? rate : 0, loop);
         }
         // TODO: V8 update. Once we update V8 past 12.6.221 we can skip the cast to double
         info.GetReturnValue().Set((double) (int64_t) handle);
@@ -183,6 +189,32 @@ namespace jsb
         Environment::wrap(isolate)->get_timer_manager().clear_timer((internal::TimerHandle) handle);
     }
 
+    template<FrameCallbacks& (Environment::*GetCallbacks)()>
+    void _request_frame(const v8::FunctionCallbackInfo<v8::Value>& info)
+    {
+        v8::Isolate* isolate = info.GetIsolate();
+        if (!info[0]->IsFunction())
+        {
+            jsb_throw(isolate, "bad argument");
+            return;
+        }
+
+        FrameCallbacks& callbacks = (Environment::wrap(isolate)->*GetCallbacks)();
+        info.GetReturnValue().Set(callbacks.request(isolate, info[0].As<v8::Function>()));
+    }
+
+    template<FrameCallbacks& (Environment::*GetCallbacks)()>
+    void _cancel_frame(const v8::FunctionCallbackInfo<v8::Value>& info)
+    {
+        v8::Isolate* isolate = info.GetIsolate();
+        if (!info[0]->IsInt32())
+        {
+            return;
+        }
+
+        (Environment::wrap(isolate)->*GetCallbacks)().cancel(info[0].As<v8::Int32>()->Value());
+    }
+
     void _time(const v8::FunctionCallbackInfo<v8::Value>& info)
     {
         v8::Isolate* isolate = info.GetIsolate();
@@ -260,6 +292,14 @@ namespace jsb
             self->Set(context, impl::Helper::new_string_ascii(isolate, "clearTimeout"), JSB_NEW_FUNCTION(context, _clear_timer, {})).Check();
             self->Set(context, impl::Helper::new_string_ascii(isolate, "clearImmediate"), JSB_NEW_FUNCTION(context, _clear_timer, {})).Check();
         }
+
+        // one-shot callbacks for the next (physics) frame
+        {
+            self->Set(context, impl::Helper::new_string_ascii(isolate, "requestAnimationFrame"), JSB_NEW_FUNCTION(context, _request_frame<&Environment::get_animation_frame_callbacks>, {})).Check();
+            self->Set(context, impl::Helper::new_string_ascii(isolate, "cancelAnimationFrame"), JSB_NEW_FUNCTION(context, _cancel_frame<&Environment::get_animation_frame_callbacks>, {})).Check();
+            self->Set(context, impl::Helper::new_string_ascii(isolate, "requestPhysicsFrame"), JSB_NEW_FUNCTION(context, _request_frame<&Environment::get_physics_frame_callbacks>, {})).Check();
+            self->Set(context, impl::Helper::new_string_ascii(isolate, "cancelPhysicsFrame"), JSB_NEW_FUNCTION(context, _cancel_frame<&Environment::get_physics_frame_callbacks>, {})).Check();
+        }
     }
 #endif
 
@@ -0,0 +1,282 @@
+#include "jsb_file_io.h"
+#include "jsb_environment.h"
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+
+#if !JSB_WITH_WEB
+#define JSB_FILE_IO_LOG(Severity, Format, ...) JSB_LOG_IMPL(JSFileIO, Severity, Format, ##__VA_ARGS__)
+
+namespace jsb
+{
+    BinaryMutex AsyncFileIO::lock_;
+    bool AsyncFileIO::finished_ = false;
+    bool AsyncFileIO::running_ = false;
+    List<FileRequest*> AsyncFileIO::queued_;
+    WorkerThreadPool::TaskID AsyncFileIO::pool_task_id_ = WorkerThreadPool::INVALID_TASK_ID;
+
+    namespace
+    {
+        bool get_path_arg(v8::Isolate* isolate, const v8::FunctionCallbackInfo<v8::Value>& info, String& r_path)
+        {
+            if (info.Length() == 0 || !info[0]->IsString())
+            {
+                jsb_throw(isolate, "bad path");
+                return false;
+            }
+            r_path = impl::Helper::to_string(isolate, info[0]);
+            return !r_path.is_empty();
+        }
+    }
+
+    void AsyncFileIO::_read_file(const v8::FunctionCallbackInfo<v8::Value>& info)
+    {
+        FileRequest* request = memnew(FileRequest);
+        request->type = FileRequest::TYPE_READ_FILE;
+        if (!get_path_arg(info.GetIsolate(), info, request->path))
+        {
+            memdelete(request);
+            return;
+        }
+        _start(info, request);
+    }
+
+    void AsyncFileIO::_write_file(const v8::FunctionCallbackInfo<v8::Value>& info)
+    {
+        v8::Isolate* isolate = info.GetIsolate();
+        FileRequest* request = memnew(FileRequest);
+        request->type = FileRequest::TYPE_WRITE_FILE;
+        if (!get_path_arg(isolate, info, request->path))
+        {
+            memdelete(request);
+            return;
+        }
+
+        // the content is copied, the buffer can be modified (or transferred) right after the call
+        if (info.Length() > 1 && info[1]->IsArrayBuffer())
+        {
+            const v8::Local<v8::ArrayBuffer> buffer = info[1].As<v8::ArrayBuffer>();
+            const size_t len = buffer->ByteLength();
+            request->data.resize((int64_t) len);
+            if (len) memcpy(request->data.ptrw(), buffer->Data(), len);
+        }
+        else if (info.Length() > 1 && info[1]->IsString())
+        {
+            const CharString utf8 = impl::Helper::to_string(isolate, info[1]).utf8();
+            request->data.resize(utf8.length());
+            if (utf8.length()) memcpy(request->data.ptrw(), utf8.get_data(), utf8.length());
+        }
+        else
+        {
+            memdelete(request);
+            jsb_throw(isolate, "ArrayBuffer or string expected");
+            return;
+        }
+        request->append = info.Length() > 2 && info[2]->BooleanValue(isolate);
+        _start(info, request);
+    }
+
+    void AsyncFileIO::_read_dir(const v8::FunctionCallbackInfo<v8::Value>& info)
+    {
+        FileRequest* request = memnew(FileRequest);
+        request->type = FileRequest::TYPE_READ_DIR;
+        if (!get_path_arg(info.GetIsolate(), info, request->path))
+        {
+            memdelete(request);
+            return;
+        }
+        _start(info, request);
+    }
+
+    void AsyncFileIO::_start(const v8::FunctionCallbackInfo<v8::Value>& info, FileRequest* p_request)
+    {
+        v8::Isolate* isolate = info.GetIsolate();
+        const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+        Environment* env = Environment::wrap(isolate);
+
+        const v8::Local<v8::Promise::Resolver> resolver = v8::Promise::Resolver::New(context).ToLocalChecked();
+        p_request->token = env;
+        WorkerThreadPool::TaskID previous_task_id = WorkerThreadPool::INVALID_TASK_ID;
+        {
+            MutexLock lock(lock_);
+            if (finished_)
+            {
+                memdelete(p_request);
+                jsb_throw(isolate, "the file io is already finished");
+                return;
+            }
+            p_request->resolver_id = env->add_pending_task(resolver);
+            queued_.push_back(p_request);
+            if (!running_)
+            {
+                running_ = true;
+                previous_task_id = pool_task_id_;
+                pool_task_id_ = WorkerThreadPool::get_singleton()->add_native_task(&_drain, nullptr, false, "jsb: file io");
+            }
+        }
+        // the previous one is already done (or returning), it only releases the task
+        if (previous_task_id != WorkerThreadPool::INVALID_TASK_ID)
+        {
+            WorkerThreadPool::get_singleton()->wait_for_task_completion(previous_task_id);
+        }
+        info.GetReturnValue().Set(resolver->GetPromise());
+    }
+
+    void AsyncFileIO::_drain(void* p_userdata)
+    {
+        while (true)
+        {
+            FileRequest* request;
+            {
+                MutexLock lock(lock_);
+                if (queued_.is_empty())
+                {
+                    running_ = false;
+                    return;
+                }
+                request = queued_.front()->get();
+                queued_.pop_front();
+            }
+
+            _run(request);
+            if (const std::shared_ptr<Environment> env = Environment::_access(request->token))
+            {
+                env->add_async_call(Environment::AsyncCall::TYPE_FILE_IO_DONE, request);
+            }
+            else
+            {
+                JSB_FILE_IO_LOG(Verbose, "the environment of file request %s is gone", request->path);
+                memdelete(request);
+            }
+        }
+    }
+
+    void AsyncFileIO::_run(FileRequest* p_request)
+    {
+        switch (p_request->type)
+        {
+        case FileRequest::TYPE_READ_FILE:
+            {
+                const Ref<FileAccess> file = FileAccess::open(p_request->path, FileAccess::READ, &p_request->error);
+                if (file.is_null()) break;
+                const uint64_t len = file->get_length();
+                p_request->data.resize((int64_t) len);
+                if (len && file->get_buffer(p_request->data.ptrw(), len) != len)
+                {
+                    p_request->data.clear();
+                    p_request->error = ERR_FILE_CANT_READ;
+                }
+            }
+            break;
+        case FileRequest::TYPE_WRITE_FILE:
+            {
+                const Ref<FileAccess> file = p_request->append && FileAccess::exists(p_request->path)
+                    ? FileAccess::open(p_request->path, FileAccess::READ_WRITE, &p_request->error)
+                    : FileAccess::open(p_request->path, FileAccess::WRITE, &p_request->error);
+                if (file.is_null()) break;
+                if (p_request->append) file->seek_end();
+                if (!file->store_buffer(p_request->data.ptr(), p_request->data.size()))
+                {
+                    p_request->error = ERR_FILE_CANT_WRITE;
+                }
+                p_request->data.clear();
+            }
+            break;
+        case FileRequest::TYPE_READ_DIR:
+            {
+                const Ref<DirAccess> dir = DirAccess::open(p_request->path, &p_request->error);
+                if (dir.is_null()) break;
+                dir->list_dir_begin();
+                for (String name = dir->get_next(); !name.is_empty(); name = dir->get_next())
+                {
+                    if (name == "." || name == "..") continue;
+                    p_request->entries.push_back(dir->current_is_dir() ? name + "/" : name);
+                }
+                dir->list_dir_end();
+            }
+            break;
+        default: jsb_checkf(false, "unknown file request: %d", p_request->type); break;
+        }
+    }
+
+    void AsyncFileIO::on_request_done(Environment* p_env, FileRequest* p_request)
+    {
+        v8::Global<v8::Promise::Resolver> resolver_handle;
+        if (p_env->take_pending_task(p_request->resolver_id, resolver_handle))
+        {
+            v8::Isolate* isolate = p_env->get_isolate();
+            const Environment::BridgeScope bridge_scope(p_env);
+            const v8::Local<v8::Context> context = p_env->get_context();
+            const v8::Local<v8::Promise::Resolver> resolver = resolver_handle.Get(isolate);
+            resolver_handle.Reset();
+
+            if (p_request->error != OK)
+            {
+                resolver->Reject(context, impl::Helper::new_string(isolate, jsb_format("%s: %s", p_request->path, jsb_ext_error_string(p_request->error)))).Check();
+            }
+            else
+            {
+                switch (p_request->type)
+                {
+                case FileRequest::TYPE_READ_FILE:
+                    {
+                        const int64_t len = p_request->data.size();
+                        const v8::Local<v8::ArrayBuffer> buffer = v8::ArrayBuffer::New(isolate, (size_t) len);
+                        if (len) memcpy(buffer->Data(), p_request->data.ptr(), len);
+                        resolver->Resolve(context, buffer).Check();
+                    }
+                    break;
+                case FileRequest::TYPE_READ_DIR:
+                    {
+                        const int num = p_request->entries.size();
+                        const v8::Local<v8::Array> array = v8::Array::New(isolate, num);
+                        for (int index = 0; index < num; ++index)
+                        {
+                            array->Set(context, index, impl::Helper::new_string(isolate, p_request->entries[index])).Check();
+                        }
+                        resolver->Resolve(context, array).Check();
+                    }
+                    break;
+                default:
+                    resolver->Resolve(context, v8::Undefined(isolate)).Check();
+                    break;
+                }
+            }
+            p_env->notify_microtasks_run();
+        }
+        memdelete(p_request);
+    }
+
+    void AsyncFileIO::finish()
+    {
+        WorkerThreadPool::TaskID task_id;
+        {
+            MutexLock lock(lock_);
+            finished_ = true;
+
+            // the environments waiting for them are already disposed
+            for (FileRequest* request : queued_)
+            {
+                memdelete(request);
+            }
+            queued_.clear();
+            task_id = pool_task_id_;
+            pool_task_id_ = WorkerThreadPool::INVALID_TASK_ID;
+        }
+        if (task_id != WorkerThreadPool::INVALID_TASK_ID)
+        {
+            WorkerThreadPool::get_singleton()->wait_for_task_completion(task_id);
+        }
+    }
+
+    void AsyncFileIO::expose(v8::Isolate* isolate, v8::Local<v8::Context> context, v8::Local<v8::Object> jsb_obj)
+    {
+        v8::Local<v8::Object> fs_obj = v8::Object::New(isolate);
+
+        jsb_obj->Set(context, impl::Helper::new_string_ascii(isolate, "fs"), fs_obj).Check();
+        fs_obj->Set(context, impl::Helper::new_string_ascii(isolate, "read_file"), JSB_NEW_FUNCTION(context, _read_file, {})).Check();
+        fs_obj->Set(context, impl::Helper::new_string_ascii(isolate, "write_file"), JSB_NEW_FUNCTION(context, _write_file, {})).Check();
+        fs_obj->Set(context, impl::Helper::new_string_ascii(isolate, "read_dir"), JSB_NEW_FUNCTION(context, _read_dir, {})).Check();
+    }
+}
+#endif
@@ -0,0 +1,81 @@
+#ifndef GODOTJS_FILE_IO_H
+#define GODOTJS_FILE_IO_H
+#include "jsb_bridge_pch.h"
+#include "core/object/worker_thread_pool.h"
+
+#if !JSB_WITH_WEB
+namespace jsb
+{
+    class Environment;
+
+    // a file request started by `jsb.fs` (owned by AsyncFileIO until it's settled in the environment which started it)
+    struct FileRequest
+    {
+        enum Type : uint8_t
+        {
+            TYPE_READ_FILE,
+            TYPE_WRITE_FILE,
+            TYPE_READ_DIR,
+        };
+
+        Type type;
+        bool append = false;
+
+        // the environment which started the request (the result is posted back to it)
+        void* token = nullptr;
+        internal::Index32 resolver_id;
+
+        String path;
+
+        // the content to write, or the content read
+        Vector<uint8_t> data;
+
+        // the entries read by TYPE_READ_DIR (directories end with `/`)
+        PackedStringArray entries;
+
+        Error error = OK;
+    };
+
+    /**
+     * File I/O off the calling thread (`jsb.fs`), the results are delivered as promises resolved on the loop of the calling environment.
+     * The requests of all environments are run one by one in a single WorkerThreadPool task (started on demand),
+     * so that they're completed in the order they're made (e.g. reading a file right after writing it returns the new content).
+     */
+    class AsyncFileIO
+    {
+    public:
+        static void expose(v8::Isolate* isolate, v8::Local<v8::Context> context, v8::Local<v8::Object> jsb_obj);
+
+        // wait for the running requests, call from main thread (GodotJSScriptLanguage::finish)
+        static void finish();
+
+        // [env thread] settle the promise of a request started in `p_env`
+        static void on_request_done(Environment* p_env, FileRequest* p_request);
+
+    private:
+        // [js] function read_file(path: string): Promise<ArrayBuffer>
+        static void _read_file(const v8::FunctionCallbackInfo<v8::Value>& info);
+        // [js] function write_file(path: string, data: ArrayBuffer | string, append?: boolean): Promise<void>
+        static void _write_file(const v8::FunctionCallbackInfo<v8::Value>& info);
+        // [js] function read_dir(path: string): Promise<string[]>
+        static void _read_dir(const v8::FunctionCallbackInfo<v8::Value>& info);
+
+        // take the ownership of `p_request`, and return the promise of it
+        static void _start(const v8::FunctionCallbackInfo<v8::Value>& info, FileRequest* p_request);
+
+        // [WorkerThreadPool] run the queued requests until the queue is empty
+        static void _drain(void* p_userdata);
+        static void _run(FileRequest* p_request);
+
+        static BinaryMutex lock_;
+        static bool finished_;
+        static bool running_;
+        static List<FileRequest*> queued_;
+
+        // the last drain task started (waited before starting the next one to release it in WorkerThreadPool)
+        static WorkerThreadPool::TaskID pool_task_id_;
+    };
+}
+#endif
+
+#endif
@@ -0,0 +1,88 @@
+#include "jsb_frame_callbacks.h"
+#include "jsb_bridge_helper.h"
+#include "jsb_environment.h"
+
+namespace jsb
+{
+    int32_t FrameCallbacks::request(v8::Isolate* isolate, const v8::Local<v8::Function>& p_func)
+    {
+        last_id_ = last_id_ == INT32_MAX ? 1 : last_id_ + 1;
+        pending_.push_back({ last_id_, v8::Global<v8::Function>(isolate, p_func) });
+        return last_id_;
+    }
+
+    bool FrameCallbacks::cancel(int32_t p_id)
+    {
+        for (auto it = pending_.begin(); it != pending_.end(); ++it)
+        {
+            if (it->id == p_id)
+            {
+                pending_.erase(it);
+                return true;
+            }
+        }
+
+        // cancelled by another callback in the same frame
+        for (Entry& entry : running_)
+        {
+            if (entry.id == p_id && !entry.function.IsEmpty())
+            {
+                entry.function.Reset();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void FrameCallbacks::invoke(v8::Isolate* isolate, const v8::Local<v8::Context>& p_context, double p_arg)
+    {
+        jsb_check(running_.empty());
+        running_.swap(pending_);
+
+        v8::Context::Scope context_scope(p_context);
+        const v8::Local<v8::Value> argv[] = { v8::Number::New(isolate, p_arg) };
+        for (size_t index = 0; index < running_.size(); ++index)
+        {
+            if (running_[index].function.IsEmpty())
+            {
+                continue;
+            }
+            const v8::Local<v8::Function> func = running_[index].function.Get(isolate);
+            running_[index].function.Reset();
+
+            const impl::TryCatch try_catch(isolate);
+            const v8::MaybeLocal<v8::Value> result = func->Call(p_context, v8::Undefined(isolate), std::size(argv), argv);
+            jsb_unused(result);
+            if (try_catch.has_caught())
+            {
+                BridgeHelper::log_exception(try_catch, "frame callback error ");
+            }
+        }
+        running_.clear();
+
+        if (awaiters_.empty())
+        {
+            return;
+        }
+        jsb_check(running_awaiters_.empty());
+        running_awaiters_.swap(awaiters_);
+        Environment* env = Environment::wrap(isolate);
+        for (const internal::Index32& task_id : running_awaiters_)
+        {
+            v8::Global<v8::Promise::Resolver> resolver;
+            if (env->take_pending_task(task_id, resolver))
+            {
+                resolver.Get(isolate)->Resolve(p_context, argv[0]).Check();
+            }
+        }
+        running_awaiters_.clear();
+    }
+
+    void FrameCallbacks::clear()
+    {
+        pending_.clear();
+        running_.clear();
+        awaiters_.clear();
+        running_awaiters_.clear();
+    }
+}
@@ -0,0 +1,50 @@
+#ifndef GODOTJS_FRAME_CALLBACKS_H
+#define GODOTJS_FRAME_CALLBACKS_H
+
+#include "jsb_bridge_pch.h"
+
+namespace jsb
+{
+    /**
+     * One-shot callbacks scheduled for the next frame (requestAnimationFrame/requestPhysicsFrame).
+     * Callbacks requested while invoking are deferred to the next `invoke()`.
+     * Awaiters (`jsb.next_frame()`/`jsb.next_physics_frame()`) are pending tasks of the environment resolved with the same argument,
+     * they don't create any JS function.
+     */
+    class FrameCallbacks
+    {
+        struct Entry
+        {
+            int32_t id;
+            v8::Global<v8::Function> function;
+        };
+
+        int32_t last_id_ = 0;
+        std::vector<Entry> pending_;
+
+        // the callbacks being invoked, a cancelled one is left with an empty function
+        std::vector<Entry> running_;
+
+        // pending task ids (see Environment::add_pending_task), the capacity is kept for reuse
+        std::vector<internal::Index32> awaiters_;
+        std::vector<internal::Index32> running_awaiters_;
+
+    public:
+        jsb_force_inline bool is_empty() const { return pending_.empty() && awaiters_.empty(); }
+
+        // return a positive id which is unique among all pending callbacks
+        int32_t request(v8::Isolate* isolate, const v8::Local<v8::Function>& p_func);
+
+        bool cancel(int32_t p_id);
+
+        // resolve the pending task on the next `invoke()`
+        jsb_force_inline void await(internal::Index32 p_task_id) { awaiters_.push_back(p_task_id); }
+
+        // invoke (and remove) all pending callbacks with `p_arg` as the only argument, then resolve the awaiters with it
+        void invoke(v8::Isolate* isolate, const v8::Local<v8::Context>& p_context, double p_arg);
+
+        void clear();
+    };
+}
+
+#endif
@@ -2,6 +2,7 @@
 #include "jsb_environment.h"
 #include "jsb_object_bindings.h"
 #include "jsb_type_convert.h"
+#include "jsb_shared_variant_info.h"
 
 namespace jsb
 {
@@ -56,30 +57,15 @@ namespace jsb
         // (2) (global) utility functions.
         if (Variant::has_utility_function(original_name))
         {
-            //TODO check static bindings at first, and dynamic bindings as a fallback
-
-            // dynamic binding:
-            static_assert(sizeof(Variant::ValidatedUtilityFunction) == sizeof(void*));
-            const int32_t utility_func_index = (int32_t) env->get_variant_info_collection().utility_funcs.size();
-            env->get_variant_info_collection().utility_funcs.append({});
-            internal::FUtilityMethodInfo& method_info = env->get_variant_info_collection().utility_funcs.write[utility_func_index];
-
-            const int argument_count = Variant::get_utility_function_argument_count(original_name);
-            method_info.argument_types.resize(argument_count);
-            for (int index = 0, num = argument_count; index < num; ++index)
-            {
-                method_info.argument_types.write[index] = Variant::get_utility_function_argument_type(original_name, index);
-            }
-            //NOTE currently, utility functions have no default argument.
-            // method_info.default_arguments = ...
-            method_info.return_type = Variant::get_utility_function_return_type(original_name);
-            method_info.is_vararg = Variant::is_utility_function_vararg(original_name);
-            method_info.set_debug_name(internal::NamingUtil::get_member_name(original_name));
-            method_info.utility_func = Variant::get_validated_utility_function(original_name);
+            // the function info is shared by all environments (with a direct numeric implementation if available)
+            const int32_t utility_func_index = SharedVariantInfo::get().find_utility_func_index(original_name);
+            jsb_check(utility_func_index >= 0);
+            const internal::FUtilityMethodInfo& method_info = SharedVariantInfo::get().collection.utility_funcs[utility_func_index];
             JSB_LOG(VeryVerbose, "expose godot utility function %s (%d)", original_name, utility_func_index);
-            jsb_check(method_info.utility_func);
 
-            info.GetReturnValue().Set(JSB_NEW_FUNCTION(context, ObjectReflectBindingUtil::_godot_utility_func, v8::Int32::New(isolate, utility_func_index)));
+            info.GetReturnValue().Set(JSB_NEW_FUNCTION(context,
+                method_info.number_func ? ObjectReflectBindingUtil::_godot_utility_func_number : ObjectReflectBindingUtil::_godot_utility_func,
+                v8::Int32::New(isolate, utility_func_index)));
             return;
         }
 
@@ -159,13 +145,12 @@ namespace jsb
             v8::Local<v8::Value> argv[] = { builtin_symbols, JSB_NEW_FUNCTION(context, _load_godot_object_class, {}) };
             const v8::MaybeLocal<v8::Value> result = proxy_func->Call(context, v8::Undefined(isolate), std::size(argv), argv);
 
-            if (v8::Local<v8::Value> proxy; result.ToLocal(&proxy))
+            // a plain object inheriting the loader proxy (the loaded types are cached as its own properties)
+            if (v8::Local<v8::Value> exports; result.ToLocal(&exports))
             {
-#if JSB_WITH_V8
-                jsb_check(proxy->IsProxy());
-#endif
-                loader_.Reset(p_env->get_isolate(), proxy.As<v8::Object>());
-                return proxy.As<v8::Object>();
+                jsb_check(exports->IsObject() && !exports->IsProxy());
+                loader_.Reset(p_env->get_isolate(), exports.As<v8::Object>());
+                return exports.As<v8::Object>();
             }
             // empty means error thrown in Call()
         }
@@ -188,7 +173,7 @@ namespace jsb
             return false;
         }
 
-        // it's a proxy object which will load godot type on-demand until it's actually accessed in a script
+        // godot types are loaded on-demand by the proxy in its prototype chain until they're actually accessed in a script
         p_module.exports.Reset(isolate, loader);
         return true;
     }
@@ -0,0 +1,142 @@
+#include "jsb_input_snapshot.h"
+#include "jsb_environment.h"
+
+#include "core/input/input.h"
+#include "core/input/input_map.h"
+
+#if !JSB_WITH_WEB
+namespace jsb
+{
+    bool InputSnapshots::_write(const Snapshot& p_snapshot, const v8::Local<v8::ArrayBuffer>& p_buffer)
+    {
+        const uint32_t count = p_snapshot.actions.size();
+        if (p_buffer->ByteLength() != count * (sizeof(float) + sizeof(uint8_t)))
+        {
+            return false;
+        }
+
+        const Input* input = Input::get_singleton();
+        float* strengths = (float*) p_buffer->Data();
+        uint8_t* flags = (uint8_t*) (strengths + count);
+        for (uint32_t index = 0; index < count; ++index)
+        {
+            const StringName& action = p_snapshot.actions[index];
+            strengths[index] = input->get_action_strength(action);
+            flags[index] = (input->is_action_pressed(action) ? Pressed : 0)
+                | (input->is_action_just_pressed(action) ? JustPressed : 0)
+                | (input->is_action_just_released(action) ? JustReleased : 0);
+        }
+        return true;
+    }
+
+    void InputSnapshots::update(v8::Isolate* isolate)
+    {
+        for (const Snapshot& snapshot : snapshots_)
+        {
+            if (snapshot.auto_update)
+            {
+                _write(snapshot, snapshot.buffer.Get(isolate));
+            }
+        }
+    }
+
+    InputSnapshots::Snapshot* InputSnapshots::_find(v8::Isolate* isolate, const v8::Local<v8::Value>& p_buffer)
+    {
+        if (!p_buffer->IsArrayBuffer())
+        {
+            return nullptr;
+        }
+        for (Snapshot& snapshot : snapshots_)
+        {
+            if (snapshot.buffer == p_buffer)
+            {
+                return &snapshot;
+            }
+        }
+        return nullptr;
+    }
+
+    void InputSnapshots::_create_snapshot(const v8::FunctionCallbackInfo<v8::Value>& info)
+    {
+        v8::Isolate* isolate = info.GetIsolate();
+        const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+        if (!info[0]->IsArray())
+        {
+            jsb_throw(isolate, "bad actions");
+            return;
+        }
+
+        Environment* env = Environment::wrap(isolate);
+        const v8::Local<v8::Array> array = info[0].As<v8::Array>();
+        const uint32_t count = array->Length();
+        Snapshot snapshot;
+        snapshot.auto_update = info.Length() < 2 || info[1]->IsUndefined() || info[1]->BooleanValue(isolate);
+        snapshot.actions.resize(count);
+        for (uint32_t index = 0; index < count; ++index)
+        {
+            v8::Local<v8::Value> element;
+            if (!array->Get(context, index).ToLocal(&element) || !element->IsString())
+            {
+                jsb_throw(isolate, jsb_format("bad action at %d", index));
+                return;
+            }
+            const StringName action = env->get_string_name_cache().get_string_name(isolate, element.As<v8::String>());
+
+            // otherwise, Input reports an error on every poll
+            if (!InputMap::get_singleton()->has_action(action))
+            {
+                jsb_throw(isolate, jsb_format("unknown action %s", action));
+                return;
+            }
+            snapshot.actions[index] = action;
+        }
+
+        const v8::Local<v8::ArrayBuffer> buffer = v8::ArrayBuffer::New(isolate, count * (sizeof(float) + sizeof(uint8_t)));
+        snapshot.buffer.Reset(isolate, buffer);
+        _write(snapshot, buffer);
+        env->get_input_snapshots().snapshots_.push_back(std::move(snapshot));
+        info.GetReturnValue().Set(buffer);
+    }
+
+    void InputSnapshots::_update_snapshot(const v8::FunctionCallbackInfo<v8::Value>& info)
+    {
+        v8::Isolate* isolate = info.GetIsolate();
+        const Snapshot* snapshot = Environment::wrap(isolate)->get_input_snapshots()._find(isolate, info[0]);
+        if (!snapshot)
+        {
+            jsb_throw(isolate, "not a snapshot");
+            return;
+        }
+        if (!_write(*snapshot, info[0].As<v8::ArrayBuffer>()))
+        {
+            jsb_throw(isolate, "snapshot detached");
+        }
+    }
+
+    void InputSnapshots::_release_snapshot(const v8::FunctionCallbackInfo<v8::Value>& info)
+    {
+        v8::Isolate* isolate = info.GetIsolate();
+        InputSnapshots& snapshots = Environment::wrap(isolate)->get_input_snapshots();
+        const Snapshot* snapshot = snapshots._find(isolate, info[0]);
+        const bool found = snapshot != nullptr;
+        if (found)
+        {
+            snapshots.snapshots_.erase(snapshots.snapshots_.begin() + (snapshot - snapshots.snapshots_.data()));
+        }
+        info.GetReturnValue().Set(v8::Boolean::New(isolate, found));
+    }
+
+    void InputSnapshots::expose(v8::Isolate* isolate, v8::Local<v8::Context> context, v8::Local<v8::Object> jsb_obj)
+    {
+        const v8::Local<v8::Object> input_obj = v8::Object::New(isolate);
+
+        jsb_obj->Set(context, impl::Helper::new_string_ascii(isolate, "input"), input_obj).Check();
+        input_obj->Set(context, impl::Helper::new_string_ascii(isolate, "PRESSED"), v8::Int32::New(isolate, Pressed)).Check();
+        input_obj->Set(context, impl::Helper::new_string_ascii(isolate, "JUST_PRESSED"), v8::Int32::New(isolate, JustPressed)).Check();
+        input_obj->Set(context, impl::Helper::new_string_ascii(isolate, "JUST_RELEASED"), v8::Int32::New(isolate, JustReleased)).Check();
+        input_obj->Set(context, impl::Helper::new_string_ascii(isolate, "create_snapshot"), JSB_NEW_FUNCTION(context, _create_snapshot, {})).Check();
+        input_obj->Set(context, impl::Helper::new_string_ascii(isolate, "update_snapshot"), JSB_NEW_FUNCTION(context, _update_snapshot, {})).Check();
+        input_obj->Set(context, impl::Helper::new_string_ascii(isolate, "release_snapshot"), JSB_NEW_FUNCTION(context, _release_snapshot, {})).Check();
+    }
+}
+#endif
@@ -0,0 +1,58 @@
+#ifndef GODOTJS_INPUT_SNAPSHOT_H
+#define GODOTJS_INPUT_SNAPSHOT_H
+#include "jsb_bridge_pch.h"
+
+#if !JSB_WITH_WEB
+namespace jsb
+{
+    /**
+     * The states of a set of input actions written into an ArrayBuffer shared with JS (`jsb.input`), polled with one native call per frame.
+     * Layout of the buffer for `n` actions (in the registered order):
+     *   - `Float32Array(buffer, 0, n)`: the action strength
+     *   - `Uint8Array(buffer, n * 4, n)`: the flags (see Flags)
+     * Auto-update snapshots are refreshed at the beginning of `Environment::update`, before timers and frame callbacks.
+     */
+    class InputSnapshots
+    {
+    public:
+        enum Flags : uint8_t
+        {
+            Pressed = 1 << 0,
+            JustPressed = 1 << 1,
+            JustReleased = 1 << 2,
+        };
+
+        jsb_force_inline bool is_empty() const { return snapshots_.empty(); }
+
+        // refresh all auto-update snapshots
+        void update(v8::Isolate* isolate);
+
+        void clear() { snapshots_.clear(); }
+
+        static void expose(v8::Isolate* isolate, v8::Local<v8::Context> context, v8::Local<v8::Object> jsb_obj);
+
+    private:
+        struct Snapshot
+        {
+            LocalVector<StringName> actions;
+            v8::Global<v8::ArrayBuffer> buffer;
+            bool auto_update;
+        };
+
+        // return false if the buffer is detached (e.g. transferred to a worker)
+        static bool _write(const Snapshot& p_snapshot, const v8::Local<v8::ArrayBuffer>& p_buffer);
+
+        Snapshot* _find(v8::Isolate* isolate, const v8::Local<v8::Value>& p_buffer);
+
+        // [js] function create_snapshot(actions: string[], auto_update?: boolean): ArrayBuffer
+        static void _create_snapshot(const v8::FunctionCallbackInfo<v8::Value>& info);
+        // [js] function update_snapshot(buffer: ArrayBuffer): void
+        static void _update_snapshot(const v8::FunctionCallbackInfo<v8::Value>& info);
+        // [js] function release_snapshot(buffer: ArrayBuffer): boolean
+        static void _release_snapshot(const v8::FunctionCallbackInfo<v8::Value>& info);
+
+        std::vector<Snapshot> snapshots_;
+    };
+}
+#endif
+#endif
@@ -0,0 +1,138 @@
+#include "jsb_instance_pool.h"
+#include "jsb_environment.h"
+#include "jsb_type_convert.h"
+
+#include "scene/main/node.h"
+
+namespace jsb
+{
+    namespace
+    {
+        Node* get_node_arg(v8::Isolate* isolate, const v8::Local<v8::Context>& context, const v8::FunctionCallbackInfo<v8::Value>& info, int p_index)
+        {
+            Object* obj = nullptr;
+            if (info.Length() <= p_index || !info[p_index]->IsObject() || !TypeConvert::js_to_gd_obj(isolate, context, info[p_index], obj) || !obj)
+            {
+                jsb_throw(isolate, jsb_format("bad node at %d", p_index));
+                return nullptr;
+            }
+            Node* node = Object::cast_to<Node>(obj);
+            if (!node)
+            {
+                jsb_throw(isolate, jsb_format("not a node at %d", p_index));
+            }
+            return node;
+        }
+
+        // call the hook if it's implemented by the object, return false if an exception is thrown
+        bool call_hook(Environment* p_env, const v8::Local<v8::Context>& context, const v8::Local<v8::Value>& p_self, const StringName& p_name)
+        {
+            v8::Local<v8::Value> hook;
+            if (!p_self.As<v8::Object>()->Get(context, p_env->get_string_value(p_name)).ToLocal(&hook))
+            {
+                return false;
+            }
+            if (!hook->IsFunction())
+            {
+                return true;
+            }
+            return !hook.As<v8::Function>()->Call(context, p_self, 0, nullptr).IsEmpty();
+        }
+
+        const StringName& get_on_pooled_name()
+        {
+            static const StringName name = internal::NamingUtil::get_member_name(StringName("on_pooled"));
+            return name;
+        }
+
+        const StringName& get_on_unpooled_name()
+        {
+            static const StringName name = internal::NamingUtil::get_member_name(StringName("on_unpooled"));
+            return name;
+        }
+
+        // function park(node: Node): boolean;
+        void _park(const v8::FunctionCallbackInfo<v8::Value>& info)
+        {
+            v8::Isolate* isolate = info.GetIsolate();
+            const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+            Node* node = get_node_arg(isolate, context, info, 0);
+            if (!node)
+            {
+                return;
+            }
+
+            Environment* env = Environment::wrap(isolate);
+            if (!env->add_parked_node(node->get_instance_id()))
+            {
+                info.GetReturnValue().Set(v8::Boolean::New(isolate, false));
+                return;
+            }
+            if (Node* parent = node->get_parent())
+            {
+                parent->remove_child(node);
+            }
+            if (call_hook(env, context, info[0], get_on_pooled_name()))
+            {
+                info.GetReturnValue().Set(v8::Boolean::New(isolate, true));
+            }
+        }
+
+        // function unpark(node: Node, parent?: Node): boolean;
+        void _unpark(const v8::FunctionCallbackInfo<v8::Value>& info)
+        {
+            v8::Isolate* isolate = info.GetIsolate();
+            const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+            Node* node = get_node_arg(isolate, context, info, 0);
+            if (!node)
+            {
+                return;
+            }
+            Node* parent = nullptr;
+            if (info.Length() > 1 && !info[1]->IsNullOrUndefined())
+            {
+                parent = get_node_arg(isolate, context, info, 1);
+                if (!parent)
+                {
+                    return;
+                }
+            }
+
+            Environment* env = Environment::wrap(isolate);
+            if (!env->remove_parked_node(node->get_instance_id()))
+            {
+                info.GetReturnValue().Set(v8::Boolean::New(isolate, false));
+                return;
+            }
+            if (parent)
+            {
+                parent->add_child(node);
+            }
+            if (call_hook(env, context, info[0], get_on_unpooled_name()))
+            {
+                info.GetReturnValue().Set(v8::Boolean::New(isolate, true));
+            }
+        }
+
+        // function is_parked(node: Node): boolean;
+        void _is_parked(const v8::FunctionCallbackInfo<v8::Value>& info)
+        {
+            v8::Isolate* isolate = info.GetIsolate();
+            const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+            if (const Node* node = get_node_arg(isolate, context, info, 0))
+            {
+                info.GetReturnValue().Set(v8::Boolean::New(isolate, Environment::wrap(isolate)->is_parked_node(node->get_instance_id())));
+            }
+        }
+    }
+
+    void InstancePool::expose(v8::Isolate* isolate, v8::Local<v8::Context> context, v8::Local<v8::Object> jsb_obj)
+    {
+        const v8::Local<v8::Object> pool_obj = v8::Object::New(isolate);
+        jsb_obj->Set(context, impl::Helper::new_string_ascii(isolate, "pool"), pool_obj).Check();
+
+        pool_obj->Set(context, impl::Helper::new_string_ascii(isolate, "park"), JSB_NEW_FUNCTION(context, _park, {})).Check();
+        pool_obj->Set(context, impl::Helper::new_string_ascii(isolate, "unpark"), JSB_NEW_FUNCTION(context, _unpark, {})).Check();
+        pool_obj->Set(context, impl::Helper::new_string_ascii(isolate, "is_parked"), JSB_NEW_FUNCTION(context, _is_parked, {})).Check();
+    }
+}
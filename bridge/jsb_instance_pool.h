@@ -0,0 +1,17 @@
+#ifndef GODOTJS_INSTANCE_POOL_H
+#define GODOTJS_INSTANCE_POOL_H
+#include "jsb_bridge_pch.h"
+
+namespace jsb
+{
+    /**
+     * Park scripted nodes out of the tree for reuse (`jsb.pool`), the script instance and the JS object are kept as they are.
+     * `on_pooled`/`on_unpooled` (`onPooled`/`onUnpooled` with camel-case bindings) are called instead of constructing new instances.
+     * `_ready` and @onready are not evaluated again when a node is unparked, since godot notifies `ready` only once unless `request_ready` is called.
+     */
+    struct InstancePool
+    {
+        static void expose(v8::Isolate* isolate, v8::Local<v8::Context> context, v8::Local<v8::Object> jsb_obj);
+    };
+}
+#endif
@@ -5,6 +5,21 @@
 
 namespace jsb
 {
+#if JSB_WITH_SHARED_ARRAY_BUFFER
+    // backing stores referenced (not copied) by a serialized message,
+    // the message keeps them alive until it's deserialized in the receiver environment.
+    struct MessageBackingStores
+    {
+        // SharedArrayBuffers, the memory is shared by the sender and the receiver
+        std::vector<std::shared_ptr<v8::BackingStore>> shared;
+
+        // ArrayBuffers in the transfer list, detached from the sender and adopted by the receiver (v8 only)
+        std::vector<std::shared_ptr<v8::BackingStore>> transferred;
+    };
+#else
+    struct MessageBackingStores {};
+#endif
+
     struct TransferData
     {
         NativeObjectID source_worker_id;
@@ -13,6 +28,10 @@ namespace jsb
         String script_path;
         List<Pair<StringName, Variant>> state;
 
+        // the script state encoded in one buffer (`[name, value]*` by encode_variant) if it's all plain data, `state` is empty in this case.
+        // it's copy-on-write, copying the TransferData into the transfer map and the message doesn't copy the state.
+        Vector<uint8_t> packed_state;
+
         TransferData() : transfer_index(0)
         {
         }
@@ -40,6 +59,9 @@ namespace jsb
             // worker message
             TYPE_MESSAGE,
 
+            // worker messages posted at once by `postMessages` (an array of them in one buffer)
+            TYPE_MESSAGES,
+
             //TODO worker error (NOT IMPLEMENTED YET)
             TYPE_ERROR,
         };
@@ -54,8 +76,10 @@ namespace jsb
         Message& operator=(Message&&) noexcept = default;
 
         Message(Type p_type, NativeObjectID p_id, Buffer&& p_buffer = Buffer(),
-            std::vector<TransferData>&& p_transfers = std::vector<TransferData>())
-            : type_(p_type), id_(p_id), buffer_(std::move(p_buffer)), transfers(std::move(p_transfers))
+            std::vector<TransferData>&& p_transfers = std::vector<TransferData>(),
+            MessageBackingStores&& p_backing_stores = MessageBackingStores())
+            : type_(p_type), id_(p_id), buffer_(std::move(p_buffer)), transfers(std::move(p_transfers)),
+              backing_stores_(std::move(p_backing_stores))
         {
         }
 
@@ -68,11 +92,14 @@ namespace jsb
 
         const std::vector<TransferData>& get_transfers() const { return transfers; }
 
+        const MessageBackingStores& get_backing_stores() const { return backing_stores_; }
+
     private:
         Type type_;
         NativeObjectID id_;
         Buffer buffer_;
         std::vector<TransferData> transfers;
+        MessageBackingStores backing_stores_;
     };
 
 }
@@ -0,0 +1,271 @@
+#include "jsb_metrics.h"
+#include "jsb_environment.h"
+#include "jsb_worker.h"
+#include "../internal/jsb_thread_util.h"
+
+#if JSB_WITH_LWS
+#include "libwebsockets.h"
+#endif
+
+#define JSB_METRICS_LOG(Severity, Format, ...) JSB_LOG_IMPL(JSMetrics, Severity, Format, ##__VA_ARGS__)
+
+namespace jsb
+{
+    namespace
+    {
+        // the front slot is `(sequence_ - 1) & 1`, the back slot (being written) is `sequence_ & 1`
+        MetricsSnapshot slots_[2];
+        std::atomic<uint64_t> sequence_ = 0;
+
+        void write_metric(StringBuilder& sb, const char* p_name, const char* p_type, const char* p_help, const String& p_value)
+        {
+            sb.append("# HELP godotjs_"); sb.append(p_name); sb.append(" "); sb.append(p_help); sb.append("\n");
+            sb.append("# TYPE godotjs_"); sb.append(p_name); sb.append(" "); sb.append(p_type); sb.append("\n");
+            sb.append("godotjs_"); sb.append(p_name); sb.append(" "); sb.append(p_value); sb.append("\n");
+        }
+
+        void write_gauge(StringBuilder& sb, const char* p_name, const char* p_help, uint64_t p_value)
+        {
+            write_metric(sb, p_name, "gauge", p_help, itos((int64_t) p_value));
+        }
+
+        void write_counter(StringBuilder& sb, const char* p_name, const char* p_help, uint64_t p_value)
+        {
+            write_metric(sb, p_name, "counter", p_help, itos((int64_t) p_value));
+        }
+    }
+
+    void Metrics::publish(const Environment* p_env)
+    {
+        Statistics stats;
+        p_env->get_statistics(stats);
+
+        const uint64_t sequence = sequence_.load(std::memory_order_relaxed);
+        // the writes to the back slot must not be reordered before the last flip of the sequence
+        std::atomic_thread_fence(std::memory_order_release);
+
+        MetricsSnapshot& snapshot = slots_[sequence & 1];
+        snapshot.time_usec = OS::get_singleton()->get_ticks_usec();
+        snapshot.objects = stats.objects;
+        snapshot.native_classes = stats.native_classes;
+        snapshot.script_classes = stats.script_classes;
+        snapshot.cached_string_names = stats.cached_string_names;
+        snapshot.persistent_objects = stats.persistent_objects;
+        snapshot.allocated_variants = stats.allocated_variants;
+        snapshot.counters = stats.counters;
+        snapshot.heap_used = 0;
+        snapshot.heap_total = 0;
+        for (const impl::CustomField& field : stats.custom_fields)
+        {
+            // v8
+            if (field.name == "heap_size" && field.type == impl::CustomField::TYPE_UINT_CAP)
+            {
+                snapshot.heap_used = field.u.u64_cap[0];
+                snapshot.heap_total = field.u.u64_cap[1];
+                break;
+            }
+            // quickjs
+            if (field.name == "memory_used_size" && field.type == impl::CustomField::TYPE_INT_VALUE)
+            {
+                snapshot.heap_used = (uint64_t) MAX(field.u.i64, (int64_t) 0);
+                break;
+            }
+        }
+#if !JSB_WITH_WEB
+        Worker::get_statistics(snapshot.workers, snapshot.worker_queued_messages);
+#endif
+
+        sequence_.store(sequence + 1, std::memory_order_release);
+    }
+
+    bool Metrics::read(MetricsSnapshot& r_snapshot)
+    {
+        while (true)
+        {
+            const uint64_t sequence = sequence_.load(std::memory_order_acquire);
+            if (sequence == 0)
+            {
+                return false;
+            }
+            r_snapshot = slots_[(sequence - 1) & 1];
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            // the slot copied is only rewritten after the sequence moves on, retry it (rarely, it's published once per interval)
+            if (sequence_.load(std::memory_order_relaxed) == sequence)
+            {
+                return true;
+            }
+        }
+    }
+
+    String Metrics::format_text(const MetricsSnapshot& p_snapshot)
+    {
+        const StatisticsCounters& counters = p_snapshot.counters;
+        StringBuilder sb;
+        write_gauge(sb, "objects", "Number of native objects bound in the main environment.", p_snapshot.objects);
+        write_gauge(sb, "native_classes", "Number of registered native classes.", p_snapshot.native_classes);
+        write_gauge(sb, "script_classes", "Number of registered script classes.", p_snapshot.script_classes);
+        write_gauge(sb, "cached_string_names", "Number of cached StringName values.", p_snapshot.cached_string_names);
+        write_gauge(sb, "persistent_objects", "Number of persistent objects.", p_snapshot.persistent_objects);
+        write_gauge(sb, "allocated_variants", "Number of Variants allocated in the pool (debug only).", p_snapshot.allocated_variants);
+        write_gauge(sb, "heap_used_bytes", "Used size of the JS heap.", p_snapshot.heap_used);
+        write_gauge(sb, "heap_total_bytes", "Total size of the JS heap (0 if not reported).", p_snapshot.heap_total);
+        write_gauge(sb, "workers", "Number of alive workers.", p_snapshot.workers);
+        write_gauge(sb, "worker_queued_messages", "Number of messages posted to workers but not handled yet.", p_snapshot.worker_queued_messages);
+
+        write_counter(sb, "bridge_calls_total", "Calls into JS from the engine.", counters.bridge_calls);
+        write_counter(sb, "valuetype_bindings_total", "JS wrappers created for Variant values.", counters.valuetype_bindings);
+        write_counter(sb, "object_bindings_total", "JS wrappers created for godot objects.", counters.object_bindings);
+        write_counter(sb, "variant_allocs_total", "Variants allocated in the pool (debug only).", counters.variant_allocs);
+        write_counter(sb, "variant_frees_total", "Variants freed in the pool (debug only).", counters.variant_frees);
+        write_counter(sb, "gc_total", "Garbage collections (if gc timing is available).", counters.gc_count);
+        write_metric(sb, "gc_seconds_total", "counter", "Time spent in garbage collections (if gc timing is available).", rtos((double) counters.gc_time_usec / 1e6));
+        write_counter(sb, "string_name_hits_total", "StringName cache hits.", counters.string_name_hits);
+        write_counter(sb, "string_name_misses_total", "StringName cache misses.", counters.string_name_misses);
+        write_counter(sb, "string_name_evictions_total", "StringName cache evictions.", counters.string_name_evictions);
+        write_metric(sb, "microtask_seconds_total", "counter", "Time spent in running microtasks.", rtos((double) counters.microtask_time_usec / 1e6));
+        return sb.as_string();
+    }
+
+#if JSB_WITH_LWS
+    namespace
+    {
+        class MetricsServer
+        {
+            lws_protocols protocols_[2] = { {}, {} };
+            lws_context* context_ = nullptr;
+            Thread io_thread_;
+            std::atomic<bool> quit_ = false;
+
+        public:
+            bool start(uint16_t p_port)
+            {
+                protocols_[0].name = "http";
+                protocols_[0].callback = _http_callback;
+
+                lws_context_creation_info context_creation_info = {};
+                context_creation_info.port = p_port;
+                context_creation_info.protocols = protocols_;
+                context_creation_info.gid = -1;
+                context_creation_info.uid = -1;
+                context_creation_info.user = this;
+                context_creation_info.options = LWS_SERVER_OPTION_DISABLE_IPV6;
+                context_ = lws_create_context(&context_creation_info);
+                if (!context_)
+                {
+                    return false;
+                }
+                Thread::Settings settings;
+                settings.priority = Thread::PRIORITY_LOW;
+                io_thread_.start(&_io_thread_run, this, settings);
+                return true;
+            }
+
+            ~MetricsServer()
+            {
+                if (io_thread_.is_started())
+                {
+                    quit_.store(true);
+                    lws_cancel_service(context_);
+                    io_thread_.wait_to_finish();
+                }
+                if (context_) lws_context_destroy(context_);
+            }
+
+        private:
+            static void _io_thread_run(void* p_userdata)
+            {
+                MetricsServer* server = (MetricsServer*) p_userdata;
+                internal::ThreadUtil::set_name("jsb.metrics");
+                while (!server->quit_.load())
+                {
+                    // block until any socket event or lws_cancel_service
+                    if (lws_service(server->context_, 0) < 0) break;
+                }
+            }
+
+            static int _respond(lws* wsi, const CharString& p_content)
+            {
+                const int content_len = p_content.length();
+                LocalVector<unsigned char> buf;
+                buf.resize(LWS_PRE + 1024 + content_len);
+                unsigned char* start = buf.ptr() + LWS_PRE;
+                unsigned char* p = start;
+                unsigned char* end = buf.ptr() + buf.size();
+                if (lws_add_http_common_headers(wsi, HTTP_STATUS_OK, "text/plain; version=0.0.4", content_len, &p, end)
+                    || lws_finalize_write_http_header(wsi, start, &p, end))
+                {
+                    return -1;
+                }
+                memcpy(start, p_content.ptr(), content_len);
+                if (lws_write(wsi, start, content_len, LWS_WRITE_HTTP_FINAL) != content_len)
+                {
+                    return -1;
+                }
+                return lws_http_transaction_completed(wsi) ? -1 : 0;
+            }
+
+            static int _http_callback(lws* wsi, lws_callback_reasons reason, void* user, void* in, size_t len)
+            {
+                switch (reason)
+                {
+                case LWS_CALLBACK_HTTP:
+                    {
+                        char uri[64];
+                        const int uri_len = lws_hdr_copy(wsi, uri, (int) std::size(uri), WSI_TOKEN_GET_URI);
+                        if (uri_len <= 0 || strcmp(uri, "/metrics") != 0)
+                        {
+                            lws_return_http_status(wsi, HTTP_STATUS_NOT_FOUND, nullptr);
+                            return -1;
+                        }
+                        MetricsSnapshot snapshot;
+                        if (!Metrics::read(snapshot))
+                        {
+                            lws_return_http_status(wsi, HTTP_STATUS_SERVICE_UNAVAILABLE, nullptr);
+                            return -1;
+                        }
+                        _respond(wsi, Metrics::format_text(snapshot).utf8());
+                        return -1;
+                    }
+                default:
+                    return lws_callback_http_dummy(wsi, reason, user, in, len);
+                }
+            }
+        };
+
+        MetricsServer* server_ = nullptr;
+    }
+
+    void Metrics::start_server(uint16_t p_port)
+    {
+        jsb_check(!server_);
+        server_ = memnew(MetricsServer);
+        if (!server_->start(p_port))
+        {
+            JSB_METRICS_LOG(Error, "failed to listen on port %d", p_port);
+            memdelete(server_);
+            server_ = nullptr;
+            return;
+        }
+        JSB_METRICS_LOG(Verbose, "http://127.0.0.1:%d/metrics", p_port);
+    }
+
+    void Metrics::stop_server()
+    {
+        if (server_)
+        {
+            memdelete(server_);
+            server_ = nullptr;
+        }
+    }
+#else
+    void Metrics::start_server(uint16_t p_port)
+    {
+        JSB_METRICS_LOG(Warning, "metrics server is not available (built without libwebsockets), only Metrics::read works");
+    }
+
+    void Metrics::stop_server()
+    {
+    }
+#endif
+}
@@ -0,0 +1,57 @@
+#ifndef GODOTJS_METRICS_H
+#define GODOTJS_METRICS_H
+#include "jsb_bridge_pch.h"
+#include "jsb_statistics.h"
+
+namespace jsb
+{
+    class Environment;
+
+    // a flat copy of the statistics of the main environment (and the state of workers), it can be copied by any thread
+    struct MetricsSnapshot
+    {
+        // when it's taken (OS::get_ticks_usec), 0 if nothing published yet
+        uint64_t time_usec = 0;
+
+        int objects = 0;
+        int native_classes = 0;
+        int script_classes = 0;
+        int cached_string_names = 0;
+        uint32_t persistent_objects = 0;
+        uint32_t allocated_variants = 0;
+
+        StatisticsCounters counters;
+
+        // the JS heap in bytes (0 if not reported by the backend)
+        uint64_t heap_used = 0;
+        uint64_t heap_total = 0;
+
+        // alive workers, and the messages posted to them but not handled yet
+        uint32_t workers = 0;
+        uint64_t worker_queued_messages = 0;
+    };
+
+    /**
+     * The latest metrics of the main environment for monitoring in production (see `runtime/debugger/metrics_port`).
+     * It's double-buffered with a sequence number (seqlock): the main thread publishes into the back slot and flips the sequence,
+     * the readers on any thread copy the front slot without lock and retry if it's overwritten meanwhile.
+     * The snapshot can be served over HTTP (`GET /metrics`) as plain text in the Prometheus exposition format.
+     */
+    class Metrics
+    {
+    public:
+        // [main thread] take a snapshot of `p_env` and publish it
+        static void publish(const Environment* p_env);
+
+        // [any thread] return false if nothing published yet
+        static bool read(MetricsSnapshot& r_snapshot);
+
+        static String format_text(const MetricsSnapshot& p_snapshot);
+
+        // serve the snapshot on a dedicated I/O thread (only available with libwebsockets), `p_port` 0 to disable
+        static void start_server(uint16_t p_port);
+        static void stop_server();
+    };
+}
+
+#endif
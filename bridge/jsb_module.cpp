@@ -27,13 +27,17 @@ namespace jsb
         {
             time_modified = latest_time;
 
-            const String latest_hash = FileAccess::get_md5(source_info.source_filepath);
-            if (!latest_hash.is_empty() && latest_hash != hash)
+            // touched but not modified if both the size and the content hash are the same
+            const Ref<FileAccess> file = FileAccess::open(source_info.source_filepath, FileAccess::READ);
+            if (file.is_null()) return false;
+            const uint64_t latest_size = file->get_length();
+            if (latest_size == size && internal::ContentHash::compute(file->get_buffer((int64_t) latest_size)) == hash)
             {
-                hash = latest_hash;
-                reload_requested = true;
-                return true;
+                return false;
             }
+            size = latest_size;
+            reload_requested = true;
+            return true;
         }
 #endif
         return false;
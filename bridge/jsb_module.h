@@ -42,8 +42,13 @@ namespace jsb
 
 #if JSB_SUPPORT_RELOAD && defined(TOOLS_ENABLED)
         bool reload_requested = false;
+        // the revision of the source when it's loaded, the content is only hashed again if the timestamp changes
         uint64_t time_modified = 0;
-        String hash;
+        uint64_t size = 0;
+        uint64_t hash = 0;
+
+        // the modules which required this module (they hold the exports of it, and need to be reloaded along with it)
+        HashSet<StringName> dependents;
 
         jsb_force_inline bool is_reloading() const { return reload_requested; }
 
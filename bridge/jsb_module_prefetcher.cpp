@@ -0,0 +1,206 @@
+#include "jsb_module_prefetcher.h"
+#include "jsb_module_resolver.h"
+#include "../internal/jsb_path_util.h"
+#include "../internal/jsb_code_cache.h"
+
+namespace jsb
+{
+#if JSB_WITH_V8
+    namespace
+    {
+        // feeds the wrapped module source to the streaming task (called in the background task)
+        class PrefetchedSourceStream : public v8::ScriptCompiler::ExternalSourceStream
+        {
+            const ModulePrefetcher::Source* source_;
+            bool consumed_ = false;
+
+        public:
+            PrefetchedSourceStream(const ModulePrefetcher::Source* p_source) : source_(p_source) {}
+
+            virtual size_t GetMoreData(const uint8_t** r_src) override
+            {
+                if (consumed_ || source_->wrapped.is_empty())
+                {
+                    return 0;
+                }
+                consumed_ = true;
+
+                // V8 takes the ownership of the chunk (deleted with delete[]), the terminating zero is excluded
+                const size_t len = source_->wrapped.size() - 1;
+                uint8_t* chunk = new uint8_t[len];
+                memcpy(chunk, source_->wrapped.ptr(), len);
+                *r_src = chunk;
+                return len;
+            }
+        };
+    }
+#endif
+
+#if JSB_WITH_THREADED_SCRIPT_PRELOAD
+    namespace
+    {
+        BinaryMutex preloaded_lock_;
+        HashMap<String, std::shared_ptr<ModulePrefetcher::Source>> preloaded_;
+
+        // the scripts loaded but never evaluated stay in memory, stop preloading when it's too much
+        constexpr size_t kMaxPreloadedSize = 64 * 1024 * 1024;
+        size_t preloaded_size_ = 0;
+    }
+#endif
+
+    void ModulePrefetcher::_run(void* p_source)
+    {
+        Source* source = (Source*) p_source;
+        const Ref<FileAccess> file = FileAccess::open(source->asset_path, FileAccess::READ);
+        if (file.is_valid())
+        {
+            source->path_absolute = file->get_path_absolute();
+            source->bytes = file->get_buffer((int64_t) file->get_length());
+        }
+
+#if JSB_WITH_V8
+        if (source->streaming_task)
+        {
+            if (!source->bytes.is_empty())
+            {
+                const internal::BytesSourceReader reader(source->asset_path, source->path_absolute, source->bytes);
+                DefaultModuleResolver::read_all_bytes_with_shebang(reader, source->wrapped);
+            }
+            source->streaming_task->Run();
+        }
+#endif
+    }
+
+    void ModulePrefetcher::prefetch(v8::Isolate* p_isolate, const String& p_asset_path, bool p_streaming)
+    {
+        if (sources_.has(p_asset_path))
+        {
+            return;
+        }
+
+        const std::shared_ptr<Source> source = std::make_shared<Source>();
+        source->asset_path = p_asset_path;
+#if JSB_WITH_V8
+        if (p_streaming)
+        {
+            source->streamed = std::make_unique<v8::ScriptCompiler::StreamedSource>(
+                std::make_unique<PrefetchedSourceStream>(source.get()), v8::ScriptCompiler::StreamedSource::UTF8);
+            source->streaming_task.reset(v8::ScriptCompiler::StartStreaming(p_isolate, source->streamed.get()));
+        }
+#else
+        jsb_unused(p_isolate);
+        jsb_unused(p_streaming);
+#endif
+        source->task_id = WorkerThreadPool::get_singleton()->add_native_task(&_run, source.get(), false, "jsb: prefetch module");
+        sources_.insert(p_asset_path, source);
+        JSB_LOG(VeryVerbose, "prefetch module %s", p_asset_path);
+    }
+
+    bool ModulePrefetcher::is_ready(const String& p_asset_path) const
+    {
+        const HashMap<String, std::shared_ptr<Source>>::ConstIterator it = sources_.find(p_asset_path);
+        return it == sources_.end() || WorkerThreadPool::get_singleton()->is_task_completed(it->value->task_id);
+    }
+
+    std::shared_ptr<ModulePrefetcher::Source> ModulePrefetcher::take(const String& p_asset_path)
+    {
+        const HashMap<String, std::shared_ptr<Source>>::Iterator it = sources_.find(p_asset_path);
+        if (it == sources_.end())
+        {
+            return nullptr;
+        }
+
+        std::shared_ptr<Source> source = it->value;
+        sources_.remove(it);
+        WorkerThreadPool::get_singleton()->wait_for_task_completion(source->task_id);
+        return source;
+    }
+
+    void ModulePrefetcher::clear()
+    {
+        for (const KeyValue<String, std::shared_ptr<Source>>& it : sources_)
+        {
+            WorkerThreadPool::get_singleton()->wait_for_task_completion(it.value->task_id);
+        }
+        sources_.clear();
+    }
+
+#if JSB_WITH_THREADED_SCRIPT_PRELOAD
+    bool ModulePrefetcher::preload(const String& p_asset_path, Vector<uint8_t>* r_bytes)
+    {
+        if (!internal::PathUtil::is_recognized_javascript_extension(p_asset_path))
+        {
+            return false;
+        }
+
+        {
+            MutexLock lock(preloaded_lock_);
+            if (const HashMap<String, std::shared_ptr<Source>>::ConstIterator it = preloaded_.find(p_asset_path); it != preloaded_.end())
+            {
+                if (r_bytes) *r_bytes = it->value->bytes;
+                return true;
+            }
+            if (preloaded_size_ >= kMaxPreloadedSize)
+            {
+                return false;
+            }
+        }
+
+        const Ref<FileAccess> file = FileAccess::open(p_asset_path, FileAccess::READ);
+        if (file.is_null() || file->get_length() == 0)
+        {
+            return false;
+        }
+
+        const std::shared_ptr<Source> source = std::make_shared<Source>();
+        source->asset_path = p_asset_path;
+        source->path_absolute = file->get_path_absolute();
+        source->bytes = file->get_buffer((int64_t) file->get_length());
+        if (source->bytes.is_empty())
+        {
+            return false;
+        }
+
+        const internal::BytesSourceReader reader(p_asset_path, source->path_absolute, source->bytes);
+        const size_t len = DefaultModuleResolver::read_all_bytes_with_shebang(reader, source->wrapped);
+#if JSB_WITH_CODE_CACHE
+        source->fingerprint = internal::CodeCache::get_fingerprint(source->wrapped.ptr(), len);
+        internal::CodeCache::load(p_asset_path, source->fingerprint, impl::Helper::get_code_cache_version_tag(), source->cached_data);
+#else
+        jsb_unused(len);
+#endif
+        if (r_bytes) *r_bytes = source->bytes;
+
+        MutexLock lock(preloaded_lock_);
+        if (!preloaded_.has(p_asset_path))
+        {
+            preloaded_size_ += source->bytes.size() + source->wrapped.size();
+            preloaded_.insert(p_asset_path, source);
+            JSB_LOG(VeryVerbose, "preload module %s", p_asset_path);
+        }
+        return true;
+    }
+
+    std::shared_ptr<ModulePrefetcher::Source> ModulePrefetcher::take_preloaded(const String& p_asset_path)
+    {
+        MutexLock lock(preloaded_lock_);
+        const HashMap<String, std::shared_ptr<Source>>::Iterator it = preloaded_.find(p_asset_path);
+        if (it == preloaded_.end())
+        {
+            return nullptr;
+        }
+
+        std::shared_ptr<Source> source = it->value;
+        preloaded_size_ -= source->bytes.size() + source->wrapped.size();
+        preloaded_.remove(it);
+        return source;
+    }
+
+    void ModulePrefetcher::clear_preloaded()
+    {
+        MutexLock lock(preloaded_lock_);
+        preloaded_.clear();
+        preloaded_size_ = 0;
+    }
+#endif
+}
@@ -0,0 +1,84 @@
+#ifndef GODOTJS_MODULE_PREFETCHER_H
+#define GODOTJS_MODULE_PREFETCHER_H
+#include "jsb_bridge_pch.h"
+
+#include "core/object/worker_thread_pool.h"
+
+namespace jsb
+{
+    /**
+     * Read module sources in the WorkerThreadPool before they're really required.
+     * With V8, the source is also parsed in the background task (`ScriptCompiler::StartStreaming`),
+     * only the instantiation and evaluation of modules happen on the isolate thread (see `DefaultModuleResolver::load`).
+     * The sources preloaded by resource loading threads (see `preload`) are process-wide and taken by the first environment requiring them.
+     */
+    class ModulePrefetcher
+    {
+    public:
+        struct Source
+        {
+            String asset_path;
+
+            // written by the background task, do not access them before the task completed
+            String path_absolute;
+            Vector<uint8_t> bytes;
+
+            // the source wrapped in the module protocol (only if streamed or preloaded)
+            Vector<uint8_t> wrapped;
+
+#if JSB_WITH_CODE_CACHE
+            // (preloaded only) the fingerprint of `wrapped` and the code cache matching it (empty if not available)
+            String fingerprint;
+            Vector<uint8_t> cached_data;
+#endif
+
+#if JSB_WITH_V8
+            std::unique_ptr<v8::ScriptCompiler::StreamedSource> streamed;
+            std::unique_ptr<v8::ScriptCompiler::ScriptStreamingTask> streaming_task;
+#endif
+
+            WorkerThreadPool::TaskID task_id = WorkerThreadPool::INVALID_TASK_ID;
+        };
+
+    private:
+        HashMap<String, std::shared_ptr<Source>> sources_;
+
+        static void _run(void* p_source);
+
+    public:
+        ~ModulePrefetcher() { clear(); }
+
+        /**
+         * start reading the module source in background (ignored if it's already requested)
+         * \param p_streaming parse the source in background (V8 only)
+         */
+        void prefetch(v8::Isolate* p_isolate, const String& p_asset_path, bool p_streaming);
+
+        jsb_force_inline bool has(const String& p_asset_path) const { return sources_.has(p_asset_path); }
+
+        // whether the background work is done (`take` will not block)
+        bool is_ready(const String& p_asset_path) const;
+
+        // wait for the background work and remove it from the prefetcher, null if not requested
+        std::shared_ptr<Source> take(const String& p_asset_path);
+
+        // wait for all pending work and discard the results (must be called before the isolate disposed)
+        void clear();
+
+#if JSB_WITH_THREADED_SCRIPT_PRELOAD
+        /**
+         * [any thread] read the module source, wrap it and load the code cache on the calling thread (usually a resource loading thread).
+         * \param r_bytes (optional) the raw source
+         * \return false if not read (not found, not JS, or too many preloaded sources not taken yet)
+         */
+        static bool preload(const String& p_asset_path, Vector<uint8_t>* r_bytes = nullptr);
+
+        // [any thread] remove the preloaded source, null if not preloaded
+        static std::shared_ptr<Source> take_preloaded(const String& p_asset_path);
+
+        // [any thread] discard all preloaded sources (they may be stale after the files changed)
+        static void clear_preloaded();
+#endif
+    };
+}
+#endif
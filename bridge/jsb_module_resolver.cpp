@@ -1,22 +1,29 @@
 #include "jsb_module_resolver.h"
 #include "jsb_environment.h"
+#include "jsb_module_prefetcher.h"
 
 #include "../internal/jsb_path_util.h"
+#include "../internal/jsb_code_cache.h"
+#include "../internal/jsb_module_archive.h"
 
 namespace jsb
 {
     namespace
     {
-        // the cost of copy return is acceptable since Vector copy constructor is by-reference under the hood 
-        PackedStringArray get_dynamic_search_paths()
+        // the module protocol (commonjs) wrapping the source
+        constexpr char kModuleHeader[] = "(function(exports,require,module,__filename,__dirname){";
+        constexpr char kModuleFooter[] = "\n})";
+
+#if JSB_SUPPORT_RELOAD && defined(TOOLS_ENABLED)
+        // remember the revision of the original source (wrapped by `read_all_bytes_with_shebang`) for change detection
+        void set_source_revision(JavaScriptModule& p_module, const internal::ISourceReader& p_reader, const uint8_t* p_wrapped, size_t p_wrapped_len)
         {
-#ifdef TOOLS_ENABLED
-            return jsb::internal::Settings::get_additional_search_paths();
-#else
-            static PackedStringArray dynamic_search_paths = jsb::internal::Settings::get_additional_search_paths();
-            return dynamic_search_paths;
-#endif
+            const size_t len = p_wrapped_len - (::std::size(kModuleHeader) - 1) - (::std::size(kModuleFooter) - 1);
+            p_module.time_modified = p_reader.get_time_modified();
+            p_module.size = len;
+            p_module.hash = internal::ContentHash::compute(p_wrapped + ::std::size(kModuleHeader) - 1, len);
         }
+#endif
     }
     
     bool IModuleResolver::load_as_json(Environment* p_env, JavaScriptModule& p_module, const String& p_asset_path, const Vector<uint8_t>& p_bytes, size_t p_len)
@@ -87,30 +94,42 @@ namespace jsb
 
     size_t DefaultModuleResolver::read_all_bytes_with_shebang(const internal::ISourceReader& p_reader, Vector<uint8_t>& o_bytes)
     {
-        static constexpr char header[] = "(function(exports,require,module,__filename,__dirname){";
-        static constexpr char footer[] = "\n})";
-
         jsb_check(!p_reader.is_null());
         const size_t file_len = p_reader.get_length();
         jsb_check(file_len);
         o_bytes.resize((int) (
             file_len +
-            ::std::size(header) + ::std::size(footer) - 2
+            ::std::size(kModuleHeader) + ::std::size(kModuleFooter) - 2
             + 1 // zero_terminated anyway
         ));
 
-        memcpy(o_bytes.ptrw(), header, ::std::size(header) - 1);
-        p_reader.get_buffer(o_bytes.ptrw() + ::std::size(header) - 1, file_len);
-        memcpy(o_bytes.ptrw() + file_len + ::std::size(header) - 1, footer, ::std::size(footer)); // include the ending zero
+        memcpy(o_bytes.ptrw(), kModuleHeader, ::std::size(kModuleHeader) - 1);
+        p_reader.get_buffer(o_bytes.ptrw() + ::std::size(kModuleHeader) - 1, file_len);
+        memcpy(o_bytes.ptrw() + file_len + ::std::size(kModuleHeader) - 1, kModuleFooter, ::std::size(kModuleFooter)); // include the ending zero
         return o_bytes.size() - 1;
     }
 
     //NOTE !!! we use FileAccess::exists instead of access->file_exists because access->file_exists does not consider files from packages (res://)
-    bool DefaultModuleResolver::check_implicit_source_path(const String& p_module_id, String& o_path)
+    bool DefaultModuleResolver::file_exists(const String& p_path) const
+    {
+        return FileAccess::exists(p_path);
+    }
+
+    bool DefaultModuleResolver::dir_exists(const String& p_path) const
+    {
+        return DirAccess::exists(p_path);
+    }
+
+    String DefaultModuleResolver::get_file_as_string(const String& p_path) const
+    {
+        return FileAccess::get_file_as_string(p_path);
+    }
+
+    bool DefaultModuleResolver::check_implicit_source_path(const String& p_module_id, String& o_path) const
     {
         // try .js
         const String js_path = internal::PathUtil::extends_with(p_module_id, "." JSB_JAVASCRIPT_EXT);
-        if (FileAccess::exists(js_path))
+        if (file_exists(js_path))
         {
             o_path = js_path;
             return true;
@@ -118,7 +137,7 @@ namespace jsb
 
         // try .cjs
         const String cjs_path = internal::PathUtil::extends_with(p_module_id, "." JSB_COMMONJS_EXT);
-        if (FileAccess::exists(cjs_path))
+        if (file_exists(cjs_path))
         {
             o_path = cjs_path;
             return true;
@@ -126,7 +145,7 @@ namespace jsb
 
         // try .json
         const String json_path = internal::PathUtil::extends_with(p_module_id, "." JSB_JSON_EXT);
-        if (FileAccess::exists(json_path))
+        if (file_exists(json_path))
         {
             o_path = json_path;
             return true;
@@ -266,14 +285,14 @@ namespace jsb
     bool DefaultModuleResolver::check_absolute_file_path(const String& p_module_id, ModuleSourceInfo& o_source_info)
     {
         // 1: module_id (we do not check it strictly here, but usually, it should already have a valid extension)
-        if (p_module_id.contains(".") && FileAccess::exists(p_module_id))
+        if (p_module_id.contains(".") && file_exists(p_module_id))
         {
             o_source_info.source_filepath = p_module_id;
             o_source_info.package_filepath = String();
             return true;
         }
 
-        const bool has_module_id_dir = DirAccess::exists(p_module_id);
+        const bool has_module_id_dir = dir_exists(p_module_id);
 
         // 2: implicit file path (module_id.js, module_id.cjs)
         if (String source_path; check_implicit_source_path(p_module_id, source_path))
@@ -288,7 +307,7 @@ namespace jsb
         if (has_module_id_dir)
         {
             const String index_path = internal::PathUtil::combine(p_module_id, "index.js");
-            if (FileAccess::exists(index_path))
+            if (file_exists(index_path))
             {
                 o_source_info.source_filepath = index_path;
                 o_source_info.package_filepath = String();
@@ -301,7 +320,7 @@ namespace jsb
 
     bool DefaultModuleResolver::check_package_file_path(const String& p_package_path, const String& p_module_id, ModuleSourceInfo& o_source_info)
     {
-        if (!DirAccess::exists(p_package_path))
+        if (!dir_exists(p_package_path))
         {
             return false;
         }
@@ -316,13 +335,10 @@ namespace jsb
         {
             const String package_json_path = internal::PathUtil::combine(p_package_path, "package.json");
 
-            if (FileAccess::exists(package_json_path))
+            if (file_exists(package_json_path))
             {
-                const Ref<FileAccess> file = FileAccess::open(package_json_path, FileAccess::READ);
-                jsb_check(file.is_valid());
-
                 const Ref json = memnew(JSON);
-                Error error = json->parse(file->get_as_utf8_string());
+                Error error = json->parse(get_file_as_string(package_json_path));
                 if (error != OK)
                 {
                     JSB_LOG(Error, "failed to parse package.json (%d: %s)", json->get_error_line(), json->get_error_message());
@@ -406,7 +422,7 @@ namespace jsb
             return false;
         }
 
-        if (!FileAccess::exists(extracted_path))
+        if (!file_exists(extracted_path))
         {
             return false;
         }
@@ -416,8 +432,30 @@ namespace jsb
         return true;
     }
 
+    std::atomic<uint32_t> DefaultModuleResolver::resolution_revision_ = 1;
+
     // early and simple validation: check source file existence
     bool DefaultModuleResolver::get_source_info(const String &p_module_id, ModuleSourceInfo& r_source_info)
+    {
+        if (const uint32_t revision = resolution_revision_.load(std::memory_order_relaxed); revision != resolution_cache_revision_)
+        {
+            resolution_cache_revision_ = revision;
+            resolution_cache_.clear();
+            dynamic_search_paths_ = internal::Settings::get_additional_search_paths();
+        }
+
+        // a large dependency tree requires the same ids many times, and the failed ones are probed in all search paths
+        if (const ModuleSourceInfo* cached = resolution_cache_.getptr(p_module_id))
+        {
+            r_source_info = *cached;
+            return !r_source_info.source_filepath.is_empty();
+        }
+        const bool resolved = resolve_source_info(p_module_id, r_source_info);
+        resolution_cache_.insert(p_module_id, r_source_info);
+        return resolved;
+    }
+
+    bool DefaultModuleResolver::resolve_source_info(const String &p_module_id, ModuleSourceInfo& r_source_info)
     {
         JSB_LOG(VeryVerbose, "resolving path %s", p_module_id);
 
@@ -449,7 +487,7 @@ namespace jsb
         }
 
         // search the paths from settings
-        for (const String& search_path : get_dynamic_search_paths())
+        for (const String& search_path : dynamic_search_paths_)
         {
             if (check_search_path(search_path, p_module_id, r_source_info))
             {
@@ -512,11 +550,134 @@ namespace jsb
         return *this;
     }
 
+    void DefaultModuleResolver::prefetch(Environment* p_env, const String& p_asset_path)
+    {
+        if (!internal::PathUtil::is_recognized_javascript_extension(p_asset_path))
+        {
+            return;
+        }
+#if JSB_WITH_CODE_CACHE
+        // compiling with code cache is faster than parsing, so only read the source in this case
+        const bool streaming = !FileAccess::exists(internal::CodeCache::get_cache_path(p_asset_path));
+#else
+        const bool streaming = true;
+#endif
+        p_env->get_module_prefetcher().prefetch(p_env->get_isolate(), p_asset_path, streaming);
+    }
+
     bool DefaultModuleResolver::load(Environment* p_env, const String& p_asset_path, JavaScriptModule& p_module)
     {
-        internal::FileAccessSourceReader reader(p_asset_path);
+        const std::shared_ptr<ModulePrefetcher::Source> prefetched = p_env->get_module_prefetcher().take(p_asset_path);
+        if (!prefetched)
+        {
+#if JSB_WITH_THREADED_SCRIPT_PRELOAD
+            if (const std::shared_ptr<ModulePrefetcher::Source> preloaded = ModulePrefetcher::take_preloaded(p_asset_path))
+            {
+                const internal::BytesSourceReader reader(p_asset_path, preloaded->path_absolute, preloaded->bytes);
+                return load_preloaded(p_env, p_asset_path, reader, *preloaded, p_module);
+            }
+#endif
+#if JSB_WITH_MAPPED_SOURCE
+            // the native files are mapped instead of being read through FileAccess, fallback if it's in a package
+            if (const internal::MappedFileSourceReader mapped(p_asset_path); !mapped.is_null())
+            {
+                return load(p_env, p_asset_path, mapped, p_module);
+            }
+#endif
+            internal::FileAccessSourceReader reader(p_asset_path);
+            return load(p_env, p_asset_path, reader, p_module);
+        }
+
+        const internal::BytesSourceReader reader(p_asset_path, prefetched->path_absolute, prefetched->bytes);
+#if JSB_WITH_V8
+        if (prefetched->streamed && !reader.is_null())
+        {
+            return load_streamed(p_env, p_asset_path, reader, *prefetched, p_module);
+        }
+#endif
         return load(p_env, p_asset_path, reader, p_module);
     }
+
+#if JSB_WITH_V8
+    bool DefaultModuleResolver::load_streamed(Environment* p_env, const String& p_asset_path, const internal::ISourceReader& p_reader, ModulePrefetcher::Source& p_source, JavaScriptModule& p_module)
+    {
+        // the source has already been parsed in the background task, finish the compilation on the isolate thread
+        const int len = p_source.wrapped.size() - 1;
+#if JSB_SUPPORT_RELOAD && defined(TOOLS_ENABLED)
+        set_source_revision(p_module, p_reader, p_source.wrapped.ptr(), len);
+#endif
+        p_env->prefetch_dependencies(p_asset_path, p_source.wrapped.ptr(), len);
+
+        v8::Isolate* isolate = p_env->get_isolate();
+        v8::Isolate::Scope isolate_scope(isolate);
+        v8::HandleScope handle_scope(isolate);
+        v8::Local<v8::Context> context = isolate->GetCurrentContext();
+        v8::Context::Scope context_scope(context);
+
+#if JSB_WITH_CODE_CACHE
+        Vector<uint8_t> new_cached_data;
+        const v8::MaybeLocal<v8::Value> func_maybe = impl::Helper::compile_streamed_function(context, p_source.streamed.get(), (const char*) p_source.wrapped.ptr(), len, p_reader.get_path_absolute(), &new_cached_data);
+        if (!new_cached_data.is_empty())
+        {
+            const String fingerprint = internal::CodeCache::get_fingerprint(p_source.wrapped.ptr(), len);
+            internal::CodeCache::save(p_asset_path, fingerprint, impl::Helper::get_code_cache_version_tag(), new_cached_data);
+        }
+#else
+        const v8::MaybeLocal<v8::Value> func_maybe = impl::Helper::compile_streamed_function(context, p_source.streamed.get(), (const char*) p_source.wrapped.ptr(), len, p_reader.get_path_absolute());
+#endif
+        v8::Local<v8::Value> func;
+        if (!func_maybe.ToLocal(&func))
+        {
+            return false;
+        }
+        if (!func->IsFunction())
+        {
+            jsb_throw(isolate, "bad module elevator");
+            return false;
+        }
+        return load_from_evaluator(p_env, p_module, p_asset_path, func.As<v8::Function>());
+    }
+#endif
+
+#if JSB_WITH_THREADED_SCRIPT_PRELOAD
+    bool DefaultModuleResolver::load_preloaded(Environment* p_env, const String& p_asset_path, const internal::ISourceReader& p_reader, const ModulePrefetcher::Source& p_source, JavaScriptModule& p_module)
+    {
+        // the source has already been read and wrapped, and the code cache loaded in the resource loading thread
+        const int len = p_source.wrapped.size() - 1;
+#if JSB_SUPPORT_RELOAD && defined(TOOLS_ENABLED)
+        set_source_revision(p_module, p_reader, p_source.wrapped.ptr(), len);
+#endif
+        p_env->prefetch_dependencies(p_asset_path, p_source.wrapped.ptr(), len);
+
+        v8::Isolate* isolate = p_env->get_isolate();
+        v8::Isolate::Scope isolate_scope(isolate);
+        v8::HandleScope handle_scope(isolate);
+        v8::Local<v8::Context> context = isolate->GetCurrentContext();
+        v8::Context::Scope context_scope(context);
+
+#if JSB_WITH_CODE_CACHE
+        Vector<uint8_t> new_cached_data;
+        const v8::MaybeLocal<v8::Value> func_maybe = impl::Helper::compile_function(context, (const char*) p_source.wrapped.ptr(), len, p_reader.get_path_absolute(), p_source.cached_data, &new_cached_data);
+        if (!new_cached_data.is_empty())
+        {
+            internal::CodeCache::save(p_asset_path, p_source.fingerprint, impl::Helper::get_code_cache_version_tag(), new_cached_data);
+        }
+#else
+        const v8::MaybeLocal<v8::Value> func_maybe = impl::Helper::compile_function(context, (const char*) p_source.wrapped.ptr(), len, p_reader.get_path_absolute());
+#endif
+        v8::Local<v8::Value> func;
+        if (!func_maybe.ToLocal(&func))
+        {
+            return false;
+        }
+        if (!func->IsFunction())
+        {
+            jsb_throw(isolate, "bad module elevator");
+            return false;
+        }
+        return load_from_evaluator(p_env, p_module, p_asset_path, func.As<v8::Function>());
+    }
+#endif
     
     bool DefaultModuleResolver::load(Environment* p_env, const String& p_asset_path, const internal::ISourceReader& p_reader, JavaScriptModule& p_module)
     {
@@ -526,11 +687,6 @@ namespace jsb
             return false;
         }
 
-#if JSB_SUPPORT_RELOAD && defined(TOOLS_ENABLED)
-        p_module.time_modified = p_reader.get_time_modified();
-        p_module.hash = p_reader.get_hash();
-#endif
-
         // parse as JSON
         if (p_asset_path.ends_with("." JSB_JSON_EXT))
         {
@@ -539,6 +695,11 @@ namespace jsb
             source.resize((int) len + 1);
             source.write[(int) len] = 0; // ensure it's zero-terminated
             p_reader.get_buffer(source.ptrw(), len);
+#if JSB_SUPPORT_RELOAD && defined(TOOLS_ENABLED)
+            p_module.time_modified = p_reader.get_time_modified();
+            p_module.size = len;
+            p_module.hash = internal::ContentHash::compute(source.ptr(), len);
+#endif
             return load_as_json(p_env, p_module, p_asset_path, source, len);
         }
 
@@ -559,9 +720,27 @@ namespace jsb
             Vector<uint8_t> source;
             const size_t len = read_all_bytes_with_shebang(p_reader, source);
             jsb_check((size_t)(int)len == len);
+#if JSB_SUPPORT_RELOAD && defined(TOOLS_ENABLED)
+            set_source_revision(p_module, p_reader, source.ptr(), len);
+#endif
+            // the dependencies are read in background while this module is being compiled
+            p_env->prefetch_dependencies(p_asset_path, source.ptr(), len);
 
             // source evaluator (the module protocol)
+#if JSB_WITH_CODE_CACHE
+            const uint32_t version_tag = impl::Helper::get_code_cache_version_tag();
+            const String fingerprint = internal::CodeCache::get_fingerprint(source.ptr(), len);
+            Vector<uint8_t> cached_data;
+            Vector<uint8_t> new_cached_data;
+            internal::CodeCache::load(p_asset_path, fingerprint, version_tag, cached_data);
+            const v8::MaybeLocal<v8::Value> func_maybe = impl::Helper::compile_function(context, (const char*) source.ptr(), (int) len, filename_abs, cached_data, &new_cached_data);
+            if (!new_cached_data.is_empty())
+            {
+                internal::CodeCache::save(p_asset_path, fingerprint, version_tag, new_cached_data);
+            }
+#else
             const v8::MaybeLocal<v8::Value> func_maybe = impl::Helper::compile_function(context, (const char*) source.ptr(), (int) len, filename_abs);
+#endif
             if (func_maybe.IsEmpty())
             {
                 //NOTE an exception should have been thrown in _compile_run if MaybeLocal is empty
@@ -579,4 +758,71 @@ namespace jsb
         }
     }
 
+#if JSB_WITH_CODE_CACHE
+    bool DefaultModuleResolver::build_code_cache(Environment* p_env, const String& p_asset_path, const internal::ISourceReader& p_reader, String& r_cache_path, Vector<uint8_t>& r_content)
+    {
+        if (p_reader.is_null() || p_reader.get_length() == 0)
+        {
+            return false;
+        }
+
+        v8::Isolate* isolate = p_env->get_isolate();
+        v8::Isolate::Scope isolate_scope(isolate);
+        v8::HandleScope handle_scope(isolate);
+        const v8::Local<v8::Context> context = p_env->get_context();
+        v8::Context::Scope context_scope(context);
+        v8::TryCatch try_catch(isolate);
+
+        Vector<uint8_t> source;
+        const size_t len = read_all_bytes_with_shebang(p_reader, source);
+        jsb_check((size_t)(int)len == len);
+
+        // it only evaluates the module protocol wrapper (a function expression), the module itself is not executed
+        Vector<uint8_t> cached_data;
+        if (impl::Helper::compile_function(context, (const char*) source.ptr(), (int) len, p_reader.get_path_absolute(), {}, &cached_data).IsEmpty() || cached_data.is_empty())
+        {
+            JSB_LOG(Warning, "failed to compile %s", p_asset_path);
+            return false;
+        }
+
+        const String fingerprint = internal::CodeCache::get_fingerprint(source.ptr(), len);
+        r_cache_path = internal::CodeCache::get_cache_path(p_asset_path);
+        r_content = internal::CodeCache::encode(fingerprint, impl::Helper::get_code_cache_version_tag(), cached_data);
+        return true;
+    }
+#endif
+
+    bool ArchiveModuleResolver::file_exists(const String& p_path) const
+    {
+        return archive_.has_file(p_path) || DefaultModuleResolver::file_exists(p_path);
+    }
+
+    bool ArchiveModuleResolver::dir_exists(const String& p_path) const
+    {
+        return archive_.has_dir(p_path) || DefaultModuleResolver::dir_exists(p_path);
+    }
+
+    String ArchiveModuleResolver::get_file_as_string(const String& p_path) const
+    {
+        return archive_.has_file(p_path) ? archive_.get_file_as_string(p_path) : DefaultModuleResolver::get_file_as_string(p_path);
+    }
+
+    void ArchiveModuleResolver::prefetch(Environment* p_env, const String& p_asset_path)
+    {
+        if (!archive_.has_file(p_asset_path))
+        {
+            DefaultModuleResolver::prefetch(p_env, p_asset_path);
+        }
+    }
+
+    bool ArchiveModuleResolver::load(Environment* p_env, const String& p_asset_path, JavaScriptModule& p_module)
+    {
+        if (!archive_.has_file(p_asset_path))
+        {
+            return DefaultModuleResolver::load(p_env, p_asset_path, p_module);
+        }
+        const internal::ArchiveSourceReader reader(archive_, p_asset_path);
+        return DefaultModuleResolver::load(p_env, p_asset_path, reader, p_module);
+    }
+
 }
@@ -3,6 +3,7 @@
 
 #include "jsb_bridge_pch.h"
 #include "jsb_module.h"
+#include "jsb_module_prefetcher.h"
 
 namespace jsb
 {
@@ -19,6 +20,9 @@ namespace jsb
         // `exports' will be set into `p_module.exports` if loaded successfully
         virtual bool load(Environment* p_env, const String& p_asset_path, JavaScriptModule& p_module) = 0;
 
+        // (optional) start reading the source in background, `load` will pick it up later
+        virtual void prefetch(Environment* p_env, const String& p_asset_path) {}
+
         // `p_filename_abs` the absolute file path accessible for debugger
         static bool load_from_evaluator(Environment* p_env, JavaScriptModule& p_module, const String& p_asset_path, const v8::Local<v8::Function>& p_elevator);
         static bool load_as_json(Environment* p_env, JavaScriptModule& p_module, const String& p_asset_path, const Vector<uint8_t>& p_bytes, size_t p_len);
@@ -35,25 +39,58 @@ namespace jsb
 
         virtual bool get_source_info(const String& p_module_id, ModuleSourceInfo& r_source_info) override;
 
-        /** load module from asset path (use FileAccessSourceReader) */
+        /** load module from asset path (use FileAccessSourceReader, or the source prefetched in `ModulePrefetcher`) */
         virtual bool load(Environment* p_env, const String& p_asset_path, JavaScriptModule& p_module) override;
 
+        /** read (and parse with V8, if no code cache available) the source file in `ModulePrefetcher` */
+        virtual void prefetch(Environment* p_env, const String& p_asset_path) override;
+
         DefaultModuleResolver& add_search_path(const String& p_path);
 
+        // drop the cached resolutions of all resolvers in all environments (files may have been added or removed in editor)
+        static void invalidate_resolution_caches() { resolution_revision_.fetch_add(1, std::memory_order_relaxed); }
+
         /** Compile source from reader (in commonjs style) and init as module */
         static bool load(Environment* p_env, const String& p_asset_path, const internal::ISourceReader& p_reader, JavaScriptModule& p_module);
 
+#if JSB_WITH_CODE_CACHE
+        /**
+         * Compile the source without running the module, and produce the code cache file which `load` picks up in exported projects.
+         * \param r_cache_path the path of the code cache file of the module
+         * \param r_content the content of the code cache file
+         */
+        static bool build_code_cache(Environment* p_env, const String& p_asset_path, const internal::ISourceReader& p_reader, String& r_cache_path, Vector<uint8_t>& r_content);
+#endif
+
+        // read the source buffer (transformed into commonjs)
+        static size_t read_all_bytes_with_shebang(const internal::ISourceReader& p_reader, Vector<uint8_t>& o_bytes);
+
     protected:
+        // resolve without the cache
+        bool resolve_source_info(const String& p_module_id, ModuleSourceInfo& r_source_info);
+
         bool check_absolute_file_path(const String& p_module_id, ModuleSourceInfo& o_source_info);
         bool check_package_file_path(const String& p_package_path, const String& p_module_id, ModuleSourceInfo& o_source_info);
         bool check_search_path(const String& p_search_path, const String& p_module_id, ModuleSourceInfo& o_source_info);
 
         static String resolve_package_export(const Dictionary& p_exports, const String& p_condition, const String& p_module_id);
 
-        // read the source buffer (transformed into commonjs)
-        static size_t read_all_bytes_with_shebang(const internal::ISourceReader& p_reader, Vector<uint8_t>& o_bytes);
+#if JSB_WITH_V8
+        // compile the source which is parsed in background by `ModulePrefetcher`
+        static bool load_streamed(Environment* p_env, const String& p_asset_path, const internal::ISourceReader& p_reader, ModulePrefetcher::Source& p_source, JavaScriptModule& p_module);
+#endif
+
+#if JSB_WITH_THREADED_SCRIPT_PRELOAD
+        // compile the source which is read (along with the code cache) in a resource loading thread (see `ModulePrefetcher::preload`)
+        static bool load_preloaded(Environment* p_env, const String& p_asset_path, const internal::ISourceReader& p_reader, const ModulePrefetcher::Source& p_source, JavaScriptModule& p_module);
+#endif
+
+        bool check_implicit_source_path(const String& p_module_id, String& o_path) const;
 
-        static bool check_implicit_source_path(const String& p_module_id, String& o_path);
+        // all file checks and reads of the resolver go through these
+        virtual bool file_exists(const String& p_path) const;
+        virtual bool dir_exists(const String& p_path) const;
+        virtual String get_file_as_string(const String& p_path) const;
 
     private:
 
@@ -67,6 +104,38 @@ namespace jsb
         static String resolve_package_export_value(const Variant& p_value, const String& p_condition, const String& p_subpath, bool p_wildcard);
 
         Vector<String> search_paths_;
+
+        // Settings::get_additional_search_paths (read again after invalidated)
+        PackedStringArray dynamic_search_paths_;
+
+        // the results of `get_source_info` by module id (relative ids are already combined with the parent), including the failed ones (empty source path)
+        HashMap<String, ModuleSourceInfo> resolution_cache_;
+        uint32_t resolution_cache_revision_ = 0;
+
+        static std::atomic<uint32_t> resolution_revision_;
+    };
+
+    /**
+     * resolve modules in the `ModuleArchive` packed in the exported project at first, and fallback to `FileAccess`.
+     * it saves the cost of opening individual files on platforms where it's expensive (e.g. APK).
+     */
+    class ArchiveModuleResolver : public DefaultModuleResolver
+    {
+        const internal::ModuleArchive& archive_;
+
+    public:
+        ArchiveModuleResolver(const internal::ModuleArchive* p_archive) : archive_(*p_archive) {}
+        virtual ~ArchiveModuleResolver() override = default;
+
+        virtual bool load(Environment* p_env, const String& p_asset_path, JavaScriptModule& p_module) override;
+
+        // the modules in archive are already in memory (fallback to `DefaultModuleResolver` for others)
+        virtual void prefetch(Environment* p_env, const String& p_asset_path) override;
+
+    protected:
+        virtual bool file_exists(const String& p_path) const override;
+        virtual bool dir_exists(const String& p_path) const override;
+        virtual String get_file_as_string(const String& p_path) const override;
     };
 }
 
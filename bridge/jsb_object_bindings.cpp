@@ -1,12 +1,270 @@
 #include "jsb_object_bindings.h"
 #include "jsb_transpiler.h"
 #include "jsb_type_convert.h"
+#include "jsb_shared_variant_info.h"
 // TODO: Refactor. Violates isolation of bridge.
 #include "../weaver/jsb_script_instance.h"
 #include "../weaver/jsb_script_language.h"
 
 namespace jsb
 {
+    namespace
+    {
+        jsb_force_inline TypeConvert::JSToGDFunc get_argument_converter(const internal::FMethodBindInfo& p_method_info, int p_index)
+        {
+            return reinterpret_cast<TypeConvert::JSToGDFunc>(p_method_info.argument_converters[p_index]);
+        }
+
+        jsb_force_inline TypeConvert::GDToJSFunc get_return_converter(const internal::FMethodBindInfo& p_method_info)
+        {
+            return reinterpret_cast<TypeConvert::GDToJSFunc>(p_method_info.return_converter);
+        }
+
+        // the element type of a typed array argument (`TypedArray<T>`), NIL if it's not a typed array
+        Variant::Type get_array_element_type(const MethodBind* p_method_bind, int p_index)
+        {
+            const PropertyInfo argument_info = p_method_bind->get_argument_info(p_index);
+            if (argument_info.type != Variant::ARRAY || argument_info.hint != PROPERTY_HINT_ARRAY_TYPE || argument_info.hint_string.is_empty())
+            {
+                return Variant::NIL;
+            }
+            if (const Variant::Type type = Variant::get_type_by_name(argument_info.hint_string); type != Variant::VARIANT_MAX)
+            {
+                return type;
+            }
+            return ClassDB::class_exists(argument_info.hint_string) ? Variant::OBJECT : Variant::NIL;
+        }
+
+        // enum and bitfield arguments (as INT) are in int32 range in practice
+        bool is_enum_argument(const MethodBind* p_method_bind, int p_index)
+        {
+            const PropertyInfo argument_info = p_method_bind->get_argument_info(p_index);
+            return argument_info.type == Variant::INT && (argument_info.usage & (PROPERTY_USAGE_CLASS_IS_ENUM | PROPERTY_USAGE_CLASS_IS_BITFIELD));
+        }
+
+        // collect the call info of a MethodBind (once) to avoid querying it on every call
+        int add_method_bind_info(Environment* p_env, HashMap<const MethodBind*, int>& p_indices, MethodBind* p_method_bind)
+        {
+            if (const auto& it = p_indices.find(p_method_bind); it != p_indices.end())
+            {
+                return it->value;
+            }
+
+            internal::FMethodBindInfo method_info;
+            const int argc = p_method_bind->get_argument_count();
+            method_info.set_debug_name(p_method_bind->get_name());
+            method_info.method_bind = p_method_bind;
+            method_info.is_vararg = p_method_bind->is_vararg();
+            method_info.is_static = p_method_bind->is_static();
+            method_info.has_return = p_method_bind->has_return();
+            method_info.return_type = p_method_bind->get_argument_type(-1);
+            method_info.default_arguments = p_method_bind->get_default_arguments();
+            method_info.argument_types.resize(argc);
+            method_info.argument_converters.resize(argc);
+            method_info.string_name_sites.resize(argc);
+            for (int index = 0; index < argc; ++index)
+            {
+                const Variant::Type type = p_method_bind->get_argument_type(index);
+                const Variant::Type element_type = type == Variant::ARRAY ? get_array_element_type(p_method_bind, index) : Variant::NIL;
+                method_info.argument_types.write[index] = type;
+                method_info.argument_converters.write[index] = reinterpret_cast<internal::FMethodBindInfo::FConvertFunc>(element_type != Variant::NIL
+                    ? TypeConvert::get_js_to_gd_array_func(element_type)
+                    : type == Variant::INT && is_enum_argument(p_method_bind, index)
+                        ? TypeConvert::get_js_to_gd_enum_func()
+                        : TypeConvert::get_js_to_gd_func(type));
+            }
+            method_info.return_converter = reinterpret_cast<internal::FMethodBindInfo::FConvertFunc>(TypeConvert::get_gd_to_js_func(method_info.return_type));
+            jsb_check(method_info.return_type == p_method_bind->get_return_info().type);
+            jsb_check(p_method_bind->get_default_argument_count() == method_info.get_default_argument_count());
+
+            const int collection_index = (int) p_env->get_variant_info_collection().method_binds.size();
+            p_env->get_variant_info_collection().method_binds.append(method_info);
+            p_indices.insert(p_method_bind, collection_index);
+            return collection_index;
+        }
+
+#if JSB_FAST_REFLECTION
+        // ptrcall is only possible when all arguments and the return value have a fixed Variant type.
+        // Object returns are excluded, because `Ref<T>` and `T*` are encoded differently by PtrToArg.
+        bool is_ptrcall_supported(const internal::FMethodBindInfo& p_method_info)
+        {
+            if (p_method_info.is_vararg) return false;
+            for (const Variant::Type type : p_method_info.argument_types)
+            {
+                if (type == Variant::NIL) return false;
+            }
+            if (!p_method_info.has_return) return true;
+            return p_method_info.return_type != Variant::NIL && p_method_info.return_type != Variant::OBJECT;
+        }
+
+        // an indexed property accessor takes the index (int) as the first argument
+        bool is_ptrcall_supported(const internal::FPropertyInfo2& p_property_info, const MethodBind* p_method_bind, bool p_is_setter)
+        {
+            if (p_method_bind->is_vararg() || p_method_bind->get_argument_type(0) != Variant::INT) return false;
+            if (p_property_info.type == Variant::NIL) return false;
+            return p_is_setter
+                ? p_method_bind->get_argument_count() == 2 && p_method_bind->get_argument_type(1) == p_property_info.type && !p_method_bind->has_return()
+                : p_method_bind->get_argument_count() == 1 && p_property_info.type != Variant::OBJECT;
+        }
+
+        // make sure the variant is exactly the expected type, since the storage is used as the native argument by ptrcall.
+        // the converted value may be a compatible variant of another type (e.g. Vector2 for Vector2i)
+        bool to_ptrcall_argument(Variant::Type p_type, Variant& r_value)
+        {
+            const Variant::Type converted_type = r_value.get_type();
+            if (converted_type == p_type)
+            {
+                return true;
+            }
+            if (converted_type == Variant::NIL)
+            {
+                VariantInternal::initialize(&r_value, p_type);
+                return true;
+            }
+            if (!Variant::can_convert(converted_type, p_type))
+            {
+                return false;
+            }
+            const Variant source = r_value;
+            const Variant* source_ptr = &source;
+            Callable::CallError error;
+            Variant::construct(p_type, r_value, &source_ptr, 1, error);
+            return error.error == Callable::CallError::CALL_OK;
+        }
+#endif
+
+        v8::FunctionCallback select_method_callback(Environment* p_env, int p_method_index)
+        {
+#if JSB_FAST_REFLECTION
+            if (is_ptrcall_supported(p_env->get_variant_info_collection().method_binds[p_method_index]))
+            {
+                return ObjectReflectBindingUtil::_godot_object_method_ptrcall;
+            }
+#endif
+            return ObjectReflectBindingUtil::_godot_object_method;
+        }
+
+#if JSB_V8_FAST_API_CALLS
+        constexpr size_t kMaxFastMethodArgs = 2;
+
+        // the native storage of a ptrcall argument or return value (int is int64_t, float is double in PtrToArg)
+        union FastMethodSlot
+        {
+            int64_t i;
+            double f;
+            bool b;
+        };
+
+        jsb_force_inline void store_fast_argument(FastMethodSlot& r_slot, Variant::Type p_type, double p_value)
+        {
+            // truncated as `Helper::to_int64` does in the slow path
+            if (p_type == Variant::INT) r_slot.i = (int64_t) p_value;
+            else r_slot.f = p_value;
+        }
+
+        jsb_force_inline void store_fast_argument(FastMethodSlot& r_slot, Variant::Type p_type, bool p_value)
+        {
+            jsb_unused(p_type);
+            r_slot.b = p_value;
+        }
+
+        template<typename R>
+        jsb_force_inline R load_fast_return(const FastMethodSlot& p_slot)
+        {
+            if constexpr (std::is_same_v<R, bool>) return p_slot.b;
+            else return p_slot.f;
+        }
+
+        /**
+         * The fast callback of a const method with only number/bool arguments (data: method index).
+         * It must not allocate JS objects or call into JS unless throwing, so it's limited to the methods not calling scripts.
+         * The call sites with a different argument count or other value types stay on the slow callback.
+         */
+        template<typename R, typename... A>
+        struct FastMethodCall
+        {
+            static R call(v8::Local<v8::Object> receiver, A... args, v8::FastApiCallbackOptions& options)
+            {
+                v8::Isolate* isolate = options.isolate;
+                Environment* env = Environment::wrap(isolate);
+                const internal::FMethodBindInfo& method_info = env->get_variant_info_collection().method_binds[options.data.As<v8::Int32>()->Value()];
+                const MethodBind* method_bind = method_info.method_bind;
+
+                Object* gd_object = (Object*) env->get_verified_object(receiver, NativeClassType::GodotObject);
+                if (!gd_object)
+                {
+                    v8::HandleScope handle_scope(isolate);
+                    const String error_message = jsb_errorf("Failed to call: %s. Bad this", method_bind->get_name());
+                    impl::Helper::throw_error(isolate, error_message);
+                    return R();
+                }
+
+                FastMethodSlot slots[sizeof...(A) + 1] = {};
+                const void* argp[sizeof...(A) + 1] = {};
+                int index = 0;
+                ((store_fast_argument(slots[index], method_info.argument_types[index], args), argp[index] = &slots[index], ++index), ...);
+                jsb_unused(index);
+
+                if constexpr (std::is_void_v<R>)
+                {
+                    method_bind->ptrcall(gd_object, argp, nullptr);
+                }
+                else
+                {
+                    FastMethodSlot rval = {};
+                    method_bind->ptrcall(gd_object, argp, &rval);
+                    return load_fast_return<R>(rval);
+                }
+            }
+
+            static const v8::CFunction* get()
+            {
+                static const v8::CFunction c_function = v8::CFunction::Make(call);
+                return &c_function;
+            }
+        };
+
+        template<typename R, typename... A>
+        const v8::CFunction* select_fast_method(const Variant::Type* p_types, int p_remaining)
+        {
+            if (p_remaining == 0)
+            {
+                return FastMethodCall<R, A...>::get();
+            }
+            if constexpr (sizeof...(A) < kMaxFastMethodArgs)
+            {
+                switch (p_types[0])
+                {
+                case Variant::INT:
+                case Variant::FLOAT: return select_fast_method<R, A..., double>(p_types + 1, p_remaining - 1);
+                case Variant::BOOL: return select_fast_method<R, A..., bool>(p_types + 1, p_remaining - 1);
+                default: return nullptr;
+                }
+            }
+            return nullptr;
+        }
+
+        // get the fast callback if the method qualifies, otherwise nullptr.
+        // only const methods are accepted, since the other ones may notify scripts (e.g. NOTIFICATION_TRANSFORM_CHANGED),
+        // and int returns are excluded because it may be greater than JSB_MAX_SAFE_INTEGER (returned as BigInt in the slow path).
+        const v8::CFunction* get_fast_method(const internal::FMethodBindInfo& p_method_info)
+        {
+            if (p_method_info.is_static || p_method_info.is_vararg || !p_method_info.method_bind->is_const()) return nullptr;
+            const int argc = p_method_info.get_argument_count();
+            if (argc > (int) kMaxFastMethodArgs) return nullptr;
+
+            const Variant::Type* types = p_method_info.argument_types.ptr();
+            if (!p_method_info.has_return) return select_fast_method<void>(types, argc);
+            switch (p_method_info.return_type)
+            {
+            case Variant::BOOL: return select_fast_method<bool>(types, argc);
+            case Variant::FLOAT: return select_fast_method<double>(types, argc);
+            default: return nullptr;
+            }
+        }
+#endif
+    }
+
     NativeClassInfoPtr ObjectReflectBindingUtil::reflect_bind(Environment* p_env, const ClassDB::ClassInfo* p_class_info, NativeClassID* r_class_id)
     {
         v8::Isolate* isolate = p_env->get_isolate();
@@ -30,6 +288,8 @@ namespace jsb
 #if JSB_EXCLUDE_GETSET_METHODS
             HashSet<StringName> omitted_methods;
 #endif
+            // a MethodBind may be shared by a property and a method
+            HashMap<const MethodBind*, int> method_indices;
             // class: properties (getset)
             for (const KeyValue<StringName, ::ClassDB::PropertySetGet>& pair : p_class_info->property_setget)
             {
@@ -45,19 +305,28 @@ namespace jsb
                     property_info2.getter_func = getset_info._getptr;
                     property_info2.setter_func = getset_info._setptr;
                     property_info2.index = pair.value.index;
+                    property_info2.type = getset_info._getptr ? getset_info._getptr->get_argument_type(-1) : getset_info._setptr->get_argument_type(1);
                     p_env->get_variant_info_collection().properties2.append(property_info2);
 
-                    class_builder.Instance().Property(property_name,
-                        getset_info._getptr ? _godot_object_get2 : nullptr,
-                        getset_info._setptr ? _godot_object_set2 : nullptr, remap_index);
+#if JSB_FAST_REFLECTION
+                    const v8::FunctionCallback getter = !getset_info._getptr ? nullptr
+                        : is_ptrcall_supported(property_info2, getset_info._getptr, false) ? _godot_object_get2_ptrcall : _godot_object_get2;
+                    const v8::FunctionCallback setter = !getset_info._setptr ? nullptr
+                        : is_ptrcall_supported(property_info2, getset_info._setptr, true) ? _godot_object_set2_ptrcall : _godot_object_set2;
+#else
+                    const v8::FunctionCallback getter = getset_info._getptr ? _godot_object_get2 : nullptr;
+                    const v8::FunctionCallback setter = getset_info._setptr ? _godot_object_set2 : nullptr;
+#endif
+                    class_builder.Instance().Property(property_name, getter, setter, remap_index);
                     // we do not exclude get/set methods in this case, because the method may not be covered by all properties
                 }
                 else
                 {
-                    // not using `property_collection_` in this case due to lower memory cost
+                    const int getter_index = getset_info._getptr ? add_method_bind_info(p_env, method_indices, getset_info._getptr) : -1;
+                    const int setter_index = getset_info._setptr ? add_method_bind_info(p_env, method_indices, getset_info._setptr) : -1;
                     class_builder.Instance().Property(property_name,
-                        getset_info._getptr ? _godot_object_method : nullptr, (void*) getset_info._getptr,
-                        getset_info._setptr ? _godot_object_method : nullptr, (void*) getset_info._setptr);
+                        getset_info._getptr ? select_method_callback(p_env, getter_index) : nullptr, getter_index,
+                        getset_info._setptr ? select_method_callback(p_env, setter_index) : nullptr, setter_index);
 
 #if JSB_EXCLUDE_GETSET_METHODS
                     if (internal::VariantUtil::is_valid_name(getset_info.getter)) omitted_methods.insert(getset_info.getter);
@@ -73,16 +342,38 @@ namespace jsb
                 if (omitted_methods.has(pair.key)) continue;
 #endif
                 const StringName& method_name = internal::NamingUtil::get_member_name(pair.key);
-                const MethodBind* method_bind = pair.value;
+                MethodBind* method_bind = pair.value;
+                const int method_index = add_method_bind_info(p_env, method_indices, method_bind);
+
+#if JSB_V8_FAST_API_CALLS
+                // bound eagerly even if JSB_LAZY_METHOD_BINDING, a lazily created function has no template to carry the CFunction
+                if (const v8::CFunction* c_function = get_fast_method(p_env->get_variant_info_collection().method_binds[method_index]))
+                {
+                    class_builder.Instance().FastMethod(method_name, select_method_callback(p_env, method_index), c_function, method_index);
+                    continue;
+                }
+#endif
 
+#if JSB_LAZY_METHOD_BINDING
+                // most of the methods are never called, the function is created on the first access
+                if (method_bind->is_static())
+                {
+                    static_builder.LazyProperty(method_name, _godot_object_method_lazy, method_index);
+                }
+                else
+                {
+                    class_builder.Instance().LazyProperty(method_name, _godot_object_method_lazy, method_index);
+                }
+#else
                 if (method_bind->is_static())
                 {
-                    static_builder.Method(method_name, _godot_object_method, (void*) method_bind);
+                    static_builder.Method(method_name, select_method_callback(p_env, method_index), method_index);
                 }
                 else
                 {
-                    class_builder.Instance().Method(method_name, _godot_object_method, (void*) method_bind);
+                    class_builder.Instance().Method(method_name, select_method_callback(p_env, method_index), method_index);
                 }
+#endif
             }
 
              if (p_class_info->name == jsb_string_name(Object))
@@ -155,6 +446,21 @@ namespace jsb
         } // end type template block scope
     }
 
+#if JSB_LAZY_METHOD_BINDING
+    void ObjectReflectBindingUtil::_godot_object_method_lazy(v8::Local<v8::Name> name, const v8::PropertyCallbackInfo<v8::Value>& info)
+    {
+        v8::Isolate* isolate = info.GetIsolate();
+        const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+
+        jsb_check(info.Data()->IsInt32());
+        const int method_index = info.Data().As<v8::Int32>()->Value();
+        const CharString name8 = impl::Helper::to_string(isolate, name).utf8();
+
+        // the same function as the one bound eagerly, it replaces the lazy property after returned
+        info.GetReturnValue().Set(impl::Helper::NewFunction(context, name8.get_data(), select_method_callback(Environment::wrap(isolate), method_index), info.Data()));
+    }
+#endif
+
     void ObjectReflectBindingUtil::_godot_object_signal_get(const v8::FunctionCallbackInfo<v8::Value>& info)
     {
         v8::Isolate* isolate = info.GetIsolate();
@@ -184,6 +490,12 @@ namespace jsb
         const Object* gd_object = (Object*) pointer;
         if (v8::Local<v8::Value> rval; TypeConvert::gd_var_to_js(isolate, context, Signal(gd_object, gd_signal_name), rval))
         {
+            // cache it on the instance, the own property shadows this accessor and the following reads are plain property loads
+            const v8::Local<v8::String> member_name = environment->get_string_name_cache().get_string_value(isolate, internal::NamingUtil::get_member_name(gd_signal_name));
+            if (self->DefineOwnProperty(context, member_name, rval, (v8::PropertyAttribute) (v8::ReadOnly | v8::DontEnum)).IsNothing())
+            {
+                JSB_LOG(Verbose, "failed to cache signal %s", gd_signal_name);
+            }
             info.GetReturnValue().Set(rval);
             return;
         }
@@ -255,6 +567,70 @@ namespace jsb
         script_instance->cache_property(property_name, gd_value);
     }
 
+    namespace
+    {
+        Variant* get_property_slot(Environment* p_env, const v8::FunctionCallbackInfo<v8::Value>& info)
+        {
+            jsb_check(info.Data()->IsInt32());
+            void* pointer = p_env->get_verified_object(info.This(), NativeClassType::GodotObject);
+            if (!pointer)
+            {
+                return nullptr;
+            }
+
+            ScriptInstance* script_instance = ((Object*) pointer)->get_script_instance();
+            if (!script_instance || script_instance->get_language() != GodotJSScriptLanguage::get_singleton()
+                || ((GodotJSScriptInstanceBase*) script_instance)->is_shadow())
+            {
+                return nullptr;
+            }
+            return ((GodotJSScriptInstance*) script_instance)->get_property_slot((uint32_t) info.Data().As<v8::Int32>()->Value() >> 8);
+        }
+    }
+
+    void ObjectReflectBindingUtil::_godot_object_slot_property_get(const v8::FunctionCallbackInfo<v8::Value>& info)
+    {
+        v8::Isolate* isolate = info.GetIsolate();
+        const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+        Environment* environment = Environment::wrap(isolate);
+
+        const Variant* slot = get_property_slot(environment, info);
+        if (!slot)
+        {
+            jsb_throw(isolate, "bad property slot");
+            return;
+        }
+
+        if (v8::Local<v8::Value> rval; TypeConvert::gd_var_to_js(isolate, context, *slot, rval))
+        {
+            info.GetReturnValue().Set(rval);
+            return;
+        }
+        const String error_message = jsb_errorf("Failed to translate Godot %s to a JS value", Variant::get_type_name(slot->get_type()));
+        impl::Helper::throw_error(isolate, error_message);
+    }
+
+    void ObjectReflectBindingUtil::_godot_object_slot_property_set(const v8::FunctionCallbackInfo<v8::Value>& info)
+    {
+        v8::Isolate* isolate = info.GetIsolate();
+        const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+        Environment* environment = Environment::wrap(isolate);
+
+        Variant* slot = get_property_slot(environment, info);
+        if (!slot || info.Length() != 1)
+        {
+            jsb_throw(isolate, "bad property slot");
+            return;
+        }
+
+        const Variant::Type type = (Variant::Type) (info.Data().As<v8::Int32>()->Value() & 0xff);
+        if (!TypeConvert::js_to_gd_var(isolate, context, info[0], type, *slot))
+        {
+            const String error_message = jsb_errorf("Failed to translate the value to a Godot %s", Variant::get_type_name(type));
+            impl::Helper::throw_error(isolate, error_message);
+        }
+    }
+
     void ObjectReflectBindingUtil::_godot_object_free(const v8::FunctionCallbackInfo<v8::Value>& info)
     {
         v8::Isolate* isolate = info.GetIsolate();
@@ -276,11 +652,113 @@ namespace jsb
         }
     }
 
+    namespace
+    {
+        // keep the results identical to VariantUtilityFunctions (for the numeric overloads of the Variant-typed ones)
+        struct FNumberUtilityFunc
+        {
+            const char* name;
+            double (*func)(const double* p_args);
+        };
+
+        const FNumberUtilityFunc number_utility_funcs[] =
+        {
+            { "sin", [](const double* p_args) { return Math::sin(p_args[0]); } },
+            { "cos", [](const double* p_args) { return Math::cos(p_args[0]); } },
+            { "tan", [](const double* p_args) { return Math::tan(p_args[0]); } },
+            { "sinh", [](const double* p_args) { return Math::sinh(p_args[0]); } },
+            { "cosh", [](const double* p_args) { return Math::cosh(p_args[0]); } },
+            { "tanh", [](const double* p_args) { return Math::tanh(p_args[0]); } },
+            { "asin", [](const double* p_args) { return Math::asin(p_args[0]); } },
+            { "acos", [](const double* p_args) { return Math::acos(p_args[0]); } },
+            { "atan", [](const double* p_args) { return Math::atan(p_args[0]); } },
+            { "atan2", [](const double* p_args) { return Math::atan2(p_args[0], p_args[1]); } },
+            { "sqrt", [](const double* p_args) { return Math::sqrt(p_args[0]); } },
+            { "fmod", [](const double* p_args) { return Math::fmod(p_args[0], p_args[1]); } },
+            { "fposmod", [](const double* p_args) { return Math::fposmod(p_args[0], p_args[1]); } },
+            { "floorf", [](const double* p_args) { return Math::floor(p_args[0]); } },
+            { "ceilf", [](const double* p_args) { return Math::ceil(p_args[0]); } },
+            { "roundf", [](const double* p_args) { return Math::round(p_args[0]); } },
+            { "absf", [](const double* p_args) { return std::fabs(p_args[0]); } },
+            { "signf", [](const double* p_args) { return (double) SIGN(p_args[0]); } },
+            { "pow", [](const double* p_args) { return Math::pow(p_args[0], p_args[1]); } },
+            { "log", [](const double* p_args) { return Math::log(p_args[0]); } },
+            { "exp", [](const double* p_args) { return Math::exp(p_args[0]); } },
+            { "ease", [](const double* p_args) { return Math::ease(p_args[0], p_args[1]); } },
+            { "deg_to_rad", [](const double* p_args) { return Math::deg_to_rad(p_args[0]); } },
+            { "rad_to_deg", [](const double* p_args) { return Math::rad_to_deg(p_args[0]); } },
+            { "lerp", [](const double* p_args) { return Math::lerp(p_args[0], p_args[1], p_args[2]); } },
+            { "lerpf", [](const double* p_args) { return Math::lerp(p_args[0], p_args[1], p_args[2]); } },
+            { "lerp_angle", [](const double* p_args) { return Math::lerp_angle(p_args[0], p_args[1], p_args[2]); } },
+            { "inverse_lerp", [](const double* p_args) { return Math::inverse_lerp(p_args[0], p_args[1], p_args[2]); } },
+            { "remap", [](const double* p_args) { return Math::remap(p_args[0], p_args[1], p_args[2], p_args[3], p_args[4]); } },
+            { "smoothstep", [](const double* p_args) { return Math::smoothstep(p_args[0], p_args[1], p_args[2]); } },
+            { "move_toward", [](const double* p_args) { return Math::move_toward(p_args[0], p_args[1], p_args[2]); } },
+            { "wrapf", [](const double* p_args) { return Math::wrapf(p_args[0], p_args[1], p_args[2]); } },
+            { "snapped", [](const double* p_args) { return Math::snapped(p_args[0], p_args[1]); } },
+            { "snappedf", [](const double* p_args) { return Math::snapped(p_args[0], p_args[1]); } },
+            { "clampf", [](const double* p_args) { return CLAMP(p_args[0], p_args[1], p_args[2]); } },
+            { "clamp", [](const double* p_args)
+                {
+                    // the same comparison order as VariantUtilityFunctions::clamp
+                    double value = p_args[0];
+                    if (value < p_args[1]) value = p_args[1];
+                    if (value > p_args[2]) value = p_args[2];
+                    return value;
+                } },
+            { "randf", [](const double*) { return (double) Math::randf(); } },
+            { "randf_range", [](const double* p_args) { return Math::random(p_args[0], p_args[1]); } },
+        };
+    }
+
+    decltype(internal::FUtilityMethodInfo::number_func) ObjectReflectBindingUtil::get_number_utility_func(const StringName& p_name)
+    {
+        for (const FNumberUtilityFunc& it : number_utility_funcs)
+        {
+            if (p_name == it.name)
+            {
+                return it.func;
+            }
+        }
+        return nullptr;
+    }
+
+    void ObjectReflectBindingUtil::_godot_utility_func_number(const v8::FunctionCallbackInfo<v8::Value>& info)
+    {
+        v8::Isolate* isolate = info.GetIsolate();
+        const internal::FUtilityMethodInfo& method_info = SharedVariantInfo::get().collection.utility_funcs[info.Data().As<v8::Int32>()->Value()];
+        const int argc = info.Length();
+        jsb_check(method_info.number_func && !method_info.is_vararg);
+
+        if (argc == method_info.argument_types.size())
+        {
+            double* args = jsb_stackalloc(double, argc);
+            int index = 0;
+            for (; index < argc; ++index)
+            {
+                const v8::Local<v8::Value> arg = info[index];
+                if (!arg->IsNumber()) break;
+                args[index] = arg.As<v8::Number>()->Value();
+            }
+            if (index == argc)
+            {
+                // (the other calls are counted by the validated path)
+                JSB_COUNT_BINDING(Environment::wrap(isolate), KIND_UTILITY_FUNC, info.Data().As<v8::Int32>()->Value());
+                info.GetReturnValue().Set(v8::Number::New(isolate, method_info.number_func(args)));
+                return;
+            }
+        }
+
+        // vectors, colors or bad arguments (the validated path reports the errors)
+        _godot_utility_func(info);
+    }
+
     void ObjectReflectBindingUtil::_godot_utility_func(const v8::FunctionCallbackInfo<v8::Value>& info)
     {
         v8::Isolate* isolate = info.GetIsolate();
         const v8::Local<v8::Context> context = isolate->GetCurrentContext();
-        const internal::FUtilityMethodInfo& method_info = Environment::wrap(context)->get_variant_info_collection().utility_funcs[info.Data().As<v8::Int32>()->Value()];
+        const internal::FUtilityMethodInfo& method_info = SharedVariantInfo::get().collection.utility_funcs[info.Data().As<v8::Int32>()->Value()];
+        JSB_COUNT_BINDING(Environment::wrap(isolate), KIND_UTILITY_FUNC, info.Data().As<v8::Int32>()->Value());
         const int argc = info.Length();
 
         // prepare argv
@@ -290,9 +768,10 @@ namespace jsb
             impl::Helper::throw_error(isolate, error_message);
             return;
         }
-        const Variant** argv = jsb_stackalloc(const Variant*, argc);
+        internal::ScratchArena::Scope scratch;
+        const Variant** argv = scratch.alloc<const Variant*>(argc);
         const int known_argc = (int) method_info.argument_types.size();
-        Variant* args = jsb_stackalloc(Variant, argc);
+        Variant* args = scratch.alloc<Variant>(argc);
         for (int index = 0; index < argc; ++index)
         {
             memnew_placement(&args[index], Variant);
@@ -333,16 +812,20 @@ namespace jsb
 
     void ObjectReflectBindingUtil::_godot_object_method(const v8::FunctionCallbackInfo<v8::Value>& info)
     {
-        jsb_check(info.Data()->IsExternal());
+        jsb_check(info.Data()->IsInt32());
         v8::Isolate* isolate = info.GetIsolate();
         v8::Local<v8::Context> context = isolate->GetCurrentContext();
-        const MethodBind* method_bind = (MethodBind*) info.Data().As<v8::External>()->Value();
+        Environment* env = Environment::wrap(isolate);
+        const internal::FMethodBindInfo& method_info = env->get_variant_info_collection().method_binds[info.Data().As<v8::Int32>()->Value()];
+        JSB_COUNT_BINDING(env, KIND_METHOD_BIND, info.Data().As<v8::Int32>()->Value());
+        const MethodBind* method_bind = method_info.method_bind;
         const int argc = info.Length();
+        JSB_TRACE_SCOPE("godot_object_method", method_bind->get_name());
 
         jsb_check(method_bind);
-        Environment::wrap(isolate)->check_internal_state();
+        env->check_internal_state();
         Object* gd_object = nullptr;
-        if (!method_bind->is_static())
+        if (!method_info.is_static)
         {
             if (!TypeConvert::js_to_gd_obj(isolate, context, info.This(), gd_object) || !gd_object)
             {
@@ -353,31 +836,37 @@ namespace jsb
         }
 
         // prepare argv
-        const int method_argc = method_bind->get_argument_count();
-        const bool method_is_vararg = method_bind->is_vararg();
-        if (!internal::VariantUtil::check_argc(method_is_vararg, argc, method_bind->get_default_argument_count(), method_argc))
+        const int method_argc = method_info.get_argument_count();
+        if (!method_info.check_argc(argc))
         {
-            const String error_message = jsb_errorf("Failed to call: %s. %d arguments are required", method_bind->get_name(), method_argc - method_bind->get_default_argument_count());
+            const String error_message = jsb_errorf("Failed to call: %s. %d arguments are required", method_bind->get_name(), method_argc - method_info.get_default_argument_count());
             impl::Helper::throw_error(isolate, error_message);
             return;
         }
-        const Variant** argv = jsb_stackalloc(const Variant*, argc);
-        Variant* args = jsb_stackalloc(Variant, argc);
+        internal::ScratchArena::Scope scratch;
+        const Variant** argv = scratch.alloc<const Variant*>(argc);
+        Variant* args = scratch.alloc<Variant>(argc);
         for (int index = 0; index < argc; ++index)
         {
             memnew_placement(&args[index], Variant);
             argv[index] = &args[index];
             const Variant::Type type = index >= method_argc
                 ? Variant::Type::NIL
-                : method_bind->get_argument_type(index);
+                : method_info.argument_types[index];
 
             const v8::Local<v8::Value>& argument = info[index];
 
-            if (argument->IsUndefined() && method_bind->has_default_argument(index))
+            if (argument->IsUndefined() && method_info.has_default_argument(index))
             {
-                args[index] = method_bind->get_default_argument(index);
+                args[index] = method_info.get_default_argument(index);
             }
-            else if (!TypeConvert::js_to_gd_var(isolate, context, argument, type, args[index]))
+            else if (type == Variant::STRING_NAME && argument->IsString())
+            {
+                args[index] = env->get_string_name(argument.As<v8::String>(), method_info.string_name_sites.ptrw()[index]);
+            }
+            else if (index >= method_argc
+                ? !TypeConvert::js_to_gd_var(isolate, context, argument, args[index])
+                : !get_argument_converter(method_info, index)(isolate, context, argument, args[index]))
             {
                 // revert all constructors
                 const String error_message = jsb_errorf("Failed to call: %s. Bad argument: %d. Unable to convert JS %s to Godot %s", method_bind->get_name(), index, TypeConvert::js_debug_typeof(isolate, info[index]), Variant::get_type_name(type));
@@ -388,6 +877,8 @@ namespace jsb
         }
 
         // call godot method
+        // (method_info may be invalidated if new classes are exposed during the call)
+        const TypeConvert::GDToJSFunc return_converter = get_return_converter(method_info);
         Callable::CallError error;
         Variant crval = method_bind->call(gd_object, argv, argc, error);
 
@@ -404,9 +895,7 @@ namespace jsb
             return;
         }
         v8::Local<v8::Value> jrval;
-        const Variant::Type return_type = method_bind->get_argument_type(-1);
-        jsb_check(return_type == method_bind->get_return_info().type);
-        if (TypeConvert::gd_var_to_js(isolate, context, crval, return_type, jrval))
+        if (return_converter(isolate, context, crval, jrval))
         {
             info.GetReturnValue().Set(jrval);
             return;
@@ -419,6 +908,132 @@ namespace jsb
         impl::Helper::throw_error(isolate, error_message);
     }
 
+#if JSB_FAST_REFLECTION
+    void ObjectReflectBindingUtil::_godot_object_method_ptrcall(const v8::FunctionCallbackInfo<v8::Value>& info)
+    {
+        jsb_check(info.Data()->IsInt32());
+        v8::Isolate* isolate = info.GetIsolate();
+        v8::Local<v8::Context> context = isolate->GetCurrentContext();
+        Environment* env = Environment::wrap(isolate);
+        const internal::FMethodBindInfo& method_info = env->get_variant_info_collection().method_binds[info.Data().As<v8::Int32>()->Value()];
+        JSB_COUNT_BINDING(env, KIND_METHOD_BIND, info.Data().As<v8::Int32>()->Value());
+        const MethodBind* method_bind = method_info.method_bind;
+        const int argc = info.Length();
+        JSB_TRACE_SCOPE("godot_object_method", method_bind->get_name());
+
+        jsb_check(method_bind);
+        jsb_check(!method_info.is_vararg);
+        env->check_internal_state();
+        Object* gd_object = nullptr;
+        if (!method_info.is_static)
+        {
+            if (!TypeConvert::js_to_gd_obj(isolate, context, info.This(), gd_object) || !gd_object)
+            {
+                const String error_message = jsb_errorf("Failed to call: %s. Bad this", method_bind->get_name());
+                impl::Helper::throw_error(isolate, error_message);
+                return;
+            }
+        }
+
+        const int method_argc = method_info.get_argument_count();
+        if (!method_info.check_argc(argc))
+        {
+            const String error_message = jsb_errorf("Failed to call: %s. %d arguments are required", method_bind->get_name(), method_argc - method_info.get_default_argument_count());
+            impl::Helper::throw_error(isolate, error_message);
+            return;
+        }
+
+        // the scratch allocated variants are only used as the typed native storage of arguments,
+        // which are accessed through the opaque pointers as the layout expected by PtrToArg.
+        internal::ScratchArena::Scope scratch;
+        const void** argp = scratch.alloc<const void*>(method_argc);
+        Variant* args = scratch.alloc<Variant>(method_argc);
+        for (int index = 0; index < method_argc; ++index)
+        {
+            memnew_placement(&args[index], Variant);
+            const Variant::Type type = method_info.argument_types[index];
+            const TypeConvert::JSToGDFunc converter = get_argument_converter(method_info, index);
+
+            if (index >= argc || info[index]->IsUndefined())
+            {
+                // check_argc guarantees the default argument exists if it's not provided
+                if (index < argc && !method_info.has_default_argument(index))
+                {
+                    if (!converter(isolate, context, info[index], args[index]))
+                    {
+                        goto BAD_ARGUMENT;  // NOLINT(cppcoreguidelines-avoid-goto, hicpp-avoid-goto)
+                    }
+                }
+                else
+                {
+                    args[index] = method_info.get_default_argument(index);
+                }
+            }
+            else if (type == Variant::STRING_NAME && info[index]->IsString())
+            {
+                args[index] = env->get_string_name(info[index].As<v8::String>(), method_info.string_name_sites.ptrw()[index]);
+            }
+            else if (!converter(isolate, context, info[index], args[index]))
+            {
+                goto BAD_ARGUMENT;  // NOLINT(cppcoreguidelines-avoid-goto, hicpp-avoid-goto)
+            }
+
+            if (!to_ptrcall_argument(type, args[index]))
+            {
+                goto BAD_ARGUMENT;  // NOLINT(cppcoreguidelines-avoid-goto, hicpp-avoid-goto)
+            }
+            argp[index] = VariantInternal::get_opaque_pointer(&args[index]);
+            continue;
+
+            BAD_ARGUMENT:
+            {
+                // revert all constructors
+                const String error_message = index < argc
+                    ? jsb_errorf("Failed to call: %s. Bad argument: %d. Unable to convert JS %s to Godot %s", method_bind->get_name(), index, TypeConvert::js_debug_typeof(isolate, info[index]), Variant::get_type_name(type))
+                    : jsb_errorf("Failed to call: %s. Bad default argument: %d", method_bind->get_name(), index);
+                while (index >= 0) { args[index--].~Variant(); }
+                impl::Helper::throw_error(isolate, error_message);
+                return;
+            }
+        }
+
+        // call godot method
+        // (method_info may be invalidated if new classes are exposed during the call)
+        const bool has_return = method_info.has_return;
+        const Variant::Type return_type = method_info.return_type;
+        const TypeConvert::GDToJSFunc return_converter = get_return_converter(method_info);
+        Variant crval;
+        if (has_return)
+        {
+            VariantInternal::initialize(&crval, return_type);
+        }
+        method_bind->ptrcall(gd_object, argp, has_return ? VariantInternal::get_opaque_pointer(&crval) : nullptr);
+
+        // don't forget to destruct all stack allocated variants
+        for (int index = 0; index < method_argc; ++index)
+        {
+            args[index].~Variant();
+        }
+
+        if (!has_return)
+        {
+            return;
+        }
+        v8::Local<v8::Value> jrval;
+        if (return_converter(isolate, context, crval, jrval))
+        {
+            info.GetReturnValue().Set(jrval);
+            return;
+        }
+        const String error_message = jsb_errorf(
+            "Failed to return from call: %s. "
+            "Failed to translate returned Godot %s to a JS value",
+            method_bind->get_name(),
+            Variant::get_type_name(crval.get_type()));
+        impl::Helper::throw_error(isolate, error_message);
+    }
+#endif
+
     void ObjectReflectBindingUtil::_godot_object_get2(const v8::FunctionCallbackInfo<v8::Value>& info)
     {
         jsb_check(info.Data()->IsInt32());
@@ -426,6 +1041,7 @@ namespace jsb
         Environment* env = Environment::wrap(isolate);
         const v8::Local<v8::Context> context = isolate->GetCurrentContext();
         const internal::FPropertyInfo2& property_info = env->get_variant_info_collection().properties2[info.Data().As<v8::Int32>()->Value()];
+        JSB_COUNT_BINDING(env, KIND_PROPERTY_GET, info.Data().As<v8::Int32>()->Value());
         env->check_internal_state();
         // prepare argv
         if (info.Length() != 0)
@@ -476,6 +1092,7 @@ namespace jsb
         Environment* env = Environment::wrap(isolate);
         const v8::Local<v8::Context> context = isolate->GetCurrentContext();
         const internal::FPropertyInfo2& property_info = env->get_variant_info_collection().properties2[info.Data().As<v8::Int32>()->Value()];
+        JSB_COUNT_BINDING(env, KIND_PROPERTY_SET, info.Data().As<v8::Int32>()->Value());
         env->check_internal_state();
         // prepare argv
         if (info.Length() != 1)
@@ -518,4 +1135,94 @@ namespace jsb
         }
     }
 
+#if JSB_FAST_REFLECTION
+    void ObjectReflectBindingUtil::_godot_object_get2_ptrcall(const v8::FunctionCallbackInfo<v8::Value>& info)
+    {
+        jsb_check(info.Data()->IsInt32());
+        v8::Isolate* isolate = info.GetIsolate();
+        Environment* env = Environment::wrap(isolate);
+        const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+        const internal::FPropertyInfo2& property_info = env->get_variant_info_collection().properties2[info.Data().As<v8::Int32>()->Value()];
+        JSB_COUNT_BINDING(env, KIND_PROPERTY_GET, info.Data().As<v8::Int32>()->Value());
+        const MethodBind* getter_func = property_info.getter_func;
+        const Variant::Type type = property_info.type;
+        env->check_internal_state();
+        if (info.Length() != 0)
+        {
+            const String error_message = jsb_errorf("Failed to get property: %s. Arguments unexpectedly provided", getter_func->get_name());
+            impl::Helper::throw_error(isolate, error_message);
+            return;
+        }
+
+        Object* gd_object = nullptr;
+        if (!getter_func->is_static() && (!TypeConvert::js_to_gd_obj(isolate, context, info.This(), gd_object) || !gd_object))
+        {
+            const String error_message = jsb_errorf("Failed to get property: %s. Bad this", getter_func->get_name());
+            impl::Helper::throw_error(isolate, error_message);
+            return;
+        }
+
+        // int (and enum) arguments are passed as int64_t by PtrToArg
+        const int64_t index = property_info.index;
+        const void* argp[] = { &index };
+
+        // call godot method
+        Variant crval;
+        VariantInternal::initialize(&crval, type);
+        getter_func->ptrcall(gd_object, argp, VariantInternal::get_opaque_pointer(&crval));
+
+        v8::Local<v8::Value> jrval;
+        if (TypeConvert::gd_var_to_js(isolate, context, crval, type, jrval))
+        {
+            info.GetReturnValue().Set(jrval);
+            return;
+        }
+        const String error_message = jsb_errorf("Failed to get property: %s. Failed to translate returned Godot %s to a JS value",
+            getter_func->get_name(), Variant::get_type_name(crval.get_type()));
+        impl::Helper::throw_error(isolate, error_message);
+    }
+
+    void ObjectReflectBindingUtil::_godot_object_set2_ptrcall(const v8::FunctionCallbackInfo<v8::Value>& info)
+    {
+        jsb_check(info.Data()->IsInt32());
+        v8::Isolate* isolate = info.GetIsolate();
+        Environment* env = Environment::wrap(isolate);
+        const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+        const internal::FPropertyInfo2& property_info = env->get_variant_info_collection().properties2[info.Data().As<v8::Int32>()->Value()];
+        JSB_COUNT_BINDING(env, KIND_PROPERTY_SET, info.Data().As<v8::Int32>()->Value());
+        const MethodBind* setter_func = property_info.setter_func;
+        const Variant::Type type = property_info.type;
+        env->check_internal_state();
+        if (info.Length() != 1)
+        {
+            const String error_message = jsb_errorf("Failed to set property: %s. 1 argument is required", setter_func->get_name());
+            impl::Helper::throw_error(isolate, error_message);
+            return;
+        }
+
+        Object* gd_object = nullptr;
+        if (!setter_func->is_static() && (!TypeConvert::js_to_gd_obj(isolate, context, info.This(), gd_object) || !gd_object))
+        {
+            const String error_message = jsb_errorf("Failed to set property: %s. Bad this", setter_func->get_name());
+            impl::Helper::throw_error(isolate, error_message);
+            return;
+        }
+
+        Variant cvar;
+        if (!TypeConvert::js_to_gd_var(isolate, context, info[0], type, cvar) || !to_ptrcall_argument(type, cvar))
+        {
+            const String error_message = jsb_errorf("Failed to set property: %s. Unable to convert provided JS %s to Godot %s",
+                setter_func->get_name(), TypeConvert::js_debug_typeof(isolate, info[0]), Variant::get_type_name(type));
+            impl::Helper::throw_error(isolate, error_message);
+            return;
+        }
+
+        // int (and enum) arguments are passed as int64_t by PtrToArg
+        const int64_t index = property_info.index;
+        const void* argp[] = { &index, VariantInternal::get_opaque_pointer(&cvar) };
+
+        // call godot method
+        setter_func->ptrcall(gd_object, argp, nullptr);
+    }
+#endif
 }
@@ -13,12 +13,35 @@ namespace jsb
 
         static void _godot_object_free(const v8::FunctionCallbackInfo<v8::Value>& info);
         static void _godot_object_method(const v8::FunctionCallbackInfo<v8::Value>& info);
+#if JSB_FAST_REFLECTION
+        // call a method with typed arguments (no Variant argument or return) through MethodBind::ptrcall
+        static void _godot_object_method_ptrcall(const v8::FunctionCallbackInfo<v8::Value>& info);
+#endif
         static void _godot_object_get2(const v8::FunctionCallbackInfo<v8::Value>& info);
         static void _godot_object_set2(const v8::FunctionCallbackInfo<v8::Value>& info);
+#if JSB_FAST_REFLECTION
+        // indexed property accessors with a typed value through MethodBind::ptrcall
+        static void _godot_object_get2_ptrcall(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void _godot_object_set2_ptrcall(const v8::FunctionCallbackInfo<v8::Value>& info);
+#endif
         static void _godot_object_signal_get(const v8::FunctionCallbackInfo<v8::Value>& info);
+#if JSB_LAZY_METHOD_BINDING
+        // create the function of a method on the first access (data: method index)
+        static void _godot_object_method_lazy(v8::Local<v8::Name> name, const v8::PropertyCallbackInfo<v8::Value>& info);
+#endif
         static void _godot_object_cached_export_update(const v8::FunctionCallbackInfo<v8::Value>& info);
+        // accessors of the exported fields stored in the native slots of GodotJSScriptInstance (data: index << 8 | Variant::Type)
+        static void _godot_object_slot_property_get(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void _godot_object_slot_property_set(const v8::FunctionCallbackInfo<v8::Value>& info);
         static void _godot_utility_func(const v8::FunctionCallbackInfo<v8::Value>& info);
 
+        // number-in/number-out utility functions (lerp, clamp, deg_to_rad...) without Variant marshaling,
+        // it falls back to `_godot_utility_func` if any argument is not a number (data: utility function index)
+        static void _godot_utility_func_number(const v8::FunctionCallbackInfo<v8::Value>& info);
+
+        // get the direct implementation of a utility function if it takes and returns only numbers (or Variant-typed with a numeric overload)
+        static decltype(internal::FUtilityMethodInfo::number_func) get_number_utility_func(const StringName& p_name);
+
     };
 }
 #endif
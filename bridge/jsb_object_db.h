@@ -8,142 +8,158 @@
 namespace jsb
 {
 #if JSB_THREADING
-#   define JSB_OBJECT_DB_HANDLE(Type, Ptr) Type(&lock_, Ptr)
+#   define JSB_OBJECT_DB_LOCK (&lock_)
 #   define JSB_OBJECT_DB_STATEMENT(Statement) Statement
+#else
+#   define JSB_OBJECT_DB_LOCK nullptr
+#   define JSB_OBJECT_DB_STATEMENT(Statement) (void) 0
+#endif
 
-    struct ObjectHandlePtr
+    // scoped access to an object in ObjectDB (with the lock of ObjectDB held if JSB_THREADING)
+    template<typename THandle, bool TWrite>
+    struct TObjectHandlePtr
     {
-    private:
-        RWLock* lock_;
-        internal::SArray<ObjectHandle, NativeObjectID>::Pointer ptr_;
-
-    public:
-        ObjectHandlePtr(const ObjectHandlePtr& ) = delete;
-
-        ObjectHandlePtr(): lock_(nullptr) {}
-        ObjectHandlePtr(RWLock* p_lock, internal::SArray<ObjectHandle, NativeObjectID>::Pointer&& p_ptr)
-            : lock_(p_lock), ptr_(std::move(p_ptr))
-        {
-        }
-
-        ~ObjectHandlePtr()
-        {
-            if (lock_) lock_->write_unlock();
-        }
-
-        ObjectHandle* operator->() const { return ptr_.operator->(); }
-        explicit operator bool() const { return (bool) ptr_; }
-
-        ObjectHandlePtr& operator=(std::nullptr_t)
-        {
-            if (lock_) lock_->write_unlock();
-            lock_ = nullptr;
-            ptr_ = nullptr;
-            return *this;
-        }
+        typedef std::conditional_t<TWrite, RWLock*, const RWLock*> LockPtr;
 
-        ObjectHandlePtr(ObjectHandlePtr&& p_other) noexcept
-            : lock_(p_other.lock_), ptr_(std::move(p_other.ptr_))
-        {
-            p_other.lock_ = nullptr;
-        }
+    private:
+#if JSB_THREADING
+        LockPtr lock_ = nullptr;
+#endif
+        std::optional<THandle> handle_;
 
-        ObjectHandlePtr& operator=(ObjectHandlePtr&& p_other) noexcept
+        void release()
         {
-            if (this != &p_other)
+#if JSB_THREADING
+            if (lock_)
             {
-                if (lock_) lock_->write_unlock();
-                lock_ = p_other.lock_;
-                ptr_ = std::move(p_other.ptr_);
-                p_other.lock_ = nullptr;
+                if constexpr (TWrite) lock_->write_unlock();
+                else lock_->read_unlock();
+                lock_ = nullptr;
             }
-            return *this;
+#endif
+            handle_.reset();
         }
-    };
-
-    struct ObjectHandleConstPtr
-    {
-    private:
-        const RWLock* lock_;
-        internal::SArray<ObjectHandle, NativeObjectID>::ConstPointer ptr_;
 
     public:
-        ObjectHandleConstPtr(const ObjectHandleConstPtr& ) = delete;
+        TObjectHandlePtr(const TObjectHandlePtr& ) = delete;
+        TObjectHandlePtr& operator=(const TObjectHandlePtr& ) = delete;
 
-        ObjectHandleConstPtr(): lock_(nullptr) {}
-        ObjectHandleConstPtr(const RWLock* p_lock, internal::SArray<ObjectHandle, NativeObjectID>::ConstPointer&& p_ptr)
-            : lock_(p_lock), ptr_(std::move(p_ptr))
+        TObjectHandlePtr() = default;
+        TObjectHandlePtr(LockPtr p_lock, const THandle& p_handle)
+#if JSB_THREADING
+            : lock_(p_lock)
+#endif
         {
+            handle_.emplace(p_handle);
         }
 
-        ~ObjectHandleConstPtr()
-        {
-            if (lock_) lock_->read_unlock();
-        }
+        ~TObjectHandlePtr() { release(); }
+
+        const THandle* operator->() const { return &*handle_; }
+        explicit operator bool() const { return handle_.has_value(); }
 
-        const ObjectHandle* operator->() const { return ptr_.operator->(); }
-        explicit operator bool() const { return (bool) ptr_; }
-        ObjectHandleConstPtr& operator=(std::nullptr_t)
+        TObjectHandlePtr& operator=(std::nullptr_t)
         {
-            if (lock_) lock_->read_unlock();
-            lock_ = nullptr;
-            ptr_ = nullptr;
+            release();
             return *this;
         }
 
-        ObjectHandleConstPtr(ObjectHandleConstPtr&& p_other) noexcept
-            : lock_(p_other.lock_), ptr_(std::move(p_other.ptr_))
-        {
-            p_other.lock_ = nullptr;
-        }
+        TObjectHandlePtr(TObjectHandlePtr&& p_other) noexcept { *this = std::move(p_other); }
 
-        ObjectHandleConstPtr& operator=(ObjectHandleConstPtr&& p_other) noexcept
+        TObjectHandlePtr& operator=(TObjectHandlePtr&& p_other) noexcept
         {
             if (this != &p_other)
             {
-                if (lock_) lock_->read_unlock();
+                release();
+#if JSB_THREADING
                 lock_ = p_other.lock_;
-                ptr_ = std::move(p_other.ptr_);
                 p_other.lock_ = nullptr;
+#endif
+                if (p_other.handle_) handle_.emplace(*p_other.handle_);
+                p_other.handle_.reset();
             }
             return *this;
         }
     };
-#else
-#   define JSB_OBJECT_DB_HANDLE(Type, Ptr) (sizeof(Type), Ptr)
-#   define JSB_OBJECT_DB_STATEMENT(Statement) (void) 0
 
-    typedef internal::SArray<ObjectHandle, NativeObjectID>::Pointer ObjectHandlePtr;
-    typedef internal::SArray<ObjectHandle, NativeObjectID>::ConstPointer ObjectHandleConstPtr;
-#endif
+    typedef TObjectHandlePtr<ObjectHandle, true> ObjectHandlePtr;
+    typedef TObjectHandlePtr<ObjectHandleConst, false> ObjectHandleConstPtr;
 
+    /**
+     * The registry of all bound objects (structure of arrays).
+     * The fields of objects are stored in separate dense arrays indexed by the slot of NativeObjectID,
+     * the hot paths (like `reference_object` and `find_object_class`) only touch the arrays they really read.
+     */
     class ObjectDB
     {
     private:
         // cpp objects should be added here since the gc callback is not guaranteed by v8
         // we need to delete them on finally releasing Environment
-        internal::SArray<ObjectHandle, NativeObjectID> objects_;
+        LocalVector<void*> pointers_;               // nullptr if the slot is free
+        LocalVector<NativeClassID> class_ids_;
+        LocalVector<uint32_t> ref_counts_;
+        LocalVector<v8::Global<v8::Object>> refs_;
+        LocalVector<NativeObjectID::RevisionType> revisions_;
 
-        // (unsafe) mapping object pointer to object_id
-        HashMap<void*, NativeObjectID> objects_index_;
+        LocalVector<int32_t> free_slots_;
+        int size_ = 0;
+        int peak_size_ = 0;
+
+        // no used slot below it (a hint for iterating in `try_get_first_pointer`)
+        mutable int32_t first_slot_hint_ = 0;
+
+        // (unsafe) mapping object pointer to the slot index
+        internal::PointerMap<int32_t> objects_index_;
 
 #if JSB_THREADING
         RWLock lock_;
 #endif
 
+        jsb_force_inline bool is_valid_id(const NativeObjectID& p_object_id) const
+        {
+            const int32_t slot = p_object_id.get_index();
+            return slot >= 0 && slot < (int32_t) pointers_.size() && p_object_id.get_revision() != 0
+                && revisions_[slot] == p_object_id.get_revision() && pointers_[slot];
+        }
+
+        jsb_force_inline ObjectHandle get_handle(int32_t p_slot)
+        {
+            return { class_ids_[p_slot], ref_counts_[p_slot], pointers_[p_slot], refs_[p_slot] };
+        }
+
+        jsb_force_inline ObjectHandleConst get_handle(int32_t p_slot) const
+        {
+            return { class_ids_[p_slot], ref_counts_[p_slot], pointers_[p_slot], refs_[p_slot] };
+        }
+
     public:
+        // the memory footprint of an object slot (approximately, including the index)
+        static constexpr size_t get_slot_size()
+        {
+            return sizeof(void*) + sizeof(NativeClassID) + sizeof(uint32_t) + sizeof(v8::Global<v8::Object>) + sizeof(NativeObjectID::RevisionType)
+                + (sizeof(void*) + sizeof(int32_t)) * 2;
+        }
+
         ObjectDB(int p_capacity)
         {
-            objects_.reserve(p_capacity);
+            pointers_.reserve(p_capacity);
+            class_ids_.reserve(p_capacity);
+            ref_counts_.reserve(p_capacity);
+            refs_.reserve(p_capacity);
+            revisions_.reserve(p_capacity);
+            objects_index_.reserve(p_capacity);
         }
 
         ~ObjectDB()
         {
-            jsb_check(objects_.size() == 0);
+            jsb_check(size_ == 0);
             jsb_check(objects_index_.size() == 0);
         }
 
-        jsb_force_inline int size() const { return objects_.size(); }
+        jsb_force_inline int size() const { return size_; }
+
+        // the max number of objects registered at the same time
+        jsb_force_inline int get_peak_size() const { return peak_size_; }
 
         jsb_force_inline bool has_object(void* p_pointer) const
         {
@@ -154,20 +170,33 @@ namespace jsb
         jsb_force_inline bool has_object(const NativeObjectID& p_object_id) const
         {
             JSB_OBJECT_DB_STATEMENT(RWLockRead lock(lock_));
-            return objects_.is_valid_index(p_object_id);
+            return is_valid_id(p_object_id);
+        }
+
+        // call `p_func(const ObjectHandleConst&)` for each registered object (the registry must not be modified in it)
+        template<typename F>
+        void for_each_object(F&& p_func) const
+        {
+            JSB_OBJECT_DB_STATEMENT(RWLockRead lock(lock_));
+            for (int32_t slot = 0, n = (int32_t) pointers_.size(); slot < n; ++slot)
+            {
+                if (pointers_[slot]) p_func(get_handle(slot));
+            }
         }
 
         jsb_force_inline void* try_get_first_pointer() const
         {
             JSB_OBJECT_DB_STATEMENT(RWLockRead lock(lock_));
-            return objects_index_.size() ? objects_index_.begin()->key : nullptr;
+            if (size_ == 0) return nullptr;
+            while (!pointers_[first_slot_hint_]) ++first_slot_hint_;
+            return pointers_[first_slot_hint_];
         }
 
         jsb_force_inline NativeObjectID try_get_object_id(void* p_pointer) const
         {
             JSB_OBJECT_DB_STATEMENT(RWLockRead lock(lock_));
-            const NativeObjectID* it = objects_index_.getptr(p_pointer);
-            return it ? *it : NativeObjectID();
+            const int32_t* slot = objects_index_.getptr(p_pointer);
+            return slot ? NativeObjectID(*slot, revisions_[*slot]) : NativeObjectID();
         }
 
         // whether the `p_pointer` registered in the object binding map
@@ -176,8 +205,8 @@ namespace jsb
         {
             JSB_OBJECT_DB_STATEMENT(lock_.read_lock());
 
-            const NativeObjectID* entry = objects_index_.getptr(p_pointer);
-            if (entry) return JSB_OBJECT_DB_HANDLE(ObjectHandleConstPtr, objects_.get_value_scoped(*entry));
+            const int32_t* slot = objects_index_.getptr(p_pointer);
+            if (slot) return ObjectHandleConstPtr(JSB_OBJECT_DB_LOCK, get_handle(*slot));
 
             JSB_OBJECT_DB_STATEMENT(lock_.read_unlock());
             return ObjectHandleConstPtr();
@@ -188,8 +217,8 @@ namespace jsb
         {
             JSB_OBJECT_DB_STATEMENT(lock_.write_lock());
 
-            const NativeObjectID* entry = objects_index_.getptr(p_pointer);
-            if (entry) return JSB_OBJECT_DB_HANDLE(ObjectHandlePtr, objects_.get_value_scoped(*entry));
+            const int32_t* slot = objects_index_.getptr(p_pointer);
+            if (slot) return ObjectHandlePtr(JSB_OBJECT_DB_LOCK, get_handle(*slot));
 
             JSB_OBJECT_DB_STATEMENT(lock_.write_unlock());
             return ObjectHandlePtr();
@@ -198,41 +227,84 @@ namespace jsb
         jsb_force_inline ObjectHandleConstPtr try_get_object(const NativeObjectID& p_object_id) const
         {
             JSB_OBJECT_DB_STATEMENT(lock_.read_lock());
-            return JSB_OBJECT_DB_HANDLE(ObjectHandleConstPtr, objects_.try_get_value_scoped(p_object_id));
+            if (is_valid_id(p_object_id)) return ObjectHandleConstPtr(JSB_OBJECT_DB_LOCK, get_handle(p_object_id.get_index()));
+
+            JSB_OBJECT_DB_STATEMENT(lock_.read_unlock());
+            return ObjectHandleConstPtr();
         }
 
         // will crash if the object is not registered in the object binding map
         jsb_force_inline ObjectHandleConstPtr get_object(const NativeObjectID& p_object_id) const
         {
             JSB_OBJECT_DB_STATEMENT(lock_.read_lock());
-            return JSB_OBJECT_DB_HANDLE(ObjectHandleConstPtr, objects_.get_value_scoped(p_object_id));
+            jsb_check(is_valid_id(p_object_id));
+            return ObjectHandleConstPtr(JSB_OBJECT_DB_LOCK, get_handle(p_object_id.get_index()));
         }
 
         // [MUTABLE]
         NativeObjectID add_object(void* p_pointer, ObjectHandlePtr* o_handle)
         {
             JSB_OBJECT_DB_STATEMENT(lock_.write_lock());
-            jsb_checkf(!objects_index_.has(p_pointer), "duplicated bindings");
-            const NativeObjectID object_id = objects_.add({});
-            objects_index_.insert(p_pointer, object_id);
-
-            if (o_handle) *o_handle = JSB_OBJECT_DB_HANDLE(ObjectHandlePtr, objects_.get_value_scoped(object_id));
+            jsb_checkf(p_pointer && !objects_index_.has(p_pointer), "duplicated bindings");
+            int32_t slot;
+            if (!free_slots_.is_empty())
+            {
+                slot = free_slots_[free_slots_.size() - 1];
+                free_slots_.remove_at(free_slots_.size() - 1);
+            }
+            else
+            {
+                slot = (int32_t) pointers_.size();
+                pointers_.push_back(nullptr);
+                class_ids_.push_back({});
+                ref_counts_.push_back(0);
+                refs_.resize(slot + 1);
+                revisions_.push_back(0);
+            }
+            jsb_check(!pointers_[slot] && ref_counts_[slot] == 0 && refs_[slot].IsEmpty());
+            pointers_[slot] = p_pointer;
+            class_ids_[slot] = {};
+            NativeObjectID::increase_revision(revisions_[slot]);
+            first_slot_hint_ = MIN(first_slot_hint_, slot);
+            peak_size_ = MAX(peak_size_, ++size_);
+            objects_index_.insert(p_pointer, slot);
+
+            const NativeObjectID object_id(slot, revisions_[slot]);
+            if (o_handle) *o_handle = ObjectHandlePtr(JSB_OBJECT_DB_LOCK, get_handle(slot));
             else JSB_OBJECT_DB_STATEMENT(lock_.write_unlock());
             return object_id;
         }
 
-        // [MUTABLE]
-        void remove_object(void* p_pointer)
+        /**
+         * [MUTABLE] unregister an object with only one lookup (and one lock held if JSB_THREADING).
+         * The JS object reference is moved out to `r_ref` instead of being reset, it's up to the caller to decide when to release it.
+         * \return false if `p_pointer` is not registered
+         */
+        bool try_remove_object(void* p_pointer, NativeClassID& r_class_id, uint32_t& r_ref_count, v8::Global<v8::Object>& r_ref)
         {
             JSB_OBJECT_DB_STATEMENT(lock_.write_lock());
-            const NativeObjectID* entry = objects_index_.getptr(p_pointer);
-            jsb_check(entry);
-            objects_.remove_at_checked(*entry);
+            const int32_t* entry = objects_index_.getptr(p_pointer);
+            if (!entry)
+            {
+                JSB_OBJECT_DB_STATEMENT(lock_.write_unlock());
+                return false;
+            }
+            const int32_t slot = *entry;
             objects_index_.erase(p_pointer);
+
+            // invalidate the ids of the removed object
+            NativeObjectID::increase_revision(revisions_[slot]);
+            r_class_id = class_ids_[slot];
+            r_ref_count = ref_counts_[slot];
+            r_ref = std::move(refs_[slot]);
+            pointers_[slot] = nullptr;
+            ref_counts_[slot] = 0;
+            free_slots_.push_back(slot);
+            --size_;
             JSB_OBJECT_DB_STATEMENT(lock_.write_unlock());
+            return true;
         }
     };
 }
 
 #endif
-
@@ -16,22 +16,29 @@ namespace jsb
 
     // godot Object classes or c++ native wrapped classes are registered in an object registry in Environment.
     // godot Variant (valuetype) DO NOT have it's ObjectHandle.
+    // NOTE the fields are stored in separate arrays of ObjectDB, an ObjectHandle is only a view of them (valid until the object registry changed).
     struct ObjectHandle
     {
-        NativeClassID class_id;
+        NativeClassID& class_id;
 
-        uint32_t ref_count_;
+        uint32_t& ref_count_;
 
-#if JSB_DEBUG
         // The raw pointer to the native object.
         // It must be a unique pointer which implies that different objects have different addresses.
-        //NOTE it's useless at runtime now. we hold it here to validate the object binding for debugging only.
-        void* pointer;
-#endif
+        void* const pointer;
 
         // this reference is initially weak and hooked on v8 gc callback.
         // it becomes a strong reference after the `ref_count_` explicitly increased.
-        v8::Global<v8::Object> ref_;
+        v8::Global<v8::Object>& ref_;
+    };
+
+    // the read-only view of an object registered in ObjectDB
+    struct ObjectHandleConst
+    {
+        const NativeClassID& class_id;
+        const uint32_t& ref_count_;
+        void* const pointer;
+        const v8::Global<v8::Object>& ref_;
     };
 
 }
@@ -1,11 +1,12 @@
 #include "jsb_primitive_bindings_reflect.h"
-#if !JSB_WITH_STATIC_BINDINGS
+#include "jsb_primitive_bindings_static.h"
 #include "jsb_reflect_binding_util.h"
 #include "jsb_class_register.h"
 #include "jsb_class_info.h"
 #include "jsb_transpiler.h"
 #include "jsb_bridge_helper.h"
 #include "jsb_type_convert.h"
+#include "jsb_shared_variant_info.h"
 #include "../internal/jsb_variant_info.h"
 #include "../internal/jsb_variant_util.h"
 
@@ -37,7 +38,10 @@
 #define JSB_DEFINE_FAST_CONSTRUCTOR(ForCppType, ClassID, ClassName) (void) 0
 #endif
 
-#define JSB_DEFINE_OVERLOADED_BINARY_BEGIN(op_code) JSB_DEFINE_OPERATOR2(op_code)
+// arithmetic operators also have an instance method version which writes the result into an existing value (e.g. `a.add_into(b, out)`)
+#define JSB_DEFINE_OVERLOADED_BINARY_BEGIN(op_code) JSB_DEFINE_OPERATOR2(op_code)\
+    class_builder.Instance().\
+    Method(internal::NamingUtil::get_member_name(String(JSB_OPERATOR_NAME(op_code)).to_lower() + "_into"), IntoOperator::invoke, (int32_t) Variant::OP_##op_code);
 #define JSB_DEFINE_OVERLOADED_BINARY_END()
 
 #define JSB_DEFINE_BINARY_OVERLOAD(R, A, B)
@@ -59,6 +63,16 @@
 
 namespace jsb
 {
+    // read the operand in place if it's a wrapped Variant, otherwise convert it into `r_storage`
+    jsb_force_inline static const Variant* get_operand(v8::Isolate* isolate, const v8::Local<v8::Context>& context, const v8::Local<v8::Value>& p_value, Variant& r_storage)
+    {
+        if (p_value->IsObject() && TypeConvert::is_variant(p_value.As<v8::Object>()))
+        {
+            return (const Variant*) p_value.As<v8::Object>()->GetAlignedPointerFromInternalField(IF_Pointer);
+        }
+        return TypeConvert::js_to_gd_var(isolate, context, p_value, r_storage) ? &r_storage : nullptr;
+    }
+
     struct BinaryOperator
     {
         static void invoke(const v8::FunctionCallbackInfo<v8::Value>& info)
@@ -71,14 +85,16 @@ namespace jsb
                 jsb_throw(isolate, "bad param");
                 return;
             }
-            Variant left, right;
-            if (!TypeConvert::js_to_gd_var(isolate, context, info[0], left) || !TypeConvert::js_to_gd_var(isolate, context, info[1], right))
+            Variant left_storage, right_storage;
+            const Variant* left = get_operand(isolate, context, info[0], left_storage);
+            const Variant* right = left ? get_operand(isolate, context, info[1], right_storage) : nullptr;
+            if (!right)
             {
                 jsb_throw(isolate, "bad translation");
                 return;
             }
-            const Variant::Type left_type = left.get_type();
-            const Variant::Type right_type = right.get_type();
+            const Variant::Type left_type = left->get_type();
+            const Variant::Type right_type = right->get_type();
             const Variant::ValidatedOperatorEvaluator func = Variant::get_validated_operator_evaluator(op, left_type, right_type);
             if (!func)
             {
@@ -88,7 +104,7 @@ namespace jsb
             Variant ret;
             const Variant::Type return_type = Variant::get_operator_return_type(op, left_type, right_type);
             internal::VariantUtil::construct_variant(ret, return_type);
-            func(&left, &right, &ret);
+            func(left, right, &ret);
             if (ret.get_type() != return_type)
             {
                 jsb_throw(isolate, "bad return");
@@ -105,6 +121,44 @@ namespace jsb
         }
     };
 
+    // [js] this.<op>_into(right, out): out
+    // evaluate `this <op> right` directly into the storage of `out`, no result wrapper is allocated
+    struct IntoOperator
+    {
+        static void invoke(const v8::FunctionCallbackInfo<v8::Value>& info)
+        {
+            v8::Isolate* isolate = info.GetIsolate();
+            v8::Local<v8::Context> context = isolate->GetCurrentContext();
+            const Variant::Operator op = (Variant::Operator) info.Data().As<v8::Int32>()->Value();
+            if (info.Length() != 2 || !info[1]->IsObject() || !TypeConvert::is_variant(info[1].As<v8::Object>()))
+            {
+                jsb_throw(isolate, "bad param");
+                return;
+            }
+            const Variant* left = (const Variant*) info.This()->GetAlignedPointerFromInternalField(IF_Pointer);
+            Variant right_storage;
+            const Variant* right = get_operand(isolate, context, info[0], right_storage);
+            if (!right)
+            {
+                jsb_throw(isolate, "bad translation");
+                return;
+            }
+            Variant* out = (Variant*) info[1].As<v8::Object>()->GetAlignedPointerFromInternalField(IF_Pointer);
+            const Variant::Type left_type = left->get_type();
+            const Variant::Type right_type = right->get_type();
+            const Variant::ValidatedOperatorEvaluator func = Variant::get_validated_operator_evaluator(op, left_type, right_type);
+            if (!func || Variant::get_operator_return_type(op, left_type, right_type) != out->get_type())
+            {
+                jsb_throw(isolate, "bad type (no operator)");
+                return;
+            }
+
+            // for math types, the result is computed before being assigned, `out` can be `this` or `right`
+            func(left, right, out);
+            info.GetReturnValue().Set(info[1]);
+        }
+    };
+
     struct UnaryOperator
     {
         static void invoke(const v8::FunctionCallbackInfo<v8::Value>& info)
@@ -152,6 +206,118 @@ namespace jsb
         }
     };
 
+    namespace
+    {
+        // compare the indices of the elements (converted to JS in `values`), it stops calling into JS once an exception is thrown
+        struct JSIndexComparator
+        {
+            v8::Isolate* isolate = nullptr;
+            v8::Local<v8::Context> context;
+            v8::Local<v8::Function> func;
+            v8::Local<v8::Array> values;
+            mutable bool failed = false;
+
+            bool operator()(int32_t p_a, int32_t p_b) const
+            {
+                if (failed) return false;
+
+                v8::HandleScope handle_scope(isolate);
+                v8::Local<v8::Value> argv[2];
+                v8::Local<v8::Value> rval;
+                if (!values->Get(context, p_a).ToLocal(&argv[0])
+                    || !values->Get(context, p_b).ToLocal(&argv[1])
+                    || !func->Call(context, v8::Undefined(isolate), ::std::size(argv), argv).ToLocal(&rval))
+                {
+                    failed = true;
+                    return false;
+                }
+                return rval->BooleanValue(isolate);
+            }
+        };
+    }
+
+    void ReflectAdditionalMethodRegister<Array>::_sort_custom(const v8::FunctionCallbackInfo<v8::Value>& info)
+    {
+        v8::Isolate* isolate = info.GetIsolate();
+        const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+        const v8::Local<v8::Object> self = info.This();
+        if (!TypeConvert::is_variant(self))
+        {
+            jsb_throw(isolate, "bad this");
+            return;
+        }
+        Variant* p_var = (Variant*) self->GetAlignedPointerFromInternalField(IF_Pointer);
+        if (p_var->get_type() != Variant::ARRAY)
+        {
+            jsb_throw(isolate, "bad this");
+            return;
+        }
+        Array* array = VariantInternal::get_array(p_var);
+
+        // a Callable from godot, nothing to save
+        if (!info[0]->IsFunction())
+        {
+            Variant callable;
+            if (!TypeConvert::js_to_gd_var(isolate, context, info[0], Variant::CALLABLE, callable))
+            {
+                jsb_throw(isolate, "bad argument: 0");
+                return;
+            }
+            array->sort_custom(callable);
+            return;
+        }
+
+        const int32_t size = (int32_t) array->size();
+        if (size < 2) return;
+        if (array->is_read_only())
+        {
+            jsb_throw(isolate, "array is in read-only state");
+            return;
+        }
+
+        JSIndexComparator comparator;
+        comparator.isolate = isolate;
+        comparator.context = context;
+        comparator.func = info[0].As<v8::Function>();
+        comparator.values = v8::Array::New(isolate, size);
+        LocalVector<int32_t> indices;
+        indices.resize(size);
+        for (int32_t index = 0; index < size; ++index)
+        {
+            v8::Local<v8::Value> value;
+            if (!TypeConvert::gd_var_to_js(isolate, context, array->get(index), value))
+            {
+                jsb_throw(isolate, "bad translation");
+                return;
+            }
+            comparator.values->Set(context, index, value).Check();
+            indices[index] = index;
+        }
+
+        SortArray<int32_t, JSIndexComparator, true> sorter;
+        sorter.compare = comparator;
+        sorter.sort(indices.ptr(), size);
+
+        // the exception is left to be thrown to the caller
+        if (sorter.compare.failed) return;
+        if (array->size() != size)
+        {
+            jsb_throw(isolate, "array is modified while sorting");
+            return;
+        }
+
+        LocalVector<Variant> elements;
+        elements.resize(size);
+        for (int32_t index = 0; index < size; ++index)
+        {
+            elements[index] = array->get(indices[index]);
+        }
+        for (int32_t index = 0; index < size; ++index)
+        {
+            array->set(index, elements[index]);
+        }
+    }
+
     template<typename TypeName>
     struct OperatorRegister
     {
@@ -177,33 +343,50 @@ namespace jsb
             const v8::Local<v8::Object> self = info.This();
             jsb_quickjs_check(self->IsObject());
             Environment* env = Environment::wrap(isolate);
-            const internal::FConstructorInfo& constructor_info = GetVariantInfoCollection(env).constructors[info.Data().As<v8::Uint32>()->Value()];
+            const internal::FConstructorInfo& constructor_info = SharedVariantInfo::get().collection.constructors[info.Data().As<v8::Uint32>()->Value()];
 
             const int argc = info.Length();
+            if (argc >= constructor_info.arities.size())
+            {
+                jsb_throw(isolate, "no suitable constructor");
+                return;
+            }
 
-            const int constructor_count = (int) constructor_info.variants.size();
-            for (int constructor_index = 0; constructor_index < constructor_count; ++constructor_index)
+            // only the overloads with the same arity are candidates, and the all-number case is selected directly
+            const internal::FConstructorArityInfo& arity_info = constructor_info.arities[argc];
+            int number_variant = arity_info.number_variant;
+            for (int argument_index = 0; number_variant >= 0 && argument_index < argc; ++argument_index)
             {
-                const internal::FConstructorVariantInfo& constructor_variant = constructor_info.variants[constructor_index];
-                if (constructor_variant.argument_types.size() != argc) continue;
-                bool argument_type_match = true;
-                for (int argument_index = 0; argument_index < argc; ++argument_index)
+                if (!info[argument_index]->IsNumber()) number_variant = -1;
+            }
+
+            const int candidate_count = number_variant >= 0 ? 1 : (int) arity_info.variants.size();
+            for (int candidate_index = 0; candidate_index < candidate_count; ++candidate_index)
+            {
+                const internal::FConstructorVariantInfo& constructor_variant = constructor_info.variants[number_variant >= 0 ? number_variant : arity_info.variants[candidate_index]];
+                jsb_check(constructor_variant.argument_types.size() == argc);
+                if (number_variant < 0)
                 {
-                    const Variant::Type argument_type = constructor_variant.argument_types[argument_index];
-                    if (!TypeConvert::can_convert_strict(isolate, context, info[argument_index], argument_type))
+                    bool argument_type_match = true;
+                    for (int argument_index = 0; argument_index < argc; ++argument_index)
                     {
-                        argument_type_match = false;
-                        break;
+                        const Variant::Type argument_type = constructor_variant.argument_types[argument_index];
+                        if (!TypeConvert::can_convert_strict(isolate, context, info[argument_index], argument_type))
+                        {
+                            argument_type_match = false;
+                            break;
+                        }
                     }
-                }
 
-                if (!argument_type_match)
-                {
-                    continue;
+                    if (!argument_type_match)
+                    {
+                        continue;
+                    }
                 }
 
-                const Variant** argv = jsb_stackalloc(const Variant*, argc);
-                Variant* args = jsb_stackalloc(Variant, argc);
+                internal::ScratchArena::Scope scratch;
+                const Variant** argv = scratch.alloc<const Variant*>(argc);
+                Variant* args = scratch.alloc<Variant>(argc);
                 for (int argument_index = 0; argument_index < argc; ++argument_index)
                 {
                     memnew_placement(&args[argument_index], Variant);
@@ -252,6 +435,58 @@ namespace jsb
         }
     };
 
+    // construct `T` directly from `sizeof...(I)` number arguments (no overload resolution, no argument Variants),
+    // return false if the arguments don't match
+    template<typename T, typename TComponent, size_t... I>
+    jsb_force_inline static bool construct_from_numbers(const v8::FunctionCallbackInfo<v8::Value>& info, std::index_sequence<I...>)
+    {
+        if (info.Length() != (int) sizeof...(I) || !info.IsConstructCall()) return false;
+        if (!(info[(int) I]->IsNumber() && ...)) return false;
+        Environment::wrap(info.GetIsolate())->bind_valuetype_copy(T((TComponent) info[(int) I].As<v8::Number>()->Value()...), info.This());
+        return true;
+    }
+
+    template<>
+    struct VariantConstructor<Vector2>
+    {
+        static void constructor(const v8::FunctionCallbackInfo<v8::Value>& info)
+        {
+            if (construct_from_numbers<Vector2, real_t>(info, std::make_index_sequence<2>())) return;
+            VariantBindFallbacks::constructor(info);
+        }
+    };
+
+    template<>
+    struct VariantConstructor<Vector3>
+    {
+        static void constructor(const v8::FunctionCallbackInfo<v8::Value>& info)
+        {
+            if (construct_from_numbers<Vector3, real_t>(info, std::make_index_sequence<3>())) return;
+            VariantBindFallbacks::constructor(info);
+        }
+    };
+
+    template<>
+    struct VariantConstructor<Vector4>
+    {
+        static void constructor(const v8::FunctionCallbackInfo<v8::Value>& info)
+        {
+            if (construct_from_numbers<Vector4, real_t>(info, std::make_index_sequence<4>())) return;
+            VariantBindFallbacks::constructor(info);
+        }
+    };
+
+    template<>
+    struct VariantConstructor<Color>
+    {
+        static void constructor(const v8::FunctionCallbackInfo<v8::Value>& info)
+        {
+            if (construct_from_numbers<Color, float>(info, std::make_index_sequence<4>())
+                || construct_from_numbers<Color, float>(info, std::make_index_sequence<3>())) return;
+            VariantBindFallbacks::constructor(info);
+        }
+    };
+
     template<typename T>
     struct VariantBind
     {
@@ -290,7 +525,7 @@ namespace jsb
             const v8::Local<v8::Context> context = isolate->GetCurrentContext();
             jsb_check(TypeConvert::is_variant(info.This()));
             const Variant* p_self = (Variant*)info.This()->GetAlignedPointerFromInternalField(IF_Pointer);
-            const internal::FGetSetInfo& getset = GetVariantInfoCollection(Environment::wrap(context)).getsets[info.Data().As<v8::Int32>()->Value()];
+            const internal::FGetSetInfo& getset = SharedVariantInfo::get().collection.getsets[info.Data().As<v8::Int32>()->Value()];
 
             Variant value;
             internal::VariantUtil::construct_variant(value, getset.type);
@@ -312,7 +547,7 @@ namespace jsb
             const v8::Local<v8::Context> context = isolate->GetCurrentContext();
             jsb_check(TypeConvert::is_variant(info.This()));
             Variant* p_self = (Variant*) info.This()->GetAlignedPointerFromInternalField(IF_Pointer);
-            const internal::FGetSetInfo& getset = GetVariantInfoCollection(Environment::wrap(context)).getsets[info.Data().As<v8::Int32>()->Value()];
+            const internal::FGetSetInfo& getset = SharedVariantInfo::get().collection.getsets[info.Data().As<v8::Int32>()->Value()];
 
             Variant value;
             if (!TypeConvert::js_to_gd_var(isolate, context, info[0], getset.type, value))
@@ -461,8 +696,9 @@ namespace jsb
             // prepare argv
             const int known_argc = (int) method_info.argument_types.size();
             const int allocated_argc = MAX(known_argc, argc);
-            const Variant** argv = jsb_stackalloc(const Variant*, allocated_argc);
-            Variant* args = jsb_stackalloc(Variant, allocated_argc);
+            internal::ScratchArena::Scope scratch;
+            const Variant** argv = scratch.alloc<const Variant*>(allocated_argc);
+            Variant* args = scratch.alloc<Variant>(allocated_argc);
             for (int index = 0; index < allocated_argc; ++index)
             {
                 memnew_placement(&args[index], Variant);
@@ -541,7 +777,8 @@ namespace jsb
         {
             v8::Isolate* isolate = info.GetIsolate();
             const v8::Local<v8::Context> context = isolate->GetCurrentContext();
-            const internal::FBuiltinMethodInfo& method_info = GetVariantInfoCollection(Environment::wrap(context)).methods[info.Data().As<v8::Int32>()->Value()];
+            const internal::FBuiltinMethodInfo& method_info = SharedVariantInfo::get().collection.methods[info.Data().As<v8::Int32>()->Value()];
+            JSB_COUNT_BINDING(Environment::wrap(isolate), KIND_BUILTIN_METHOD, info.Data().As<v8::Int32>()->Value());
             Variant* self = TypeConvert::is_variant(info.This())
                 ? (Variant*) info.This()->GetAlignedPointerFromInternalField(IF_Pointer)
                 : nullptr;
@@ -559,7 +796,8 @@ namespace jsb
         {
             v8::Isolate* isolate = info.GetIsolate();
             v8::Local<v8::Context> context = isolate->GetCurrentContext();
-            const internal::FBuiltinMethodInfo& method_info = GetVariantInfoCollection(Environment::wrap(context)).methods[info.Data().As<v8::Int32>()->Value()];
+            const internal::FBuiltinMethodInfo& method_info = SharedVariantInfo::get().collection.methods[info.Data().As<v8::Int32>()->Value()];
+            JSB_COUNT_BINDING(Environment::wrap(isolate), KIND_BUILTIN_METHOD, info.Data().As<v8::Int32>()->Value());
 
             call_builtin_function<HasReturnValueT>(nullptr, method_info, info, isolate, context);
         }
@@ -576,7 +814,8 @@ namespace jsb
             }
 
             const v8::Local<v8::Context> context = isolate->GetCurrentContext();
-            const internal::FBuiltinMethodInfo& method_info = GetVariantInfoCollection(Environment::wrap(context)).methods[info.Data().As<v8::Int32>()->Value()];
+            const internal::FBuiltinMethodInfo& method_info = SharedVariantInfo::get().collection.methods[info.Data().As<v8::Int32>()->Value()];
+            JSB_COUNT_BINDING(Environment::wrap(isolate), KIND_BUILTIN_METHOD, info.Data().As<v8::Int32>()->Value());
 
             Variant variant;
             if (!TypeConvert::js_to_gd_var(isolate, context, info[0], VariantT, variant))
@@ -601,26 +840,7 @@ namespace jsb
 
             // fallback
             {
-                const uint32_t constructor_index = (uint32_t) GetVariantInfoCollection(p_env.env).constructors.size();
-                GetVariantInfoCollection(p_env.env).constructors.append({});
-                internal::FConstructorInfo& constructor_info = GetVariantInfoCollection(p_env.env).constructors.write[constructor_index];
-                const int count = Variant::get_constructor_count(TYPE);
-#if GODOT_4_5_OR_NEWER
-                constructor_info.variants.resize_initialized(count);
-#else
-                constructor_info.variants.resize_zeroed(count);
-#endif
-                for (int index = 0; index < count; ++index)
-                {
-                    internal::FConstructorVariantInfo& variant_info = constructor_info.variants.write[index];
-                    variant_info.ctor_func = Variant::get_validated_constructor(TYPE, index);
-                    const int arg_count = Variant::get_constructor_argument_count(TYPE, index);
-                    variant_info.argument_types.resize(arg_count);
-                    for (int arg_index = 0; arg_index < arg_count; ++arg_index)
-                    {
-                        variant_info.argument_types.write[arg_index] = Variant::get_constructor_argument_type(TYPE, index, arg_index);
-                    }
-                }
+                const uint32_t constructor_index = (uint32_t) SharedVariantInfo::get().get_constructor_index(TYPE);
                 return impl::ClassBuilder::New<IF_VariantFieldCount>(p_env.isolate,
                     p_class_name,
                     &VariantConstructor<T>::constructor,
@@ -653,11 +873,8 @@ namespace jsb
                     JSB_DEFINE_FAST_GETSET(member_type, int32_t, name);
 
                     // fallback to reflection invocation
-                    const int collection_index = (int) GetVariantInfoCollection(p_env.env).getsets.size();
-                    GetVariantInfoCollection(p_env.env).getsets.append({
-                       Variant::get_member_validated_setter(TYPE, name),
-                       Variant::get_member_validated_getter(TYPE, name),
-                       member_type});
+                    const int collection_index = SharedVariantInfo::get().find_getset_index(TYPE, name);
+                    jsb_check(collection_index >= 0);
 
                     class_builder.Instance().Property(internal::NamingUtil::get_member_name(name), _getter, _setter, collection_index);
                 }
@@ -683,14 +900,27 @@ namespace jsb
                 Variant::get_builtin_method_list(TYPE, &methods);
                 for (const StringName& name : methods)
                 {
-                    const int argument_count = Variant::get_builtin_method_argument_count(TYPE, name);
+                    if (ReflectAdditionalMethodRegister<T>::is_replaced(name)) continue;
+
                     const bool has_return_value = Variant::has_builtin_method_return_value(TYPE, name);
-                    const Variant::Type return_type = Variant::get_builtin_method_return_type(TYPE, name);
                     const String member_name = internal::NamingUtil::get_member_name(name);
 
+#if JSB_WITH_STATIC_BINDINGS
+                    // type-exact bindings take precedence over any reflection
+                    if (const StaticMethodBinding* binding = find_primitive_static_method(TYPE, name))
+                    {
+                        if (binding->is_static) class_builder.Static().Method(member_name, binding->callback);
+                        else class_builder.Instance().Method(member_name, binding->callback);
+                        continue;
+                    }
+#endif
+
 #if JSB_FAST_REFLECTION
                     if (!Variant::is_builtin_method_vararg(TYPE, name))
                     {
+                        const int argument_count = Variant::get_builtin_method_argument_count(TYPE, name);
+                        const Variant::Type return_type = Variant::get_builtin_method_return_type(TYPE, name);
+
                         //TODO hardcoded branches for fast method reflection wrapper
                         if (has_return_value)
                         {
@@ -814,25 +1044,9 @@ namespace jsb
                     }
 #endif
 
-                    // convert method info, and store
-                    const int collection_index = (int) GetVariantInfoCollection(p_env.env).methods.size();
-                    GetVariantInfoCollection(p_env.env).methods.append({});
-                    internal::FBuiltinMethodInfo& method_info = GetVariantInfoCollection(p_env.env).methods.write[collection_index];
-                    method_info.set_debug_name(member_name);
-                    method_info.builtin_func = Variant::get_validated_builtin_method(TYPE, name);
-                    method_info.return_type = return_type;
-                    method_info.default_arguments = Variant::get_builtin_method_default_arguments(TYPE, name);
-#if GODOT_4_5_OR_NEWER
-                    method_info.argument_types.resize_initialized(argument_count);
-#else
-                    method_info.argument_types.resize_zeroed(argument_count);
-#endif
-                    method_info.is_vararg = Variant::is_builtin_method_vararg(TYPE, name);
-                    for (int argument_index = 0; argument_index < argument_count; ++argument_index)
-                    {
-                        const Variant::Type type = Variant::get_builtin_method_argument_type(TYPE, name, argument_index);
-                        method_info.argument_types.write[argument_index] = type;
-                    }
+                    // the method info is shared by all environments
+                    const int collection_index = SharedVariantInfo::get().find_method_index(TYPE, name);
+                    jsb_check(collection_index >= 0);
 
                     // function wrapper
                     if (has_return_value)
@@ -947,9 +1161,7 @@ namespace jsb
 
                 for (const StringName& name : methods)
                 {
-                    const int argument_count = Variant::get_builtin_method_argument_count(TYPE, name);
                     const bool has_return_value = Variant::has_builtin_method_return_value(TYPE, name);
-                    const Variant::Type return_type = Variant::get_builtin_method_return_type(TYPE, name);
                     String member_name = internal::NamingUtil::get_member_name(name);
 
                     if (member_name == "length")
@@ -959,25 +1171,9 @@ namespace jsb
                         member_name = "length_";
                     }
 
-                    // convert method info, and store
-                    const int collection_index = (int) GetVariantInfoCollection(p_env.env).methods.size();
-                    GetVariantInfoCollection(p_env.env).methods.append({});
-                    internal::FBuiltinMethodInfo& method_info = GetVariantInfoCollection(p_env.env).methods.write[collection_index];
-                    method_info.set_debug_name(member_name);
-                    method_info.builtin_func = Variant::get_validated_builtin_method(TYPE, name);
-                    method_info.return_type = return_type;
-                    method_info.default_arguments = Variant::get_builtin_method_default_arguments(TYPE, name);
-#if GODOT_4_5_OR_NEWER
-                    method_info.argument_types.resize_initialized(argument_count);
-#else
-                    method_info.argument_types.resize_zeroed(argument_count);
-#endif
-                    method_info.is_vararg = Variant::is_builtin_method_vararg(TYPE, name);
-                    for (int argument_index = 0; argument_index < argument_count; ++argument_index)
-                    {
-                        const Variant::Type type = Variant::get_builtin_method_argument_type(TYPE, name, argument_index);
-                        method_info.argument_types.write[argument_index] = type;
-                    }
+                    // the method info is shared by all environments
+                    const int collection_index = SharedVariantInfo::get().find_method_index(TYPE, name);
+                    jsb_check(collection_index >= 0);
 
                     // function wrapper
                     if (has_return_value)
@@ -1061,5 +1257,3 @@ namespace jsb
     }
 }
 
-#endif
-
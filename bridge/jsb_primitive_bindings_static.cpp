@@ -1,4 +1,190 @@
-// AUTO-GENERATED
 #include "jsb_primitive_bindings_static.h"
 #if JSB_WITH_STATIC_BINDINGS
+#include <tuple>
+#include <utility>
+
+#include "jsb_reflect_binding_util.h"
+#include "jsb_type_convert.h"
+
+namespace jsb
+{
+    namespace
+    {
+        // read an argument of a statically bound method
+        template<typename T>
+        struct StaticArg
+        {
+            // primitive values are read by pointer if possible, or converted (e.g. from plain objects) otherwise
+            static bool get(v8::Isolate* isolate, const v8::Local<v8::Context>& context, const v8::Local<v8::Value>& p_input, T& r_value)
+            {
+                if (p_input->IsObject() && TypeConvert::is_variant(p_input.As<v8::Object>()))
+                {
+                    const Variant* var = (const Variant*) p_input.As<v8::Object>()->GetAlignedPointerFromInternalField(IF_Pointer);
+                    if (var->get_type() == GetTypeInfo<T>::VARIANT_TYPE)
+                    {
+                        r_value = *(const T*) VariantInternal::get_opaque_pointer(var);
+                        return true;
+                    }
+                }
+                return StaticBindingUtil<T>::get(isolate, context, p_input, r_value);
+            }
+        };
+
+        template<> struct StaticArg<float> : StaticBindingUtil<float> {};
+        template<> struct StaticArg<double> : StaticBindingUtil<double> {};
+        template<> struct StaticArg<int32_t> : StaticBindingUtil<int32_t> {};
+        template<> struct StaticArg<int64_t> : StaticBindingUtil<int64_t> {};
+
+        template<typename T>
+        struct StaticReturn
+        {
+            static bool set(v8::Isolate* isolate, const v8::Local<v8::Context>& context, const T& p_value, v8::Local<v8::Value>& r_value)
+            {
+                return TypeConvert::gd_var_to_js(isolate, context, Variant(p_value), r_value);
+            }
+        };
+
+        template<typename T>
+        struct StaticReturnNumber
+        {
+            static bool set(v8::Isolate* isolate, const v8::Local<v8::Context>& context, const T& p_value, v8::Local<v8::Value>& r_value)
+            {
+                r_value = v8::Number::New(isolate, (double) p_value);
+                return true;
+            }
+        };
+
+        template<> struct StaticReturn<float> : StaticReturnNumber<float> {};
+        template<> struct StaticReturn<double> : StaticReturnNumber<double> {};
+
+        template<>
+        struct StaticReturn<bool>
+        {
+            static bool set(v8::Isolate* isolate, const v8::Local<v8::Context>& context, const bool& p_value, v8::Local<v8::Value>& r_value)
+            {
+                r_value = v8::Boolean::New(isolate, p_value);
+                return true;
+            }
+        };
+
+        template<typename TFunc> struct MethodTraits;
+
+        template<typename TSelf, typename TReturn, typename... TArgs>
+        struct MethodTraits<TReturn (TSelf::*)(TArgs...) const>
+        {
+            typedef TSelf Self;
+            typedef TReturn Return;
+            typedef std::tuple<std::decay_t<TArgs>...> Args;
+        };
+
+        // call the C++ method directly on the Variant storage of `this`, without Variant boxing and argument vectors
+        template<auto Method>
+        struct StaticMethodCall
+        {
+            typedef MethodTraits<decltype(Method)> Traits;
+            typedef typename Traits::Self Self;
+            typedef typename Traits::Return Return;
+            typedef typename Traits::Args Args;
+            static constexpr size_t kArgc = std::tuple_size_v<Args>;
+
+            static void call(const v8::FunctionCallbackInfo<v8::Value>& info)
+            {
+                call_impl(info, std::make_index_sequence<kArgc>());
+            }
+
+        private:
+            template<size_t I>
+            static bool get_arg(v8::Isolate* isolate, const v8::Local<v8::Context>& context, const v8::FunctionCallbackInfo<v8::Value>& info, Args& r_args)
+            {
+                typedef std::tuple_element_t<I, Args> ArgType;
+                if (!StaticArg<ArgType>::get(isolate, context, info[(int) I], std::get<I>(r_args)))
+                {
+                    jsb_throw(isolate, jsb_format("bad param at %d", (int) I));
+                    return false;
+                }
+                return true;
+            }
+
+            template<size_t... I>
+            static void call_impl(const v8::FunctionCallbackInfo<v8::Value>& info, std::index_sequence<I...>)
+            {
+                v8::Isolate* isolate = info.GetIsolate();
+                const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+                if (info.Length() < (int) kArgc)
+                {
+                    jsb_throw(isolate, "num of arguments does not meet the requirement");
+                    return;
+                }
+
+                Args args;
+                if (!(get_arg<I>(isolate, context, info, args) && ...)) return;
+
+                const Self* self = (const Self*) TVariantOpaquePointer<Self>::from(info);
+                v8::Local<v8::Value> rval;
+                if (!StaticReturn<Return>::set(isolate, context, (self->*Method)(std::get<I>(args)...), rval))
+                {
+                    jsb_throw(isolate, "failed to translate return value");
+                    return;
+                }
+                info.GetReturnValue().Set(rval);
+            }
+        };
+
+#define JSB_STATIC_METHOD(Type, Name) { #Name, &StaticMethodCall<&Type::Name>::call, false }
+
+        // the most frequently used math methods, only methods without default arguments are listed
+        const StaticMethodBinding vector2_methods[] = {
+            JSB_STATIC_METHOD(Vector2, length),
+            JSB_STATIC_METHOD(Vector2, length_squared),
+            JSB_STATIC_METHOD(Vector2, normalized),
+            JSB_STATIC_METHOD(Vector2, is_normalized),
+            JSB_STATIC_METHOD(Vector2, angle),
+            JSB_STATIC_METHOD(Vector2, angle_to),
+            JSB_STATIC_METHOD(Vector2, dot),
+            JSB_STATIC_METHOD(Vector2, cross),
+            JSB_STATIC_METHOD(Vector2, distance_to),
+            JSB_STATIC_METHOD(Vector2, distance_squared_to),
+            JSB_STATIC_METHOD(Vector2, direction_to),
+            JSB_STATIC_METHOD(Vector2, rotated),
+            JSB_STATIC_METHOD(Vector2, lerp),
+            JSB_STATIC_METHOD(Vector2, slerp),
+            { nullptr, nullptr, false },
+        };
+
+        const StaticMethodBinding vector3_methods[] = {
+            JSB_STATIC_METHOD(Vector3, length),
+            JSB_STATIC_METHOD(Vector3, length_squared),
+            JSB_STATIC_METHOD(Vector3, normalized),
+            JSB_STATIC_METHOD(Vector3, is_normalized),
+            JSB_STATIC_METHOD(Vector3, angle_to),
+            JSB_STATIC_METHOD(Vector3, dot),
+            JSB_STATIC_METHOD(Vector3, cross),
+            JSB_STATIC_METHOD(Vector3, distance_to),
+            JSB_STATIC_METHOD(Vector3, distance_squared_to),
+            JSB_STATIC_METHOD(Vector3, direction_to),
+            JSB_STATIC_METHOD(Vector3, rotated),
+            JSB_STATIC_METHOD(Vector3, lerp),
+            JSB_STATIC_METHOD(Vector3, slerp),
+            { nullptr, nullptr, false },
+        };
+
+#undef JSB_STATIC_METHOD
+    }
+
+    const StaticMethodBinding* find_primitive_static_method(Variant::Type p_type, const StringName& p_name)
+    {
+        const StaticMethodBinding* it;
+        switch (p_type)
+        {
+        case Variant::VECTOR2: it = vector2_methods; break;
+        case Variant::VECTOR3: it = vector3_methods; break;
+        default: return nullptr;
+        }
+        for (; it->name; ++it)
+        {
+            if (p_name == it->name) return it;
+        }
+        return nullptr;
+    }
+}
 #endif // JSB_WITH_STATIC_BINDINGS
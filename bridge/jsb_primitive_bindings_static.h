@@ -5,9 +5,16 @@
 namespace jsb
 {
 #if JSB_WITH_STATIC_BINDINGS
-    class Environment;
+    // a type-exact binding which replaces the reflected builtin method with the same name
+    struct StaticMethodBinding
+    {
+        const char* name;
+        v8::FunctionCallback callback;
+        bool is_static;
+    };
 
-    void register_primitive_bindings_static(Environment* p_env);
+    // return nullptr if no static binding is provided for the builtin method (reflection is used as fallback)
+    const StaticMethodBinding* find_primitive_static_method(Variant::Type p_type, const StringName& p_name);
 #endif
 }
 
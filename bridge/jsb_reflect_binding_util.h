@@ -6,8 +6,6 @@
 #include "jsb_static_binding_util.h"
 #include "../internal/jsb_variant_info.h"
 
-#define GetVariantInfoCollection(env) (env)->get_variant_info_collection() // ::jsb::internal::VariantInfoCollection::global
-
 namespace jsb
 {
     template<typename ForType>
@@ -34,16 +32,65 @@ namespace jsb
     struct ReflectAdditionalMethodRegister
     {
         static void register_(impl::ClassBuilder& class_builder) {}
+
+        // the builtin methods replaced by `register_` (not reflected)
+        static bool is_replaced(const StringName& p_name) { return false; }
     };
 
+    // packed arrays of plain old data could be viewed as ArrayBuffer without copying
+    template<typename PackedT>
+    struct ReflectArrayBufferViewMethodRegister
+    {
+        static void register_(impl::ClassBuilder& class_builder)
+        {
+            class_builder.Instance().Method(internal::NamingUtil::get_member_name("as_array_buffer"), &_as_array_buffer);
+        }
+
+        static bool is_replaced(const StringName& p_name) { return false; }
+
+        static void _as_array_buffer(const v8::FunctionCallbackInfo<v8::Value>& info)
+        {
+            v8::Isolate* isolate = info.GetIsolate();
+            const v8::Local<v8::Object> self = info.This();
+            if (!TypeConvert::is_variant(self))
+            {
+                jsb_throw(isolate, "bad this");
+                return;
+            }
+            const Variant* p_var = (const Variant*) self->GetAlignedPointerFromInternalField(IF_Pointer);
+            if (p_var->get_type() != GetTypeInfo<PackedT>::VARIANT_TYPE)
+            {
+                jsb_throw(isolate, "bad this");
+                return;
+            }
+            info.GetReturnValue().Set(impl::Helper::to_array_buffer_view(isolate, *VariantGetInternalPtr<PackedT>::get_ptr(p_var)));
+        }
+    };
+
+#define JSB_DEFINE_ARRAY_BUFFER_VIEW_METHOD_REGISTER(PackedT) \
+    template<> struct ReflectAdditionalMethodRegister<PackedT> : ReflectArrayBufferViewMethodRegister<PackedT> {};
+
+    JSB_DEFINE_ARRAY_BUFFER_VIEW_METHOD_REGISTER(PackedInt32Array)
+    JSB_DEFINE_ARRAY_BUFFER_VIEW_METHOD_REGISTER(PackedInt64Array)
+    JSB_DEFINE_ARRAY_BUFFER_VIEW_METHOD_REGISTER(PackedFloat32Array)
+    JSB_DEFINE_ARRAY_BUFFER_VIEW_METHOD_REGISTER(PackedFloat64Array)
+    JSB_DEFINE_ARRAY_BUFFER_VIEW_METHOD_REGISTER(PackedVector2Array)
+    JSB_DEFINE_ARRAY_BUFFER_VIEW_METHOD_REGISTER(PackedVector3Array)
+    JSB_DEFINE_ARRAY_BUFFER_VIEW_METHOD_REGISTER(PackedColorArray)
+
+#undef JSB_DEFINE_ARRAY_BUFFER_VIEW_METHOD_REGISTER
+
     template<>
     struct ReflectAdditionalMethodRegister<PackedByteArray>
     {
         static void register_(impl::ClassBuilder& class_builder)
         {
             class_builder.Instance().Method(internal::NamingUtil::get_member_name("to_array_buffer"), &_to_array_buffer);
+            ReflectArrayBufferViewMethodRegister<PackedByteArray>::register_(class_builder);
         }
 
+        static bool is_replaced(const StringName& p_name) { return false; }
+
         static void _to_array_buffer(const v8::FunctionCallbackInfo<v8::Value>& info)
         {
             v8::Isolate* isolate = info.GetIsolate();
@@ -59,6 +106,21 @@ namespace jsb
         }
     };
 
+    template<>
+    struct ReflectAdditionalMethodRegister<Array>
+    {
+        static void register_(impl::ClassBuilder& class_builder)
+        {
+            class_builder.Instance().Method(internal::NamingUtil::get_member_name("sort_custom"), &_sort_custom);
+        }
+
+        static bool is_replaced(const StringName& p_name) { return p_name == SNAME("sort_custom"); }
+
+        // with a JS function, the elements are converted once and compared in the current scope,
+        // instead of converting both of them in each call of a JSCallable
+        static void _sort_custom(const v8::FunctionCallbackInfo<v8::Value>& info);
+    };
+
     // fallback version of get_opaque_pointer for any Variant
     template<typename OwnerT>
     struct TVariantOpaquePointer
@@ -325,18 +387,14 @@ namespace jsb
         {
             static_assert(GetTypeInfo<TStruct>::VARIANT_TYPE != Variant::VARIANT_MAX);
             Environment* env = Environment::wrap(isolate);
-            Variant* pointer = env->alloc_variant();
-            *pointer = p_value;
-            env->bind_valuetype(pointer, p_object);
+            env->bind_valuetype_copy(p_value, p_object);
         }
 
         jsb_force_inline static void bind_valuetype(v8::Isolate* isolate, const v8::Local<v8::Object>& p_object, const TStruct& p_value, const NativeClassID p_class_id)
         {
             static_assert(GetTypeInfo<TStruct>::VARIANT_TYPE != Variant::VARIANT_MAX);
             Environment* env = Environment::wrap(isolate);
-            Variant* pointer = env->alloc_variant();
-            *pointer = p_value;
-            env->bind_valuetype(pointer, p_object);
+            env->bind_valuetype_copy(p_value, p_object);
         }
     };
 
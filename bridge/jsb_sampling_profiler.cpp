@@ -0,0 +1,171 @@
+#include "jsb_sampling_profiler.h"
+
+#if JSB_WITH_SAMPLING_PROFILER
+#include "jsb_environment.h"
+#include "../internal/jsb_content_hash.h"
+
+namespace jsb
+{
+    void SamplingProfiler::start(Environment* p_env, int p_interval_usec)
+    {
+        jsb_check(p_env && p_interval_usec > 0);
+        if (profiler_) return;
+
+        v8::Isolate* isolate = p_env->get_isolate();
+        v8::Isolate::Scope isolate_scope(isolate);
+        v8::HandleScope handle_scope(isolate);
+        const v8::Local<v8::String> title = impl::Helper::new_string(isolate, "jsb.sampling_profiler");
+
+        env_ = p_env;
+        interval_usec_ = (uint64_t) p_interval_usec;
+        title_.Reset(isolate, title);
+        profiler_ = v8::CpuProfiler::New(isolate);
+        profiler_->SetSamplingInterval(p_interval_usec);
+        profiler_->StartProfiling(title, false);
+        JSB_LOG(Verbose, "sampling profiler started (%d usec)", p_interval_usec);
+    }
+
+    void SamplingProfiler::stop()
+    {
+        if (!profiler_) return;
+
+        v8::Isolate* isolate = env_->get_isolate();
+        v8::Isolate::Scope isolate_scope(isolate);
+        v8::HandleScope handle_scope(isolate);
+        if (v8::CpuProfile* profile = profiler_->StopProfiling(title_.Get(isolate)))
+        {
+            profile->Delete();
+        }
+        profiler_->Dispose();
+        profiler_ = nullptr;
+        title_.Reset();
+        env_ = nullptr;
+        functions_.clear();
+        function_index_.clear();
+        frame_functions_.clear();
+    }
+
+    void SamplingProfiler::frame()
+    {
+        if (!profiler_) return;
+
+        v8::Isolate* isolate = env_->get_isolate();
+        v8::Isolate::Scope isolate_scope(isolate);
+        v8::HandleScope handle_scope(isolate);
+        const v8::Local<v8::String> title = title_.Get(isolate);
+
+        for (const uint32_t index : frame_functions_)
+        {
+            FunctionInfo& info = functions_[index];
+            info.frame_self_time = info.frame_time = info.frame_samples = 0;
+            info.in_frame = false;
+        }
+        frame_functions_.clear();
+        if (v8::CpuProfile* profile = profiler_->StopProfiling(title))
+        {
+            visit(profile->GetTopDownRoot());
+            profile->Delete();
+        }
+        profiler_->StartProfiling(title, false);
+    }
+
+    uint32_t SamplingProfiler::get_function_index(const v8::CpuProfileNode* p_node)
+    {
+        const char* function_name = p_node->GetFunctionNameStr();
+        const int32_t location[3] = { p_node->GetScriptId(), p_node->GetLineNumber(), p_node->GetColumnNumber() };
+        const uint64_t hash = internal::ContentHash::compute((const uint8_t*) function_name, strlen(function_name),
+            internal::ContentHash::compute((const uint8_t*) location, sizeof(location)));
+        if (const uint32_t* index = function_index_.getptr(hash))
+        {
+            return *index;
+        }
+
+        // translate the position only once for each function
+        String filename = String::utf8(p_node->GetScriptResourceNameStr());
+        int line = p_node->GetLineNumber();
+        if (internal::SourcePosition position; env_->get_source_map_cache().find_source_position(filename, line, p_node->GetColumnNumber(), position))
+        {
+            filename = position.filename;
+            line = position.line;
+        }
+
+        const uint32_t index = functions_.size();
+        FunctionInfo info;
+        info.signature = jsb_format("%s::%d::%s", filename, line, *function_name ? String::utf8(function_name) : String("(anonymous)"));
+        functions_.push_back(info);
+        function_index_.insert(hash, index);
+        return index;
+    }
+
+    uint64_t SamplingProfiler::visit(const v8::CpuProfileNode* p_node)
+    {
+        // the pseudo nodes (root, program, idle, garbage collector) are not in any script
+        const bool is_script = p_node->GetScriptId() != v8::UnboundScript::kNoScriptId && p_node->GetScriptId() != 0;
+        const uint32_t index = is_script ? get_function_index(p_node) : 0;
+        if (is_script)
+        {
+            ++functions_[index].depth;
+        }
+
+        const uint64_t hits = p_node->GetHitCount();
+        uint64_t samples = hits;
+        for (int i = 0, n = p_node->GetChildrenCount(); i < n; ++i)
+        {
+            samples += visit(p_node->GetChild(i));
+        }
+
+        if (is_script)
+        {
+            FunctionInfo& info = functions_[index];
+            if (!info.in_frame)
+            {
+                info.in_frame = true;
+                frame_functions_.push_back(index);
+            }
+            info.frame_self_time += hits * interval_usec_;
+            info.total_self_time += hits * interval_usec_;
+            info.frame_samples += hits;
+            info.total_samples += hits;
+            if (--info.depth == 0)
+            {
+                info.frame_time += samples * interval_usec_;
+                info.total_time += samples * interval_usec_;
+            }
+        }
+        return samples;
+    }
+
+    int SamplingProfiler::get_frame_data(ScriptLanguage::ProfilingInfo* p_info_arr, int p_info_max) const
+    {
+        int current = 0;
+        for (const uint32_t index : frame_functions_)
+        {
+            if (current >= p_info_max) break;
+            const FunctionInfo& info = functions_[index];
+            if (info.frame_time == 0) continue;
+            p_info_arr[current].signature = info.signature;
+            p_info_arr[current].self_time = info.frame_self_time;
+            p_info_arr[current].total_time = info.frame_time;
+            p_info_arr[current].call_count = info.frame_samples;
+            ++current;
+        }
+        return current;
+    }
+
+    int SamplingProfiler::get_accumulated_data(ScriptLanguage::ProfilingInfo* p_info_arr, int p_info_max) const
+    {
+        int current = 0;
+        for (const FunctionInfo& info : functions_)
+        {
+            if (current >= p_info_max) break;
+            if (info.total_time == 0) continue;
+            p_info_arr[current].signature = info.signature;
+            p_info_arr[current].self_time = info.total_self_time;
+            p_info_arr[current].total_time = info.total_time;
+            p_info_arr[current].call_count = info.total_samples;
+            ++current;
+        }
+        return current;
+    }
+}
+#endif
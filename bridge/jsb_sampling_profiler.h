@@ -0,0 +1,79 @@
+#ifndef GODOTJS_SAMPLING_PROFILER_H
+#define GODOTJS_SAMPLING_PROFILER_H
+#include "jsb_bridge_pch.h"
+
+#if JSB_WITH_SAMPLING_PROFILER
+#include "core/object/script_language.h"
+
+namespace jsb
+{
+    class Environment;
+
+    /**
+     * Sample the JS stacks of an environment with v8::CpuProfiler.
+     * The profile is collected (and restarted) on each frame, the samples are aggregated per JS function
+     * as the self/total time of the script profiler of godot (the positions are translated with source map).
+     */
+    class SamplingProfiler
+    {
+    private:
+        struct FunctionInfo
+        {
+            // path::line::function
+            String signature;
+
+            uint64_t total_self_time = 0;
+            uint64_t total_time = 0;
+            uint64_t total_samples = 0;
+
+            uint64_t frame_self_time = 0;
+            uint64_t frame_time = 0;
+            uint64_t frame_samples = 0;
+
+            // the number of occurrences in the stack being visited (to not count the total time of recursive calls twice)
+            uint32_t depth = 0;
+
+            // listed in `frame_functions_`
+            bool in_frame = false;
+        };
+
+        Environment* env_ = nullptr;
+        v8::CpuProfiler* profiler_ = nullptr;
+        v8::Global<v8::String> title_;
+        uint64_t interval_usec_ = 0;
+
+        LocalVector<FunctionInfo> functions_;
+
+        // keyed by the hash of [script id, line, column, function name] of the profile node
+        HashMap<uint64_t, uint32_t> function_index_;
+
+        // the functions sampled in the last collected frame
+        LocalVector<uint32_t> frame_functions_;
+
+    public:
+        SamplingProfiler() = default;
+        SamplingProfiler(const SamplingProfiler&) = delete;
+        SamplingProfiler& operator=(const SamplingProfiler&) = delete;
+        ~SamplingProfiler() { stop(); }
+
+        jsb_force_inline bool is_started() const { return profiler_ != nullptr; }
+
+        void start(Environment* p_env, int p_interval_usec);
+        void stop();
+
+        // collect the samples since the last call, and start a new profile
+        void frame();
+
+        int get_frame_data(ScriptLanguage::ProfilingInfo* p_info_arr, int p_info_max) const;
+        int get_accumulated_data(ScriptLanguage::ProfilingInfo* p_info_arr, int p_info_max) const;
+
+    private:
+        uint32_t get_function_index(const v8::CpuProfileNode* p_node);
+
+        // return the number of samples in the subtree
+        uint64_t visit(const v8::CpuProfileNode* p_node);
+    };
+}
+#endif
+
+#endif
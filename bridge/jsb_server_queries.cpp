@@ -0,0 +1,437 @@
+#include "jsb_server_queries.h"
+#include "jsb_environment.h"
+#include "jsb_type_convert.h"
+
+#if !JSB_WITH_WEB
+#include "core/io/resource_loader.h"
+#include "core/object/message_queue.h"
+#if __has_include("servers/navigation_3d/navigation_server_3d.h")
+#   include "servers/navigation_3d/navigation_server_3d.h"
+#else
+#   include "servers/navigation_server_3d.h"
+#endif
+#if __has_include("servers/navigation_2d/navigation_server_2d.h")
+#   include "servers/navigation_2d/navigation_server_2d.h"
+#else
+#   include "servers/navigation_server_2d.h"
+#endif
+#if __has_include("servers/physics_3d/physics_server_3d.h")
+#   include "servers/physics_3d/physics_server_3d.h"
+#else
+#   include "servers/physics_server_3d.h"
+#endif
+#if __has_include("servers/physics_2d/physics_server_2d.h")
+#   include "servers/physics_2d/physics_server_2d.h"
+#else
+#   include "servers/physics_server_2d.h"
+#endif
+
+#if defined(_3D_DISABLED) || defined(NAVIGATION_3D_DISABLED)
+#   define JSB_SERVER_NAVIGATION_3D 0
+#else
+#   define JSB_SERVER_NAVIGATION_3D 1
+#endif
+#if defined(NAVIGATION_2D_DISABLED)
+#   define JSB_SERVER_NAVIGATION_2D 0
+#else
+#   define JSB_SERVER_NAVIGATION_2D 1
+#endif
+#if defined(_3D_DISABLED) || defined(PHYSICS_3D_DISABLED)
+#   define JSB_SERVER_PHYSICS_3D 0
+#else
+#   define JSB_SERVER_PHYSICS_3D 1
+#endif
+#if defined(PHYSICS_2D_DISABLED)
+#   define JSB_SERVER_PHYSICS_2D 0
+#else
+#   define JSB_SERVER_PHYSICS_2D 1
+#endif
+
+#define JSB_SERVER_QUERIES_LOG(Severity, Format, ...) JSB_LOG_IMPL(JSServerQueries, Severity, Format, ##__VA_ARGS__)
+
+namespace jsb
+{
+    BinaryMutex ServerQueries::lock_;
+    bool ServerQueries::finished_ = false;
+    bool ServerQueries::physics_flush_queued_ = false;
+    LocalVector<ServerQuery*> ServerQueries::physics_queries_;
+    HashSet<WorkerThreadPool::TaskID> ServerQueries::pool_tasks_;
+
+    namespace
+    {
+        bool get_arg(v8::Isolate* isolate, const v8::Local<v8::Context>& context, const v8::FunctionCallbackInfo<v8::Value>& info, int p_index, Variant::Type p_type, Variant& r_value)
+        {
+            if (!TypeConvert::js_to_gd_var(isolate, context, info[p_index], p_type, r_value) || r_value.get_type() != p_type)
+            {
+                jsb_throw(isolate, jsb_format("bad argument at %d (%s expected)", p_index, Variant::get_type_name(p_type)));
+                return false;
+            }
+            return true;
+        }
+
+        bool get_rid_arg(v8::Isolate* isolate, const v8::Local<v8::Context>& context, const v8::FunctionCallbackInfo<v8::Value>& info, RID& r_rid)
+        {
+            Variant rid;
+            if (!get_arg(isolate, context, info, 0, Variant::RID, rid)) return false;
+            r_rid = rid;
+            if (!r_rid.is_valid())
+            {
+                jsb_throw(isolate, "invalid RID");
+                return false;
+            }
+            return true;
+        }
+
+        // an optional uint32 argument (layers or collision mask)
+        bool get_mask_arg(v8::Isolate* isolate, const v8::Local<v8::Context>& context, const v8::FunctionCallbackInfo<v8::Value>& info, int p_index, uint32_t p_default, uint32_t& r_mask)
+        {
+            r_mask = p_default;
+            if (info.Length() <= p_index || info[p_index]->IsUndefined()) return true;
+            if (!info[p_index]->Uint32Value(context).To(&r_mask))
+            {
+                jsb_throw(isolate, jsb_format("bad mask at %d", p_index));
+                return false;
+            }
+            return true;
+        }
+    }
+
+    // [js] function navigation_map_get_path_3d(map: RID, origin: Vector3, destination: Vector3, optimize?: boolean, navigation_layers?: number): Promise<PackedVector3Array>;
+    void ServerQueries::_navigation_map_get_path_3d(const v8::FunctionCallbackInfo<v8::Value>& info)
+    {
+        v8::Isolate* isolate = info.GetIsolate();
+        const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+        ServerQuery query;
+        query.type = ServerQuery::TYPE_NAVIGATION_PATH_3D;
+        if (!get_rid_arg(isolate, context, info, query.rid)
+            || !get_arg(isolate, context, info, 1, Variant::VECTOR3, query.from)
+            || !get_arg(isolate, context, info, 2, Variant::VECTOR3, query.to)
+            || !get_mask_arg(isolate, context, info, 4, 1, query.mask))
+        {
+            return;
+        }
+        query.flag = info.Length() <= 3 || info[3]->IsUndefined() || info[3]->BooleanValue(isolate);
+        _start(info, memnew(ServerQuery(std::move(query))));
+    }
+
+    // [js] function navigation_map_get_path_2d(map: RID, origin: Vector2, destination: Vector2, optimize?: boolean, navigation_layers?: number): Promise<PackedVector2Array>;
+    void ServerQueries::_navigation_map_get_path_2d(const v8::FunctionCallbackInfo<v8::Value>& info)
+    {
+        v8::Isolate* isolate = info.GetIsolate();
+        const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+        ServerQuery query;
+        query.type = ServerQuery::TYPE_NAVIGATION_PATH_2D;
+        if (!get_rid_arg(isolate, context, info, query.rid)
+            || !get_arg(isolate, context, info, 1, Variant::VECTOR2, query.from)
+            || !get_arg(isolate, context, info, 2, Variant::VECTOR2, query.to)
+            || !get_mask_arg(isolate, context, info, 4, 1, query.mask))
+        {
+            return;
+        }
+        query.flag = info.Length() <= 3 || info[3]->IsUndefined() || info[3]->BooleanValue(isolate);
+        _start(info, memnew(ServerQuery(std::move(query))));
+    }
+
+    // [js] function intersect_ray_3d(space: RID, from: Vector3, to: Vector3, collision_mask?: number, collide_with_areas?: boolean): Promise<RayHit3D | null>;
+    void ServerQueries::_intersect_ray_3d(const v8::FunctionCallbackInfo<v8::Value>& info)
+    {
+        v8::Isolate* isolate = info.GetIsolate();
+        const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+        ServerQuery query;
+        query.type = ServerQuery::TYPE_INTERSECT_RAY_3D;
+        if (!get_rid_arg(isolate, context, info, query.rid)
+            || !get_arg(isolate, context, info, 1, Variant::VECTOR3, query.from)
+            || !get_arg(isolate, context, info, 2, Variant::VECTOR3, query.to)
+            || !get_mask_arg(isolate, context, info, 3, UINT32_MAX, query.mask))
+        {
+            return;
+        }
+        query.flag = info.Length() > 4 && info[4]->BooleanValue(isolate);
+        _start(info, memnew(ServerQuery(std::move(query))));
+    }
+
+    // [js] function intersect_ray_2d(space: RID, from: Vector2, to: Vector2, collision_mask?: number, collide_with_areas?: boolean): Promise<RayHit2D | null>;
+    void ServerQueries::_intersect_ray_2d(const v8::FunctionCallbackInfo<v8::Value>& info)
+    {
+        v8::Isolate* isolate = info.GetIsolate();
+        const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+        ServerQuery query;
+        query.type = ServerQuery::TYPE_INTERSECT_RAY_2D;
+        if (!get_rid_arg(isolate, context, info, query.rid)
+            || !get_arg(isolate, context, info, 1, Variant::VECTOR2, query.from)
+            || !get_arg(isolate, context, info, 2, Variant::VECTOR2, query.to)
+            || !get_mask_arg(isolate, context, info, 3, UINT32_MAX, query.mask))
+        {
+            return;
+        }
+        query.flag = info.Length() > 4 && info[4]->BooleanValue(isolate);
+        _start(info, memnew(ServerQuery(std::move(query))));
+    }
+
+    // [js] function load_resource(path: string, type_hint?: string): Promise<Resource>;
+    void ServerQueries::_load_resource(const v8::FunctionCallbackInfo<v8::Value>& info)
+    {
+        v8::Isolate* isolate = info.GetIsolate();
+        ServerQuery query;
+        query.type = ServerQuery::TYPE_LOAD_RESOURCE;
+        query.path = impl::Helper::to_string(isolate, info[0]);
+        if (query.path.is_empty())
+        {
+            jsb_throw(isolate, "bad path");
+            return;
+        }
+        if (info.Length() > 1 && !info[1]->IsUndefined())
+        {
+            query.type_hint = impl::Helper::to_string(isolate, info[1]);
+        }
+        _start(info, memnew(ServerQuery(std::move(query))));
+    }
+
+    void ServerQueries::_start(const v8::FunctionCallbackInfo<v8::Value>& info, ServerQuery* p_query)
+    {
+        v8::Isolate* isolate = info.GetIsolate();
+        const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+        Environment* env = Environment::wrap(isolate);
+
+        const v8::Local<v8::Promise::Resolver> resolver = v8::Promise::Resolver::New(context).ToLocalChecked();
+        p_query->token = env;
+        {
+            MutexLock lock(lock_);
+            if (finished_)
+            {
+                memdelete(p_query);
+                jsb_throw(isolate, "the server queries are already finished");
+                return;
+            }
+            p_query->resolver_id = env->add_pending_task(resolver);
+
+            if (p_query->type == ServerQuery::TYPE_INTERSECT_RAY_2D || p_query->type == ServerQuery::TYPE_INTERSECT_RAY_3D)
+            {
+                physics_queries_.push_back(p_query);
+                if (!physics_flush_queued_)
+                {
+                    physics_flush_queued_ = true;
+                    MessageQueue::get_singleton()->push_callable(callable_mp_static(&ServerQueries::_flush_physics));
+                }
+            }
+            else
+            {
+                p_query->pool_task_id = WorkerThreadPool::get_singleton()->add_native_task(&_execute, p_query, false, "jsb: server query");
+                pool_tasks_.insert(p_query->pool_task_id);
+            }
+        }
+        info.GetReturnValue().Set(resolver->GetPromise());
+    }
+
+    void ServerQueries::_execute(void* p_userdata)
+    {
+        ServerQuery* query = (ServerQuery*) p_userdata;
+        _run(query);
+        _post(query);
+    }
+
+    void ServerQueries::_flush_physics()
+    {
+        LocalVector<ServerQuery*> queries;
+        {
+            MutexLock lock(lock_);
+            physics_flush_queued_ = false;
+            queries = std::move(physics_queries_);
+            physics_queries_.clear();
+        }
+        for (ServerQuery* query : queries)
+        {
+            _run(query);
+            _post(query);
+        }
+    }
+
+    void ServerQueries::_run(ServerQuery* p_query)
+    {
+        switch (p_query->type)
+        {
+        case ServerQuery::TYPE_NAVIGATION_PATH_3D:
+#if JSB_SERVER_NAVIGATION_3D
+            p_query->result = NavigationServer3D::get_singleton()->map_get_path(p_query->rid, p_query->from, p_query->to, p_query->flag, p_query->mask);
+#else
+            p_query->error = "navigation 3d is disabled";
+#endif
+            break;
+        case ServerQuery::TYPE_NAVIGATION_PATH_2D:
+#if JSB_SERVER_NAVIGATION_2D
+            p_query->result = NavigationServer2D::get_singleton()->map_get_path(p_query->rid, p_query->from, p_query->to, p_query->flag, p_query->mask);
+#else
+            p_query->error = "navigation 2d is disabled";
+#endif
+            break;
+        case ServerQuery::TYPE_INTERSECT_RAY_3D:
+#if JSB_SERVER_PHYSICS_3D
+            if (PhysicsDirectSpaceState3D* state = PhysicsServer3D::get_singleton()->space_get_direct_state(p_query->rid))
+            {
+                PhysicsDirectSpaceState3D::RayParameters parameters;
+                parameters.from = p_query->from;
+                parameters.to = p_query->to;
+                parameters.collision_mask = p_query->mask;
+                parameters.collide_with_areas = p_query->flag;
+                PhysicsDirectSpaceState3D::RayResult result;
+                if (state->intersect_ray(parameters, result))
+                {
+                    Dictionary hit;
+                    hit["position"] = result.position;
+                    hit["normal"] = result.normal;
+                    hit["collider_id"] = result.collider_id;
+                    hit["rid"] = result.rid;
+                    hit["shape"] = result.shape;
+                    p_query->result = hit;
+                }
+            }
+            else
+            {
+                p_query->error = "space state is not accessible";
+            }
+#else
+            p_query->error = "physics 3d is disabled";
+#endif
+            break;
+        case ServerQuery::TYPE_INTERSECT_RAY_2D:
+#if JSB_SERVER_PHYSICS_2D
+            if (PhysicsDirectSpaceState2D* state = PhysicsServer2D::get_singleton()->space_get_direct_state(p_query->rid))
+            {
+                PhysicsDirectSpaceState2D::RayParameters parameters;
+                parameters.from = p_query->from;
+                parameters.to = p_query->to;
+                parameters.collision_mask = p_query->mask;
+                parameters.collide_with_areas = p_query->flag;
+                PhysicsDirectSpaceState2D::RayResult result;
+                if (state->intersect_ray(parameters, result))
+                {
+                    Dictionary hit;
+                    hit["position"] = result.position;
+                    hit["normal"] = result.normal;
+                    hit["collider_id"] = result.collider_id;
+                    hit["rid"] = result.rid;
+                    hit["shape"] = result.shape;
+                    p_query->result = hit;
+                }
+            }
+            else
+            {
+                p_query->error = "space state is not accessible";
+            }
+#else
+            p_query->error = "physics 2d is disabled";
+#endif
+            break;
+        case ServerQuery::TYPE_LOAD_RESOURCE:
+            {
+                Error err;
+                const Ref<Resource> resource = ResourceLoader::load(p_query->path, p_query->type_hint, ResourceFormatLoader::CACHE_MODE_REUSE, &err);
+                if (resource.is_null())
+                {
+                    p_query->error = jsb_format("failed to load %s (%d)", p_query->path, err);
+                }
+                else
+                {
+                    p_query->result = resource;
+                }
+            }
+            break;
+        default: jsb_checkf(false, "unknown server query: %d", p_query->type); break;
+        }
+    }
+
+    void ServerQueries::_post(ServerQuery* p_query)
+    {
+        if (const std::shared_ptr<Environment> env = Environment::_access(p_query->token))
+        {
+            env->add_async_call(Environment::AsyncCall::TYPE_SERVER_QUERY_DONE, p_query);
+            return;
+        }
+
+        // nobody is waiting for the result, the pool task is waited in `finish`
+        JSB_SERVER_QUERIES_LOG(Verbose, "the environment of server query %d is gone", p_query->type);
+        memdelete(p_query);
+    }
+
+    void ServerQueries::on_query_done(Environment* p_env, ServerQuery* p_query)
+    {
+        if (p_query->pool_task_id != WorkerThreadPool::INVALID_TASK_ID)
+        {
+            {
+                MutexLock lock(lock_);
+                pool_tasks_.erase(p_query->pool_task_id);
+            }
+            // already completed (the result is posted at the end of the pool task), it releases the task in WorkerThreadPool
+            WorkerThreadPool::get_singleton()->wait_for_task_completion(p_query->pool_task_id);
+        }
+
+        v8::Global<v8::Promise::Resolver> resolver_handle;
+        if (p_env->take_pending_task(p_query->resolver_id, resolver_handle))
+        {
+            v8::Isolate* isolate = p_env->get_isolate();
+            const Environment::BridgeScope bridge_scope(p_env);
+            const v8::Local<v8::Context> context = p_env->get_context();
+            const v8::Local<v8::Promise::Resolver> resolver = resolver_handle.Get(isolate);
+            resolver_handle.Reset();
+
+            v8::Local<v8::Value> value;
+            if (!p_query->error.is_empty())
+            {
+                resolver->Reject(context, impl::Helper::new_string(isolate, p_query->error)).Check();
+            }
+            else if (p_query->result.get_type() == Variant::NIL)
+            {
+                resolver->Resolve(context, v8::Null(isolate)).Check();
+            }
+            else if (TypeConvert::gd_var_to_js(isolate, context, p_query->result, value))
+            {
+                resolver->Resolve(context, value).Check();
+            }
+            else
+            {
+                resolver->Reject(context, impl::Helper::new_string(isolate, "failed to convert the result of server query")).Check();
+            }
+            p_env->notify_microtasks_run();
+        }
+        memdelete(p_query);
+    }
+
+    void ServerQueries::finish()
+    {
+        LocalVector<WorkerThreadPool::TaskID> pool_tasks;
+        {
+            MutexLock lock(lock_);
+            finished_ = true;
+
+            // the environments waiting for them are already disposed
+            for (ServerQuery* query : physics_queries_)
+            {
+                memdelete(query);
+            }
+            physics_queries_.clear();
+            for (const WorkerThreadPool::TaskID& task_id : pool_tasks_)
+            {
+                pool_tasks.push_back(task_id);
+            }
+            pool_tasks_.clear();
+        }
+
+        for (const WorkerThreadPool::TaskID& task_id : pool_tasks)
+        {
+            WorkerThreadPool::get_singleton()->wait_for_task_completion(task_id);
+        }
+    }
+
+    void ServerQueries::expose(v8::Isolate* isolate, v8::Local<v8::Context> context, v8::Local<v8::Object> jsb_obj)
+    {
+        v8::Local<v8::Object> servers_obj = v8::Object::New(isolate);
+
+        jsb_obj->Set(context, impl::Helper::new_string_ascii(isolate, "servers"), servers_obj).Check();
+        servers_obj->Set(context, impl::Helper::new_string_ascii(isolate, "navigation_map_get_path_3d"), JSB_NEW_FUNCTION(context, _navigation_map_get_path_3d, {})).Check();
+        servers_obj->Set(context, impl::Helper::new_string_ascii(isolate, "navigation_map_get_path_2d"), JSB_NEW_FUNCTION(context, _navigation_map_get_path_2d, {})).Check();
+        servers_obj->Set(context, impl::Helper::new_string_ascii(isolate, "intersect_ray_3d"), JSB_NEW_FUNCTION(context, _intersect_ray_3d, {})).Check();
+        servers_obj->Set(context, impl::Helper::new_string_ascii(isolate, "intersect_ray_2d"), JSB_NEW_FUNCTION(context, _intersect_ray_2d, {})).Check();
+        servers_obj->Set(context, impl::Helper::new_string_ascii(isolate, "load_resource"), JSB_NEW_FUNCTION(context, _load_resource, {})).Check();
+    }
+}
+#endif
@@ -0,0 +1,92 @@
+#ifndef GODOTJS_SERVER_QUERIES_H
+#define GODOTJS_SERVER_QUERIES_H
+#include "jsb_bridge_pch.h"
+#include "core/object/worker_thread_pool.h"
+
+#if !JSB_WITH_WEB
+namespace jsb
+{
+    class Environment;
+
+    // a query started by `jsb.servers` (owned by ServerQueries until it's settled in the environment which started it)
+    struct ServerQuery
+    {
+        enum Type : uint8_t
+        {
+            TYPE_NAVIGATION_PATH_2D,
+            TYPE_NAVIGATION_PATH_3D,
+            TYPE_INTERSECT_RAY_2D,
+            TYPE_INTERSECT_RAY_3D,
+            TYPE_LOAD_RESOURCE,
+        };
+
+        Type type;
+
+        // the environment which started the query (the result is posted back to it)
+        void* token = nullptr;
+        internal::Index32 resolver_id;
+
+        // the arguments
+        RID rid;
+        Variant from;
+        Variant to;
+        bool flag = false;
+        uint32_t mask = UINT32_MAX;
+        String path;
+        String type_hint;
+
+        // written by the executing thread
+        Variant result;
+        String error;
+
+        WorkerThreadPool::TaskID pool_task_id = WorkerThreadPool::INVALID_TASK_ID;
+    };
+
+    /**
+     * The thread-safe subset of engine servers callable from any environment (`jsb.servers`), with the results delivered as promises
+     * resolved on the loop of the calling environment:
+     *   - navigation path queries and resource loads run on godot's WorkerThreadPool (the servers lock the data they read)
+     *   - physics space queries are only valid while the space is not stepping, they're batched and run in the next idle time of the main thread
+     *     (MessageQueue) without any script, the workers don't need to bounce the requests through the main environment.
+     */
+    class ServerQueries
+    {
+    public:
+        static void expose(v8::Isolate* isolate, v8::Local<v8::Context> context, v8::Local<v8::Object> jsb_obj);
+
+        // wait for the running queries, call from main thread (GodotJSScriptLanguage::finish)
+        static void finish();
+
+        // [env thread] settle the promise of a query started in `p_env`
+        static void on_query_done(Environment* p_env, ServerQuery* p_query);
+
+    private:
+        static void _navigation_map_get_path_3d(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void _navigation_map_get_path_2d(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void _intersect_ray_3d(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void _intersect_ray_2d(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void _load_resource(const v8::FunctionCallbackInfo<v8::Value>& info);
+
+        // take the ownership of `p_query`, and return the promise of it
+        static void _start(const v8::FunctionCallbackInfo<v8::Value>& info, ServerQuery* p_query);
+
+        // [WorkerThreadPool]
+        static void _execute(void* p_userdata);
+
+        // [main thread] run all queued physics queries
+        static void _flush_physics();
+
+        // [any thread]
+        static void _run(ServerQuery* p_query);
+        static void _post(ServerQuery* p_query);
+
+        static BinaryMutex lock_;
+        static bool finished_;
+        static bool physics_flush_queued_;
+        static LocalVector<ServerQuery*> physics_queries_;
+        static HashSet<WorkerThreadPool::TaskID> pool_tasks_;
+    };
+}
+#endif
+
+#endif
@@ -0,0 +1,158 @@
+#include "jsb_shared_variant_info.h"
+#include "jsb_object_bindings.h"
+
+namespace jsb
+{
+    std::atomic<SharedVariantInfo*> SharedVariantInfo::instance_ = nullptr;
+
+    namespace
+    {
+        Mutex build_mutex_;
+    }
+
+    const SharedVariantInfo& SharedVariantInfo::_build()
+    {
+        MutexLock lock(build_mutex_);
+        if (const SharedVariantInfo* instance = instance_.load(std::memory_order_relaxed))
+        {
+            return *instance;
+        }
+
+        JSB_BENCHMARK_SCOPE(SharedVariantInfo, build);
+        SharedVariantInfo* instance = memnew(SharedVariantInfo);
+        for (int type = Variant::NIL + 1; type < Variant::VARIANT_MAX; ++type)
+        {
+            if (type == Variant::OBJECT) continue;
+            instance->_add_type((Variant::Type) type);
+        }
+
+        List<StringName> utility_funcs;
+        Variant::get_utility_function_list(&utility_funcs);
+        for (const StringName& name : utility_funcs)
+        {
+            instance->_add_utility_func(name);
+        }
+        JSB_LOG(VeryVerbose, "shared variant info: %d constructors, %d methods, %d getsets, %d utility functions",
+            instance->collection.constructors.size(), instance->collection.methods.size(),
+            instance->collection.getsets.size(), instance->collection.utility_funcs.size());
+
+        instance_.store(instance, std::memory_order_release);
+        return *instance;
+    }
+
+    void SharedVariantInfo::release()
+    {
+        MutexLock lock(build_mutex_);
+        if (SharedVariantInfo* instance = instance_.exchange(nullptr, std::memory_order_acq_rel))
+        {
+            memdelete(instance);
+        }
+    }
+
+    void SharedVariantInfo::_add_type(Variant::Type p_type)
+    {
+        // constructors
+        {
+            constructor_indices_[p_type] = collection.constructors.size();
+            collection.constructors.append({});
+            internal::FConstructorInfo& constructor_info = collection.constructors.write[constructor_indices_[p_type]];
+            const int count = Variant::get_constructor_count(p_type);
+#if GODOT_4_5_OR_NEWER
+            constructor_info.variants.resize_initialized(count);
+#else
+            constructor_info.variants.resize_zeroed(count);
+#endif
+            for (int index = 0; index < count; ++index)
+            {
+                internal::FConstructorVariantInfo& variant_info = constructor_info.variants.write[index];
+                variant_info.ctor_func = Variant::get_validated_constructor(p_type, index);
+                const int arg_count = Variant::get_constructor_argument_count(p_type, index);
+                variant_info.argument_types.resize(arg_count);
+                bool numbers_only = true;
+                for (int arg_index = 0; arg_index < arg_count; ++arg_index)
+                {
+                    const Variant::Type argument_type = Variant::get_constructor_argument_type(p_type, index, arg_index);
+                    variant_info.argument_types.write[arg_index] = argument_type;
+                    numbers_only = numbers_only && (argument_type == Variant::INT || argument_type == Variant::FLOAT);
+                }
+
+                // overload resolution table
+                if (constructor_info.arities.size() <= arg_count)
+                {
+                    constructor_info.arities.resize(arg_count + 1);
+                }
+                internal::FConstructorArityInfo& arity_info = constructor_info.arities.write[arg_count];
+                arity_info.variants.push_back(index);
+                if (numbers_only && arity_info.number_variant < 0)
+                {
+                    arity_info.number_variant = index;
+                }
+            }
+        }
+
+        // properties (getset)
+        {
+            List<StringName> members;
+            Variant::get_member_list(p_type, &members);
+            for (const StringName& name : members)
+            {
+                getset_indices_[p_type].insert(name, collection.getsets.size());
+                collection.getsets.append({
+                    Variant::get_member_validated_setter(p_type, name),
+                    Variant::get_member_validated_getter(p_type, name),
+                    Variant::get_member_type(p_type, name) });
+            }
+        }
+
+        // methods
+        {
+            List<StringName> methods;
+            Variant::get_builtin_method_list(p_type, &methods);
+            for (const StringName& name : methods)
+            {
+                const int collection_index = collection.methods.size();
+                method_indices_[p_type].insert(name, collection_index);
+                collection.methods.append({});
+                internal::FBuiltinMethodInfo& method_info = collection.methods.write[collection_index];
+                const int argument_count = Variant::get_builtin_method_argument_count(p_type, name);
+                method_info.set_debug_name(internal::NamingUtil::get_member_name(name));
+                method_info.builtin_func = Variant::get_validated_builtin_method(p_type, name);
+                method_info.return_type = Variant::get_builtin_method_return_type(p_type, name);
+                method_info.default_arguments = Variant::get_builtin_method_default_arguments(p_type, name);
+#if GODOT_4_5_OR_NEWER
+                method_info.argument_types.resize_initialized(argument_count);
+#else
+                method_info.argument_types.resize_zeroed(argument_count);
+#endif
+                method_info.is_vararg = Variant::is_builtin_method_vararg(p_type, name);
+                for (int argument_index = 0; argument_index < argument_count; ++argument_index)
+                {
+                    method_info.argument_types.write[argument_index] = Variant::get_builtin_method_argument_type(p_type, name, argument_index);
+                }
+            }
+        }
+    }
+
+    void SharedVariantInfo::_add_utility_func(const StringName& p_name)
+    {
+        static_assert(sizeof(Variant::ValidatedUtilityFunction) == sizeof(void*));
+        const int utility_func_index = collection.utility_funcs.size();
+        utility_func_indices_.insert(p_name, utility_func_index);
+        collection.utility_funcs.append({});
+        internal::FUtilityMethodInfo& method_info = collection.utility_funcs.write[utility_func_index];
+
+        const int argument_count = Variant::get_utility_function_argument_count(p_name);
+        method_info.argument_types.resize(argument_count);
+        for (int index = 0; index < argument_count; ++index)
+        {
+            method_info.argument_types.write[index] = Variant::get_utility_function_argument_type(p_name, index);
+        }
+        //NOTE currently, utility functions have no default argument.
+        method_info.return_type = Variant::get_utility_function_return_type(p_name);
+        method_info.is_vararg = Variant::is_utility_function_vararg(p_name);
+        method_info.set_debug_name(internal::NamingUtil::get_member_name(p_name));
+        method_info.utility_func = Variant::get_validated_utility_function(p_name);
+        jsb_check(method_info.utility_func);
+        method_info.number_func = method_info.is_vararg ? nullptr : ObjectReflectBindingUtil::get_number_utility_func(p_name);
+    }
+}
@@ -0,0 +1,68 @@
+#ifndef GODOTJS_SHARED_VARIANT_INFO_H
+#define GODOTJS_SHARED_VARIANT_INFO_H
+#include "jsb_bridge_pch.h"
+#include "../internal/jsb_variant_info.h"
+
+namespace jsb
+{
+    /**
+     * The reflection info of Variant types and utility functions, built once (on the first access) and shared by all environments (main, workers and shadows).
+     * It's immutable after built, so it's read without lock from any thread,
+     * and the environments only create the engine-specific function templates referring to the indices in `collection`.
+     * The info of godot object classes (`method_binds`, `properties2`) is still collected per environment,
+     * since the classes are exposed on demand and the method infos carry the inline caches of the environment.
+     */
+    class SharedVariantInfo
+    {
+    public:
+        internal::VariantInfoCollection collection;
+
+        static jsb_force_inline const SharedVariantInfo& get()
+        {
+            if (const SharedVariantInfo* instance = instance_.load(std::memory_order_acquire))
+            {
+                return *instance;
+            }
+            return _build();
+        }
+
+        // release it after all environments disposed (GodotJSScriptLanguage::finish), it's rebuilt if accessed again
+        static void release();
+
+        jsb_force_inline int get_constructor_index(Variant::Type p_type) const { return constructor_indices_[p_type]; }
+
+        // -1 if not found
+        int find_method_index(Variant::Type p_type, const StringName& p_name) const
+        {
+            const int* it = method_indices_[p_type].getptr(p_name);
+            return it ? *it : -1;
+        }
+
+        int find_getset_index(Variant::Type p_type, const StringName& p_name) const
+        {
+            const int* it = getset_indices_[p_type].getptr(p_name);
+            return it ? *it : -1;
+        }
+
+        int find_utility_func_index(const StringName& p_name) const
+        {
+            const int* it = utility_func_indices_.getptr(p_name);
+            return it ? *it : -1;
+        }
+
+    private:
+        static const SharedVariantInfo& _build();
+
+        void _add_type(Variant::Type p_type);
+        void _add_utility_func(const StringName& p_name);
+
+        static std::atomic<SharedVariantInfo*> instance_;
+
+        int constructor_indices_[Variant::VARIANT_MAX] = {};
+        HashMap<StringName, int> method_indices_[Variant::VARIANT_MAX];
+        HashMap<StringName, int> getset_indices_[Variant::VARIANT_MAX];
+        HashMap<StringName, int> utility_func_indices_;
+    };
+}
+
+#endif
@@ -0,0 +1,156 @@
+#include "jsb_signal_awaiter.h"
+#include "jsb_environment.h"
+#include "jsb_type_convert.h"
+
+namespace jsb
+{
+    namespace
+    {
+        // keep the resolver of a new promise as a pending task, return the promise
+        bool new_awaiter(Environment* p_env, const v8::Local<v8::Context>& context, internal::Index32& r_task_id, v8::Local<v8::Promise>& r_promise)
+        {
+            v8::Local<v8::Promise::Resolver> resolver;
+            if (!v8::Promise::Resolver::New(context).ToLocal(&resolver))
+            {
+                return false;
+            }
+            r_task_id = p_env->add_pending_task(resolver);
+            r_promise = resolver->GetPromise();
+            return true;
+        }
+
+        // await_signal(signal: Signal): Promise<any>
+        void _await_signal(const v8::FunctionCallbackInfo<v8::Value>& info)
+        {
+            v8::Isolate* isolate = info.GetIsolate();
+            const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+            Variant signal_var;
+            if (!TypeConvert::js_to_gd_var(isolate, context, info[0], Variant::SIGNAL, signal_var) || signal_var.get_type() != Variant::SIGNAL)
+            {
+                jsb_throw(isolate, "bad signal");
+                return;
+            }
+            const Signal signal = signal_var;
+            if (signal.is_null() || !signal.get_object())
+            {
+                jsb_throw(isolate, "invalid signal");
+                return;
+            }
+
+            Environment* env = Environment::wrap(isolate);
+            internal::Index32 task_id;
+            v8::Local<v8::Promise> promise;
+            if (!new_awaiter(env, context, task_id, promise))
+            {
+                return;
+            }
+            const Error err = signal.connect(Callable(memnew(SignalAwaiter(env->id(), task_id))), Object::CONNECT_ONE_SHOT);
+            if (err != OK)
+            {
+                // the callable is already released with the pending task if failed to connect
+                jsb_throw(isolate, jsb_format("failed to connect signal %s", signal.get_name()));
+                return;
+            }
+            info.GetReturnValue().Set(promise);
+        }
+
+#if JSB_WITH_ESSENTIALS
+        template<FrameCallbacks& (Environment::*GetCallbacks)()>
+        void _next_frame(const v8::FunctionCallbackInfo<v8::Value>& info)
+        {
+            v8::Isolate* isolate = info.GetIsolate();
+            const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+            Environment* env = Environment::wrap(isolate);
+            internal::Index32 task_id;
+            v8::Local<v8::Promise> promise;
+            if (!new_awaiter(env, context, task_id, promise))
+            {
+                return;
+            }
+            (env->*GetCallbacks)().await(task_id);
+            info.GetReturnValue().Set(promise);
+        }
+#endif
+    }
+
+    SignalAwaiter::~SignalAwaiter()
+    {
+        if (settled_)
+        {
+            return;
+        }
+        if (const std::shared_ptr<Environment> env = Environment::_access(env_id_))
+        {
+            v8::Global<v8::Promise::Resolver> resolver;
+            env->take_pending_task(task_id_, resolver);
+        }
+    }
+
+    void SignalAwaiter::call(const Variant** p_arguments, int p_argcount, Variant& r_return_value, Callable::CallError& r_call_error) const
+    {
+        const std::shared_ptr<Environment> env = Environment::_access(env_id_);
+        if (!env)
+        {
+            r_call_error.error = Callable::CallError::CALL_ERROR_INVALID_METHOD;
+            return;
+        }
+        r_call_error.error = Callable::CallError::CALL_OK;
+
+        v8::Global<v8::Promise::Resolver> resolver_handle;
+        if (settled_ || !env->take_pending_task(task_id_, resolver_handle))
+        {
+            return;
+        }
+
+        settled_ = true;
+
+        v8::Isolate* isolate = env->get_isolate();
+        const Environment::BridgeScope bridge_scope(env.get());
+        const v8::Local<v8::Context> context = env->get_context();
+        const v8::Local<v8::Promise::Resolver> resolver = resolver_handle.Get(isolate);
+        resolver_handle.Reset();
+
+        // resolved with undefined if no argument, the only argument or an array of all arguments (same as the old `as_promise`)
+        v8::Local<v8::Value> value;
+        if (p_argcount == 0)
+        {
+            value = v8::Undefined(isolate);
+        }
+        else if (p_argcount == 1)
+        {
+            if (!TypeConvert::gd_var_to_js(isolate, context, *p_arguments[0], value))
+            {
+                resolver->Reject(context, impl::Helper::new_string_ascii(isolate, "bad signal argument")).Check();
+                env->notify_microtasks_run();
+                return;
+            }
+        }
+        else
+        {
+            const v8::Local<v8::Array> array = v8::Array::New(isolate, p_argcount);
+            for (int index = 0; index < p_argcount; ++index)
+            {
+                v8::Local<v8::Value> element;
+                if (!TypeConvert::gd_var_to_js(isolate, context, *p_arguments[index], element))
+                {
+                    resolver->Reject(context, impl::Helper::new_string_ascii(isolate, "bad signal argument")).Check();
+                    env->notify_microtasks_run();
+                    return;
+                }
+                array->Set(context, index, element).Check();
+            }
+            value = array;
+        }
+        resolver->Resolve(context, value).Check();
+        env->notify_microtasks_run();
+    }
+
+    void SignalAwaiter::expose(v8::Isolate* isolate, v8::Local<v8::Context> context, v8::Local<v8::Object> jsb_obj)
+    {
+        jsb_obj->Set(context, impl::Helper::new_string_ascii(isolate, "await_signal"), JSB_NEW_FUNCTION(context, _await_signal, {})).Check();
+#if JSB_WITH_ESSENTIALS
+        jsb_obj->Set(context, impl::Helper::new_string_ascii(isolate, "next_frame"), JSB_NEW_FUNCTION(context, _next_frame<&Environment::get_animation_frame_callbacks>, {})).Check();
+        jsb_obj->Set(context, impl::Helper::new_string_ascii(isolate, "next_physics_frame"), JSB_NEW_FUNCTION(context, _next_frame<&Environment::get_physics_frame_callbacks>, {})).Check();
+#endif
+    }
+}
@@ -0,0 +1,56 @@
+#ifndef GODOTJS_SIGNAL_AWAITER_H
+#define GODOTJS_SIGNAL_AWAITER_H
+#include "jsb_bridge_pch.h"
+
+namespace jsb
+{
+    /**
+     * A one-shot connection which resolves a pending promise directly on the signal emission (`Signal.as_promise`).
+     * No JS function is created and nothing is registered in the function bank,
+     * the promise capability is kept in the pending tasks of the environment (slots are recycled), this callable only holds the slot id.
+     */
+    class SignalAwaiter : public CallableCustom
+    {
+    private:
+        jsb::EnvironmentID env_id_;
+        internal::Index32 task_id_;
+
+        // the slot may be reused by another awaiter before this callable is released (it's the identity of the connection, so not reset)
+        mutable bool settled_ = false;
+
+    public:
+        static bool _compare_equal(const CallableCustom* p_a, const CallableCustom* p_b)
+        {
+            const SignalAwaiter* awaiter_a = (const SignalAwaiter*)p_a;
+            const SignalAwaiter* awaiter_b = (const SignalAwaiter*)p_b;
+            return awaiter_a->task_id_ == awaiter_b->task_id_ && awaiter_a->env_id_ == awaiter_b->env_id_;
+        }
+
+        static bool _compare_less(const CallableCustom* p_a, const CallableCustom* p_b)
+        {
+            const SignalAwaiter* awaiter_a = (const SignalAwaiter*)p_a;
+            const SignalAwaiter* awaiter_b = (const SignalAwaiter*)p_b;
+            return awaiter_a->task_id_ != awaiter_b->task_id_
+                ? awaiter_a->task_id_ < awaiter_b->task_id_
+                : awaiter_a->env_id_ < awaiter_b->env_id_;
+        }
+
+        SignalAwaiter(jsb::EnvironmentID p_env_id, internal::Index32 p_task_id) : env_id_(p_env_id), task_id_(p_task_id) {}
+
+        // the promise is left pending if the signal is never emitted (e.g. the source object is freed)
+        virtual ~SignalAwaiter() override;
+
+        virtual bool is_valid() const override { return true; }
+        virtual String get_as_text() const override { return "SignalAwaiter"; }
+        virtual ObjectID get_object() const override { return {}; }
+        virtual void call(const Variant** p_arguments, int p_argcount, Variant& r_return_value, Callable::CallError& r_call_error) const override;
+
+        virtual CompareEqualFunc get_compare_equal_func() const override { return _compare_equal; }
+        virtual CompareLessFunc get_compare_less_func() const override { return _compare_less; }
+        virtual uint32_t hash() const override { return task_id_.hash(); }
+
+        // expose `jsb.await_signal(signal)`, and `jsb.next_frame()`/`jsb.next_physics_frame()` with essentials
+        static void expose(v8::Isolate* isolate, v8::Local<v8::Context> context, v8::Local<v8::Object> jsb_obj);
+    };
+}
+#endif
@@ -6,6 +6,31 @@
 
 namespace jsb
 {
+    // accumulated numbers since the environment created, the consumer computes the rates by itself (see GodotJSMonitor)
+    struct StatisticsCounters
+    {
+        // only valid in debug mode
+        uint64_t variant_allocs = 0;
+        uint64_t variant_frees = 0;
+
+        // num of JS wrappers created for Variant and godot objects
+        uint64_t valuetype_bindings = 0;
+        uint64_t object_bindings = 0;
+
+        // only valid if JSB_PRINT_GC_TIME is enabled (v8), or the scheduled gc is enabled (quickjs, see `gc_malloc_threshold_kb`)
+        uint64_t gc_count = 0;
+        uint64_t gc_time_usec = 0;
+
+        uint64_t string_name_hits = 0;
+        uint64_t string_name_misses = 0;
+        uint64_t string_name_evictions = 0;
+
+        uint64_t microtask_time_usec = 0;
+
+        // num of calls into JS from the engine (outermost bridge scopes)
+        uint64_t bridge_calls = 0;
+    };
+
     struct Statistics
     {
         // num of traced objects
@@ -23,6 +48,8 @@ namespace jsb
         // allocated num of Variants in pool (only valid in debug mode)
         uint32_t allocated_variants;
 
+        StatisticsCounters counters;
+
         // impl-specific fields
         Vector<impl::CustomField> custom_fields;
 
@@ -38,5 +65,32 @@ namespace jsb
             return {};
         }
     };
+
+    // taken on demand (slow), two snapshots can be compared by the names of entries (see GodotJSStatisticsViewer)
+    struct HeapSnapshot
+    {
+        struct NativeClassEntry
+        {
+            String name;
+
+            // num of bound objects of this class
+            int objects = 0;
+
+            // num of them referenced strongly (kept alive by JS, e.g. script instances and RefCounted objects)
+            int strong = 0;
+        };
+
+        uint64_t time_usec = 0;
+
+        // impl-specific (by constructor name in v8, by kind of memory in quickjs)
+        Vector<impl::HeapSummaryEntry> js_heap;
+
+        // the bound objects grouped by NativeClassInfo (sorted by the number of objects)
+        Vector<NativeClassEntry> native_objects;
+
+        int cached_string_names = 0;
+        // 0 for unlimited
+        int string_name_cache_capacity = 0;
+    };
 }
 #endif
@@ -26,47 +26,80 @@ namespace jsb
             ~Slot() = default;
         };
 
+        // an entry of the open-addressing (linear probing) table, `id` is empty for unused buckets
+        struct Bucket
+        {
+            uint32_t hash;
+            StringNameID id;
+        };
+
         // StringName => StringNameID
         HashMap<StringName, StringNameID> name_index;
 
-        // JSValue => StringNameID
-        internal::TypeGen<TStrongRef<v8::String>, StringNameID>::UnorderedMap value_index_; // backlink
+        // JSValue => StringNameID (backlink), keyed by the identity hash of the JS string.
+        // NOTE: on V8 it's the content hash of the string, different string objects with the same content share the same bucket chain.
+        std::vector<Bucket> value_index_;
+        int value_index_size_ = 0;
 
         // List< StringName+JSValue >
         // managed as a least recently used cache if max_size_ > 0
         internal::SArray<Slot, StringNameID> values_;
 
+        // StringName data pointer => StringNameID (direct mapped, the last one wins on collision).
+        // checked before `name_index` in `get_string_value`, a hit doesn't touch the LRU list (the entry is validated by the slot itself).
+        enum : uint32_t { kFastIndexSize = 256 };
+        StringNameID fast_index_[kFastIndexSize] = {};
+
+        // statistics of get_string_name/get_string_value
+        uint64_t hits_ = 0;
+        uint64_t misses_ = 0;
+        uint64_t evictions_ = 0;
+
     public:
         TStringNameCache()
         {
             // jsb_check(max_size_ <= 0 || max_size_ > 32);
             values_.reserve(kMaxCacheSize);
+            value_index_.resize(next_power_of_2((uint32_t) MAX(kMaxCacheSize, 32) * 2));
         }
-        
+
         void clear()
         {
             name_index.clear();
-            value_index_.clear();
+            for (StringNameID& id : fast_index_) id = {};
+            for (Bucket& bucket : value_index_) bucket = {};
+            value_index_size_ = 0;
             values_.clear();
         }
 
-        // [reserved] only called on low memory. 
-        void shrink() {}
+        // only called on low memory, drop the least used half of the entries (recreated on demand)
+        void shrink()
+        {
+            if constexpr (kMaxCacheSize <= 0) return;
+            for (int num = values_.size() / 2; num > 0; --num)
+            {
+                remove_first();
+            }
+        }
 
         jsb_force_inline int size() const { return values_.size(); }
+        // 0 for unlimited
+        static constexpr int get_max_size() { return kMaxCacheSize; }
+        jsb_force_inline uint64_t get_hits() const { return hits_; }
+        jsb_force_inline uint64_t get_misses() const { return misses_; }
+        jsb_force_inline uint64_t get_evictions() const { return evictions_; }
 
-        bool try_get_string_name(v8::Isolate* isolate, const v8::Local<v8::Value>& p_value, StringName& r_string_name) const 
+        bool try_get_string_name(v8::Isolate* isolate, const v8::Local<v8::Value>& p_value, StringName& r_string_name) const
         {
             if (p_value->IsString()) return try_get_string_name(isolate, p_value.As<v8::String>(), r_string_name);
             r_string_name = {};
             return false;
         }
 
-        bool try_get_string_name(v8::Isolate* isolate, const v8::Local<v8::String>& p_value, StringName& r_string_name) const 
+        bool try_get_string_name(v8::Isolate* isolate, const v8::Local<v8::String>& p_value, StringName& r_string_name) const
         {
-            if (const auto& it = value_index_.find(TStrongRef(isolate, p_value)); it != value_index_.end())
+            if (const StringNameID id = find_value(isolate, p_value))
             {
-                const StringNameID id = it->second;
                 r_string_name = values_[id].name_;
                 const_cast<TStringNameCache*>(this)->mark_as_used(id);
                 return true;
@@ -75,7 +108,7 @@ namespace jsb
             return false;
         }
 
-        bool is_string_value_cached(v8::Isolate* isolate, const v8::Local<v8::String>& p_value) const 
+        bool is_string_value_cached(v8::Isolate* isolate, const v8::Local<v8::String>& p_value) const
         {
             StringName unused;
             return try_get_string_name(isolate, p_value, unused);
@@ -83,49 +116,165 @@ namespace jsb
 
         StringName get_string_name(v8::Isolate* isolate, const v8::Local<v8::String>& p_value)
         {
-            if (const auto& it = value_index_.find(TStrongRef(isolate, p_value)); it != value_index_.end())
+            return values_[get_value_id(isolate, p_value)].name_;
+        }
+
+        /**
+         * The same as `get_string_name`, with an inline cache of the call site (usually a string literal passed to the same argument slot).
+         * `r_site` holds the entry of the last string, it resolves with a single identity compare if the same string is passed again.
+         */
+        StringName get_string_name(v8::Isolate* isolate, const v8::Local<v8::String>& p_value, StringNameID& r_site)
+        {
+            if (values_.is_valid_index(r_site) && values_[r_site].ref_.object_ == p_value)
             {
-                const StringNameID id = it->second;
-                const StringName name = values_[id].name_;
-                
-                mark_as_used(id);
-                return name;
+                mark_as_used(r_site);
+                ++hits_;
+                return values_[r_site].name_;
             }
-            else
+            r_site = get_value_id(isolate, p_value);
+            return values_[r_site].name_;
+        }
+
+        v8::Local<v8::String> get_string_value(v8::Isolate* isolate, const StringName& p_name)
+        {
+            StringNameID& fast_id = fast_index_[get_fast_index(p_name)];
+            if (values_.is_valid_index(fast_id))
             {
-                const StringName name = impl::Helper::to_string(isolate, p_value);
-                const StringNameID id = get_string_id(isolate, name);
-                Slot& slot = values_[id];
-                if (slot.ref_ && slot.ref_.object_ != p_value)
+                if (const Slot& slot = values_[fast_id]; slot.name_ == p_name && slot.ref_)
                 {
-                    const size_t removed = value_index_.erase(slot.ref_);
-                    JSB_LOG(Verbose, "(not recommended) update an existing string name %s", name);
-                    jsb_check(removed == 1);
+                    ++hits_;
+                    return slot.ref_.object_.Get(isolate);
                 }
-                slot.ref_ = TStrongRef(isolate, p_value);
-                value_index_.insert(std::pair(TStrongRef(isolate, p_value), id));
-                JSB_LOG(VeryVerbose, "new string name pair (js) %s %d [slots:%d]", name, id, values_.size());
-                return name;
             }
-        }
 
-        v8::Local<v8::String> get_string_value(v8::Isolate* isolate, const StringName& p_name)
-        {
             const StringNameID id = get_string_id(isolate, p_name);
+            fast_id = id;
             Slot& slot = values_[id];
             if (!slot.ref_)
             {
+                ++misses_;
                 const v8::Local<v8::String> str_val = impl::Helper::new_string(isolate, p_name);
                 slot.ref_ = TStrongRef(isolate, str_val);
-                value_index_.insert(std::pair(TStrongRef(isolate, str_val), id));
+                insert_value(slot.ref_.hash(), id);
                 JSB_LOG(VeryVerbose, "new string name pair (cpp) %s %d [slots:%d]", p_name, id, values_.size());
                 return str_val;
             }
+            ++hits_;
             return slot.ref_.object_.Get(isolate);
         }
-        
+
     private:
-        void mark_as_used(const StringNameID id)  
+        static jsb_force_inline uint32_t get_fast_index(const StringName& p_name)
+        {
+            // the data is allocated with alignment, the low bits are always the same
+            return (uint32_t) ((uintptr_t) p_name.data_unique_pointer() >> 4) & (kFastIndexSize - 1);
+        }
+
+        StringNameID get_value_id(v8::Isolate* isolate, const v8::Local<v8::String>& p_value)
+        {
+            if (const StringNameID id = find_value(isolate, p_value))
+            {
+                mark_as_used(id);
+                ++hits_;
+                return id;
+            }
+
+            ++misses_;
+            const StringName name = impl::Helper::to_string(isolate, p_value);
+            const StringNameID id = get_string_id(isolate, name);
+            Slot& slot = values_[id];
+            if (slot.ref_ && slot.ref_.object_ != p_value)
+            {
+                const bool removed = erase_value(slot.ref_.hash(), id);
+                JSB_LOG(Verbose, "(not recommended) update an existing string name %s", name);
+                jsb_check(removed);
+                jsb_unused(removed);
+            }
+            slot.ref_ = TStrongRef(isolate, p_value);
+            insert_value(slot.ref_.hash(), id);
+            JSB_LOG(VeryVerbose, "new string name pair (js) %s %d [slots:%d]", name, id, values_.size());
+            return id;
+        }
+
+        jsb_force_inline uint32_t get_mask() const { return (uint32_t) value_index_.size() - 1; }
+
+        StringNameID find_value(v8::Isolate* isolate, const v8::Local<v8::String>& p_value) const
+        {
+            const uint32_t hash = (uint32_t) p_value->GetIdentityHash();
+            const uint32_t mask = get_mask();
+#if JSB_WITH_V8
+            StringNameID same_content;
+#endif
+            for (uint32_t index = hash & mask; ; index = (index + 1) & mask)
+            {
+                const Bucket& bucket = value_index_[index];
+                if (!bucket.id) break;
+                if (bucket.hash != hash) continue;
+
+                const TStrongRef<v8::String>& ref = values_[bucket.id].ref_;
+                if (ref.object_ == p_value) return bucket.id;
+#if JSB_WITH_V8
+                // strings built at runtime (e.g. `"hp_" + id`) are always new objects,
+                // reuse the cached entry with the same content to avoid converting it again.
+                if (!same_content && ref.object_.Get(isolate)->StringEquals(p_value)) same_content = bucket.id;
+#endif
+            }
+#if JSB_WITH_V8
+            return same_content;
+#else
+            jsb_unused(isolate);
+            return {};
+#endif
+        }
+
+        void insert_value(uint32_t p_hash, const StringNameID& p_id)
+        {
+            if ((value_index_size_ + 1) * 2 > (int) value_index_.size())
+            {
+                // only possible if the cache size is unlimited
+                std::vector<Bucket> old_index(value_index_.size() * 2);
+                old_index.swap(value_index_);
+                value_index_size_ = 0;
+                for (const Bucket& bucket : old_index)
+                {
+                    if (bucket.id) insert_value(bucket.hash, bucket.id);
+                }
+            }
+
+            const uint32_t mask = get_mask();
+            uint32_t index = p_hash & mask;
+            while (value_index_[index].id) index = (index + 1) & mask;
+            value_index_[index] = { p_hash, p_id };
+            ++value_index_size_;
+        }
+
+        bool erase_value(uint32_t p_hash, const StringNameID& p_id)
+        {
+            const uint32_t mask = get_mask();
+            uint32_t index = p_hash & mask;
+            while (value_index_[index].id != p_id)
+            {
+                if (!value_index_[index].id) return false;
+                index = (index + 1) & mask;
+            }
+
+            // backward shift deletion, no tombstones are left in the table
+            for (uint32_t next = (index + 1) & mask; value_index_[next].id; next = (next + 1) & mask)
+            {
+                const uint32_t home = value_index_[next].hash & mask;
+                // move the entry back only if its home bucket is not in (index, next]
+                if (((next - home) & mask) >= ((next - index) & mask))
+                {
+                    value_index_[index] = value_index_[next];
+                    index = next;
+                }
+            }
+            value_index_[index] = {};
+            --value_index_size_;
+            return true;
+        }
+
+        void mark_as_used(const StringNameID id)
         {
             if constexpr (kMaxCacheSize <= 0) return;
 
@@ -133,23 +282,28 @@ namespace jsb
             jsb_check(values_.is_valid_index(id));
             jsb_check(values_.get_last_index() == id);
         }
-        
-        
+
+
         void remove_the_least_used(v8::Isolate* isolate)
         {
             if constexpr (kMaxCacheSize <= 0) return;
             if (values_.size() < kMaxCacheSize) return;
-            
+            remove_first();
+        }
+
+        void remove_first()
+        {
             const StringNameID id = values_.get_first_index();
             const Slot& slot = values_[id];
-            value_index_.erase(slot.ref_);
+            if (slot.ref_) erase_value(slot.ref_.hash(), id);
             name_index.erase(slot.name_);
+            ++evictions_;
+            JSB_LOG(VeryVerbose, "remove the least used string name %s %d [slots: %d]", slot.name_, id, values_.size());
             const StringNameID removed_id = values_.remove_first();
             jsb_check(removed_id == id);
             jsb_unused(removed_id);
-            JSB_LOG(VeryVerbose, "remove the least used string name %s %d [slots: %d]", slot.name_, id, values_.size());
         }
-        
+
         StringNameID get_string_id(v8::Isolate* isolate, const StringName& p_string_name)
         {
             if (const HashMap<StringName, StringNameID>::Iterator& it = name_index.find(p_string_name); it)
@@ -157,7 +311,7 @@ namespace jsb
                 mark_as_used(it->value);
                 return it->value;
             }
-            
+
             remove_the_least_used(isolate);
             const StringNameID id = values_.add(Slot(p_string_name));
             name_index.insert(p_string_name, id);
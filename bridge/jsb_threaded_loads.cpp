@@ -0,0 +1,88 @@
+#include "jsb_threaded_loads.h"
+#include "jsb_environment.h"
+#include "jsb_type_convert.h"
+
+#include "core/io/resource_loader.h"
+
+namespace jsb
+{
+    void ThreadedLoads::update(Environment* p_env)
+    {
+        v8::Isolate* isolate = p_env->get_isolate();
+        bool settled = false;
+        for (uint32_t index = 0; index < loads_.size();)
+        {
+            const Load& load = loads_[index];
+            const ResourceLoader::ThreadLoadStatus status = ResourceLoader::load_threaded_get_status(load.path);
+            if (status == ResourceLoader::THREAD_LOAD_IN_PROGRESS)
+            {
+                ++index;
+                continue;
+            }
+
+            // the request is released by `load_threaded_get` (even if it's failed), it doesn't block since it's not in progress
+            Ref<Resource> resource;
+            if (status != ResourceLoader::THREAD_LOAD_INVALID_RESOURCE)
+            {
+                resource = ResourceLoader::load_threaded_get(load.path);
+            }
+
+            v8::Global<v8::Promise::Resolver> resolver_handle;
+            if (p_env->take_pending_task(load.task_id, resolver_handle))
+            {
+                const Environment::BridgeScope bridge_scope(p_env);
+                const v8::Local<v8::Context> context = p_env->get_context();
+                const v8::Local<v8::Promise::Resolver> resolver = resolver_handle.Get(isolate);
+                resolver_handle.Reset();
+
+                v8::Local<v8::Value> value;
+                if (resource.is_valid() && TypeConvert::gd_var_to_js(isolate, context, resource, value))
+                {
+                    resolver->Resolve(context, value).Check();
+                }
+                else
+                {
+                    resolver->Reject(context, impl::Helper::new_string(isolate, jsb_format("failed to load %s (status %d)", load.path, status))).Check();
+                }
+                settled = true;
+            }
+
+            // the order of the pending loads doesn't matter
+            loads_.remove_at_unordered(index);
+        }
+        if (settled)
+        {
+            p_env->notify_microtasks_run();
+        }
+    }
+
+    void ThreadedLoads::_load_threaded(const v8::FunctionCallbackInfo<v8::Value>& info)
+    {
+        v8::Isolate* isolate = info.GetIsolate();
+        const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+        if (info.Length() == 0 || !info[0]->IsString())
+        {
+            jsb_throw(isolate, "bad path");
+            return;
+        }
+        const String path = impl::Helper::to_string(isolate, info[0]);
+        const String type_hint = info.Length() > 1 && info[1]->IsString() ? impl::Helper::to_string(isolate, info[1]) : String();
+        const bool use_sub_threads = info.Length() > 2 && info[2]->BooleanValue(isolate);
+
+        if (const Error err = ResourceLoader::load_threaded_request(path, type_hint, use_sub_threads); err != OK)
+        {
+            impl::Helper::throw_error(isolate, jsb_format("failed to load %s (%s)", path, jsb_ext_error_string(err)));
+            return;
+        }
+
+        Environment* env = Environment::wrap(isolate);
+        const v8::Local<v8::Promise::Resolver> resolver = v8::Promise::Resolver::New(context).ToLocalChecked();
+        env->get_threaded_loads().loads_.push_back({ path, env->add_pending_task(resolver) });
+        info.GetReturnValue().Set(resolver->GetPromise());
+    }
+
+    void ThreadedLoads::expose(v8::Isolate* isolate, v8::Local<v8::Context> context, v8::Local<v8::Object> jsb_obj)
+    {
+        jsb_obj->Set(context, impl::Helper::new_string_ascii(isolate, "load_threaded"), JSB_NEW_FUNCTION(context, _load_threaded, {})).Check();
+    }
+}
@@ -0,0 +1,40 @@
+#ifndef GODOTJS_THREADED_LOADS_H
+#define GODOTJS_THREADED_LOADS_H
+#include "jsb_bridge_pch.h"
+
+namespace jsb
+{
+    class Environment;
+
+    /**
+     * The resources requested by `jsb.load_threaded` (ResourceLoader threaded loads), each of them settles a pending promise.
+     * All pending loads are polled natively in one pass at the end of `Environment::update`,
+     * instead of calling `ResourceLoader.load_threaded_get_status` from scripts for each of them in every frame.
+     */
+    class ThreadedLoads
+    {
+    public:
+        jsb_force_inline bool is_empty() const { return loads_.is_empty(); }
+
+        // settle the promises of the finished loads
+        void update(Environment* p_env);
+
+        // the requests are not waited (it'd block until they're loaded), ResourceLoader keeps them until they're done
+        void clear() { loads_.clear(); }
+
+        static void expose(v8::Isolate* isolate, v8::Local<v8::Context> context, v8::Local<v8::Object> jsb_obj);
+
+    private:
+        struct Load
+        {
+            String path;
+            internal::Index32 task_id;
+        };
+
+        // [js] function load_threaded(path: string, type_hint?: string, use_sub_threads?: boolean): Promise<Resource>
+        static void _load_threaded(const v8::FunctionCallbackInfo<v8::Value>& info);
+
+        LocalVector<Load> loads_;
+    };
+}
+#endif
@@ -6,13 +6,13 @@ namespace jsb
 {
     void JavaScriptTimerAction::operator()(v8::Isolate* isolate)
     {
-        if (!function_)
+        if (function_.IsEmpty())
         {
             JSB_LOG(Warning, "Ignored attempt to execute a unassigned/moved/destroyed JavaScriptTimerAction");
             return;
         }
 
-        const v8::Local<v8::Function> func = function_->Get(isolate);
+        const v8::Local<v8::Function> func = function_.Get(isolate);
         const v8::Local<v8::Context> context = func->GetCreationContextChecked();
 
         jsb_checkf(Environment::wrap(context), "timer triggered after Environment disposed");
@@ -27,7 +27,14 @@ namespace jsb
             for (int index = 0; index < argc_; ++index)
             {
                 memnew_placement(&argv[index], LocalValue);
-                argv[index] = argv_[index].Get(isolate);
+                if (index < kInlineArgc)
+                {
+                    argv[index] = inline_argv_[index].Get(isolate);
+                }
+                else if (!rest_argv_.Get(isolate)->Get(context, index - kInlineArgc).ToLocal(&argv[index]))
+                {
+                    argv[index] = v8::Undefined(isolate);
+                }
             }
             result = func->Call(context, v8::Undefined(isolate), argc_, argv);
             for (int index = 0; index < argc_; ++index)
@@ -52,7 +59,7 @@ namespace jsb
 #endif
         if (try_catch.has_caught())
         {
-            JSB_LOG(Error, "timer error %s", BridgeHelper::get_exception(try_catch));
+            BridgeHelper::log_exception(try_catch, "timer error ");
         }
     }
 }
@@ -6,80 +6,49 @@
 namespace jsb
 {
     /**
-     * This struct is *not* POD, but aims to be compatible with SArray's memory relocation logic.
+     * This struct is *not* POD, but aims to be compatible with SArray's memory relocation logic
+     * (the handles are moved bitwise with the timer slots, nothing is allocated separately).
      */
     struct JavaScriptTimerAction
     {
-        jsb_force_inline JavaScriptTimerAction(): function_(nullptr), argc_(0), argv_(nullptr)
-        {
-        }
+        // the number of arguments stored in the action itself, the rest of them are packed in one JS array
+        static constexpr int kInlineArgc = 2;
 
-        jsb_force_inline JavaScriptTimerAction(v8::Global<v8::Function>&& p_func, int p_argc) : argc_(p_argc)
-        {
-            function_ = new v8::Global<v8::Function>(std::move(p_func));
+        JavaScriptTimerAction() = default;
 
-            if (p_argc > 0)
+        JavaScriptTimerAction(v8::Isolate* isolate, const v8::Local<v8::Context>& context, const v8::Local<v8::Function>& p_func, const v8::Local<v8::Value>* p_argv, int p_argc)
+            : function_(isolate, p_func), argc_(p_argc)
+        {
+            for (int index = 0, n = MIN(p_argc, kInlineArgc); index < n; ++index)
             {
-                argv_ = new v8::Global<v8::Value>[p_argc];
+                inline_argv_[index].Reset(isolate, p_argv[index]);
             }
-            else
+            if (p_argc > kInlineArgc)
             {
-                argv_ = nullptr;
+                const v8::Local<v8::Array> rest = v8::Array::New(isolate, p_argc - kInlineArgc);
+                for (int index = kInlineArgc; index < p_argc; ++index)
+                {
+                    rest->Set(context, index - kInlineArgc, p_argv[index]).Check();
+                }
+                rest_argv_.Reset(isolate, rest);
             }
         }
 
-        jsb_force_inline ~JavaScriptTimerAction()
-        {
-            delete function_;
-            delete[] argv_;
-            function_ = nullptr;
-            argv_ = nullptr;
-        }
-
-        JavaScriptTimerAction(JavaScriptTimerAction& p_other) = delete;
-
-        jsb_force_inline JavaScriptTimerAction(JavaScriptTimerAction&& p_other) noexcept
-            : function_(p_other.function_), argc_(p_other.argc_), argv_(p_other.argv_)
-        {
-            p_other.function_ = nullptr;
-            p_other.argc_ = 0;
-            p_other.argv_ = nullptr;
-        }
-
-        JavaScriptTimerAction& operator=(JavaScriptTimerAction& p_other) = delete;
-
-        jsb_force_inline JavaScriptTimerAction& operator=(JavaScriptTimerAction&& p_other) noexcept
-        {
-            if (this != &p_other)
-            {
-                delete function_;
-                delete[] argv_;
-
-                function_ = p_other.function_;
-                argc_ = p_other.argc_;
-                argv_ = p_other.argv_;
+        JavaScriptTimerAction(const JavaScriptTimerAction& p_other) = delete;
+        JavaScriptTimerAction& operator=(const JavaScriptTimerAction& p_other) = delete;
 
-                p_other.function_ = nullptr;
-                p_other.argc_ = 0;
-                p_other.argv_ = nullptr;
-            }
-            return *this;
-        }
-
-        jsb_force_inline explicit operator bool() const { return function_ && !function_->IsEmpty(); }
+        JavaScriptTimerAction(JavaScriptTimerAction&& p_other) noexcept = default;
+        JavaScriptTimerAction& operator=(JavaScriptTimerAction&& p_other) noexcept = default;
 
-        jsb_force_inline void store(int index, v8::Global<v8::Value>&& value)
-        {
-            jsb_check(index >= 0 && index < argc_);
-            argv_[index] = std::move(value);
-        }
+        jsb_force_inline explicit operator bool() const { return !function_.IsEmpty(); }
 
         void operator()(v8::Isolate* isolate);
 
     private:
-        v8::Global<v8::Function>* function_;
-        int argc_;
-        v8::Global<v8::Value>* argv_;
+        v8::Global<v8::Function> function_;
+        int argc_ = 0;
+        v8::Global<v8::Value> inline_argv_[kInlineArgc];
+        v8::Global<v8::Array> rest_argv_;
     };
 }
 #endif
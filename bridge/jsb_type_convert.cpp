@@ -1,6 +1,8 @@
 ﻿#include "jsb_type_convert.h"
 #include "jsb_environment.h"
 
+#include <array>
+
 // Not ideal. Need to clean up access.
 #include "../weaver/jsb_script_language.h"
 #include "../weaver/jsb_script.h"
@@ -11,13 +13,31 @@ namespace jsb
     template<typename T>
     static bool try_convert_array(v8::Isolate* isolate, const v8::Local<v8::Context>& context, v8::Local<v8::Value> p_val, Variant& r_packed)
     {
-        if constexpr (GetTypeInfo<T>::METADATA == GodotTypeInfo::METADATA_INT_IS_UINT8)
+        // plain old data can be copied from the binary buffer directly
+        if constexpr (!std::is_same_v<T, String>)
         {
             if (p_val->IsArrayBuffer())
             {
-                r_packed = impl::Helper::to_packed_byte_array(isolate, p_val.As<v8::ArrayBuffer>());
+                Vector<T> packed;
+                if (!impl::Helper::to_packed_array(isolate, p_val.As<v8::ArrayBuffer>(), packed))
+                {
+                    return false;
+                }
+                r_packed = packed;
                 return true;
             }
+#if JSB_WITH_V8
+            if (p_val->IsArrayBufferView())
+            {
+                Vector<T> packed;
+                if (!impl::Helper::to_packed_array(isolate, p_val.As<v8::ArrayBufferView>(), packed))
+                {
+                    return false;
+                }
+                r_packed = packed;
+                return true;
+            }
+#endif
         }
 
 #if JSB_IMPLICIT_PACKED_ARRAY_CONVERSION
@@ -52,7 +72,15 @@ namespace jsb
 #endif
     }
 
-    static bool try_convert_array_any(v8::Isolate* isolate, const v8::Local<v8::Context>& context, v8::Local<v8::Value> p_val, Variant& r_packed)
+    // convert an array element as the element type of a typed array (or loosely if `p_element_type` is NIL)
+    jsb_force_inline static bool convert_array_element(v8::Isolate* isolate, const v8::Local<v8::Context>& context, const v8::Local<v8::Value>& p_element, Variant::Type p_element_type, Variant& r_element)
+    {
+        return p_element_type == Variant::NIL
+            ? TypeConvert::js_to_gd_var(isolate, context, p_element, r_element)
+            : TypeConvert::js_to_gd_var(isolate, context, p_element, p_element_type, r_element);
+    }
+
+    static bool try_convert_array_any(v8::Isolate* isolate, const v8::Local<v8::Context>& context, v8::Local<v8::Value> p_val, Variant::Type p_element_type, Variant& r_packed)
     {
 #if JSB_IMPLICIT_PACKED_ARRAY_CONVERSION
         if (!p_val->IsArray())
@@ -64,11 +92,45 @@ namespace jsb
         const uint32_t len = array->Length();
         Array packed;
         packed.resize((int)len);
-        for (uint32_t index = 0; index < len; ++index)
+        uint32_t start = 0;
+#if JSB_WITH_V8
+#if V8_VERSION_NEWER_THAN(11, 0, 0)
+        // iterate the elements without the property lookups as long as they can be converted without calling back into v8,
+        // the rest of elements (strings, plain objects, proxies and failures) are converted with `Get` below
+        struct IterateState
+        {
+            v8::Isolate* isolate;
+            const v8::Local<v8::Context>* context;
+            Array* packed;
+            Variant::Type element_type;
+            uint32_t next;
+        } state { isolate, &context, &packed, p_element_type, 0 };
+        const bool iterated = array->Iterate(context, [](uint32_t index, v8::Local<v8::Value> element, void* data)
+        {
+            IterateState& state = *(IterateState*) data;
+            if (!element->IsNumber() && !element->IsBoolean() && !element->IsNullOrUndefined()
+                && !(element->IsObject() && element.As<v8::Object>()->InternalFieldCount() != 0))
+            {
+                return v8::Array::CallbackResult::kBreak;
+            }
+            Variant element_var;
+            if (!convert_array_element(state.isolate, *state.context, element, state.element_type, element_var))
+            {
+                return v8::Array::CallbackResult::kBreak;
+            }
+            state.packed->set((int) index, element_var);
+            state.next = index + 1;
+            return v8::Array::CallbackResult::kContinue;
+        }, &state).IsJust();
+        jsb_unused(iterated);
+        start = state.next;
+#endif
+#endif
+        for (uint32_t index = start; index < len; ++index)
         {
             v8::Local<v8::Value> element;
             Variant element_var;
-            if (array->Get(context, index).ToLocal(&element) && TypeConvert::js_to_gd_var(isolate, context, element, element_var))
+            if (array->Get(context, index).ToLocal(&element) && convert_array_element(isolate, context, element, p_element_type, element_var))
             {
                 packed.set((int) index, element_var);
             }
@@ -76,7 +138,7 @@ namespace jsb
             {
                 // be cautious here, we silently omit conversion failures
                 packed.set((int) index, {});
-                JSB_LOG(Warning, "failed to convert array element %d (loosely), it'll be left as the default value", index);
+                JSB_LOG(Warning, "failed to convert array element %d (%s), it'll be left as the default value", index, p_element_type == Variant::NIL ? "loosely" : Variant::get_type_name(p_element_type));
             }
         }
         r_packed = packed;
@@ -86,6 +148,160 @@ namespace jsb
 #endif
     }
 
+    // plain javascript objects (not bound to any native object, and not callable)
+    jsb_force_inline static bool is_plain_object(const v8::Local<v8::Value>& p_val)
+    {
+        return p_val->IsObject() && !p_val->IsArray() && !p_val->IsFunction() && !p_val->IsProxy()
+            && p_val.As<v8::Object>()->InternalFieldCount() == 0;
+    }
+
+    static bool deep_js_to_gd(v8::Isolate* isolate, const v8::Local<v8::Context>& context, const v8::Local<v8::Value>& p_val, Variant& r_cvar, int p_depth);
+
+    static bool deep_js_to_gd_array(v8::Isolate* isolate, const v8::Local<v8::Context>& context, const v8::Local<v8::Array>& p_array, Array& r_array, int p_depth)
+    {
+        const uint32_t len = p_array->Length();
+        r_array.resize((int) len);
+        for (uint32_t index = 0; index < len; ++index)
+        {
+            v8::Local<v8::Value> element;
+            Variant element_var;
+            if (!p_array->Get(context, index).ToLocal(&element) || !deep_js_to_gd(isolate, context, element, element_var, p_depth + 1))
+            {
+                return false;
+            }
+            r_array.set((int) index, element_var);
+        }
+        return true;
+    }
+
+    static bool deep_js_to_gd_dictionary(v8::Isolate* isolate, const v8::Local<v8::Context>& context, const v8::Local<v8::Object>& p_object, Dictionary& r_dict, int p_depth)
+    {
+        constexpr v8::PropertyFilter property_filter = (v8::PropertyFilter)(v8::PropertyFilter::ONLY_ENUMERABLE | v8::PropertyFilter::SKIP_SYMBOLS);
+        v8::Local<v8::Array> keys;
+        if (!p_object->GetOwnPropertyNames(context, property_filter, v8::KeyConversionMode::kNoNumbers).ToLocal(&keys))
+        {
+            return false;
+        }
+        Environment* env = Environment::wrap(isolate);
+        for (uint32_t index = 0, len = keys->Length(); index < len; ++index)
+        {
+            v8::Local<v8::Value> key;
+            v8::Local<v8::Value> value;
+            Variant value_var;
+            if (!keys->Get(context, index).ToLocal(&key) || !key->IsString()
+                || !p_object->Get(context, key).ToLocal(&value) || !deep_js_to_gd(isolate, context, value, value_var, p_depth + 1))
+            {
+                return false;
+            }
+            // the keys are usually a small set of names, cache them as the other string names
+            r_dict[(String) env->get_string_name(key.As<v8::String>())] = value_var;
+        }
+        return true;
+    }
+
+    static bool deep_js_to_gd(v8::Isolate* isolate, const v8::Local<v8::Context>& context, const v8::Local<v8::Value>& p_val, Variant& r_cvar, int p_depth)
+    {
+        if (p_depth > JSB_DEEP_CONTAINER_CONVERSION_MAX_DEPTH)
+        {
+            JSB_LOG(Error, "too deep nested containers (cyclic reference?)");
+            return false;
+        }
+        if (p_val->IsArray())
+        {
+            Array array;
+            if (!deep_js_to_gd_array(isolate, context, p_val.As<v8::Array>(), array, p_depth)) return false;
+            r_cvar = array;
+            return true;
+        }
+        if (is_plain_object(p_val))
+        {
+            Dictionary dict;
+            if (!deep_js_to_gd_dictionary(isolate, context, p_val.As<v8::Object>(), dict, p_depth)) return false;
+            r_cvar = dict;
+            return true;
+        }
+        return TypeConvert::js_to_gd_var(isolate, context, p_val, r_cvar);
+    }
+
+    static bool deep_gd_to_js(v8::Isolate* isolate, const v8::Local<v8::Context>& context, const Variant& p_cvar, v8::Local<v8::Value>& r_jval, int p_depth)
+    {
+        if (p_depth > JSB_DEEP_CONTAINER_CONVERSION_MAX_DEPTH)
+        {
+            JSB_LOG(Error, "too deep nested containers (cyclic reference?)");
+            return false;
+        }
+        switch (p_cvar.get_type())
+        {
+        case Variant::ARRAY:
+            {
+                const Array array = p_cvar;
+                const int len = array.size();
+#if JSB_WITH_V8
+                // create the array with all elements at once
+                std::vector<v8::Local<v8::Value>> elements(len);
+                for (int index = 0; index < len; ++index)
+                {
+                    if (!deep_gd_to_js(isolate, context, array[index], elements[index], p_depth + 1))
+                    {
+                        return false;
+                    }
+                }
+                r_jval = v8::Array::New(isolate, elements.data(), elements.size());
+#else
+                const v8::Local<v8::Array> jarray = v8::Array::New(isolate, len);
+                for (int index = 0; index < len; ++index)
+                {
+                    v8::Local<v8::Value> element;
+                    if (!deep_gd_to_js(isolate, context, array[index], element, p_depth + 1)
+                        || !jarray->Set(context, index, element).FromMaybe(false))
+                    {
+                        return false;
+                    }
+                }
+                r_jval = jarray;
+#endif
+                return true;
+            }
+        case Variant::DICTIONARY:
+            {
+                const Dictionary dict = p_cvar;
+                Environment* env = Environment::wrap(isolate);
+                const v8::Local<v8::Object> jobject = v8::Object::New(isolate);
+                for (const KeyValue<Variant, Variant>& kv : dict)
+                {
+                    // only the keys representable as property names are accepted
+                    v8::Local<v8::Value> key;
+                    switch (kv.key.get_type())
+                    {
+                    case Variant::STRING:
+                    case Variant::STRING_NAME: key = env->get_string_value(kv.key); break;
+                    case Variant::INT: key = impl::Helper::new_integer(isolate, kv.key); break;
+                    default: return false;
+                    }
+                    v8::Local<v8::Value> value;
+                    if (!deep_gd_to_js(isolate, context, kv.value, value, p_depth + 1)
+                        || !jobject->Set(context, key, value).FromMaybe(false))
+                    {
+                        return false;
+                    }
+                }
+                r_jval = jobject;
+                return true;
+            }
+        default: return TypeConvert::gd_var_to_js(isolate, context, p_cvar, r_jval);
+        }
+    }
+
+    bool TypeConvert::js_to_gd_var_deep(v8::Isolate* isolate, const v8::Local<v8::Context>& context, const v8::Local<v8::Value>& p_jval, Variant& r_cvar)
+    {
+        return deep_js_to_gd(isolate, context, p_jval, r_cvar, 0);
+    }
+
+    bool TypeConvert::gd_var_to_js_deep(v8::Isolate* isolate, const v8::Local<v8::Context>& context, const Variant& p_cvar, v8::Local<v8::Value>& r_jval)
+    {
+        return deep_gd_to_js(isolate, context, p_cvar, r_jval, 0);
+    }
+
     String TypeConvert::js_debug_typeof(v8::Isolate* isolate, const v8::Local<v8::Value>& p_jval)
     {
         if (p_jval.IsEmpty())
@@ -146,11 +362,8 @@ namespace jsb
     // translate js val into gd variant with an expected type
     bool TypeConvert::js_to_gd_var(v8::Isolate* isolate, const v8::Local<v8::Context>& context, const v8::Local<v8::Value>& p_jval, Variant::Type p_type, Variant& r_cvar)
     {
-#if JSB_WITH_V8
+        // every impl detects a Proxy without any property lookup (a conservative check on some of them, but never for objects bound to native)
         if (p_jval->IsProxy())
-#else
-        if (p_jval->IsObject())
-#endif
         {
             v8::Local<v8::Object> object = v8::Local<v8::Object>::Cast(p_jval);
             v8::MaybeLocal<v8::Value> target = object->Get(context, Environment::wrap(isolate)->get_symbol(Symbols::ProxyTarget));
@@ -251,7 +464,24 @@ namespace jsb
         case Variant::PACKED_VECTOR2_ARRAY: if (try_convert_array<Vector2>(isolate, context, p_jval, r_cvar)) return true; goto FALLBACK_TO_VARIANT;  // NOLINT(cppcoreguidelines-avoid-goto, hicpp-avoid-goto)
         case Variant::PACKED_VECTOR3_ARRAY: if (try_convert_array<Vector3>(isolate, context, p_jval, r_cvar)) return true; goto FALLBACK_TO_VARIANT;  // NOLINT(cppcoreguidelines-avoid-goto, hicpp-avoid-goto)
         case Variant::PACKED_COLOR_ARRAY:   if (try_convert_array<Color>(isolate, context, p_jval, r_cvar))   return true; goto FALLBACK_TO_VARIANT;  // NOLINT(cppcoreguidelines-avoid-goto, hicpp-avoid-goto)
-        case Variant::ARRAY:                if (try_convert_array_any(isolate, context, p_jval, r_cvar))      return true; goto FALLBACK_TO_VARIANT;  // NOLINT(cppcoreguidelines-avoid-goto, hicpp-avoid-goto)
+#if JSB_DEEP_CONTAINER_CONVERSION
+        case Variant::ARRAY:
+            if (Array array; p_jval->IsArray() && deep_js_to_gd_array(isolate, context, p_jval.As<v8::Array>(), array, 0))
+            {
+                r_cvar = array;
+                return true;
+            }
+            goto FALLBACK_TO_VARIANT;  // NOLINT(cppcoreguidelines-avoid-goto, hicpp-avoid-goto)
+        case Variant::DICTIONARY:
+            if (Dictionary dict; is_plain_object(p_jval) && deep_js_to_gd_dictionary(isolate, context, p_jval.As<v8::Object>(), dict, 0))
+            {
+                r_cvar = dict;
+                return true;
+            }
+            goto FALLBACK_TO_VARIANT;  // NOLINT(cppcoreguidelines-avoid-goto, hicpp-avoid-goto)
+#else
+        case Variant::ARRAY:                if (try_convert_array_any(isolate, context, p_jval, Variant::NIL, r_cvar)) return true; goto FALLBACK_TO_VARIANT;  // NOLINT(cppcoreguidelines-avoid-goto, hicpp-avoid-goto)
+#endif
         // math types
         case Variant::VECTOR2:
         case Variant::VECTOR2I:
@@ -274,7 +504,9 @@ namespace jsb
         case Variant::RID:
         case Variant::CALLABLE:
         case Variant::SIGNAL:
+#if !JSB_DEEP_CONTAINER_CONVERSION
         case Variant::DICTIONARY:
+#endif
             {
                 FALLBACK_TO_VARIANT:
                 if (!p_jval->IsObject())
@@ -368,8 +600,19 @@ namespace jsb
         case Variant::RID:
         case Variant::CALLABLE:
         case Variant::SIGNAL:
+#if JSB_DEEP_CONTAINER_CONVERSION
         case Variant::DICTIONARY:
         case Variant::ARRAY:
+            if (v8::Local<v8::Value> jval; p_cvar.get_type() == p_type && deep_gd_to_js(isolate, context, p_cvar, jval, 0))
+            {
+                r_jval = jval;
+                return true;
+            }
+            goto WRAP_AS_VARIANT;  // NOLINT(cppcoreguidelines-avoid-goto, hicpp-avoid-goto)
+#else
+        case Variant::DICTIONARY:
+        case Variant::ARRAY:
+#endif
 
         // typed arrays
         case Variant::PACKED_BYTE_ARRAY:
@@ -382,6 +625,9 @@ namespace jsb
         case Variant::PACKED_VECTOR3_ARRAY:
         case Variant::PACKED_COLOR_ARRAY:
             {
+#if JSB_DEEP_CONTAINER_CONVERSION
+                WRAP_AS_VARIANT:
+#endif
                 // nil var is considered as acceptable here (in the case of set_script_property_value called from godot scene state restoring)
                 jsb_checkf(p_cvar.get_type() == Variant::NIL || Variant::can_convert(p_cvar.get_type(), p_type),
                     "variant type can't convert to %s from %s",
@@ -394,7 +640,7 @@ namespace jsb
                     r_jval = class_info->clazz.NewInstance(context);
                     jsb_check(TypeConvert::is_variant(r_jval.As<v8::Object>()));
 
-                    env->bind_valuetype(env->alloc_variant(p_cvar), r_jval.As<v8::Object>());
+                    env->bind_valuetype_copy(p_cvar, r_jval.As<v8::Object>());
                     return true;
                 }
                 return false;
@@ -414,6 +660,179 @@ namespace jsb
         }
     }
 
+    namespace
+    {
+        template<Variant::Type TYPE>
+        struct TTypedConverter
+        {
+            static bool js_to_gd(v8::Isolate* isolate, const v8::Local<v8::Context>& context, const v8::Local<v8::Value>& p_jval, Variant& r_cvar)
+            {
+                return TypeConvert::js_to_gd_var(isolate, context, p_jval, TYPE, r_cvar);
+            }
+
+            static bool gd_to_js(v8::Isolate* isolate, const v8::Local<v8::Context>& context, const Variant& p_cvar, v8::Local<v8::Value>& r_jval)
+            {
+                return TypeConvert::gd_var_to_js(isolate, context, p_cvar, TYPE, r_jval);
+            }
+        };
+
+        // fast paths of the most common argument types,
+        // anything else (proxies, null values and failures) falls back to the generic conversion for the same result
+
+        template<>
+        bool TTypedConverter<Variant::FLOAT>::js_to_gd(v8::Isolate* isolate, const v8::Local<v8::Context>& context, const v8::Local<v8::Value>& p_jval, Variant& r_cvar)
+        {
+            if (p_jval->IsNumber())
+            {
+                r_cvar = p_jval.As<v8::Number>()->Value();
+                return true;
+            }
+            return TypeConvert::js_to_gd_var(isolate, context, p_jval, Variant::FLOAT, r_cvar);
+        }
+
+        template<>
+        bool TTypedConverter<Variant::INT>::js_to_gd(v8::Isolate* isolate, const v8::Local<v8::Context>& context, const v8::Local<v8::Value>& p_jval, Variant& r_cvar)
+        {
+            if (int64_t val; impl::Helper::to_int64(p_jval, val))
+            {
+                r_cvar = val;
+                return true;
+            }
+            return TypeConvert::js_to_gd_var(isolate, context, p_jval, Variant::INT, r_cvar);
+        }
+
+        // enum and bitfield arguments are almost always passed as small integers (Smi in v8, JS_TAG_INT in quickjs)
+        bool js_to_gd_enum(v8::Isolate* isolate, const v8::Local<v8::Context>& context, const v8::Local<v8::Value>& p_jval, Variant& r_cvar)
+        {
+            if (jsb_likely(p_jval->IsInt32()))
+            {
+                r_cvar = (int64_t) p_jval.As<v8::Int32>()->Value();
+                return true;
+            }
+            return TTypedConverter<Variant::INT>::js_to_gd(isolate, context, p_jval, r_cvar);
+        }
+
+        template<>
+        bool TTypedConverter<Variant::BOOL>::js_to_gd(v8::Isolate* isolate, const v8::Local<v8::Context>& context, const v8::Local<v8::Value>& p_jval, Variant& r_cvar)
+        {
+            if (p_jval->IsBoolean())
+            {
+                r_cvar = p_jval->BooleanValue(isolate);
+                return true;
+            }
+            return TypeConvert::js_to_gd_var(isolate, context, p_jval, Variant::BOOL, r_cvar);
+        }
+
+        template<>
+        bool TTypedConverter<Variant::STRING_NAME>::js_to_gd(v8::Isolate* isolate, const v8::Local<v8::Context>& context, const v8::Local<v8::Value>& p_jval, Variant& r_cvar)
+        {
+            if (p_jval->IsString())
+            {
+                r_cvar = Environment::wrap(isolate)->get_string_name(p_jval.As<v8::String>());
+                return true;
+            }
+            return TypeConvert::js_to_gd_var(isolate, context, p_jval, Variant::STRING_NAME, r_cvar);
+        }
+
+        template<>
+        bool TTypedConverter<Variant::OBJECT>::js_to_gd(v8::Isolate* isolate, const v8::Local<v8::Context>& context, const v8::Local<v8::Value>& p_jval, Variant& r_cvar)
+        {
+            // objects bound to native are never proxies
+            if (p_jval->IsObject())
+            {
+                if (const v8::Local<v8::Object> self = p_jval.As<v8::Object>(); TypeConvert::is_object(self))
+                {
+                    void* pointer = self->GetAlignedPointerFromInternalField(IF_Pointer);
+                    r_cvar = Environment::wrap(isolate)->verify_object(pointer) ? (Object*) pointer : nullptr;
+                    return true;
+                }
+            }
+            return TypeConvert::js_to_gd_var(isolate, context, p_jval, Variant::OBJECT, r_cvar);
+        }
+
+        template<>
+        bool TTypedConverter<Variant::FLOAT>::gd_to_js(v8::Isolate* isolate, const v8::Local<v8::Context>& context, const Variant& p_cvar, v8::Local<v8::Value>& r_jval)
+        {
+            r_jval = v8::Number::New(isolate, p_cvar);
+            return true;
+        }
+
+        template<>
+        bool TTypedConverter<Variant::INT>::gd_to_js(v8::Isolate* isolate, const v8::Local<v8::Context>& context, const Variant& p_cvar, v8::Local<v8::Value>& r_jval)
+        {
+            // the type is known here, read it without the conversion switch of Variant
+            r_jval = p_cvar.get_type() == Variant::INT
+                ? impl::Helper::new_integer(isolate, *VariantInternal::get_int(&p_cvar))
+                : impl::Helper::new_integer(isolate, p_cvar);
+            return true;
+        }
+
+        template<>
+        bool TTypedConverter<Variant::BOOL>::gd_to_js(v8::Isolate* isolate, const v8::Local<v8::Context>& context, const Variant& p_cvar, v8::Local<v8::Value>& r_jval)
+        {
+            r_jval = v8::Boolean::New(isolate, p_cvar);
+            return true;
+        }
+
+        template<Variant::Type ELEMENT_TYPE>
+        struct TTypedArrayConverter
+        {
+            static bool js_to_gd(v8::Isolate* isolate, const v8::Local<v8::Context>& context, const v8::Local<v8::Value>& p_jval, Variant& r_cvar)
+            {
+                if (try_convert_array_any(isolate, context, p_jval, ELEMENT_TYPE, r_cvar))
+                {
+                    return true;
+                }
+                return TypeConvert::js_to_gd_var(isolate, context, p_jval, Variant::ARRAY, r_cvar);
+            }
+        };
+
+        template<size_t... Is>
+        constexpr std::array<TypeConvert::JSToGDFunc, Variant::VARIANT_MAX> make_js_to_gd_array_funcs(std::index_sequence<Is...>)
+        {
+            return { &TTypedArrayConverter<(Variant::Type) Is>::js_to_gd... };
+        }
+
+        template<size_t... Is>
+        constexpr std::array<TypeConvert::JSToGDFunc, Variant::VARIANT_MAX> make_js_to_gd_funcs(std::index_sequence<Is...>)
+        {
+            return { &TTypedConverter<(Variant::Type) Is>::js_to_gd... };
+        }
+
+        template<size_t... Is>
+        constexpr std::array<TypeConvert::GDToJSFunc, Variant::VARIANT_MAX> make_gd_to_js_funcs(std::index_sequence<Is...>)
+        {
+            return { &TTypedConverter<(Variant::Type) Is>::gd_to_js... };
+        }
+
+        constexpr std::array<TypeConvert::JSToGDFunc, Variant::VARIANT_MAX> kJSToGDFuncs = make_js_to_gd_funcs(std::make_index_sequence<Variant::VARIANT_MAX>());
+        constexpr std::array<TypeConvert::GDToJSFunc, Variant::VARIANT_MAX> kGDToJSFuncs = make_gd_to_js_funcs(std::make_index_sequence<Variant::VARIANT_MAX>());
+        constexpr std::array<TypeConvert::JSToGDFunc, Variant::VARIANT_MAX> kJSToGDArrayFuncs = make_js_to_gd_array_funcs(std::make_index_sequence<Variant::VARIANT_MAX>());
+    }
+
+    TypeConvert::JSToGDFunc TypeConvert::get_js_to_gd_func(Variant::Type p_type)
+    {
+        jsb_check(p_type >= 0 && p_type < Variant::VARIANT_MAX);
+        return kJSToGDFuncs[p_type];
+    }
+
+    TypeConvert::GDToJSFunc TypeConvert::get_gd_to_js_func(Variant::Type p_type)
+    {
+        jsb_check(p_type >= 0 && p_type < Variant::VARIANT_MAX);
+        return kGDToJSFuncs[p_type];
+    }
+
+    TypeConvert::JSToGDFunc TypeConvert::get_js_to_gd_enum_func()
+    {
+        return js_to_gd_enum;
+    }
+
+    TypeConvert::JSToGDFunc TypeConvert::get_js_to_gd_array_func(Variant::Type p_element_type)
+    {
+        jsb_check(p_element_type >= 0 && p_element_type < Variant::VARIANT_MAX);
+        return kJSToGDArrayFuncs[p_element_type];
+    }
+
     bool TypeConvert::gd_obj_to_js(v8::Isolate* isolate, const v8::Local<v8::Context>& context, Object* p_godot_obj, v8::Local<v8::Object>& r_jval)
     {
         jsb_check(p_godot_obj);
@@ -446,7 +865,7 @@ namespace jsb
 
         const StringName& class_name = p_godot_obj->get_class_name();
         if (NativeClassID class_id;
-            NativeClassInfoPtr class_info = environment->expose_godot_object_class(ClassDB::classes.getptr(class_name), &class_id))
+            NativeClassInfoPtr class_info = environment->expose_godot_object_class(class_name, &class_id))
         {
             // class_info ptr will be invalid after escape()
             // to avoid possible side effects during `NewInstance`
@@ -454,7 +873,8 @@ namespace jsb
             jsb_check(TypeConvert::is_object(r_jval));
 
             // the lifecycle will be managed by javascript runtime, DO NOT DELETE it externally
-            environment->bind_godot_object(class_id, p_godot_obj, r_jval.As<v8::Object>());
+            // (unless it's weakly bound, the engine still owns it)
+            environment->bind_godot_object(class_id, p_godot_obj, r_jval.As<v8::Object>(), si == nullptr);
             return true;
         }
         JSB_LOG(Error, "failed to expose godot class '%s'", class_name);
@@ -515,9 +935,7 @@ namespace jsb
         {
             const v8::Local<v8::Object> self = p_jval.As<v8::Object>();
 
-#if JSB_WITH_V8
             if (p_jval->IsProxy())
-#endif
             {
                 v8::MaybeLocal<v8::Value> target = self->Get(context, Environment::wrap(isolate)->get_symbol(Symbols::ProxyTarget));
                 if (!target.IsEmpty())
@@ -539,6 +957,9 @@ namespace jsb
                     r_cvar = Environment::wrap(isolate)->verify_object(pointer) ? (Object*) pointer : nullptr;
                     return true;
                 }
+#if JSB_DEEP_CONTAINER_CONVERSION
+            case 0: return (p_jval->IsArray() || is_plain_object(p_jval)) && deep_js_to_gd(isolate, context, p_jval, r_cvar, 0);
+#endif
             default: return false;
             }
         }
@@ -624,6 +1045,9 @@ namespace jsb
         case Variant::SIGNAL:
         case Variant::DICTIONARY:
             {
+#if JSB_DEEP_CONTAINER_CONVERSION
+                if (p_type == Variant::DICTIONARY && is_plain_object(p_val)) return true;
+#endif
                 FALLBACK_TO_VARIANT:
                 if (!p_val->IsObject())
                 {
@@ -653,32 +1077,32 @@ namespace jsb
             return false;
         }
 
-#if JSB_WITH_V8
-        if (p_jval->IsProxy())
-#else
-        if (p_jval->IsObject())
-#endif
+        // fast path: bound objects always have internal fields, read them directly.
+        // a Proxy never has internal fields, so the ProxyTarget lookup is only needed for objects without them.
+        const v8::Local<v8::Object> self = p_jval.As<v8::Object>();
+        if (jsb_likely(TypeConvert::is_object(self)))
         {
-            v8::Local<v8::Object> object = v8::Local<v8::Object>::Cast(p_jval);
-            v8::MaybeLocal<v8::Value> target = object->Get(context, Environment::wrap(isolate)->get_symbol(Symbols::ProxyTarget));
-            if (!target.IsEmpty())
+            // return false if strict type check fails
+            if ((NativeClassType::Type)(uintptr_t) self->GetAlignedPointerFromInternalField(IF_ClassType) != NativeClassType::GodotObject)
             {
-                return js_to_gd_obj(isolate, context, target.ToLocalChecked(), r_godot_obj);
+                return false;
             }
+
+            // dead objects return true with a nullptr
+            void* pointer = self->GetAlignedPointerFromInternalField(IF_Pointer);
+            r_godot_obj = Environment::wrap(isolate)->verify_object(pointer) ? (Object*) pointer : nullptr;
+            return true;
         }
 
-        // return false if strict type check fails
-        const v8::Local<v8::Object> self = p_jval.As<v8::Object>();
-        if (!TypeConvert::is_object(self)
-            || (NativeClassType::Type)(uintptr_t) self->GetAlignedPointerFromInternalField(IF_ClassType) != NativeClassType::GodotObject)
+        if (p_jval->IsProxy())
         {
-            return false;
+            v8::MaybeLocal<v8::Value> target = self->Get(context, Environment::wrap(isolate)->get_symbol(Symbols::ProxyTarget));
+            if (!target.IsEmpty() && target.ToLocalChecked()->IsObject())
+            {
+                return js_to_gd_obj(isolate, context, target.ToLocalChecked(), r_godot_obj);
+            }
         }
-
-        // dead objects return true with a nullptr
-        void* pointer = self->GetAlignedPointerFromInternalField(IF_Pointer);
-        r_godot_obj = Environment::wrap(isolate)->verify_object(pointer) ? (Object*) pointer : nullptr;
-        return true;
+        return false;
     }
 
 }
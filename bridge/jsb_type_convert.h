@@ -9,6 +9,10 @@ namespace jsb
 {
     struct TypeConvert
     {
+        // converters specialized for an expected variant type (see `get_js_to_gd_func`/`get_gd_to_js_func`)
+        typedef bool (*JSToGDFunc)(v8::Isolate* isolate, const v8::Local<v8::Context>& context, const v8::Local<v8::Value>& p_jval, Variant& r_cvar);
+        typedef bool (*GDToJSFunc)(v8::Isolate* isolate, const v8::Local<v8::Context>& context, const Variant& p_cvar, v8::Local<v8::Value>& r_jval);
+
         /**
          * Returns a string representation of a JavaScript type. For primitives, equivalent to the typeof operator in
          * JS. For JS objects, we perform additional inspections and display if the object is an array, the Godot
@@ -33,11 +37,32 @@ namespace jsb
         static bool gd_var_to_js(v8::Isolate* isolate, const v8::Local<v8::Context>& context, const Variant& p_cvar, Variant::Type p_type, v8::Local<v8::Value>& r_jval);
         static bool js_to_gd_var(v8::Isolate* isolate, const v8::Local<v8::Context>& context, const v8::Local<v8::Value>& p_jval, Variant::Type p_type, Variant& r_cvar);
 
+        /**
+         * Get the converter specialized for `p_type`, which behaves the same as `js_to_gd_var`/`gd_var_to_js` with the type.
+         * It's supposed to be selected once for each argument slot (at bind time) instead of switching on the type in every call.
+         */
+        static JSToGDFunc get_js_to_gd_func(Variant::Type p_type);
+        static GDToJSFunc get_gd_to_js_func(Variant::Type p_type);
+
+        // get the converter of enum/bitfield parameters (INT), specialized for the values in int32 range
+        static JSToGDFunc get_js_to_gd_enum_func();
+
+        // get the converter of typed array parameters (`Array[T]`), the elements are converted as `p_element_type` directly
+        static JSToGDFunc get_js_to_gd_array_func(Variant::Type p_element_type);
+
         /**
          * Translate js val into gd variant without any type hint
          */
         static bool js_to_gd_var(v8::Isolate* isolate, const v8::Local<v8::Context>& context, const v8::Local<v8::Value>& p_jval, Variant& r_cvar);
 
+        /**
+         * Convert the nested plain objects/arrays into Dictionary/Array (and the reverse) in one pass,
+         * regardless of JSB_DEEP_CONTAINER_CONVERSION. The other values are converted as `js_to_gd_var`/`gd_var_to_js`.
+         * Dictionary keys must be strings, string names or integers to be converted into JS.
+         */
+        static bool js_to_gd_var_deep(v8::Isolate* isolate, const v8::Local<v8::Context>& context, const v8::Local<v8::Value>& p_jval, Variant& r_cvar);
+        static bool gd_var_to_js_deep(v8::Isolate* isolate, const v8::Local<v8::Context>& context, const Variant& p_cvar, v8::Local<v8::Value>& r_jval);
+
         /**
          * Check if a javascript value `p_val` could be converted into the expected primitive type `p_type`
          */
@@ -0,0 +1,116 @@
+#include "jsb_watchdog.h"
+#include "jsb_environment.h"
+#include "jsb_bridge_helper.h"
+#include "../internal/jsb_thread_util.h"
+
+#if JSB_WITH_WATCHDOG
+namespace jsb
+{
+    BinaryMutex Watchdog::lock_;
+    LocalVector<Environment*> Watchdog::environments_;
+    Thread Watchdog::thread_;
+    std::mutex Watchdog::wait_mutex_;
+    std::condition_variable Watchdog::wait_cv_;
+    bool Watchdog::finished_ = false;
+
+#if JSB_WITH_V8
+    namespace
+    {
+        // [isolate thread] called by v8 in the middle of the running JS
+        void on_interrupt(v8::Isolate* isolate, void* data)
+        {
+            const Environment* env = (const Environment*) data;
+
+            // the call may be already completed before the interrupt is handled
+            if (env->get_watchdog_deadline() < Watchdog::kFiring) return;
+
+            String stacktrace;
+            {
+                internal::SourcePosition source_position;
+                const impl::TryCatch try_catch(isolate);
+                jsb_throw(isolate, "");
+                if (try_catch.has_caught())
+                {
+                    stacktrace = BridgeHelper::get_stacktrace(try_catch, source_position);
+                }
+            }
+            JSB_LOG(Error, "script call exceeded the budget (%dms), terminated\n%s", internal::Settings::get_script_call_budget_msec(), stacktrace);
+            isolate->TerminateExecution();
+        }
+    }
+#endif
+
+    void Watchdog::register_(Environment* p_env)
+    {
+        MutexLock lock(lock_);
+        jsb_check(!environments_.has(p_env));
+        environments_.push_back(p_env);
+        if (!thread_.is_started() && !finished_)
+        {
+            Thread::Settings settings;
+            settings.priority = Thread::PRIORITY_LOW;
+            thread_.start(&_run, nullptr, settings);
+        }
+    }
+
+    void Watchdog::unregister(Environment* p_env)
+    {
+        // the environment is not accessed by the watchdog thread after it's removed (with the lock held)
+        MutexLock lock(lock_);
+        environments_.erase(p_env);
+    }
+
+    void Watchdog::finish()
+    {
+        {
+            std::lock_guard lock(wait_mutex_);
+            finished_ = true;
+        }
+        wait_cv_.notify_one();
+        if (thread_.is_started())
+        {
+            thread_.wait_to_finish();
+        }
+    }
+
+    void Watchdog::_interrupt(Environment* p_env)
+    {
+#if JSB_WITH_V8
+        p_env->get_isolate()->RequestInterrupt(&on_interrupt, p_env);
+#else
+        // the stack is carried by the uncatchable `interrupted` error which is reported by the caller
+        JSB_LOG(Error, "script call exceeded the budget (%dms), terminating", internal::Settings::get_script_call_budget_msec());
+        p_env->get_isolate()->TerminateExecution();
+#endif
+    }
+
+    void Watchdog::_run(void* p_userdata)
+    {
+        ThreadUtil::set_name("jsb.watchdog");
+
+        // check a few times per budget, so a call is interrupted no later than 1.25x of the budget
+        const uint64_t budget_msec = internal::Settings::get_script_call_budget_msec();
+        const uint64_t interval_msec = CLAMP(budget_msec / 4, (uint64_t) 1, (uint64_t) 100);
+        while (true)
+        {
+            {
+                std::unique_lock lock(wait_mutex_);
+                if (wait_cv_.wait_for(lock, std::chrono::milliseconds(interval_msec), [] { return finished_; })) break;
+            }
+
+            const uint64_t now = OS::get_singleton()->get_ticks_usec();
+            MutexLock lock(lock_);
+            for (Environment* env : environments_)
+            {
+                uint64_t deadline = env->watchdog_deadline_usec_.load(std::memory_order_relaxed);
+                if (deadline == 0 || deadline >= kFiring || now < deadline) continue;
+                if (!env->watchdog_deadline_usec_.compare_exchange_strong(deadline, kFiring, std::memory_order_acq_rel)) continue;
+
+                // the call can not be completed until the state leaves kFiring (see `Environment::_disarm_watchdog`)
+                _interrupt(env);
+                env->watchdog_deadline_usec_.store(kFired, std::memory_order_release);
+            }
+        }
+    }
+}
+#endif
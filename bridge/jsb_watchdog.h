@@ -0,0 +1,49 @@
+#ifndef GODOTJS_WATCHDOG_H
+#define GODOTJS_WATCHDOG_H
+#include "jsb_bridge_pch.h"
+
+namespace jsb
+{
+    class Environment;
+
+#if JSB_WITH_WATCHDOG
+
+    /**
+     * Interrupt the outermost JS calls (see Environment::BridgeScope) running longer than `runtime/core/script_call_budget_msec`.
+     * A single thread checks the deadlines of all registered environments (the main one and workers).
+     * The offending call is terminated and the environment keeps running: the stack is reported on v8,
+     * and the uncatchable `interrupted` error carries it on quickjs. Other backends can not be interrupted.
+     */
+    class Watchdog
+    {
+    public:
+        // the deadline of an environment is 0 if it's not running JS, or one of these states while it's being interrupted
+        static constexpr uint64_t kFiring = UINT64_MAX - 1;
+        static constexpr uint64_t kFired = UINT64_MAX;
+
+        // [any thread] watch the calls of an environment (it must be unregistered before the isolate is disposed)
+        static void register_(Environment* p_env);
+        static void unregister(Environment* p_env);
+
+        // stop the thread, call from main thread (GodotJSScriptLanguage::finish)
+        static void finish();
+
+    private:
+        static void _run(void* p_userdata);
+
+        // [watchdog thread, lock held] the deadline of `p_env` is kFiring
+        static void _interrupt(Environment* p_env);
+
+        static BinaryMutex lock_;
+        static LocalVector<Environment*> environments_;
+        static Thread thread_;
+
+        // sleep between the checks, notified to stop the thread
+        static std::mutex wait_mutex_;
+        static std::condition_variable wait_cv_;
+        static bool finished_;
+    };
+#endif
+}
+
+#endif
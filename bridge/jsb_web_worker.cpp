@@ -0,0 +1,93 @@
+#include "jsb_web_worker.h"
+#include "jsb_environment.h"
+#include "jsb_module_resolver.h"
+
+#if JSB_WITH_WEB
+#define JSB_WORKER_MODULE_NAME "godot.worker"
+#define JSB_WEB_WORKER_IMPL_MODULE_NAME "godot.worker.web"
+
+namespace jsb
+{
+    namespace
+    {
+        class WebWorkerModuleLoader : public IModuleLoader
+        {
+        public:
+            virtual ~WebWorkerModuleLoader() override = default;
+
+            virtual bool load(Environment* p_env, JavaScriptModule& p_module) override
+            {
+                v8::Isolate* isolate = p_env->get_isolate();
+                v8::Isolate::Scope isolate_scope(isolate);
+                v8::HandleScope handle_scope(isolate);
+                const v8::Local<v8::Context> context = p_env->get_context();
+                v8::Context::Scope context_scope(context);
+
+                const JavaScriptModule* impl_module = p_env->_load_module(String(), JSB_WEB_WORKER_IMPL_MODULE_NAME);
+                if (!impl_module)
+                {
+                    JSB_LOG(Error, "failed to load %s", JSB_WEB_WORKER_IMPL_MODULE_NAME);
+                    return false;
+                }
+
+                // exports = require("godot.worker.web").create(read_source)
+                v8::Local<v8::Value> create;
+                const v8::Local<v8::Object> impl_exports = impl_module->exports.Get(isolate);
+                if (!impl_exports->Get(context, impl::Helper::new_string_ascii(isolate, "create")).ToLocal(&create) || !create->IsFunction())
+                {
+                    JSB_LOG(Error, "bad %s", JSB_WEB_WORKER_IMPL_MODULE_NAME);
+                    return false;
+                }
+                v8::Local<v8::Value> argv[] = { JSB_NEW_FUNCTION(context, WebWorker::_read_source, {}) };
+                v8::Local<v8::Value> exports;
+                if (!create.As<v8::Function>()->Call(context, v8::Undefined(isolate), ::std::size(argv), argv).ToLocal(&exports) || !exports->IsObject())
+                {
+                    JSB_LOG(Error, "failed to create %s", JSB_WORKER_MODULE_NAME);
+                    return false;
+                }
+                p_module.exports.Reset(isolate, exports.As<v8::Object>());
+                return true;
+            }
+        };
+    }
+
+    void WebWorker::register_(const v8::Local<v8::Context>& p_context, const v8::Local<v8::Object>& p_self)
+    {
+        Environment::wrap(p_context)->add_module_loader<WebWorkerModuleLoader>(JSB_WORKER_MODULE_NAME);
+    }
+
+    void WebWorker::_read_source(const v8::FunctionCallbackInfo<v8::Value>& info)
+    {
+        v8::Isolate* isolate = info.GetIsolate();
+        const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+        if (!info[0]->IsString())
+        {
+            jsb_throw(isolate, "bad path");
+            return;
+        }
+
+        // resolved in the same way as the path of a native JSWorker
+        const String module_id = impl::Helper::to_string(isolate, info[0]);
+        ModuleSourceInfo source_info;
+        if (!Environment::wrap(isolate)->find_module_resolver(module_id, source_info))
+        {
+            jsb_throw(isolate, jsb_format("no source file for %s", module_id));
+            return;
+        }
+
+        const internal::FileAccessSourceReader reader(source_info.source_filepath);
+        if (reader.is_null())
+        {
+            jsb_throw(isolate, jsb_format("failed to read %s", source_info.source_filepath));
+            return;
+        }
+        Vector<uint8_t> bytes;
+        const size_t len = DefaultModuleResolver::read_all_bytes_with_shebang(reader, bytes);
+
+        const v8::Local<v8::Object> result = v8::Object::New(isolate);
+        result->Set(context, impl::Helper::new_string_ascii(isolate, "source"), impl::Helper::new_string(isolate, String::utf8((const char*) bytes.ptr(), (int) len))).Check();
+        result->Set(context, impl::Helper::new_string_ascii(isolate, "filename"), impl::Helper::new_string(isolate, source_info.source_filepath)).Check();
+        info.GetReturnValue().Set(result);
+    }
+}
+#endif
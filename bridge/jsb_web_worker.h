@@ -0,0 +1,22 @@
+#ifndef GODOTJS_WEB_WORKER_H
+#define GODOTJS_WEB_WORKER_H
+#include "jsb_bridge_pch.h"
+
+#if JSB_WITH_WEB
+namespace jsb
+{
+    /**
+     * `godot.worker` on the web platform, the JS part is implemented in `godot.worker.web` (jsb.runtime).
+     * A JSWorker runs the worker module in a browser Web Worker, messages are passed by `postMessage` of the browser (structured clone).
+     * Godot APIs are not available in the worker since the engine is not instantiated in it, so the worker module must be self-contained.
+     */
+    struct WebWorker
+    {
+        static void register_(const v8::Local<v8::Context>& p_context, const v8::Local<v8::Object>& p_self);
+
+        // [js] function read_source(module_id: string): { source: string, filename: string }
+        static void _read_source(const v8::FunctionCallbackInfo<v8::Value>& info);
+    };
+}
+#endif
+#endif
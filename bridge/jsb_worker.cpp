@@ -1,12 +1,13 @@
 #include "jsb_worker.h"
+#include "jsb_worker_task.h"
 #include "jsb_buffer.h"
 #include "jsb_environment.h"
 #include "jsb_type_convert.h"
 #include "../internal/jsb_sarray.h"
 #include "../internal/jsb_thread_util.h"
-#include "../internal/jsb_double_buffered.h"
+#include "../internal/jsb_mpsc_queue.h"
 
-#if !JSB_WITH_WEB && !JSB_WITH_JAVASCRIPTCORE
+#if !JSB_WITH_WEB
 #define JSB_WORKER_LOG(Severity, Format, ...) JSB_LOG_IMPL(JSWorker, Severity, Format, ##__VA_ARGS__)
 #define JSB_WORKER_MODULE_NAME "godot.worker"
 
@@ -19,6 +20,7 @@ namespace jsb
         WorkerID id_ = {};
         void* token_ = nullptr;
         String path_;
+        WorkerOptions options_;
 
         SafeFlag interrupt_requested_ = SafeFlag(false);
         Thread thread_;
@@ -27,11 +29,14 @@ namespace jsb
         // object id of this worker object in the master environment
         NativeObjectID handle_;
         std::shared_ptr<Environment> env_;
-        internal::DoubleBuffered<WorkerMessage> inbox_;
+        internal::MPSCQueue<WorkerMessage> inbox_;
+
+        // num of messages received but not handled yet (see Worker::get_statistics)
+        std::atomic<uint64_t> queued_messages_ = 0;
 
     public:
-        WorkerImpl(Environment* p_master, const String& p_path, NativeObjectID p_handle)
-        : token_(p_master), path_(p_path), handle_(p_handle)
+        WorkerImpl(Environment* p_master, const String& p_path, const WorkerOptions& p_options, NativeObjectID p_handle)
+        : token_(p_master), path_(p_path), options_(p_options), handle_(p_handle)
         {
         }
 
@@ -48,11 +53,17 @@ namespace jsb
 
         jsb_force_inline Thread::ID get_thread_id() const { return thread_.get_id(); }
 
+        jsb_force_inline uint64_t get_queued_messages() const { return queued_messages_.load(std::memory_order_relaxed); }
+
         static void _run(void* data)
         {
             WorkerImpl* impl = (WorkerImpl*) data;
 
-            internal::ThreadUtil::set_name(jsb_format("JSWorker_%d", *impl->id_));
+            internal::ThreadUtil::set_name(impl->options_.name.is_empty() ? jsb_format("JSWorker_%d", *impl->id_) : impl->options_.name);
+            if (impl->options_.affinity_mask != 0 && !internal::ThreadUtil::set_affinity(impl->options_.affinity_mask))
+            {
+                JSB_WORKER_LOG(Warning, "failed to set the affinity of worker %d (not supported on this platform?)", impl->id_);
+            }
             const OS* os = OS::get_singleton();
             uint64_t last_ticks = os->get_ticks_msec();
 
@@ -61,14 +72,20 @@ namespace jsb
             {
                 Environment::CreateParams params;
                 params.initial_class_slots = JSB_WORKER_INITIAL_CLASS_SLOTS;
-                params.initial_object_slots = JSB_WORKER_INITIAL_OBJECT_SLOTS;
+                params.initial_object_slots = internal::Settings::get_worker_initial_object_slots();
                 params.initial_script_slots = JSB_WORKER_INITIAL_SCRIPT_SLOTS;
+                params.max_heap_size_mb = internal::Settings::get_max_heap_size_mb(true);
+                params.initial_heap_size_mb = internal::Settings::get_initial_heap_size_mb(true);
                 params.thread_id = Thread::get_caller_id();
                 params.type = Environment::Type::Worker;
 
                 const std::shared_ptr<Environment> env = std::make_shared<Environment>(params);
                 impl->env_ = env;
                 env->init();
+                if (impl->options_.defer_script_calls)
+                {
+                    env->set_defer_threaded_script_calls(true);
+                }
 
                 v8::Global<v8::Object> context_obj_handle;
                 {
@@ -102,6 +119,11 @@ namespace jsb
                         v8::Function::New(context, &worker_post_message, v8::Uint32::NewFromUnsigned(isolate, *impl->id_)).ToLocalChecked()
                         )
                     .Check();
+                    context_obj->Set(context,
+                        jsb_name(env, postMessages),
+                        v8::Function::New(context, &worker_post_messages, v8::Uint32::NewFromUnsigned(isolate, *impl->id_)).ToLocalChecked()
+                        )
+                    .Check();
                     context_obj->Set(context,
                         jsb_name(env, close),
                         v8::Function::New(context, &worker_close, v8::Uint32::NewFromUnsigned(isolate, *impl->id_)).ToLocalChecked()
@@ -112,6 +134,11 @@ namespace jsb
                         v8::Null(isolate)
                         )
                     .Check();
+                    context_obj->Set(context,
+                        jsb_name(env, onmessages),
+                        v8::Null(isolate)
+                        )
+                    .Check();
                 }
 
                 if (env->load(impl->path_) == OK)
@@ -126,9 +153,9 @@ namespace jsb
                             std::vector<WorkerMessage>& messages = impl->inbox_.swap();
                             if (!messages.empty())
                             {
+                                // each batch is a call timed by the watchdog (if enabled)
+                                const Environment::BridgeScope bridge_scope(env.get());
                                 v8::Isolate* isolate = env->get_isolate();
-                                v8::Isolate::Scope isolate_scope(isolate);
-                                v8::HandleScope handle_scope(isolate);
                                 const v8::Local<v8::Context> context = env->get_context();
                                 const v8::Local<v8::Object> context_obj = context_obj_handle.Get(isolate);
 
@@ -137,6 +164,7 @@ namespace jsb
                                     if (impl->interrupt_requested_.is_set()) break;
                                     impl->_on_message(env, context, context_obj, message);
                                 }
+                                impl->queued_messages_.fetch_sub(messages.size(), std::memory_order_relaxed);
                                 messages.clear();
                             }
                         }
@@ -145,7 +173,9 @@ namespace jsb
                         const uint64_t ticks = os->get_ticks_msec();
                         env->update(ticks - last_ticks);
                         last_ticks = ticks;
-                        os->delay_usec(10 * 1000);
+
+                        // sleep until a message arrives or the earliest timer is due (instead of polling)
+                        env->wait_for_wake_up(env->get_idle_time(JSB_WORKER_MAX_IDLE_TIME));
                     }
                 }
                 context_obj_handle.Reset();
@@ -166,7 +196,7 @@ namespace jsb
             id_ = p_id;
             JSB_WORKER_LOG(VeryVerbose, "starting Worker %d", p_id);
             Thread::Settings settings;
-            settings.priority = Thread::PRIORITY_LOW;
+            settings.priority = options_.priority;
             thread_.start(_run, this,  settings);
         }
 
@@ -193,6 +223,7 @@ namespace jsb
             interrupt_requested_.set();
             if (const std::shared_ptr<Environment> env = env_)
             {
+                env->wake_up();
                 v8::Isolate* isolate = env->get_isolate();
                 if (isolate->IsExecutionTerminating())
                 {
@@ -209,7 +240,13 @@ namespace jsb
             {
                 return false;
             }
+            queued_messages_.fetch_add(1, std::memory_order_relaxed);
             inbox_.add(std::move(p_message));
+            // the worker picks up the messages in the inbox before waiting, it's fine if the env is not created yet
+            if (const std::shared_ptr<Environment> env = env_)
+            {
+                env->wake_up();
+            }
             return true;
         }
 
@@ -217,12 +254,20 @@ namespace jsb
         // (worker) handle message from master
         void _on_message(const std::shared_ptr<Environment>& p_env, const v8::Local<v8::Context>& p_context, const v8::Local<v8::Object>& p_context_obj, const WorkerMessage& p_message)
         {
+            JSB_TRACE_SCOPE("worker_on_message");
             v8::Isolate* isolate = p_env->get_isolate();
             v8::Local<v8::Value> callback;
-            if (!p_context_obj->Get(p_context, jsb_name(p_env, onmessage)).ToLocal(&callback) || !callback->IsFunction())
+
+            // a batch is passed to `onmessages` in one call if provided, otherwise to `onmessage` one by one
+            bool spread = false;
+            if (!p_message.is_batch() || !p_context_obj->Get(p_context, jsb_name(p_env, onmessages)).ToLocal(&callback) || !callback->IsFunction())
             {
-                JSB_WORKER_LOG(Error, "onmessage is not a function");
-                return;
+                if (!p_context_obj->Get(p_context, jsb_name(p_env, onmessage)).ToLocal(&callback) || !callback->IsFunction())
+                {
+                    JSB_WORKER_LOG(Error, "onmessage is not a function");
+                    return;
+                }
+                spread = p_message.is_batch();
             }
 
             Environment* worker_env = env_.get();
@@ -236,42 +281,38 @@ namespace jsb
                     JSB_WORKER_LOG(Error, "failed to access worker owner environment from worker onmessage");
                     return;
                 }
-
-                for (const auto& transfer : p_message.get_transfers())
-                {
-                    p_env->transfer_in(transfer);
-                }
             }
 
-#if JSB_WITH_V8
-            Serialization::VariantDeserializerDelegate delegate(worker_env, p_message.get_transfers());
-            v8::ValueDeserializer deserializer(isolate, p_message.get_data().ptr(), p_message.get_data().size(), &delegate);
-            delegate.SetSerializer(&deserializer);
-#else
-            v8::ValueDeserializer deserializer(isolate, p_message.get_data().ptr(), p_message.get_data().size());
-#endif
-
-            bool ok;
-            if (!deserializer.ReadHeader(p_context).To(&ok) || !ok)
+            v8::Local<v8::Value> value;
+            if (!Worker::deserialize_message(worker_env, p_context, p_message, value))
             {
-                JSB_WORKER_LOG(Error, "failed to parse message header");
                 return;
             }
-            v8::Local<v8::Value> value;
 
+            const v8::Local<v8::Function> call = callback.As<v8::Function>();
+            if (spread && value->IsArray())
             {
-                Environment::ExecutionDeferredScope defer(worker_env);
-
-                if (!deserializer.ReadValue(p_context).ToLocal(&value))
+                const v8::Local<v8::Array> batch = value.As<v8::Array>();
+                const uint32_t len = batch->Length();
+                for (uint32_t index = 0; index < len; ++index)
                 {
-                    JSB_WORKER_LOG(Error, "failed to parse message value");
-                    return;
+                    v8::Local<v8::Value> element;
+                    if (!batch->Get(p_context, index).ToLocal(&element))
+                    {
+                        JSB_WORKER_LOG(Error, "failed to read message %d of batch", index);
+                        return;
+                    }
+                    _call(isolate, p_context, call, element);
                 }
+                return;
             }
+            _call(isolate, p_context, call, value);
+        }
 
+        static void _call(v8::Isolate* isolate, const v8::Local<v8::Context>& p_context, const v8::Local<v8::Function>& p_callback, v8::Local<v8::Value> p_value)
+        {
             const impl::TryCatch try_catch(isolate);
-            const v8::Local<v8::Function> call = callback.As<v8::Function>();
-            const v8::MaybeLocal<v8::Value> rval = call->Call(p_context, v8::Undefined(isolate), 1, &value);
+            const v8::MaybeLocal<v8::Value> rval = p_callback->Call(p_context, v8::Undefined(isolate), 1, &p_value);
             jsb_unused(rval);
             if (try_catch.has_caught())
             {
@@ -351,6 +392,17 @@ namespace jsb
 
         // worker -> master (run in worker env)
         static void worker_post_message(const v8::FunctionCallbackInfo<v8::Value>& info)
+        {
+            _worker_post_message(info, false);
+        }
+
+        // worker -> master, an array of messages at once (run in worker env)
+        static void worker_post_messages(const v8::FunctionCallbackInfo<v8::Value>& info)
+        {
+            _worker_post_message(info, true);
+        }
+
+        static void _worker_post_message(const v8::FunctionCallbackInfo<v8::Value>& info, bool p_batch)
         {
             v8::Isolate* isolate = info.GetIsolate();
             v8::HandleScope handle_scope(isolate);
@@ -375,10 +427,12 @@ namespace jsb
             }
 
             internal::ReferentialVariantMap<TransferData> transfer_map;
-            const std::pair<uint8_t*, size_t> data = Worker::handle_post_message(info, transfer_map);
+            MessageBackingStores backing_stores;
+            const std::pair<uint8_t*, size_t> data = Worker::handle_post_message(info, transfer_map, backing_stores, p_batch);
 
             if (data.first)
             {
+                JSB_TRACE_INSTANT("worker_post_message", (uint32_t) data.second);
                 std::vector<TransferData> transfers;
                 transfers.reserve(transfer_map.size());
 
@@ -387,7 +441,7 @@ namespace jsb
                     transfers.push_back(transfer.value);
                 }
 
-                master->post_message(Message(Message::TYPE_MESSAGE, handle, Buffer::steal(data.first, data.second), std::move(transfers)));
+                master->post_message(Message(p_batch ? Message::TYPE_MESSAGES : Message::TYPE_MESSAGE, handle, Buffer::steal(data.first, data.second), std::move(transfers), std::move(backing_stores)));
             }
         }
     };
@@ -417,6 +471,7 @@ namespace jsb
             impl::ClassBuilder class_builder = impl::ClassBuilder::New<IF_ObjectFieldCount>(isolate, class_name, &Worker::constructor, *class_id);
 
             class_builder.Instance().Method("postMessage", &Worker::post_message);
+            class_builder.Instance().Method("postMessages", &Worker::post_messages);
             class_builder.Instance().Method("onready", &Worker::_placeholder);
             class_builder.Instance().Method("onerror", &Worker::_placeholder);
             class_builder.Instance().Method("onmessage", &Worker::_placeholder);
@@ -430,38 +485,53 @@ namespace jsb
             jsb_check(class_info->name == class_name);
             jsb_check(!class_info->clazz.IsEmpty());
             exports->Set(context, jsb_name(p_env, JSWorker), class_info->clazz.Get(isolate));
+            WorkerTaskPool::register_(p_env, context, exports);
             return true;
         }
 
     };
 
     // construct a Worker object (called from master thread)
-    WorkerID Worker::create(Environment* p_master, const String& p_path, NativeObjectID p_handle)
+    WorkerID Worker::create(Environment* p_master, const String& p_path, NativeObjectID p_handle, const WorkerOptions& p_options)
     {
-        lock_.lock();
-        WorkerImplPtr worker = std::make_shared<WorkerImpl>(p_master, p_path, p_handle);
+        lock_.write_lock();
+        WorkerImplPtr worker = std::make_shared<WorkerImpl>(p_master, p_path, p_options, p_handle);
         const WorkerID id = worker_list_.add(worker);
         worker->init(id);
         jsb_check(worker->get_thread_id() != Thread::UNASSIGNED_ID);
         workers_.insert(worker->get_thread_id(), id);
-        lock_.unlock();
+        lock_.write_unlock();
 
         return id;
     }
 
+    bool Worker::_try_get_impl(WorkerID p_id, WorkerImplPtr& o_impl)
+    {
+        RWLockRead lock(lock_);
+        return worker_list_.try_get_value(p_id, o_impl);
+    }
+
     bool Worker::is_valid(WorkerID p_id)
     {
-        lock_.lock();
-        const bool valid = worker_list_.is_valid_index(p_id);
-        lock_.unlock();
-        return valid;
+        RWLockRead lock(lock_);
+        return worker_list_.is_valid_index(p_id);
+    }
+
+    void Worker::get_statistics(uint32_t& r_workers, uint64_t& r_queued_messages)
+    {
+        RWLockRead lock(lock_);
+        r_workers = (uint32_t) worker_list_.size();
+        r_queued_messages = 0;
+        for (const WorkerImplPtr& impl : worker_list_)
+        {
+            r_queued_messages += impl->get_queued_messages();
+        }
     }
 
     bool Worker::try_get_worker(WorkerID p_id, NativeObjectID& o_handle, void*& o_token_ptr)
     {
-        lock_.lock();
         WorkerImplPtr impl;
-        if (worker_list_.try_get_value(p_id, impl))
+        if (_try_get_impl(p_id, impl))
         {
             o_handle = impl->get_handle();
             o_token_ptr = impl->get_token();
@@ -471,51 +541,46 @@ namespace jsb
             o_handle = {};
             o_token_ptr = nullptr;
         }
-        lock_.unlock();
         return (bool) o_handle;
     }
 
     void Worker::on_receive(WorkerID p_id, WorkerMessage&& p_message)
     {
-        lock_.lock();
+        // the registry lock is only held while copying the impl pointer out, enqueueing is lock-free
         WorkerImplPtr impl;
-        if (!worker_list_.try_get_value(p_id, impl) || !impl->on_receive(std::move(p_message)))
+        if (!_try_get_impl(p_id, impl) || !impl->on_receive(std::move(p_message)))
         {
             JSB_WORKER_LOG(Error, "can't post message to a dead worker (%d)", p_id);
         }
-        lock_.unlock();
     }
 
     bool Worker::terminate(WorkerID p_id)
     {
-        bool res = false;
-        lock_.lock();
         WorkerImplPtr impl;
-        if (worker_list_.try_get_value(p_id, impl))
+        if (_try_get_impl(p_id, impl))
         {
-            res = true;
             impl->finish();
+            return true;
         }
-        lock_.unlock();
-        return res;
+        return false;
     }
 
     void Worker::finish()
     {
         while (true)
         {
-            lock_.lock();
+            lock_.read_lock();
             const WorkerID id = worker_list_.get_first_index();
             if (!id)
             {
-                lock_.unlock();
+                lock_.read_unlock();
                 break;
             }
             jsb_check(worker_list_.is_valid_index(id));
             jsb_check(!worker_list_.is_empty());
             WorkerImplPtr impl;
             worker_list_.try_get_value(id, impl);
-            lock_.unlock();
+            lock_.read_unlock();
 
             if (impl)
             {
@@ -533,14 +598,14 @@ namespace jsb
     {
         const Thread::ID p_thread_id = Thread::get_caller_id();
 
-        lock_.lock();
+        lock_.write_lock();
         if (const WorkerID* worker_id = workers_.getptr(p_thread_id))
         {
             worker_list_.remove_at(*worker_id);
             jsb_check(!worker_list_.is_valid_index(*worker_id));
             workers_.erase(p_thread_id);
         }
-        lock_.unlock();
+        lock_.write_unlock();
 
         // on_thread_exit is the only way which is safe to delete all WorkerImpl objects in any cases,
         // the side effect is Error prompt in ~Thread().
@@ -573,11 +638,101 @@ namespace jsb
             return;
         }
 
+        WorkerOptions options;
+        if (info.Length() > 1 && !parse_options(isolate, isolate->GetCurrentContext(), info[1], options))
+        {
+            return;
+        }
+
         Environment* master = Environment::wrap(isolate);
         Worker* ptr = memnew(Worker);
         const NativeObjectID handle = master->bind_pointer(class_id, NativeClassType::Worker, ptr, self, 0);
         jsb_check(handle);
-        ptr->id_ = Worker::create(master, path, handle);
+        ptr->id_ = Worker::create(master, path, handle, options);
+    }
+
+    bool Worker::parse_options(v8::Isolate* p_isolate, const v8::Local<v8::Context>& p_context, const v8::Local<v8::Value>& p_value, WorkerOptions& r_options)
+    {
+        if (p_value->IsUndefined())
+        {
+            return true;
+        }
+        if (!p_value->IsObject())
+        {
+            jsb_throw(p_isolate, "bad param: worker options must be an object");
+            return false;
+        }
+        const v8::Local<v8::Object> options = p_value.As<v8::Object>();
+
+        // priority: "low" (default) | "normal" | "high"
+        v8::Local<v8::Value> value;
+        if (!options->Get(p_context, impl::Helper::new_string(p_isolate, "priority")).ToLocal(&value))
+        {
+            return false;
+        }
+        if (!value->IsUndefined())
+        {
+            const String priority = impl::Helper::to_string(p_isolate, value);
+            if (priority == "low") r_options.priority = Thread::PRIORITY_LOW;
+            else if (priority == "normal") r_options.priority = Thread::PRIORITY_NORMAL;
+            else if (priority == "high") r_options.priority = Thread::PRIORITY_HIGH;
+            else
+            {
+                jsb_throw(p_isolate, "bad param: priority must be 'low', 'normal' or 'high'");
+                return false;
+            }
+        }
+
+        // affinity: indices of the logical processors
+        if (!options->Get(p_context, impl::Helper::new_string(p_isolate, "affinity")).ToLocal(&value))
+        {
+            return false;
+        }
+        if (!value->IsUndefined())
+        {
+            if (!value->IsArray())
+            {
+                jsb_throw(p_isolate, "bad param: affinity must be an array of processor indices");
+                return false;
+            }
+            const v8::Local<v8::Array> processors = value.As<v8::Array>();
+            const int processor_count = OS::get_singleton()->get_processor_count();
+            for (uint32_t index = 0, num = processors->Length(); index < num; ++index)
+            {
+                v8::Local<v8::Value> element;
+                if (!processors->Get(p_context, index).ToLocal(&element) || !element->IsInt32())
+                {
+                    jsb_throw(p_isolate, "bad param: invalid processor index in affinity");
+                    return false;
+                }
+                const int32_t processor = element.As<v8::Int32>()->Value();
+                if (processor < 0 || processor >= MIN(processor_count, 64))
+                {
+                    jsb_throw(p_isolate, "bad param: invalid processor index in affinity");
+                    return false;
+                }
+                r_options.affinity_mask |= 1ull << processor;
+            }
+        }
+
+        if (!options->Get(p_context, impl::Helper::new_string(p_isolate, "name")).ToLocal(&value))
+        {
+            return false;
+        }
+        if (!value->IsUndefined())
+        {
+            r_options.name = impl::Helper::to_string(p_isolate, value);
+        }
+
+        if (!options->Get(p_context, impl::Helper::new_string(p_isolate, "defer_script_calls")).ToLocal(&value))
+        {
+            return false;
+        }
+        if (!value->IsUndefined())
+        {
+            r_options.defer_script_calls = value->BooleanValue(p_isolate);
+        }
+        return true;
     }
 
     // placeholder func for ontransfer/onmessage/onready/onerror of worker (in master)
@@ -585,6 +740,17 @@ namespace jsb
 
     // master.postMessage
     void Worker::post_message(const v8::FunctionCallbackInfo<v8::Value>& info)
+    {
+        _post_message(info, false);
+    }
+
+    // master.postMessages
+    void Worker::post_messages(const v8::FunctionCallbackInfo<v8::Value>& info)
+    {
+        _post_message(info, true);
+    }
+
+    void Worker::_post_message(const v8::FunctionCallbackInfo<v8::Value>& info, bool p_batch)
     {
         v8::Isolate* isolate = info.GetIsolate();
         v8::HandleScope handle_scope(isolate);
@@ -605,10 +771,12 @@ namespace jsb
         }
 
         internal::ReferentialVariantMap<TransferData> transfer_map;
-        const std::pair<uint8_t*, size_t> data = Worker::handle_post_message(info, transfer_map);
+        MessageBackingStores backing_stores;
+        const std::pair<uint8_t*, size_t> data = Worker::handle_post_message(info, transfer_map, backing_stores, p_batch);
 
         if (data.first)
         {
+            JSB_TRACE_INSTANT("post_message", (uint32_t) data.second);
             std::vector<TransferData> transfers;
             transfers.reserve(transfer_map.size());
 
@@ -617,7 +785,7 @@ namespace jsb
                 transfers.push_back(transfer.value);
             }
 
-            Worker::on_receive(worker->id_, WorkerMessage(Buffer::steal(data.first, data.second), std::move(transfers)));
+            Worker::on_receive(worker->id_, WorkerMessage(Buffer::steal(data.first, data.second), std::move(transfers), std::move(backing_stores), p_batch));
         }
     }
 
@@ -644,22 +812,68 @@ namespace jsb
         Environment::wrap(p_context)->add_module_loader<JSWorkerModuleLoader>(JSB_WORKER_MODULE_NAME);
     }
 
-    std::pair<uint8_t*, size_t> Worker::handle_post_message(const v8::FunctionCallbackInfo<v8::Value>& info, internal::ReferentialVariantMap<TransferData>& transfers)
+    std::pair<uint8_t*, size_t> Worker::handle_post_message(const v8::FunctionCallbackInfo<v8::Value>& info, internal::ReferentialVariantMap<TransferData>& transfers, MessageBackingStores& r_backing_stores, bool p_batch)
     {
         v8::Isolate* isolate = info.GetIsolate();
-        const v8::Local<v8::Context> context = isolate->GetCurrentContext();
-        Environment* from_env = Environment::wrap(isolate);
-        from_env->check_internal_state();
-
         if (info.Length() == 0)
         {
             jsb_throw(isolate, "postMessage requires at least 1 argument");
             return {nullptr, 0};
         }
+        if (p_batch && !info[0]->IsArray())
+        {
+            jsb_throw(isolate, "postMessages requires an array of messages");
+            return {nullptr, 0};
+        }
+        return serialize_message(isolate, isolate->GetCurrentContext(), info[0], info.Length() > 1 ? info[1] : v8::Local<v8::Value>(), transfers, r_backing_stores);
+    }
 
-        if (info.Length() > 1 && !info[1]->IsUndefined())
+    bool Worker::deserialize_message(Environment* p_env, const v8::Local<v8::Context>& p_context, const WorkerMessage& p_message, v8::Local<v8::Value>& r_value)
+    {
+        v8::Isolate* isolate = p_env->get_isolate();
+        for (const TransferData& transfer : p_message.get_transfers())
         {
-            v8::Local<v8::Value> transfer_arg = info[1];
+            p_env->transfer_in(transfer);
+        }
+
+#if JSB_WITH_VARIANT_SERIALIZATION
+        Serialization::VariantDeserializerDelegate delegate(p_env, p_message.get_transfers(), p_message.get_backing_stores());
+        v8::ValueDeserializer deserializer(isolate, p_message.get_data().ptr(), p_message.get_data().size(), &delegate);
+        delegate.SetSerializer(&deserializer);
+#if JSB_WITH_V8
+        delegate.TransferArrayBuffers(isolate);
+#endif
+#else
+        v8::ValueDeserializer deserializer(isolate, p_message.get_data().ptr(), p_message.get_data().size());
+#endif
+
+        bool ok;
+        if (!deserializer.ReadHeader(p_context).To(&ok) || !ok)
+        {
+            JSB_WORKER_LOG(Error, "failed to parse message header");
+            return false;
+        }
+
+        Environment::ExecutionDeferredScope defer(p_env);
+        if (!deserializer.ReadValue(p_context).ToLocal(&r_value))
+        {
+            JSB_WORKER_LOG(Error, "failed to parse message value");
+            return false;
+        }
+        return true;
+    }
+
+    std::pair<uint8_t*, size_t> Worker::serialize_message(v8::Isolate* isolate, const v8::Local<v8::Context>& context, const v8::Local<v8::Value>& p_value, const v8::Local<v8::Value>& p_transfer, internal::ReferentialVariantMap<TransferData>& transfers, MessageBackingStores& r_backing_stores)
+    {
+        Environment* from_env = Environment::wrap(isolate);
+        from_env->check_internal_state();
+
+        // ArrayBuffers in the transfer list are moved (detached from the sender) instead of cloned
+        std::vector<v8::Local<v8::ArrayBuffer>> transferred_array_buffers;
+
+        if (!p_transfer.IsEmpty() && !p_transfer->IsUndefined())
+        {
+            v8::Local<v8::Value> transfer_arg = p_transfer;
 
             if (!transfer_arg->IsArray() && !transfer_arg->IsObject())
             {
@@ -682,6 +896,18 @@ namespace jsb
                         continue;
                     }
 
+                    if (item->IsArrayBuffer())
+                    {
+                        const v8::Local<v8::ArrayBuffer> array_buffer = item.As<v8::ArrayBuffer>();
+                        if (!array_buffer->IsDetachable())
+                        {
+                            jsb_throw(isolate, "ArrayBuffer in the transfer list is not detachable");
+                            return {nullptr, 0};
+                        }
+                        transferred_array_buffers.push_back(array_buffer);
+                        continue;
+                    }
+
                     Variant variant;
 
                     if (!TypeConvert::js_to_gd_var(isolate, context, item.As<v8::Object>(), Variant::Type::ARRAY, variant))
@@ -692,7 +918,7 @@ namespace jsb
 
                     TransferData transfer_data;
                     from_env->transfer_out(NativeObjectID::none(), transfers.size(), variant, transfer_data);
-                    transfers.insert(variant, transfer_data);
+                    transfers.insert(variant, std::move(transfer_data));
                 }
             }
             else
@@ -711,30 +937,48 @@ namespace jsb
                     Variant& variant = transfer_arr[i];
                     TransferData transfer_data;
                     from_env->transfer_out(NativeObjectID::none(), i, variant, transfer_data);
-                    transfers.insert(variant, transfer_data);
+                    transfers.insert(variant, std::move(transfer_data));
                 }
             }
         }
 
         Vector<TransferData> transferred;
 
-        // TODO: Transfer support non-V8.
-#if JSB_WITH_V8
-        Serialization::VariantSerializerDelegate delegate(from_env, transfers);
+        // TODO: Transfer support for quickjs-ng.
+#if JSB_WITH_VARIANT_SERIALIZATION
+        Serialization::VariantSerializerDelegate delegate(from_env, transfers, r_backing_stores);
         v8::ValueSerializer serializer(isolate, &delegate);
         delegate.SetSerializer(&serializer);
+#if JSB_WITH_V8
+        for (uint32_t index = 0, num = (uint32_t) transferred_array_buffers.size(); index < num; ++index)
+        {
+            serializer.TransferArrayBuffer(index, transferred_array_buffers[index]);
+        }
+#endif
 #else
         v8::ValueSerializer serializer(isolate);
 #endif
 
         serializer.WriteHeader();
-        v8::Maybe<bool> write_result = serializer.WriteValue(context, info[0]);
+        v8::Maybe<bool> write_result = serializer.WriteValue(context, p_value);
 
         if (write_result.IsNothing())
         {
             return {nullptr, 0};
         }
 
+#if JSB_WITH_QUICKJS
+        r_backing_stores.shared = serializer.ReleaseSharedBackingStores();
+#endif
+
+        for (const v8::Local<v8::ArrayBuffer>& array_buffer : transferred_array_buffers)
+        {
+#if JSB_WITH_V8
+            r_backing_stores.transferred.push_back(array_buffer->GetBackingStore());
+#endif
+            const v8::Maybe<bool> detached = array_buffer->Detach(v8::Local<v8::Value>());
+            jsb_unused(detached);
+        }
         return serializer.Release();
     }
 }
@@ -6,13 +6,13 @@
 #include "jsb_environment.h"
 #include "jsb_type_convert.h"
 
-#if !JSB_WITH_WEB && !JSB_WITH_JAVASCRIPTCORE
+#if !JSB_WITH_WEB
 namespace jsb
 {
     enum class FinalizationType : uint8_t;
 
     typedef internal::Index32 WorkerID;
-    typedef Mutex WorkerLock;
+    typedef RWLock WorkerLock;
     class Environment;
     class WorkerImpl;
     typedef std::shared_ptr<WorkerImpl> WorkerImplPtr;
@@ -31,18 +31,40 @@ namespace jsb
         WorkerMessage(WorkerMessage&&) noexcept = default;
         WorkerMessage& operator=(WorkerMessage&&) noexcept = default;
 
-        WorkerMessage(Buffer&& p_data, std::vector<TransferData>&& p_transfers) :
-            data(std::move(p_data)), transfers(std::move(p_transfers))
+        WorkerMessage(Buffer&& p_data, std::vector<TransferData>&& p_transfers, MessageBackingStores&& p_backing_stores, bool p_batch = false) :
+            data(std::move(p_data)), transfers(std::move(p_transfers)), backing_stores(std::move(p_backing_stores)), batch(p_batch)
         {
         }
 
+        // the data is an array of messages posted at once by `postMessages`
+        bool is_batch() const { return batch; }
+
         const Buffer& get_data() const { return data; }
         const std::vector<TransferData>& get_transfers() const { return transfers; }
+        const MessageBackingStores& get_backing_stores() const { return backing_stores; }
 
     private:
 
         Buffer data;
         std::vector<TransferData> transfers;
+        MessageBackingStores backing_stores;
+        bool batch;
+    };
+
+    // options of a worker thread (the optional second parameter of the JSWorker constructor)
+    struct WorkerOptions
+    {
+        Thread::Priority priority = Thread::PRIORITY_LOW;
+
+        // the logical processors to run the worker thread on (bit N for processor N), 0 for no restriction
+        uint64_t affinity_mask = 0;
+
+        // the name of the worker thread (shown in debuggers and profilers), `JSWorker_<id>` if empty
+        String name;
+
+        // queue the script calls from other threads to the objects bound in the worker (e.g. `_process` of the nodes instantiated by a room
+        // and added to the scene tree), even if `defer_threaded_script_calls` is disabled in the project settings
+        bool defer_script_calls = false;
     };
 
     class Worker
@@ -63,6 +85,9 @@ namespace jsb
         // release all workers, call from main thread (GodotJSScriptLanguage::finish)
         static void finish();
 
+        // num of alive workers and the messages queued to them (not handled yet), call from any thread
+        static void get_statistics(uint32_t& r_workers, uint64_t& r_queued_messages);
+
         static void on_thread_enter();
         static void on_thread_exit();
 
@@ -72,9 +97,17 @@ namespace jsb
 
         static void terminate(const v8::FunctionCallbackInfo<v8::Value>& info);
         static void post_message(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void post_messages(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void _post_message(const v8::FunctionCallbackInfo<v8::Value>& info, bool p_batch);
         static void _placeholder(const v8::FunctionCallbackInfo<v8::Value>& info);
 
-        static WorkerID create(Environment* p_master, const String& p_path, NativeObjectID p_handle);
+        static WorkerID create(Environment* p_master, const String& p_path, NativeObjectID p_handle, const WorkerOptions& p_options);
+
+        // read the options object passed to the JSWorker constructor, return false (with a JS exception thrown) if any option is invalid
+        static bool parse_options(v8::Isolate* p_isolate, const v8::Local<v8::Context>& p_context, const v8::Local<v8::Value>& p_value, WorkerOptions& r_options);
+
+        // lookup a worker by id, only a shared (read) lock is taken so that concurrent posters don't contend
+        static bool _try_get_impl(WorkerID p_id, WorkerImplPtr& o_impl);
 
         // check if a worker valid
         static bool is_valid(WorkerID p_id);
@@ -88,7 +121,15 @@ namespace jsb
         static void on_receive(WorkerID p_id, WorkerMessage&& message);
 
         // shared master <-> worker postMessage logic
-        static std::pair<uint8_t*, size_t> handle_post_message(const v8::FunctionCallbackInfo<v8::Value>& info, internal::ReferentialVariantMap<TransferData>& transfers);
+        // `p_batch` for postMessages (the first argument must be an array of messages)
+        static std::pair<uint8_t*, size_t> handle_post_message(const v8::FunctionCallbackInfo<v8::Value>& info, internal::ReferentialVariantMap<TransferData>& transfers, MessageBackingStores& r_backing_stores, bool p_batch = false);
+
+    public:
+        // serialize a value with an optional transfer list (empty or undefined if not provided), return {nullptr, 0} with a JS exception thrown if failed
+        static std::pair<uint8_t*, size_t> serialize_message(v8::Isolate* isolate, const v8::Local<v8::Context>& context, const v8::Local<v8::Value>& p_value, const v8::Local<v8::Value>& p_transfer, internal::ReferentialVariantMap<TransferData>& transfers, MessageBackingStores& r_backing_stores);
+
+        // adopt the transferred variants and read the value of a serialized message in `p_env`
+        static bool deserialize_message(Environment* p_env, const v8::Local<v8::Context>& p_context, const WorkerMessage& p_message, v8::Local<v8::Value>& r_value);
     };
 }
 #endif
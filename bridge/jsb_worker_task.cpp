@@ -0,0 +1,319 @@
+#include "jsb_worker_task.h"
+#include "jsb_environment.h"
+#include "jsb_bridge_helper.h"
+
+#if !JSB_WITH_WEB
+#define JSB_WORKER_TASK_LOG(Severity, Format, ...) JSB_LOG_IMPL(JSWorkerTask, Severity, Format, ##__VA_ARGS__)
+
+namespace jsb
+{
+    BinaryMutex WorkerTaskPool::lock_;
+    bool WorkerTaskPool::finished_ = false;
+    int WorkerTaskPool::capacity_ = 0;
+    int WorkerTaskPool::running_ = 0;
+    List<WorkerTask*> WorkerTaskPool::queued_;
+    HashSet<WorkerThreadPool::TaskID> WorkerTaskPool::pool_tasks_;
+    std::vector<std::shared_ptr<Environment>> WorkerTaskPool::idle_environments_;
+    std::vector<std::shared_ptr<Environment>> WorkerTaskPool::all_environments_;
+
+    void WorkerTaskPool::register_(Environment* p_env, const v8::Local<v8::Context>& p_context, const v8::Local<v8::Object>& p_exports)
+    {
+        v8::Isolate* isolate = p_env->get_isolate();
+        p_exports->Set(p_context, impl::Helper::new_string(isolate, "runTask"), v8::Function::New(p_context, &_run_task).ToLocalChecked()).Check();
+    }
+
+    void WorkerTaskPool::_run_task(const v8::FunctionCallbackInfo<v8::Value>& info)
+    {
+        v8::Isolate* isolate = info.GetIsolate();
+        v8::HandleScope handle_scope(isolate);
+        const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+        Environment* env = Environment::wrap(isolate);
+
+        const String path = impl::Helper::to_string(isolate, info[0]);
+        if (path.is_empty())
+        {
+            jsb_throw(isolate, "bad param");
+            return;
+        }
+
+        internal::ReferentialVariantMap<TransferData> transfer_map;
+        MessageBackingStores backing_stores;
+        const std::pair<uint8_t*, size_t> data = Worker::serialize_message(isolate, context, info[1], info[2], transfer_map, backing_stores);
+        if (!data.first)
+        {
+            return;
+        }
+
+        std::vector<TransferData> transfers;
+        transfers.reserve(transfer_map.size());
+        for (const auto& transfer : transfer_map)
+        {
+            transfers.push_back(transfer.value);
+        }
+
+        const v8::Local<v8::Promise::Resolver> resolver = v8::Promise::Resolver::New(context).ToLocalChecked();
+        WorkerTask* task = memnew(WorkerTask);
+        task->token = env;
+        task->path = path;
+        task->input.emplace(Buffer::steal(data.first, data.second), std::move(transfers), std::move(backing_stores));
+        {
+            MutexLock lock(lock_);
+            if (finished_)
+            {
+                memdelete(task);
+                jsb_throw(isolate, "the task pool is already finished");
+                return;
+            }
+            if (capacity_ == 0)
+            {
+                capacity_ = internal::Settings::get_task_environment_pool_size();
+                if (capacity_ == 0) capacity_ = MAX(1, WorkerThreadPool::get_singleton()->get_thread_count() / 2);
+            }
+            task->resolver_id = env->add_pending_task(resolver);
+            if (running_ < capacity_)
+            {
+                ++running_;
+                _dispatch(task);
+            }
+            else
+            {
+                queued_.push_back(task);
+            }
+        }
+        info.GetReturnValue().Set(resolver->GetPromise());
+    }
+
+    void WorkerTaskPool::_dispatch(WorkerTask* p_task)
+    {
+        p_task->pool_task_id = WorkerThreadPool::get_singleton()->add_native_task(&_execute, p_task, false, "jsb: run task");
+        pool_tasks_.insert(p_task->pool_task_id);
+    }
+
+    std::shared_ptr<Environment> WorkerTaskPool::_checkout()
+    {
+        {
+            MutexLock lock(lock_);
+            if (!idle_environments_.empty())
+            {
+                std::shared_ptr<Environment> env = std::move(idle_environments_.back());
+                idle_environments_.pop_back();
+                return env;
+            }
+        }
+
+        Environment::CreateParams params;
+        params.initial_class_slots = JSB_WORKER_INITIAL_CLASS_SLOTS;
+        params.initial_object_slots = internal::Settings::get_worker_initial_object_slots();
+        params.initial_script_slots = JSB_WORKER_INITIAL_SCRIPT_SLOTS;
+        params.max_heap_size_mb = internal::Settings::get_max_heap_size_mb(true);
+        params.initial_heap_size_mb = internal::Settings::get_initial_heap_size_mb(true);
+        // never used by more than one thread at the same time, but not bound to a specific thread (the same as shadow environments)
+        params.thread_id = Thread::UNASSIGNED_ID;
+        params.type = Environment::Type::Worker;
+
+        std::shared_ptr<Environment> env = std::make_shared<Environment>(params);
+        JSB_WORKER_TASK_LOG(Verbose, "creating a task Environment on thread %d [env %s]", Thread::get_caller_id(), (uintptr_t) env->id());
+        env->init();
+        {
+            MutexLock lock(lock_);
+            all_environments_.push_back(env);
+        }
+        return env;
+    }
+
+    void WorkerTaskPool::_checkin(const std::shared_ptr<Environment>& p_env)
+    {
+        MutexLock lock(lock_);
+        idle_environments_.push_back(p_env);
+    }
+
+    void WorkerTaskPool::_execute(void* p_userdata)
+    {
+        WorkerTask* task = (WorkerTask*) p_userdata;
+        {
+            const std::shared_ptr<Environment> env = _checkout();
+            _run(env.get(), task);
+            _checkin(env);
+        }
+
+        // take the next one before posting the result (`pool_task_id` is written with the lock held)
+        {
+            MutexLock lock(lock_);
+            if (!finished_ && !queued_.is_empty())
+            {
+                WorkerTask* next = queued_.front()->get();
+                queued_.pop_front();
+                _dispatch(next);
+            }
+            else
+            {
+                --running_;
+            }
+        }
+
+        if (const std::shared_ptr<Environment> master = Environment::_access(task->token))
+        {
+            master->add_async_call(Environment::AsyncCall::TYPE_TASK_DONE, task);
+        }
+        else
+        {
+            // nobody is waiting for the result, the pool task is waited in `finish`
+            JSB_WORKER_TASK_LOG(Verbose, "the environment of task %s is gone", task->path);
+            memdelete(task);
+        }
+    }
+
+    void WorkerTaskPool::_run(Environment* p_env, WorkerTask* p_task)
+    {
+        v8::Isolate* isolate = p_env->get_isolate();
+        {
+            const Environment::BridgeScope bridge_scope(p_env);
+            const v8::Local<v8::Context> context = p_env->get_context();
+            const impl::TryCatch try_catch(isolate);
+
+            JavaScriptModule* module = nullptr;
+            if (p_env->load(p_task->path, &module) != OK || !module)
+            {
+                p_task->error = jsb_format("failed to load task module %s", p_task->path);
+                return;
+            }
+
+            const v8::Local<v8::Value> exports = module->exports.Get(isolate);
+            v8::Local<v8::Value> run;
+            if (!exports->IsObject()
+                || !exports.As<v8::Object>()->Get(context, impl::Helper::new_string(isolate, "run")).ToLocal(&run)
+                || !run->IsFunction())
+            {
+                p_task->error = jsb_format("task module %s does not export a run function", p_task->path);
+                return;
+            }
+
+            v8::Local<v8::Value> input;
+            const bool read = Worker::deserialize_message(p_env, context, *p_task->input, input);
+            p_task->input.reset();
+            if (!read)
+            {
+                p_task->error = "failed to read the input of task";
+                return;
+            }
+
+            v8::Local<v8::Value> result;
+            if (!run.As<v8::Function>()->Call(context, v8::Undefined(isolate), 1, &input).ToLocal(&result))
+            {
+                p_task->error = try_catch.has_caught() ? BridgeHelper::get_exception(try_catch) : String("task failed");
+                return;
+            }
+
+            // an async `run` must not wait for anything other than microtasks (e.g. timers never fire in a task)
+            if (result->IsPromise())
+            {
+                p_env->perform_microtask_checkpoint();
+                const v8::Local<v8::Promise> promise = result.As<v8::Promise>();
+                switch (promise->State())
+                {
+                case v8::Promise::kFulfilled: result = promise->Result(); break;
+                case v8::Promise::kRejected:
+                    p_task->error = impl::Helper::to_string(isolate, promise->Result());
+                    return;
+                default:
+                    p_task->error = jsb_format("task %s is not settled after running microtasks", p_task->path);
+                    return;
+                }
+            }
+
+            internal::ReferentialVariantMap<TransferData> transfer_map;
+            MessageBackingStores backing_stores;
+            const std::pair<uint8_t*, size_t> data = Worker::serialize_message(isolate, context, result, v8::Local<v8::Value>(), transfer_map, backing_stores);
+            if (!data.first)
+            {
+                p_task->error = try_catch.has_caught() ? BridgeHelper::get_exception(try_catch) : String("failed to write the result of task");
+                return;
+            }
+
+            std::vector<TransferData> transfers;
+            transfers.reserve(transfer_map.size());
+            for (const auto& transfer : transfer_map)
+            {
+                transfers.push_back(transfer.value);
+            }
+            p_task->output.emplace(Buffer::steal(data.first, data.second), std::move(transfers), std::move(backing_stores));
+        }
+
+        // the housekeeping of the environment (async calls, microtasks, freed variants) before it's checked in
+        p_env->update(0);
+    }
+
+    void WorkerTaskPool::on_task_done(Environment* p_master, WorkerTask* p_task)
+    {
+        {
+            MutexLock lock(lock_);
+            pool_tasks_.erase(p_task->pool_task_id);
+        }
+        // already completed (the result is posted at the end of the pool task), it releases the task in WorkerThreadPool
+        WorkerThreadPool::get_singleton()->wait_for_task_completion(p_task->pool_task_id);
+
+        v8::Global<v8::Promise::Resolver> resolver_handle;
+        if (p_master->take_pending_task(p_task->resolver_id, resolver_handle))
+        {
+            v8::Isolate* isolate = p_master->get_isolate();
+            const Environment::BridgeScope bridge_scope(p_master);
+            const v8::Local<v8::Context> context = p_master->get_context();
+            const v8::Local<v8::Promise::Resolver> resolver = resolver_handle.Get(isolate);
+            resolver_handle.Reset();
+
+            v8::Local<v8::Value> value;
+            if (p_task->output && Worker::deserialize_message(p_master, context, *p_task->output, value))
+            {
+                resolver->Resolve(context, value).Check();
+            }
+            else
+            {
+                const String error = p_task->output ? String("failed to read the result of task") : p_task->error;
+                resolver->Reject(context, impl::Helper::new_string(isolate, error)).Check();
+            }
+            p_master->notify_microtasks_run();
+        }
+        memdelete(p_task);
+    }
+
+    void WorkerTaskPool::finish()
+    {
+        LocalVector<WorkerThreadPool::TaskID> pool_tasks;
+        {
+            MutexLock lock(lock_);
+            finished_ = true;
+
+            // the environments waiting for them are already disposed
+            for (WorkerTask* task : queued_)
+            {
+                memdelete(task);
+            }
+            queued_.clear();
+            for (const WorkerThreadPool::TaskID& task_id : pool_tasks_)
+            {
+                pool_tasks.push_back(task_id);
+            }
+            pool_tasks_.clear();
+        }
+
+        for (const WorkerThreadPool::TaskID& task_id : pool_tasks)
+        {
+            WorkerThreadPool::get_singleton()->wait_for_task_completion(task_id);
+        }
+
+        std::vector<std::shared_ptr<Environment>> environments;
+        {
+            MutexLock lock(lock_);
+            environments = std::move(all_environments_);
+            all_environments_.clear();
+            idle_environments_.clear();
+        }
+        JSB_WORKER_TASK_LOG(Verbose, "release %d task environments", (int) environments.size());
+        for (const std::shared_ptr<Environment>& env : environments)
+        {
+            env->dispose();
+        }
+    }
+}
+
+#endif
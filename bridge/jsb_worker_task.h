@@ -0,0 +1,70 @@
+#ifndef GODOTJS_WORKER_TASK_H
+#define GODOTJS_WORKER_TASK_H
+#include "jsb_bridge_pch.h"
+#include "jsb_worker.h"
+#include "core/object/worker_thread_pool.h"
+
+#if !JSB_WITH_WEB
+namespace jsb
+{
+    // a short-lived task started by `runTask` (owned by WorkerTaskPool until it's done)
+    struct WorkerTask
+    {
+        // the environment which started the task (the result is posted back to it)
+        void* token = nullptr;
+        internal::Index32 resolver_id;
+
+        String path;
+        std::optional<WorkerMessage> input;
+
+        // written in WorkerThreadPool
+        std::optional<WorkerMessage> output;
+        String error;
+
+        WorkerThreadPool::TaskID pool_task_id = WorkerThreadPool::INVALID_TASK_ID;
+    };
+
+    /**
+     * Run short-lived JS tasks on godot's WorkerThreadPool instead of dedicated threads (as JSWorker does).
+     * A task module exports a `run(input)` function, the input and the result are passed in the same way as JSWorker messages.
+     * The environments are pre-initialized and reused, each of them is checked out by one pool task at a time (never shared between threads).
+     * Tasks are queued if the pool is full (`runtime/core/task_environment_pool_size`), engine jobs and scripts share the same threads.
+     */
+    class WorkerTaskPool
+    {
+    public:
+        static void register_(Environment* p_env, const v8::Local<v8::Context>& p_context, const v8::Local<v8::Object>& p_exports);
+
+        // wait for the running tasks and release all pooled environments, call from main thread (GodotJSScriptLanguage::finish)
+        static void finish();
+
+        // [env thread] settle the promise of a task started in `p_master`
+        static void on_task_done(Environment* p_master, WorkerTask* p_task);
+
+    private:
+        // exposed JS function `runTask(path, input, transfer?): Promise<any>`
+        static void _run_task(const v8::FunctionCallbackInfo<v8::Value>& info);
+
+        // [WorkerThreadPool]
+        static void _execute(void* p_userdata);
+        static void _run(Environment* p_env, WorkerTask* p_task);
+
+        // [lock held] start a task on WorkerThreadPool
+        static void _dispatch(WorkerTask* p_task);
+
+        static std::shared_ptr<Environment> _checkout();
+        static void _checkin(const std::shared_ptr<Environment>& p_env);
+
+        static BinaryMutex lock_;
+        static bool finished_;
+        static int capacity_;
+        static int running_;
+        static List<WorkerTask*> queued_;
+        static HashSet<WorkerThreadPool::TaskID> pool_tasks_;
+        static std::vector<std::shared_ptr<Environment>> idle_environments_;
+        static std::vector<std::shared_ptr<Environment>> all_environments_;
+    };
+}
+#endif
+
+#endif
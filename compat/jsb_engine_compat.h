@@ -67,10 +67,34 @@
 
 using namespace godot;
 
+#include <godot_cpp/godot.hpp>
+
 namespace jsb::compat
 {
     typedef godot::ObjectDB ObjectDB;
     typedef godot::Performance Performance;
+
+    /**
+     * The counterpart of `MethodBind::ptrcall` in the module build, the method bind of GDExtension is resolved once and kept by the caller.
+     * The arguments and the return value are the typed native buffers (the PtrToArg encoding, e.g. int64_t for int, double for float).
+     * NOTE the hash of a method is not exposed by ClassDB at runtime, it's required to be known ahead (from extension_api.json).
+     */
+    struct MethodBindPtr
+    {
+        GDExtensionMethodBindPtr ptr = nullptr;
+
+        static MethodBindPtr resolve(const StringName& p_class_name, const StringName& p_method_name, int64_t p_hash)
+        {
+            return { ::godot::internal::gdextension_interface_classdb_get_method_bind(p_class_name._native_ptr(), p_method_name._native_ptr(), p_hash) };
+        }
+
+        jsb_force_inline bool is_valid() const { return ptr != nullptr; }
+
+        jsb_force_inline void ptrcall(Object* p_object, const void** p_args, void* r_ret) const
+        {
+            ::godot::internal::gdextension_interface_object_method_bind_ptrcall(ptr, p_object ? p_object->_owner : nullptr, (const GDExtensionConstTypePtr*) p_args, r_ret);
+        }
+    };
 }
 
 Variant EDITOR_GET(const String &p_setting)
@@ -32,6 +32,28 @@ namespace v8
         return size;
     }
 
+    Maybe<bool> ArrayBuffer::Detach(Local<Value> key)
+    {
+        JSContextRef ctx = isolate_->ctx();
+        const JSObjectRef self = jsb::impl::JavaScriptCore::AsObject(ctx, (JSValueRef) *this);
+        const JSStringRef name = JSStringCreateWithUTF8CString("transfer");
+        JSValueRef error = nullptr;
+        const JSValueRef transfer = JSObjectGetProperty(ctx, self, name, &error);
+        JSStringRelease(name);
+        if (!error && transfer && JSValueIsObject(ctx, transfer) && JSObjectIsFunction(ctx, (JSObjectRef) transfer))
+        {
+            // transfer(0) detaches this buffer and returns an empty one
+            const JSValueRef zero = JSValueMakeNumber(ctx, 0);
+            JSObjectCallAsFunction(ctx, (JSObjectRef) transfer, self, 1, &zero, &error);
+        }
+        if (error)
+        {
+            jsb::impl::JavaScriptCore::MarkExceptionAsTrivial(ctx, error);
+            return Maybe<bool>(false);
+        }
+        return Maybe<bool>(true);
+    }
+
     Local<ArrayBuffer> ArrayBuffer::New(Isolate* isolate, size_t length)
     {
         JSValueRef error = nullptr;
@@ -48,4 +70,22 @@ namespace v8
         memfree(bytes);
     }
 
+    Local<ArrayBuffer> ArrayBuffer::New(Isolate* isolate, void* data, size_t length, DeleterCallback deleter, void* deleter_data)
+    {
+        JSValueRef error = nullptr;
+        ExternalDeleter* external = memnew(ExternalDeleter { deleter, deleter_data, length });
+        const JSObjectRef obj = JSObjectMakeArrayBufferWithBytesNoCopy(isolate->ctx(),
+            data, length,
+            _deallocator_external, /* deallocatorContext */ external,
+            &error);
+        return Local<ArrayBuffer>(v8::Data(isolate, isolate->push_copy(obj)));
+    }
+
+    void ArrayBuffer::_deallocator_external(void* bytes, void* deallocatorContext)
+    {
+        const ExternalDeleter* external = (ExternalDeleter*) deallocatorContext;
+        external->callback(bytes, external->length, external->data);
+        memdelete(external);
+    }
+
 }
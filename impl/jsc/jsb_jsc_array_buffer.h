@@ -19,13 +19,31 @@ namespace v8
             virtual void Free(void* data, size_t length) = 0;
         };
 
+        // same as v8::BackingStore::DeleterCallback
+        typedef void (*DeleterCallback)(void* data, size_t length, void* deleter_data);
+
         void* Data() const;
         size_t ByteLength() const;
 
+        // there is no C API to detach, it's done by `ArrayBuffer.prototype.transfer` if available (otherwise the ArrayBuffer is left as is)
+        bool IsDetachable() const { return true; }
+        Maybe<bool> Detach(Local<Value> key);
+
         static Local<ArrayBuffer> New(Isolate* isolate, size_t length);
 
+        // create an ArrayBuffer over external data (no copy), `deleter` is called when it's garbage collected
+        static Local<ArrayBuffer> New(Isolate* isolate, void* data, size_t length, DeleterCallback deleter, void* deleter_data);
+
     private:
+        struct ExternalDeleter
+        {
+            DeleterCallback callback;
+            void* data;
+            size_t length;
+        };
+
         static void _deallocator(void* bytes, void* deallocatorContext);
+        static void _deallocator_external(void* bytes, void* deallocatorContext);
     };
 }
 #endif
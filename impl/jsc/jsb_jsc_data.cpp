@@ -136,6 +136,15 @@ namespace v8
         return isolate_->_IsArrayBuffer(val);
     }
 
+    bool Data::IsProxy() const
+    {
+        const JSValueRef val = isolate_->stack_val(stack_pos_);
+        if (!JSValueIsObject(isolate_->ctx(), val)) return false;
+        const JSObjectRef self = jsb::impl::JavaScriptCore::AsObject(isolate_->ctx(), val);
+        const jsb::impl::InternalData* internal_data = (jsb::impl::InternalData*) JSObjectGetPrivate(self);
+        return !internal_data || internal_data->internal_field_count == 0;
+    }
+
     bool Data::strict_eq(const Data& other) const
     {
         const JSValueRef val1 = isolate_->stack_val(stack_pos_);
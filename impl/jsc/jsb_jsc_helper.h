@@ -21,14 +21,24 @@ namespace jsb::impl
 
         static PackedByteArray to_packed_byte_array(v8::Isolate* isolate, const v8::Local<v8::ArrayBuffer>& array_buffer)
         {
-            const size_t size = array_buffer->ByteLength();
             PackedByteArray packed;
-            const Error err = packed.resize((int) size);
+            const bool succeeded = to_packed_array(isolate, array_buffer, packed);
+            jsb_unused(succeeded);
+            jsb_check(succeeded);
+            return packed;
+        }
+
+        // copy the content of an ArrayBuffer into a packed array (the byte length must be a multiple of the element size)
+        template<typename T>
+        static bool to_packed_array(v8::Isolate* isolate, const v8::Local<v8::ArrayBuffer>& array_buffer, Vector<T>& r_packed)
+        {
+            const size_t size = array_buffer->ByteLength();
+            if (size % sizeof(T) != 0) return false;
+            const Error err = r_packed.resize((int) (size / sizeof(T)));
             jsb_unused(err);
             jsb_check(err == OK);
-            const void* data = array_buffer->Data();
-            memcpy(packed.ptrw(), data, size);
-            return packed;
+            if (size != 0) memcpy(r_packed.ptrw(), array_buffer->Data(), size);
+            return true;
         }
 
         static v8::Local<v8::ArrayBuffer> to_array_buffer(v8::Isolate* isolate, const Vector<uint8_t>& packed)
@@ -39,6 +49,22 @@ namespace jsb::impl
             return buffer;
         }
 
+        // create an ArrayBuffer over the storage of a packed array without copying.
+        // the storage is shared with `packed` (COW), and kept alive until the ArrayBuffer is garbage collected.
+        template<typename T>
+        static v8::Local<v8::ArrayBuffer> to_array_buffer_view(v8::Isolate* isolate, const Vector<T>& packed)
+        {
+            if (packed.is_empty()) return v8::ArrayBuffer::New(isolate, 0);
+            Vector<T>* storage = memnew(Vector<T>(packed));
+            return v8::ArrayBuffer::New(isolate, (void*) storage->ptr(), storage->size() * sizeof(T), &_release_array_buffer_view<T>, storage);
+        }
+
+        template<typename T>
+        static void _release_array_buffer_view(void* data, size_t length, void* deleter_data)
+        {
+            memdelete((Vector<T>*) deleter_data);
+        }
+
         static v8::Local<v8::Function> NewFunction(v8::Local<v8::Context> context, const char* name, v8::FunctionCallback callback, v8::Local<v8::Value> data)
         {
             v8::Isolate* isolate = context->isolate_;
@@ -150,10 +176,18 @@ namespace jsb::impl
             isolate->throw_error(message);
         }
 
+        // the size of the memory used by the JS heap (in bytes, 0 if not available)
+        jsb_force_inline static size_t get_used_heap_size(v8::Isolate* isolate) { return 0; }
+
         jsb_force_inline static void get_statistics(v8::Isolate* isolate, Vector<CustomField>& p_fields)
         {
         }
 
+        // not available in JavaScriptCore
+        jsb_force_inline static void get_heap_summary(v8::Isolate* isolate, Vector<HeapSummaryEntry>& r_entries)
+        {
+        }
+
         jsb_force_inline static bool to_int64(const v8::Local<v8::Value> p_val, int64_t& r_val)
         {
             if (p_val->IsInt32()) { r_val = p_val.As<v8::Int32>()->Value(); return true; }
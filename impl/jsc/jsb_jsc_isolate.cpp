@@ -38,8 +38,6 @@ namespace v8
 
     Isolate::Isolate() : 
         ref_count_(1), disposed_(false), handle_scope_(nullptr), 
-        pending_delete_(nearest_shift(2048)), 
-        pending_finalize_(nearest_shift(2048)), 
         stack_pos_(0)
     {
         rt_ = JSContextGroupCreate();
@@ -238,22 +236,34 @@ function(key, value, getter, setter) {
 
     void Isolate::PerformMicrotaskCheckpoint()
     {
-        while (pending_delete_.data_left())
+        while (jsb::impl::CFunctionPayload* payload = pending_delete_.take_all())
         {
-            const jsb::impl::CapturedValueID id = pending_delete_.read();
-            const JSValueRef value = captured_values_.get_value(id);
-            JSValueUnprotect(ctx_, value);
-            captured_values_.remove_at(id);
+            do
+            {
+                jsb::impl::CFunctionPayload* next = payload->next_pending;
+                const JSValueRef value = captured_values_.get_value(payload->captured_value_id);
+                JSValueUnprotect(ctx_, value);
+                captured_values_.remove_at(payload->captured_value_id);
+                memdelete(payload);
+                payload = next;
+            }
+            while (payload);
         }
-        while (pending_finalize_.data_left())
+        // the weak callbacks are run in batch (they only post the release to the environment or free the valuetype data)
+        while (jsb::impl::InternalData* data = pending_finalize_.take_all())
         {
-            jsb::impl::InternalData* data = pending_finalize_.read();
-            if (const WeakCallbackInfo<void>::Callback callback = (WeakCallbackInfo<void>::Callback) data->weak.callback)
+            do
             {
-                const WeakCallbackInfo<void> info(this, data->weak.parameter, data->internal_fields);
-                callback(info);
+                jsb::impl::InternalData* next = data->next_pending;
+                if (const WeakCallbackInfo<void>::Callback callback = (WeakCallbackInfo<void>::Callback) data->weak.callback)
+                {
+                    const WeakCallbackInfo<void> info(this, data->weak.parameter, data->internal_fields);
+                    callback(info);
+                }
+                memdelete(data);
+                data = next;
             }
-            memdelete(data);
+            while (data);
         }
     }
 
@@ -295,6 +305,11 @@ function(key, value, getter, setter) {
         return JSValueIsObjectOfClass(ctx_, val, classes_[jsb::impl::ClassID::External]);
     }
 
+    bool Isolate::_IsInstance(JSValueRef val) const
+    {
+        return JSValueIsObjectOfClass(ctx_, val, classes_[jsb::impl::ClassID::Instance]);
+    }
+
     JSObjectRef Isolate::_NewExternal(void* data)
     {
         return JSObjectMake(ctx_, classes_[jsb::impl::ClassID::External], data);
@@ -435,8 +450,7 @@ function(key, value, getter, setter) {
     {
         jsb::impl::CFunctionPayload* payload = (jsb::impl::CFunctionPayload*) JSObjectGetPrivate(obj);
         jsb_check(payload);
-        payload->isolate->_delete_cfunction(payload->captured_value_id);
-        memdelete(payload);
+        payload->isolate->_delete_cfunction(payload);
     }
 
     // no guarantee for main thread
@@ -447,9 +461,7 @@ function(key, value, getter, setter) {
             v8::Isolate* isolate = (v8::Isolate*) data->isolate;
             JSB_JSC_LOG(VeryVerbose, "remove internal data JSObject:%s id:%s", (uintptr_t) obj, (uintptr_t) data);
 
-            //TODO improve: always handle it in environment
-            const ::Error error = isolate->pending_finalize_.write(data);
-            jsb_check(error == ::OK);
+            isolate->pending_finalize_.push(data);
         }
     }
 
@@ -517,12 +529,9 @@ function(key, value, getter, setter) {
         return func_obj;
     }
 
-    void Isolate::_delete_cfunction(jsb::impl::CapturedValueID id)
+    void Isolate::_delete_cfunction(jsb::impl::CFunctionPayload* payload)
     {
-        //TODO delete FunctionData in a thread safe way
-        //TODO JSValueUnprotect(data.data);
-        const ::Error error = pending_delete_.write(id);
-        jsb_check(error == ::OK);
+        pending_delete_.push(payload);
     }
 
 }
@@ -45,6 +45,9 @@ namespace jsb::impl
 
         uint8_t internal_field_count = 0;
         void* internal_fields[2] = { nullptr, nullptr };
+
+        // linked in Isolate::pending_finalize_ after the object finalized
+        InternalData* next_pending = nullptr;
     };
 
     typedef jsb::internal::Index32 CapturedValueID;
@@ -54,6 +57,45 @@ namespace jsb::impl
         v8::Isolate* isolate;
         void* callback;
         CapturedValueID captured_value_id;
+
+        // linked in Isolate::pending_delete_ after the function finalized
+        CFunctionPayload* next_pending = nullptr;
+    };
+
+    // a multi-producer single-consumer list of the nodes linked by `T::next_pending`.
+    // JSC may run finalizers on the collector threads, the nodes are handed over to the isolate thread without locking (and without capacity limit).
+    template<typename T>
+    class PendingList
+    {
+    public:
+        void push(T* p_node)
+        {
+            T* head = head_.load(std::memory_order_relaxed);
+            do
+            {
+                p_node->next_pending = head;
+            }
+            while (!head_.compare_exchange_weak(head, p_node, std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        // take all pending nodes (in the order of pushing), return nullptr if empty
+        T* take_all()
+        {
+            if (!head_.load(std::memory_order_relaxed)) return nullptr;
+            T* node = head_.exchange(nullptr, std::memory_order_acquire);
+            T* reversed = nullptr;
+            while (node)
+            {
+                T* next = node->next_pending;
+                node->next_pending = reversed;
+                reversed = node;
+                node = next;
+            }
+            return reversed;
+        }
+
+    private:
+        std::atomic<T*> head_ = nullptr;
     };
 
     struct CConstructorPayload
@@ -137,6 +179,7 @@ namespace v8
         void PerformMicrotaskCheckpoint();
         void LowMemoryNotification();
         void SetBatterySaverMode(bool) {}
+        void SetAllowAtomicsWait(bool) {}
         void RequestGarbageCollectionForTesting(GarbageCollectionType type);
         Local<Context> GetCurrentContext();
 
@@ -156,6 +199,8 @@ namespace v8
         bool _IsPromise(JSValueRef val) const;
         bool _IsMap(JSValueRef val) const;
         bool _IsExternal(JSValueRef val) const;
+        // objects with internal fields (godot objects and variants)
+        bool _IsInstance(JSValueRef val) const;
         bool _IsArrayBuffer(JSValueRef val) const;
         JSValueRef _GetProperty(JSObjectRef obj, JSAtom atom);
         bool _SetProperty(JSObjectRef obj, JSAtom atom, JSValueRef value);
@@ -170,7 +215,8 @@ namespace v8
         static bool _hasInstance_callback(JSContextRef ctx, JSObjectRef constructor, JSValueRef possibleInstance, JSValueRef* exception);
         JSObjectRef _NewConstructor(JSObjectCallAsConstructorCallback func, const char* name, v8::FunctionCallback callback, uint32_t class_payload);
         JSObjectRef _NewObjectProtoClass(JSValueRef prototype, void* data);
-        void _delete_cfunction(jsb::impl::CapturedValueID id);
+        // [any thread] postpone the release of the captured value to the isolate thread
+        void _delete_cfunction(jsb::impl::CFunctionPayload* payload);
         JSValueRef _get_captured_value(jsb::impl::CapturedValueID id) { return captured_values_.get_value(id); }
 
         // return nullptr if exception is thrown (saved in stack)
@@ -308,8 +354,9 @@ namespace v8
         JSObjectRef bridge_calls_[jsb::impl::JSBridgeCall::Num];
 
         jsb::internal::SArray<JSValueRef, jsb::impl::CapturedValueID> captured_values_;
-        RingBuffer<jsb::impl::CapturedValueID> pending_delete_;
-        RingBuffer<jsb::impl::InternalData*> pending_finalize_; //TODO improve
+        // drained in PerformMicrotaskCheckpoint
+        jsb::impl::PendingList<jsb::impl::CFunctionPayload> pending_delete_;
+        jsb::impl::PendingList<jsb::impl::InternalData> pending_finalize_;
 
         uint16_t stack_pos_;
         JSValueRef stack_[jsb::impl::kMaxStackSize];
@@ -18,6 +18,7 @@
 #include "JSWeakPrivate.h"
 
 #include <memory>
+#include <atomic>
 #include <cstdint>
 
 #define JSB_JSC_LOG(Severity, Format, ...) JSB_LOG_IMPL(jsc, Severity, Format, ##__VA_ARGS__)
@@ -3,23 +3,80 @@
 #include "jsb_jsc_context.h"
 #include "jsb_jsc_maybe.h"
 #include "jsb_jsc_handle.h"
+#include "jsb_jsc_handle_scope.h"
 #include "jsb_jsc_isolate.h"
 
 namespace v8
 {
-    ValueSerializer::ValueSerializer(Isolate* isolate)
+    namespace
     {
+        constexpr uint8_t kMagic = 'C';
+        constexpr uint8_t kVersion = 1;
 
+        // deeper values are rejected instead of overflowing the native stack
+        constexpr int kMaxDepth = 512;
+
+        enum SerializationTag : uint8_t
+        {
+            kUndefined = '_',
+            kNull = '0',
+            kTrue = 'T',
+            kFalse = 'F',
+            kInt32 = 'I',           // zigzag varint
+            kDouble = 'N',          // 8 bytes
+            kString8 = 's',         // varint length, latin-1 characters
+            kString16 = 'w',        // varint length, utf16 code units
+            kKeyRef = 'k',          // varint index of a property name already written
+            kArray = 'A',           // varint length, elements (holes are read as undefined)
+            kObject = 'O',          // varint count, (name, value) pairs
+            kObjectRef = 'R',       // varint index of an object already written
+            kArrayBuffer = 'B',     // varint length, bytes
+            kTypedArray = 'W',      // element type (JSTypedArrayType), varint byte length, bytes
+            kDate = 'D',            // 8 bytes (time value)
+            kHostObject = 'H',      // written by the delegate
+        };
+
+        size_t get_element_size(JSTypedArrayType p_type)
+        {
+            switch (p_type)
+            {
+            case kJSTypedArrayTypeInt8Array: case kJSTypedArrayTypeUint8Array: case kJSTypedArrayTypeUint8ClampedArray: return 1;
+            case kJSTypedArrayTypeInt16Array: case kJSTypedArrayTypeUint16Array: return 2;
+            case kJSTypedArrayTypeInt32Array: case kJSTypedArrayTypeUint32Array: case kJSTypedArrayTypeFloat32Array: return 4;
+            case kJSTypedArrayTypeFloat64Array: case kJSTypedArrayTypeBigInt64Array: case kJSTypedArrayTypeBigUint64Array: return 8;
+            default: return 0;
+            }
+        }
+
+        void free_bytes(void* bytes, void* deallocator_context)
+        {
+            memfree(bytes);
+        }
+    }
+
+    ValueSerializer::ValueSerializer(Isolate* isolate, Delegate* delegate)
+        : isolate_(isolate), delegate_(delegate)
+    {
+        JSContextRef ctx = isolate_->ctx();
+        object_prototype_ = JSObjectGetPrototype(ctx, JSObjectMake(ctx, nullptr, nullptr));
+        JSValueProtect(ctx, object_prototype_);
+    }
+
+    ValueSerializer::~ValueSerializer()
+    {
+        JSValueUnprotect(isolate_->ctx(), object_prototype_);
+        if (buffer_) memfree(buffer_);
     }
 
     void ValueSerializer::WriteHeader()
     {
+        _write_byte(kMagic);
+        _write_byte(kVersion);
     }
 
     Maybe<bool> ValueSerializer::WriteValue(Local<Context> context, Local<Value> value)
     {
-        //TODO serialize with JSON as a workaround?
-        return Maybe<bool>();
+        return _write_value((JSValueRef) value, 0) ? Maybe<bool>(true) : Maybe<bool>();
     }
 
     std::pair<uint8_t*, size_t> ValueSerializer::Release()
@@ -27,23 +84,541 @@ namespace v8
         std::pair<uint8_t*, size_t> rval = { buffer_, size_ };
         buffer_ = nullptr;
         size_ = 0;
+        capacity_ = 0;
         return rval;
     }
 
-    ValueDeserializer::ValueDeserializer(Isolate* isolate, const uint8_t* data, size_t size)
-        : buffer_(const_cast<uint8_t*>(data)), size_(size)
+    void ValueSerializer::WriteUint32(uint32_t value)
+    {
+        _write_varint(value);
+    }
+
+    void ValueSerializer::WriteRawBytes(const void* source, size_t length)
+    {
+        memcpy(_reserve(length), source, length);
+    }
+
+    uint8_t* ValueSerializer::_reserve(size_t p_size)
     {
+        if (size_ + p_size > capacity_)
+        {
+            capacity_ = MAX(MAX(capacity_ * 2, size_ + p_size), (size_t) 64);
+            buffer_ = (uint8_t*) memrealloc(buffer_, capacity_);
+        }
+        uint8_t* ptr = buffer_ + size_;
+        size_ += p_size;
+        return ptr;
+    }
+
+    void ValueSerializer::_write_byte(uint8_t p_byte)
+    {
+        *_reserve(1) = p_byte;
+    }
+
+    void ValueSerializer::_write_varint(uint32_t p_value)
+    {
+        uint8_t bytes[5];
+        size_t len = 0;
+        do
+        {
+            uint8_t byte = p_value & 0x7f;
+            p_value >>= 7;
+            if (p_value) byte |= 0x80;
+            bytes[len++] = byte;
+        }
+        while (p_value);
+        memcpy(_reserve(len), bytes, len);
+    }
+
+    bool ValueSerializer::_rethrow(JSValueRef p_error)
+    {
+        isolate_->_ThrowError(p_error);
+        return false;
+    }
+
+    bool ValueSerializer::_write_value(JSValueRef p_value, int p_depth)
+    {
+        JSContextRef ctx = isolate_->ctx();
+        switch (JSValueGetType(ctx, p_value))
+        {
+        case kJSTypeUndefined: _write_tag(kUndefined); return true;
+        case kJSTypeNull: _write_tag(kNull); return true;
+        case kJSTypeBoolean: _write_tag(JSValueToBoolean(ctx, p_value) ? kTrue : kFalse); return true;
+        case kJSTypeNumber:
+            {
+                const double value = JSValueToNumber(ctx, p_value, nullptr);
+                const int32_t int_value = (int32_t) value;
+                if ((double) int_value == value && !(int_value == 0 && std::signbit(value)))
+                {
+                    _write_tag(kInt32);
+                    _write_varint(((uint32_t) int_value << 1) ^ (uint32_t) (int_value >> 31));
+                    return true;
+                }
+                _write_tag(kDouble);
+                memcpy(_reserve(sizeof(value)), &value, sizeof(value));
+                return true;
+            }
+        case kJSTypeString:
+            {
+                JSValueRef error = nullptr;
+                const JSStringRef str = JSValueToStringCopy(ctx, p_value, &error);
+                if (!str) return _rethrow(error);
+                _write_string(str);
+                JSStringRelease(str);
+                return true;
+            }
+        case kJSTypeObject: return _write_object(jsb::impl::JavaScriptCore::AsObject(ctx, p_value), p_depth);
+        // Symbol, BigInt
+        default:
+            isolate_->throw_error("the value can not be cloned");
+            return false;
+        }
+    }
+
+    bool ValueSerializer::_write_string(JSStringRef p_str)
+    {
+        const size_t len = JSStringGetLength(p_str);
+        const JSChar* chars = JSStringGetCharactersPtr(p_str);
+        bool latin1 = true;
+        for (size_t i = 0; i < len; ++i)
+        {
+            if (chars[i] > 0xff)
+            {
+                latin1 = false;
+                break;
+            }
+        }
+
+        _write_tag(latin1 ? kString8 : kString16);
+        _write_varint((uint32_t) len);
+        if (latin1)
+        {
+            uint8_t* dst = _reserve(len);
+            for (size_t i = 0; i < len; ++i)
+            {
+                dst[i] = (uint8_t) chars[i];
+            }
+        }
+        else
+        {
+            memcpy(_reserve(len * sizeof(JSChar)), chars, len * sizeof(JSChar));
+        }
+        return true;
+    }
+
+    bool ValueSerializer::_write_key(JSStringRef p_name)
+    {
+        const String name = String::utf16((const char16_t*) JSStringGetCharactersPtr(p_name), (int) JSStringGetLength(p_name));
+        if (const uint32_t* index = keys_.getptr(name))
+        {
+            _write_tag(kKeyRef);
+            _write_varint(*index);
+            return true;
+        }
+        keys_.insert(name, keys_.size());
+        return _write_string(p_name);
+    }
+
+    bool ValueSerializer::_write_object(JSObjectRef p_object, int p_depth)
+    {
+        JSContextRef ctx = isolate_->ctx();
+        if (p_depth >= kMaxDepth)
+        {
+            isolate_->throw_error("the value is nested too deeply to be cloned");
+            return false;
+        }
+
+        if (const uint32_t* index = objects_.getptr(p_object))
+        {
+            _write_tag(kObjectRef);
+            _write_varint(*index);
+            return true;
+        }
+
+        // godot objects and variants
+        if (isolate_->_IsInstance(p_object))
+        {
+            if (!delegate_)
+            {
+                isolate_->throw_error("a host object can not be cloned");
+                return false;
+            }
+            objects_.insert(p_object, objects_.size());
+            _write_tag(kHostObject);
+
+            HandleScope handle_scope(isolate_);
+            const Local<Object> object(Data(isolate_, isolate_->push_copy(p_object)));
+            return delegate_->WriteHostObject(isolate_, object).IsJust();
+        }
+
+        if (JSObjectIsFunction(ctx, p_object) || isolate_->_IsMap(p_object) || isolate_->_IsPromise(p_object))
+        {
+            isolate_->throw_error("the object can not be cloned");
+            return false;
+        }
+
+        JSValueRef error = nullptr;
+        if (JSValueIsArray(ctx, p_object))
+        {
+            const JSValueRef len_val = isolate_->_GetProperty(p_object, jsb::impl::JS_ATOM_length);
+            const uint32_t len = len_val ? (uint32_t) JSValueToNumber(ctx, len_val, nullptr) : 0;
+
+            objects_.insert(p_object, objects_.size());
+            _write_tag(kArray);
+            _write_varint(len);
+            for (uint32_t i = 0; i < len; ++i)
+            {
+                const JSValueRef element = JSObjectGetPropertyAtIndex(ctx, p_object, i, &error);
+                if (error) return _rethrow(error);
+                if (!_write_value(element, p_depth + 1)) return false;
+            }
+            return true;
+        }
+
+        if (JSValueIsDate(ctx, p_object))
+        {
+            const double time = JSValueToNumber(ctx, p_object, &error);
+            if (error) return _rethrow(error);
+            objects_.insert(p_object, objects_.size());
+            _write_tag(kDate);
+            memcpy(_reserve(sizeof(time)), &time, sizeof(time));
+            return true;
+        }
+
+        // the C API of JavaScriptCore can't tell SharedArrayBuffers apart, they are copied as ArrayBuffers
+        const JSTypedArrayType type = JSValueGetTypedArrayType(ctx, p_object, &error);
+        if (error) return _rethrow(error);
+        if (type == kJSTypedArrayTypeArrayBuffer)
+        {
+            const size_t size = JSObjectGetArrayBufferByteLength(ctx, p_object, &error);
+            const uint8_t* data = error ? nullptr : (const uint8_t*) JSObjectGetArrayBufferBytesPtr(ctx, p_object, &error);
+            if (error) return _rethrow(error);
+            objects_.insert(p_object, objects_.size());
+            _write_tag(kArrayBuffer);
+            _write_varint((uint32_t) size);
+            if (size) memcpy(_reserve(size), data, size);
+            return true;
+        }
+        if (type != kJSTypedArrayTypeNone)
+        {
+            const size_t offset = JSObjectGetTypedArrayByteOffset(ctx, p_object, &error);
+            const size_t length = error ? 0 : JSObjectGetTypedArrayByteLength(ctx, p_object, &error);
+            const JSObjectRef buffer = error ? nullptr : JSObjectGetTypedArrayBuffer(ctx, p_object, &error);
+            const uint8_t* data = error ? nullptr : (const uint8_t*) JSObjectGetArrayBufferBytesPtr(ctx, buffer, &error);
+            if (error) return _rethrow(error);
+
+            // only the viewed range is copied (into a new ArrayBuffer of the receiver)
+            objects_.insert(p_object, objects_.size());
+            _write_tag(kTypedArray);
+            _write_byte((uint8_t) type);
+            _write_varint((uint32_t) length);
+            if (length) memcpy(_reserve(length), data + offset, length);
+            return true;
+        }
+
+        // plain objects and instances of script classes (the prototype is not preserved, same as v8)
+        const JSPropertyNameArrayRef names = JSObjectCopyPropertyNames(ctx, p_object);
+        const size_t len = JSPropertyNameArrayGetCount(names);
+        objects_.insert(p_object, objects_.size());
+        _write_tag(kObject);
+        _write_varint((uint32_t) len);
+        bool written = true;
+        for (size_t i = 0; i < len && written; ++i)
+        {
+            const JSStringRef name = JSPropertyNameArrayGetNameAtIndex(names, i);
+            const JSValueRef value = JSObjectGetProperty(ctx, p_object, name, &error);
+            written = error ? _rethrow(error) : _write_key(name) && _write_value(value, p_depth + 1);
+        }
+        JSPropertyNameArrayRelease(names);
+        return written;
+    }
+
+    ValueDeserializer::ValueDeserializer(Isolate* isolate, const uint8_t* data, size_t size, Delegate* delegate)
+        : isolate_(isolate), delegate_(delegate), buffer_(data), size_(size)
+    {
+    }
+
+    ValueDeserializer::~ValueDeserializer()
+    {
+        JSContextRef ctx = isolate_->ctx();
+        for (const JSStringRef key : keys_)
+        {
+            JSStringRelease(key);
+        }
+        for (const JSObjectRef object : objects_)
+        {
+            JSValueUnprotect(ctx, object);
+        }
     }
 
     Maybe<bool> ValueDeserializer::ReadHeader(Local<Context> context)
     {
-        return Maybe(true);
+        uint8_t magic, version;
+        return Maybe(_read_byte(magic) && magic == kMagic && _read_byte(version) && version == kVersion);
     }
 
     MaybeLocal<Value> ValueDeserializer::ReadValue(Local<Context> context)
     {
-        //TODO deserialize with JSON as a workaround?
-        return MaybeLocal<Value>();
+        Isolate* isolate = context->GetIsolate();
+        const JSValueRef rval = _read_value(0);
+        if (!rval)
+        {
+            if (isolate->_HasError())
+            {
+                jsb::impl::JavaScriptCore::MarkExceptionAsTrivial(isolate->ctx(), isolate->_GetError());
+            }
+            return MaybeLocal<Value>();
+        }
+
+        return MaybeLocal<Value>(Data(isolate, isolate->push_copy(rval)));
+    }
+
+    bool ValueDeserializer::ReadUint32(uint32_t* value)
+    {
+        return _read_varint(*value);
+    }
+
+    bool ValueDeserializer::ReadRawBytes(size_t length, const void** data)
+    {
+        if (length > size_ - position_)
+        {
+            return false;
+        }
+        *data = buffer_ + position_;
+        position_ += length;
+        return true;
+    }
+
+    bool ValueDeserializer::_read_byte(uint8_t& r_byte)
+    {
+        if (position_ >= size_)
+        {
+            return false;
+        }
+        r_byte = buffer_[position_++];
+        return true;
+    }
+
+    bool ValueDeserializer::_read_varint(uint32_t& r_value)
+    {
+        uint32_t value = 0;
+        for (int shift = 0; shift < 35; shift += 7)
+        {
+            uint8_t byte;
+            if (!_read_byte(byte))
+            {
+                return false;
+            }
+            value |= (uint32_t) (byte & 0x7f) << shift;
+            if (!(byte & 0x80))
+            {
+                r_value = value;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    JSValueRef ValueDeserializer::_throw_invalid()
+    {
+        isolate_->throw_error("invalid serialized data");
+        return nullptr;
+    }
+
+    JSValueRef ValueDeserializer::_rethrow(JSValueRef p_error)
+    {
+        isolate_->_ThrowError(p_error);
+        return nullptr;
+    }
+
+    JSObjectRef ValueDeserializer::_add_object(JSObjectRef p_object)
+    {
+        JSValueProtect(isolate_->ctx(), p_object);
+        objects_.push_back(p_object);
+        return p_object;
     }
 
+    JSStringRef ValueDeserializer::_read_string(uint8_t p_tag)
+    {
+        uint32_t len;
+        const void* chars;
+        if (!_read_varint(len) || !ReadRawBytes(p_tag == kString8 ? len : len * sizeof(JSChar), &chars))
+        {
+            return nullptr;
+        }
+        if (p_tag == kString16)
+        {
+            LocalVector<JSChar> aligned;
+            aligned.resize(len);
+            if (len) memcpy(aligned.ptr(), chars, len * sizeof(JSChar));
+            return JSStringCreateWithCharacters(aligned.ptr(), len);
+        }
+
+        LocalVector<JSChar> widened;
+        widened.resize(len);
+        for (uint32_t i = 0; i < len; ++i)
+        {
+            widened[i] = ((const uint8_t*) chars)[i];
+        }
+        return JSStringCreateWithCharacters(widened.ptr(), len);
+    }
+
+    JSStringRef ValueDeserializer::_read_key()
+    {
+        uint8_t tag;
+        if (!_read_byte(tag))
+        {
+            return nullptr;
+        }
+        if (tag == kKeyRef)
+        {
+            uint32_t index;
+            if (!_read_varint(index) || index >= (uint32_t) keys_.size())
+            {
+                return nullptr;
+            }
+            return keys_[index];
+        }
+        if (tag != kString8 && tag != kString16)
+        {
+            return nullptr;
+        }
+        const JSStringRef key = _read_string(tag);
+        if (key) keys_.push_back(key);
+        return key;
+    }
+
+    JSValueRef ValueDeserializer::_read_value(int p_depth)
+    {
+        JSContextRef ctx = isolate_->ctx();
+        uint8_t tag;
+        if (!_read_byte(tag) || p_depth >= kMaxDepth)
+        {
+            return _throw_invalid();
+        }
+
+        JSValueRef error = nullptr;
+        switch (tag)
+        {
+        case kUndefined: return JSValueMakeUndefined(ctx);
+        case kNull: return JSValueMakeNull(ctx);
+        case kTrue: return JSValueMakeBoolean(ctx, true);
+        case kFalse: return JSValueMakeBoolean(ctx, false);
+        case kInt32:
+            {
+                uint32_t value;
+                if (!_read_varint(value)) return _throw_invalid();
+                return JSValueMakeNumber(ctx, (int32_t) ((value >> 1) ^ (0u - (value & 1))));
+            }
+        case kDouble:
+            {
+                const void* bytes;
+                if (!ReadRawBytes(sizeof(double), &bytes)) return _throw_invalid();
+                double value;
+                memcpy(&value, bytes, sizeof(value));
+                return JSValueMakeNumber(ctx, value);
+            }
+        case kString8:
+        case kString16:
+            {
+                const JSStringRef str = _read_string(tag);
+                if (!str) return _throw_invalid();
+                const JSValueRef value = JSValueMakeString(ctx, str);
+                JSStringRelease(str);
+                return value;
+            }
+        case kObjectRef:
+            {
+                uint32_t index;
+                if (!_read_varint(index) || index >= (uint32_t) objects_.size()) return _throw_invalid();
+                return objects_[index];
+            }
+        case kArray:
+            {
+                uint32_t len;
+                if (!_read_varint(len)) return _throw_invalid();
+                const JSObjectRef array = JSObjectMakeArray(ctx, 0, nullptr, &error);
+                if (!array) return _rethrow(error);
+                _add_object(array);
+                for (uint32_t i = 0; i < len; ++i)
+                {
+                    const JSValueRef element = _read_value(p_depth + 1);
+                    if (!element) return nullptr;
+                    JSObjectSetPropertyAtIndex(ctx, array, i, element, &error);
+                    if (error) return _rethrow(error);
+                }
+                return array;
+            }
+        case kObject:
+            {
+                uint32_t len;
+                if (!_read_varint(len)) return _throw_invalid();
+                const JSObjectRef object = _add_object(JSObjectMake(ctx, nullptr, nullptr));
+                for (uint32_t i = 0; i < len; ++i)
+                {
+                    const JSStringRef key = _read_key();
+                    if (!key) return _throw_invalid();
+                    const JSValueRef value = _read_value(p_depth + 1);
+                    if (!value) return nullptr;
+                    JSObjectSetProperty(ctx, object, key, value, kJSPropertyAttributeNone, &error);
+                    if (error) return _rethrow(error);
+                }
+                return object;
+            }
+        case kDate:
+            {
+                const void* bytes;
+                if (!ReadRawBytes(sizeof(double), &bytes)) return _throw_invalid();
+                double time;
+                memcpy(&time, bytes, sizeof(time));
+                const JSValueRef arg = JSValueMakeNumber(ctx, time);
+                const JSObjectRef date = JSObjectMakeDate(ctx, 1, &arg, &error);
+                if (!date) return _rethrow(error);
+                return _add_object(date);
+            }
+        case kArrayBuffer:
+            {
+                uint32_t len;
+                const void* data;
+                if (!_read_varint(len) || !ReadRawBytes(len, &data)) return _throw_invalid();
+                void* bytes = memalloc(MAX(len, 1u));
+                if (len) memcpy(bytes, data, len);
+                const JSObjectRef buffer = JSObjectMakeArrayBufferWithBytesNoCopy(ctx, bytes, len, free_bytes, nullptr, &error);
+                if (!buffer)
+                {
+                    memfree(bytes);
+                    return _rethrow(error);
+                }
+                return _add_object(buffer);
+            }
+        case kTypedArray:
+            {
+                uint8_t type;
+                uint32_t len;
+                const void* data;
+                if (!_read_byte(type) || !_read_varint(len) || !ReadRawBytes(len, &data)) return _throw_invalid();
+                const size_t element_size = get_element_size((JSTypedArrayType) type);
+                if (element_size == 0 || len % element_size != 0) return _throw_invalid();
+                const JSObjectRef typed_array = JSObjectMakeTypedArray(ctx, (JSTypedArrayType) type, len / element_size, &error);
+                if (!typed_array) return _rethrow(error);
+                _add_object(typed_array);
+                if (len)
+                {
+                    void* bytes = JSObjectGetTypedArrayBytesPtr(ctx, typed_array, &error);
+                    if (!bytes) return _rethrow(error);
+                    memcpy(bytes, data, len);
+                }
+                return typed_array;
+            }
+        case kHostObject:
+            {
+                if (!delegate_) return _throw_invalid();
+                HandleScope handle_scope(isolate_);
+                Local<Object> object;
+                if (!delegate_->ReadHostObject(isolate_).ToLocal(&object)) return _throw_invalid();
+                return _add_object(jsb::impl::JavaScriptCore::AsObject(ctx, (JSValueRef) object));
+            }
+        default: return _throw_invalid();
+        }
+    }
 }
@@ -17,29 +17,119 @@ namespace v8
 
     class Context;
     class Value;
+    class Object;
 
+    // the structured clone format of jsb over the C API of JavaScriptCore (which has no serializer of its own),
+    // it's the same layout as the one of quickjs.impl but not interchangeable (messages never cross the backends)
     class ValueSerializer
     {
-        uint8_t* buffer_ = nullptr;
-        size_t size_ = 0;
-
     public:
-        explicit ValueSerializer(Isolate* isolate);
+        class Delegate
+        {
+        public:
+            virtual ~Delegate() = default;
+
+            // write an object with internal fields (godot objects and variants) with WriteUint32/WriteRawBytes,
+            // return Nothing with an exception thrown if it can't be cloned
+            virtual Maybe<bool> WriteHostObject(Isolate* isolate, Local<Object> object) = 0;
+        };
+
+        explicit ValueSerializer(Isolate* isolate, Delegate* delegate = nullptr);
+        ~ValueSerializer();
+
+        ValueSerializer(const ValueSerializer&) = delete;
+        ValueSerializer& operator=(const ValueSerializer&) = delete;
 
         void WriteHeader();
         Maybe<bool> WriteValue(Local<Context> context, Local<Value> value);
         std::pair<uint8_t*, size_t> Release();
-    };
 
-    class ValueDeserializer
-    {
+        void WriteUint32(uint32_t value);
+        void WriteRawBytes(const void* source, size_t length);
+
+    private:
+        bool _write_value(JSValueRef p_value, int p_depth);
+        bool _write_object(JSObjectRef p_object, int p_depth);
+        bool _write_key(JSStringRef p_name);
+        bool _write_string(JSStringRef p_str);
+
+        // an exception returned by the C API of JavaScriptCore is rethrown on the isolate
+        bool _rethrow(JSValueRef p_error);
+
+        void _write_tag(uint8_t p_tag) { _write_byte(p_tag); }
+        void _write_byte(uint8_t p_byte);
+        void _write_varint(uint32_t p_value);
+        uint8_t* _reserve(size_t p_size);
+
+        Isolate* isolate_;
+        Delegate* delegate_;
+
         uint8_t* buffer_ = nullptr;
         size_t size_ = 0;
+        size_t capacity_ = 0;
+
+        // the prototype of plain objects (protected)
+        JSValueRef object_prototype_ = nullptr;
+
+        // property names already written, referenced by index
+        HashMap<String, uint32_t> keys_;
+
+        // objects already written, referenced by index (preserve the identity and cycles),
+        // they're reachable from the value being written, so they are never collected before the serializer is released
+        HashMap<JSObjectRef, uint32_t> objects_;
+    };
 
+    class ValueDeserializer
+    {
     public:
-        ValueDeserializer(Isolate* isolate, const uint8_t* data, size_t size);
+        class Delegate
+        {
+        public:
+            virtual ~Delegate() = default;
+
+            // read an object written by ValueSerializer::Delegate::WriteHostObject
+            virtual MaybeLocal<Object> ReadHostObject(Isolate* isolate) = 0;
+        };
+
+        ValueDeserializer(Isolate* isolate, const uint8_t* data, size_t size, Delegate* delegate = nullptr);
+        ~ValueDeserializer();
+
+        ValueDeserializer(const ValueDeserializer&) = delete;
+        ValueDeserializer& operator=(const ValueDeserializer&) = delete;
+
         Maybe<bool> ReadHeader(Local<Context> context);
         MaybeLocal<Value> ReadValue(Local<Context> context);
+
+        bool ReadUint32(uint32_t* value);
+        bool ReadRawBytes(size_t length, const void** data);
+
+    private:
+        // return nullptr if failed (with an exception thrown on the isolate)
+        JSValueRef _read_value(int p_depth);
+        JSStringRef _read_string(uint8_t p_tag);
+        JSStringRef _read_key();
+
+        // keep a created object alive until the deserializer is released
+        JSObjectRef _add_object(JSObjectRef p_object);
+
+        bool _read_byte(uint8_t& r_byte);
+        bool _read_varint(uint32_t& r_value);
+
+        JSValueRef _throw_invalid();
+        JSValueRef _rethrow(JSValueRef p_error);
+
+        Isolate* isolate_;
+        Delegate* delegate_;
+
+        const uint8_t* buffer_ = nullptr;
+        size_t size_ = 0;
+        size_t position_ = 0;
+
+        // owned
+        std::vector<JSStringRef> keys_;
+
+        // objects in the order of creation (protected)
+        std::vector<JSObjectRef> objects_;
     };
 }
 #endif
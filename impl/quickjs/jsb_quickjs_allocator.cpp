@@ -0,0 +1,177 @@
+#include "jsb_quickjs_allocator.h"
+
+namespace jsb::impl
+{
+    namespace
+    {
+        // (size + 15) / 16 => size class index
+        struct SizeClassTable
+        {
+            uint8_t indices[SlabAllocator::kMaxSlabSize / 16 + 1];
+
+            constexpr SizeClassTable() : indices()
+            {
+                int class_index = 0;
+                for (uint32_t i = 0; i <= SlabAllocator::kMaxSlabSize / 16; ++i)
+                {
+                    while (SlabAllocator::kSizeClasses[class_index] < i * 16) ++class_index;
+                    indices[i] = (uint8_t) class_index;
+                }
+            }
+        };
+
+        constexpr SizeClassTable kSizeClassTable;
+    }
+
+    int SlabAllocator::get_size_class(size_t p_size)
+    {
+        return p_size <= kMaxSlabSize ? kSizeClassTable.indices[(p_size + 15) / 16] : -1;
+    }
+
+    void* SlabAllocator::alloc(size_t p_size)
+    {
+        const int class_index = get_size_class(p_size);
+        if (class_index < 0)
+        {
+            jsb_check(p_size < UINT32_MAX - sizeof(Header));
+            Header* header = (Header*) memalloc(sizeof(Header) + p_size);
+            if (unlikely(!header)) return nullptr;
+            header->size_class = kLargeClass;
+            header->size = (uint32_t) p_size;
+            ++large_count_;
+            large_size_ += p_size;
+            return header + 1;
+        }
+
+        SizeClass& size_class = classes_[class_index];
+        if (unlikely(!size_class.free_list))
+        {
+            refill(class_index);
+        }
+        FreeBlock* block = size_class.free_list;
+        size_class.free_list = block->next;
+        ++size_class.used;
+
+        Header* header = (Header*) block;
+        header->size_class = (uint32_t) class_index;
+        header->size = kSizeClasses[class_index];
+        return header + 1;
+    }
+
+    void SlabAllocator::free(void* p_ptr)
+    {
+        if (!p_ptr) return;
+        Header* header = (Header*) p_ptr - 1;
+        if (header->size_class == kLargeClass)
+        {
+            --large_count_;
+            large_size_ -= header->size;
+            memfree(header);
+            return;
+        }
+
+        jsb_check(header->size_class < (uint32_t) kNumSizeClasses);
+        SizeClass& size_class = classes_[header->size_class];
+        FreeBlock* block = (FreeBlock*) header;
+        block->next = size_class.free_list;
+        size_class.free_list = block;
+        --size_class.used;
+    }
+
+    void* SlabAllocator::realloc(void* p_ptr, size_t p_size)
+    {
+        if (!p_ptr) return p_size ? alloc(p_size) : nullptr;
+        if (p_size == 0)
+        {
+            free(p_ptr);
+            return nullptr;
+        }
+
+        Header* header = (Header*) p_ptr - 1;
+        if (header->size_class == kLargeClass)
+        {
+            // large to large, reallocate in place if possible
+            if (get_size_class(p_size) < 0)
+            {
+                Header* new_header = (Header*) memrealloc(header, sizeof(Header) + p_size);
+                if (unlikely(!new_header)) return nullptr;
+                large_size_ = large_size_ - new_header->size + p_size;
+                new_header->size = (uint32_t) p_size;
+                return new_header + 1;
+            }
+        }
+        else if (get_size_class(p_size) == (int) header->size_class)
+        {
+            return p_ptr;
+        }
+
+        void* new_ptr = alloc(p_size);
+        if (unlikely(!new_ptr)) return nullptr;
+        memcpy(new_ptr, p_ptr, MIN(p_size, (size_t) header->size));
+        free(p_ptr);
+        return new_ptr;
+    }
+
+    void SlabAllocator::refill(int p_class_index)
+    {
+        SizeClass& size_class = classes_[p_class_index];
+        const size_t block_size = sizeof(Header) + kSizeClasses[p_class_index];
+        const uint32_t num_blocks = (uint32_t) (kPageSize / block_size);
+        uint8_t* page = (uint8_t*) memalloc(kPageSize);
+        CRASH_COND_MSG(!page, "out of memory");
+        pages_.push_back(page);
+
+        // link in the reversed order, so that the blocks are allocated from the start of the page
+        for (uint32_t i = num_blocks; i > 0; --i)
+        {
+            FreeBlock* block = (FreeBlock*) (page + (i - 1) * block_size);
+            block->next = size_class.free_list;
+            size_class.free_list = block;
+        }
+        size_class.capacity += num_blocks;
+    }
+
+    void SlabAllocator::release()
+    {
+        for (void* page : pages_)
+        {
+            memfree(page);
+        }
+        pages_.clear();
+        for (SizeClass& size_class : classes_)
+        {
+            size_class = SizeClass();
+        }
+    }
+
+    size_t SlabAllocator::get_allocated_size() const
+    {
+        size_t size = (size_t) large_size_;
+        for (int i = 0; i < kNumSizeClasses; ++i)
+        {
+            size += (size_t) classes_[i].used * kSizeClasses[i];
+        }
+        return size;
+    }
+
+    void SlabAllocator::get_statistics(Vector<CustomField>& r_fields) const
+    {
+        uint64_t used_size = 0;
+        uint64_t capacity_size = 0;
+        for (int i = 0; i < kNumSizeClasses; ++i)
+        {
+            used_size += (uint64_t) classes_[i].used * kSizeClasses[i];
+            capacity_size += (uint64_t) classes_[i].capacity * kSizeClasses[i];
+        }
+        r_fields.append(CustomField::value_u64("slab_page_count", pages_.size()));
+        r_fields.append(CustomField::value_u64("slab_page_size", (uint64_t) pages_.size() * kPageSize, CustomField::HINT_SIZE));
+        r_fields.append(CustomField::cap_u64("slab_used_size", used_size, capacity_size, CustomField::HINT_SIZE));
+        for (int i = 0; i < kNumSizeClasses; ++i)
+        {
+            if (classes_[i].capacity == 0) continue;
+            r_fields.append(CustomField::cap_u64(jsb_format("slab_%d", kSizeClasses[i]), classes_[i].used, classes_[i].capacity));
+        }
+        r_fields.append(CustomField::value_u64("large_block_count", large_count_));
+        r_fields.append(CustomField::value_u64("large_block_size", large_size_, CustomField::HINT_SIZE));
+    }
+}
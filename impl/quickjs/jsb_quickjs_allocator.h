@@ -0,0 +1,84 @@
+#ifndef GODOTJS_QUICKJS_ALLOCATOR_H
+#define GODOTJS_QUICKJS_ALLOCATOR_H
+#include "jsb_quickjs_pch.h"
+
+namespace jsb::impl
+{
+    /**
+     * A size-class slab allocator for a QuickJS runtime (installed as JSMallocFunctions).
+     * Small blocks (JSObject, JSShape, property arrays, short strings etc.) are carved from pages owned by the allocator,
+     * larger blocks fall back to the general allocator.
+     * Each isolate (and each worker) owns its allocator, all pages are freed at once on the isolate disposing.
+     * NOTE: not thread-safe, a QuickJS runtime is always used by a single thread.
+     */
+    class SlabAllocator
+    {
+    public:
+        static constexpr size_t kPageSize = 64 * 1024;
+
+        // payload sizes of the size classes (multiples of 16 for the fast lookup)
+        static constexpr uint32_t kSizeClasses[] = { 16, 32, 48, 64, 80, 96, 128, 160, 192, 256 };
+        static constexpr int kNumSizeClasses = (int) (sizeof(kSizeClasses) / sizeof(kSizeClasses[0]));
+        static constexpr uint32_t kMaxSlabSize = kSizeClasses[kNumSizeClasses - 1];
+
+    private:
+        // prefixed to every block, keeps the 8 bytes alignment required by QuickJS
+        struct Header
+        {
+            uint32_t size_class;    // index of size class, or kLargeClass
+            uint32_t size;          // usable size
+        };
+        static_assert(sizeof(Header) == 8);
+        static constexpr uint32_t kLargeClass = UINT32_MAX;
+
+        struct FreeBlock
+        {
+            FreeBlock* next;
+        };
+
+        struct SizeClass
+        {
+            FreeBlock* free_list = nullptr;
+            uint32_t used = 0;
+            uint32_t capacity = 0;
+        };
+
+        SizeClass classes_[kNumSizeClasses];
+        LocalVector<void*> pages_;
+
+        uint64_t large_count_ = 0;
+        uint64_t large_size_ = 0;
+
+    public:
+        SlabAllocator() = default;
+        ~SlabAllocator() { release(); }
+
+        SlabAllocator(const SlabAllocator&) = delete;
+        SlabAllocator& operator=(const SlabAllocator&) = delete;
+
+        void* alloc(size_t p_size);
+        void free(void* p_ptr);
+        void* realloc(void* p_ptr, size_t p_size);
+
+        static size_t usable_size(const void* p_ptr)
+        {
+            return p_ptr ? ((const Header*) p_ptr - 1)->size : 0;
+        }
+
+        // free all pages at once, all blocks allocated from this allocator become invalid
+        void release();
+
+        void get_statistics(Vector<CustomField>& r_fields) const;
+
+        // total usable size of all blocks currently allocated
+        size_t get_allocated_size() const;
+
+    private:
+        static int get_size_class(size_t p_size);
+
+        // allocate a new page for the size class and put all blocks of it into the free list
+        void refill(int p_class_index);
+    };
+}
+
+#endif
@@ -19,6 +19,12 @@ namespace v8
         return size;
     }
 
+    Maybe<bool> ArrayBuffer::Detach(Local<Value> key)
+    {
+        JS_DetachArrayBuffer(isolate_->ctx(), (JSValue) *this);
+        return Maybe<bool>(true);
+    }
+
     Local<ArrayBuffer> ArrayBuffer::New(Isolate* isolate, size_t length)
     {
         uint8_t* buf = (uint8_t*) memalloc(length);
@@ -30,4 +36,56 @@ namespace v8
         memfree(ptr);
     }
 
+    Local<ArrayBuffer> ArrayBuffer::New(Isolate* isolate, void* data, size_t length, DeleterCallback deleter, void* deleter_data)
+    {
+        ExternalDeleter* external = memnew(ExternalDeleter { deleter, deleter_data, length });
+        return Local<ArrayBuffer>(v8::Data(isolate, isolate->push_steal(JS_NewArrayBuffer(isolate->ctx(), (uint8_t*) data, length, _free_external, external, 0))));
+    }
+
+    void ArrayBuffer::_free_external(JSRuntime* rt, void* opaque, void* ptr)
+    {
+        const ExternalDeleter* external = (ExternalDeleter*) opaque;
+        external->callback(ptr, external->length, external->data);
+        memdelete(external);
+    }
+
+    BackingStore::BackingStore(void* p_data) : data_(p_data)
+    {
+        _sab_dup(nullptr, data_);
+    }
+
+    BackingStore::~BackingStore()
+    {
+        _sab_free(nullptr, data_);
+    }
+
+    size_t BackingStore::ByteLength() const
+    {
+        return _get_header(data_)->size;
+    }
+
+    void* BackingStore::_sab_alloc(void* opaque, size_t size)
+    {
+        uint8_t* block = (uint8_t*) memalloc(kHeaderSize + size);
+        Header* header = memnew_placement(block, Header);
+        header->ref_count.store(1, std::memory_order_relaxed);
+        header->size = size;
+        return block + kHeaderSize;
+    }
+
+    void BackingStore::_sab_free(void* opaque, void* ptr)
+    {
+        Header* header = _get_header(ptr);
+        if (header->ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            header->~Header();
+            memfree(header);
+        }
+    }
+
+    void BackingStore::_sab_dup(void* opaque, void* ptr)
+    {
+        _get_header(ptr)->ref_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
 }
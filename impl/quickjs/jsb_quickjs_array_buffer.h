@@ -19,13 +19,65 @@ namespace v8
             virtual void Free(void* data, size_t length) = 0;
         };
 
+        // same as v8::BackingStore::DeleterCallback
+        typedef void (*DeleterCallback)(void* data, size_t length, void* deleter_data);
+
         void* Data() const;
         size_t ByteLength() const;
 
+        bool IsDetachable() const { return true; }
+        Maybe<bool> Detach(Local<Value> key);
+
         static Local<ArrayBuffer> New(Isolate* isolate, size_t length);
 
+        // create an ArrayBuffer over external data (no copy), `deleter` is called when it's garbage collected
+        static Local<ArrayBuffer> New(Isolate* isolate, void* data, size_t length, DeleterCallback deleter, void* deleter_data);
+
     private:
+        struct ExternalDeleter
+        {
+            DeleterCallback callback;
+            void* data;
+            size_t length;
+        };
+
         static void _free(JSRuntime *rt, void *opaque, void *ptr);
+        static void _free_external(JSRuntime *rt, void *opaque, void *ptr);
+    };
+
+    // A reference to the memory of a SharedArrayBuffer, which is reference-counted across runtimes.
+    // Only used to keep the shared memory alive while a message is passed between isolates (workers).
+    class BackingStore
+    {
+    public:
+        // take a new reference of the shared memory allocated by `_sab_alloc`
+        explicit BackingStore(void* p_data);
+        ~BackingStore();
+
+        BackingStore(const BackingStore&) = delete;
+        BackingStore& operator=(const BackingStore&) = delete;
+
+        void* Data() const { return data_; }
+        size_t ByteLength() const;
+
+        // JSSharedArrayBufferFunctions installed on every runtime
+        static void* _sab_alloc(void* opaque, size_t size);
+        static void _sab_free(void* opaque, void* ptr);
+        static void _sab_dup(void* opaque, void* ptr);
+
+    private:
+        struct Header
+        {
+            std::atomic<uint32_t> ref_count;
+            size_t size;
+        };
+
+        // keep the data aligned for all typed array views (and Atomics)
+        static constexpr size_t kHeaderSize = (sizeof(Header) + 15) & ~(size_t) 15;
+
+        static Header* _get_header(void* ptr) { return (Header*) ((uint8_t*) ptr - kHeaderSize); }
+
+        void* data_;
     };
 }
 #endif
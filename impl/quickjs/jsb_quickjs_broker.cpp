@@ -5,10 +5,10 @@ namespace jsb::impl
 {
     void Broker::SetWeak(v8::Isolate* isolate, JSValue value, void* parameter, void* callback)
     {
-        const jsb::impl::InternalDataID index = (jsb::impl::InternalDataID)(uintptr_t) JS_GetOpaque(value, isolate->get_class_id());
-        const jsb::impl::InternalDataPtr data = isolate->get_internal_data(index);
-        JSB_QUICKJS_LOG(VeryVerbose, "update internal data JSObject:%s id:%s pc:%s,%s (last:%s,%s)",
-            (uintptr_t) JS_VALUE_GET_PTR(value), index,
+        const jsb::impl::InternalDataPtr data = isolate->get_internal_data(value);
+        jsb_check(data);
+        JSB_QUICKJS_LOG(VeryVerbose, "update internal data JSObject:%s data:%s pc:%s,%s (last:%s,%s)",
+            (uintptr_t) JS_VALUE_GET_PTR(value), (uintptr_t) data,
             (uintptr_t) parameter, (uintptr_t) callback,
             (uintptr_t) data->weak.parameter, (uintptr_t) data->weak.callback);
         jsb_checkf(!callback || !data->weak.callback, "overriding an existing value is not allowed");
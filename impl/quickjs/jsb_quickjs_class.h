@@ -69,9 +69,9 @@ namespace jsb::impl
         {
             const JSValue this_val = JS_NewObjectProtoClass(ctx, (JSValue) prototype, isolate->get_class_id());
             jsb_check(JS_IsObject(this_val));
-            const jsb::impl::InternalDataID internal_data_id = isolate->add_internal_data(internal_field_count);
-            JS_SetOpaque(this_val, (void*)(uintptr_t) *internal_data_id);
-            JSB_QUICKJS_LOG(VeryVerbose, "allocating internal data JSObject:%s id:%s", (uintptr_t) JS_VALUE_GET_PTR(this_val), internal_data_id);
+            const jsb::impl::InternalDataPtr internal_data = isolate->add_internal_data(internal_field_count);
+            JS_SetOpaque(this_val, internal_data);
+            JSB_QUICKJS_LOG(VeryVerbose, "allocating internal data JSObject:%s data:%s", (uintptr_t) JS_VALUE_GET_PTR(this_val), (uintptr_t) internal_data);
             return this_val;
         }
 
@@ -49,10 +49,11 @@ namespace jsb::impl
             {
                 jsb_check(!builder_->closed_);
                 v8::HandleScope handle_scope(builder_->isolate_);
-                const v8::Local<v8::Name> key = Helper::new_string(builder_->isolate_, name);
+                const v8::Local<v8::Name> key = builder_->_member_name(name);
                 const v8::Local<v8::Value> value = impl_private::Data<int64_t>::New(builder_->isolate_, data);
 
-                enumeration_->Set(builder_->GetContext(), key, value);
+                JS_DefinePropertyValue(builder_->ctx(), (JSValue) enumeration_, builder_->isolate_->get_member_atom(name),
+                    JS_DupValue(builder_->ctx(), (JSValue) value), JS_PROP_C_W_E);
 
                 // represents the value back to string for convenient uses, such as MyColor[MyColor.White] => 'White'
                 const jsb::impl::QuickJS::Atom value_atom(builder_->ctx(), (JSValue) value);
@@ -75,7 +76,7 @@ namespace jsb::impl
 
             EnumDeclaration Enum(const String& name)
             {
-                return EnumDeclaration(builder_, is_instance_method, Helper::new_string(builder_->isolate_, name));
+                return EnumDeclaration(builder_, is_instance_method, builder_->_member_name(name));
             }
 
             template<size_t N>
@@ -84,11 +85,8 @@ namespace jsb::impl
                 jsb_check(!builder_->closed_);
                 v8::HandleScope handle_scope(builder_->isolate_);
 
-                const v8::Local<v8::Name> key = Helper::new_string(builder_->isolate_, name);
                 const v8::Local<v8::FunctionTemplate> value = JSB_NEW_FUNCTION_TEMPLATE(builder_->isolate_, name, callback, {});
-
-                if (is_instance_method) builder_->prototype_template_->Set(builder_->GetContext(), key, value);
-                else builder_->template_->Set(builder_->GetContext(), key, value);
+                _define_value(name, value);
             }
 
             void Method(const String& name, const v8::FunctionCallback callback)
@@ -96,11 +94,8 @@ namespace jsb::impl
                 jsb_check(!builder_->closed_);
                 v8::HandleScope handle_scope(builder_->isolate_);
 
-                const v8::Local<v8::Name> key = Helper::new_string(builder_->isolate_, name);
                 const v8::Local<v8::FunctionTemplate> value = JSB_NEW_FUNCTION_TEMPLATE(builder_->isolate_, name, callback, {});
-
-                if (is_instance_method) builder_->prototype_template_->Set(builder_->GetContext(), key, value);
-                else builder_->template_->Set(builder_->GetContext(), key, value);
+                _define_value(name, value);
             }
 
             template<typename T>
@@ -109,11 +104,8 @@ namespace jsb::impl
                 jsb_check(!builder_->closed_);
                 v8::HandleScope handle_scope(builder_->isolate_);
 
-                const v8::Local<v8::Name> key = Helper::new_string(builder_->isolate_, name);
                 const v8::Local<v8::FunctionTemplate> value = JSB_NEW_FUNCTION_TEMPLATE(builder_->isolate_, name, callback, impl_private::Data<T>::New(builder_->isolate_, data));
-
-                if (is_instance_method) builder_->prototype_template_->Set(builder_->GetContext(), key, value);
-                else builder_->template_->Set(builder_->GetContext(), key, value);
+                _define_value(name, value);
             }
 
             // getter/setter with common data payload
@@ -123,7 +115,6 @@ namespace jsb::impl
                 jsb_check(!builder_->closed_);
                 v8::HandleScope handle_scope(builder_->isolate_);
 
-                const v8::Local<v8::Name> key = Helper::new_string(builder_->isolate_, name);
                 const v8::Local<v8::Value> payload = impl_private::Data<T>::New(builder_->isolate_, data);
                 const v8::Local<v8::FunctionTemplate> getter = getter_cb \
                     ? JSB_NEW_FUNCTION_TEMPLATE(builder_->isolate_, name, getter_cb, payload)
@@ -132,8 +123,7 @@ namespace jsb::impl
                     ? JSB_NEW_FUNCTION_TEMPLATE(builder_->isolate_, name, setter_cb, payload)
                     : v8::Local<v8::FunctionTemplate>();;
 
-                if (is_instance_method) builder_->prototype_template_->SetAccessorProperty(key, getter, setter);
-                else builder_->template_->SetAccessorProperty(key, getter, setter);
+                _define_accessor(name, getter, setter);
             }
 
             template<typename GetterDataT, typename SetterDataT>
@@ -142,7 +132,6 @@ namespace jsb::impl
                 jsb_check(!builder_->closed_);
                 v8::HandleScope handle_scope(builder_->isolate_);
 
-                const v8::Local<v8::Name> key = Helper::new_string(builder_->isolate_, name);
                 const v8::Local<v8::FunctionTemplate> getter = getter_cb \
                     ? JSB_NEW_FUNCTION_TEMPLATE(builder_->isolate_, name, getter_cb, impl_private::Data<GetterDataT>::New(builder_->isolate_, getter_data))
                     : v8::Local<v8::FunctionTemplate>();
@@ -150,8 +139,7 @@ namespace jsb::impl
                     ? JSB_NEW_FUNCTION_TEMPLATE(builder_->isolate_, name, setter_cb, impl_private::Data<SetterDataT>::New(builder_->isolate_, setter_data))
                     : v8::Local<v8::FunctionTemplate>();
 
-                if (is_instance_method) builder_->prototype_template_->SetAccessorProperty(key, getter, setter);
-                else builder_->template_->SetAccessorProperty(key, getter, setter);
+                _define_accessor(name, getter, setter);
             }
 
             template<typename GetterDataT>
@@ -160,13 +148,11 @@ namespace jsb::impl
                 jsb_check(!builder_->closed_);
                 v8::HandleScope handle_scope(builder_->isolate_);
 
-                const v8::Local<v8::Name> key = Helper::new_string(builder_->isolate_, name);
                 const v8::Local<v8::FunctionTemplate> getter = getter_cb \
                     ? JSB_NEW_FUNCTION_TEMPLATE(builder_->isolate_, name, getter_cb, impl_private::Data<GetterDataT>::New(builder_->isolate_, getter_data))
                     : v8::Local<v8::FunctionTemplate>();
 
-                if (is_instance_method) builder_->prototype_template_->SetAccessorProperty(key, getter);
-                else builder_->template_->SetAccessorProperty(key, getter);
+                _define_accessor(name, getter, {});
             }
 
             void LazyProperty(const String& name, const v8::AccessorNameGetterCallback getter)
@@ -174,12 +160,26 @@ namespace jsb::impl
                 jsb_check(!builder_->closed_);
                 v8::HandleScope handle_scope(builder_->isolate_);
 
-                const v8::Local<v8::Name> key = Helper::new_string(builder_->isolate_, name);
+                const v8::Local<v8::Name> key = builder_->_member_name(name);
 
                 if (is_instance_method) builder_->prototype_template_->SetLazyDataProperty(builder_->GetContext(), key, getter);
                 else builder_->template_->SetLazyDataProperty(builder_->GetContext(), key, getter);
             }
 
+            // the lazy getter receives `data` as `PropertyCallbackInfo::Data()`
+            template<typename T>
+            void LazyProperty(const String& name, const v8::AccessorNameGetterCallback getter, T data)
+            {
+                jsb_check(!builder_->closed_);
+                v8::HandleScope handle_scope(builder_->isolate_);
+
+                const v8::Local<v8::Name> key = builder_->_member_name(name);
+                const v8::Local<v8::Value> value = impl_private::Data<T>::New(builder_->isolate_, data);
+
+                if (is_instance_method) builder_->prototype_template_->SetLazyDataProperty(builder_->GetContext(), key, getter, value);
+                else builder_->template_->SetLazyDataProperty(builder_->GetContext(), key, getter, value);
+            }
+
             template<typename T>
             void Value(const v8::Local<v8::Name> key, T val)
             {
@@ -198,14 +198,35 @@ namespace jsb::impl
                 jsb_check(!builder_->closed_);
                 v8::HandleScope handle_scope(builder_->isolate_);
 
-                const v8::Local<v8::Name> key = Helper::new_string(builder_->isolate_, name);
                 const v8::Local<v8::Value> value = impl_private::Data<T>::New(builder_->isolate_, val);
-
-                if (is_instance_method) builder_->prototype_template_->Set(builder_->GetContext(), key, value);
-                else builder_->template_->Set(builder_->GetContext(), key, value);
+                _define_value(name, value);
             }
 
         private:
+            // define a data property with the cached atom of `name` (no string conversion, no setter lookup as `Set` does)
+            void _define_value(const String& name, const v8::Local<v8::Value> value) const
+            {
+                JSContext* ctx = builder_->ctx();
+                const int res = JS_DefinePropertyValue(ctx, builder_->_holder(is_instance_method), builder_->isolate_->get_member_atom(name),
+                    JS_DupValue(ctx, (JSValue) value), JS_PROP_C_W_E);
+                jsb_check(res >= 0);
+                jsb_unused(res);
+            }
+
+            // same as `Object::SetAccessorProperty` but with the cached atom of `name`
+            void _define_accessor(const String& name, const v8::Local<v8::FunctionTemplate> getter, const v8::Local<v8::FunctionTemplate> setter) const
+            {
+                int flags = JS_PROP_HAS_ENUMERABLE | JS_PROP_HAS_CONFIGURABLE;
+                if (!getter.IsEmpty()) flags |= JS_PROP_HAS_GET;
+                if (!setter.IsEmpty()) flags |= JS_PROP_HAS_SET | JS_PROP_HAS_WRITABLE;
+
+                //NOTE JS_DefineProperty does not consume the references of getter/setter
+                const int res = JS_DefineProperty(builder_->ctx(), builder_->_holder(is_instance_method), builder_->isolate_->get_member_atom(name),
+                    JS_UNDEFINED, (JSValue) getter, (JSValue) setter, flags);
+                jsb_check(res >= 0);
+                jsb_unused(res);
+            }
+
             ClassBuilder* builder_;
             bool is_instance_method;
         };
@@ -268,6 +289,14 @@ namespace jsb::impl
     private:
         JSContext* ctx() const { return isolate_->ctx(); }
 
+        JSValue _holder(bool is_instance_method) const { return is_instance_method ? (JSValue) prototype_template_ : (JSValue) template_; }
+
+        // the string of a cached member atom (no utf8 conversion)
+        v8::Local<v8::Name> _member_name(const String& name) const
+        {
+            return v8::Local<v8::Name>(v8::Data(isolate_, isolate_->push_steal(JS_AtomToString(ctx(), isolate_->get_member_atom(name)))));
+        }
+
         v8::Local<v8::Context> GetContext() const
         {
             return isolate_->GetCurrentContext();
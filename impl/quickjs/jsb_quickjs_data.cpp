@@ -132,6 +132,14 @@ namespace v8
         return JS_IsArrayBuffer(val);
     }
 
+    bool Data::IsProxy() const
+    {
+        const JSValue val = isolate_->stack_val(stack_pos_);
+
+        //NOTE quickjs source modified (quickjs-ng has it as a public API)
+        return JS_IsProxy(val);
+    }
+
     bool Data::strict_eq(const Data& other) const
     {
         const JSValue val1 = isolate_->stack_val(stack_pos_);
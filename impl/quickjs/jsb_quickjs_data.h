@@ -42,6 +42,7 @@ namespace v8
         bool IsBigInt() const;
         bool IsExternal() const;
         bool IsArrayBuffer() const;
+        bool IsProxy() const;
 
     private:
         bool strict_eq(const Data& other) const;
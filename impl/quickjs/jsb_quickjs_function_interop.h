@@ -104,16 +104,23 @@ namespace v8
     class PropertyCallbackInfo
     {
     public:
-        PropertyCallbackInfo(Isolate* isolate, uint16_t stack_pos) : isolate_(isolate), stack_pos_(stack_pos) {}
+        PropertyCallbackInfo(Isolate* isolate, uint16_t stack_pos, uint16_t data_pos = jsb::impl::StackPos::Undefined)
+        : isolate_(isolate), stack_pos_(stack_pos), data_pos_(data_pos) {}
         Isolate* GetIsolate() const { return isolate_; }
         ReturnValue<T> GetReturnValue() const
         {
             return ReturnValue<T>(v8::Data(isolate_, stack_pos_));
         }
 
+        Local<Value> Data() const
+        {
+            return Local<Value>(v8::Data(isolate_, data_pos_));
+        }
+
     private:
         Isolate* isolate_;
         uint16_t stack_pos_;
+        uint16_t data_pos_;
     };
 }
 #endif
@@ -17,7 +17,7 @@ namespace v8
         jsb_check(isolate_->handle_scope_ == this);
         for (uint16_t i = stack_; i < isolate_->stack_pos_; i++)
         {
-            JS_FreeValue(isolate_->ctx_, isolate_->stack_[i]);
+            JS_FreeValue(isolate_->ctx_, isolate_->stack_at(i));
         }
         isolate_->handle_scope_ = last_;
         isolate_->stack_pos_ = stack_;
@@ -20,14 +20,24 @@ namespace jsb::impl
 
         static PackedByteArray to_packed_byte_array(v8::Isolate* isolate, const v8::Local<v8::ArrayBuffer>& array_buffer)
         {
-            const size_t size = array_buffer->ByteLength();
             PackedByteArray packed;
-            const Error err = packed.resize((int) size);
+            const bool succeeded = to_packed_array(isolate, array_buffer, packed);
+            jsb_unused(succeeded);
+            jsb_check(succeeded);
+            return packed;
+        }
+
+        // copy the content of an ArrayBuffer into a packed array (the byte length must be a multiple of the element size)
+        template<typename T>
+        static bool to_packed_array(v8::Isolate* isolate, const v8::Local<v8::ArrayBuffer>& array_buffer, Vector<T>& r_packed)
+        {
+            const size_t size = array_buffer->ByteLength();
+            if (size % sizeof(T) != 0) return false;
+            const Error err = r_packed.resize((int) (size / sizeof(T)));
             jsb_unused(err);
             jsb_check(err == OK);
-            const void* data = array_buffer->Data();
-            memcpy(packed.ptrw(), data, size);
-            return packed;
+            if (size != 0) memcpy(r_packed.ptrw(), array_buffer->Data(), size);
+            return true;
         }
 
         static v8::Local<v8::ArrayBuffer> to_array_buffer(v8::Isolate* isolate, const Vector<uint8_t>& packed)
@@ -38,6 +48,22 @@ namespace jsb::impl
             return buffer;
         }
 
+        // create an ArrayBuffer over the storage of a packed array without copying.
+        // the storage is shared with `packed` (COW), and kept alive until the ArrayBuffer is garbage collected.
+        template<typename T>
+        static v8::Local<v8::ArrayBuffer> to_array_buffer_view(v8::Isolate* isolate, const Vector<T>& packed)
+        {
+            if (packed.is_empty()) return v8::ArrayBuffer::New(isolate, 0);
+            Vector<T>* storage = memnew(Vector<T>(packed));
+            return v8::ArrayBuffer::New(isolate, (void*) storage->ptr(), storage->size() * sizeof(T), &_release_array_buffer_view<T>, storage);
+        }
+
+        template<typename T>
+        static void _release_array_buffer_view(void* data, size_t length, void* deleter_data)
+        {
+            memdelete((Vector<T>*) deleter_data);
+        }
+
         static v8::Local<v8::Function> NewFunction(v8::Local<v8::Context> context, const char* name, v8::FunctionCallback callback, v8::Local<v8::Value> data)
         {
             // const v8::Local<v8::Function> func = v8::Function::New(context, callback, data).ToLocalChecked();
@@ -98,8 +124,17 @@ namespace jsb::impl
             return v8::Local<v8::String>(v8::Data(isolate, stack_pos));
         }
 
-        jsb_force_inline static v8::Local<v8::String> new_string(v8::Isolate* isolate, const String& p_str)
+        static v8::Local<v8::String> new_string(v8::Isolate* isolate, const String& p_str)
         {
+#if !JSB_PREFER_QUICKJS_NG
+            if (const int len = p_str.length(); len <= Latin1::kStackBufferSize && Latin1::is_latin1(p_str.ptr(), len))
+            {
+                uint8_t* chars = jsb_stackalloc(uint8_t, len);
+                Latin1::narrow(p_str.ptr(), len, chars);
+                const uint16_t stack_pos = isolate->push_steal(JS_NewLatin1String(isolate->ctx(), chars, len));
+                return v8::Local<v8::String>(v8::Data(isolate, stack_pos));
+            }
+#endif
             const CharString str8 = p_str.utf8();
             const uint16_t stack_pos = isolate->push_steal(JS_NewStringLen(isolate->ctx(), str8.get_data(), str8.length()));
             return v8::Local<v8::String>(v8::Data(isolate, stack_pos));
@@ -136,6 +171,13 @@ namespace jsb::impl
             if (!p_val.IsEmpty() && !p_val->IsNullOrUndefined())
             {
                 size_t len;
+#if !JSB_PREFER_QUICKJS_NG
+                // 8 bit strings are widened directly without the utf8 round trip
+                if (const uint8_t* chars = JS_GetLatin1String((JSValue) p_val, &len))
+                {
+                    return Latin1::to_string(chars, (int) len);
+                }
+#endif
                 if (const char* str = JS_ToCStringLen(isolate->ctx(), &len, (JSValue) p_val))
                 {
                     const String ret = String::utf8(str, (int) len);
@@ -168,6 +210,15 @@ namespace jsb::impl
             isolate->throw_error(message);
         }
 
+        // the size of the memory used by the JS heap (in bytes, 0 if not available)
+        jsb_force_inline static size_t get_used_heap_size(v8::Isolate* isolate)
+        {
+            if (const size_t malloc_size = get_malloc_size(isolate)) return malloc_size;
+            JSMemoryUsage usage;
+            JS_ComputeMemoryUsage(isolate->rt(), &usage);
+            return (size_t) usage.malloc_size;
+        }
+
         jsb_force_inline static void get_statistics(v8::Isolate* isolate, Vector<CustomField>& p_fields)
         {
             JSMemoryUsage usage;
@@ -195,11 +246,60 @@ namespace jsb::impl
             p_fields.append(CustomField::value_i64(jsb_nameof(JSMemoryUsage, js_func_size), usage.js_func_size, CustomField::HINT_SIZE));
             p_fields.append(CustomField::value_i64(jsb_nameof(JSMemoryUsage, js_func_code_size), usage.js_func_code_size, CustomField::HINT_SIZE));
             p_fields.append(CustomField::value_i64(jsb_nameof(JSMemoryUsage, c_func_count), usage.c_func_count));
+#if JSB_QUICKJS_SLAB_ALLOCATOR
+            isolate->get_allocator().get_statistics(p_fields);
+#endif
+        }
+
+        // quickjs doesn't track the allocation per class, the heap is broken down by the kind of memory (JS_ComputeMemoryUsage)
+        static void get_heap_summary(v8::Isolate* isolate, Vector<HeapSummaryEntry>& r_entries)
+        {
+            JSMemoryUsage usage;
+            JS_ComputeMemoryUsage(isolate->rt(), &usage);
+
+            r_entries.append({ "(object)", usage.obj_count, usage.obj_size });
+            r_entries.append({ "(property)", usage.prop_count, usage.prop_size });
+            r_entries.append({ "(shape)", usage.shape_count, usage.shape_size });
+            r_entries.append({ "(string)", usage.str_count, usage.str_size });
+            r_entries.append({ "(atom)", usage.atom_count, usage.atom_size });
+            r_entries.append({ "(function)", usage.js_func_count, usage.js_func_size + usage.js_func_code_size });
+            r_entries.append({ "(array)", usage.array_count, usage.fast_array_elements * (int64_t) sizeof(JSValue) });
+            r_entries.append({ "(binary)", usage.binary_object_count, usage.binary_object_size });
+            r_entries.append({ "(malloc)", usage.malloc_count, usage.malloc_size });
+        }
+
+        // the size of memory allocated by the runtime (0 if not tracked)
+        jsb_force_inline static size_t get_malloc_size(v8::Isolate* isolate)
+        {
+#if JSB_QUICKJS_SLAB_ALLOCATOR
+            return isolate->get_allocator().get_allocated_size();
+#else
+            return 0;
+#endif
+        }
+
+        // the automatic cycle collection is triggered by the runtime if the allocated size exceeds the threshold
+        jsb_force_inline static void set_gc_threshold(v8::Isolate* isolate, size_t p_threshold)
+        {
+            JS_SetGCThreshold(isolate->rt(), p_threshold);
+        }
+
+        // allocations beyond the limit fail with out of memory errors (0 for unlimited)
+        jsb_force_inline static void set_memory_limit(v8::Isolate* isolate, size_t p_limit)
+        {
+            JS_SetMemoryLimit(isolate->rt(), p_limit);
+        }
+
+        // run a full cycle collection (QuickJS has no incremental gc)
+        jsb_force_inline static void run_gc(v8::Isolate* isolate)
+        {
+            JS_RunGC(isolate->rt());
         }
 
         jsb_force_inline static bool to_int64(const v8::Local<v8::Value> p_val, int64_t& r_val)
         {
-            if (p_val->IsInt32()) { r_val = p_val.As<v8::Int32>()->Value(); return true; }
+            // read the small integers from the tag directly (without JS_ToInt32)
+            if (const JSValue val = (JSValue) p_val; JS_VALUE_GET_TAG(val) == JS_TAG_INT) { r_val = JS_VALUE_GET_INT(val); return true; }
             if (p_val->IsNumber()) { r_val = (int64_t) p_val.As<v8::Number>()->Value(); return true; }
 #if JSB_WITH_BIGINT
             if (p_val->IsBigInt()) { r_val = p_val.As<v8::BigInt>()->Int64Value(); return true; }
@@ -210,7 +310,7 @@ namespace jsb::impl
         jsb_force_inline static v8::Local<v8::Value> new_integer(v8::Isolate* isolate, const int64_t p_val)
         {
             if (const int32_t downscale = (int32_t) p_val;
-                (int64_t) downscale == p_val)
+                jsb_likely((int64_t) downscale == p_val))
             {
                 return v8::Int32::New(isolate, downscale);
             }
@@ -240,6 +340,70 @@ namespace jsb::impl
             return v8::MaybeLocal<v8::Value>(v8::Data(isolate, isolate->push_steal(rval)));
         }
 
+#if JSB_WITH_CODE_CACHE
+        // the bytecode format is only guaranteed to be compatible with the exact same build of quickjs
+        static uint32_t get_code_cache_version_tag()
+        {
+            return (uint32_t) hash_murmur3_one_32(sizeof(void*), hash_murmur3_one_32(JSB_BUNDLE_VERSION));
+        }
+
+        /**
+         * \brief same as `compile_function` but consume/produce the bytecode (JS_ReadObject/JS_WriteObject).
+         * \param p_cached_data the bytecode produced previously (can be empty)
+         * \param r_cached_data (optional) filled with the bytecode if `p_cached_data` is empty or unreadable
+         * \param p_static_one_byte unused, the source is always parsed in place
+         */
+        static v8::MaybeLocal<v8::Value> compile_function(const v8::Local<v8::Context>& context, const char* p_source, int p_source_len, const String& p_filename,
+            const Vector<uint8_t>& p_cached_data, Vector<uint8_t>* r_cached_data, bool p_static_one_byte = false)
+        {
+            jsb_unused(p_static_one_byte);
+            jsb_checkf(p_source[p_source_len] == '\0', "JS_Eval needs a zero-terminated string as input to evaluate");
+            v8::Isolate* isolate = context->GetIsolate();
+            JSContext* ctx = isolate->ctx();
+            JSValue func = JS_UNDEFINED;
+            if (!p_cached_data.is_empty())
+            {
+                func = JS_ReadObject(ctx, p_cached_data.ptr(), p_cached_data.size(), JS_READ_OBJ_BYTECODE);
+                if (JS_IsException(func))
+                {
+                    // discard the exception, and fallback to compile from source
+                    JS_FreeValue(ctx, JS_GetException(ctx));
+                    func = JS_UNDEFINED;
+                    JSB_QUICKJS_LOG(Verbose, "bad bytecode cache %s", p_filename);
+                }
+            }
+            if (JS_IsUndefined(func))
+            {
+                const CharString filename = p_filename.utf8();
+                constexpr int flags = JS_EVAL_TYPE_GLOBAL | JS_EVAL_FLAG_STRICT | JS_EVAL_FLAG_COMPILE_ONLY;
+                func = JS_Eval(ctx, p_source, p_source_len, filename.get_data(), flags);
+                if (JS_IsException(func))
+                {
+                    // intentionally keep the exception
+                    return v8::MaybeLocal<v8::Value>();
+                }
+                if (r_cached_data)
+                {
+                    size_t size = 0;
+                    if (uint8_t* bytecode = JS_WriteObject(ctx, &size, func, JS_WRITE_OBJ_BYTECODE))
+                    {
+                        r_cached_data->resize((int) size);
+                        memcpy(r_cached_data->ptrw(), bytecode, size);
+                        js_free(ctx, bytecode);
+                    }
+                }
+            }
+
+            // JS_EvalFunction takes the ownership of `func`
+            const JSValue rval = JS_EvalFunction(ctx, func);
+            if (JS_IsException(rval))
+            {
+                return v8::MaybeLocal<v8::Value>();
+            }
+            return v8::MaybeLocal<v8::Value>(v8::Data(isolate, isolate->push_steal(rval)));
+        }
+#endif
+
         static v8::MaybeLocal<v8::Value> eval(const v8::Local<v8::Context>& context, const char* p_source, int p_source_len, const String& p_filename)
         {
             return compile_function(context, p_source, p_source_len, p_filename);
@@ -21,7 +21,64 @@ namespace v8
             return val;
         }
 
+#if JSB_QUICKJS_SLAB_ALLOCATOR
 #if JSB_PREFER_QUICKJS_NG
+        static void* js_calloc(void* opaque, size_t count, size_t size)
+        {
+            void* ptr = ((Isolate*) opaque)->allocator_.alloc(count * size);
+            if (ptr) memset(ptr, 0, count * size);
+            return ptr;
+        }
+
+        static void* js_malloc(void* opaque, size_t size)
+        {
+            return ((Isolate*) opaque)->allocator_.alloc(size);
+        }
+
+        static void js_free(void* opaque, void* ptr)
+        {
+            if (ptr)
+            {
+                ((Isolate*) opaque)->allocator_.free(ptr);
+                ((Isolate*) opaque)->_invalidate_phantom(ptr);
+            }
+        }
+
+        static void* js_realloc(void* opaque, void* ptr, size_t size)
+        {
+            return ((Isolate*) opaque)->allocator_.realloc(ptr, size);
+        }
+
+        static size_t js_malloc_usable_size(const void* ptr)
+        {
+            return jsb::impl::SlabAllocator::usable_size(ptr);
+        }
+#else
+        static void* js_malloc(JSMallocState* s, size_t size)
+        {
+            return ((Isolate*) s->opaque)->allocator_.alloc(size);
+        }
+
+        static void js_free(JSMallocState* s, void* ptr)
+        {
+            if (ptr)
+            {
+                ((Isolate*) s->opaque)->allocator_.free(ptr);
+                ((Isolate*) s->opaque)->_invalidate_phantom(ptr);
+            }
+        }
+
+        static void* js_realloc(JSMallocState* s, void* ptr, size_t size)
+        {
+            return ((Isolate*) s->opaque)->allocator_.realloc(ptr, size);
+        }
+
+        static size_t js_malloc_usable_size(const void* ptr)
+        {
+            return jsb::impl::SlabAllocator::usable_size(ptr);
+        }
+#endif
+#elif JSB_PREFER_QUICKJS_NG
         static void* js_calloc(void* opaque, size_t count, size_t size)
         {
             return ::calloc(count, size);
@@ -97,13 +154,15 @@ namespace v8
     {
 #if JSB_PREFER_QUICKJS_NG
         const JSMallocFunctions mf = { details::js_calloc, details::js_malloc, details::js_free, details::js_realloc, details::js_malloc_usable_size };
+#elif JSB_QUICKJS_SLAB_ALLOCATOR
+        const JSMallocFunctions mf = { details::js_malloc, details::js_free, details::js_realloc, details::js_malloc_usable_size };
 #else
         const JSMallocFunctions mf = { details::js_malloc, details::js_free, details::js_realloc, nullptr };
 #endif
         rt_ = JS_NewRuntime2(&mf, this);
         ctx_ = JS_NewContext(rt_);
         class_id_.init(rt_);
-        static_assert(sizeof(stack_) == sizeof(JSValue) * jsb::impl::kMaxStackSize);
+        static_assert(sizeof(stack_) == sizeof(JSValue) * jsb::impl::kStackSegmentSize);
 
         // should be fine to leave it uninitialized
         // memset(stack_, 0, sizeof(stack_));
@@ -114,6 +173,10 @@ namespace v8
         JS_SetContextOpaque(ctx_, this);
         JS_SetHostPromiseRejectionTracker(rt_, _promise_rejection_tracker, this);
 
+        // SharedArrayBuffer memory is reference-counted to share it with other runtimes (workers)
+        const JSSharedArrayBufferFunctions sab_funcs = { &BackingStore::_sab_alloc, &BackingStore::_sab_free, &BackingStore::_sab_dup, nullptr };
+        JS_SetSharedArrayBufferFunctions(rt_, &sab_funcs);
+
         //TODO dead loop checker
         // JS_SetInterruptHandler
 
@@ -158,6 +221,16 @@ namespace v8
         {
             JS_FreeValue(ctx_, stack_[i]);
         }
+        for (JSValue* segment : stack_segments_)
+        {
+            memdelete_arr(segment);
+        }
+        stack_segments_.clear();
+        for (const KeyValue<::String, JSAtom>& it : member_atoms_)
+        {
+            JS_FreeAtom(ctx_, it.value);
+        }
+        member_atoms_.clear();
 
         swap_free_queue();
         swap_free_queue();
@@ -166,7 +239,7 @@ namespace v8
 
 #if !JSB_STRICT_DISPOSE
         // make it behave like v8, not to trigger gc callback after the isolate disposed
-        internal_data_.clear();
+        internal_data_released_ = true;
 #endif
 
         // dispose the runtime
@@ -176,12 +249,23 @@ namespace v8
         rt_ = nullptr;
 
 #if JSB_STRICT_DISPOSE
-        jsb_check(internal_data_.is_empty());
+        jsb_check(internal_data_.size() == 0);
 #endif
 
         memdelete(this);
     }
 
+    void Isolate::grow_stack_()
+    {
+        CRASH_COND_MSG(stack_pos_ >= jsb::impl::kMaxStackSize, "quickjs handle stack overflow, consider increasing JSB_QUICKJS_MAX_STACK_SIZE");
+        const uint32_t segment_index = stack_pos_ / jsb::impl::kStackSegmentSize - 1;
+        if (segment_index == stack_segments_.size())
+        {
+            JSB_QUICKJS_LOG(Verbose, "grow stack to %d", (segment_index + 2) * jsb::impl::kStackSegmentSize);
+            stack_segments_.push_back(memnew_arr(JSValue, jsb::impl::kStackSegmentSize));
+        }
+    }
+
     void Isolate::Dispose()
     {
         jsb_check(!disposed_);
@@ -212,24 +296,31 @@ namespace v8
     void Isolate::_finalizer(JSRuntime* rt, JSValue val)
     {
         Isolate* isolate = (Isolate*) JS_GetRuntimeOpaque(rt);
-        const jsb::impl::InternalDataID index = (jsb::impl::InternalDataID)(uintptr_t) JS_GetOpaque(val, isolate->get_class_id());
+        if (const jsb::impl::InternalDataPtr data = isolate->get_internal_data(val))
         {
-            jsb::impl::InternalData* data;
-            if (isolate->internal_data_.try_get_value_pointer(index, data))
+            if (const WeakCallbackInfo<void>::Callback callback = (WeakCallbackInfo<void>::Callback) data->weak.callback;
+                callback && !isolate->internal_data_released_)
             {
-                if (const WeakCallbackInfo<void>::Callback callback = (WeakCallbackInfo<void>::Callback) data->weak.callback)
-                {
-                    const WeakCallbackInfo<void> info(isolate, data->weak.parameter, data->internal_fields);
-                    callback(info);
-                }
-                JSB_QUICKJS_LOG(VeryVerbose, "remove internal data JSObject:%s id:%s", (uintptr_t) JS_VALUE_GET_PTR(val), index);
-                isolate->internal_data_.remove_at(index);
+                const WeakCallbackInfo<void> info(isolate, data->weak.parameter, data->internal_fields);
+                callback(info);
             }
+            JSB_QUICKJS_LOG(VeryVerbose, "remove internal data JSObject:%s data:%s", (uintptr_t) JS_VALUE_GET_PTR(val), (uintptr_t) data);
+            isolate->internal_data_.free(data);
         }
     }
 
     void Isolate::PerformMicrotaskCheckpoint()
     {
+        // fast path for most frames, only the postponed JS_FreeValue ops (if any) need to be flushed
+        if (!JS_IsJobPending(rt_))
+        {
+            if (!handle_scope_)
+            {
+                swap_free_queue();
+            }
+            return;
+        }
+
         JSContext* ctx;
         HandleScope handle_scope(this);
 
@@ -6,6 +6,7 @@
 #include "jsb_quickjs_handle_scope.h"
 #include "jsb_quickjs_array_buffer.h"
 #include "jsb_quickjs_promise_reject.h"
+#include "jsb_quickjs_allocator.h"
 
 namespace jsb::impl
 {
@@ -26,16 +27,62 @@ namespace jsb::impl
         void* internal_fields[2] = { nullptr, nullptr };
     };
 
-#if INTPTR_MAX >= INT64_MAX
-    typedef internal::Index64 InternalDataID;
-#elif INTPTR_MAX >= INT32_MAX
-    typedef internal::Index32 InternalDataID;
-#else
-    #error "quickjs.impl does not support on the current arch"
-#endif
+    // the opaque of a bridged JSObject is the address of its InternalData directly (no index lookup on access)
+    typedef InternalData* InternalDataPtr;
+    typedef const InternalData* InternalDataConstPtr;
+
+    // InternalData allocated in fixed-size blocks, the addresses are stable until the pool destructed
+    class InternalDataPool
+    {
+        enum { kBlockSize = 256 };
+
+        // the free entries are linked through `weak.parameter`
+        InternalData* free_list_ = nullptr;
+        LocalVector<InternalData*> blocks_;
+        uint32_t size_ = 0;
+
+    public:
+        ~InternalDataPool()
+        {
+            for (InternalData* block : blocks_)
+            {
+                memdelete_arr(block);
+            }
+        }
+
+        // number of allocated (not freed) entries
+        jsb_force_inline uint32_t size() const { return size_; }
 
-    typedef internal::SArray<InternalData, InternalDataID>::Pointer InternalDataPtr;
-    typedef internal::SArray<InternalData, InternalDataID>::ConstPointer InternalDataConstPtr;
+        jsb_force_inline InternalData* alloc(uint8_t p_internal_field_count)
+        {
+            if (jsb_unlikely(!free_list_)) grow();
+            InternalData* data = free_list_;
+            free_list_ = (InternalData*) data->weak.parameter;
+            *data = InternalData { { nullptr, nullptr }, p_internal_field_count, { nullptr, nullptr } };
+            ++size_;
+            return data;
+        }
+
+        jsb_force_inline void free(InternalData* p_data)
+        {
+            jsb_check(size_ != 0);
+            *p_data = InternalData { { free_list_, nullptr }, 0, { nullptr, nullptr } };
+            free_list_ = p_data;
+            --size_;
+        }
+
+    private:
+        void grow()
+        {
+            InternalData* block = memnew_arr(InternalData, kBlockSize);
+            blocks_.push_back(block);
+            for (int index = kBlockSize - 1; index >= 0; --index)
+            {
+                block[index].weak.parameter = free_list_;
+                free_list_ = &block[index];
+            }
+        }
+    };
 
     struct ConstructorData
     {
@@ -43,7 +90,13 @@ namespace jsb::impl
         uint32_t data = 0;
     };
 
-    enum { kMaxStackSize = 512 };
+    enum
+    {
+        // number of values in a segment of the handle stack
+        kStackSegmentSize = 512,
+        kMaxStackSize = JSB_QUICKJS_MAX_STACK_SIZE,
+    };
+    static_assert(kMaxStackSize % kStackSegmentSize == 0 && kMaxStackSize < UINT16_MAX, "invalid JSB_QUICKJS_MAX_STACK_SIZE");
 
     namespace StackPos
     {
@@ -139,6 +192,7 @@ namespace v8
         void PerformMicrotaskCheckpoint();
         void LowMemoryNotification();
         void SetBatterySaverMode(bool) {}
+        void SetAllowAtomicsWait(bool allow) { JS_SetCanBlock(rt_, allow); }
         void RequestGarbageCollectionForTesting(GarbageCollectionType type);
         Local<Context> GetCurrentContext();
 
@@ -149,33 +203,34 @@ namespace v8
         void set_as_interruptible() { JS_SetInterruptHandler(rt_, _interrupt_callback, this); }
         bool IsExecutionTerminating() const { return interrupted_.is_set(); }
         void TerminateExecution() { interrupted_.set(); }
+        void CancelTerminateExecution() { interrupted_.clear(); }
 
         jsb_force_inline JSRuntime* rt() const { return rt_; }
         jsb_force_inline JSContext* ctx() const { return ctx_; }
 
-        jsb::impl::InternalDataConstPtr get_internal_data(const jsb::impl::InternalDataID index) const
-        {
-            return internal_data_.get_value_scoped(index);
-        }
-
-        jsb::impl::InternalDataPtr get_internal_data(const jsb::impl::InternalDataID index)
+        // nullptr if `val` is not an object of the bridged class (or not allocated with internal data)
+        jsb_force_inline jsb::impl::InternalDataPtr get_internal_data(JSValueConst val) const
         {
-            return internal_data_.get_value_scoped(index);
+            return (jsb::impl::InternalDataPtr) JS_GetOpaque(val, get_class_id());
         }
 
-        jsb::impl::InternalDataID add_internal_data(const uint8_t internal_field_count)
+        jsb_force_inline jsb::impl::InternalDataPtr add_internal_data(const uint8_t internal_field_count)
         {
-            return internal_data_.add(jsb::impl::InternalData {  { nullptr, nullptr }, internal_field_count, { nullptr, nullptr }});
+            return internal_data_.alloc(internal_field_count);
         }
 
         jsb_force_inline JSClassID get_class_id() const { return (JSClassID) class_id_; }
 
+#if JSB_QUICKJS_SLAB_ALLOCATOR
+        jsb_force_inline const jsb::impl::SlabAllocator& get_allocator() const { return allocator_; }
+#endif
+
         // get stack value
         [[nodiscard]] const JSValue& stack_val(const uint16_t index) const
         {
             jsb_check(index < stack_pos_);
             jsb_check(index < jsb::impl::StackPos::Num || handle_scope_);
-            return stack_[index];
+            return stack_at(index);
         }
 
         // get stack value (duplicated)
@@ -189,8 +244,9 @@ namespace v8
         {
             jsb_check(to < stack_pos_);
             jsb_check(to < jsb::impl::StackPos::Num || handle_scope_);
-            JS_FreeValue(ctx_, stack_[to]);
-            stack_[to] = value;
+            JSValue& slot = stack_at(to);
+            JS_FreeValue(ctx_, slot);
+            slot = value;
         }
 
         // duplicate a value 'from' to the stack pos 'to'
@@ -198,9 +254,11 @@ namespace v8
         {
             jsb_check(to != from && to < stack_pos_ && from < stack_pos_);
             jsb_check(handle_scope_ || (to < jsb::impl::StackPos::Num && from < jsb::impl::StackPos::Num));
-            JS_DupValue(ctx_, stack_[from]);
-            JS_FreeValue(ctx_, stack_[to]);
-            stack_[to] = stack_[from];
+            const JSValue& value = stack_at(from);
+            JSValue& slot = stack_at(to);
+            JS_DupValue(ctx_, value);
+            JS_FreeValue(ctx_, slot);
+            slot = value;
         }
 
         // due to the missing QuickJS API for NewSymbol/NewMap
@@ -250,6 +308,17 @@ namespace v8
             // return constructor_data_.get_value((jsb::internal::Index32)(uint32_t) index);
         }
 
+        // the atom of a class member name, created on the first request and kept until the isolate disposed (not duplicated for the caller).
+        // the same names are defined repeatedly while exposing classes (methods and properties sharing getter names, enums, etc.)
+        JSAtom get_member_atom(const ::String& p_name)
+        {
+            if (const JSAtom* it = member_atoms_.getptr(p_name)) return *it;
+            const CharString str8 = p_name.utf8();
+            const JSAtom atom = JS_NewAtomLen(ctx_, str8.get_data(), str8.length());
+            member_atoms_.insert(p_name, atom);
+            return atom;
+        }
+
         ~Isolate();
 
         // phantom is a pointer to JSObject (internal type of quickjs).
@@ -349,14 +418,33 @@ namespace v8
         // push value to the top of stack (without ref-counting)
         uint16_t emplace_(JSValue value)
         {
-            jsb_check(stack_pos_ < jsb::impl::kMaxStackSize);
             jsb_check(!JS_IsException(value));
+            if (unlikely(stack_pos_ >= jsb::impl::kStackSegmentSize && stack_pos_ % jsb::impl::kStackSegmentSize == 0))
+            {
+                grow_stack_();
+            }
 
             const uint16_t pos = stack_pos_++;
-            stack_[pos] = value;
+            stack_at(pos) = value;
             return pos;
         }
 
+        // the values in the first segment are accessed directly
+        jsb_force_inline JSValue& stack_at(const uint16_t index)
+        {
+            if (likely(index < jsb::impl::kStackSegmentSize)) return stack_[index];
+            return stack_segments_[index / jsb::impl::kStackSegmentSize - 1][index % jsb::impl::kStackSegmentSize];
+        }
+
+        jsb_force_inline const JSValue& stack_at(const uint16_t index) const
+        {
+            if (likely(index < jsb::impl::kStackSegmentSize)) return stack_[index];
+            return stack_segments_[index / jsb::impl::kStackSegmentSize - 1][index % jsb::impl::kStackSegmentSize];
+        }
+
+        // ensure the segment for the value at stack_pos_ allocated (crash if exceeding kMaxStackSize)
+        void grow_stack_();
+
         void swap_free_queue()
         {
             jsb_check(!swapping_free_queue_);
@@ -385,6 +473,11 @@ namespace v8
         static void _promise_rejection_tracker(JSContext* ctx, JSValueConst promise, JSValueConst reason, JS_BOOL is_handled, void* user_data);
         static int _interrupt_callback(JSRuntime* rt, void* data) { return ((Isolate*) data)->interrupted_.is_set(); }
 
+#if JSB_QUICKJS_SLAB_ALLOCATOR
+        // must be destructed after the runtime freed
+        jsb::impl::SlabAllocator allocator_;
+#endif
+
         jsb::impl::ClassID class_id_;
         uint32_t ref_count_;
         bool disposed_;
@@ -394,9 +487,13 @@ namespace v8
 
         PromiseRejectCallback promise_reject_;
 
-        jsb::internal::SArray<jsb::impl::InternalData, jsb::impl::InternalDataID> internal_data_;
+        // must be destructed after the runtime freed (the finalizers release the internal data)
+        jsb::impl::InternalDataPool internal_data_;
+        // the weak callbacks are not triggered by the finalizers since the isolate disposed
+        bool internal_data_released_ = false;
         Vector<jsb::impl::ConstructorData> constructor_data_;
         HashMap<void*, jsb::impl::Phantom> phantom_;
+        HashMap<::String, JSAtom> member_atoms_;
 
         // a queue for postponing the JS_FreeValue
         Vector<JSValue> front_free_queue_;
@@ -405,7 +502,11 @@ namespace v8
         bool swapping_free_queue_ = false;
 
         uint16_t stack_pos_;
-        JSValue stack_[jsb::impl::kMaxStackSize];
+        JSValue stack_[jsb::impl::kStackSegmentSize];
+
+        // the following segments of the stack, allocated on demand and kept until the isolate disposed.
+        // segments are never moved, so the references to stack values are stable even if the stack grows.
+        LocalVector<JSValue*> stack_segments_;
 
         void* embedder_data_ = nullptr;
         void* context_embedder_data_ = nullptr;
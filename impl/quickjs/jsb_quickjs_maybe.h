@@ -38,5 +38,11 @@ namespace v8
         bool has_value_ = false;
         T value_;
     };
+
+    template<typename T>
+    Maybe<T> Just(const T& value) { return Maybe<T>(value); }
+
+    template<typename T>
+    Maybe<T> Nothing() { return Maybe<T>(); }
 }
 #endif
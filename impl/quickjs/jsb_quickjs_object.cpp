@@ -8,19 +8,17 @@ namespace v8
     int Object::InternalFieldCount() const
     {
         const JSValue val = isolate_->stack_val(stack_pos_);
-        const jsb::impl::InternalDataID index = (jsb::impl::InternalDataID)(uintptr_t) JS_GetOpaque(val, isolate_->get_class_id());
-        if (!index) return 0;
-        const jsb::impl::InternalDataPtr data = isolate_->get_internal_data(index);
-        return data->internal_field_count;
+        const jsb::impl::InternalDataPtr data = isolate_->get_internal_data(val);
+        return data ? data->internal_field_count : 0;
     }
 
     void Object::SetAlignedPointerInInternalField(int slot, void* data)
     {
         jsb_check((uintptr_t) data % 2 == 0);
         const JSValue val = isolate_->stack_val(stack_pos_);
-        const jsb::impl::InternalDataID internal_data_id = (jsb::impl::InternalDataID)(uintptr_t) JS_GetOpaque(val, isolate_->get_class_id());
-        const jsb::impl::InternalDataPtr internal_data = isolate_->get_internal_data(internal_data_id);
-        JSB_QUICKJS_LOG(VeryVerbose, "set internal data JSObject:%s id:%s data:%s (last:%s)", (uintptr_t) JS_VALUE_GET_PTR(val), internal_data_id, (uintptr_t) data, (uintptr_t) internal_data->internal_fields[slot]);
+        const jsb::impl::InternalDataPtr internal_data = isolate_->get_internal_data(val);
+        jsb_check(internal_data);
+        JSB_QUICKJS_LOG(VeryVerbose, "set internal data JSObject:%s data:%s (last:%s)", (uintptr_t) JS_VALUE_GET_PTR(val), (uintptr_t) data, (uintptr_t) internal_data->internal_fields[slot]);
         jsb_checkf(!data || !internal_data->internal_fields[slot], "overwriting the internal field is not allowed");
         internal_data->internal_fields[slot] = data;
     }
@@ -28,8 +26,8 @@ namespace v8
     void Object::SetAlignedPointerInInternalFields(int argc, int indices[], void* values[])
     {
         const JSValue val = isolate_->stack_val(stack_pos_);
-        const jsb::impl::InternalDataID internal_data_id = (jsb::impl::InternalDataID)(uintptr_t) JS_GetOpaque(val, isolate_->get_class_id());
-        const jsb::impl::InternalDataPtr internal_data = isolate_->get_internal_data(internal_data_id);
+        const jsb::impl::InternalDataPtr internal_data = isolate_->get_internal_data(val);
+        jsb_check(internal_data);
         for (int i = 0; i < argc; i++)
         {
             jsb_check((uintptr_t) values[i] % 2 == 0);
@@ -41,8 +39,8 @@ namespace v8
     void* Object::GetAlignedPointerFromInternalField(int slot) const
     {
         const JSValue val = isolate_->stack_val(stack_pos_);
-        const jsb::impl::InternalDataID index = (jsb::impl::InternalDataID)(uintptr_t) JS_GetOpaque(val, isolate_->get_class_id());
-        const jsb::impl::InternalDataPtr data = isolate_->get_internal_data(index);
+        const jsb::impl::InternalDataConstPtr data = isolate_->get_internal_data(val);
+        jsb_check(data);
         return data->internal_fields[slot];
     }
 
@@ -228,7 +226,7 @@ namespace v8
             HandleScope handle_scope(isolate);
 
             const uint16_t rvo_pos = isolate->push_copy(JS_UNDEFINED); // return value
-            const PropertyCallbackInfo<Value> info(isolate, rvo_pos);
+            const PropertyCallbackInfo<Value> info(isolate, rvo_pos, isolate->push_copy(func_data[2]));
             const Local<Name> prop_v(Data(isolate, isolate->push_copy(func_data[0])));
 
             getter(prop_v, info);
@@ -245,13 +243,13 @@ namespace v8
             jsb_check(!JS_IsException(rvo));
         }
 
-        // overwrite the current lazy getter with rvo
+        // overwrite the current lazy getter with rvo (on the object which holds it, instead of the receiver which may inherit it, e.g. instances of a class)
         {
             const jsb::impl::QuickJS::Atom prop(ctx, func_data[0]);
             constexpr int flags = JS_PROP_HAS_CONFIGURABLE | JS_PROP_HAS_ENUMERABLE | JS_PROP_HAS_VALUE;
 
             //NOTE !!! JS_DefineProperty DOES NOT CONSUME THE REFERENCE !!!
-            const int res = JS_DefineProperty(ctx, this_val, prop, rvo, JS_UNDEFINED, JS_UNDEFINED, flags);
+            const int res = JS_DefineProperty(ctx, func_data[3], prop, rvo, JS_UNDEFINED, JS_UNDEFINED, flags);
             jsb_check(res >= 0);
             jsb_unused(res);
         }
@@ -259,12 +257,20 @@ namespace v8
         return rvo;
     }
 
-    Maybe<bool> Object::SetLazyDataProperty(Local<Context> context, Local<Name> name, AccessorNameGetterCallback getter)
+    Maybe<bool> Object::SetLazyDataProperty(Local<Context> context, Local<Name> name, AccessorNameGetterCallback getter, Local<Value> data)
     {
         JSContext* ctx = isolate_->ctx();
         const JSValue this_obj = (JSValue) *this;
         constexpr int flags = JS_PROP_HAS_CONFIGURABLE | JS_PROP_HAS_ENUMERABLE | JS_PROP_HAS_GET;
-        JSValue lazy_data[] = { JS_DupValue(ctx, (JSValue) name), JS_MKPTR(jsb::impl::JS_TAG_EXTERNAL, (void *) getter) };
+
+        // the holder is referenced until the getter is replaced (a cycle collected by the gc if never accessed),
+        // it's not duplicated here since JS_NewCFunctionData duplicates the values by itself
+        JSValue lazy_data[] = {
+            JS_DupValue(ctx, (JSValue) name),
+            JS_MKPTR(jsb::impl::JS_TAG_EXTERNAL, (void *) getter),
+            data.IsEmpty() ? JS_UNDEFINED : (JSValue) data,
+            this_obj,
+        };
         const JSValue lazy = JS_NewCFunctionData(ctx, _lazy, /* length */ 0, /* magic */ 0, ::std::size(lazy_data), lazy_data);
 
         const jsb::impl::QuickJS::Atom prop(ctx, (JSValue) name);
@@ -330,6 +336,7 @@ namespace v8
         int flags = 0;
         if ((filter & SKIP_STRINGS) == 0) flags |= JS_GPN_STRING_MASK;
         if ((filter & SKIP_SYMBOLS) == 0) flags |= JS_GPN_SYMBOL_MASK;
+        if (filter & ONLY_ENUMERABLE) flags |= JS_GPN_ENUM_ONLY;
 
         // key_conversion is not available in quickjs.impl
         jsb_check(key_conversion == v8::KeyConversionMode::kNoNumbers);
@@ -399,6 +406,21 @@ namespace v8
         }
     }
 
+    Promise::PromiseState Promise::State()
+    {
+        switch (JS_PromiseState(isolate_->ctx(), (JSValue) *this))
+        {
+        case JS_PROMISE_FULFILLED: return kFulfilled;
+        case JS_PROMISE_REJECTED: return kRejected;
+        default: return kPending;
+        }
+    }
+
+    Local<Value> Promise::Result()
+    {
+        return Local<Value>(Data(isolate_, isolate_->push_steal(JS_PromiseResult(isolate_->ctx(), (JSValue) *this))));
+    }
+
     Local<Promise> Promise::Resolver::GetPromise()
     {
         JSContext* ctx = isolate_->ctx();
@@ -48,7 +48,7 @@ namespace v8
 
         Maybe<bool> SetLazyDataProperty(
             Local<Context> context, Local<Name> name,
-            AccessorNameGetterCallback getter);
+            AccessorNameGetterCallback getter, Local<Value> data = Local<Value>());
 
         static Local<Object> New(Isolate* isolate);
 
@@ -59,6 +59,13 @@ namespace v8
     class Promise : public Object
     {
     public:
+        enum PromiseState { kPending, kFulfilled, kRejected };
+
+        PromiseState State();
+
+        // the value (or the reason) of a settled promise
+        Local<Value> Result();
+
         class Resolver : public Object
         {
             enum : uint32_t { kHolderIndexResolve, kHolderIndexReject, kHolderIndexPromise, kHolderIndexCount };
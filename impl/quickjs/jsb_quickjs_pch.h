@@ -4,6 +4,7 @@
 #include "../../jsb.gen.h"
 
 #include "../shared/jsb_custom_field.h"
+#include "../shared/jsb_latin1.h"
 #if JSB_PREFER_QUICKJS_NG
 #include "../../quickjs-ng/quickjs.h"
 #else
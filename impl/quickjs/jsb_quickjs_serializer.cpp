@@ -1,26 +1,94 @@
 #include "jsb_quickjs_serializer.h"
 
+#include "jsb_quickjs_typedef.h"
 #include "jsb_quickjs_context.h"
 #include "jsb_quickjs_maybe.h"
 #include "jsb_quickjs_handle.h"
+#include "jsb_quickjs_handle_scope.h"
 #include "jsb_quickjs_isolate.h"
+#include "jsb_quickjs_array_buffer.h"
 
 namespace v8
 {
-    ValueSerializer::ValueSerializer(Isolate* isolate)
+#if JSB_QUICKJS_STRUCTURED_CLONE
+    namespace
     {
+        constexpr uint8_t kMagic = 'J';
+        constexpr uint8_t kVersion = 1;
 
+        // deeper values are rejected instead of overflowing the native stack
+        constexpr int kMaxDepth = 512;
+
+        enum SerializationTag : uint8_t
+        {
+            kUndefined = '_',
+            kNull = '0',
+            kTrue = 'T',
+            kFalse = 'F',
+            kInt32 = 'I',           // zigzag varint
+            kDouble = 'N',          // 8 bytes
+            kString8 = 's',         // varint length, latin-1 characters
+            kStringUtf8 = 'u',      // varint length, utf8 bytes
+            kKeyRef = 'k',          // varint index of a property name already written
+            kArray = 'A',           // varint length, elements (holes are read as undefined)
+            kObject = 'O',          // varint count, (name, value) pairs
+            kObjectRef = 'R',       // varint index of an object already written
+            kArrayBuffer = 'B',     // varint length, bytes
+            kTypedArray = 'W',      // element type, varint byte length, bytes
+            kHostObject = 'H',      // written by the delegate
+            kQuickJSObject = 'Q',   // varint length, value in the object format of quickjs (Date, Map, Set, SharedArrayBuffer etc.)
+        };
+    }
+#endif
+
+    ValueSerializer::ValueSerializer(Isolate* isolate, Delegate* delegate)
+        : isolate_(isolate), delegate_(delegate)
+    {
+    }
+
+    ValueSerializer::~ValueSerializer()
+    {
+#if JSB_QUICKJS_STRUCTURED_CLONE
+        JSContext* ctx = isolate_->ctx();
+        for (const KeyValue<JSAtom, uint32_t>& pair : keys_)
+        {
+            JS_FreeAtom(ctx, pair.key);
+        }
+        if (buffer_) memfree(buffer_);
+#else
+        if (buffer_) ::free(buffer_);
+#endif
     }
 
     void ValueSerializer::WriteHeader()
     {
+#if JSB_QUICKJS_STRUCTURED_CLONE
+        _write_byte(kMagic);
+        _write_byte(kVersion);
+#endif
     }
 
     Maybe<bool> ValueSerializer::WriteValue(Local<Context> context, Local<Value> value)
     {
         JSContext* ctx = context->GetIsolate()->ctx();
-        buffer_ = JS_WriteObject(ctx, &size_, (JSValue) value, JS_WRITE_OBJ_REFERENCE);
+#if JSB_QUICKJS_STRUCTURED_CLONE
+        jsb_unused(ctx);
+        return _write_value((JSValue) value, 0) ? Maybe<bool>(true) : Maybe<bool>();
+#else
+        uint8_t** sab_tab = nullptr;
+        size_t sab_tab_len = 0;
+        buffer_ = JS_WriteObject2(ctx, &size_, (JSValue) value, JS_WRITE_OBJ_REFERENCE | JS_WRITE_OBJ_SAB, &sab_tab, &sab_tab_len);
+        if (sab_tab)
+        {
+            shared_backing_stores_.reserve(shared_backing_stores_.size() + sab_tab_len);
+            for (size_t i = 0; i < sab_tab_len; ++i)
+            {
+                shared_backing_stores_.push_back(std::make_shared<BackingStore>(sab_tab[i]));
+            }
+            js_free(ctx, sab_tab);
+        }
         return Maybe(!!buffer_);
+#endif
     }
 
     std::pair<uint8_t*, size_t> ValueSerializer::Release()
@@ -28,24 +96,355 @@ namespace v8
         std::pair<uint8_t*, size_t> rval = { buffer_, size_ };
         buffer_ = nullptr;
         size_ = 0;
+        capacity_ = 0;
         return rval;
     }
 
-    ValueDeserializer::ValueDeserializer(Isolate* isolate, const uint8_t* data, size_t size)
-        : buffer_(const_cast<uint8_t*>(data)), size_(size)
+    void ValueSerializer::WriteUint32(uint32_t value)
+    {
+#if JSB_QUICKJS_STRUCTURED_CLONE
+        _write_varint(value);
+#else
+        jsb_checkf(false, "not supported");
+#endif
+    }
+
+    void ValueSerializer::WriteRawBytes(const void* source, size_t length)
+    {
+#if JSB_QUICKJS_STRUCTURED_CLONE
+        memcpy(_reserve(length), source, length);
+#else
+        jsb_checkf(false, "not supported");
+#endif
+    }
+
+#if JSB_QUICKJS_STRUCTURED_CLONE
+    uint8_t* ValueSerializer::_reserve(size_t p_size)
+    {
+        if (size_ + p_size > capacity_)
+        {
+            capacity_ = MAX(MAX(capacity_ * 2, size_ + p_size), (size_t) 64);
+            buffer_ = (uint8_t*) memrealloc(buffer_, capacity_);
+        }
+        uint8_t* ptr = buffer_ + size_;
+        size_ += p_size;
+        return ptr;
+    }
+
+    void ValueSerializer::_write_byte(uint8_t p_byte)
+    {
+        *_reserve(1) = p_byte;
+    }
+
+    void ValueSerializer::_write_varint(uint32_t p_value)
+    {
+        uint8_t bytes[5];
+        size_t len = 0;
+        do
+        {
+            uint8_t byte = p_value & 0x7f;
+            p_value >>= 7;
+            if (p_value) byte |= 0x80;
+            bytes[len++] = byte;
+        }
+        while (p_value);
+        memcpy(_reserve(len), bytes, len);
+    }
+
+    bool ValueSerializer::_write_value(JSValueConst p_value, int p_depth)
+    {
+        switch (JS_VALUE_GET_NORM_TAG(p_value))
+        {
+        case JS_TAG_UNDEFINED: _write_tag(kUndefined); return true;
+        case JS_TAG_NULL: _write_tag(kNull); return true;
+        case JS_TAG_BOOL: _write_tag(JS_VALUE_GET_BOOL(p_value) ? kTrue : kFalse); return true;
+        case JS_TAG_INT:
+            {
+                const int32_t value = JS_VALUE_GET_INT(p_value);
+                _write_tag(kInt32);
+                _write_varint(((uint32_t) value << 1) ^ (uint32_t) (value >> 31));
+                return true;
+            }
+        case JS_TAG_FLOAT64:
+            {
+                const double value = JS_VALUE_GET_FLOAT64(p_value);
+                _write_tag(kDouble);
+                memcpy(_reserve(sizeof(value)), &value, sizeof(value));
+                return true;
+            }
+        case JS_TAG_STRING: return _write_string(p_value);
+        case JS_TAG_OBJECT: return _write_object(p_value, p_depth);
+        // BigInt etc. (or throw for the values which can't be cloned)
+        default: return _write_quickjs_object(p_value);
+        }
+    }
+
+    bool ValueSerializer::_write_string(JSValueConst p_value)
     {
+        size_t len;
+        if (const uint8_t* chars = JS_GetLatin1String(p_value, &len))
+        {
+            _write_tag(kString8);
+            _write_varint((uint32_t) len);
+            memcpy(_reserve(len), chars, len);
+            return true;
+        }
+
+        JSContext* ctx = isolate_->ctx();
+        const char* str = JS_ToCStringLen(ctx, &len, p_value);
+        if (!str)
+        {
+            return false;
+        }
+        _write_tag(kStringUtf8);
+        _write_varint((uint32_t) len);
+        memcpy(_reserve(len), str, len);
+        JS_FreeCString(ctx, str);
+        return true;
+    }
+
+    bool ValueSerializer::_write_key(JSAtom p_atom)
+    {
+        if (const uint32_t* index = keys_.getptr(p_atom))
+        {
+            _write_tag(kKeyRef);
+            _write_varint(*index);
+            return true;
+        }
+
+        JSContext* ctx = isolate_->ctx();
+        const JSValue str = JS_AtomToString(ctx, p_atom);
+        if (JS_IsException(str))
+        {
+            return false;
+        }
+        const bool written = _write_string(str);
+        JS_FreeValue(ctx, str);
+
+        // hold the atom to make sure it's not reused by another name before the serializer is released
+        keys_.insert(JS_DupAtom(ctx, p_atom), keys_.size());
+        return written;
+    }
+
+    bool ValueSerializer::_write_object(JSValueConst p_value, int p_depth)
+    {
+        JSContext* ctx = isolate_->ctx();
+        if (p_depth >= kMaxDepth)
+        {
+            JS_ThrowRangeError(ctx, "the value is nested too deeply to be cloned");
+            return false;
+        }
+
+        void* ptr = JS_VALUE_GET_PTR(p_value);
+        if (const uint32_t* index = objects_.getptr(ptr))
+        {
+            _write_tag(kObjectRef);
+            _write_varint(*index);
+            return true;
+        }
+
+        // godot objects and variants
+        if (JS_GetOpaque(p_value, isolate_->get_class_id()))
+        {
+            if (!delegate_)
+            {
+                JS_ThrowTypeError(ctx, "a host object can not be cloned");
+                return false;
+            }
+            objects_.insert(ptr, objects_.size());
+            _write_tag(kHostObject);
+
+            HandleScope handle_scope(isolate_);
+            const Local<Object> object(Data(isolate_, isolate_->push_copy(p_value)));
+            return delegate_->WriteHostObject(isolate_, object).IsJust();
+        }
+
+        if (JS_IsProxy(p_value))
+        {
+            JS_ThrowTypeError(ctx, "a proxy can not be cloned");
+            return false;
+        }
+
+        if (JS_IsPlainObject(p_value))
+        {
+            JSPropertyEnum* props = nullptr;
+            uint32_t len = 0;
+            if (JS_GetOwnPropertyNames(ctx, &props, &len, p_value, JS_GPN_STRING_MASK | JS_GPN_ENUM_ONLY) < 0)
+            {
+                return false;
+            }
+
+            objects_.insert(ptr, objects_.size());
+            _write_tag(kObject);
+            _write_varint(len);
+            bool written = true;
+            for (uint32_t i = 0; i < len; ++i)
+            {
+                if (written)
+                {
+                    if (!_write_key(props[i].atom))
+                    {
+                        written = false;
+                    }
+                    else
+                    {
+                        const JSValue value = JS_GetProperty(ctx, p_value, props[i].atom);
+                        written = !JS_IsException(value) && _write_value(value, p_depth + 1);
+                        JS_FreeValue(ctx, value);
+                    }
+                }
+                JS_FreeAtom(ctx, props[i].atom);
+            }
+            js_free(ctx, props);
+            return written;
+        }
+
+        if (JS_IsArray(ctx, p_value) > 0)
+        {
+            JSValue* values;
+            uint32_t len;
+            if (!JS_GetFastArray(p_value, &values, &len))
+            {
+                const JSValue len_val = JS_GetProperty(ctx, p_value, jsb::impl::JS_ATOM_length);
+                const int res = JS_IsException(len_val) ? -1 : JS_ToUint32(ctx, &len, len_val);
+                JS_FreeValue(ctx, len_val);
+                if (res < 0)
+                {
+                    return false;
+                }
+            }
+
+            objects_.insert(ptr, objects_.size());
+            _write_tag(kArray);
+            _write_varint(len);
+            for (uint32_t i = 0; i < len; ++i)
+            {
+                // the elements are read again in each step since the array could be modified by getters of the nested objects
+                uint32_t count;
+                const JSValue element = JS_GetFastArray(p_value, &values, &count) && i < count
+                    ? JS_DupValue(ctx, values[i])
+                    : JS_GetPropertyUint32(ctx, p_value, i);
+                const bool written = !JS_IsException(element) && _write_value(element, p_depth + 1);
+                JS_FreeValue(ctx, element);
+                if (!written)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // the memory of SharedArrayBuffers (and the views of them) is shared instead of copied
+        if (JS_IsArrayBuffer(p_value) && !JS_IsSharedArrayBuffer(p_value))
+        {
+            size_t size;
+            const uint8_t* data = JS_GetArrayBuffer(ctx, &size, p_value);
+            if (!data)
+            {
+                return false;
+            }
+            objects_.insert(ptr, objects_.size());
+            _write_tag(kArrayBuffer);
+            _write_varint((uint32_t) size);
+            memcpy(_reserve(size), data, size);
+            return true;
+        }
+
+        if (const int type = JS_GetTypedArrayType(p_value); type >= 0)
+        {
+            size_t offset, length;
+            const JSValue buffer = JS_GetTypedArrayBuffer(ctx, p_value, &offset, &length, nullptr);
+            if (JS_IsException(buffer))
+            {
+                return false;
+            }
+            if (!JS_IsSharedArrayBuffer(buffer))
+            {
+                size_t size;
+                const uint8_t* data = JS_GetArrayBuffer(ctx, &size, buffer);
+                JS_FreeValue(ctx, buffer);
+                if (!data)
+                {
+                    return false;
+                }
+
+                // only the viewed range is copied (into a new ArrayBuffer of the receiver)
+                objects_.insert(ptr, objects_.size());
+                _write_tag(kTypedArray);
+                _write_byte((uint8_t) type);
+                _write_varint((uint32_t) length);
+                memcpy(_reserve(length), data + offset, length);
+                return true;
+            }
+            JS_FreeValue(ctx, buffer);
+        }
+
+        return _write_quickjs_object(p_value);
+    }
+
+    bool ValueSerializer::_write_quickjs_object(JSValueConst p_value)
+    {
+        JSContext* ctx = isolate_->ctx();
+        size_t size = 0;
+        uint8_t** sab_tab = nullptr;
+        size_t sab_tab_len = 0;
+        uint8_t* data = JS_WriteObject2(ctx, &size, p_value, JS_WRITE_OBJ_REFERENCE | JS_WRITE_OBJ_SAB, &sab_tab, &sab_tab_len);
+        if (sab_tab)
+        {
+            shared_backing_stores_.reserve(shared_backing_stores_.size() + sab_tab_len);
+            for (size_t i = 0; i < sab_tab_len; ++i)
+            {
+                shared_backing_stores_.push_back(std::make_shared<BackingStore>(sab_tab[i]));
+            }
+            js_free(ctx, sab_tab);
+        }
+        if (!data)
+        {
+            return false;
+        }
+        _write_tag(kQuickJSObject);
+        _write_varint((uint32_t) size);
+        memcpy(_reserve(size), data, size);
+        js_free(ctx, data);
+        return true;
+    }
+#endif
+
+    ValueDeserializer::ValueDeserializer(Isolate* isolate, const uint8_t* data, size_t size, Delegate* delegate)
+        : isolate_(isolate), delegate_(delegate), buffer_(data), size_(size)
+    {
+    }
+
+    ValueDeserializer::~ValueDeserializer()
+    {
+#if JSB_QUICKJS_STRUCTURED_CLONE
+        JSContext* ctx = isolate_->ctx();
+        for (const JSAtom atom : keys_)
+        {
+            JS_FreeAtom(ctx, atom);
+        }
+#endif
     }
 
     Maybe<bool> ValueDeserializer::ReadHeader(Local<Context> context)
     {
+#if JSB_QUICKJS_STRUCTURED_CLONE
+        uint8_t magic, version;
+        return Maybe(_read_byte(magic) && magic == kMagic && _read_byte(version) && version == kVersion);
+#else
         return Maybe(true);
+#endif
     }
 
     MaybeLocal<Value> ValueDeserializer::ReadValue(Local<Context> context)
     {
         v8::Isolate* isolate = context->GetIsolate();
         JSContext* ctx = isolate->ctx();
-        const JSValue rval = JS_ReadObject(ctx, buffer_, size_, JS_READ_OBJ_REFERENCE);
+#if JSB_QUICKJS_STRUCTURED_CLONE
+        const JSValue rval = _read_value(0);
+#else
+        const JSValue rval = JS_ReadObject(ctx, buffer_, size_, JS_READ_OBJ_REFERENCE | JS_READ_OBJ_SAB);
+#endif
         if (JS_IsException(rval))
         {
             jsb::impl::QuickJS::MarkExceptionAsTrivial(ctx);
@@ -55,4 +454,234 @@ namespace v8
         return MaybeLocal<Value>(Data(isolate, isolate->push_steal(rval)));
     }
 
+    bool ValueDeserializer::ReadUint32(uint32_t* value)
+    {
+#if JSB_QUICKJS_STRUCTURED_CLONE
+        return _read_varint(*value);
+#else
+        return false;
+#endif
+    }
+
+    bool ValueDeserializer::ReadRawBytes(size_t length, const void** data)
+    {
+        if (length > size_ - position_)
+        {
+            return false;
+        }
+        *data = buffer_ + position_;
+        position_ += length;
+        return true;
+    }
+
+#if JSB_QUICKJS_STRUCTURED_CLONE
+    bool ValueDeserializer::_read_byte(uint8_t& r_byte)
+    {
+        if (position_ >= size_)
+        {
+            return false;
+        }
+        r_byte = buffer_[position_++];
+        return true;
+    }
+
+    bool ValueDeserializer::_read_varint(uint32_t& r_value)
+    {
+        uint32_t value = 0;
+        for (int shift = 0; shift < 35; shift += 7)
+        {
+            uint8_t byte;
+            if (!_read_byte(byte))
+            {
+                return false;
+            }
+            value |= (uint32_t) (byte & 0x7f) << shift;
+            if (!(byte & 0x80))
+            {
+                r_value = value;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    JSValue ValueDeserializer::_throw_invalid()
+    {
+        return JS_ThrowSyntaxError(isolate_->ctx(), "invalid serialized data");
+    }
+
+    JSValue ValueDeserializer::_read_string(uint8_t p_tag)
+    {
+        uint32_t len;
+        const void* chars;
+        if (!_read_varint(len) || !ReadRawBytes(len, &chars))
+        {
+            return _throw_invalid();
+        }
+        return p_tag == kString8
+            ? JS_NewLatin1String(isolate_->ctx(), (const uint8_t*) chars, len)
+            : JS_NewStringLen(isolate_->ctx(), (const char*) chars, len);
+    }
+
+    bool ValueDeserializer::_read_key(JSAtom& r_atom)
+    {
+        uint8_t tag;
+        if (!_read_byte(tag))
+        {
+            _throw_invalid();
+            return false;
+        }
+        if (tag == kKeyRef)
+        {
+            uint32_t index;
+            if (!_read_varint(index) || index >= (uint32_t) keys_.size())
+            {
+                _throw_invalid();
+                return false;
+            }
+            r_atom = keys_[index];
+            return true;
+        }
+        if (tag != kString8 && tag != kStringUtf8)
+        {
+            _throw_invalid();
+            return false;
+        }
+
+        JSContext* ctx = isolate_->ctx();
+        const JSValue str = _read_string(tag);
+        if (JS_IsException(str))
+        {
+            return false;
+        }
+        r_atom = JS_ValueToAtom(ctx, str);
+        JS_FreeValue(ctx, str);
+        if (r_atom == JS_ATOM_NULL)
+        {
+            return false;
+        }
+        keys_.push_back(r_atom);
+        return true;
+    }
+
+    JSValue ValueDeserializer::_read_value(int p_depth)
+    {
+        JSContext* ctx = isolate_->ctx();
+        uint8_t tag;
+        if (!_read_byte(tag) || p_depth >= kMaxDepth)
+        {
+            return _throw_invalid();
+        }
+
+        switch (tag)
+        {
+        case kUndefined: return JS_UNDEFINED;
+        case kNull: return JS_NULL;
+        case kTrue: return JS_TRUE;
+        case kFalse: return JS_FALSE;
+        case kInt32:
+            {
+                uint32_t value;
+                if (!_read_varint(value)) return _throw_invalid();
+                return JS_NewInt32(ctx, (int32_t) ((value >> 1) ^ (0u - (value & 1))));
+            }
+        case kDouble:
+            {
+                const void* bytes;
+                if (!ReadRawBytes(sizeof(double), &bytes)) return _throw_invalid();
+                double value;
+                memcpy(&value, bytes, sizeof(value));
+                return JS_NewFloat64(ctx, value);
+            }
+        case kString8:
+        case kStringUtf8:
+            return _read_string(tag);
+        case kObjectRef:
+            {
+                uint32_t index;
+                if (!_read_varint(index) || index >= (uint32_t) objects_.size()) return _throw_invalid();
+                return JS_DupValue(ctx, objects_[index]);
+            }
+        case kArray:
+            {
+                uint32_t len;
+                if (!_read_varint(len)) return _throw_invalid();
+                const JSValue array = JS_NewArray(ctx);
+                if (JS_IsException(array)) return array;
+                objects_.push_back(array);
+                for (uint32_t i = 0; i < len; ++i)
+                {
+                    const JSValue element = _read_value(p_depth + 1);
+                    if (JS_IsException(element) || JS_DefinePropertyValueUint32(ctx, array, i, element, JS_PROP_C_W_E) < 0)
+                    {
+                        JS_FreeValue(ctx, array);
+                        return JS_EXCEPTION;
+                    }
+                }
+                return array;
+            }
+        case kObject:
+            {
+                uint32_t len;
+                if (!_read_varint(len)) return _throw_invalid();
+                const JSValue object = JS_NewObject(ctx);
+                if (JS_IsException(object)) return object;
+                objects_.push_back(object);
+                for (uint32_t i = 0; i < len; ++i)
+                {
+                    JSAtom atom;
+                    if (!_read_key(atom))
+                    {
+                        JS_FreeValue(ctx, object);
+                        return JS_EXCEPTION;
+                    }
+                    const JSValue value = _read_value(p_depth + 1);
+                    if (JS_IsException(value) || JS_DefinePropertyValue(ctx, object, atom, value, JS_PROP_C_W_E) < 0)
+                    {
+                        JS_FreeValue(ctx, object);
+                        return JS_EXCEPTION;
+                    }
+                }
+                return object;
+            }
+        case kArrayBuffer:
+            {
+                uint32_t len;
+                const void* data;
+                if (!_read_varint(len) || !ReadRawBytes(len, &data)) return _throw_invalid();
+                const JSValue buffer = JS_NewArrayBufferCopy(ctx, (const uint8_t*) data, len);
+                if (!JS_IsException(buffer)) objects_.push_back(buffer);
+                return buffer;
+            }
+        case kTypedArray:
+            {
+                uint8_t type;
+                uint32_t len;
+                const void* data;
+                if (!_read_byte(type) || !_read_varint(len) || !ReadRawBytes(len, &data)) return _throw_invalid();
+                const JSValue typed_array = JS_NewTypedArrayCopy(ctx, type, (const uint8_t*) data, len);
+                if (!JS_IsException(typed_array)) objects_.push_back(typed_array);
+                return typed_array;
+            }
+        case kHostObject:
+            {
+                if (!delegate_) return _throw_invalid();
+                HandleScope handle_scope(isolate_);
+                Local<Object> object;
+                if (!delegate_->ReadHostObject(isolate_).ToLocal(&object)) return _throw_invalid();
+                const JSValue value = JS_DupValue(ctx, (JSValue) object);
+                objects_.push_back(value);
+                return value;
+            }
+        case kQuickJSObject:
+            {
+                uint32_t len;
+                const void* data;
+                if (!_read_varint(len) || !ReadRawBytes(len, &data)) return _throw_invalid();
+                return JS_ReadObject(ctx, (const uint8_t*) data, len, JS_READ_OBJ_REFERENCE | JS_READ_OBJ_SAB);
+            }
+        default: return _throw_invalid();
+        }
+    }
+#endif
 }
@@ -2,6 +2,10 @@
 #define GODOTJS_QUICKJS_SERIALIZER_H
 #include "jsb_quickjs_pch.h"
 
+// the structured clone format of jsb (shared nothing with the object format of quickjs except the fallback of uncommon types),
+// quickjs-ng still uses JS_WriteObject/JS_ReadObject since it lacks the jsb modifications of quickjs
+#define JSB_QUICKJS_STRUCTURED_CLONE !JSB_PREFER_QUICKJS_NG
+
 namespace v8
 {
     class Isolate;
@@ -17,29 +21,122 @@ namespace v8
 
     class Context;
     class Value;
+    class Object;
+    class BackingStore;
 
     class ValueSerializer
     {
-        uint8_t* buffer_ = nullptr;
-        size_t size_ = 0;
-
     public:
-        explicit ValueSerializer(Isolate* isolate);
+        class Delegate
+        {
+        public:
+            virtual ~Delegate() = default;
+
+            // write an object with internal fields (godot objects and variants) with WriteUint32/WriteRawBytes,
+            // return Nothing with an exception thrown if it can't be cloned
+            virtual Maybe<bool> WriteHostObject(Isolate* isolate, Local<Object> object) = 0;
+        };
+
+        explicit ValueSerializer(Isolate* isolate, Delegate* delegate = nullptr);
+        ~ValueSerializer();
+
+        ValueSerializer(const ValueSerializer&) = delete;
+        ValueSerializer& operator=(const ValueSerializer&) = delete;
 
         void WriteHeader();
         Maybe<bool> WriteValue(Local<Context> context, Local<Value> value);
         std::pair<uint8_t*, size_t> Release();
-    };
 
-    class ValueDeserializer
-    {
+        void WriteUint32(uint32_t value);
+        void WriteRawBytes(const void* source, size_t length);
+
+        // (not a v8 api) take the backing stores of all SharedArrayBuffers written
+        std::vector<std::shared_ptr<BackingStore>> ReleaseSharedBackingStores() { return std::move(shared_backing_stores_); }
+
+    private:
+#if JSB_QUICKJS_STRUCTURED_CLONE
+        bool _write_value(JSValueConst p_value, int p_depth);
+        bool _write_object(JSValueConst p_value, int p_depth);
+        bool _write_key(JSAtom p_atom);
+        bool _write_string(JSValueConst p_value);
+
+        // write the value in the object format of quickjs (for the types not covered by the structured clone format)
+        bool _write_quickjs_object(JSValueConst p_value);
+
+        void _write_tag(uint8_t p_tag) { _write_byte(p_tag); }
+        void _write_byte(uint8_t p_byte);
+        void _write_varint(uint32_t p_value);
+        uint8_t* _reserve(size_t p_size);
+#endif
+
+        Isolate* isolate_;
+        Delegate* delegate_;
+
         uint8_t* buffer_ = nullptr;
         size_t size_ = 0;
+        size_t capacity_ = 0;
+
+#if JSB_QUICKJS_STRUCTURED_CLONE
+        // property names already written, referenced by index
+        HashMap<JSAtom, uint32_t> keys_;
+
+        // objects already written, referenced by index (preserve the identity and cycles)
+        HashMap<void*, uint32_t> objects_;
+#endif
 
+        // SharedArrayBuffers are written as raw pointers, hold references until the data is deserialized
+        std::vector<std::shared_ptr<BackingStore>> shared_backing_stores_;
+    };
+
+    class ValueDeserializer
+    {
     public:
-        ValueDeserializer(Isolate* isolate, const uint8_t* data, size_t size);
+        class Delegate
+        {
+        public:
+            virtual ~Delegate() = default;
+
+            // read an object written by ValueSerializer::Delegate::WriteHostObject
+            virtual MaybeLocal<Object> ReadHostObject(Isolate* isolate) = 0;
+        };
+
+        ValueDeserializer(Isolate* isolate, const uint8_t* data, size_t size, Delegate* delegate = nullptr);
+        ~ValueDeserializer();
+
+        ValueDeserializer(const ValueDeserializer&) = delete;
+        ValueDeserializer& operator=(const ValueDeserializer&) = delete;
+
         Maybe<bool> ReadHeader(Local<Context> context);
         MaybeLocal<Value> ReadValue(Local<Context> context);
+
+        bool ReadUint32(uint32_t* value);
+        bool ReadRawBytes(size_t length, const void** data);
+
+    private:
+#if JSB_QUICKJS_STRUCTURED_CLONE
+        JSValue _read_value(int p_depth);
+        JSValue _read_string(uint8_t p_tag);
+        bool _read_key(JSAtom& r_atom);
+
+        bool _read_byte(uint8_t& r_byte);
+        bool _read_varint(uint32_t& r_value);
+
+        JSValue _throw_invalid();
+#endif
+
+        Isolate* isolate_;
+        Delegate* delegate_;
+
+        const uint8_t* buffer_ = nullptr;
+        size_t size_ = 0;
+        size_t position_ = 0;
+
+#if JSB_QUICKJS_STRUCTURED_CLONE
+        std::vector<JSAtom> keys_;
+
+        // objects in the order of creation (not owned)
+        std::vector<JSValue> objects_;
+#endif
     };
 }
 #endif
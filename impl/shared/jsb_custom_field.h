@@ -79,5 +79,13 @@ namespace jsb::impl
             return cf;
         }
     };
+
+    // an entry of the JS heap summary (see `Helper::get_heap_summary`)
+    struct HeapSummaryEntry
+    {
+        String name;
+        int64_t count;
+        int64_t size;
+    };
 }
 #endif
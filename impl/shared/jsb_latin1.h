@@ -0,0 +1,58 @@
+#ifndef GODOTJS_LATIN1_H
+#define GODOTJS_LATIN1_H
+
+#include <cstdint>
+#include "core/string/ustring.h"
+#include "../../compat/jsb_engine_version_comparison.h"
+
+namespace jsb::impl
+{
+    // conversion between godot strings and one-byte (latin-1) js strings without going through utf8/utf16 encoding,
+    // the loops are kept trivial to let the compiler vectorize them
+    struct Latin1
+    {
+        // threshold of the staging buffer allocated on the stack (in characters)
+        constexpr static int kStackBufferSize = 512;
+
+        // widen latin-1 characters into a godot string
+        static String to_string(const uint8_t* p_chars, int p_len)
+        {
+            String str;
+            if (p_len <= 0) return str;
+#if GODOT_4_5_OR_NEWER
+            str.resize_uninitialized(p_len + 1);
+#else
+            str.resize(p_len + 1);
+#endif
+            char32_t* dst = str.ptrw();
+            for (int i = 0; i < p_len; ++i)
+            {
+                dst[i] = (char32_t) p_chars[i];
+            }
+            dst[p_len] = 0;
+            return str;
+        }
+
+        // check if all characters of a godot string are representable in latin-1
+        static bool is_latin1(const char32_t* p_chars, int p_len)
+        {
+            char32_t bits = 0;
+            for (int i = 0; i < p_len; ++i)
+            {
+                bits |= p_chars[i];
+            }
+            return bits <= 0xFF;
+        }
+
+        // narrow the characters of a latin-1 godot string (`is_latin1` must be checked at first)
+        static void narrow(const char32_t* p_chars, int p_len, uint8_t* r_chars)
+        {
+            for (int i = 0; i < p_len; ++i)
+            {
+                r_chars[i] = (uint8_t) p_chars[i];
+            }
+        }
+    };
+}
+
+#endif
@@ -122,6 +122,23 @@ namespace jsb::impl
                 else builder_->template_->Set(key, value);
             }
 
+#if JSB_V8_FAST_API_CALLS
+            // a method with the fast callback called from optimized code, `callback` is still used if the call site is not optimized
+            template<typename T>
+            void FastMethod(const String& name, const v8::FunctionCallback callback, const v8::CFunction* c_function, T data)
+            {
+                jsb_check(builder_->state_ == State::Building);
+                v8::HandleScope handle_scope(builder_->isolate_);
+
+                const v8::Local<v8::Name> key = Helper::new_string(builder_->isolate_, name);
+                const v8::Local<v8::FunctionTemplate> value = v8::FunctionTemplate::New(builder_->isolate_, callback, impl_private::Data<T>::New(builder_->isolate_, data),
+                    v8::Local<v8::Signature>(), 0, v8::ConstructorBehavior::kThrow, v8::SideEffectType::kHasSideEffect, c_function);
+
+                if (is_instance_method) builder_->prototype_template_->Set(key, value);
+                else builder_->template_->Set(key, value);
+            }
+#endif
+
             // getter/setter with common data payload
             template<typename T>
             void Property(const String& name, const v8::FunctionCallback getter_cb, const v8::FunctionCallback setter_cb, T data)
@@ -186,6 +203,20 @@ namespace jsb::impl
                 else builder_->template_->SetLazyDataProperty(key, getter);
             }
 
+            // the lazy getter receives `data` as `PropertyCallbackInfo::Data()`
+            template<typename T>
+            void LazyProperty(const String& name, const v8::AccessorNameGetterCallback getter, T data)
+            {
+                jsb_check(builder_->state_ == State::Building);
+                v8::HandleScope handle_scope(builder_->isolate_);
+
+                const v8::Local<v8::Name> key = Helper::new_string(builder_->isolate_, name);
+                const v8::Local<v8::Value> value = impl_private::Data<T>::New(builder_->isolate_, data);
+
+                if (is_instance_method) builder_->prototype_template_->SetLazyDataProperty(key, getter, value);
+                else builder_->template_->SetLazyDataProperty(key, getter, value);
+            }
+
             template<typename T>
             void Value(const v8::Local<v8::Name> key, T val)
             {
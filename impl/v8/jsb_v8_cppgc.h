@@ -0,0 +1,45 @@
+#ifndef GODOTJS_V8_CPPGC_H
+#define GODOTJS_V8_CPPGC_H
+
+#include "jsb_v8_pch.h"
+
+#if JSB_V8_CPPGC
+namespace jsb::impl
+{
+    /**
+     * The native part of a JS wrapper object, allocated on the CppHeap of the isolate and traced by the unified heap.
+     * It's finalized (on the isolate thread) after the JS wrapper is collected, then the deleter is called with the bound pointer.
+     * The deleter must not touch the JS heap, it only releases the native data or posts the release to the environment.
+     */
+    class CppgcWrappable final : public cppgc::GarbageCollected<CppgcWrappable>
+    {
+    public:
+        CppgcWrappable(void* p_pointer, size_t p_length, v8::BackingStore::DeleterCallback p_deleter, void* p_deleter_data)
+            : pointer_(p_pointer), length_(p_length), deleter_(p_deleter), deleter_data_(p_deleter_data)
+        {}
+
+        ~CppgcWrappable()
+        {
+            if (deleter_) deleter_(pointer_, length_, deleter_data_);
+        }
+
+        // no managed references to other objects
+        void Trace(cppgc::Visitor* p_visitor) const {}
+
+        static void wrap(v8::Isolate* isolate, const v8::Local<v8::Object>& p_object, void* p_pointer, size_t p_length, v8::BackingStore::DeleterCallback p_deleter, void* p_deleter_data)
+        {
+            CppgcWrappable* wrappable = cppgc::MakeGarbageCollected<CppgcWrappable>(isolate->GetCppHeap()->GetAllocationHandle(),
+                p_pointer, p_length, p_deleter, p_deleter_data);
+            v8::Object::Wrap<v8::CppHeapPointerTag::kDefaultTag>(isolate, p_object, wrappable);
+        }
+
+    private:
+        void* pointer_;
+        size_t length_;
+        v8::BackingStore::DeleterCallback deleter_;
+        void* deleter_data_;
+    };
+}
+#endif
+
+#endif
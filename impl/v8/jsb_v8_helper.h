@@ -2,6 +2,7 @@
 #define GODOTJS_V8_HELPER_H
 
 #include "jsb_v8_pch.h"
+#include "jsb_v8_cppgc.h"
 
 #define V8_VERSION_NEWER_THAN(major, minor, patch) GODOT_VERSION_COMPARE(V8_MAJOR_VERSION, major, GODOT_VERSION_COMPARE(V8_MINOR_VERSION, minor, GODOT_VERSION_COMPARE(V8_BUILD_VERSION, patch, false)))
 
@@ -16,22 +17,60 @@ namespace jsb::impl
         static void SetDeleter(Variant* p_pointer, const v8::Local<v8::Object> p_object, v8::BackingStore::DeleterCallback callback, void *deleter_data)
         {
             v8::Isolate* isolate = p_object->GetIsolate();
+#if JSB_V8_CPPGC
+            // the variant is released along with the wrapper by cppgc
+            CppgcWrappable::wrap(isolate, p_object, p_pointer, sizeof(Variant), callback, deleter_data);
+#else
             p_object->Set(isolate->GetCurrentContext(), 0,
                 // in this way, the scavenger could gc it efficiently
                 v8::ArrayBuffer::New(isolate, v8::ArrayBuffer::NewBackingStore(p_pointer, sizeof(Variant), callback, deleter_data))
             ).Check();
+#endif
+        }
+
+        // allocate a Variant in a backing store owned by `p_object`, it's released along with `p_object` without any callback.
+        // only valid for the types without heap allocated data (see VariantUtil::is_trivial_storage_type).
+        static Variant* new_inline_variant(const v8::Local<v8::Object> p_object)
+        {
+            v8::Isolate* isolate = p_object->GetIsolate();
+            const v8::Local<v8::ArrayBuffer> buffer = v8::ArrayBuffer::New(isolate, sizeof(Variant));
+            p_object->Set(isolate->GetCurrentContext(), 0, buffer).Check();
+            return memnew_placement(buffer->Data(), Variant);
         }
 
         static PackedByteArray to_packed_byte_array(v8::Isolate* isolate, const v8::Local<v8::ArrayBuffer>& array_buffer)
         {
-            const size_t size = array_buffer->ByteLength();
             PackedByteArray packed;
-            const Error err = packed.resize((int) size);
+            const bool succeeded = to_packed_array(isolate, array_buffer, packed);
+            jsb_unused(succeeded);
+            jsb_check(succeeded);
+            return packed;
+        }
+
+        // copy the content of an ArrayBuffer into a packed array (the byte length must be a multiple of the element size)
+        template<typename T>
+        static bool to_packed_array(v8::Isolate* isolate, const v8::Local<v8::ArrayBuffer>& array_buffer, Vector<T>& r_packed)
+        {
+            const size_t size = array_buffer->ByteLength();
+            if (size % sizeof(T) != 0) return false;
+            const Error err = r_packed.resize((int) (size / sizeof(T)));
             jsb_unused(err);
             jsb_check(err == OK);
-            const void* data = array_buffer->Data();
-            memcpy(packed.ptrw(), data, size);
-            return packed;
+            if (size != 0) memcpy(r_packed.ptrw(), array_buffer->Data(), size);
+            return true;
+        }
+
+        // copy the content of a TypedArray/DataView into a packed array (the byte length must be a multiple of the element size)
+        template<typename T>
+        static bool to_packed_array(v8::Isolate* isolate, const v8::Local<v8::ArrayBufferView>& array_buffer_view, Vector<T>& r_packed)
+        {
+            const size_t size = array_buffer_view->ByteLength();
+            if (size % sizeof(T) != 0) return false;
+            const Error err = r_packed.resize((int) (size / sizeof(T)));
+            jsb_unused(err);
+            jsb_check(err == OK);
+            if (size != 0) array_buffer_view->CopyContents(r_packed.ptrw(), size);
+            return true;
         }
 
         static v8::Local<v8::ArrayBuffer> to_array_buffer(v8::Isolate* isolate, const Vector<uint8_t>& packed)
@@ -42,6 +81,24 @@ namespace jsb::impl
             return buffer;
         }
 
+        // create an ArrayBuffer over the storage of a packed array without copying.
+        // the storage is shared with `packed` (COW), and kept alive until the ArrayBuffer is garbage collected.
+        template<typename T>
+        static v8::Local<v8::ArrayBuffer> to_array_buffer_view(v8::Isolate* isolate, const Vector<T>& packed)
+        {
+            if (packed.is_empty()) return v8::ArrayBuffer::New(isolate, 0);
+            Vector<T>* storage = memnew(Vector<T>(packed));
+            return v8::ArrayBuffer::New(isolate, v8::ArrayBuffer::NewBackingStore(
+                (void*) storage->ptr(), storage->size() * sizeof(T), &_release_array_buffer_view<T>, storage));
+        }
+
+        // [thread safe] the backing store may be released on any thread
+        template<typename T>
+        static void _release_array_buffer_view(void* data, size_t length, void* deleter_data)
+        {
+            memdelete((Vector<T>*) deleter_data);
+        }
+
         static v8::Local<v8::Function> NewFunction(v8::Local<v8::Context> context, const char* name, v8::FunctionCallback callback, v8::Local<v8::Value> data)
         {
             return v8::Function::New(context, callback, data).ToLocalChecked();
@@ -66,6 +123,22 @@ namespace jsb::impl
         {
             if (!p_val.IsEmpty() && !p_val->IsNullOrUndefined())
             {
+                // most strings (names, keys) are stored as one-byte strings in v8, widen them directly
+                if (p_val->IsString() && p_val.As<v8::String>()->IsOneByte())
+                {
+                    const v8::Local<v8::String> str = p_val.As<v8::String>();
+                    const int len = str->Length();
+                    if (len <= Latin1::kStackBufferSize)
+                    {
+                        uint8_t* chars = jsb_stackalloc(uint8_t, len);
+                        str->WriteOneByte(isolate, chars, 0, len, v8::String::NO_NULL_TERMINATION);
+                        return Latin1::to_string(chars, len);
+                    }
+                    internal::ScratchArena::Scope scratch;
+                    uint8_t* chars = scratch.alloc<uint8_t>(len);
+                    str->WriteOneByte(isolate, chars, 0, len, v8::String::NO_NULL_TERMINATION);
+                    return Latin1::to_string(chars, len);
+                }
 #if JSB_UTF16_CONV_PREFERRED
                 if (const v8::String::Value str16(isolate, p_val); str16.length())
                 {
@@ -97,8 +170,14 @@ namespace jsb::impl
             return v8::String::NewFromUtf8Literal(isolate, literal, v8::NewStringType::kNormal);
         }
 
-        jsb_force_inline static v8::Local<v8::String> new_string(v8::Isolate* isolate, const String& p_str)
+        static v8::Local<v8::String> new_string(v8::Isolate* isolate, const String& p_str)
         {
+            if (const int len = p_str.length(); len <= Latin1::kStackBufferSize && Latin1::is_latin1(p_str.ptr(), len))
+            {
+                uint8_t* chars = jsb_stackalloc(uint8_t, len);
+                Latin1::narrow(p_str.ptr(), len, chars);
+                return v8::String::NewFromOneByte(isolate, chars, v8::NewStringType::kNormal, len).ToLocalChecked();
+            }
 #if JSB_UTF16_CONV_PREFERRED
             const Char16String str16 = p_str.utf16();
             return v8::String::NewFromTwoByte(isolate, (const uint16_t*) str16.get_data(), v8::NewStringType::kNormal, str16.length()).ToLocalChecked();
@@ -134,8 +213,9 @@ namespace jsb::impl
         jsb_force_inline static v8::Local<v8::Value> new_integer(v8::Isolate* isolate, const int64_t p_val)
         {
             if (const int32_t downscale = (int32_t) p_val;
-                (int64_t) downscale == p_val)
+                jsb_likely((int64_t) downscale == p_val))
             {
+                // Smi
                 return v8::Int32::New(isolate, downscale);
             }
 #if JSB_WITH_BIGINT
@@ -201,6 +281,152 @@ namespace jsb::impl
             return maybe_value;
         }
 
+        // a string referring to the immutable ASCII data which lives until the process exits (e.g. the embedded presets)
+        static v8::Local<v8::String> new_static_one_byte_string(v8::Isolate* isolate, const char* p_data, int p_len)
+        {
+            // V8 deletes the resource when the string is collected, the data itself is not owned
+            struct StaticOneByteStringResource : v8::String::ExternalOneByteStringResource
+            {
+                const char* data_;
+                size_t length_;
+
+                StaticOneByteStringResource(const char* p_data, size_t p_length) : data_(p_data), length_(p_length) {}
+                virtual const char* data() const override { return data_; }
+                virtual size_t length() const override { return length_; }
+            };
+
+            v8::Local<v8::String> str;
+            if (!v8::String::NewExternalOneByte(isolate, new StaticOneByteStringResource(p_data, (size_t) p_len)).ToLocal(&str))
+            {
+                // too short to be external, or too long to be a string at all
+                return v8::String::NewFromOneByte(isolate, (const uint8_t*) p_data, v8::NewStringType::kNormal, p_len).ToLocalChecked();
+            }
+            return str;
+        }
+
+#if JSB_WITH_CODE_CACHE
+        // a tag which changes along with the V8 version and flags, the code cache is useless if it mismatches
+        static uint32_t get_code_cache_version_tag()
+        {
+            return v8::ScriptCompiler::CachedDataVersionTag();
+        }
+
+        /**
+         * \brief same as `compile_function` but consume/produce the V8 code cache.
+         * \param p_cached_data the code cache produced previously (can be empty)
+         * \param r_cached_data (optional) filled with a fresh code cache if `p_cached_data` is empty or rejected by V8
+         * \param p_static_one_byte the source is pure ASCII and never freed, it's referenced as an external string without copying it into the V8 heap
+         */
+        static v8::MaybeLocal<v8::Value> compile_function(const v8::Local<v8::Context>& context, const char* p_source, int p_source_len, const String& p_filename,
+            const Vector<uint8_t>& p_cached_data, Vector<uint8_t>* r_cached_data, bool p_static_one_byte = false)
+        {
+            v8::Isolate* isolate = context->GetIsolate();
+            const v8::Local<v8::String> source_string = p_static_one_byte
+                ? new_static_one_byte_string(isolate, p_source, p_source_len)
+                : v8::String::NewFromUtf8(isolate, p_source, v8::NewStringType::kNormal, p_source_len).ToLocalChecked();
+#if JSB_WITH_URI_SCRIPT_ORIGIN
+            const String prefixed = "file://" + p_filename;
+            const CharString filename = prefixed.utf8();
+#else
+#ifdef WINDOWS_ENABLED
+            const CharString filename = p_filename.replace("/", "\\").utf8();
+#else
+            const CharString filename = p_filename.utf8();
+#endif
+#endif
+#if V8_VERSION_NEWER_THAN(12, 1, 139)
+            v8::ScriptOrigin origin(v8::String::NewFromUtf8(isolate, filename.ptr(), v8::NewStringType::kNormal, filename.length()).ToLocalChecked());
+#else
+            v8::ScriptOrigin origin(isolate, v8::String::NewFromUtf8(isolate, filename.ptr(), v8::NewStringType::kNormal, filename.length()).ToLocalChecked());
+#endif
+            const bool has_cached_data = !p_cached_data.is_empty();
+
+            // `Source` takes the ownership of `CachedData`, but not the buffer (BufferNotOwned)
+            v8::ScriptCompiler::Source source(source_string, origin, has_cached_data
+                ? new v8::ScriptCompiler::CachedData(p_cached_data.ptr(), p_cached_data.size())
+                : nullptr);
+            const v8::MaybeLocal<v8::Script> maybe_script = v8::ScriptCompiler::Compile(context, &source,
+                has_cached_data ? v8::ScriptCompiler::kConsumeCodeCache : v8::ScriptCompiler::kNoCompileOptions);
+
+            v8::Local<v8::Script> script;
+            if (!maybe_script.ToLocal(&script))
+            {
+                return {};
+            }
+
+            const bool rejected = has_cached_data && source.GetCachedData()->rejected;
+            if (rejected)
+            {
+                JSB_LOG(Verbose, "code cache rejected %s", p_filename);
+            }
+
+            const v8::MaybeLocal<v8::Value> maybe_value = script->Run(context);
+            if (maybe_value.IsEmpty())
+            {
+                return {};
+            }
+
+            // create the code cache after running, the functions compiled lazily while running are included
+            if (r_cached_data && (!has_cached_data || rejected))
+            {
+                if (const std::unique_ptr<v8::ScriptCompiler::CachedData> cached_data(v8::ScriptCompiler::CreateCodeCache(script->GetUnboundScript())); cached_data)
+                {
+                    r_cached_data->resize(cached_data->length);
+                    memcpy(r_cached_data->ptrw(), cached_data->data, cached_data->length);
+                }
+            }
+            return maybe_value;
+        }
+#endif
+
+        /**
+         * \brief same as `compile_function` but finish the compilation of a source which is already parsed in background (see `ModulePrefetcher`).
+         * \param p_full_source the same source fed to the streaming task
+         * \param r_cached_data (optional) filled with a fresh code cache
+         */
+        static v8::MaybeLocal<v8::Value> compile_streamed_function(const v8::Local<v8::Context>& context, v8::ScriptCompiler::StreamedSource* p_streamed,
+            const char* p_full_source, int p_full_source_len, const String& p_filename, Vector<uint8_t>* r_cached_data = nullptr)
+        {
+            v8::Isolate* isolate = context->GetIsolate();
+            const v8::Local<v8::String> source_string = v8::String::NewFromUtf8(isolate, p_full_source, v8::NewStringType::kNormal, p_full_source_len).ToLocalChecked();
+#if JSB_WITH_URI_SCRIPT_ORIGIN
+            const String prefixed = "file://" + p_filename;
+            const CharString filename = prefixed.utf8();
+#else
+#ifdef WINDOWS_ENABLED
+            const CharString filename = p_filename.replace("/", "\\").utf8();
+#else
+            const CharString filename = p_filename.utf8();
+#endif
+#endif
+#if V8_VERSION_NEWER_THAN(12, 1, 139)
+            v8::ScriptOrigin origin(v8::String::NewFromUtf8(isolate, filename.ptr(), v8::NewStringType::kNormal, filename.length()).ToLocalChecked());
+#else
+            v8::ScriptOrigin origin(isolate, v8::String::NewFromUtf8(isolate, filename.ptr(), v8::NewStringType::kNormal, filename.length()).ToLocalChecked());
+#endif
+            v8::Local<v8::Script> script;
+            if (!v8::ScriptCompiler::Compile(context, p_streamed, source_string, origin).ToLocal(&script))
+            {
+                return {};
+            }
+
+            const v8::MaybeLocal<v8::Value> maybe_value = script->Run(context);
+            if (maybe_value.IsEmpty())
+            {
+                return {};
+            }
+
+            if (r_cached_data)
+            {
+                if (const std::unique_ptr<v8::ScriptCompiler::CachedData> cached_data(v8::ScriptCompiler::CreateCodeCache(script->GetUnboundScript())); cached_data)
+                {
+                    r_cached_data->resize(cached_data->length);
+                    memcpy(r_cached_data->ptrw(), cached_data->data, cached_data->length);
+                }
+            }
+            return maybe_value;
+        }
+
         static v8::MaybeLocal<v8::Value> eval(const v8::Local<v8::Context>& context, const char* p_source, int p_source_len, const String& p_filename)
         {
             return compile_function(context, p_source, p_source_len, p_filename);
@@ -222,6 +448,14 @@ namespace jsb::impl
             ::free(data);
         }
 
+        // the size of the memory used by the JS heap (in bytes, 0 if not available)
+        jsb_force_inline static size_t get_used_heap_size(v8::Isolate* isolate)
+        {
+            v8::HeapStatistics v8_statistics;
+            isolate->GetHeapStatistics(&v8_statistics);
+            return v8_statistics.used_heap_size() + v8_statistics.malloced_memory();
+        }
+
         jsb_force_inline static void get_statistics(v8::Isolate* isolate, Vector<CustomField>& p_fields)
         {
             v8::HeapStatistics v8_statistics;
@@ -234,6 +468,46 @@ namespace jsb::impl
             p_fields.append(CustomField::value_u64("external_memory", v8_statistics.external_memory()));
         }
 
+        // take a heap snapshot (slow), the objects are grouped by the constructor name (script classes included) and other nodes by type.
+        // the size is the shallow size, the retained size is not available in the public api of v8
+        static void get_heap_summary(v8::Isolate* isolate, Vector<HeapSummaryEntry>& r_entries)
+        {
+            v8::HandleScope handle_scope(isolate);
+            const v8::HeapSnapshot* snapshot = isolate->GetHeapProfiler()->TakeHeapSnapshot();
+            if (!snapshot) return;
+
+            HashMap<String, int> indices;
+            for (int index = 0, n = snapshot->GetNodesCount(); index < n; ++index)
+            {
+                const v8::HeapGraphNode* node = snapshot->GetNode(index);
+                String name;
+                switch (node->GetType())
+                {
+                case v8::HeapGraphNode::kObject: name = to_string(isolate, node->GetName()); break;
+                case v8::HeapGraphNode::kClosure: name = "(closure)"; break;
+                case v8::HeapGraphNode::kString:
+                case v8::HeapGraphNode::kConsString:
+                case v8::HeapGraphNode::kSlicedString: name = "(string)"; break;
+                case v8::HeapGraphNode::kCode: name = "(code)"; break;
+                case v8::HeapGraphNode::kArray: name = "(array)"; break;
+                case v8::HeapGraphNode::kRegExp: name = "(regexp)"; break;
+                case v8::HeapGraphNode::kHeapNumber: name = "(number)"; break;
+                default: name = "(system)"; break;
+                }
+
+                int* entry_index = indices.getptr(name);
+                if (!entry_index)
+                {
+                    entry_index = &indices.insert(name, r_entries.size())->value;
+                    r_entries.append({ name, 0, 0 });
+                }
+                HeapSummaryEntry& entry = r_entries.write[*entry_index];
+                ++entry.count;
+                entry.size += (int64_t) node->GetShallowSize();
+            }
+            const_cast<v8::HeapSnapshot*>(snapshot)->Delete();
+        }
+
         jsb_force_inline static void set_as_interruptible(v8::Isolate* isolate) {}
     };
 }
@@ -5,16 +5,34 @@
 #include <v8-persistent-handle.h>
 #include <libplatform/libplatform.h>
 #include <v8-inspector.h>
+#include <v8-profiler.h>
 #include <v8-version-string.h>
 
 #if JSB_V8_CPPGC
 #   include <v8-cppgc.h>
 #   include <cppgc/default-platform.h>
+#   include <cppgc/allocation.h>
+#   include <cppgc/garbage-collected.h>
+#   include <cppgc/visitor.h>
+#   if V8_MAJOR_VERSION < 12 || (V8_MAJOR_VERSION == 12 && V8_MINOR_VERSION < 8)
+#       error "JSB_V8_CPPGC requires v8 12.8 or later (v8::Object::Wrap)"
+#   endif
+#endif
+
+#if JSB_V8_FAST_API_CALLS
+#   include <v8-fast-api-calls.h>
+#   if V8_MAJOR_VERSION < 12 || (V8_MAJOR_VERSION == 12 && V8_MINOR_VERSION < 8)
+        // `FastApiCallbackOptions::isolate` and `FastApiCallbackOptions::data` as a Local are not available
+#       undef JSB_V8_FAST_API_CALLS
+#       define JSB_V8_FAST_API_CALLS 0
+#   endif
 #endif
 
 #include "../../internal/jsb_logger.h"
 #include "../../internal/jsb_macros.h"
+#include "../../internal/jsb_scratch_arena.h"
 
 #include "../shared/jsb_custom_field.h"
+#include "../shared/jsb_latin1.h"
 
 #endif
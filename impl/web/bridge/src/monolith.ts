@@ -24,7 +24,6 @@ interface WasmProtocol {
 }
 
 interface InteropProtocol {
-    gc_callback(engine_opaque: IntPtr, internal_opaque: Pointer): void;
     unhandled_rejection(engine_opaque: IntPtr, cb: FunctionPointer, promise_sp: StackPosition, reason_sp: StackPosition): void;
 
     // is_construct_call: true if it's a constructor call, it's just a shorthand for `new.target !== undefined` on C++ side
@@ -44,6 +43,28 @@ enum jsbb_PropertyFlags {
     VALUE = 1 << 5,
 }
 
+// type tag of the values read by ReadValues (keep sync with jsb::impl::ValueTag)
+enum jsbb_ValueTag {
+    Undefined = 0,
+    Null = 1,
+    False = 2,
+    True = 3,
+    Integer = 4,
+    Number = 5,
+    String = 6,
+    LongString = 7,
+    Object = 8,
+    Other = 9,
+}
+
+// opcodes recorded by jsb::impl::CommandBuffer
+enum jsbb_CommandType {
+    SetProperty = 1,
+    SetPropertyUint32 = 2,
+    DefineProperty = 3,
+    StackExit = 4,
+}
+
 // FinalizationRegistry (ES2021):
 // https://developer.mozilla.org/en-US/docs/Web/JavaScript/Reference/Global_Objects/FinalizationRegistry
 
@@ -262,21 +283,39 @@ class jsbb_Handles {
 
 class jsbb_Registry {
     private _count = 0;
-    private engine_opaque: Pointer;
     private watcher: FinalizationRegistry<FinalizationRegistryCallbackInfo>;
 
+    // the internal data of finalized objects, taken by the isolate in batch (see TakeFinalized) instead of calling into wasm for each of them
+    private _finalized = new Int32Array(256);
+    private _finalized_count = 0;
+
     get count() { return this._count; }
 
-    constructor(engine_opaque: Pointer) {
+    constructor() {
         const self = this;
-        this.engine_opaque = engine_opaque;
         this.watcher = new FinalizationRegistry(function (internal_data) {
             jsbb_console.log("gc.dealloc", internal_data);
             --self._count;
-            _jsbb_.interop.gc_callback(self.engine_opaque, internal_data);
+            if (self._finalized_count === self._finalized.length) {
+                const grown = new Int32Array(self._finalized.length * 2);
+                grown.set(self._finalized);
+                self._finalized = grown;
+            }
+            self._finalized[self._finalized_count++] = internal_data;
         });
     }
 
+    // copy up to `capacity` finalized internal data into `out_ptr` (int32 array), return the number copied
+    TakeFinalized(out_ptr: Pointer, capacity: number): number {
+        const count = Math.min(this._finalized_count, capacity);
+        if (count > 0) {
+            const begin = this._finalized_count - count;
+            _jsbb_.i32.set(this._finalized.subarray(begin, this._finalized_count), out_ptr >> 2);
+            this._finalized_count = begin;
+        }
+        return count;
+    }
+
     Add(obj: any, internal_data: Pointer): void {
         jsbb_console.log("gc.alloc", internal_data);
 
@@ -297,6 +336,28 @@ class jsbb_External {
     }
 }
 
+// the web equivalent of v8::Promise::Resolver
+class jsbb_PromiseResolver {
+    readonly promise: Promise<any>;
+    private _resolve!: (value: any) => void;
+    private _reject!: (reason: any) => void;
+
+    constructor() {
+        this.promise = new Promise((resolve, reject) => {
+            this._resolve = resolve;
+            this._reject = reject;
+        });
+    }
+
+    settle(value: any, rejected: boolean) {
+        if (rejected) {
+            this._reject(value);
+        } else {
+            this._resolve(value);
+        }
+    }
+}
+
 class jsbb_Engine {
     private _id: EngineID;
 
@@ -339,7 +400,7 @@ class jsbb_Engine {
         // this._global = {};
         this._stack = new jsbb_Stack();
         this._handles = new jsbb_Handles();
-        this._registry = new jsbb_Registry(opaque);
+        this._registry = new jsbb_Registry();
 
         // init all commonly used string here
         this._atoms = new Array(3);
@@ -368,6 +429,10 @@ class jsbb_Engine {
         _jsbb_.i32[offset + 2] = this._registry.count;
     }
 
+    TakeFinalized(out_ptr: Pointer, capacity: number): number {
+        return this._registry.TakeFinalized(out_ptr, capacity);
+    }
+
     Release() {
         // this._global = <any>undefined;
         this._handles = <any>undefined;
@@ -506,6 +571,55 @@ class jsbb_Engine {
         return this._stack.Push(String(val));
     }
 
+    /**
+     * read the values of [first_sp, first_sp + count) into the records at `out` (see jsb::impl::ValueRecord, 16 bytes for each),
+     * the content of strings are copied as utf-16 into the space following the records.
+     * @returns the number of values read
+     */
+    ReadValues(first_sp: StackPosition, count: number, out: Pointer, out_size: number): number {
+        const i32 = _jsbb_.i32;
+        const f64 = _jsbb_.f64;
+        const u16 = _jsbb_.u16;
+        const string_base = (out >> 1) + count * 8;
+        const string_end = (out + out_size) >> 1;
+        let string_pos = string_base;
+
+        for (let i = 0; i < count; ++i) {
+            const val = this._stack.GetValue(first_sp + i);
+            const p = (out >> 2) + i * 4;
+            let tag: jsbb_ValueTag;
+
+            switch (typeof val) {
+                case "undefined": tag = jsbb_ValueTag.Undefined; break;
+                case "boolean": tag = val ? jsbb_ValueTag.True : jsbb_ValueTag.False; break;
+                case "number":
+                    tag = Number.isInteger(val) ? jsbb_ValueTag.Integer : jsbb_ValueTag.Number;
+                    f64[(p + 2) >> 1] = val;
+                    break;
+                case "string": {
+                    const len = val.length;
+                    i32[p + 1] = len;
+                    if (string_pos + len <= string_end) {
+                        for (let j = 0; j < len; ++j) {
+                            u16[string_pos + j] = val.charCodeAt(j);
+                        }
+                        i32[p + 2] = string_pos - string_base;
+                        string_pos += len;
+                        tag = jsbb_ValueTag.String;
+                    } else {
+                        tag = jsbb_ValueTag.LongString;
+                    }
+                    break;
+                }
+                case "object": tag = val === null ? jsbb_ValueTag.Null : jsbb_ValueTag.Object; break;
+                case "function": tag = jsbb_ValueTag.Object; break;
+                default: tag = jsbb_ValueTag.Other; break;
+            }
+            i32[p] = tag;
+        }
+        return count;
+    }
+
     NumberValue(stack_pos: StackPosition): number {
         const val = this._stack.GetValue(stack_pos);
         return Number(val);
@@ -537,6 +651,42 @@ class jsbb_Engine {
         return this._stack.Push(this._stack.GetValue(stack_pos));
     }
 
+    /**
+     * execute the commands recorded in wasm memory in a single call.
+     * NOTE: the heap view is fetched for each command, since the wasm memory may grow if any setter calls back into native.
+     * @returns the number of failed commands, or -1 if an unknown command is met
+     */
+    Flush(cmds: Pointer, len: number): number {
+        let p = cmds >> 2;
+        const end = p + len;
+        let failed = 0;
+        while (p < end) {
+            const i32 = _jsbb_.i32;
+            switch (i32[p]) {
+                case jsbb_CommandType.SetProperty:
+                    if (this.SetProperty(i32[p + 1], i32[p + 2], i32[p + 3]) < 0) ++failed;
+                    p += 4;
+                    break;
+                case jsbb_CommandType.SetPropertyUint32:
+                    if (this.SetPropertyUint32(i32[p + 1], i32[p + 2] >>> 0, i32[p + 3]) < 0) ++failed;
+                    p += 4;
+                    break;
+                case jsbb_CommandType.DefineProperty:
+                    if (this.DefineProperty(i32[p + 1], i32[p + 2], i32[p + 3], i32[p + 4], i32[p + 5], i32[p + 6]) < 0) ++failed;
+                    p += 7;
+                    break;
+                case jsbb_CommandType.StackExit:
+                    this._stack.ExitScope();
+                    p += 1;
+                    break;
+                default:
+                    jsbb_console.error("invalid command", i32[p], "at", p - (cmds >> 2));
+                    return -1;
+            }
+        }
+        return failed;
+    }
+
     StackSet(to_sp: StackPosition, from_sp: StackPosition): void {
         this._stack.SetValue(to_sp, this._stack.GetValue(from_sp));
     }
@@ -1177,6 +1327,24 @@ class jsbb_Engine {
         return this._stack.Push({});
     }
 
+    NewPromiseResolver(): StackPosition {
+        return this._stack.Push(new jsbb_PromiseResolver());
+    }
+
+    GetResolverPromise(resolver_sp: StackPosition): StackPosition {
+        return this._stack.Push((<jsbb_PromiseResolver>this._stack.GetValue(resolver_sp)).promise);
+    }
+
+    SettlePromise(resolver_sp: StackPosition, value_sp: StackPosition, rejected: boolean): ResultValue {
+        try {
+            (<jsbb_PromiseResolver>this._stack.GetValue(resolver_sp)).settle(this._stack.GetValue(value_sp), !!rejected);
+            return 1;
+        } catch (err) {
+            this._throw_trivial(err);
+            return -1;
+        }
+    }
+
     SetConstructor(func_sp: StackPosition, proto_sp: StackPosition): ResultValue {
         try {
             const p = this._stack.GetValue(proto_sp);
@@ -1214,6 +1382,10 @@ class _jsbb_ {
     static interop: InteropProtocol;
     static wasmop: WasmProtocol;
     static engine: jsbb_Engine | undefined;
+
+    // shortcuts of the only engine for the library functions (jsbi_*), the engine_id parameter is not looked up in them
+    static stack: jsbb_Stack<any> | undefined;
+    static handles: jsbb_Handles | undefined;
     private static _i64: BigInt64Array;
 
     static get u8(): Uint8Array {
@@ -1229,6 +1401,19 @@ class _jsbb_ {
         return HEAP32;
     }
 
+    static get u16(): Uint16Array {
+        if (wasmMemory.buffer != HEAP8.buffer) {
+            updateMemoryViews();
+        }
+        return HEAPU16;
+    }
+    static get f64(): Float64Array {
+        if (wasmMemory.buffer != HEAP8.buffer) {
+            updateMemoryViews();
+        }
+        return HEAPF64;
+    }
+
     //TODO may not be supported?
     static get i64(): BigInt64Array {
         if (wasmMemory.buffer != HEAP8.buffer) {
@@ -1248,7 +1433,6 @@ class _jsbb_ {
         }
         try {
             this.interop = {
-                gc_callback: GodotRuntime.get_func(interop.gc_callback),
                 unhandled_rejection: GodotRuntime.get_func(interop.unhandled_rejection),
                 call_function: GodotRuntime.get_func(interop.call_function),
                 call_accessor: GodotRuntime.get_func(interop.call_accessor),
@@ -1278,6 +1462,8 @@ class _jsbb_ {
         // currectly, engine_id is hardcoded.
         // only one single engine is supported to new simultaneously
         this.engine = new jsbb_Engine(0, opaque);
+        this.stack = this.engine.stack;
+        this.handles = this.engine.handles;
         return 0;
     }
 
@@ -1288,6 +1474,8 @@ class _jsbb_ {
         }
         this.engine!.Release();
         this.engine = undefined;
+        this.stack = undefined;
+        this.handles = undefined;
     }
 
     static GetEngine(engine_id: EngineID) {
@@ -1339,6 +1527,8 @@ declare const wasmMemory: WebAssembly.Memory;
 declare const HEAP8: Int8Array;
 declare const HEAPU8: Uint8Array;
 declare const HEAP32: Int32Array;
+declare const HEAPU16: Uint16Array;
+declare const HEAPF64: Float64Array;
 declare const global: any;
 declare const UTF8ToString: Function;
 
@@ -0,0 +1,28 @@
+#include "jsb_web_argument_cache.h"
+
+namespace jsb::impl
+{
+    void ArgumentCache::load(JSRuntime rt)
+    {
+        const int size = count_ * (int) sizeof(ValueRecord) + kStringCapacity * (int) sizeof(char16_t);
+        if ((int) (scratch_.size() * sizeof(uint64_t)) < size)
+        {
+            scratch_.resize((size + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+        }
+        const int read = jsbi_ReadValues(rt, first_sp_, count_, scratch_.ptr(), (int) (scratch_.size() * sizeof(uint64_t)));
+        jsb_unused(read);
+        jsb_check(read == count_);
+        loaded_ = true;
+    }
+
+    String ArgumentCache::get_string(const ValueRecord& p_record) const
+    {
+        jsb_check(p_record.tag == ValueTag::String);
+        if (p_record.length == 0)
+        {
+            return String();
+        }
+        const char16_t* strings = (const char16_t*) ((const ValueRecord*) scratch_.ptr() + count_);
+        return String::utf16(strings + p_record.offset, p_record.length);
+    }
+}
@@ -0,0 +1,113 @@
+#ifndef GODOTJS_WEB_ARGUMENT_CACHE_H
+#define GODOTJS_WEB_ARGUMENT_CACHE_H
+#include "jsb_web_pch.h"
+#include "jsb_web_typedef.h"
+
+namespace jsb::impl
+{
+    // a value read by jsbi_ReadValues
+    //NOTE be cautious to always keep sync with ReadValues in monolith.ts
+    struct ValueRecord
+    {
+        int32_t tag;        // ValueTag
+        int32_t length;     // length of string (in utf-16 code units)
+        union
+        {
+            double number;
+            int32_t offset; // offset of the string content in the string space (in utf-16 code units)
+        };
+
+        jsb_force_inline bool is_number() const { return tag == ValueTag::Integer || tag == ValueTag::Number; }
+        jsb_force_inline bool is_string() const { return tag == ValueTag::String || tag == ValueTag::LongString; }
+        jsb_force_inline bool is_boolean() const { return tag == ValueTag::False || tag == ValueTag::True; }
+        jsb_force_inline bool is_null_or_undefined() const { return tag == ValueTag::Null || tag == ValueTag::Undefined; }
+
+        // same as `_jsbb_.is_object` (null is considered as an object)
+        jsb_force_inline bool is_object() const { return tag == ValueTag::Object || tag == ValueTag::Null; }
+
+        // Number(val) | 0, only available if the value is an integer in the range of int32
+        jsb_force_inline bool get_int32(int32_t& r_value) const
+        {
+            if (tag != ValueTag::Integer || number < (double) INT32_MIN || number > (double) INT32_MAX) return false;
+            r_value = (int32_t) number;
+            return true;
+        }
+
+        // Boolean(val), not available for symbol and bigint
+        jsb_force_inline bool get_boolean(bool& r_value) const
+        {
+            switch (tag)
+            {
+            case ValueTag::Undefined: case ValueTag::Null: case ValueTag::False: r_value = false; return true;
+            case ValueTag::True: case ValueTag::Object: r_value = true; return true;
+            case ValueTag::Integer: case ValueTag::Number: r_value = number != 0 && !Math::is_nan(number); return true;
+            case ValueTag::String: case ValueTag::LongString: r_value = length != 0; return true;
+            default: return false;
+            }
+        }
+    };
+    static_assert(sizeof(ValueRecord) == 16);
+
+    /**
+     * The arguments of the native function being called.
+     * They're read into a scratch space in wasm memory by a single jsbi_ReadValues call on the first query,
+     * so that the type checks and primitive conversions of arguments don't cross the wasm/js boundary one by one.
+     * The arguments on stack are immutable until the function returns.
+     */
+    class ArgumentCache
+    {
+        // capacity of the string space (in utf-16 code units)
+        static constexpr int kStringCapacity = 4096;
+
+    public:
+        struct Frame
+        {
+            StackPosition first_sp;
+            int count;
+        };
+
+    private:
+        StackPosition first_sp_ = 0;
+        int count_ = 0;
+        bool loaded_ = false;
+
+        // ValueRecord * count_, string space (uint64_t for the alignment of doubles)
+        LocalVector<uint64_t> scratch_;
+
+    public:
+        // start caching the arguments of a function call, return the previous frame to restore on exit
+        jsb_force_inline Frame enter(StackPosition p_first_sp, int p_count)
+        {
+            const Frame last = { first_sp_, count_ };
+            first_sp_ = p_first_sp;
+            count_ = p_count;
+            loaded_ = false;
+            return last;
+        }
+
+        // the scratch space may have been overwritten by the inner call, read again if queried
+        jsb_force_inline void exit(const Frame& p_last)
+        {
+            first_sp_ = p_last.first_sp;
+            count_ = p_last.count;
+            loaded_ = false;
+        }
+
+        // null if the stack position is not an argument of current function call
+        jsb_force_inline const ValueRecord* find(JSRuntime rt, StackPosition p_sp)
+        {
+            const int index = p_sp - first_sp_;
+            if (index < 0 || index >= count_) return nullptr;
+            if (!loaded_) load(rt);
+            return (const ValueRecord*) scratch_.ptr() + index;
+        }
+
+        // (only for ValueTag::String)
+        String get_string(const ValueRecord& p_record) const;
+
+    private:
+        void load(JSRuntime rt);
+    };
+}
+
+#endif
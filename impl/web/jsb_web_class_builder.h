@@ -52,10 +52,11 @@ namespace jsb::impl
                 const v8::Local<v8::Name> key = Helper::new_string(builder_->isolate_, name);
                 const v8::Local<v8::Value> value = impl_private::Data<int64_t>::New(builder_->isolate_, data);
 
-                enumeration_->Set(builder_->GetContext(), key, value);
+                jsb::impl::CommandBuffer& command_buffer = builder_->isolate_->command_buffer();
+                command_buffer.set_property(enumeration_->stack_pos_, key->stack_pos_, value->stack_pos_);
 
                 // represents the value back to string for convenient uses, such as MyColor[MyColor.White] => 'White'
-                jsbi_SetProperty(builder_->isolate_->rt(), enumeration_->stack_pos_, value->stack_pos_, key->stack_pos_);
+                command_buffer.set_property(enumeration_->stack_pos_, value->stack_pos_, key->stack_pos_);
                 // jsbi_DefineProperty(builder_->isolate_->rt(), enumeration_->stack_pos_,
                 //     value->stack_pos_, // value as key
                 //     key->stack_pos_,   // key as value
@@ -88,8 +89,7 @@ namespace jsb::impl
                 const v8::Local<v8::Name> key = Helper::new_string(builder_->isolate_, name);
                 const v8::Local<v8::FunctionTemplate> value = JSB_NEW_FUNCTION_TEMPLATE(builder_->isolate_, name, callback, {});
 
-                if (is_instance_method) builder_->prototype_template_->Set(builder_->GetContext(), key, value);
-                else builder_->template_->Set(builder_->GetContext(), key, value);
+                builder_->RecordValue(is_instance_method, key->stack_pos_, value->stack_pos_);
             }
 
             void Method(const String& name, const v8::FunctionCallback callback)
@@ -100,8 +100,7 @@ namespace jsb::impl
                 const v8::Local<v8::Name> key = Helper::new_string(builder_->isolate_, name);
                 const v8::Local<v8::FunctionTemplate> value = JSB_NEW_FUNCTION_TEMPLATE(builder_->isolate_, name, callback, {});
 
-                if (is_instance_method) builder_->prototype_template_->Set(builder_->GetContext(), key, value);
-                else builder_->template_->Set(builder_->GetContext(), key, value);
+                builder_->RecordValue(is_instance_method, key->stack_pos_, value->stack_pos_);
             }
 
             template<typename T>
@@ -113,8 +112,7 @@ namespace jsb::impl
                 const v8::Local<v8::Name> key = Helper::new_string(builder_->isolate_, name);
                 const v8::Local<v8::FunctionTemplate> value = JSB_NEW_FUNCTION_TEMPLATE(builder_->isolate_, name, callback, impl_private::Data<T>::New(builder_->isolate_, data));
 
-                if (is_instance_method) builder_->prototype_template_->Set(builder_->GetContext(), key, value);
-                else builder_->template_->Set(builder_->GetContext(), key, value);
+                builder_->RecordValue(is_instance_method, key->stack_pos_, value->stack_pos_);
             }
 
             // getter/setter with common data payload
@@ -133,8 +131,7 @@ namespace jsb::impl
                     ? JSB_NEW_FUNCTION_TEMPLATE(builder_->isolate_, name, setter_cb, payload)
                     : v8::Local<v8::FunctionTemplate>();;
 
-                if (is_instance_method) builder_->prototype_template_->SetAccessorProperty(key, getter, setter);
-                else builder_->template_->SetAccessorProperty(key, getter, setter);
+                builder_->RecordAccessor(is_instance_method, key, getter, setter);
             }
 
             template<typename GetterDataT, typename SetterDataT>
@@ -151,8 +148,7 @@ namespace jsb::impl
                     ? JSB_NEW_FUNCTION_TEMPLATE(builder_->isolate_, name, setter_cb, impl_private::Data<SetterDataT>::New(builder_->isolate_, setter_data))
                     : v8::Local<v8::FunctionTemplate>();
 
-                if (is_instance_method) builder_->prototype_template_->SetAccessorProperty(key, getter, setter);
-                else builder_->template_->SetAccessorProperty(key, getter, setter);
+                builder_->RecordAccessor(is_instance_method, key, getter, setter);
             }
 
             template<typename GetterDataT>
@@ -166,8 +162,7 @@ namespace jsb::impl
                     ? JSB_NEW_FUNCTION_TEMPLATE(builder_->isolate_, name, getter_cb, impl_private::Data<GetterDataT>::New(builder_->isolate_, getter_data))
                     : v8::Local<v8::FunctionTemplate>();
 
-                if (is_instance_method) builder_->prototype_template_->SetAccessorProperty(key, getter);
-                else builder_->template_->SetAccessorProperty(key, getter);
+                builder_->RecordAccessor(is_instance_method, key, getter, {});
             }
 
             void LazyProperty(const String& name, const v8::AccessorNameGetterCallback getter)
@@ -188,8 +183,7 @@ namespace jsb::impl
                 v8::HandleScope handle_scope(builder_->isolate_);
 
                 const v8::Local<v8::Value> value = impl_private::Data<T>::New(builder_->isolate_, val);
-                if (is_instance_method) builder_->prototype_template_->Set(builder_->GetContext(), key, value);
-                else builder_->template_->Set(builder_->GetContext(), key, value);
+                builder_->RecordValue(is_instance_method, key->stack_pos_, value->stack_pos_);
             }
 
             // generic set
@@ -202,8 +196,7 @@ namespace jsb::impl
                 const v8::Local<v8::Name> key = Helper::new_string(builder_->isolate_, name);
                 const v8::Local<v8::Value> value = impl_private::Data<T>::New(builder_->isolate_, val);
 
-                if (is_instance_method) builder_->prototype_template_->Set(builder_->GetContext(), key, value);
-                else builder_->template_->Set(builder_->GetContext(), key, value);
+                builder_->RecordValue(is_instance_method, key->stack_pos_, value->stack_pos_);
             }
 
         private:
@@ -231,6 +224,7 @@ namespace jsb::impl
         {
             jsb_checkf(!closed_, "class builder is already closed");
             closed_ = true;
+            isolate_->command_buffer().flush(isolate_->rt());
             jsb_ensure(jsbi_SetConstructor(isolate_->rt(), template_->stack_pos_, prototype_template_->stack_pos_) != -1);
             return Class(isolate_, prototype_template_, template_);
         }
@@ -267,6 +261,28 @@ namespace jsb::impl
             return isolate_->GetCurrentContext();
         }
 
+        // members are recorded into the command buffer and defined along with the exit of the HandleScope of the declaration
+        void RecordValue(bool is_instance_member, jsb::impl::StackPosition key_sp, jsb::impl::StackPosition value_sp)
+        {
+            const jsb::impl::StackPosition target_sp = is_instance_member ? prototype_template_->stack_pos_ : template_->stack_pos_;
+            isolate_->command_buffer().set_property(target_sp, key_sp, value_sp);
+        }
+
+        // same as Object::SetAccessorProperty
+        void RecordAccessor(bool is_instance_member, const v8::Local<v8::Name> key, const v8::Local<v8::FunctionTemplate> getter, const v8::Local<v8::FunctionTemplate> setter)
+        {
+            int flags = jsb::impl::PropertyFlags::ENUMERABLE | jsb::impl::PropertyFlags::CONFIGURABLE;
+            if (!getter.IsEmpty()) flags |= jsb::impl::PropertyFlags::GET;
+            if (!setter.IsEmpty()) flags |= jsb::impl::PropertyFlags::SET;
+
+            const jsb::impl::StackPosition target_sp = is_instance_member ? prototype_template_->stack_pos_ : template_->stack_pos_;
+            isolate_->command_buffer().define_property(target_sp, key->stack_pos_,
+                /* value */ jsb::impl::StackBase::Undefined,
+                (jsb::impl::StackPosition) getter,
+                (jsb::impl::StackPosition) setter,
+                flags);
+        }
+
         ClassBuilder() {}
     };
 
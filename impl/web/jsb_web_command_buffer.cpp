@@ -0,0 +1,26 @@
+#include "jsb_web_command_buffer.h"
+
+namespace jsb::impl
+{
+    bool CommandBuffer::flush(JSRuntime rt)
+    {
+        if (words_.is_empty())
+        {
+            return true;
+        }
+
+        // move out the recorded commands in case of new commands recorded (by any setter calling back into native) while flushing
+        LocalVector<int32_t> words;
+        SWAP(words, words_);
+        const int failed = jsbi_Flush(rt, words.ptr(), (int) words.size());
+        jsb_checkf(failed >= 0, "malformed command buffer");
+
+        // reuse the allocated memory
+        if (words_.is_empty())
+        {
+            words.clear();
+            SWAP(words, words_);
+        }
+        return failed == 0;
+    }
+}
@@ -0,0 +1,55 @@
+#ifndef GODOTJS_WEB_COMMAND_BUFFER_H
+#define GODOTJS_WEB_COMMAND_BUFFER_H
+#include "jsb_web_pch.h"
+
+namespace jsb::impl
+{
+    /**
+     * Commands recorded into a linear buffer in wasm memory and executed by a single jsbi_Flush call,
+     * instead of crossing the wasm/js boundary for each of them.
+     * Only the commands without an observable result can be recorded (think twice before recording anything else),
+     * and the buffer must be flushed before the stack positions referenced by the commands are released.
+     */
+    class CommandBuffer
+    {
+        LocalVector<int32_t> words_;
+
+    public:
+        jsb_force_inline bool is_empty() const { return words_.is_empty(); }
+
+        void set_property(StackPosition obj_sp, StackPosition key_sp, StackPosition value_sp)
+        {
+            push(CommandType::SetProperty, obj_sp, key_sp, value_sp);
+        }
+
+        void set_property_uint32(StackPosition obj_sp, uint32_t index, StackPosition value_sp)
+        {
+            push(CommandType::SetPropertyUint32, obj_sp, (int32_t) index, value_sp);
+        }
+
+        void define_property(StackPosition obj_sp, StackPosition key_sp, StackPosition value_sp, StackPosition get_sp, StackPosition set_sp, int flags)
+        {
+            push(CommandType::DefineProperty, obj_sp, key_sp, value_sp, get_sp, set_sp, flags);
+        }
+
+        void stack_exit()
+        {
+            push(CommandType::StackExit);
+        }
+
+        /**
+         * execute all recorded commands
+         * \return false if any command failed (the errors are reported by the runtime)
+         */
+        bool flush(JSRuntime rt);
+
+    private:
+        template<typename... TArgs>
+        jsb_force_inline void push(TArgs... p_words)
+        {
+            (words_.push_back((int32_t) p_words), ...);
+        }
+    };
+}
+
+#endif
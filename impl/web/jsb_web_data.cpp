@@ -11,89 +11,113 @@ namespace v8
 
     bool Data::IsNullOrUndefined() const
     {
+        if (const jsb::impl::ValueRecord* record = isolate_->read_argument(stack_pos_)) return record->is_null_or_undefined();
         return jsbi_IsNullOrUndefined(isolate_->rt(), stack_pos_);
     }
 
     bool Data::IsNull() const
     {
+        if (const jsb::impl::ValueRecord* record = isolate_->read_argument(stack_pos_)) return record->tag == jsb::impl::ValueTag::Null;
         return jsbi_IsNull(isolate_->rt(), stack_pos_);
     }
 
     bool Data::IsUndefined() const
     {
+        if (const jsb::impl::ValueRecord* record = isolate_->read_argument(stack_pos_)) return record->tag == jsb::impl::ValueTag::Undefined;
         return jsbi_IsUndefined(isolate_->rt(), stack_pos_);
     }
 
     bool Data::IsObject() const
     {
+        if (const jsb::impl::ValueRecord* record = isolate_->read_argument(stack_pos_)) return record->is_object();
         return jsbi_IsObject(isolate_->rt(), stack_pos_);
     }
 
     bool Data::IsPromise() const
     {
+        if (const jsb::impl::ValueRecord* record = isolate_->read_argument(stack_pos_); record && record->tag != jsb::impl::ValueTag::Object) return false;
         return jsbi_IsPromise(isolate_->rt(), stack_pos_);
     }
 
     bool Data::IsArray() const
     {
+        if (const jsb::impl::ValueRecord* record = isolate_->read_argument(stack_pos_); record && record->tag != jsb::impl::ValueTag::Object) return false;
         return jsbi_IsArray(isolate_->rt(), stack_pos_);
     }
 
     bool Data::IsMap() const
     {
+        if (const jsb::impl::ValueRecord* record = isolate_->read_argument(stack_pos_); record && record->tag != jsb::impl::ValueTag::Object) return false;
         return jsbi_IsMap(isolate_->rt(), stack_pos_);
     }
 
     bool Data::IsSymbol() const
     {
+        if (const jsb::impl::ValueRecord* record = isolate_->read_argument(stack_pos_); record && record->tag != jsb::impl::ValueTag::Other) return false;
         return jsbi_IsSymbol(isolate_->rt(), stack_pos_);
     }
 
     bool Data::IsString() const
     {
+        if (const jsb::impl::ValueRecord* record = isolate_->read_argument(stack_pos_)) return record->is_string();
         return jsbi_IsString(isolate_->rt(), stack_pos_);
     }
 
     bool Data::IsFunction() const
     {
+        if (const jsb::impl::ValueRecord* record = isolate_->read_argument(stack_pos_); record && record->tag != jsb::impl::ValueTag::Object) return false;
         return jsbi_IsFunction(isolate_->rt(), stack_pos_);
     }
 
     bool Data::IsInt32() const
     {
+        if (const jsb::impl::ValueRecord* record = isolate_->read_argument(stack_pos_)) return record->tag == jsb::impl::ValueTag::Integer;
         return jsbi_IsInt32(isolate_->rt(), stack_pos_);
     }
 
     bool Data::IsUint32() const
     {
+        if (const jsb::impl::ValueRecord* record = isolate_->read_argument(stack_pos_)) return record->tag == jsb::impl::ValueTag::Integer;
         return jsbi_IsUint32(isolate_->rt(), stack_pos_);
     }
 
     bool Data::IsNumber() const
     {
+        if (const jsb::impl::ValueRecord* record = isolate_->read_argument(stack_pos_)) return record->is_number();
         return jsbi_IsNumber(isolate_->rt(), stack_pos_);
     }
 
     bool Data::IsExternal() const
     {
+        if (const jsb::impl::ValueRecord* record = isolate_->read_argument(stack_pos_); record && record->tag != jsb::impl::ValueTag::Object) return false;
         return jsbi_IsExternal(isolate_->rt(), stack_pos_);
     }
 
     bool Data::IsBoolean() const
     {
+        if (const jsb::impl::ValueRecord* record = isolate_->read_argument(stack_pos_)) return record->is_boolean();
         return jsbi_IsBoolean(isolate_->rt(), stack_pos_);
     }
 
     bool Data::IsBigInt() const
     {
+        if (const jsb::impl::ValueRecord* record = isolate_->read_argument(stack_pos_); record && record->tag != jsb::impl::ValueTag::Other) return false;
         return jsbi_IsBigInt(isolate_->rt(), stack_pos_);
     }
 
     bool Data::IsArrayBuffer() const
     {
+        if (const jsb::impl::ValueRecord* record = isolate_->read_argument(stack_pos_); record && record->tag != jsb::impl::ValueTag::Object) return false;
         return jsbi_IsArrayBuffer(isolate_->rt(), stack_pos_);
     }
 
+    bool Data::IsProxy() const
+    {
+        if (!IsObject()) return false;
+        const jsb::impl::InternalDataID index = (jsb::impl::InternalDataID)(uintptr_t) jsbi_GetOpaque(isolate_->rt(), stack_pos_);
+        return !index || isolate_->get_internal_data(index)->internal_field_count == 0;
+    }
+
     bool Data::strict_eq(const Data& other) const
     {
         return jsbi_stack_eq(isolate_->rt(), stack_pos_, other.stack_pos_);
@@ -42,6 +42,10 @@ namespace v8
         bool IsExternal() const;
         bool IsArrayBuffer() const;
 
+        // conservative: true for any object without internal fields (no Proxy detection across the bridge),
+        // objects bound to native (godot objects, variants) are never reported.
+        bool IsProxy() const;
+
     private:
         bool strict_eq(const Data& other) const;
     };
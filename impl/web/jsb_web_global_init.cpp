@@ -25,28 +25,12 @@ JSNATIVE_API EMSCRIPTEN_KEEPALIVE void jsni_unhandled_rejection(v8::Isolate* iso
     cb(message);
 }
 
-JSNATIVE_API EMSCRIPTEN_KEEPALIVE void jsni_gc_callback(v8::Isolate* isolate, void* ptr)
-{
-    const jsb::impl::InternalDataID index = (jsb::impl::InternalDataID)(uintptr_t) ptr;
-    {
-        jsb::impl::InternalData* data;
-        if (isolate->internal_data_.try_get_value_pointer(index, data))
-        {
-            if (const v8::WeakCallbackInfo<void>::Callback callback = (v8::WeakCallbackInfo<void>::Callback) data->weak.callback)
-            {
-                const v8::WeakCallbackInfo<void> info(isolate, data->weak.parameter, data->internal_fields);
-                callback(info);
-            }
-            JSB_WEB_LOG(VeryVerbose, "remove internal data id:%s", index);
-            isolate->internal_data_.remove_at(index);
-        }
-    }
-}
-
 JSNATIVE_API EMSCRIPTEN_KEEPALIVE void jsni_call_function(v8::Isolate* isolate, v8::FunctionCallback cb, bool is_construct_call, jsb::impl::StackPosition stack_base, int argc)
 {
     v8::FunctionCallbackInfo<v8::Value> callback_info(isolate, is_construct_call, stack_base, argc);
+    const jsb::impl::ArgumentCache::Frame last = isolate->argument_cache().enter(stack_base + jsb::impl::FunctionStackBase::_Num, argc);
     cb(callback_info);
+    isolate->argument_cache().exit(last);
 }
 
 JSNATIVE_API EMSCRIPTEN_KEEPALIVE void jsni_call_accessor(v8::Isolate* isolate, v8::AccessorNameGetterCallback cb, jsb::impl::StackPosition key_sp, jsb::impl::StackPosition rval_sp)
@@ -91,7 +75,6 @@ namespace jsb::impl
     {
         internal::Logger::set_callbacks(_custom_print_verbose, _custom_print_line, _custom_print_error);
         jsbi_init(
-            JSNI_FUNC(gc_callback),
             JSNI_FUNC(unhandled_rejection),
             JSNI_FUNC(call_function),
             JSNI_FUNC(call_accessor),
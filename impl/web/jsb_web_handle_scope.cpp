@@ -10,7 +10,19 @@ namespace v8
 
     HandleScope::~HandleScope()
     {
-        jsbi_StackExit(isolate_->rt());
+        jsb::impl::CommandBuffer& command_buffer = isolate_->command_buffer();
+        if (command_buffer.is_empty())
+        {
+            jsbi_StackExit(isolate_->rt());
+            return;
+        }
+
+        // exit the scope along with the recorded commands in a single call
+        command_buffer.stack_exit();
+        if (!command_buffer.flush(isolate_->rt()))
+        {
+            JSB_WEB_LOG(Error, "failed to execute the recorded commands");
+        }
     }
 
 }
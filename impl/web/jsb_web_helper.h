@@ -30,17 +30,29 @@ namespace jsb::impl
         }
 
         static PackedByteArray to_packed_byte_array(v8::Isolate* isolate, const v8::Local<v8::ArrayBuffer>& array_buffer)
+        {
+            PackedByteArray packed;
+            const bool succeeded = to_packed_array(isolate, array_buffer, packed);
+            jsb_unused(succeeded);
+            jsb_check(succeeded);
+            return packed;
+        }
+
+        // copy the content of an ArrayBuffer into a packed array (the byte length must be a multiple of the element size)
+        template<typename T>
+        static bool to_packed_array(v8::Isolate* isolate, const v8::Local<v8::ArrayBuffer>& array_buffer, Vector<T>& r_packed)
         {
             const int size = jsbi_GetByteLength(isolate->rt(), array_buffer->stack_pos_);
             jsb_check(size >= 0);
-            if (size == 0) return {};
+            if (size % (int) sizeof(T) != 0) return false;
+            r_packed.clear();
+            if (size == 0) return true;
 
-            PackedByteArray packed;
-            const Error err = packed.resize(size);
+            const Error err = r_packed.resize(size / (int) sizeof(T));
             jsb_unused(err);
             jsb_check(err == OK);
-            jsbi_ReadArrayBufferData(isolate->rt(), array_buffer->stack_pos_, size, packed.ptrw());
-            return packed;
+            jsbi_ReadArrayBufferData(isolate->rt(), array_buffer->stack_pos_, size, r_packed.ptrw());
+            return true;
         }
 
         //TODO copy from HEAP?
@@ -49,6 +61,13 @@ namespace jsb::impl
             return v8::Local<v8::ArrayBuffer>(v8::Data(isolate, jsbi_NewArrayBuffer(isolate->rt(), packed.ptr(), packed.size())));
         }
 
+        // [web.impl] the wasm memory can not be shared with the host JS engine as an external buffer, it's always copied.
+        template<typename T>
+        static v8::Local<v8::ArrayBuffer> to_array_buffer_view(v8::Isolate* isolate, const Vector<T>& packed)
+        {
+            return v8::Local<v8::ArrayBuffer>(v8::Data(isolate, jsbi_NewArrayBuffer(isolate->rt(), (const uint8_t*) packed.ptr(), packed.size() * (int) sizeof(T))));
+        }
+
         static v8::Local<v8::Function> NewFunction(v8::Local<v8::Context> context, const char* name, v8::FunctionCallback callback, v8::Local<v8::Value> data)
         {
             static_assert(sizeof(callback) == sizeof(void*));
@@ -124,6 +143,12 @@ namespace jsb::impl
             String ret;
             if (!p_val.IsEmpty() && !p_val->IsNullOrUndefined())
             {
+                // copied directly from the arguments read in bulk
+                if (const jsb::impl::ValueRecord* record = isolate->read_argument(p_val->stack_pos_); record && record->tag == jsb::impl::ValueTag::String)
+                {
+                    return isolate->argument_cache().get_string(*record);
+                }
+
                 int32_t len;
                 if (char* str = jsbi_ToCStringLen(isolate->rt(), &len, p_val->stack_pos_))
                 {
@@ -158,6 +183,9 @@ namespace jsb::impl
             isolate->throw_error(message);
         }
 
+        // the size of the memory used by the JS heap (in bytes, 0 if not available)
+        jsb_force_inline static size_t get_used_heap_size(v8::Isolate* isolate) { return 0; }
+
         jsb_force_inline static void get_statistics(v8::Isolate* isolate, Vector<CustomField>& p_fields)
         {
             struct
@@ -173,6 +201,11 @@ namespace jsb::impl
             p_fields.append(CustomField::value_i64("registered_object_count", (int64_t) usage.registered_object_count));
         }
 
+        // not available in web
+        jsb_force_inline static void get_heap_summary(v8::Isolate* isolate, Vector<HeapSummaryEntry>& r_entries)
+        {
+        }
+
         jsb_force_inline static bool to_int64(const v8::Local<v8::Value> p_val, int64_t& r_val)
         {
             if (p_val->IsInt32()) { r_val = p_val.As<v8::Int32>()->Value(); return true; }
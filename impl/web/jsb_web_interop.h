@@ -44,11 +44,22 @@ namespace jsb::impl
             VALUE = 1 << 5,
         };
     }
+
+    // opcodes of the commands executed by jsbi_Flush (see CommandBuffer)
+    namespace CommandType
+    {
+        enum : int32_t
+        {
+            SetProperty = 1,        // obj_sp, key_sp, value_sp
+            SetPropertyUint32 = 2,  // obj_sp, index, value_sp
+            DefineProperty = 3,     // obj_sp, key_sp, value_sp, get_sp, set_sp, flags
+            StackExit = 4,
+        };
+    }
 }
 
 // global init
 JSBROWSER_API void jsbi_init(
-    jsb::impl::FunctionPointer gc_callback,
     jsb::impl::FunctionPointer unhandled_rejection,
     jsb::impl::FunctionPointer call_function,
     jsb::impl::FunctionPointer call_accessor,
@@ -63,6 +74,9 @@ JSBROWSER_API void jsbi_free(void* ptr);
 JSBROWSER_API void jsbi_debugbreak();
 JSBROWSER_API void jsbi_GetStatistics(jsb::impl::JSRuntime engine_id, void* ptr);
 
+// take the internal data ids of the objects finalized since the last call (up to `capacity`), return the number written to `out`
+JSBROWSER_API int jsbi_TakeFinalized(jsb::impl::JSRuntime engine_id, int32_t* out, int capacity);
+
 JSBROWSER_API jsb::impl::StackPosition jsbi_CompileFunctionSource(jsb::impl::JSRuntime engine_id, const char* id, const char* source);
 JSBROWSER_API jsb::impl::StackPosition jsbi_Eval(jsb::impl::JSRuntime engine_id, const char* id, const char* source);
 JSBROWSER_API jsb::impl::StackPosition jsbi_Call(jsb::impl::JSRuntime engine_id, jsb::impl::StackPosition this_sp, jsb::impl::StackPosition func_sp, int argc, jsb::impl::StackPosition* argv);
@@ -75,6 +89,8 @@ JSBROWSER_API void jsbi_SetHostPromiseRejectionTracker(jsb::impl::JSRuntime engi
 
 JSBROWSER_API void  jsbi_StackEnter(jsb::impl::JSRuntime engine_id);
 JSBROWSER_API void  jsbi_StackExit(jsb::impl::JSRuntime engine_id);
+// execute `len` words of recorded commands at once, return the number of failed commands (-1 if the buffer is malformed)
+JSBROWSER_API int   jsbi_Flush(jsb::impl::JSRuntime engine_id, const int32_t* cmds, int len);
 JSBROWSER_API void* jsbi_GetOpaque(jsb::impl::JSRuntime engine_id, jsb::impl::StackPosition stack_pos);
 JSBROWSER_API jsb::impl::StackPosition jsbi_GetGlobalObject(jsb::impl::JSRuntime engine_id);
 JSBROWSER_API jsb::impl::StackPosition jsbi_StackDup(jsb::impl::JSRuntime engine_id, jsb::impl::StackPosition stack_pos);
@@ -95,6 +111,9 @@ JSBROWSER_API jsb::impl::StackPosition jsbi_NewObject(jsb::impl::JSRuntime engin
 JSBROWSER_API jsb::impl::StackPosition jsbi_NewClass(jsb::impl::JSRuntime engine_id, jsb::impl::FunctionPointer cb_ptr, jsb::impl::StackPosition data_sp, int field_count, const char* class_name_ptr);
 JSBROWSER_API jsb::impl::StackPosition jsbi_NewInstance(jsb::impl::JSRuntime engine_id, jsb::impl::StackPosition proto_sp);
 JSBROWSER_API jsb::impl::StackPosition jsbi_NewString(jsb::impl::JSRuntime engine_id, const char* str, int len);
+JSBROWSER_API jsb::impl::StackPosition jsbi_NewPromiseResolver(jsb::impl::JSRuntime engine_id);
+JSBROWSER_API jsb::impl::StackPosition jsbi_GetResolverPromise(jsb::impl::JSRuntime engine_id, jsb::impl::StackPosition resolver_sp);
+JSBROWSER_API jsb::impl::ResultValue jsbi_SettlePromise(jsb::impl::JSRuntime engine_id, jsb::impl::StackPosition resolver_sp, jsb::impl::StackPosition value_sp, bool rejected);
 
 JSBROWSER_API jsb::impl::ResultValue jsbi_SetConstructor(jsb::impl::JSRuntime engine_id, jsb::impl::StackPosition func_sp, jsb::impl::StackPosition proto_sp);
 JSBROWSER_API jsb::impl::ResultValue jsbi_SetPrototype(jsb::impl::JSRuntime engine_id, jsb::impl::StackPosition proto_sp, jsb::impl::StackPosition parent_sp);
@@ -123,6 +142,8 @@ JSBROWSER_API int   jsbi_GetArrayLength(jsb::impl::JSRuntime engine_id, jsb::imp
 JSBROWSER_API int   jsbi_GetStringLength(jsb::impl::JSRuntime engine_id, jsb::impl::StackPosition stack_pos);
 JSBROWSER_API char* jsbi_ToCStringLen(jsb::impl::JSRuntime engine_id, int32_t* o_size, jsb::impl::StackPosition str_sp);
 JSBROWSER_API jsb::impl::StackPosition jsbi_ToString(jsb::impl::JSRuntime engine_id, jsb::impl::StackPosition stack_pos);
+// read values [first_sp, first_sp + count) as jsb::impl::ValueRecord (followed by the utf-16 string data) into `out` at once, return the number of values read
+JSBROWSER_API int jsbi_ReadValues(jsb::impl::JSRuntime engine_id, jsb::impl::StackPosition first_sp, int count, void* out, int out_size);
 JSBROWSER_API double jsbi_NumberValue(jsb::impl::JSRuntime engine_id, jsb::impl::StackPosition stack_pos);
 JSBROWSER_API bool   jsbi_BooleanValue(jsb::impl::JSRuntime engine_id, jsb::impl::StackPosition stack_pos);
 JSBROWSER_API int32_t  jsbi_Int32Value(jsb::impl::JSRuntime engine_id, jsb::impl::StackPosition stack_pos);
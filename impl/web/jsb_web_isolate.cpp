@@ -46,6 +46,36 @@ namespace v8
         _remove_reference();
     }
 
+    void Isolate::PerformMicrotaskCheckpoint()
+    {
+        int32_t batch[256];
+        int count;
+        do
+        {
+            count = jsbi_TakeFinalized(rt_, batch, (int) ::std::size(batch));
+            for (int i = 0; i < count; ++i)
+            {
+                _finalize((jsb::impl::InternalDataID)(uintptr_t) batch[i]);
+            }
+        }
+        while (count == (int) ::std::size(batch));
+    }
+
+    void Isolate::_finalize(jsb::impl::InternalDataID index)
+    {
+        jsb::impl::InternalData* data;
+        if (internal_data_.try_get_value_pointer(index, data))
+        {
+            if (const v8::WeakCallbackInfo<void>::Callback callback = (v8::WeakCallbackInfo<void>::Callback) data->weak.callback)
+            {
+                const v8::WeakCallbackInfo<void> info(this, data->weak.parameter, data->internal_fields);
+                callback(info);
+            }
+            JSB_WEB_LOG(VeryVerbose, "remove internal data id:%s", index);
+            internal_data_.remove_at(index);
+        }
+    }
+
     void Isolate::SetData(int index, void* data)
     {
         jsb_check(index == 0);
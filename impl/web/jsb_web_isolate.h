@@ -6,6 +6,8 @@
 #include "jsb_web_handle_scope.h"
 #include "jsb_web_array_buffer.h"
 #include "jsb_web_promise_reject.h"
+#include "jsb_web_command_buffer.h"
+#include "jsb_web_argument_cache.h"
 
 namespace jsb::impl
 {
@@ -76,9 +78,11 @@ namespace v8
 
         void* GetData(int index) const { jsb_check(index == 0); return embedder_data_; }
         void SetData(int index, void* data);
-        void PerformMicrotaskCheckpoint() {}
+        // microtasks are run by the browser, it only processes the objects finalized since the last call
+        void PerformMicrotaskCheckpoint();
         void LowMemoryNotification() {}
         void SetBatterySaverMode(bool) {}
+        void SetAllowAtomicsWait(bool) {}
         void RequestGarbageCollectionForTesting(GarbageCollectionType type) {}
         Local<Context> GetCurrentContext();
 
@@ -92,6 +96,15 @@ namespace v8
 
         jsb_force_inline jsb::impl::JSRuntime rt() const { return rt_; }
 
+        // commands deferred until the exit of current HandleScope
+        jsb_force_inline jsb::impl::CommandBuffer& command_buffer() { return command_buffer_; }
+
+        // the arguments of the native function being called
+        jsb_force_inline jsb::impl::ArgumentCache& argument_cache() { return argument_cache_; }
+
+        // the value at the stack position read in bulk along with the other arguments, null if it's not an argument
+        jsb_force_inline const jsb::impl::ValueRecord* read_argument(jsb::impl::StackPosition stack_pos) { return argument_cache_.find(rt_, stack_pos); }
+
         jsb::impl::InternalDataConstPtr get_internal_data(const jsb::impl::InternalDataID index) const
         {
             return internal_data_.get_value_scoped(index);
@@ -146,10 +159,15 @@ namespace v8
 
         void _release();
 
+        // run the weak callback and remove the internal data of a finalized object
+        void _finalize(jsb::impl::InternalDataID index);
+
         uint32_t ref_count_;
         bool disposed_;
         jsb::impl::JSRuntime rt_;
         HandleScope* handle_scope_;
+        jsb::impl::CommandBuffer command_buffer_;
+        jsb::impl::ArgumentCache argument_cache_;
 
         void* embedder_data_ = nullptr;
         void* context_embedder_data_ = nullptr;
@@ -1,5 +1,6 @@
 #include "jsb_web_object.h"
 #include "jsb_web_isolate.h"
+#include "jsb_web_context.h"
 #include "jsb_web_function_interop.h"
 #include "jsb_web_template.h"
 
@@ -138,6 +139,40 @@ namespace v8
         return MaybeLocal<Value>(Data(isolate_, rval_sp));
     }
 
+    MaybeLocal<Promise::Resolver> Promise::Resolver::New(Local<Context> context)
+    {
+        Isolate* isolate = context->isolate_;
+        const jsb::impl::StackPosition resolver_sp = jsbi_NewPromiseResolver(isolate->rt());
+        if (resolver_sp == jsb::impl::StackBase::Error)
+        {
+            return MaybeLocal<Resolver>();
+        }
+        return MaybeLocal<Resolver>(Data(isolate, resolver_sp));
+    }
+
+    Local<Promise> Promise::Resolver::GetPromise()
+    {
+        return Local<Promise>(Data(isolate_, jsbi_GetResolverPromise(isolate_->rt(), stack_pos_)));
+    }
+
+    Maybe<bool> Promise::Resolver::Resolve(Local<Context> context, Local<Value> value)
+    {
+        if (jsbi_SettlePromise(isolate_->rt(), stack_pos_, value->stack_pos_, false) < 0)
+        {
+            return Maybe<bool>();
+        }
+        return Maybe<bool>(true);
+    }
+
+    Maybe<bool> Promise::Resolver::Reject(Local<Context> context, Local<Value> value)
+    {
+        if (jsbi_SettlePromise(isolate_->rt(), stack_pos_, value->stack_pos_, true) < 0)
+        {
+            return Maybe<bool>();
+        }
+        return Maybe<bool>(true);
+    }
+
     Local<Object> Object::New(Isolate* isolate)
     {
         return Local<Object>(Data(isolate, jsbi_NewObject(isolate->rt())));
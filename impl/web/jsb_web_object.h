@@ -56,6 +56,17 @@ namespace v8
     class Promise : public Object
     {
     public:
+        // a settle-once pair of resolve/reject functions with the promise they settle (held by the bridge)
+        class Resolver : public Object
+        {
+        public:
+            static MaybeLocal<Resolver> New(Local<Context> context);
+
+            Local<Promise> GetPromise();
+
+            Maybe<bool> Resolve(Local<Context> context, Local<Value> value);
+            Maybe<bool> Reject(Local<Context> context, Local<Value> value);
+        };
     };
 
 }
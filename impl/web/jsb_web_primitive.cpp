@@ -22,16 +22,25 @@ namespace v8
 
     Maybe<int32_t> Value::Int32Value(Local<Context> context) const
     {
+        if (const jsb::impl::ValueRecord* record = isolate_->read_argument(stack_pos_))
+        {
+            if (int32_t value; record->get_int32(value)) return Maybe<int32_t>(value);
+        }
         return Maybe<int32_t>(jsbi_Int32Value(isolate_->rt(), stack_pos_));
     }
 
     bool Value::BooleanValue(Isolate* isolate) const
     {
+        if (const jsb::impl::ValueRecord* record = isolate_->read_argument(stack_pos_))
+        {
+            if (bool value; record->get_boolean(value)) return value;
+        }
         return jsbi_BooleanValue(isolate_->rt(), stack_pos_);
     }
 
     Maybe<double> Value::NumberValue(Local<Context> context) const
     {
+        if (const jsb::impl::ValueRecord* record = isolate_->read_argument(stack_pos_); record && record->is_number()) return Maybe<double>(record->number);
         return Maybe<double>(jsbi_NumberValue(isolate_->rt(), stack_pos_));
     }
 
@@ -77,6 +86,7 @@ namespace v8
 
     double Number::Value() const
     {
+        if (const jsb::impl::ValueRecord* record = isolate_->read_argument(stack_pos_); record && record->is_number()) return record->number;
         return jsbi_NumberValue(isolate_->rt(), stack_pos_);
     }
 
@@ -87,6 +97,10 @@ namespace v8
 
     int32_t Int32::Value() const
     {
+        if (const jsb::impl::ValueRecord* record = isolate_->read_argument(stack_pos_))
+        {
+            if (int32_t value; record->get_int32(value)) return value;
+        }
         return jsbi_Int32Value(isolate_->rt(), stack_pos_);
     }
 
@@ -99,6 +113,10 @@ namespace v8
     {
         if (stack_pos_ == jsb::impl::StackBase::True) return true;
         if (stack_pos_ == jsb::impl::StackBase::False) return false;
+        if (const jsb::impl::ValueRecord* record = isolate_->read_argument(stack_pos_))
+        {
+            if (bool value; record->get_boolean(value)) return value;
+        }
         return jsbi_BooleanValue(isolate_->rt(), stack_pos_);
     }
 
@@ -40,6 +40,25 @@ namespace jsb::impl
         };
     }
 
+    // type tag of the values read by jsbi_ReadValues
+    //NOTE be cautious to always keep sync with jsbb_ValueTag in monolith.ts
+    namespace ValueTag
+    {
+        enum : int32_t
+        {
+            Undefined = 0,
+            Null = 1,
+            False = 2,
+            True = 3,
+            Integer = 4,    // a number which is an integer (as Number.isInteger)
+            Number = 5,
+            String = 6,     // with the utf-16 content copied
+            LongString = 7, // a string without content copied (out of the scratch space)
+            Object = 8,     // object or function
+            Other = 9,      // symbol, bigint
+        };
+    }
+
     enum JSAtomIndex
     {
         JS_ATOM_message = 0,
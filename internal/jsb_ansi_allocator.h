@@ -73,10 +73,18 @@ namespace jsb::internal
         template <typename T>
         struct ForType : AnyTypeAllocator<sizeof(T)>
         {
+            // elements are moved (bitwise) on resizing
+            static constexpr bool kStableAddress = false;
+
             T* get_data() const
             {
                 return (T*) AnyTypeAllocator<sizeof(T)>::get_data();
             }
+
+            T& at(size_t p_index) const
+            {
+                return get_data()[p_index];
+            }
         };
     };
 }
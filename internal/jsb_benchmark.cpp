@@ -0,0 +1,127 @@
+﻿#include "jsb_benchmark.h"
+
+namespace jsb::internal
+{
+    namespace
+    {
+        std::atomic<BenchmarkSite*> sites_ = nullptr;
+
+        jsb_force_inline int get_bucket(uint64_t p_usec)
+        {
+            int bucket = 0;
+            while (p_usec != 0 && bucket < BenchmarkSite::kHistogramBuckets - 1)
+            {
+                p_usec >>= 1;
+                ++bucket;
+            }
+            return bucket;
+        }
+    }
+
+    thread_local BenchmarkSite* Benchmark::current_ = nullptr;
+
+    BenchmarkSite::BenchmarkSite(const char* p_name, const char* p_file, int p_line)
+        : name(p_name), file(p_file), line(p_line)
+    {
+        // prepend (the list is reversed in `collect`)
+        BenchmarkSite* head = sites_.load(std::memory_order_relaxed);
+        do
+        {
+            next = head;
+        }
+        while (!sites_.compare_exchange_weak(head, this, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    void BenchmarkSite::add(uint64_t p_usec)
+    {
+        count.fetch_add(1, std::memory_order_relaxed);
+        total_usec.fetch_add(p_usec, std::memory_order_relaxed);
+        histogram[get_bucket(p_usec)].fetch_add(1, std::memory_order_relaxed);
+        uint64_t max = max_usec.load(std::memory_order_relaxed);
+        while (p_usec > max && !max_usec.compare_exchange_weak(max, p_usec, std::memory_order_relaxed)) {}
+    }
+
+    void BenchmarkSite::collect(LocalVector<Snapshot>& r_snapshots)
+    {
+        LocalVector<const BenchmarkSite*> registered;
+        for (const BenchmarkSite* site = sites_.load(std::memory_order_acquire); site; site = site->next)
+        {
+            if (site->count.load(std::memory_order_relaxed) != 0) registered.push_back(site);
+        }
+
+        // in the order of registration
+        LocalVector<const BenchmarkSite*> sites;
+        HashSet<const BenchmarkSite*> listed;
+        for (int index = (int) registered.size() - 1; index >= 0; --index)
+        {
+            sites.push_back(registered[index]);
+            listed.insert(registered[index]);
+        }
+
+        HashSet<const BenchmarkSite*> visited;
+        const auto emit = [&](const BenchmarkSite* p_site, int p_parent_index, int p_depth, const auto& p_emit) -> void
+        {
+            visited.insert(p_site);
+
+            Snapshot snapshot;
+            snapshot.name = p_site->name;
+            snapshot.file = p_site->file;
+            snapshot.line = p_site->line;
+            snapshot.parent = p_parent_index;
+            snapshot.depth = p_depth;
+            snapshot.count = p_site->count.load(std::memory_order_relaxed);
+            snapshot.total_usec = p_site->total_usec.load(std::memory_order_relaxed);
+            snapshot.max_usec = p_site->max_usec.load(std::memory_order_relaxed);
+
+            // the upper bound of the bucket containing the 99th percentile
+            uint32_t histogram[kHistogramBuckets];
+            uint64_t histogram_sum = 0;
+            for (int bucket = 0; bucket < kHistogramBuckets; ++bucket)
+            {
+                histogram[bucket] = p_site->histogram[bucket].load(std::memory_order_relaxed);
+                histogram_sum += histogram[bucket];
+            }
+            const uint64_t threshold = histogram_sum - histogram_sum / 100;
+            uint64_t accumulated = 0;
+            snapshot.p99_usec = snapshot.max_usec;
+            for (int bucket = 0; bucket < kHistogramBuckets; ++bucket)
+            {
+                accumulated += histogram[bucket];
+                if (accumulated >= threshold)
+                {
+                    snapshot.p99_usec = MIN((uint64_t) 1 << bucket, snapshot.max_usec);
+                    break;
+                }
+            }
+
+            const int index = (int) r_snapshots.size();
+            r_snapshots.push_back(snapshot);
+            for (const BenchmarkSite* child : sites)
+            {
+                if (!visited.has(child) && child->parent.load(std::memory_order_relaxed) == p_site)
+                {
+                    p_emit(child, index, p_depth + 1, p_emit);
+                }
+            }
+        };
+
+        // the roots at first (the parent may be not listed if it's never finished, e.g. still running)
+        for (const BenchmarkSite* site : sites)
+        {
+            const BenchmarkSite* parent = site->parent.load(std::memory_order_relaxed);
+            if (!visited.has(site) && (!parent || !listed.has(parent)))
+            {
+                emit(site, -1, 0, emit);
+            }
+        }
+
+        // the sites in a cycle of parents (entered from each other at the first time on different threads)
+        for (const BenchmarkSite* site : sites)
+        {
+            if (!visited.has(site))
+            {
+                emit(site, -1, 0, emit);
+            }
+        }
+    }
+}
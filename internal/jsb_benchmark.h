@@ -1,22 +1,74 @@
 ﻿#ifndef GODOTJS_BENCHMARK_H
 #define GODOTJS_BENCHMARK_H
 #include "jsb_internal_pch.h"
+#include "jsb_logger.h"
 
 #if JSB_BENCHMARK
 #   define JSB_BENCHMARK_SCOPE(RegionName, DetailName) \
-    static const char* __String__##RegionName##DetailName = #RegionName "." #DetailName; \
-    ::jsb::internal::Benchmark __Benchmark__##RegionName##DetailName(__String__##RegionName##DetailName, __FILE__, __LINE__)
+    static ::jsb::internal::BenchmarkSite __BenchmarkSite__##RegionName##DetailName(#RegionName "." #DetailName, __FILE__, __LINE__); \
+    const ::jsb::internal::Benchmark __Benchmark__##RegionName##DetailName(__BenchmarkSite__##RegionName##DetailName)
 #else
 #   define JSB_BENCHMARK_SCOPE(RegionName, DetailName) (void) 0
 #endif
 
 namespace jsb::internal
 {
-    // simple implementation of benchmark
+    // the aggregated timing of a JSB_BENCHMARK_SCOPE (one static instance per site, never destructed before exit)
+    struct BenchmarkSite
+    {
+        // the durations are counted in buckets of [2^(n-1), 2^n) usec to estimate the percentiles
+        constexpr static int kHistogramBuckets = 32;
+
+        struct Snapshot
+        {
+            const char* name;
+            const char* file;
+            int line;
+
+            // the index of the enclosing scope in the collected snapshots (-1 for a root)
+            int parent;
+            int depth;
+
+            uint64_t count;
+            uint64_t total_usec;
+            uint64_t max_usec;
+            uint64_t p99_usec;
+        };
+
+        const char* name;
+        const char* file;
+        int line;
+
+        // the scope which this site is entered from at the first time (the sites are listed as a tree)
+        std::atomic<BenchmarkSite*> parent = nullptr;
+
+        std::atomic<uint64_t> count = 0;
+        std::atomic<uint64_t> total_usec = 0;
+        std::atomic<uint64_t> max_usec = 0;
+        std::atomic<uint32_t> histogram[kHistogramBuckets] = {};
+
+        // the list of all sites (in the order of registration)
+        BenchmarkSite* next = nullptr;
+
+        BenchmarkSite(const char* p_name, const char* p_file, int p_line);
+
+        void add(uint64_t p_usec);
+
+        // all sites entered at least once, the parents precede their children
+        static void collect(LocalVector<Snapshot>& r_snapshots);
+    };
+
+    // time a scope and aggregate it into the static site, log if it's slow
     struct Benchmark
     {
-        Benchmark(const char* p_name, const char* p_file, int p_line): name_(p_name), file_(p_file), line_(p_line)
+        Benchmark(BenchmarkSite& p_site) : site_(p_site), parent_(current_)
         {
+            if (parent_ && !site_.parent.load(std::memory_order_relaxed) && parent_ != &site_)
+            {
+                BenchmarkSite* expected = nullptr;
+                site_.parent.compare_exchange_strong(expected, parent_, std::memory_order_relaxed);
+            }
+            current_ = &site_;
             start_ = OS::get_singleton()->get_ticks_usec();
             // OS::get_singleton()->benchmark_begin_measure(name_);
         }
@@ -24,20 +76,27 @@ namespace jsb::internal
         ~Benchmark()
         {
             const uint64_t total = OS::get_singleton()->get_ticks_usec() - start_;
+            current_ = parent_;
+            site_.add(total);
             // ignore if finished in a jiffy
             if (total > 20000)
             {
                 const double total_f = (double)total / 1000000.0;
-                JSB_LOG(Debug, "slow process %s: %f s (%s:%d)", name_, total_f, file_, line_);
+                JSB_LOG(Debug, "slow process %s: %f s (%s:%d)", site_.name, total_f, site_.file, site_.line);
             }
             // OS::get_singleton()->benchmark_end_measure(name_);
         }
 
+        Benchmark(const Benchmark&) = delete;
+        Benchmark& operator=(const Benchmark&) = delete;
+
     private:
-        const char* name_;
-        const char* file_;
-        int line_;
+        BenchmarkSite& site_;
+        BenchmarkSite* parent_;
         uint64_t start_;
+
+        // the innermost scope on the current thread
+        static thread_local BenchmarkSite* current_;
     };
 }
 #endif
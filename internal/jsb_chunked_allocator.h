@@ -0,0 +1,107 @@
+#ifndef GODOTJS_CHUNKED_ALLOCATOR_H
+#define GODOTJS_CHUNKED_ALLOCATOR_H
+
+#include "../compat/jsb_compat.h"
+#include "jsb_macros.h"
+
+namespace jsb::internal
+{
+    // allocates elements in fixed-size chunks (with a chunk table),
+    // growing only appends new chunks, the addresses of elements are never changed.
+    template<int kChunkSize = 256>
+    struct ChunkedAllocator
+    {
+        static_assert(kChunkSize > 0 && (kChunkSize & (kChunkSize - 1)) == 0, "the chunk size must be a power of 2");
+
+        enum { kInitialElementNum = kChunkSize };
+
+        template <typename T>
+        struct ForType
+        {
+            static constexpr bool kStableAddress = true;
+
+            ForType() : chunks(nullptr), num_chunks(0)
+            {
+            }
+
+            ~ForType()
+            {
+                release();
+            }
+
+            ForType(ForType&& other) noexcept
+            {
+                chunks = other.chunks;
+                num_chunks = other.num_chunks;
+                other.chunks = nullptr;
+                other.num_chunks = 0;
+            }
+
+            ForType& operator=(ForType&& other) noexcept
+            {
+                if (this != &other)
+                {
+                    release();
+                    chunks = other.chunks;
+                    num_chunks = other.num_chunks;
+                    other.chunks = nullptr;
+                    other.num_chunks = 0;
+                }
+                return *this;
+            }
+
+            ForType(const ForType& other) = delete;
+            ForType& operator=(const ForType& other) = delete;
+
+            // the capacity is rounded up to chunks
+            void resize(size_t p_last_num, size_t p_num)
+            {
+                jsb_check(p_last_num == capacity());
+                const size_t new_num_chunks = (p_num + kChunkSize - 1) / kChunkSize;
+                if (new_num_chunks <= num_chunks)
+                {
+                    return;
+                }
+
+                // only the chunk table is reallocated
+                chunks = (T**) memrealloc(chunks, sizeof(T*) * new_num_chunks);
+                jsb_check(chunks);
+                for (size_t i = num_chunks; i < new_num_chunks; ++i)
+                {
+                    T* chunk = (T*) memalloc(sizeof(T) * kChunkSize);
+                    jsb_check(chunk);
+                    memset((void*) chunk, 0, sizeof(T) * kChunkSize);
+                    chunks[i] = chunk;
+                }
+                num_chunks = new_num_chunks;
+            }
+
+            jsb_force_inline T& at(size_t p_index) const
+            {
+                jsb_check(p_index < capacity());
+                return chunks[p_index / kChunkSize][p_index % kChunkSize];
+            }
+
+            size_t capacity() const { return num_chunks * kChunkSize; }
+
+        private:
+            void release()
+            {
+                for (size_t i = 0; i < num_chunks; ++i)
+                {
+                    memfree(chunks[i]);
+                }
+                if (chunks)
+                {
+                    memfree(chunks);
+                }
+                chunks = nullptr;
+                num_chunks = 0;
+            }
+
+            T** chunks;
+            size_t num_chunks;
+        };
+    };
+}
+#endif
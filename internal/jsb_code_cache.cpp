@@ -0,0 +1,157 @@
+﻿#include "jsb_code_cache.h"
+#include "jsb_settings.h"
+#include "jsb_macros.h"
+#include "jsb_logger.h"
+#include "jsb_content_hash.h"
+
+#include "core/io/marshalls.h"
+
+namespace jsb::internal
+{
+    namespace
+    {
+        // 'JSBC', bump the lower byte if the layout of the cache file changed
+        constexpr uint32_t kCodeCacheMagic = 0x4A534201;
+
+        struct MemoryEntry
+        {
+            uint32_t version_tag;
+            // shared (copy on write) with the environments consuming it
+            Vector<uint8_t> data;
+        };
+
+        Mutex memory_mutex_;
+        // insertion ordered, the oldest ones are evicted first if it exceeds JSB_CODE_CACHE_MEMORY_LIMIT
+        HashMap<String, MemoryEntry> memory_;
+        size_t memory_size_ = 0;
+    }
+
+    bool CodeCache::load_memory(const String& p_fingerprint, uint32_t p_version_tag, Vector<uint8_t>& r_data)
+    {
+        MutexLock lock(memory_mutex_);
+        const MemoryEntry* entry = memory_.getptr(p_fingerprint);
+        if (!entry || entry->version_tag != p_version_tag)
+        {
+            return false;
+        }
+        r_data = entry->data;
+        return true;
+    }
+
+    void CodeCache::save_memory(const String& p_fingerprint, uint32_t p_version_tag, const Vector<uint8_t>& p_data)
+    {
+        if ((size_t) p_data.size() > JSB_CODE_CACHE_MEMORY_LIMIT)
+        {
+            return;
+        }
+        MutexLock lock(memory_mutex_);
+        if (const MemoryEntry* entry = memory_.getptr(p_fingerprint))
+        {
+            memory_size_ -= entry->data.size();
+            memory_.erase(p_fingerprint);
+        }
+        while (!memory_.is_empty() && memory_size_ + p_data.size() > JSB_CODE_CACHE_MEMORY_LIMIT)
+        {
+            const String oldest = memory_.begin()->key;
+            memory_size_ -= memory_.begin()->value.data.size();
+            memory_.erase(oldest);
+        }
+        memory_.insert(p_fingerprint, { p_version_tag, p_data });
+        memory_size_ += p_data.size();
+    }
+
+    void CodeCache::clear_memory()
+    {
+        MutexLock lock(memory_mutex_);
+        memory_.clear();
+        memory_size_ = 0;
+    }
+
+    String CodeCache::get_cache_dir()
+    {
+        return Settings::get_jsb_out_res_path().path_join(".codecache");
+    }
+
+    String CodeCache::get_cache_path(const String& p_path)
+    {
+        return get_cache_dir().path_join(p_path.md5_text() + ".bin");
+    }
+
+    String CodeCache::get_fingerprint(const uint8_t* p_source, size_t p_length)
+    {
+        return itos((int64_t) p_length) + ":" + String::num_uint64(ContentHash::compute(p_source, p_length), 16);
+    }
+
+    bool CodeCache::load(const String& p_path, const String& p_fingerprint, uint32_t p_version_tag, Vector<uint8_t>& r_data)
+    {
+        if (load_memory(p_fingerprint, p_version_tag, r_data))
+        {
+            JSB_LOG(VeryVerbose, "code cache shared in memory %s", p_path);
+            return true;
+        }
+        const Ref<FileAccess> file = FileAccess::open(get_cache_path(p_path), FileAccess::READ);
+        if (file.is_null())
+        {
+            return false;
+        }
+        if (file->get_32() != kCodeCacheMagic || file->get_32() != p_version_tag || file->get_pascal_string() != p_fingerprint)
+        {
+            JSB_LOG(Verbose, "outdated code cache %s", p_path);
+            return false;
+        }
+        const uint32_t size = file->get_32();
+        if (size == 0 || (uint64_t) size > file->get_length() - file->get_position())
+        {
+            JSB_LOG(Warning, "corrupted code cache %s", p_path);
+            return false;
+        }
+        r_data.resize((int) size);
+        if (file->get_buffer(r_data.ptrw(), size) != size)
+        {
+            return false;
+        }
+        save_memory(p_fingerprint, p_version_tag, r_data);
+        return true;
+    }
+
+    void CodeCache::save(const String& p_path, const String& p_fingerprint, uint32_t p_version_tag, const Vector<uint8_t>& p_data)
+    {
+        if (p_data.is_empty())
+        {
+            return;
+        }
+        save_memory(p_fingerprint, p_version_tag, p_data);
+        const String cache_dir = get_cache_dir();
+        if (!DirAccess::exists(cache_dir) && DirAccess::make_dir_recursive_absolute(cache_dir) != OK)
+        {
+            JSB_LOG(Verbose, "code cache is not writable %s", cache_dir);
+            return;
+        }
+        const Ref<FileAccess> file = FileAccess::open(get_cache_path(p_path), FileAccess::WRITE);
+        if (file.is_null())
+        {
+            return;
+        }
+        const Vector<uint8_t> content = encode(p_fingerprint, p_version_tag, p_data);
+        file->store_buffer(content.ptr(), content.size());
+        JSB_LOG(VeryVerbose, "code cache saved %s (%d bytes)", p_path, p_data.size());
+    }
+
+    Vector<uint8_t> CodeCache::encode(const String& p_fingerprint, uint32_t p_version_tag, const Vector<uint8_t>& p_data)
+    {
+        // same layout as FileAccess::store_32/store_pascal_string (little endian)
+        const CharString fingerprint = p_fingerprint.utf8();
+        Vector<uint8_t> content;
+        content.resize(4 * 4 + fingerprint.length() + p_data.size());
+        uint8_t* ptr = content.ptrw();
+        ptr += encode_uint32(kCodeCacheMagic, ptr);
+        ptr += encode_uint32(p_version_tag, ptr);
+        ptr += encode_uint32((uint32_t) fingerprint.length(), ptr);
+        memcpy(ptr, fingerprint.get_data(), fingerprint.length());
+        ptr += fingerprint.length();
+        ptr += encode_uint32((uint32_t) p_data.size(), ptr);
+        memcpy(ptr, p_data.ptr(), p_data.size());
+        return content;
+    }
+
+}
@@ -0,0 +1,47 @@
+﻿#ifndef GODOTJS_CODE_CACHE_H
+#define GODOTJS_CODE_CACHE_H
+#include "jsb_internal_pch.h"
+
+namespace jsb::internal
+{
+    /**
+     * Persistent storage of the compiled modules (the format of data is defined by the underlying javascript runtime).
+     * The caches loaded and saved are also kept in memory (process-wide, keyed by the fingerprint of the source content),
+     * so that the same module compiled by the main environment is consumed by the workers and shadow environments
+     * without reading the cache file again (or at all if the cache directory is not writable).
+     */
+    struct CodeCache
+    {
+        /**
+         * \brief read the cached data of a module
+         * \param p_path asset path of the module source
+         * \param p_fingerprint identifies the revision of the source, the cache is discarded if it mismatches
+         * \param p_version_tag identifies the revision of the runtime, the cache is discarded if it mismatches
+         * \return true if `r_data` is filled with a valid cache
+         */
+        static bool load(const String& p_path, const String& p_fingerprint, uint32_t p_version_tag, Vector<uint8_t>& r_data);
+
+        // write the cached data of a module (silently ignored if the cache directory is not writable)
+        static void save(const String& p_path, const String& p_fingerprint, uint32_t p_version_tag, const Vector<uint8_t>& p_data);
+
+        // fingerprint of the given source (by content, it's calculated on the source already in memory)
+        static String get_fingerprint(const uint8_t* p_source, size_t p_length);
+
+        // the content of a cache file as written by `save` (used to pack prebuilt caches into exported projects)
+        static Vector<uint8_t> encode(const String& p_fingerprint, uint32_t p_version_tag, const Vector<uint8_t>& p_data);
+
+        // the path of the cache file of a module
+        static String get_cache_path(const String& p_path);
+
+        // release the caches kept in memory
+        static void clear_memory();
+
+    private:
+        static String get_cache_dir();
+
+        static bool load_memory(const String& p_fingerprint, uint32_t p_version_tag, Vector<uint8_t>& r_data);
+        static void save_memory(const String& p_fingerprint, uint32_t p_version_tag, const Vector<uint8_t>& p_data);
+    };
+}
+
+#endif
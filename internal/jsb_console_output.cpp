@@ -1,4 +1,5 @@
 ﻿#include "jsb_console_output.h"
+#include "jsb_mpsc_queue.h"
 
 namespace jsb::internal
 {
@@ -6,6 +7,25 @@ namespace jsb::internal
     {
         RWLock lock_;
         Vector<IConsoleOutput*> outputs_;
+
+        struct PendingMessage
+        {
+            ELogSeverity::Type severity;
+            String text;
+        };
+
+        std::atomic<bool> buffered_ = false;
+
+        // approximated number of queued messages (it's only used to limit the queue)
+        std::atomic<int> pending_num_ = 0;
+        std::atomic<int> dropped_num_ = 0;
+        MPSCQueue<PendingMessage> pending_;
+
+        void write_now(ELogSeverity::Type p_severity, const String& p_text)
+        {
+            IConsoleOutput::internal_write(p_severity, p_text);
+            print_line(p_text);
+        }
     }
 
     IConsoleOutput::IConsoleOutput()
@@ -34,4 +54,50 @@ namespace jsb::internal
         }
     }
 
+    void IConsoleOutput::print(ELogSeverity::Type p_severity, String&& p_text)
+    {
+        if (!buffered_.load(std::memory_order_relaxed))
+        {
+            write_now(p_severity, p_text);
+            return;
+        }
+        if (pending_num_.fetch_add(1, std::memory_order_relaxed) >= JSB_CONSOLE_MAX_PENDING_MESSAGES)
+        {
+            pending_num_.fetch_sub(1, std::memory_order_relaxed);
+            dropped_num_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        pending_.add(PendingMessage { p_severity, std::move(p_text) });
+    }
+
+    void IConsoleOutput::flush()
+    {
+        std::vector<PendingMessage>& messages = pending_.swap();
+        if (!messages.empty())
+        {
+            pending_num_.fetch_sub((int) messages.size(), std::memory_order_relaxed);
+            for (const PendingMessage& message : messages)
+            {
+                write_now(message.severity, message.text);
+            }
+            messages.clear();
+        }
+        if (const int dropped = dropped_num_.exchange(0, std::memory_order_relaxed); dropped != 0)
+        {
+            write_now(ELogSeverity::Warning, jsb_format("[JS] %d console messages dropped", dropped));
+        }
+    }
+
+    void IConsoleOutput::set_buffered(bool p_buffered)
+    {
+        buffered_.store(p_buffered, std::memory_order_relaxed);
+        // write the pending messages at once if it's switched off
+        if (!p_buffered) flush();
+    }
+
+    bool IConsoleOutput::is_buffered()
+    {
+        return buffered_.load(std::memory_order_relaxed);
+    }
+
 }
@@ -15,6 +15,16 @@ namespace jsb
 
             static void internal_write(ELogSeverity::Type p_severity, const String& p_text);
 
+            // write a console message to all outputs and the godot console,
+            // it's only queued (from any thread) if buffered, and written later in `flush()`
+            static void print(ELogSeverity::Type p_severity, String&& p_text);
+
+            // [main thread] write all queued console messages (once per frame)
+            static void flush();
+
+            static void set_buffered(bool p_buffered);
+            static bool is_buffered();
+
             IConsoleOutput();
             virtual ~IConsoleOutput();
 
@@ -0,0 +1,102 @@
+#ifndef GODOTJS_CONTENT_HASH_H
+#define GODOTJS_CONTENT_HASH_H
+#include "jsb_internal_pch.h"
+
+namespace jsb::internal
+{
+    // a fast non-cryptographic 64-bit hash of file contents (XXH64), only for change detection
+    struct ContentHash
+    {
+        static uint64_t compute(const uint8_t* p_data, size_t p_length, uint64_t p_seed = 0)
+        {
+            const uint8_t* ptr = p_data;
+            const uint8_t* const end = p_data + p_length;
+            uint64_t h;
+
+            if (p_length >= 32)
+            {
+                uint64_t v1 = p_seed + kPrime1 + kPrime2;
+                uint64_t v2 = p_seed + kPrime2;
+                uint64_t v3 = p_seed;
+                uint64_t v4 = p_seed - kPrime1;
+                for (const uint8_t* const limit = end - 32; ptr <= limit; ptr += 32)
+                {
+                    v1 = round(v1, read64(ptr));
+                    v2 = round(v2, read64(ptr + 8));
+                    v3 = round(v3, read64(ptr + 16));
+                    v4 = round(v4, read64(ptr + 24));
+                }
+                h = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18);
+                h = merge_round(h, v1);
+                h = merge_round(h, v2);
+                h = merge_round(h, v3);
+                h = merge_round(h, v4);
+            }
+            else
+            {
+                h = p_seed + kPrime5;
+            }
+
+            h += (uint64_t) p_length;
+            for (; ptr + 8 <= end; ptr += 8)
+            {
+                h ^= round(0, read64(ptr));
+                h = rotl(h, 27) * kPrime1 + kPrime4;
+            }
+            if (ptr + 4 <= end)
+            {
+                h ^= (uint64_t) read32(ptr) * kPrime1;
+                h = rotl(h, 23) * kPrime2 + kPrime3;
+                ptr += 4;
+            }
+            for (; ptr < end; ++ptr)
+            {
+                h ^= (uint64_t) *ptr * kPrime5;
+                h = rotl(h, 11) * kPrime1;
+            }
+
+            h ^= h >> 33;
+            h *= kPrime2;
+            h ^= h >> 29;
+            h *= kPrime3;
+            h ^= h >> 32;
+            return h;
+        }
+
+        static uint64_t compute(const Vector<uint8_t>& p_data) { return compute(p_data.ptr(), p_data.size()); }
+
+    private:
+        static constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87ULL;
+        static constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4FULL;
+        static constexpr uint64_t kPrime3 = 0x165667B19E3779F9ULL;
+        static constexpr uint64_t kPrime4 = 0x85EBCA77C2B2AE63ULL;
+        static constexpr uint64_t kPrime5 = 0x27D4EB2F165667C5ULL;
+
+        static jsb_force_inline uint64_t rotl(uint64_t p_value, int p_bits) { return (p_value << p_bits) | (p_value >> (64 - p_bits)); }
+
+        // little-endian reads (unaligned)
+        static jsb_force_inline uint64_t read64(const uint8_t* p_ptr)
+        {
+            uint64_t value = 0;
+            for (int i = 7; i >= 0; --i) value = (value << 8) | p_ptr[i];
+            return value;
+        }
+
+        static jsb_force_inline uint32_t read32(const uint8_t* p_ptr)
+        {
+            return (uint32_t) p_ptr[0] | ((uint32_t) p_ptr[1] << 8) | ((uint32_t) p_ptr[2] << 16) | ((uint32_t) p_ptr[3] << 24);
+        }
+
+        static jsb_force_inline uint64_t round(uint64_t p_acc, uint64_t p_input)
+        {
+            return rotl(p_acc + p_input * kPrime2, 31) * kPrime1;
+        }
+
+        static jsb_force_inline uint64_t merge_round(uint64_t p_acc, uint64_t p_value)
+        {
+            return (p_acc ^ round(0, p_value)) * kPrime1 + kPrime4;
+        }
+    };
+}
+
+#endif
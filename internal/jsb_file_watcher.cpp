@@ -0,0 +1,178 @@
+#include "jsb_file_watcher.h"
+#include "jsb_logger.h"
+
+#if defined(WINDOWS_ENABLED)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#elif defined(__linux__)
+#include <errno.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace jsb::internal
+{
+#if defined(WINDOWS_ENABLED)
+    class FileWatcherImpl : public FileWatcher
+    {
+        struct Watch
+        {
+            String dir;
+            HANDLE handle = INVALID_HANDLE_VALUE;
+            OVERLAPPED overlapped = {};
+            alignas(DWORD) uint8_t buffer[16 * 1024];
+        };
+
+        HashMap<String, std::unique_ptr<Watch>> watches_;
+
+        static bool issue(Watch& p_watch)
+        {
+            return ReadDirectoryChangesW(p_watch.handle, p_watch.buffer, sizeof(p_watch.buffer), FALSE,
+                FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_SIZE, nullptr, &p_watch.overlapped, nullptr);
+        }
+
+    public:
+        virtual ~FileWatcherImpl() override
+        {
+            for (const KeyValue<String, std::unique_ptr<Watch>>& it : watches_)
+            {
+                CancelIo(it.value->handle);
+                CloseHandle(it.value->handle);
+                CloseHandle(it.value->overlapped.hEvent);
+            }
+        }
+
+        virtual bool add_directory(const String& p_dir) override
+        {
+            if (watches_.has(p_dir)) return true;
+
+            std::unique_ptr<Watch> watch = std::make_unique<Watch>();
+            watch->dir = p_dir;
+            watch->handle = CreateFileW((LPCWSTR) p_dir.utf16().get_data(), FILE_LIST_DIRECTORY, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                nullptr, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+            if (watch->handle == INVALID_HANDLE_VALUE)
+            {
+                JSB_LOG(Verbose, "failed to watch %s", p_dir);
+                return false;
+            }
+            watch->overlapped.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+            if (!issue(*watch))
+            {
+                CloseHandle(watch->handle);
+                CloseHandle(watch->overlapped.hEvent);
+                return false;
+            }
+            watches_.insert(p_dir, std::move(watch));
+            return true;
+        }
+
+        virtual bool poll(HashSet<String>& r_changed) override
+        {
+            bool complete = true;
+            for (const KeyValue<String, std::unique_ptr<Watch>>& it : watches_)
+            {
+                Watch& watch = *it.value;
+                DWORD bytes = 0;
+                if (!GetOverlappedResult(watch.handle, &watch.overlapped, &bytes, FALSE))
+                {
+                    // ERROR_IO_INCOMPLETE if nothing changed
+                    continue;
+                }
+
+                // zero bytes means the buffer overflowed
+                if (bytes == 0) complete = false;
+                for (size_t offset = 0; bytes != 0; )
+                {
+                    const FILE_NOTIFY_INFORMATION* info = (const FILE_NOTIFY_INFORMATION*) (watch.buffer + offset);
+                    const String name = String::utf16((const char16_t*) info->FileName, (int) (info->FileNameLength / sizeof(WCHAR)));
+                    r_changed.insert(watch.dir.path_join(name.replace("\\", "/")));
+                    if (info->NextEntryOffset == 0) break;
+                    offset += info->NextEntryOffset;
+                }
+
+                ResetEvent(watch.overlapped.hEvent);
+                if (!issue(watch)) complete = false;
+            }
+            return complete;
+        }
+    };
+#elif defined(__linux__)
+    class FileWatcherImpl : public FileWatcher
+    {
+        int fd_ = -1;
+        HashMap<String, int> watches_;
+        HashMap<int, String> dirs_;
+
+    public:
+        FileWatcherImpl() : fd_(inotify_init1(IN_NONBLOCK | IN_CLOEXEC)) {}
+
+        virtual ~FileWatcherImpl() override
+        {
+            if (fd_ >= 0) close(fd_);
+        }
+
+        jsb_force_inline bool is_valid() const { return fd_ >= 0; }
+
+        virtual bool add_directory(const String& p_dir) override
+        {
+            if (watches_.has(p_dir)) return true;
+
+            const int wd = inotify_add_watch(fd_, p_dir.utf8().get_data(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE);
+            if (wd < 0)
+            {
+                // usually ENOSPC if `max_user_watches` is exceeded
+                JSB_LOG(Verbose, "failed to watch %s (%d)", p_dir, errno);
+                return false;
+            }
+            watches_.insert(p_dir, wd);
+            dirs_.insert(wd, p_dir);
+            return true;
+        }
+
+        virtual bool poll(HashSet<String>& r_changed) override
+        {
+            bool complete = true;
+            alignas(inotify_event) char buffer[16 * 1024];
+            for (;;)
+            {
+                const ssize_t len = read(fd_, buffer, sizeof(buffer));
+                if (len <= 0) break;
+
+                for (ssize_t offset = 0; offset < len; )
+                {
+                    const inotify_event* event = (const inotify_event*) (buffer + offset);
+                    offset += (ssize_t) (sizeof(inotify_event) + event->len);
+                    if (event->mask & IN_Q_OVERFLOW)
+                    {
+                        complete = false;
+                        continue;
+                    }
+                    if (event->len == 0) continue;
+                    if (const HashMap<int, String>::Iterator it = dirs_.find(event->wd); it != dirs_.end())
+                    {
+                        r_changed.insert(it->value.path_join(String::utf8(event->name)));
+                    }
+                }
+            }
+            return complete;
+        }
+    };
+#endif
+
+    std::unique_ptr<FileWatcher> FileWatcher::create()
+    {
+#if defined(WINDOWS_ENABLED)
+        return std::make_unique<FileWatcherImpl>();
+#elif defined(__linux__)
+        std::unique_ptr<FileWatcherImpl> watcher = std::make_unique<FileWatcherImpl>();
+        if (!watcher->is_valid())
+        {
+            JSB_LOG(Verbose, "inotify is not available (%d)", errno);
+            return nullptr;
+        }
+        return watcher;
+#else
+        return nullptr;
+#endif
+    }
+}
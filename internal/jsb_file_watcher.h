@@ -0,0 +1,32 @@
+#ifndef GODOTJS_FILE_WATCHER_H
+#define GODOTJS_FILE_WATCHER_H
+#include "jsb_internal_pch.h"
+
+namespace jsb::internal
+{
+    /**
+     * Receive change notifications of files from the OS (inotify, ReadDirectoryChangesW) instead of checking them one by one.
+     * Directories are watched non-recursively, the notifications are queued by the OS until `poll` is called.
+     */
+    class FileWatcher
+    {
+    public:
+        virtual ~FileWatcher() = default;
+
+        // null if it's not supported on the current platform
+        static std::unique_ptr<FileWatcher> create();
+
+        // start watching files in the directory (absolute path), it's ok to add a directory more than once
+        virtual bool add_directory(const String& p_dir) = 0;
+
+        /**
+         * \brief collect the absolute paths of files changed since the last poll (non-blocking)
+         * \return false if some notifications have been lost (e.g. the queue overflowed), all files should be checked in this case
+         */
+        virtual bool poll(HashSet<String>& r_changed) = 0;
+
+    protected:
+        FileWatcher() = default;
+    };
+}
+#endif
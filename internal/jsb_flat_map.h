@@ -0,0 +1,249 @@
+#ifndef GODOTJS_FLAT_MAP_H
+#define GODOTJS_FLAT_MAP_H
+
+#include "jsb_internal_pch.h"
+#include "jsb_macros.h"
+
+namespace jsb::internal
+{
+    /**
+     * A hash map with open addressing (robin hood probing with backward shift deletion, no tombstones).
+     * The entries are stored densely in insertion order (until the first `erase` which moves the last entry into the hole),
+     * and the probe sequence is a flat array of [hash, index] slots, so that a lookup usually touches one cache line of slots
+     * and compares the key of at most one entry.
+     * The lookups are heterogeneous, any type hashed by `THasher` consistently with the key and comparable with it works,
+     * e.g. `String` for `StringName` keys (without interning a StringName), or `const T*` for `T*` keys.
+     * Pointers to the values are invalidated by `insert` and `erase`.
+     */
+    template<typename TKey, typename TValue, typename THasher = HashMapHasherDefault>
+    class FlatMap
+    {
+    public:
+        // the key must not be modified through iteration
+        struct Entry
+        {
+            TKey key;
+            TValue value;
+        };
+
+    private:
+        enum : uint32_t { kMinCapacity = 8 };
+
+        struct Slot
+        {
+            // 0 for empty slots
+            uint32_t hash;
+            uint32_t index;
+        };
+
+        std::vector<Entry> entries_;
+        std::vector<Slot> slots_;
+
+        template<typename TLookup>
+        static jsb_force_inline uint32_t hash_of(const TLookup& p_key)
+        {
+            const uint32_t hash = (uint32_t) THasher::hash(p_key);
+            return hash != 0 ? hash : 1;
+        }
+
+        jsb_force_inline uint32_t get_mask() const { return (uint32_t) slots_.size() - 1; }
+
+        // the distance of a slot from the home position of its hash
+        jsb_force_inline uint32_t distance_of(uint32_t p_hash, uint32_t p_pos) const { return (p_pos - p_hash) & get_mask(); }
+
+        template<typename TLookup>
+        int64_t find_slot(const TLookup& p_key) const
+        {
+            if (jsb_unlikely(entries_.empty())) return -1;
+            const uint32_t hash = hash_of(p_key);
+            const uint32_t mask = get_mask();
+            for (uint32_t pos = hash & mask, distance = 0; ; pos = (pos + 1) & mask, ++distance)
+            {
+                const Slot& slot = slots_[pos];
+                // a richer slot means the key would have been placed before it
+                if (slot.hash == 0 || distance_of(slot.hash, pos) < distance) return -1;
+                if (slot.hash == hash && entries_[slot.index].key == p_key) return pos;
+            }
+        }
+
+        // the slot must not exist
+        void place(Slot p_slot)
+        {
+            const uint32_t mask = get_mask();
+            for (uint32_t pos = p_slot.hash & mask, distance = 0; ; pos = (pos + 1) & mask, ++distance)
+            {
+                Slot& slot = slots_[pos];
+                if (slot.hash == 0)
+                {
+                    slot = p_slot;
+                    return;
+                }
+                if (const uint32_t slot_distance = distance_of(slot.hash, pos); slot_distance < distance)
+                {
+                    std::swap(slot, p_slot);
+                    distance = slot_distance;
+                }
+            }
+        }
+
+        void rehash(uint32_t p_capacity)
+        {
+            jsb_check(p_capacity >= kMinCapacity && (p_capacity & (p_capacity - 1)) == 0);
+            std::vector<Slot> old_slots(p_capacity, Slot {});
+            slots_.swap(old_slots);
+            for (const Slot& slot : old_slots)
+            {
+                if (slot.hash != 0) place(slot);
+            }
+        }
+
+        void grow_for(uint32_t p_num)
+        {
+            // the load factor is kept under 3/4
+            if (p_num * 4 > (uint32_t) slots_.size() * 3)
+            {
+                rehash(MAX((uint32_t) kMinCapacity, next_power_of_2(p_num * 4 / 3 + 1)));
+            }
+        }
+
+        void erase_slot(uint32_t p_pos)
+        {
+            const uint32_t mask = get_mask();
+            const uint32_t index = slots_[p_pos].index;
+
+            // shift the following slots of the probe sequence back
+            uint32_t hole = p_pos;
+            for (uint32_t next = (hole + 1) & mask; slots_[next].hash != 0 && distance_of(slots_[next].hash, next) != 0; next = (next + 1) & mask)
+            {
+                slots_[hole] = slots_[next];
+                hole = next;
+            }
+            slots_[hole] = {};
+
+            // move the last entry into the hole
+            const uint32_t last = (uint32_t) entries_.size() - 1;
+            if (index != last)
+            {
+                for (uint32_t pos = hash_of(entries_[last].key) & mask; ; pos = (pos + 1) & mask)
+                {
+                    if (slots_[pos].index == last && slots_[pos].hash != 0)
+                    {
+                        slots_[pos].index = index;
+                        break;
+                    }
+                }
+                entries_[index] = std::move(entries_[last]);
+            }
+            entries_.pop_back();
+        }
+
+    public:
+        jsb_force_inline uint32_t size() const { return (uint32_t) entries_.size(); }
+        jsb_force_inline bool is_empty() const { return entries_.empty(); }
+
+        void reserve(uint32_t p_num)
+        {
+            entries_.reserve(p_num);
+            grow_for(p_num);
+        }
+
+        template<typename TLookup>
+        jsb_force_inline bool has(const TLookup& p_key) const { return find_slot(p_key) >= 0; }
+
+        template<typename TLookup>
+        jsb_force_inline const TValue* getptr(const TLookup& p_key) const
+        {
+            const int64_t pos = find_slot(p_key);
+            return pos >= 0 ? &entries_[slots_[pos].index].value : nullptr;
+        }
+
+        template<typename TLookup>
+        jsb_force_inline TValue* getptr(const TLookup& p_key)
+        {
+            const int64_t pos = find_slot(p_key);
+            return pos >= 0 ? &entries_[slots_[pos].index].value : nullptr;
+        }
+
+        // nullptr if not found
+        template<typename TLookup>
+        jsb_force_inline const Entry* find(const TLookup& p_key) const
+        {
+            const int64_t pos = find_slot(p_key);
+            return pos >= 0 ? &entries_[slots_[pos].index] : nullptr;
+        }
+
+        template<typename TLookup>
+        jsb_force_inline Entry* find(const TLookup& p_key)
+        {
+            const int64_t pos = find_slot(p_key);
+            return pos >= 0 ? &entries_[slots_[pos].index] : nullptr;
+        }
+
+        // the key must exist
+        template<typename TLookup>
+        const TValue& get(const TLookup& p_key) const
+        {
+            const TValue* value = getptr(p_key);
+            jsb_check(value);
+            return *value;
+        }
+
+        // replace the value if the key exists
+        Entry* insert(const TKey& p_key, TValue&& p_value)
+        {
+            if (const int64_t pos = find_slot(p_key); pos >= 0)
+            {
+                Entry& entry = entries_[slots_[pos].index];
+                entry.value = std::move(p_value);
+                return &entry;
+            }
+            grow_for(size() + 1);
+            const uint32_t index = size();
+            entries_.push_back({ p_key, std::move(p_value) });
+            place({ hash_of(p_key), index });
+            return &entries_[index];
+        }
+
+        Entry* insert(const TKey& p_key, const TValue& p_value)
+        {
+            return insert(p_key, TValue(p_value));
+        }
+
+        // insert a default value if the key doesn't exist
+        TValue& operator[](const TKey& p_key)
+        {
+            if (TValue* value = getptr(p_key))
+            {
+                return *value;
+            }
+            return insert(p_key, TValue())->value;
+        }
+
+        template<typename TLookup>
+        bool erase(const TLookup& p_key)
+        {
+            const int64_t pos = find_slot(p_key);
+            if (pos < 0)
+            {
+                return false;
+            }
+            erase_slot((uint32_t) pos);
+            return true;
+        }
+
+        // the capacity is kept
+        void clear()
+        {
+            if (entries_.empty()) return;
+            entries_.clear();
+            std::fill(slots_.begin(), slots_.end(), Slot {});
+        }
+
+        jsb_force_inline Entry* begin() { return entries_.data(); }
+        jsb_force_inline Entry* end() { return entries_.data() + entries_.size(); }
+        jsb_force_inline const Entry* begin() const { return entries_.data(); }
+        jsb_force_inline const Entry* end() const { return entries_.data() + entries_.size(); }
+    };
+}
+
+#endif
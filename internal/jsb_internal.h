@@ -4,12 +4,19 @@
 #include "jsb_macros.h"
 #include "jsb_sindex.h"
 #include "jsb_sarray.h"
+#include "jsb_pointer_map.h"
+#include "jsb_flat_map.h"
+#include "jsb_scratch_arena.h"
 #include "jsb_double_buffered.h"
+#include "jsb_mpsc_queue.h"
+#include "jsb_profile_counters.h"
 #include "jsb_format.h"
 #include "jsb_logger.h"
 #include "jsb_naming_util.h"
 #include "jsb_string_names.h"
 #include "jsb_source_reader.h"
+#include "jsb_file_watcher.h"
+#include "jsb_content_hash.h"
 #include "jsb_source_map.h"
 #include "jsb_source_map_cache.h"
 #include "jsb_timer_manager.h"
@@ -22,6 +29,8 @@
 #include "jsb_function_pointer.h"
 #include "jsb_typealias.h"
 #include "jsb_benchmark.h"
+#include "jsb_trace_events.h"
+#include "jsb_resource_cache.h"
 
 #include "jsb_variant_info.h"
 #include "jsb_variant_allocator.h"
@@ -1,7 +1,9 @@
 #ifndef GODOTJS_INTERNAL_PCH_H
 #define GODOTJS_INTERNAL_PCH_H
 
+#include <atomic>
 #include <memory>
+#include <optional>
 #include <vector>
 #include <unordered_map>
 
@@ -0,0 +1,131 @@
+#include "jsb_mapped_file.h"
+#include "jsb_logger.h"
+
+#if !JSB_GDEXTENSION
+#include "core/io/file_access_pack.h"
+#endif
+
+#if defined(WINDOWS_ENABLED)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#define JSB_MAPPED_FILE_SUPPORTED 1
+#elif defined(UNIX_ENABLED) && !defined(__EMSCRIPTEN__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define JSB_MAPPED_FILE_SUPPORTED 1
+#else
+#define JSB_MAPPED_FILE_SUPPORTED 0
+#endif
+
+namespace jsb::internal
+{
+    String MappedFile::get_native_path(const String& p_path)
+    {
+#if JSB_MAPPED_FILE_SUPPORTED
+        if (p_path.begins_with("res://"))
+        {
+#if JSB_GDEXTENSION
+            // no access to the packed data, only the editor is known to read res:// from the filesystem
+            if (!OS::get_singleton()->has_feature("editor"))
+            {
+                return String();
+            }
+#else
+            // files in packages shadow the files on the filesystem
+            if (PackedData::get_singleton() && !PackedData::get_singleton()->is_disabled() && PackedData::get_singleton()->has_path(p_path))
+            {
+                return String();
+            }
+#endif
+        }
+        const String path = ProjectSettings::get_singleton()->globalize_path(p_path);
+        return path.begins_with("res://") || path.begins_with("user://") ? String() : path;
+#else
+        return String();
+#endif
+    }
+
+    Error MappedFile::open(const String& p_path)
+    {
+        close();
+        const String path = get_native_path(p_path);
+        if (path.is_empty())
+        {
+            return ERR_UNAVAILABLE;
+        }
+
+#if defined(WINDOWS_ENABLED)
+        const HANDLE file = CreateFileW((LPCWSTR) path.utf16().get_data(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            return ERR_FILE_CANT_OPEN;
+        }
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+        {
+            CloseHandle(file);
+            return ERR_FILE_CANT_READ;
+        }
+        // the mapping object keeps the file open
+        const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (!mapping)
+        {
+            return ERR_FILE_CANT_READ;
+        }
+        void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!view)
+        {
+            CloseHandle(mapping);
+            return ERR_FILE_CANT_READ;
+        }
+        mapping_ = mapping;
+        data_ = (const uint8_t*) view;
+        size_ = (uint64_t) size.QuadPart;
+        return OK;
+#elif JSB_MAPPED_FILE_SUPPORTED
+        const int fd = ::open(path.utf8().get_data(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            return ERR_FILE_CANT_OPEN;
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size <= 0)
+        {
+            ::close(fd);
+            return ERR_FILE_CANT_READ;
+        }
+        // the mapping keeps the file referenced after the descriptor is closed
+        void* view = mmap(nullptr, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (view == MAP_FAILED)
+        {
+            return ERR_FILE_CANT_READ;
+        }
+        data_ = (const uint8_t*) view;
+        size_ = (uint64_t) st.st_size;
+        return OK;
+#else
+        return ERR_UNAVAILABLE;
+#endif
+    }
+
+    void MappedFile::close()
+    {
+        if (!data_)
+        {
+            return;
+        }
+#if defined(WINDOWS_ENABLED)
+        UnmapViewOfFile(data_);
+        CloseHandle(mapping_);
+        mapping_ = nullptr;
+#elif JSB_MAPPED_FILE_SUPPORTED
+        munmap((void*) data_, (size_t) size_);
+#endif
+        data_ = nullptr;
+        size_ = 0;
+    }
+}
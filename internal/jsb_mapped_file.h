@@ -0,0 +1,41 @@
+#ifndef GODOTJS_MAPPED_FILE_H
+#define GODOTJS_MAPPED_FILE_H
+#include "jsb_internal_pch.h"
+
+namespace jsb::internal
+{
+    /**
+     * A read-only view of a file on the native filesystem mapped into memory (the pages are loaded on demand by the OS).
+     * Files in packages (res:// in pck) can't be mapped, the caller should fall back to FileAccess in this case.
+     */
+    class MappedFile
+    {
+    public:
+        MappedFile() = default;
+        ~MappedFile() { close(); }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        // ERR_UNAVAILABLE if the file is not on the native filesystem or the platform doesn't support it
+        Error open(const String& p_path);
+        void close();
+
+        jsb_force_inline bool is_open() const { return data_ != nullptr; }
+        jsb_force_inline const uint8_t* get_data() const { return data_; }
+        jsb_force_inline uint64_t get_size() const { return size_; }
+
+        // the absolute path of the file on the native filesystem, empty if it's not mappable
+        static String get_native_path(const String& p_path);
+
+    private:
+        const uint8_t* data_ = nullptr;
+        uint64_t size_ = 0;
+
+#if defined(WINDOWS_ENABLED)
+        void* mapping_ = nullptr;
+#endif
+    };
+}
+
+#endif
@@ -0,0 +1,191 @@
+#include "jsb_module_archive.h"
+#include "jsb_settings.h"
+#include "jsb_macros.h"
+#include "jsb_logger.h"
+
+#include "core/io/marshalls.h"
+
+namespace jsb::internal
+{
+    namespace
+    {
+        // 'JSBA', bump the lower byte if the layout of the archive changed
+        constexpr uint32_t kModuleArchiveMagic = 0x4A534241;
+        constexpr uint32_t kModuleArchiveVersion = 1;
+
+        jsb_force_inline bool read_u32(const uint8_t*& p_ptr, const uint8_t* p_end, uint32_t& r_value)
+        {
+            if (p_end - p_ptr < 4) return false;
+            r_value = decode_uint32(p_ptr);
+            p_ptr += 4;
+            return true;
+        }
+    }
+
+    String ModuleArchive::get_packaged_path()
+    {
+        return Settings::get_jsb_out_res_path().path_join("modules.jsba");
+    }
+
+    const ModuleArchive* ModuleArchive::get_packaged()
+    {
+#ifdef TOOLS_ENABLED
+        // the editor always reads the sources directly
+        return nullptr;
+#else
+        // opened once for all environments (it's immutable after opening)
+        static const std::unique_ptr<ModuleArchive> archive = []
+        {
+            const String path = get_packaged_path();
+            if (!FileAccess::exists(path))
+            {
+                return std::unique_ptr<ModuleArchive>();
+            }
+            std::unique_ptr<ModuleArchive> opened = std::make_unique<ModuleArchive>();
+            if (opened->open(path) != OK)
+            {
+                return std::unique_ptr<ModuleArchive>();
+            }
+            JSB_LOG(Verbose, "module archive opened %s (%d files)", path, opened->size());
+            return opened;
+        }();
+        return archive.get();
+#endif
+    }
+
+    Error ModuleArchive::open(const String& p_path)
+    {
+        Error err = ERR_UNAVAILABLE;
+#if JSB_WITH_MAPPED_SOURCE
+        err = mapped_.open(p_path);
+#endif
+        if (err != OK)
+        {
+            buffer_ = FileAccess::get_file_as_bytes(p_path, &err);
+            if (err != OK)
+            {
+                return err;
+            }
+        }
+
+        const uint8_t* ptr = mapped_.is_open() ? mapped_.get_data() : buffer_.ptr();
+        const uint8_t* end = ptr + (mapped_.is_open() ? mapped_.get_size() : (uint64_t) buffer_.size());
+        uint32_t magic, version, num_files;
+        if (!read_u32(ptr, end, magic) || !read_u32(ptr, end, version) || !read_u32(ptr, end, num_files)
+            || magic != kModuleArchiveMagic || version != kModuleArchiveVersion)
+        {
+            JSB_LOG(Error, "bad module archive %s", p_path);
+            buffer_.clear();
+            mapped_.close();
+            return ERR_FILE_UNRECOGNIZED;
+        }
+
+        entries_.reserve(num_files);
+        for (uint32_t i = 0; i < num_files; ++i)
+        {
+            uint32_t path_len;
+            Entry entry;
+            if (!read_u32(ptr, end, path_len) || (uint64_t)(end - ptr) < path_len)
+            {
+                break;
+            }
+            String path;
+            path.parse_utf8((const char*) ptr, (int) path_len);
+            ptr += path_len;
+            if (!read_u32(ptr, end, entry.offset) || !read_u32(ptr, end, entry.length))
+            {
+                break;
+            }
+            entries_.insert(path, entry);
+            for (String dir = path.get_base_dir(); !dir.is_empty() && !dir.ends_with(":/") && !directories_.has(dir); dir = dir.get_base_dir())
+            {
+                directories_.insert(dir);
+            }
+        }
+
+        data_ = ptr;
+        const uint64_t data_size = end - ptr;
+        const bool corrupted = entries_.size() != num_files;
+        for (const KeyValue<String, Entry>& it : entries_)
+        {
+            if (corrupted || (uint64_t) it.value.offset + it.value.length > data_size)
+            {
+                JSB_LOG(Error, "corrupted module archive %s", p_path);
+                entries_.clear();
+                directories_.clear();
+                buffer_.clear();
+                mapped_.close();
+                data_ = nullptr;
+                return ERR_FILE_CORRUPT;
+            }
+        }
+        return OK;
+    }
+
+    bool ModuleArchive::get_file(const String& p_path, const uint8_t*& r_data, uint32_t& r_length) const
+    {
+        const HashMap<String, Entry>::ConstIterator it = entries_.find(p_path);
+        if (it == entries_.end())
+        {
+            return false;
+        }
+        r_data = data_ + it->value.offset;
+        r_length = it->value.length;
+        return true;
+    }
+
+    String ModuleArchive::get_file_as_string(const String& p_path) const
+    {
+        const uint8_t* data;
+        uint32_t length;
+        String str;
+        if (get_file(p_path, data, length))
+        {
+            str.parse_utf8((const char*) data, (int) length);
+        }
+        return str;
+    }
+
+    Vector<uint8_t> ModuleArchive::Writer::finish() const
+    {
+        // header
+        Vector<CharString> paths;
+        size_t header_size = 4 * 3;
+        size_t data_size = 0;
+        for (const KeyValue<String, Vector<uint8_t>>& it : files_)
+        {
+            paths.push_back(it.key.utf8());
+            header_size += 4 * 3 + paths[paths.size() - 1].length();
+            data_size += it.value.size();
+        }
+        jsb_check(header_size + data_size < UINT32_MAX);
+
+        Vector<uint8_t> content;
+        content.resize((int) (header_size + data_size));
+        uint8_t* ptr = content.ptrw();
+        ptr += encode_uint32(kModuleArchiveMagic, ptr);
+        ptr += encode_uint32(kModuleArchiveVersion, ptr);
+        ptr += encode_uint32((uint32_t) files_.size(), ptr);
+        uint32_t offset = 0;
+        int index = 0;
+        for (const KeyValue<String, Vector<uint8_t>>& it : files_)
+        {
+            const CharString& path = paths[index++];
+            ptr += encode_uint32((uint32_t) path.length(), ptr);
+            memcpy(ptr, path.get_data(), path.length());
+            ptr += path.length();
+            ptr += encode_uint32(offset, ptr);
+            ptr += encode_uint32((uint32_t) it.value.size(), ptr);
+            offset += (uint32_t) it.value.size();
+        }
+
+        // data
+        for (const KeyValue<String, Vector<uint8_t>>& it : files_)
+        {
+            memcpy(ptr, it.value.ptr(), it.value.size());
+            ptr += it.value.size();
+        }
+        return content;
+    }
+
+}
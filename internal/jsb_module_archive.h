@@ -0,0 +1,72 @@
+#ifndef GODOTJS_MODULE_ARCHIVE_H
+#define GODOTJS_MODULE_ARCHIVE_H
+#include "jsb_internal_pch.h"
+#include "jsb_macros.h"
+#include "jsb_mapped_file.h"
+
+namespace jsb::internal
+{
+    /**
+     * A read-only archive of module files (sources, package.json) packed by the exporter.
+     * It's mapped into memory if possible (or read with a single file access), and the files are served as views of the archive buffer.
+     * Layout (little endian):
+     *     magic, version, num_files, [path (pascal string), offset, length] * num_files, data
+     */
+    class ModuleArchive
+    {
+    public:
+        struct Entry
+        {
+            // offset in the data section
+            uint32_t offset;
+            uint32_t length;
+        };
+
+        // an archive being written by the exporter
+        class Writer
+        {
+            HashMap<String, Vector<uint8_t>> files_;
+
+        public:
+            jsb_force_inline bool has_file(const String& p_path) const { return files_.has(p_path); }
+            jsb_force_inline int size() const { return (int) files_.size(); }
+
+            void add_file(const String& p_path, const Vector<uint8_t>& p_content) { files_[p_path] = p_content; }
+
+            Vector<uint8_t> finish() const;
+        };
+
+    private:
+        Vector<uint8_t> buffer_;
+        MappedFile mapped_;
+        const uint8_t* data_ = nullptr;
+
+        HashMap<String, Entry> entries_;
+
+        // all parent directories of the files, they're considered existing in the archive
+        HashSet<String> directories_;
+
+    public:
+        // the archive packed in the exported project, null if not available (always null in editor)
+        static const ModuleArchive* get_packaged();
+
+        // the path of the archive packed in the exported project
+        static String get_packaged_path();
+
+        Error open(const String& p_path);
+
+        jsb_force_inline bool has_file(const String& p_path) const { return entries_.has(p_path); }
+        jsb_force_inline bool has_dir(const String& p_path) const { return directories_.has(p_path.trim_suffix("/")); }
+        jsb_force_inline int size() const { return (int) entries_.size(); }
+
+        /**
+         * \brief get the content of a file without copying
+         * \return true if the file is in the archive, the content is valid as long as the archive is alive
+         */
+        bool get_file(const String& p_path, const uint8_t*& r_data, uint32_t& r_length) const;
+
+        String get_file_as_string(const String& p_path) const;
+    };
+}
+
+#endif
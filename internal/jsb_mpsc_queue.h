@@ -0,0 +1,86 @@
+#ifndef GODOTJS_MPSC_QUEUE_H
+#define GODOTJS_MPSC_QUEUE_H
+#include "jsb_internal_pch.h"
+#include "jsb_macros.h"
+#include "jsb_logger.h"
+
+namespace jsb::internal
+{
+    // Unbounded lock-free queue with any number of producers and a single consumer (intrusive Vyukov queue).
+    // `add()` is wait-free (a single atomic exchange), `swap()` must only be called from the consumer thread.
+    // It's a drop-in replacement of `DoubleBuffered` for cross-thread message passing (worker inbox/outbox).
+    template<typename T>
+    struct MPSCQueue
+    {
+    private:
+        struct Node
+        {
+            std::atomic<Node*> next = nullptr;
+            std::optional<T> value;
+        };
+
+        // [producers] the most recently added node
+        std::atomic<Node*> head_;
+
+        // [consumer only] the stub node, all nodes after it are pending
+        Node* tail_;
+
+        // [consumer only] drained elements returned by `swap()`
+        // use std::vector because we need the move semantics
+        std::vector<T> drained_;
+
+    public:
+        MPSCQueue()
+        {
+            Node* stub = memnew(Node);
+            head_.store(stub, std::memory_order_relaxed);
+            tail_ = stub;
+        }
+
+        ~MPSCQueue()
+        {
+            bool discarded = !drained_.empty();
+            Node* node = tail_;
+            while (node)
+            {
+                Node* next = node->next.load(std::memory_order_acquire);
+                discarded |= !!next;
+                memdelete(node);
+                node = next;
+            }
+            if (discarded)
+            {
+                JSB_LOG(Warning, "discarding unhandled buffers");
+            }
+        }
+
+        MPSCQueue(const MPSCQueue&) = delete;
+        MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+        template<typename E>
+        void add(E&& p_element)
+        {
+            Node* node = memnew(Node);
+            node->value.emplace(std::forward<E>(p_element));
+            Node* prev = head_.exchange(node, std::memory_order_acq_rel);
+            prev->next.store(node, std::memory_order_release);
+        }
+
+        // take all elements which are completely added so far.
+        // a producer preempted in the middle of `add()` only delays its element to the next `swap()`.
+        std::vector<T>& swap()
+        {
+            while (Node* next = tail_->next.load(std::memory_order_acquire))
+            {
+                drained_.push_back(std::move(*next->value));
+                next->value.reset();
+                memdelete(tail_);
+                tail_ = next;
+            }
+            return drained_;
+        }
+    };
+
+}
+
+#endif
@@ -358,6 +358,80 @@ namespace jsb::internal
 		return ret;
 	}
 
+	namespace
+	{
+		enum class ENameKind : uint8_t
+		{
+			Class,
+			Enum,
+			EnumValue,
+			Member,
+			ScriptMethod,
+			Num,
+		};
+
+		struct NameCache
+		{
+			RWLock lock;
+			HashMap<StringName, StringName> names[(int) ENameKind::Num];
+		};
+
+		NameCache& get_name_cache()
+		{
+			static NameCache cache;
+			return cache;
+		}
+
+		template<typename TConverter>
+		StringName get_cached_name(ENameKind p_kind, const StringName& p_original_name, TConverter p_converter)
+		{
+			NameCache& cache = get_name_cache();
+			HashMap<StringName, StringName>& names = cache.names[(int) p_kind];
+			{
+				RWLockRead lock(cache.lock);
+				if (const StringName* it = names.getptr(p_original_name))
+				{
+					return *it;
+				}
+			}
+
+			// converted out of the lock, another thread may insert the same result in the meantime
+			const StringName converted_name = p_converter(p_original_name);
+			RWLockWrite lock(cache.lock);
+			names.insert(p_original_name, converted_name);
+			return converted_name;
+		}
+	}
+
+	StringName NamingUtil::get_class_name(const StringName& p_original_name)
+	{
+		return get_cached_name(ENameKind::Class, p_original_name, [](const StringName& p_name) { return get_class_name((String) p_name); });
+	}
+
+	StringName NamingUtil::get_enum_name(const StringName& p_original_name)
+	{
+		return get_cached_name(ENameKind::Enum, p_original_name, [](const StringName& p_name) { return get_enum_name((String) p_name); });
+	}
+
+	StringName NamingUtil::get_enum_value_name(const StringName& p_original_name)
+	{
+		return get_cached_name(ENameKind::EnumValue, p_original_name, [](const StringName& p_name) { return get_enum_value_name((String) p_name); });
+	}
+
+	StringName NamingUtil::get_member_name(const StringName& p_original_name)
+	{
+		return get_cached_name(ENameKind::Member, p_original_name, [](const StringName& p_name) { return get_member_name((String) p_name); });
+	}
+
+	StringName NamingUtil::get_script_method_name(const StringName& p_method)
+	{
+		return get_cached_name(ENameKind::ScriptMethod, p_method, [](const StringName& p_name)
+		{
+			const String name = p_name;
+			return name.begins_with("_") ? StringName(get_member_name(name)) : p_name;
+		});
+	}
+
 	List<StringName> NamingUtil::get_exposed_original_class_list()
 	{
 #ifdef TOOLS_ENABLED
@@ -19,6 +19,19 @@ namespace jsb::internal
 
 		static bool is_original_class_exposed(const String& p_original_name);
 
+		// memoized conversions of engine names, shared by all environments and workers (the result of each name is converted only once per process).
+		// `camel_case_bindings_enabled` requires a restart, so the cached results never go stale.
+		static StringName get_class_name(const StringName& p_original_name);
+		static StringName get_enum_name(const StringName& p_original_name);
+		static StringName get_enum_value_name(const StringName& p_original_name);
+		static StringName get_member_name(const StringName& p_original_name);
+
+		// the exposed name of a method called by the engine, `_` prefixed names (godot virtuals) follow the member naming and others are used as-is (memoized)
+		static StringName get_script_method_name(const StringName& p_method);
+
+		static String get_class_name(const char* p_original_name) { return get_class_name(String(p_original_name)); }
+		static String get_member_name(const char* p_original_name) { return get_member_name(String(p_original_name)); }
+
 		static String get_class_name(const String& p_original_name)
 		{
 			if (Settings::get_camel_case_bindings_enabled())
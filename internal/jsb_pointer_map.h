@@ -0,0 +1,157 @@
+#ifndef GODOTJS_POINTER_MAP_H
+#define GODOTJS_POINTER_MAP_H
+
+#include "../compat/jsb_compat.h"
+#include "jsb_macros.h"
+
+namespace jsb::internal
+{
+    /**
+     * A hash map keyed by (non-null) pointers with open addressing (linear probing).
+     * All entries are stored inline in a single array, so that a lookup usually touches only one cache line.
+     * Removal shifts the following entries of the probe sequence back (no tombstones).
+     */
+    template<typename TValue>
+    class PointerMap
+    {
+        static_assert(std::is_trivially_copyable_v<TValue>);
+
+        enum { kMinCapacity = 16 };
+
+        struct Entry
+        {
+            // nullptr for empty entries
+            void* key;
+            TValue value;
+        };
+
+        Entry* entries_ = nullptr;
+        uint32_t mask_ = 0;
+        uint32_t size_ = 0;
+        uint32_t shift_ = 0;
+
+        // fibonacci hashing, the lower bits of pointers are mostly zero for the sake of alignment
+        jsb_force_inline uint32_t home_of(const void* p_key) const
+        {
+            return (uint32_t) (((uint64_t) (uintptr_t) p_key * 0x9E3779B97F4A7C15ULL) >> shift_);
+        }
+
+        jsb_force_inline int64_t find_index(const void* p_key) const
+        {
+            if (jsb_unlikely(!entries_)) return -1;
+            for (uint32_t index = home_of(p_key); ; index = (index + 1) & mask_)
+            {
+                const Entry& entry = entries_[index];
+                if (entry.key == p_key) return index;
+                if (!entry.key) return -1;
+            }
+        }
+
+        void rehash(uint32_t p_capacity)
+        {
+            jsb_check(p_capacity >= kMinCapacity && (p_capacity & (p_capacity - 1)) == 0);
+            Entry* old_entries = entries_;
+            const uint32_t old_capacity = entries_ ? mask_ + 1 : 0;
+
+            entries_ = (Entry*) memalloc(sizeof(Entry) * p_capacity);
+            memset((void*) entries_, 0, sizeof(Entry) * p_capacity);
+            mask_ = p_capacity - 1;
+            shift_ = 64;
+            for (uint32_t n = p_capacity; n > 1; n >>= 1) --shift_;
+            for (uint32_t i = 0; i < old_capacity; ++i)
+            {
+                if (const Entry& entry = old_entries[i]; entry.key)
+                {
+                    uint32_t index = home_of(entry.key);
+                    while (entries_[index].key) index = (index + 1) & mask_;
+                    entries_[index] = entry;
+                }
+            }
+            if (old_entries) memfree(old_entries);
+        }
+
+    public:
+        PointerMap() = default;
+        PointerMap(const PointerMap&) = delete;
+        PointerMap& operator=(const PointerMap&) = delete;
+
+        ~PointerMap()
+        {
+            if (entries_) memfree(entries_);
+        }
+
+        jsb_force_inline uint32_t size() const { return size_; }
+        jsb_force_inline uint32_t capacity() const { return entries_ ? mask_ + 1 : 0; }
+
+        // make room for `p_num` entries without rehashing (the load factor is kept under 1/2)
+        void reserve(uint32_t p_num)
+        {
+            const uint32_t capacity = MAX((uint32_t) kMinCapacity, next_power_of_2(p_num * 2));
+            if (capacity > this->capacity())
+            {
+                rehash(capacity);
+            }
+        }
+
+        jsb_force_inline bool has(const void* p_key) const { return find_index(p_key) >= 0; }
+
+        jsb_force_inline const TValue* getptr(const void* p_key) const
+        {
+            const int64_t index = find_index(p_key);
+            return index >= 0 ? &entries_[index].value : nullptr;
+        }
+
+        jsb_force_inline TValue* getptr(const void* p_key)
+        {
+            const int64_t index = find_index(p_key);
+            return index >= 0 ? &entries_[index].value : nullptr;
+        }
+
+        // the key must not exist in the map
+        void insert(void* p_key, const TValue& p_value)
+        {
+            jsb_check(p_key && !has(p_key));
+            if ((size_ + 1) * 2 > capacity())
+            {
+                rehash(MAX((uint32_t) kMinCapacity, capacity() * 2));
+            }
+            uint32_t index = home_of(p_key);
+            while (entries_[index].key) index = (index + 1) & mask_;
+            entries_[index] = { p_key, p_value };
+            ++size_;
+        }
+
+        bool erase(const void* p_key)
+        {
+            const int64_t found = find_index(p_key);
+            if (found < 0)
+            {
+                return false;
+            }
+
+            uint32_t hole = (uint32_t) found;
+            for (uint32_t next = (hole + 1) & mask_; entries_[next].key; next = (next + 1) & mask_)
+            {
+                // move it back into the hole unless its home is between the hole and itself (cyclically)
+                const uint32_t home = home_of(entries_[next].key);
+                if (((next - home) & mask_) >= ((next - hole) & mask_))
+                {
+                    entries_[hole] = entries_[next];
+                    hole = next;
+                }
+            }
+            entries_[hole].key = nullptr;
+            --size_;
+            return true;
+        }
+
+        void clear()
+        {
+            if (size_ == 0) return;
+            memset((void*) entries_, 0, sizeof(Entry) * capacity());
+            size_ = 0;
+        }
+    };
+}
+
+#endif
@@ -57,6 +57,7 @@ namespace jsb::internal
                 uncompressed_data_ = p_other.uncompressed_data_;
                 data_size_ = p_other.data_size_;
                 data_ = p_other.data_;
+                is_zero_terminated_ = p_other.is_zero_terminated_;
 
                 p_other.filename_ = String();
                 p_other.uncompressed_data_ = {};
@@ -76,6 +77,7 @@ namespace jsb::internal
                 uncompressed_data_ = p_other.uncompressed_data_;
                 data_size_ = p_other.data_size_;
                 data_ = p_other.data_;
+                is_zero_terminated_ = p_other.is_zero_terminated_;
             }
             return *this;
         }
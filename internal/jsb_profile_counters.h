@@ -0,0 +1,155 @@
+#ifndef GODOTJS_PROFILE_COUNTERS_H
+#define GODOTJS_PROFILE_COUNTERS_H
+#include "jsb_internal_pch.h"
+#include "jsb_macros.h"
+
+namespace jsb::internal
+{
+    /**
+     * Per-thread [time, calls] counters indexed by dense integer ids (no lock, no lookup on `add`).
+     * Each thread only writes its own counters (single writer), the counters are monotonic,
+     * and the reader (`collect`) sums the counters of all threads.
+     * The counters of a thread are kept until the ProfileCounters is destroyed (even if the thread exits).
+     */
+    class ProfileCounters
+    {
+    public:
+        enum : uint32_t
+        {
+            kChunkSize = 256,
+            kMaxChunks = 256,
+            kMaxCounters = kChunkSize * kMaxChunks,
+        };
+
+        struct Value
+        {
+            uint64_t time = 0;
+            uint64_t calls = 0;
+        };
+
+    private:
+        struct Chunk
+        {
+            std::atomic<uint64_t> time[kChunkSize];
+            std::atomic<uint64_t> calls[kChunkSize];
+
+            Chunk()
+            {
+                for (uint32_t i = 0; i < kChunkSize; ++i)
+                {
+                    time[i].store(0, std::memory_order_relaxed);
+                    calls[i].store(0, std::memory_order_relaxed);
+                }
+            }
+        };
+
+        struct ThreadCounters
+        {
+            std::atomic<Chunk*> chunks[kMaxChunks];
+            ThreadCounters* next = nullptr;
+
+            ThreadCounters()
+            {
+                for (uint32_t i = 0; i < kMaxChunks; ++i) chunks[i].store(nullptr, std::memory_order_relaxed);
+            }
+
+            ~ThreadCounters()
+            {
+                for (uint32_t i = 0; i < kMaxChunks; ++i)
+                {
+                    if (Chunk* chunk = chunks[i].load(std::memory_order_relaxed)) memdelete(chunk);
+                }
+            }
+        };
+
+        // lock-free list of the counters of all threads (push only)
+        std::atomic<ThreadCounters*> threads_ = nullptr;
+
+        // identifies this instance in the thread local cache (the address may be reused by a new instance)
+        const uint64_t instance_id_ = next_instance_id();
+
+        static uint64_t next_instance_id()
+        {
+            static std::atomic<uint64_t> last_id = 0;
+            return ++last_id;
+        }
+
+        ThreadCounters* get_thread_counters()
+        {
+            struct Cache
+            {
+                uint64_t owner = 0;
+                ThreadCounters* counters = nullptr;
+            };
+            static thread_local Cache cache;
+            if (jsb_likely(cache.owner == instance_id_)) return cache.counters;
+
+            ThreadCounters* counters = memnew(ThreadCounters);
+            ThreadCounters* head = threads_.load(std::memory_order_relaxed);
+            do
+            {
+                counters->next = head;
+            } while (!threads_.compare_exchange_weak(head, counters, std::memory_order_release, std::memory_order_relaxed));
+            cache = { instance_id_, counters };
+            return counters;
+        }
+
+    public:
+        ProfileCounters() = default;
+        ProfileCounters(const ProfileCounters&) = delete;
+        ProfileCounters& operator=(const ProfileCounters&) = delete;
+
+        ~ProfileCounters()
+        {
+            ThreadCounters* it = threads_.load(std::memory_order_acquire);
+            while (it)
+            {
+                ThreadCounters* next = it->next;
+                memdelete(it);
+                it = next;
+            }
+        }
+
+        // [any thread]
+        void add(uint32_t p_id, uint64_t p_time)
+        {
+            if (jsb_unlikely(p_id >= kMaxCounters)) return;
+            ThreadCounters* counters = get_thread_counters();
+            std::atomic<Chunk*>& slot = counters->chunks[p_id / kChunkSize];
+            Chunk* chunk = slot.load(std::memory_order_relaxed);
+            if (jsb_unlikely(!chunk))
+            {
+                chunk = memnew(Chunk);
+                slot.store(chunk, std::memory_order_release);
+            }
+
+            // only this thread writes to them, load + store is enough
+            const uint32_t index = p_id % kChunkSize;
+            chunk->time[index].store(chunk->time[index].load(std::memory_order_relaxed) + p_time, std::memory_order_relaxed);
+            chunk->calls[index].store(chunk->calls[index].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+
+        // [any thread] the sum of counters [0, p_count) of all threads
+        void collect(uint32_t p_count, LocalVector<Value>& r_values) const
+        {
+            p_count = MIN(p_count, (uint32_t) kMaxCounters);
+            r_values.resize(p_count);
+            for (Value& value : r_values) value = {};
+            for (const ThreadCounters* it = threads_.load(std::memory_order_acquire); it; it = it->next)
+            {
+                for (uint32_t chunk_index = 0, chunk_num = (p_count + kChunkSize - 1) / kChunkSize; chunk_index < chunk_num; ++chunk_index)
+                {
+                    const Chunk* chunk = it->chunks[chunk_index].load(std::memory_order_acquire);
+                    if (!chunk) continue;
+                    for (uint32_t index = 0, base = chunk_index * kChunkSize, n = MIN((uint32_t) kChunkSize, p_count - base); index < n; ++index)
+                    {
+                        r_values[base + index].time += chunk->time[index].load(std::memory_order_relaxed);
+                        r_values[base + index].calls += chunk->calls[index].load(std::memory_order_relaxed);
+                    }
+                }
+            }
+        }
+    };
+}
+
+#endif
@@ -2,52 +2,67 @@
 #include "jsb_macros.h"
 #include "jsb_logger.h"
 
-#if 0
+#include "core/io/resource_uid.h"
+
 namespace jsb::internal
 {
-    Ref<PackedScene> ResourceCache::get_packed_scene(const String& p_path, Error& r_error)
+    Ref<Resource> ResourceCache::get(const String& p_path, const String& p_type_hint, Error& r_error)
     {
-        MutexLock lock(mutex);
-
-        const String path = p_path.begins_with("uid://")
-            ? ResourceUID::get_singleton()->get_id_path(ResourceUID::get_singleton()->text_to_id(p_path))
-            : p_path;
-
-        if (ObjectID* object_id = packed_scenes.getptr(path))
+        String path = p_path;
+        if (p_path.begins_with("uid://"))
         {
-            if (Object* obj = jsb::compat::ObjectDB::get_instance(*object_id))
+            if (const String* resolved = uid_paths_.getptr(p_path))
             {
-                PackedScene* scene = Object::cast_to<PackedScene>(obj);
-                jsb_check(scene);
-                return { scene };
+                path = *resolved;
+            }
+            else
+            {
+                const ResourceUID::ID id = ResourceUID::get_singleton()->text_to_id(p_path);
+                if (id == ResourceUID::INVALID_ID || !ResourceUID::get_singleton()->has_id(id))
+                {
+                    r_error = ERR_FILE_BAD_PATH;
+                    return {};
+                }
+                path = ResourceUID::get_singleton()->get_id_path(id);
+                uid_paths_.insert(p_path, path);
             }
-            JSB_LOG(Verbose, "cache expired (%s)", p_path);
         }
 
-        // see GDScriptCache::get_packed_scene
-        if (Ref<PackedScene> scene = ::ResourceCache::get_ref(path); scene.is_valid())
+        Ref<Resource> resource;
+        if (const Ref<Resource>* cached = resources_.getptr(path))
         {
-            packed_scenes[path] = scene->get_instance_id();
-            return scene;
+            resource = *cached;
         }
-
-        // fresh load
+        else
         {
-            Ref<PackedScene> scene;
-            scene.instantiate();
-            if (path.is_empty())
+            // see GDScriptCache::get_packed_scene
+            resource = ::ResourceCache::get_ref(path);
+            if (resource.is_null())
             {
-                r_error = ERR_FILE_BAD_PATH;
-                return scene;
+                Error err;
+                resource = ResourceLoader::load(path, p_type_hint, ResourceFormatLoader::CACHE_MODE_REUSE, &err);
+                if (resource.is_null())
+                {
+                    r_error = err == OK ? ERR_CANT_OPEN : err;
+                    return {};
+                }
             }
-            scene->set_path(path);
-            packed_scenes[path] = scene->get_instance_id();
-            scene->reload_from_file();
-            r_error = OK;
-            return scene;
+            resources_.insert(path, resource);
+            JSB_LOG(VeryVerbose, "resource cached %s", path);
         }
+
+        if (!p_type_hint.is_empty() && !resource->is_class(p_type_hint))
+        {
+            r_error = ERR_INVALID_DATA;
+            return {};
+        }
+        r_error = OK;
+        return resource;
     }
 
+    void ResourceCache::clear()
+    {
+        resources_.clear();
+        uid_paths_.clear();
+    }
 }
-
-#endif
@@ -1,22 +1,31 @@
 #ifndef GODOTJS_RESOURCE_CACHE_H
 #define GODOTJS_RESOURCE_CACHE_H
-
-#if 0
 #include "jsb_internal_pch.h"
 
 namespace jsb::internal
 {
+    /**
+     * Strong references of the resources preloaded by scripts (`jsb.preload`), keyed by path (`uid://` paths are resolved first).
+     * The lookups of the same path skip ResourceLoader entirely. It's owned by an environment and only accessed on its thread.
+     */
     class ResourceCache
     {
-        // a map of PackedScene, behaves like a weak ref
-        HashMap<String, ObjectID> packed_scenes;
+        HashMap<String, Ref<Resource>> resources_;
 
-        Mutex mutex;
+        // `uid://...` => the resolved path
+        HashMap<String, String> uid_paths_;
 
     public:
-        Ref<PackedScene> get_packed_scene(const String &p_path, Error &r_error);
+        /**
+         * \param p_type_hint (optional) the expected class of the resource
+         * \return null with `r_error` set if it can't be loaded
+         */
+        Ref<Resource> get(const String& p_path, const String& p_type_hint, Error& r_error);
+
+        jsb_force_inline int size() const { return resources_.size(); }
+
+        void clear();
     };
 }
-#endif
 
 #endif
@@ -5,6 +5,7 @@
 
 #include "jsb_macros.h"
 #include "jsb_ansi_allocator.h"
+#include "jsb_chunked_allocator.h"
 #include "jsb_sindex.h"
 
 #include <cstddef>
@@ -51,9 +52,9 @@ namespace jsb::internal
         int _address_locked = 0;
         AllocatorType allocator;
 
-        Slot* get_data() const
+        jsb_force_inline Slot& slot_at(int p_index) const
         {
-            return (Slot*)allocator.get_data();
+            return allocator.at(p_index);
         }
 
     public:
@@ -175,7 +176,7 @@ namespace jsb::internal
                     return false;
                 }
 #if JSB_SARRAY_DEBUG
-                return container.get_data()[p_slot_index].has_value();
+                return container.slot_at(p_slot_index).has_value();
 #else
                 return true;
 #endif
@@ -183,12 +184,12 @@ namespace jsb::internal
 
             T& get_slot_value(int p_slot_index)
             {
-                return container.get_data()[p_slot_index].value;
+                return container.slot_at(p_slot_index).value;
             }
 
             const T& get_slot_value(int p_slot_index) const
             {
-                return container.get_data()[p_slot_index].value;
+                return container.slot_at(p_slot_index).value;
             }
 
         private:
@@ -212,7 +213,7 @@ namespace jsb::internal
             {
                 while (_first_index != INDEX_NONE)
                 {
-                    Slot& slot = get_data()[_first_index];
+                    Slot& slot = slot_at(_first_index);
                     const int next = slot.next;
 #if JSB_SARRAY_DEBUG
                     jsb_check(slot.has_value());
@@ -245,11 +246,10 @@ namespace jsb::internal
             {
                 return;
             }
-            Slot* slots_base = get_data();
             while (_first_index != INDEX_NONE)
             {
                 const int index = _first_index;
-                Slot& slot = slots_base[index];
+                Slot& slot = slot_at(index);
 
                 // invalidate the revision before destructor to avoid getting from the same position during destructing
                 IndexType::increase_revision(slot.revision);
@@ -273,27 +273,26 @@ namespace jsb::internal
         {
             int forward = _first_index;
             int backward = _last_index;
-            Slot* slots_base = get_data();
             while (forward != backward)
             {
                 jsb_check(forward >= 0 && backward >= 0);
-                SWAP(slots_base[forward].value, slots_base[backward].value);
-                forward = slots_base[forward].next;
-                backward = slots_base[backward].previous;
+                SWAP(slot_at(forward).value, slot_at(backward).value);
+                forward = slot_at(forward).next;
+                backward = slot_at(backward).previous;
             }
         }
 
         IndexType get_first_index() const
         {
             return _first_index != INDEX_NONE
-                       ? IndexType(_first_index, get_data()[_first_index].revision)
+                       ? IndexType(_first_index, slot_at(_first_index).revision)
                        : IndexType::none();
         }
 
         IndexType get_last_index() const
         {
             return _last_index != INDEX_NONE
-                       ? IndexType(_last_index, get_data()[_last_index].revision)
+                       ? IndexType(_last_index, slot_at(_last_index).revision)
                        : IndexType::none();
         }
 
@@ -305,11 +304,11 @@ namespace jsb::internal
                 return;
             }
 
-            const Slot& slot = get_data()[p_index.get_index()];
+            const Slot& slot = slot_at(p_index.get_index());
             if (slot.next != INDEX_NONE)
             {
-                jsb_check(get_data()[slot.next].previous == p_index.get_index());
-                o_next = IndexType(slot.next, get_data()[slot.next].revision);
+                jsb_check(slot_at(slot.next).previous == p_index.get_index());
+                o_next = IndexType(slot.next, slot_at(slot.next).revision);
             }
             else
             {
@@ -317,8 +316,8 @@ namespace jsb::internal
             }
             if (slot.previous != INDEX_NONE)
             {
-                jsb_check(get_data()[slot.previous].next == p_index.get_index());
-                o_previous = IndexType(slot.previous, get_data()[slot.previous].revision);
+                jsb_check(slot_at(slot.previous).next == p_index.get_index());
+                o_previous = IndexType(slot.previous, slot_at(slot.previous).revision);
             }
             else
             {
@@ -329,11 +328,11 @@ namespace jsb::internal
         IndexType get_next_index(const IndexType& p_index) const
         {
             jsb_check(is_valid_index(p_index));
-            const Slot& slot = get_data()[p_index.get_index()];
+            const Slot& slot = slot_at(p_index.get_index());
             if (slot.next != INDEX_NONE)
             {
-                jsb_check(get_data()[slot.next].previous == p_index.get_index());
-                return IndexType(slot.next, get_data()[slot.next].revision);
+                jsb_check(slot_at(slot.next).previous == p_index.get_index());
+                return IndexType(slot.next, slot_at(slot.next).revision);
             }
             return IndexType::none();
         }
@@ -341,11 +340,11 @@ namespace jsb::internal
         IndexType get_previous_index(const IndexType& p_index) const
         {
             jsb_check(is_valid_index(p_index));
-            const Slot& slot = get_data()[p_index.get_index()];
+            const Slot& slot = slot_at(p_index.get_index());
             if (slot.previous != INDEX_NONE)
             {
-                jsb_check(get_data()[slot.previous].next == p_index.get_index());
-                return IndexType(slot.previous, get_data()[slot.previous].revision);
+                jsb_check(slot_at(slot.previous).next == p_index.get_index());
+                return IndexType(slot.previous, slot_at(slot.previous).revision);
             }
             return IndexType::none();
         }
@@ -353,12 +352,12 @@ namespace jsb::internal
         bool is_valid_index(const IndexType& p_index) const
         {
             const int index = p_index.get_index();
-            if (index < 0 || index >= capacity() || p_index.get_revision() == 0 || get_data()[index].revision != p_index.get_revision())
+            if (index < 0 || index >= capacity() || p_index.get_revision() == 0 || slot_at(index).revision != p_index.get_revision())
             {
                 return false;
             }
 #if JSB_SARRAY_DEBUG
-            jsb_check(get_data()[index].has_value());
+            jsb_check(slot_at(index).has_value());
 #endif
             return true;
         }
@@ -368,7 +367,7 @@ namespace jsb::internal
         {
             grow_if_needed(1);
             const int new_index = _free_index;
-            Slot& slot = get_data()[new_index];
+            Slot& slot = slot_at(new_index);
 
             IndexType::increase_revision(slot.revision);
 
@@ -382,7 +381,7 @@ namespace jsb::internal
             ++_used_size;
             if (_last_index != INDEX_NONE)
             {
-                Slot& last_slot = get_data()[_last_index];
+                Slot& last_slot = slot_at(_last_index);
                 last_slot.next = new_index;
             }
             if (_first_index == INDEX_NONE)
@@ -403,14 +402,14 @@ namespace jsb::internal
                 return;
             }
 
-            Slot& slot = get_data()[p_index.get_index()];
+            Slot& slot = slot_at(p_index.get_index());
             if (slot.previous != INDEX_NONE)
             {
-                get_data()[slot.previous].next = slot.next;
+                slot_at(slot.previous).next = slot.next;
             }
             if (slot.next != INDEX_NONE)
             {
-                get_data()[slot.next].previous = slot.previous;
+                slot_at(slot.next).previous = slot.previous;
             }
             if (_last_index == p_index.get_index())
             {
@@ -418,7 +417,7 @@ namespace jsb::internal
             }
             slot.previous = INDEX_NONE;
             slot.next = _first_index;
-            get_data()[_first_index].previous = p_index.get_index();
+            slot_at(_first_index).previous = p_index.get_index();
             _first_index = p_index.get_index();
             ++_version;
             jsb_check(is_consistent());
@@ -432,14 +431,14 @@ namespace jsb::internal
                 return;
             }
 
-            Slot& slot = get_data()[p_index.get_index()];
+            Slot& slot = slot_at(p_index.get_index());
             if (slot.previous != INDEX_NONE)
             {
-                get_data()[slot.previous].next = slot.next;
+                slot_at(slot.previous).next = slot.next;
             }
             if (slot.next != INDEX_NONE)
             {
-                get_data()[slot.next].previous = slot.previous;
+                slot_at(slot.next).previous = slot.previous;
             }
             if (_first_index == p_index.get_index())
             {
@@ -447,7 +446,7 @@ namespace jsb::internal
             }
             slot.next = INDEX_NONE;
             slot.previous = _last_index;
-            get_data()[_last_index].next = p_index.get_index();
+            slot_at(_last_index).next = p_index.get_index();
             _last_index = p_index.get_index();
             ++_version;
             jsb_check(is_consistent());
@@ -459,9 +458,9 @@ namespace jsb::internal
             jsb_check(is_valid_index(p_index));
             grow_if_needed(1);
 
-            Slot& pivot_slot = get_data()[p_index.get_index()];
+            Slot& pivot_slot = slot_at(p_index.get_index());
             const int new_index = _free_index;
-            Slot& new_slot = get_data()[new_index];
+            Slot& new_slot = slot_at(new_index);
 
             IndexType::increase_revision(new_slot.revision);
 
@@ -472,11 +471,11 @@ namespace jsb::internal
             new_slot.next = p_index.get_index();
             new_slot.previous = pivot_slot.previous;
             pivot_slot.previous = new_index;
-            jsb_check(get_data() + p_index.get_index() == &pivot_slot);
-            jsb_check(get_data()[p_index.get_index()].previous == pivot_slot.previous && pivot_slot.previous == new_index);
+            jsb_check(&slot_at(p_index.get_index()) == &pivot_slot);
+            jsb_check(slot_at(p_index.get_index()).previous == pivot_slot.previous && pivot_slot.previous == new_index);
             if (new_slot.previous != INDEX_NONE)
             {
-                Slot& previous_slot = get_data()[new_slot.previous];
+                Slot& previous_slot = slot_at(new_slot.previous);
                 previous_slot.next = new_index;
             }
             ++_used_size;
@@ -494,7 +493,7 @@ namespace jsb::internal
         {
             if (is_valid_index(p_index))
             {
-                Slot& slot = get_data()[p_index.get_index()];
+                Slot& slot = slot_at(p_index.get_index());
                 out_item = &slot.value;
                 return true;
             }
@@ -507,7 +506,7 @@ namespace jsb::internal
         {
             if (is_valid_index(p_index))
             {
-                const Slot& slot = get_data()[p_index.get_index()];
+                const Slot& slot = slot_at(p_index.get_index());
                 out_item = &slot.value;
                 return true;
             }
@@ -519,7 +518,7 @@ namespace jsb::internal
         {
             if (is_valid_index(p_index))
             {
-                Slot& slot = get_data()[p_index.get_index()];
+                Slot& slot = slot_at(p_index.get_index());
                 out_item = slot.value;
                 return true;
             }
@@ -539,7 +538,7 @@ namespace jsb::internal
         T pop()
         {
             jsb_check(_last_index != INDEX_NONE);
-            const Slot& slot = get_data()[_last_index];
+            const Slot& slot = slot_at(_last_index);
             const T item = std::move(slot.value);
             remove_at({_last_index, slot.revision});
             return item;
@@ -549,7 +548,7 @@ namespace jsb::internal
         IndexType remove_first()
         {
             jsb_check(_first_index != INDEX_NONE);
-            const Slot& slot = get_data()[_first_index];
+            const Slot& slot = slot_at(_first_index);
             const IndexType index = {_first_index, slot.revision};
             remove_at(index);
             return index;
@@ -559,7 +558,7 @@ namespace jsb::internal
         IndexType remove_last()
         {
             jsb_check(_last_index != INDEX_NONE);
-            const Slot& slot = get_data()[_last_index];
+            const Slot& slot = slot_at(_last_index);
             const IndexType index = {_last_index, slot.revision};
             remove_at(index);
             return index;
@@ -595,7 +594,7 @@ namespace jsb::internal
             jsb_check(p_index.get_revision() != 0);
             jsb_check(p_index.get_index() >= 0);
             jsb_check(p_index.get_index() < capacity());
-            Slot& slot = get_data()[p_index.get_index()];
+            Slot& slot = slot_at(p_index.get_index());
             jsb_check(p_index.get_revision() == slot.revision);
             return slot.value;
         }
@@ -604,7 +603,7 @@ namespace jsb::internal
         {
             jsb_check(p_index.get_index() >= 0);
             jsb_check(p_index.get_index() < capacity());
-            const Slot& slot = get_data()[p_index.get_index()];
+            const Slot& slot = slot_at(p_index.get_index());
             jsb_check(p_index.get_revision() == slot.revision);
             return slot.value;
         }
@@ -613,7 +612,7 @@ namespace jsb::internal
         {
             if (p_index.get_index() >= 0 && p_index.get_index() < capacity())
             {
-                const Slot& slot = get_data()[p_index.get_index()];
+                const Slot& slot = slot_at(p_index.get_index());
                 if (p_index.get_revision() == slot.revision)
                 {
                     o_value = slot.value;
@@ -635,7 +634,7 @@ namespace jsb::internal
             int current = _first_index;
             while (current != INDEX_NONE)
             {
-                const Slot& slot = get_data()[current];
+                const Slot& slot = slot_at(current);
                 if (slot.value == p_item)
                 {
                     return IndexType(current, slot.revision);
@@ -651,7 +650,7 @@ namespace jsb::internal
             int current = _last_index;
             while (current != INDEX_NONE)
             {
-                const Slot& slot = get_data()[current];
+                const Slot& slot = slot_at(current);
                 if (slot.value == p_item)
                 {
                     return IndexType(current, slot.revision);
@@ -679,7 +678,7 @@ namespace jsb::internal
             {
                 return false;
             }
-            Slot& slot = get_data()[p_index.get_index()];
+            Slot& slot = slot_at(p_index.get_index());
             if (slot.revision != p_index.get_revision())
             {
                 return false;
@@ -706,11 +705,11 @@ namespace jsb::internal
 
             if (next != INDEX_NONE)
             {
-                get_data()[next].previous = previous;
+                slot_at(next).previous = previous;
             }
             if (previous != INDEX_NONE)
             {
-                get_data()[previous].next = next;
+                slot_at(previous).next = next;
             }
             if (_first_index == p_index.get_index())
             {
@@ -752,13 +751,13 @@ namespace jsb::internal
                 return;
             }
 
-            const int new_capacity = std::max(std::max(current_size * 2, 4), expected_size);
+            // the chunked allocator only appends chunks (rounded up by itself), no need to reserve more in advance
+            const int new_capacity = AllocatorType::kStableAddress ? expected_size : std::max(std::max(current_size * 2, 4), expected_size);
             allocator.resize(current_size, new_capacity);
-            jsb_check(new_capacity == capacity());
-            Slot* slots_base = get_data();
-            for (int i = current_size; i < new_capacity; ++i)
+            jsb_check(new_capacity <= capacity());
+            for (int i = current_size, n = capacity(); i < n; ++i)
             {
-                Slot& slot = slots_base[i];
+                Slot& slot = slot_at(i);
 #if JSB_SARRAY_DEBUG
                 jsb_check(!slot.has_value());
 #endif
@@ -916,8 +915,8 @@ namespace jsb::internal
             int index = other._first_index;
             while (index != INDEX_NONE)
             {
-                add(other.get_data()[index].value);
-                index = other.get_data()[index].next;
+                add(other.slot_at(index).value);
+                index = other.slot_at(index).next;
             }
             return *this;
         }
@@ -936,12 +935,12 @@ namespace jsb::internal
             int rhs_index = rhs._first_index;
             while (lhs_index != INDEX_NONE && rhs_index != INDEX_NONE)
             {
-                if (lhs.get_data()[lhs_index].value != rhs.get_data()[rhs_index].value)
+                if (lhs.slot_at(lhs_index).value != rhs.slot_at(rhs_index).value)
                 {
                     return false;
                 }
-                lhs_index = lhs.get_data()[lhs_index].next;
-                rhs_index = rhs.get_data()[rhs_index].next;
+                lhs_index = lhs.slot_at(lhs_index).next;
+                rhs_index = rhs.slot_at(rhs_index).next;
             }
             return true;
         }
@@ -952,8 +951,9 @@ namespace jsb::internal
         }
 
     private:
-        jsb_force_inline void lock_address() { ++_address_locked; }
-        jsb_force_inline void unlock_address() { jsb_check(_address_locked > 0); --_address_locked; }
+        // addresses are never moved by the chunked allocator, nothing to guard
+        jsb_force_inline void lock_address() { if constexpr (!AllocatorType::kStableAddress) ++_address_locked; }
+        jsb_force_inline void unlock_address() { if constexpr (!AllocatorType::kStableAddress) { jsb_check(_address_locked > 0); --_address_locked; } }
 
 #if JSB_SARRAY_CONSISTENCY_CHECK
         bool is_consistent() const
@@ -962,7 +962,7 @@ namespace jsb::internal
             int count = 0;
             while (index != INDEX_NONE)
             {
-                const Slot& slot = get_data()[index];
+                const Slot& slot = slot_at(index);
                 index = slot.next;
                 ++count;
             }
@@ -973,7 +973,7 @@ namespace jsb::internal
                 index = _first_index;
                 while (index != INDEX_NONE)
                 {
-                    const Slot& slot = get_data()[index];
+                    const Slot& slot = slot_at(index);
                     jsb_check(is_valid_index({ index, slot.revision }));
                     if (index == _first_index)
                     {
@@ -981,11 +981,11 @@ namespace jsb::internal
                     }
                     if (slot.next != INDEX_NONE)
                     {
-                        jsb_check(get_data()[slot.next].previous == index);
+                        jsb_check(slot_at(slot.next).previous == index);
                     }
                     if (slot.previous != INDEX_NONE)
                     {
-                        jsb_check(get_data()[slot.previous].next == index);
+                        jsb_check(slot_at(slot.previous).next == index);
                     }
                     ++count;
                     jsb_check(count <= _used_size);
@@ -0,0 +1,40 @@
+#include "jsb_scratch_arena.h"
+
+namespace jsb::internal
+{
+    ScratchArena::ScratchArena()
+    {
+        update_current();
+    }
+
+    ScratchArena::~ScratchArena()
+    {
+        jsb_check(block_ == 0 && offset_ == 0);
+        for (const Block& block : blocks_)
+        {
+            memfree(block.data);
+        }
+    }
+
+    void* ScratchArena::alloc_slow(size_t p_size)
+    {
+        // the blocks after the current one are never in use, take the next one or replace it if it's too small
+        const uint32_t next = block_;
+        const size_t size = MAX((size_t) kBlockSize, next_power_of_2((uint32_t) p_size));
+        if (next == blocks_.size())
+        {
+            blocks_.push_back({ (uint8_t*) memalloc(size), size });
+        }
+        else if (blocks_[next].size < p_size)
+        {
+            memfree(blocks_[next].data);
+            blocks_[next] = { (uint8_t*) memalloc(size), size };
+        }
+
+        // the rest of the current block is wasted until the scope exits
+        block_ = next + 1;
+        offset_ = p_size;
+        update_current();
+        return data_;
+    }
+}
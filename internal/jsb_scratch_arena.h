@@ -0,0 +1,124 @@
+#ifndef GODOTJS_SCRATCH_ARENA_H
+#define GODOTJS_SCRATCH_ARENA_H
+
+#include "jsb_internal_pch.h"
+#include "jsb_inline_allocator.h"
+
+namespace jsb::internal
+{
+    /**
+     * A per-thread bump allocator for the transient buffers of marshaling (argument arrays, string conversions).
+     * Allocations are only valid in the `ScratchArena::Scope` they're made in, the scopes must be strictly nested on a thread
+     * (which is guaranteed if they're only used as local variables), and the memory is released all at once when the scope exits.
+     * The first block is inline in the thread local storage, the bigger blocks allocated on demand are kept for reuse,
+     * so it stops touching the heap allocator once the peak usage is reached.
+     * NOTE: no constructor or destructor is called, the callers construct/destruct the elements (like `jsb_stackalloc`).
+     */
+    class ScratchArena
+    {
+    public:
+        enum : size_t
+        {
+            kInlineSize = JSB_SCRATCH_ARENA_INLINE_SIZE,
+            kBlockSize = JSB_SCRATCH_ARENA_BLOCK_SIZE,
+            kAlignment = alignof(std::max_align_t),
+        };
+
+        struct Marker
+        {
+            uint32_t block;
+            size_t offset;
+        };
+
+        class Scope
+        {
+            ScratchArena& arena_;
+            const Marker marker_;
+
+        public:
+            jsb_force_inline Scope() : arena_(ScratchArena::get()), marker_(arena_.mark()) {}
+            jsb_force_inline ~Scope() { arena_.reset(marker_); }
+
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+
+            // uninitialized memory for `p_num` elements of T (nullptr if `p_num` is 0)
+            template<typename T>
+            jsb_force_inline T* alloc(size_t p_num)
+            {
+                static_assert(alignof(T) <= kAlignment);
+                return (T*) arena_.alloc(sizeof(T) * p_num);
+            }
+        };
+
+        static jsb_force_inline ScratchArena& get()
+        {
+            static thread_local ScratchArena arena;
+            return arena;
+        }
+
+        ~ScratchArena();
+
+        jsb_force_inline Marker mark() const { return { block_, offset_ }; }
+        jsb_force_inline void reset(const Marker& p_marker)
+        {
+            jsb_check(p_marker.block < block_ || (p_marker.block == block_ && p_marker.offset <= offset_));
+            block_ = p_marker.block;
+            offset_ = p_marker.offset;
+            update_current();
+        }
+
+        jsb_force_inline void* alloc(size_t p_size)
+        {
+            if (jsb_unlikely(p_size == 0)) return nullptr;
+            const size_t size = (p_size + kAlignment - 1) & ~(size_t)(kAlignment - 1);
+            if (jsb_likely(size <= capacity_ - offset_))
+            {
+                void* ptr = data_ + offset_;
+                offset_ += size;
+                return ptr;
+            }
+            return alloc_slow(size);
+        }
+
+        // number of heap blocks allocated (for statistics)
+        uint32_t get_block_count() const { return (uint32_t) blocks_.size(); }
+
+    private:
+        struct Block
+        {
+            uint8_t* data;
+            size_t size;
+        };
+
+        ScratchArena();
+
+        void* alloc_slow(size_t p_size);
+
+        jsb_force_inline void update_current()
+        {
+            if (block_ == 0)
+            {
+                data_ = inline_.get_data();
+                capacity_ = kInlineSize;
+            }
+            else
+            {
+                const Block& block = blocks_[block_ - 1];
+                data_ = block.data;
+                capacity_ = block.size;
+            }
+        }
+
+        // the current block, 0 is the inline one, `blocks_[block_ - 1]` otherwise
+        uint32_t block_ = 0;
+        size_t offset_ = 0;
+        uint8_t* data_ = nullptr;
+        size_t capacity_ = 0;
+
+        alignas(kAlignment) InlineAllocator<kInlineSize>::ForType<uint8_t> inline_;
+        LocalVector<Block> blocks_;
+    };
+}
+
+#endif
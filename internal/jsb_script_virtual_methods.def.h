@@ -0,0 +1,20 @@
+#ifndef DEF
+#define DEF(x)
+#endif
+
+// godot virtual methods which are dispatched by a fixed index of ScriptVirtualMethod (see ScriptClassInfo::virtual_methods)
+// ONLY FREQUENTLY CALLED VIRTUALS SHOULD BE LISTED HERE (at most 32)
+
+DEF(_notification)
+DEF(_ready)
+DEF(_enter_tree)
+DEF(_exit_tree)
+DEF(_process)
+DEF(_physics_process)
+DEF(_input)
+DEF(_shortcut_input)
+DEF(_unhandled_input)
+DEF(_unhandled_key_input)
+DEF(_gui_input)
+DEF(_draw)
+DEF(_integrate_forces)
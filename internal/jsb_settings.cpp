@@ -4,6 +4,8 @@
 #include "jsb_macros.h"
 #include "jsb_logger.h"
 
+#include "servers/display_server.h"
+
 #define JSB_SET_RESTART(val) (val)
 #define JSB_SET_IGNORE_DOCS(val) (val)
 #define JSB_SET_BASIC(val) (val)
@@ -20,21 +22,61 @@ namespace jsb::internal
     static constexpr char kEdAutogenResourceDTSOnSave[] =     JSB_MODULE_NAME_STRING "/codegen/autogen_resource_dts_on_save";
     static constexpr char kEdGenResourceDTS[] =     JSB_MODULE_NAME_STRING "/codegen/generate_resource_dts";
     static constexpr char kEdCodegenUseProjectSettings[] =     JSB_MODULE_NAME_STRING "/codegen/use_project_settings";
+    static constexpr char kEdScriptClassCache[] =     JSB_MODULE_NAME_STRING "/editor/script_class_cache";
+    static constexpr char kEdTranspileOnChange[] =     JSB_MODULE_NAME_STRING "/editor/transpile_on_change";
 #endif
 
     // use unnecessary first category layer (runtime and editor) to make the second layer shown as sections in project settings
 
     static constexpr char kRtDebuggerPort[] =     JSB_MODULE_NAME_STRING "/runtime/debugger/debugger_port";
+    static constexpr char kRtSamplingProfilerIntervalUsec[] = JSB_MODULE_NAME_STRING "/runtime/debugger/sampling_profiler_interval_usec";
+    static constexpr char kRtTraceEventsPath[] = JSB_MODULE_NAME_STRING "/runtime/debugger/trace_events_path";
+    static constexpr char kRtMetricsPort[] = JSB_MODULE_NAME_STRING "/runtime/debugger/metrics_port";
+    static constexpr char kRtMetricsIntervalMsec[] = JSB_MODULE_NAME_STRING "/runtime/debugger/metrics_interval_msec";
     static constexpr char kRtSourceMapEnabled[] = JSB_MODULE_NAME_STRING "/runtime/logger/source_map_enabled";
+    static constexpr char kRtAsyncSymbolication[] = JSB_MODULE_NAME_STRING "/runtime/logger/async_symbolication";
+    static constexpr char kRtBufferedConsoleOutput[] = JSB_MODULE_NAME_STRING "/runtime/logger/buffered_console_output";
+    static constexpr char kRtConsoleMinSeverity[] = JSB_MODULE_NAME_STRING "/runtime/logger/console_min_severity";
     static constexpr char kRtAdditionalSearchPaths[] = JSB_MODULE_NAME_STRING "/runtime/core/additional_search_paths";
     static constexpr char kRtEntryScriptPath[] = JSB_MODULE_NAME_STRING "/runtime/core/entry_script_path";
     static constexpr char kRtCamelCaseBindingsEnabled[] = JSB_MODULE_NAME_STRING "/runtime/core/camel_case_bindings_enabled";
+    static constexpr char kRtTimerFrameBudgetUsec[] = JSB_MODULE_NAME_STRING "/runtime/core/timer_frame_budget_usec";
+    static constexpr char kRtMicrotaskCheckpointPerCallBatch[] = JSB_MODULE_NAME_STRING "/runtime/core/microtask_checkpoint_per_call_batch";
+    static constexpr char kRtExportedPropertySlots[] = JSB_MODULE_NAME_STRING "/runtime/core/exported_property_slots";
+    static constexpr char kRtDeferredScriptLoading[] = JSB_MODULE_NAME_STRING "/runtime/core/deferred_script_loading";
+    static constexpr char kRtGCMallocThresholdKb[] = JSB_MODULE_NAME_STRING "/runtime/core/gc_malloc_threshold_kb";
+    static constexpr char kRtIdleGCMinSlackUsec[] = JSB_MODULE_NAME_STRING "/runtime/core/idle_gc_min_slack_usec";
+    static constexpr char kRtInitialObjectSlots[] = JSB_MODULE_NAME_STRING "/runtime/core/initial_object_slots";
+    static constexpr char kRtInitialScriptSlots[] = JSB_MODULE_NAME_STRING "/runtime/core/initial_script_slots";
+    static constexpr char kRtWorkerInitialObjectSlots[] = JSB_MODULE_NAME_STRING "/runtime/core/worker_initial_object_slots";
+    static constexpr char kRtAdaptiveInitialSlots[] = JSB_MODULE_NAME_STRING "/runtime/core/adaptive_initial_slots";
+    static constexpr char kRtStartupPrefetchModules[] = JSB_MODULE_NAME_STRING "/runtime/core/startup_prefetch_modules";
+    static constexpr char kRtPrewarmClasses[] = JSB_MODULE_NAME_STRING "/runtime/core/prewarm_classes";
+    static constexpr char kRtRecordTouchedClasses[] = JSB_MODULE_NAME_STRING "/runtime/core/record_touched_classes";
+    static constexpr char kRtWeakEngineObjectWrappers[] = JSB_MODULE_NAME_STRING "/runtime/core/weak_engine_object_wrappers";
+    static constexpr char kRtDeferThreadedScriptCalls[] = JSB_MODULE_NAME_STRING "/runtime/core/defer_threaded_script_calls";
+    static constexpr char kRtScriptCallBudgetMsec[] = JSB_MODULE_NAME_STRING "/runtime/core/script_call_budget_msec";
+    static constexpr char kRtMaxHeapSizeMb[] = JSB_MODULE_NAME_STRING "/runtime/core/max_heap_size_mb";
+    static constexpr char kRtInitialHeapSizeMb[] = JSB_MODULE_NAME_STRING "/runtime/core/initial_heap_size_mb";
+    static constexpr char kRtWorkerMaxHeapSizeMb[] = JSB_MODULE_NAME_STRING "/runtime/core/worker_max_heap_size_mb";
+    static constexpr char kRtWorkerInitialHeapSizeMb[] = JSB_MODULE_NAME_STRING "/runtime/core/worker_initial_heap_size_mb";
+    static constexpr char kRtPrefetchModuleDependencies[] = JSB_MODULE_NAME_STRING "/runtime/core/prefetch_module_dependencies";
+    static constexpr char kRtShadowEnvironmentPoolSize[] = JSB_MODULE_NAME_STRING "/runtime/core/shadow_environment_pool_size";
+    static constexpr char kRtTaskEnvironmentPoolSize[] = JSB_MODULE_NAME_STRING "/runtime/core/task_environment_pool_size";
+    static constexpr char kRtServerProfile[] = JSB_MODULE_NAME_STRING "/runtime/server/server_profile";
+    static constexpr char kRtServerTickRate[] = JSB_MODULE_NAME_STRING "/runtime/server/tick_rate";
+    static constexpr char kRtServerInitialObjectSlots[] = JSB_MODULE_NAME_STRING "/runtime/server/initial_object_slots";
+    static constexpr char kRtServerInitialScriptSlots[] = JSB_MODULE_NAME_STRING "/runtime/server/initial_script_slots";
 
     // editor specific settings, but we need it configured as project-wise instead of global-wise
     static constexpr char kRtPackagingWithSourceMap[] = JSB_MODULE_NAME_STRING "/editor/packaging/source_map_included";
     static constexpr char kRtPackagingIncludeFiles[] = JSB_MODULE_NAME_STRING "/editor/packaging/include_files";
     static constexpr char kRtPackagingIncludeDirectories[] = JSB_MODULE_NAME_STRING "/editor/packaging/include_directories";
     static constexpr char kRtPackagingReferencedNodeModules[] = JSB_MODULE_NAME_STRING "/editor/packaging/referenced_node_modules";
+    static constexpr char kRtPackagingPrecompiledCodeCache[] = JSB_MODULE_NAME_STRING "/editor/packaging/precompiled_code_cache";
+    static constexpr char kRtPackagingModuleArchive[] = JSB_MODULE_NAME_STRING "/editor/packaging/module_archive";
+    static constexpr char kRtPackagingTreeShaking[] = JSB_MODULE_NAME_STRING "/editor/packaging/tree_shaking";
+    static constexpr char kRtPackagingMinifierCommand[] = JSB_MODULE_NAME_STRING "/editor/packaging/minifier_command";
 
 #ifdef TOOLS_ENABLED
     bool init_editor_settings()
@@ -67,6 +109,8 @@ namespace jsb::internal
                 _EDITOR_DEF(kEdGenResourceDTS, true, false);
                 _EDITOR_DEF(kEdAutogenResourceDTSOnSave, true, false);
                 _EDITOR_DEF(kEdCodegenUseProjectSettings, true, false);
+                _EDITOR_DEF(kEdScriptClassCache, true, false);
+                _EDITOR_DEF(kEdTranspileOnChange, false, false);
             }
         }
         return inited;
@@ -86,9 +130,58 @@ namespace jsb::internal
             ;
 
             _GLOBAL_DEF(kRtDebuggerPort, 9229, JSB_SET_RESTART(true), JSB_SET_IGNORE_DOCS(false), JSB_SET_BASIC(false), JSB_SET_INTERNAL(false));
+            _GLOBAL_DEF(kRtSamplingProfilerIntervalUsec, 0, JSB_SET_RESTART(false), JSB_SET_IGNORE_DOCS(false), JSB_SET_BASIC(false), JSB_SET_INTERNAL(false));
+            _GLOBAL_DEF(kRtTraceEventsPath, String(), JSB_SET_RESTART(true), JSB_SET_IGNORE_DOCS(false), JSB_SET_BASIC(false), JSB_SET_INTERNAL(false));
+            _GLOBAL_DEF(kRtMetricsPort, 0, JSB_SET_RESTART(true), JSB_SET_IGNORE_DOCS(false), JSB_SET_BASIC(false), JSB_SET_INTERNAL(false));
+            _GLOBAL_DEF(kRtMetricsIntervalMsec, JSB_METRICS_INTERVAL_MSEC, JSB_SET_RESTART(false), JSB_SET_IGNORE_DOCS(false), JSB_SET_BASIC(false), JSB_SET_INTERNAL(false));
             _GLOBAL_DEF(kRtSourceMapEnabled, true, JSB_SET_RESTART(false), JSB_SET_IGNORE_DOCS(false), JSB_SET_BASIC(true),  JSB_SET_INTERNAL(false));
+            _GLOBAL_DEF(kRtAsyncSymbolication, false, JSB_SET_RESTART(false), JSB_SET_IGNORE_DOCS(false), JSB_SET_BASIC(false),  JSB_SET_INTERNAL(false));
+            _GLOBAL_DEF(kRtBufferedConsoleOutput, false, JSB_SET_RESTART(true), JSB_SET_IGNORE_DOCS(false), JSB_SET_BASIC(false),  JSB_SET_INTERNAL(false));
+            {
+                // the values are the same as ELogSeverity
+                PropertyInfo ConsoleMinSeverity;
+                ConsoleMinSeverity.type = Variant::INT;
+                ConsoleMinSeverity.name = kRtConsoleMinSeverity;
+                ConsoleMinSeverity.hint = PROPERTY_HINT_ENUM;
+                ConsoleMinSeverity.hint_string = "All,Verbose,Debug,Info,Log,Trace,Warning,Error";
+                _GLOBAL_DEF(ConsoleMinSeverity, 0, JSB_SET_RESTART(true), JSB_SET_IGNORE_DOCS(false), JSB_SET_BASIC(false),  JSB_SET_INTERNAL(false));
+            }
             _GLOBAL_DEF(kRtAdditionalSearchPaths, PackedStringArray(), JSB_SET_RESTART(false),  JSB_SET_IGNORE_DOCS(false), JSB_SET_BASIC(true),  JSB_SET_INTERNAL(false));
             _GLOBAL_DEF(kRtCamelCaseBindingsEnabled, false, JSB_SET_RESTART(true), JSB_SET_IGNORE_DOCS(false), JSB_SET_BASIC(true),  JSB_SET_INTERNAL(false));
+            _GLOBAL_DEF(kRtTimerFrameBudgetUsec, 0, JSB_SET_RESTART(true), JSB_SET_IGNORE_DOCS(false), JSB_SET_BASIC(false),  JSB_SET_INTERNAL(false));
+            _GLOBAL_DEF(kRtMicrotaskCheckpointPerCallBatch, false, JSB_SET_RESTART(true), JSB_SET_IGNORE_DOCS(false), JSB_SET_BASIC(false),  JSB_SET_INTERNAL(false));
+            _GLOBAL_DEF(kRtExportedPropertySlots, false, JSB_SET_RESTART(true), JSB_SET_IGNORE_DOCS(false), JSB_SET_BASIC(false),  JSB_SET_INTERNAL(false));
+            _GLOBAL_DEF(kRtDeferredScriptLoading, false, JSB_SET_RESTART(true), JSB_SET_IGNORE_DOCS(false), JSB_SET_BASIC(false),  JSB_SET_INTERNAL(false));
+            _GLOBAL_DEF(kRtGCMallocThresholdKb, 0, JSB_SET_RESTART(true), JSB_SET_IGNORE_DOCS(false), JSB_SET_BASIC(false),  JSB_SET_INTERNAL(false));
+            _GLOBAL_DEF(kRtIdleGCMinSlackUsec, 0, JSB_SET_RESTART(true), JSB_SET_IGNORE_DOCS(false), JSB_SET_BASIC(false),  JSB_SET_INTERNAL(false));
+            _GLOBAL_DEF(kRtInitialObjectSlots, JSB_MASTER_INITIAL_OBJECT_SLOTS, JSB_SET_RESTART(true), JSB_SET_IGNORE_DOCS(false), JSB_SET_BASIC(false),  JSB_SET_INTERNAL(false));
+            _GLOBAL_DEF(kRtInitialScriptSlots, JSB_MASTER_INITIAL_SCRIPT_SLOTS, JSB_SET_RESTART(true), JSB_SET_IGNORE_DOCS(false), JSB_SET_BASIC(false),  JSB_SET_INTERNAL(false));
+            _GLOBAL_DEF(kRtWorkerInitialObjectSlots, JSB_WORKER_INITIAL_OBJECT_SLOTS, JSB_SET_RESTART(true), JSB_SET_IGNORE_DOCS(false), JSB_SET_BASIC(false),  JSB_SET_INTERNAL(false));
+            _GLOBAL_DEF(kRtAdaptiveInitialSlots, false, JSB_SET_RESTART(true), JSB_SET_IGNORE_DOCS(false), JSB_SET_BASIC(false),  JSB_SET_INTERNAL(false));
+            _GLOBAL_DEF(kRtStartupPrefetchModules, PackedStringArray(), JSB_SET_RESTART(true), JSB_SET_IGNORE_DOCS(false), JSB_SET_BASIC(false),  JSB_SET_INTERNAL(false));
+            _GLOBAL_DEF(kRtPrewarmClasses, PackedStringArray(), JSB_SET_RESTART(true), JSB_SET_IGNORE_DOCS(false), JSB_SET_BASIC(false),  JSB_SET_INTERNAL(false));
+            _GLOBAL_DEF(kRtRecordTouchedClasses, false, JSB_SET_RESTART(true), JSB_SET_IGNORE_DOCS(false), JSB_SET_BASIC(false),  JSB_SET_INTERNAL(false));
+            _GLOBAL_DEF(kRtPrefetchModuleDependencies, true, JSB_SET_RESTART(true), JSB_SET_IGNORE_DOCS(false), JSB_SET_BASIC(false),  JSB_SET_INTERNAL(false));
+            _GLOBAL_DEF(kRtShadowEnvironmentPoolSize, JSB_MAX_CACHED_SHADOW_ENVIRONMENTS, JSB_SET_RESTART(true), JSB_SET_IGNORE_DOCS(false), JSB_SET_BASIC(false),  JSB_SET_INTERNAL(false));
+            _GLOBAL_DEF(kRtTaskEnvironmentPoolSize, 0, JSB_SET_RESTART(true), JSB_SET_IGNORE_DOCS(false), JSB_SET_BASIC(false),  JSB_SET_INTERNAL(false));
+            _GLOBAL_DEF(kRtWeakEngineObjectWrappers, false, JSB_SET_RESTART(true), JSB_SET_IGNORE_DOCS(false), JSB_SET_BASIC(false),  JSB_SET_INTERNAL(false));
+            _GLOBAL_DEF(kRtDeferThreadedScriptCalls, false, JSB_SET_RESTART(true), JSB_SET_IGNORE_DOCS(false), JSB_SET_BASIC(false),  JSB_SET_INTERNAL(false));
+            _GLOBAL_DEF(kRtScriptCallBudgetMsec, 0, JSB_SET_RESTART(true), JSB_SET_IGNORE_DOCS(false), JSB_SET_BASIC(false),  JSB_SET_INTERNAL(false));
+            _GLOBAL_DEF(kRtMaxHeapSizeMb, 0, JSB_SET_RESTART(true), JSB_SET_IGNORE_DOCS(false), JSB_SET_BASIC(false),  JSB_SET_INTERNAL(false));
+            _GLOBAL_DEF(kRtInitialHeapSizeMb, 0, JSB_SET_RESTART(true), JSB_SET_IGNORE_DOCS(false), JSB_SET_BASIC(false),  JSB_SET_INTERNAL(false));
+            _GLOBAL_DEF(kRtWorkerMaxHeapSizeMb, 0, JSB_SET_RESTART(true), JSB_SET_IGNORE_DOCS(false), JSB_SET_BASIC(false),  JSB_SET_INTERNAL(false));
+            _GLOBAL_DEF(kRtWorkerInitialHeapSizeMb, 0, JSB_SET_RESTART(true), JSB_SET_IGNORE_DOCS(false), JSB_SET_BASIC(false),  JSB_SET_INTERNAL(false));
+            {
+                PropertyInfo ServerProfile;
+                ServerProfile.type = Variant::INT;
+                ServerProfile.name = kRtServerProfile;
+                ServerProfile.hint = PROPERTY_HINT_ENUM;
+                ServerProfile.hint_string = "Disabled,Auto,Enabled";
+                _GLOBAL_DEF(ServerProfile, 1, JSB_SET_RESTART(true), JSB_SET_IGNORE_DOCS(false), JSB_SET_BASIC(false),  JSB_SET_INTERNAL(false));
+            }
+            _GLOBAL_DEF(kRtServerTickRate, JSB_SERVER_TICK_RATE, JSB_SET_RESTART(true), JSB_SET_IGNORE_DOCS(false), JSB_SET_BASIC(false),  JSB_SET_INTERNAL(false));
+            _GLOBAL_DEF(kRtServerInitialObjectSlots, JSB_SERVER_INITIAL_OBJECT_SLOTS, JSB_SET_RESTART(true), JSB_SET_IGNORE_DOCS(false), JSB_SET_BASIC(false),  JSB_SET_INTERNAL(false));
+            _GLOBAL_DEF(kRtServerInitialScriptSlots, JSB_SERVER_INITIAL_SCRIPT_SLOTS, JSB_SET_RESTART(true), JSB_SET_IGNORE_DOCS(false), JSB_SET_BASIC(false),  JSB_SET_INTERNAL(false));
 
             {
                 PropertyInfo EntryScriptPath;
@@ -120,6 +213,12 @@ namespace jsb::internal
             }
 
             _GLOBAL_DEF(kRtPackagingReferencedNodeModules, true, false);
+            _GLOBAL_DEF(kRtPackagingPrecompiledCodeCache, false, false);
+            _GLOBAL_DEF(kRtPackagingModuleArchive, false, false);
+            _GLOBAL_DEF(kRtPackagingTreeShaking, false, false);
+
+            // e.g. ["npx", "terser", "{input}", "-c", "-m", "--source-map", "content='{input_map}'", "-o", "{output}"]
+            _GLOBAL_DEF(kRtPackagingMinifierCommand, PackedStringArray(), false);
         }
     }
 
@@ -170,6 +269,18 @@ namespace jsb::internal
         init_editor_settings();
         return EDITOR_GET(kEdCodegenUseProjectSettings);
     }
+
+    bool Settings::is_script_class_cache_enabled()
+    {
+        init_editor_settings();
+        return EDITOR_GET(kEdScriptClassCache);
+    }
+
+    bool Settings::is_transpile_on_change()
+    {
+        init_editor_settings();
+        return EDITOR_GET(kEdTranspileOnChange);
+    }
 #endif
 
     bool Settings::is_packaging_with_source_map()
@@ -198,6 +309,30 @@ namespace jsb::internal
         return GLOBAL_GET(kRtPackagingReferencedNodeModules);
     }
 
+    bool Settings::is_packaging_precompiled_code_cache()
+    {
+        init_settings();
+        return GLOBAL_GET(kRtPackagingPrecompiledCodeCache);
+    }
+
+    bool Settings::is_packaging_module_archive()
+    {
+        init_settings();
+        return GLOBAL_GET(kRtPackagingModuleArchive);
+    }
+
+    bool Settings::is_packaging_tree_shaking()
+    {
+        init_settings();
+        return GLOBAL_GET(kRtPackagingTreeShaking);
+    }
+
+    PackedStringArray Settings::get_packaging_minifier_command()
+    {
+        init_settings();
+        return (PackedStringArray) GLOBAL_GET(kRtPackagingMinifierCommand);
+    }
+
     uint16_t Settings::get_debugger_port()
     {
 #ifdef TOOLS_ENABLED
@@ -211,12 +346,54 @@ namespace jsb::internal
         return GLOBAL_GET(kRtDebuggerPort);
     }
 
+    uint16_t Settings::get_metrics_port()
+    {
+        init_settings();
+        return GLOBAL_GET(kRtMetricsPort);
+    }
+
+    int Settings::get_metrics_interval_msec()
+    {
+        init_settings();
+        return MAX((int) GLOBAL_GET(kRtMetricsIntervalMsec), 1);
+    }
+
+    int Settings::get_sampling_profiler_interval_usec()
+    {
+        init_settings();
+        return GLOBAL_GET(kRtSamplingProfilerIntervalUsec);
+    }
+
+    String Settings::get_trace_events_path()
+    {
+        init_settings();
+        return GLOBAL_GET(kRtTraceEventsPath);
+    }
+
     bool Settings::get_sourcemap_enabled()
     {
         init_settings();
         return GLOBAL_GET(kRtSourceMapEnabled);
     }
 
+    bool Settings::is_async_symbolication()
+    {
+        init_settings();
+        return GLOBAL_GET(kRtAsyncSymbolication);
+    }
+
+    bool Settings::is_buffered_console_output()
+    {
+        init_settings();
+        return GLOBAL_GET(kRtBufferedConsoleOutput);
+    }
+
+    ELogSeverity::Type Settings::get_console_min_severity()
+    {
+        init_settings();
+        return (ELogSeverity::Type) CLAMP((int) GLOBAL_GET(kRtConsoleMinSeverity), 0, (int) ELogSeverity::Error);
+    }
+
     String Settings::get_project_data_dir_name()
     {
         const String project_data_dir = ProjectSettings::get_singleton()->get_project_data_dir_name();
@@ -257,6 +434,165 @@ namespace jsb::internal
         return GLOBAL_GET(kRtCamelCaseBindingsEnabled);
     }
 
+    uint32_t Settings::get_timer_frame_budget_usec()
+    {
+        init_settings();
+        return (uint32_t) (int64_t) GLOBAL_GET(kRtTimerFrameBudgetUsec);
+    }
+
+    uint32_t Settings::get_gc_malloc_threshold_kb()
+    {
+        init_settings();
+        return (uint32_t) (int64_t) GLOBAL_GET(kRtGCMallocThresholdKb);
+    }
+
+    uint32_t Settings::get_idle_gc_min_slack_usec()
+    {
+        init_settings();
+        return (uint32_t) (int64_t) GLOBAL_GET(kRtIdleGCMinSlackUsec);
+    }
+
+    int Settings::get_initial_object_slots()
+    {
+        init_settings();
+        return MAX(1, (int) GLOBAL_GET(kRtInitialObjectSlots));
+    }
+
+    int Settings::get_initial_script_slots()
+    {
+        init_settings();
+        return MAX(1, (int) GLOBAL_GET(kRtInitialScriptSlots));
+    }
+
+    int Settings::get_worker_initial_object_slots()
+    {
+        init_settings();
+        return MAX(1, (int) GLOBAL_GET(kRtWorkerInitialObjectSlots));
+    }
+
+    PackedStringArray Settings::get_startup_prefetch_modules()
+    {
+        init_settings();
+        return GLOBAL_GET(kRtStartupPrefetchModules);
+    }
+
+    PackedStringArray Settings::get_prewarm_classes()
+    {
+        init_settings();
+        return GLOBAL_GET(kRtPrewarmClasses);
+    }
+
+    bool Settings::is_record_touched_classes()
+    {
+        init_settings();
+        return GLOBAL_GET(kRtRecordTouchedClasses);
+    }
+
+    int Settings::get_shadow_environment_pool_size()
+    {
+        init_settings();
+        return MAX((int) GLOBAL_GET(kRtShadowEnvironmentPoolSize), 1);
+    }
+
+    bool Settings::is_adaptive_initial_slots()
+    {
+        init_settings();
+        return GLOBAL_GET(kRtAdaptiveInitialSlots);
+    }
+
+    bool Settings::is_microtask_checkpoint_per_call_batch()
+    {
+        init_settings();
+        return GLOBAL_GET(kRtMicrotaskCheckpointPerCallBatch);
+    }
+
+    bool Settings::is_exported_property_slots()
+    {
+        init_settings();
+        return GLOBAL_GET(kRtExportedPropertySlots);
+    }
+
+    bool Settings::is_deferred_script_loading()
+    {
+        init_settings();
+        return GLOBAL_GET(kRtDeferredScriptLoading);
+    }
+
+    int Settings::get_task_environment_pool_size()
+    {
+        init_settings();
+        return MAX((int) GLOBAL_GET(kRtTaskEnvironmentPoolSize), 0);
+    }
+
+    bool Settings::is_weak_engine_object_wrappers()
+    {
+        init_settings();
+        return GLOBAL_GET(kRtWeakEngineObjectWrappers);
+    }
+
+    bool Settings::is_defer_threaded_script_calls()
+    {
+        init_settings();
+        return GLOBAL_GET(kRtDeferThreadedScriptCalls);
+    }
+
+    bool Settings::is_server_profile()
+    {
+        init_settings();
+        switch ((int) GLOBAL_GET(kRtServerProfile))
+        {
+        case 0: return false;
+        case 2: return true;
+        default:
+            // never in editor, even if it's headless (e.g. exporting from the command line)
+            if (Engine::get_singleton()->is_editor_hint()) return false;
+            return OS::get_singleton()->has_feature("dedicated_server")
+                || (DisplayServer::get_singleton() && DisplayServer::get_singleton()->get_name() == "headless");
+        }
+    }
+
+    int Settings::get_server_tick_rate()
+    {
+        init_settings();
+        return MAX(0, (int) GLOBAL_GET(kRtServerTickRate));
+    }
+
+    int Settings::get_server_initial_object_slots()
+    {
+        init_settings();
+        return MAX(1, (int) GLOBAL_GET(kRtServerInitialObjectSlots));
+    }
+
+    int Settings::get_server_initial_script_slots()
+    {
+        init_settings();
+        return MAX(1, (int) GLOBAL_GET(kRtServerInitialScriptSlots));
+    }
+
+    bool Settings::is_prefetch_module_dependencies()
+    {
+        init_settings();
+        return GLOBAL_GET(kRtPrefetchModuleDependencies);
+    }
+
+    uint32_t Settings::get_script_call_budget_msec()
+    {
+        init_settings();
+        return (uint32_t) (int64_t) GLOBAL_GET(kRtScriptCallBudgetMsec);
+    }
+
+    uint32_t Settings::get_max_heap_size_mb(bool p_worker)
+    {
+        init_settings();
+        return (uint32_t) (int64_t) GLOBAL_GET(p_worker ? kRtWorkerMaxHeapSizeMb : kRtMaxHeapSizeMb);
+    }
+
+    uint32_t Settings::get_initial_heap_size_mb(bool p_worker)
+    {
+        init_settings();
+        return (uint32_t) (int64_t) GLOBAL_GET(p_worker ? kRtWorkerInitialHeapSizeMb : kRtInitialHeapSizeMb);
+    }
+
     String Settings::get_indentation()
     {
 #ifdef TOOLS_ENABLED
@@ -3,6 +3,7 @@
 
 #include <cstdint>
 #include "../compat/jsb_compat.h"
+#include "jsb_log_severity.h"
 
 namespace jsb::internal
 {
@@ -10,8 +11,30 @@ namespace jsb::internal
     {
     public:
         static uint16_t get_debugger_port();
+
+        // serve the metrics of the main environment over HTTP (`GET /metrics`, Prometheus text format), 0 to disable
+        static uint16_t get_metrics_port();
+
+        // how often the metrics snapshot is taken on the main thread
+        static int get_metrics_interval_msec();
+
+        // sample the JS stacks in the script profiler (v8 only), 0 to disable
+        static int get_sampling_profiler_interval_usec();
+
+        // record trace events from startup and save them to this file on exit (e.g. `user://godotjs_trace.json`), empty to disable
+        static String get_trace_events_path();
         static bool get_sourcemap_enabled();
 
+        // the exceptions in frequent callbacks (functions, timers, frame callbacks) are symbolicated in background and logged later (identical ones are throttled)
+        static bool is_async_symbolication();
+
+        // console.log/info/debug/trace are written once per frame on the main thread instead of synchronously in the caller
+        static bool is_buffered_console_output();
+
+        // the initial minimum severity of console messages in each environment (see jsb.set_console_min_severity),
+        // the messages under it are skipped before formatting (in addition to JSB_MIN_LOG_LEVEL at compile-time)
+        static ELogSeverity::Type get_console_min_severity();
+
         /**
          * get the project relative path for `outDir` (it refers to `.godot/GodotJS` by default)
          */
@@ -37,6 +60,83 @@ namespace jsb::internal
 
         static bool get_camel_case_bindings_enabled();
 
+        // max time (in microseconds) spent on firing timers per frame, 0 for unlimited
+        static uint32_t get_timer_frame_budget_usec();
+
+        // (quickjs only) run the cycle collection after the frame work if the allocated memory grows more than it since the last collection, 0 to leave it to the engine
+        static uint32_t get_gc_malloc_threshold_kb();
+
+        // (v8 only) give the time left in the frame (capped by `max_fps`) to the GC if it's not less than it, 0 to disable
+        static uint32_t get_idle_gc_min_slack_usec();
+
+        // initial capacity of the object/script registries of the main environment (reallocated as a whole block when outgrown)
+        static int get_initial_object_slots();
+        static int get_initial_script_slots();
+
+        // initial capacity of the object registry of workers
+        static int get_worker_initial_object_slots();
+
+        // record the high-water mark of the registries in the user data dir, and reserve for it on the next launch
+        static bool is_adaptive_initial_slots();
+
+        // modules read (and parsed, with v8) in background threads before the entry script is loaded
+        static PackedStringArray get_startup_prefetch_modules();
+
+        // godot classes (engine names) bound in the frame idle time after startup, instead of the first time they're touched by scripts
+        static PackedStringArray get_prewarm_classes();
+
+        // record the godot classes exposed to scripts in the user data dir, and prewarm them on the next launch
+        static bool is_record_touched_classes();
+
+        // the max number of idle shadow environments kept for parsing scripts out of the main thread (also the parallelism of `reload_scripts` in editor)
+        static int get_shadow_environment_pool_size();
+
+        // the max number of environments running `runTask` tasks on the WorkerThreadPool at the same time, 0 for half of the pool threads
+        static int get_task_environment_pool_size();
+
+        // run microtasks right after each batch of calls into JS (timers, messages, batched process...) instead of once per frame
+        static bool is_microtask_checkpoint_per_call_batch();
+
+        // store the values of exported fields in native slots of the script instances, the engine reads/writes them without entering JS
+        static bool is_exported_property_slots();
+
+        // evaluate the module of a script only when it's really used (e.g. instantiated), the class metadata is collected by the exporter
+        static bool is_deferred_script_loading();
+
+        // wrappers of the engine objects returned to JS (not RefCounted, without script) are weak, recreated on demand after collected.
+        // any properties added on them by scripts are lost with the wrapper.
+        static bool is_weak_engine_object_wrappers();
+
+        // script methods called from other threads (e.g. nodes in a threaded `process_thread_group`) are queued and run on the thread of the environment
+        // in the next update instead of failing. the engine doesn't wait for them, so the calls return nothing.
+        static bool is_defer_threaded_script_calls();
+
+        // the runtime profile of headless servers (`Auto` if the display server is headless or the `dedicated_server` feature is present):
+        // the main environment is updated at a fixed tick rate instead of every frame, with the debugger, monitors and profilers off,
+        // and smaller registries (`runtime/server/initial_*_slots` instead of `runtime/core/initial_*_slots`)
+        static bool is_server_profile();
+
+        // (server profile) the rate (per second) of updating timers and microtasks of the main environment, 0 for once per frame
+        static int get_server_tick_rate();
+
+        static int get_server_initial_object_slots();
+        static int get_server_initial_script_slots();
+
+        // read (and parse with v8) the modules statically required by a module (`require("literal")`) in background before its body runs,
+        // so the dependencies are fetched in parallel instead of one by one
+        static bool is_prefetch_module_dependencies();
+
+        // (v8 and quickjs only) terminate a JS call from the engine (a script method, a signal, timers of a frame...) running longer than it, 0 to disable.
+        // the time paused at breakpoints also counts, disable it while debugging
+        static uint32_t get_script_call_budget_msec();
+
+        // the heap limit of the main environment or workers (in megabytes, 0 for the engine default).
+        // the caches are released and a full gc is run when it's nearly reached (v8 grants some headroom once, quickjs throws out of memory errors beyond it)
+        static uint32_t get_max_heap_size_mb(bool p_worker);
+
+        // (v8 only) the initial size of the old generation (in megabytes, 0 for the engine default)
+        static uint32_t get_initial_heap_size_mb(bool p_worker);
+
         static bool is_packaging_with_source_map();
 
         static PackedStringArray get_packaging_include_files();
@@ -45,6 +145,18 @@ namespace jsb::internal
 
         static bool is_packaging_referenced_node_modules();
 
+        // pack the code cache (bytecode) of exported scripts along with the sources, it's skipped by the runtime if it's built by a different version
+        static bool is_packaging_precompiled_code_cache();
+
+        // pack all script modules into a single archive instead of individual files
+        static bool is_packaging_module_archive();
+
+        // export only the scripts reachable from the resources in project, the autoloads and the entry script (along with their dependencies)
+        static bool is_packaging_tree_shaking();
+
+        // the external command (program and arguments) run by the exporter on each exported script, empty if not minifying
+        static PackedStringArray get_packaging_minifier_command();
+
 #ifdef TOOLS_ENABLED
         // [EDITOR ONLY]
         static bool editor_settings_available();
@@ -55,6 +167,12 @@ namespace jsb::internal
         static bool get_autogen_resource_dts_on_save();
         static bool get_gen_resource_dts();
         static bool get_codegen_use_project_settings();
+
+        // answer the queries on the class info of scripts with the persisted results of the last parsing until the modules are really loaded
+        static bool is_script_class_cache_enabled();
+
+        // transpile the changed typescript sources in editor (without type checking) and reload them immediately, instead of waiting for tsc
+        static bool is_transpile_on_change();
 #endif
     };
 }
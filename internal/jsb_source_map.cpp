@@ -19,98 +19,148 @@ namespace jsb::internal
 
     // base64vlq decode
     // adapted from https://www.murzwin.com/base64vlq.html
-    void SourceMap::decode(int p_line, const char* p_token, const char* p_end, InternalPosition& r_pos, int& r_aline, int& r_acol)
+    bool SourceMap::decode_line(int p_line, State& r_state, LocalVector<Segment>* r_segments) const
     {
-        if (p_end - p_token <= 1) return;
-        uint8_t shift = 0;
-        int32_t value = 0;
-        uint8_t index = 0;
-        while (p_end != p_token)
+        const char* cursor;
+        const char* end;
+        get_line_range(p_line, cursor, end);
+
+        int result_column = 0;
+        while (cursor < end)
         {
-            const char token = *(p_token++);
-            jsb_check(token >= '+' && token <= 'z');
-            int32_t integer = kBase64Unmap[(uint8_t) (token - '+')];
-            const bool cont = integer & 0x20;
-            integer &= 0x1f;
-            value |= integer << shift;
-            if (cont) {
-                shift += 5;
+            // fields: [result_column, source_index, source_line, source_column, name_index] (all relative)
+            int fields[5] = {};
+            uint8_t index = 0;
+            uint8_t shift = 0;
+            int32_t value = 0;
+            while (cursor < end)
+            {
+                const char token = *(cursor++);
+                if (token == ',') break;
+                const uint8_t integer = token >= '+' && token <= 'z' ? kBase64Unmap[(uint8_t) (token - '+')] : 0xff;
+                if (jsb_unlikely(integer == 0xff || index == 5))
+                {
+                    // malformed mappings, ignore the rest of this line
+                    return false;
+                }
+                value |= (integer & 0x1f) << shift;
+                if (integer & 0x20)
+                {
+                    shift += 5;
+                    continue;
+                }
+                const bool neg = value & 1;
+                value = value >> 1;
+                fields[index++] = neg ? -value : value;
+                value = shift = 0;
+            }
+
+            result_column += fields[0];
+            if (index < 4)
+            {
+                // a segment without the source position
                 continue;
             }
-            const bool neg = value & 1;
-            value = value >> 1;
-            r_pos[index++] = neg ? -value : value;
-            value = shift = 0;
+            r_state.source_index += fields[1];
+            r_state.source_line += fields[2];
+            r_state.source_column += fields[3];
+            if (index == 5) r_state.name_index += fields[4];
+            if (r_segments)
+            {
+                r_segments->push_back({ result_column, r_state.source_index, r_state.source_line, r_state.source_column });
+            }
         }
-        r_aline += r_pos.source_line;
-        r_acol += r_pos.source_column;
-        Vector<InternalPosition>& elements = (*this)[p_line].elements;
-        elements.append({ r_pos.result_column, r_pos.source_index, r_aline, r_acol, r_pos._reserved });
+        return true;
     }
 
-    SourceMap::InternalLine& SourceMap::operator[](int p_line)
+    void SourceMap::get_line_range(int p_line, const char*& r_begin, const char*& r_end) const
     {
-        const int size = source_lines_.size();
-        if (size == 0 || source_lines_[size - 1].result_line != p_line)
-        {
-            source_lines_.push_back({ {}, p_line });
-            return source_lines_.write[size];
-        }
-        return source_lines_.write[size - 1];
+        jsb_check(p_line >= 0 && p_line < (int) line_offsets_.size());
+        const char* data = mappings_.ptr();
+        r_begin = data + line_offsets_[p_line];
+        r_end = p_line + 1 < (int) line_offsets_.size()
+            ? data + line_offsets_[p_line + 1] - 1 // exclude ';'
+            : data + mappings_.size();
     }
 
-    bool SourceMap::parse_mappings(const char* p_mappings, size_t p_len)
+    const LocalVector<SourceMap::Segment>& SourceMap::get_line(int p_line) const
     {
-        source_lines_.clear();
-        int line = 0;
-        size_t pos = 0;
-        size_t cursor = 0;
-        int accum_line = 0;
-        int accum_column = 0;
-        InternalPosition sp;
-        while (cursor < p_len)
+        if (const LocalVector<Segment>* decoded = decoded_lines_.getptr(p_line))
+        {
+            return *decoded;
+        }
+        if (decoded_lines_.size() >= kMaxDecodedLines)
+        {
+            decoded_lines_.clear();
+        }
+
+        // restore the state at the beginning of the line from the nearest checkpoint
+        const int checkpoint = p_line / kCheckpointInterval;
+        if (checkpoints_.is_empty())
         {
-            const char ch = p_mappings[cursor];
-            switch (ch)
+            checkpoints_.push_back({});
+        }
+        while ((int) checkpoints_.size() <= checkpoint)
+        {
+            State state = checkpoints_[checkpoints_.size() - 1];
+            for (int line = ((int) checkpoints_.size() - 1) * kCheckpointInterval, n = line + kCheckpointInterval; line < n; ++line)
             {
-            case ';':
-                // new line
-                decode(line, p_mappings + pos, p_mappings + cursor, sp, accum_line, accum_column);
-                ++line;
-                pos = ++cursor;
-                break;
-            case ',':
-                // new element
-                jsb_check(pos < cursor);
-                decode(line, p_mappings + pos, p_mappings + cursor, sp, accum_line, accum_column);
-                pos = ++cursor;
-                break;
-            default: ++cursor; break;
+                decode_line(line, state, nullptr);
             }
+            checkpoints_.push_back(state);
+        }
+        State state = checkpoints_[checkpoint];
+        for (int line = checkpoint * kCheckpointInterval; line < p_line; ++line)
+        {
+            decode_line(line, state, nullptr);
         }
-        if (pos < cursor)
+
+        LocalVector<Segment>& segments = decoded_lines_.insert(p_line, {})->value;
+        decode_line(p_line, state, &segments);
+        return segments;
+    }
+
+    bool SourceMap::parse_mappings(const char* p_mappings, size_t p_len)
+    {
+        // only the line offsets are collected here, the segments are decoded on demand
+        mappings_.resize((uint32_t) p_len);
+        if (p_len != 0) memcpy(mappings_.ptr(), p_mappings, p_len);
+        line_offsets_.clear();
+        checkpoints_.clear();
+        decoded_lines_.clear();
+        line_offsets_.push_back(0);
+        for (const char* it = p_mappings, *end = p_mappings + p_len; (it = (const char*) memchr(it, ';', end - it)); )
         {
-            decode(line, p_mappings + pos, p_mappings + cursor, sp, accum_line, accum_column);
+            ++it;
+            line_offsets_.push_back((uint32_t) (it - p_mappings));
         }
         return true;
     }
 
     bool SourceMap::find(int p_line, int p_column, IndexedSourcePosition& r_pos) const
     {
-        for (int line_index = source_lines_.size() - 1; line_index >= 0; --line_index)
+        // search in the nearest generated line with mappings
+        for (int line_index = MIN(p_line, get_line_count() - 1); line_index >= 0; --line_index)
         {
-            const InternalLine& line = source_lines_[line_index];
-            if (line.result_line > p_line)
+            const char* begin;
+            const char* end;
+            get_line_range(line_index, begin, end);
+            if (begin == end)
+            {
+                continue;
+            }
+            const LocalVector<Segment>& segments = get_line(line_index);
+            if (segments.is_empty())
             {
                 continue;
             }
 
             int xdist = INT_MAX;
             int xindex = 0;
-            for (int index = line.elements.size() - 1; index >= 0; -- index)
+            for (int index = (int) segments.size() - 1; index >= 0; -- index)
             {
-                const InternalPosition& position = line.elements[index];
-                const int dist = std::abs(position.result_column - p_column);
+                const Segment& segment = segments[index];
+                const int dist = std::abs(segment.result_column - p_column);
                 if (dist == 0)
                 {
                     xindex = index;
@@ -123,10 +173,10 @@ namespace jsb::internal
                 }
             }
 
-            const InternalPosition& xposition = line.elements[xindex];
-            r_pos.index = xposition.source_index;
-            r_pos.line = xposition.source_line;
-            r_pos.column = xposition.source_column;
+            const Segment& xsegment = segments[xindex];
+            r_pos.index = xsegment.source_index;
+            r_pos.line = xsegment.source_line;
+            r_pos.column = xsegment.source_column;
             return true;
         }
         // no matched position
@@ -20,28 +20,47 @@ namespace jsb::internal
         int column = 0;
     };
 
+    /**
+     * The mappings are kept in the original base64 VLQ form, only the offset of each generated line is recorded on parsing.
+     * A line is decoded on demand (when it's looked up), the accumulated fields at the beginning of lines are
+     * restored from the checkpoints which are also computed on demand (one for every `kCheckpointInterval` lines).
+     */
     struct SourceMap
     {
     private:
-        struct InternalPosition
+        enum
+        {
+            kCheckpointInterval = 64,
+
+            // the decoded lines are dropped all at once when the limit is reached (most lookups hit several same lines)
+            kMaxDecodedLines = 64,
+        };
+
+        struct Segment
         {
-            // DO NOT CHANGE THE ORDER
             int result_column = 0;
             int source_index = 0;
             int source_line = 0;
             int source_column = 0;
-            int _reserved = 0; // name index
-
-            jsb_force_inline int& operator[](uint8_t index) { jsb_check(index < 5); return *((int*)this + index); }
         };
 
-        struct InternalLine
+        // the fields accumulated across lines (the result column is reset on each line)
+        struct State
         {
-            Vector<InternalPosition> elements;
-            int result_line = 0;
+            int source_index = 0;
+            int source_line = 0;
+            int source_column = 0;
+            int name_index = 0;
         };
 
-        Vector<InternalLine> source_lines_;
+        LocalVector<char> mappings_;
+
+        // the start offset of each generated line in `mappings_`
+        LocalVector<uint32_t> line_offsets_;
+
+        mutable LocalVector<State> checkpoints_;
+        mutable HashMap<int, LocalVector<Segment>> decoded_lines_;
+
         Vector<String> sources_;
         String source_root_;
 
@@ -60,9 +79,18 @@ namespace jsb::internal
         const String& get_source_root() const;
         const String& get_source(int index) const;
 
+        // the number of generated lines
+        jsb_force_inline int get_line_count() const { return (int) line_offsets_.size(); }
+
     private:
-        void decode(int p_line, const char* p_token, const char* p_end, InternalPosition& r_pos, int& r_aline, int& r_acol);
-        InternalLine& operator[](int p_line);
+        // [begin, end) of the generated line in `mappings_`
+        void get_line_range(int p_line, const char*& r_begin, const char*& r_end) const;
+
+        // decode all segments of a generated line, `r_state` is advanced to the beginning of the next line.
+        // the decoded segments are appended to `r_segments` if it's not null.
+        bool decode_line(int p_line, State& r_state, LocalVector<Segment>* r_segments) const;
+
+        const LocalVector<Segment>& get_line(int p_line) const;
     };
 }
 #endif
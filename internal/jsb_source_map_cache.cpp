@@ -3,9 +3,123 @@
 #include "jsb_settings.h"
 #include "jsb_format.h"
 #include "jsb_logger.h"
+#include "jsb_content_hash.h"
 
 namespace jsb::internal
 {
+    SourceMapCache::~SourceMapCache()
+    {
+        wait_for_reports();
+
+        // do not lose the errors reported right before shutdown
+        update();
+    }
+
+    void SourceMapCache::report(const String& p_message, const String& p_stacktrace)
+    {
+        // hashing the raw report is much cheaper than translating it, the identical ones are throttled
+        const CharString message_utf8 = p_message.utf8();
+        const CharString stacktrace_utf8 = p_stacktrace.utf8();
+        const uint64_t hash = ContentHash::compute((const uint8_t*) stacktrace_utf8.get_data(), stacktrace_utf8.length(),
+            ContentHash::compute((const uint8_t*) message_utf8.get_data(), message_utf8.length()));
+        const uint64_t now = OS::get_singleton()->get_ticks_msec();
+
+        ReportHistory* history = report_history_.getptr(hash);
+        if (history && now - history->last_time < kReportIntervalMsec)
+        {
+            ++history->suppressed;
+            return;
+        }
+        if (!history)
+        {
+            if (report_history_.size() >= kMaxReportHistory)
+            {
+                report_history_.clear();
+            }
+            history = &report_history_.insert(hash, {})->value;
+        }
+        const uint32_t repeated = history->suppressed;
+        history->last_time = now;
+        history->suppressed = 0;
+
+        MutexLock lock(mutex_);
+        pending_reports_.push_back({ p_message, p_stacktrace, repeated });
+        if (!report_task_running_)
+        {
+            // the previous task is finished (or about to be finished), but still need to be waited
+            if (report_task_ != WorkerThreadPool::INVALID_TASK_ID)
+            {
+                WorkerThreadPool::get_singleton()->wait_for_task_completion(report_task_);
+            }
+            report_task_running_ = true;
+            report_task_ = WorkerThreadPool::get_singleton()->add_native_task(&_symbolicate_reports, this, false, "jsb: symbolicate");
+        }
+    }
+
+    void SourceMapCache::_symbolicate_reports(void* p_userdata)
+    {
+        SourceMapCache* self = (SourceMapCache*) p_userdata;
+        while (true)
+        {
+            LocalVector<Report> reports;
+            {
+                MutexLock lock(self->mutex_);
+                if (self->pending_reports_.is_empty())
+                {
+                    self->report_task_running_ = false;
+                    return;
+                }
+                reports = self->pending_reports_;
+                self->pending_reports_.clear();
+            }
+
+            for (Report& report : reports)
+            {
+                report.stacktrace = self->process_source_position(report.stacktrace);
+            }
+
+            MutexLock lock(self->mutex_);
+            for (Report& report : reports)
+            {
+                self->finished_reports_.push_back(report);
+            }
+        }
+    }
+
+    void SourceMapCache::update()
+    {
+        LocalVector<Report> reports;
+        {
+            MutexLock lock(mutex_);
+            if (finished_reports_.is_empty()) return;
+            reports = finished_reports_;
+            finished_reports_.clear();
+        }
+
+        for (const Report& report : reports)
+        {
+            const String text = report.message.is_empty() ? report.stacktrace : (report.stacktrace.is_empty() ? report.message : report.message + "\n" + report.stacktrace);
+            if (report.repeated == 0) JSB_LOG(Error, "%s", text);
+            else JSB_LOG(Error, "%s\n(repeated %d times)", text, report.repeated);
+        }
+    }
+
+    void SourceMapCache::wait_for_reports()
+    {
+        WorkerThreadPool::TaskID task_id;
+        {
+            MutexLock lock(mutex_);
+            task_id = report_task_;
+            report_task_ = WorkerThreadPool::INVALID_TASK_ID;
+        }
+        if (task_id != WorkerThreadPool::INVALID_TASK_ID)
+        {
+            WorkerThreadPool::get_singleton()->wait_for_task_completion(task_id);
+        }
+        MutexLock lock(mutex_);
+        jsb_check(!report_task_running_);
+    }
+
 #if JSB_WITH_SOURCEMAP
     bool SourceMapCache::match(const String& p_line, MatchResult& r_result)
     {
@@ -44,29 +158,23 @@ namespace jsb::internal
         if (!internal::Settings::get_sourcemap_enabled()) return p_stacktrace;
         if (p_stacktrace.length() == 0) return p_stacktrace;
 
+        MutexLock lock(mutex_);
         bool is_position_set = r_position == nullptr;
         Vector<String> st_lines = p_stacktrace.split("\n");
         MatchResult result;
         for (String& st_line : st_lines)
         {
             if (!match(st_line, result)) continue;
-            const SourceMap* map = find_source_map(result.filename);
-            if (!map) continue;
-            IndexedSourcePosition position;
-            if (!map->find(result.line, result.col, position)) continue;
-            const String& source = map->get_source(position.index);
-            const String& source_root = map->get_source_root();
-            const String original_path = PathUtil::to_platform_specific_path(PathUtil::combine("res://", source_root, source));
+            SourcePosition position;
+            if (!find_source_position(result.filename, result.line, result.col, position)) continue;
 
-            if (result.function.is_empty()) st_line = jsb_format("    at %s:%d:%d", original_path, position.line, position.column);
-            else st_line = jsb_format("    at %s (%s:%d:%d)", result.function, original_path, position.line, position.column);
+            if (result.function.is_empty()) st_line = jsb_format("    at %s:%d:%d", position.filename, position.line, position.column);
+            else st_line = jsb_format("    at %s (%s:%d:%d)", result.function, position.filename, position.line, position.column);
 
             if (!is_position_set)
             {
                 is_position_set = true;
-                r_position->filename = original_path;
-                r_position->line = position.line;
-                r_position->column = position.column;
+                *r_position = position;
                 r_position->function = result.function;
             }
         }
@@ -84,8 +192,22 @@ namespace jsb::internal
         return ret;
     }
 
+    bool SourceMapCache::find_source_position(const String& p_filename, int p_line, int p_column, SourcePosition& r_position)
+    {
+        MutexLock lock(mutex_);
+        const SourceMap* map = find_source_map(p_filename);
+        IndexedSourcePosition position;
+        if (!map || !map->find(p_line, p_column, position)) return false;
+
+        r_position.filename = PathUtil::to_platform_specific_path(PathUtil::combine("res://", map->get_source_root(), map->get_source(position.index)));
+        r_position.line = position.line;
+        r_position.column = position.column;
+        return true;
+    }
+
     void SourceMapCache::invalidate(const String& p_filename)
     {
+        MutexLock lock(mutex_);
         if (cached_source_maps_.erase(p_filename))
         {
             JSB_LOG(Verbose, "invalidating source map cache of file %s", p_filename);
@@ -94,6 +216,9 @@ namespace jsb::internal
 
     void SourceMapCache::clear()
     {
+        // the source maps may be in use by the symbolication task
+        wait_for_reports();
+        MutexLock lock(mutex_);
         source_map_match1_.unref();
         source_map_match2_.unref();
         cached_source_maps_.clear();
@@ -119,7 +244,9 @@ namespace jsb::internal
         return &map;
     }
 #else
-    String SourceMapCache::process_source_position(const String& p_stacktrace) { return p_stacktrace; }
+    String SourceMapCache::process_source_position(const String& p_stacktrace, SourcePosition* r_position) { return p_stacktrace; }
+    bool SourceMapCache::find_source_position(const String& p_filename, int p_line, int p_column, SourcePosition& r_position) { return false; }
     void SourceMapCache::invalidate(const String& p_filename) {}
+    void SourceMapCache::clear() { wait_for_reports(); }
 #endif
 }
@@ -4,6 +4,7 @@
 #include "jsb_internal_pch.h"
 #include "jsb_source_map.h"
 #include "modules/regex/regex.h"
+#include "core/object/worker_thread_pool.h"
 
 namespace jsb::internal
 {
@@ -12,11 +13,57 @@ namespace jsb::internal
         // try to translate the source positions in stacktrace
         String process_source_position(const String& p_stacktrace, SourcePosition* r_position = nullptr);
 
+        // translate a single js source position (`function` is not touched)
+        bool find_source_position(const String& p_filename, int p_line, int p_column, SourcePosition& r_position);
+
         void invalidate(const String& p_filename);
 
         void clear();
 
+        // the stacktrace is translated in WorkerThreadPool, and logged (as an error) in `update()`.
+        // the identical reports are logged at most once in `kReportIntervalMsec` (along with the number of suppressed ones).
+        void report(const String& p_message, const String& p_stacktrace);
+
+        // [owner thread] log the symbolicated reports
+        void update();
+
+        ~SourceMapCache();
+
     private:
+        struct Report
+        {
+            String message;
+            String stacktrace;
+
+            // the number of identical reports suppressed before this one
+            uint32_t repeated = 0;
+        };
+
+        struct ReportHistory
+        {
+            uint64_t last_time = 0;
+            uint32_t suppressed = 0;
+        };
+
+        enum
+        {
+            kReportIntervalMsec = 1000,
+            kMaxReportHistory = 256,
+        };
+
+        static void _symbolicate_reports(void* p_userdata);
+        void wait_for_reports();
+
+        // guards the source maps and the report queues (the symbolication runs in background)
+        Mutex mutex_;
+        bool report_task_running_ = false;
+        WorkerThreadPool::TaskID report_task_ = WorkerThreadPool::INVALID_TASK_ID;
+        LocalVector<Report> pending_reports_;
+        LocalVector<Report> finished_reports_;
+
+        // [owner thread] keyed by the hash of raw reports
+        HashMap<uint64_t, ReportHistory> report_history_;
+
 #if JSB_WITH_SOURCEMAP
         struct MatchResult
         {
@@ -1,6 +1,7 @@
 #include "jsb_source_reader.h"
 #include "jsb_macros.h"
 #include "jsb_logger.h"
+#include "jsb_module_archive.h"
 
 namespace jsb::internal
 {
@@ -10,6 +11,20 @@ namespace jsb::internal
         cached_length_ = file_.is_null() ? 0 : file_->get_length();
     }
 
+    MappedFileSourceReader::MappedFileSourceReader(const String& p_file_name)
+        : path_(p_file_name)
+        , absolute_path_(MappedFile::get_native_path(p_file_name))
+    {
+        file_.open(p_file_name);
+    }
+
+    uint64_t MappedFileSourceReader::get_buffer(uint8_t* p_dst, uint64_t p_length) const
+    {
+        const uint64_t len = std::min(p_length, file_.get_size());
+        memcpy(p_dst, file_.get_data(), len);
+        return len;
+    }
+
     StringSourceReader::StringSourceReader(const String& p_path, const String& p_absolute_path, const String& p_source)
         : path_(p_path)
         , absolute_path_(p_absolute_path)
@@ -24,4 +39,28 @@ namespace jsb::internal
         return len;
     }
 
+    uint64_t BytesSourceReader::get_buffer(uint8_t* p_dst, uint64_t p_length) const
+    {
+        const uint64_t len = std::min(p_length, (uint64_t) buffer_.size());
+        memcpy(p_dst, buffer_.ptr(), len);
+        return len;
+    }
+
+    ArchiveSourceReader::ArchiveSourceReader(const ModuleArchive& p_archive, const String& p_path)
+        : path_(p_path)
+    {
+        if (!p_archive.get_file(p_path, data_, length_))
+        {
+            data_ = nullptr;
+            length_ = 0;
+        }
+    }
+
+    uint64_t ArchiveSourceReader::get_buffer(uint8_t* p_dst, uint64_t p_length) const
+    {
+        const uint64_t len = std::min(p_length, (uint64_t) length_);
+        memcpy(p_dst, data_, len);
+        return len;
+    }
+
 }
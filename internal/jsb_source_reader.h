@@ -1,9 +1,12 @@
 ﻿#ifndef GODOTJS_SOURCE_READER_H
 #define GODOTJS_SOURCE_READER_H
 #include "jsb_internal_pch.h"
+#include "jsb_mapped_file.h"
 
 namespace jsb::internal
 {
+    class ModuleArchive;
+
     class ISourceReader
     {
     public:
@@ -19,8 +22,10 @@ namespace jsb::internal
         virtual uint64_t get_length() const = 0;
         virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const = 0;
 
+        /** Get the content without copying if it's already in memory (valid as long as the reader is alive), otherwise null */
+        virtual const uint8_t* get_data() const { return nullptr; }
+
         virtual uint64_t get_time_modified() const { return 0; }
-        virtual String get_hash() const { return String(); }
     };
 
     class FileAccessSourceReader : public ISourceReader
@@ -41,7 +46,30 @@ namespace jsb::internal
 
 #if JSB_SUPPORT_RELOAD && defined(TOOLS_ENABLED)
         virtual uint64_t get_time_modified() const override { return FileAccess::get_modified_time(file_->get_path()); }
-        virtual String get_hash() const override { return FileAccess::get_md5(file_->get_path()); }
+#endif
+    };
+
+    // read a file on the native filesystem through a memory mapping (see `MappedFile`),
+    // it's preferred for large sources to avoid reading them through the buffered FileAccess
+    class MappedFileSourceReader : public ISourceReader
+    {
+        String path_;
+        String absolute_path_;
+        MappedFile file_;
+
+    public:
+        MappedFileSourceReader(const String& p_file_name);
+        virtual ~MappedFileSourceReader() override = default;
+
+        virtual bool is_null() const override { return !file_.is_open(); }
+        virtual String get_path() const override { return path_; }
+        virtual String get_path_absolute() const override { return absolute_path_; }
+        virtual uint64_t get_length() const override { return file_.get_size(); }
+        virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+        virtual const uint8_t* get_data() const override { return file_.get_data(); }
+
+#if JSB_SUPPORT_RELOAD && defined(TOOLS_ENABLED)
+        virtual uint64_t get_time_modified() const override { return FileAccess::get_modified_time(path_); }
 #endif
     };
 
@@ -61,5 +89,48 @@ namespace jsb::internal
         virtual uint64_t get_length() const override { return buffer_.size(); }
         virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
     };
+
+    // read a source file which is already loaded into memory (e.g. by `ModulePrefetcher`)
+    class BytesSourceReader : public ISourceReader
+    {
+        String path_;
+        String absolute_path_;
+        Vector<uint8_t> buffer_;
+
+    public:
+        BytesSourceReader(const String& p_path, const String& p_absolute_path, const Vector<uint8_t>& p_bytes)
+            : path_(p_path), absolute_path_(p_absolute_path), buffer_(p_bytes) {}
+        virtual ~BytesSourceReader() override = default;
+
+        virtual bool is_null() const override { return buffer_.is_empty(); }
+        virtual String get_path() const override { return path_; }
+        virtual String get_path_absolute() const override { return absolute_path_; }
+        virtual uint64_t get_length() const override { return buffer_.size(); }
+        virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+        virtual const uint8_t* get_data() const override { return buffer_.ptr(); }
+
+#if JSB_SUPPORT_RELOAD && defined(TOOLS_ENABLED)
+        virtual uint64_t get_time_modified() const override { return FileAccess::get_modified_time(path_); }
+#endif
+    };
+
+    // read a file in `ModuleArchive` (the archive must outlive the reader)
+    class ArchiveSourceReader : public ISourceReader
+    {
+        String path_;
+        const uint8_t* data_ = nullptr;
+        uint32_t length_ = 0;
+
+    public:
+        ArchiveSourceReader(const ModuleArchive& p_archive, const String& p_path);
+        virtual ~ArchiveSourceReader() override = default;
+
+        virtual bool is_null() const override { return !data_; }
+        virtual String get_path() const override { return path_; }
+        virtual String get_path_absolute() const override { return path_; }
+        virtual uint64_t get_length() const override { return length_; }
+        virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+        virtual const uint8_t* get_data() const override { return data_; }
+    };
 }
 #endif
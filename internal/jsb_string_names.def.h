@@ -9,6 +9,7 @@ DEF(prototype)
 DEF(__proto__)
 DEF(constructor)
 DEF(value)
+DEF(writable)
 DEF(id)
 DEF(path)
 DEF(exports)
@@ -20,10 +21,12 @@ DEF(cache)
 DEF(children)
 DEF(type)
 DEF(evaluator)
-DEF(_notification)
 DEF(Reflect)
 DEF(construct)
 
+// script virtual methods
+#include "jsb_script_virtual_methods.def.h"
+
 // class names
 DEF(Object)
 DEF(Node)
@@ -56,9 +59,11 @@ DEF(default)
 DEF(JSWorker)
 DEF(ontransfer)
 DEF(onmessage)
+DEF(onmessages)
 DEF(onready)
 DEF(onerror)
 DEF(postMessage)
+DEF(postMessages)
 DEF(transfer)
 DEF(close)
 
@@ -32,6 +32,10 @@ namespace jsb::internal
         HashMap<StringName, StringName> replacements_;     // original => modified (Array => GArray)
         HashMap<StringName, StringName> replacements_inv_; // modified => original (GArray => Array)
 
+        // the exposed names of engine classes/functions are added once by the first environment
+        BinaryMutex exposed_replacements_lock_;
+        bool exposed_replacements_added_ = false;
+
         StringNames();
 
     public:
@@ -59,6 +63,15 @@ namespace jsb::internal
             replacements_inv_.insert(replacement, name);
         }
 
+        // call `p_add` only for the first time (the environments in other threads wait until it's done)
+        void add_exposed_replacements_once(void (*p_add)(StringNames&))
+        {
+            MutexLock lock(exposed_replacements_lock_);
+            if (exposed_replacements_added_) return;
+            exposed_replacements_added_ = true;
+            p_add(*this);
+        }
+
         StringName sn_godot_typeloader;
         StringName sn_godot_postbind;
 
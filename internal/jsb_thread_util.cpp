@@ -4,6 +4,8 @@
 #ifdef WINDOWS_ENABLED
 #   define WIN32_LEAN_AND_MEAN
 #   include <windows.h>
+#elif defined(__linux__)
+#   include <sched.h>
 #endif
 
 namespace jsb::internal
@@ -42,4 +44,24 @@ namespace jsb::internal
         ::Thread::set_name(p_name);
     }
 
+    bool ThreadUtil::set_affinity(uint64_t p_mask)
+    {
+        if (p_mask == 0) return false;
+#if defined(WINDOWS_ENABLED)
+        return ::SetThreadAffinityMask(::GetCurrentThread(), (DWORD_PTR) p_mask) != 0;
+#elif defined(__linux__)
+        // linux and android (pid 0 stands for the calling thread)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int index = 0; index < 64; ++index)
+        {
+            if (p_mask & (1ull << index)) CPU_SET(index, &set);
+        }
+        return ::sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+        // thread affinity is not exposed on apple platforms (only hints via QoS)
+        return false;
+#endif
+    }
+
 }
@@ -8,6 +8,12 @@ namespace jsb::internal
     struct ThreadUtil
     {
         static void set_name(const String& p_name);
+
+        /**
+         * restrict the current thread to run on the given logical processors (bit N for processor N).
+         * \return false if it's not supported on this platform (e.g. macOS/iOS) or failed
+         */
+        static bool set_affinity(uint64_t p_mask);
     };
 }
 #endif
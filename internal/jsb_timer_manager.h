@@ -47,6 +47,15 @@ namespace jsb::internal
         typedef uint64_t Span;
 
     private:
+        // intrusive doubly-linked list of timers (a wheel slot, or the activated timers)
+        struct TimerList
+        {
+            IndexSafe64 head;
+            IndexSafe64 tail;
+
+            jsb_force_inline bool is_empty() const { return !head; }
+        };
+
         struct TimerData
         {
             bool loop;
@@ -55,25 +64,11 @@ namespace jsb::internal
             uint64_t expires;
 
             TFunction action;
-        };
-
-        struct WheelSlot
-        {
-            std::vector<IndexSafe64> timer_indices;
 
-            jsb_force_inline void append(const IndexSafe64& index) { timer_indices.push_back(index); }
-
-            jsb_force_inline void move_to(std::vector<IndexSafe64>& cache)
-            {
-                cache.reserve(cache.size() + timer_indices.size());
-                cache.insert(cache.end(), timer_indices.begin(), timer_indices.end());
-                timer_indices.clear();
-            }
-
-            jsb_force_inline void clear()
-            {
-                timer_indices.clear();
-            }
+            // the list which this timer currently belongs to (at most one at a time)
+            TimerList* list = nullptr;
+            IndexSafe64 prev;
+            IndexSafe64 next;
         };
 
         struct WheelState
@@ -84,7 +79,7 @@ namespace jsb::internal
             uint64_t interval;
             uint64_t range;
 
-            WheelSlot slots[kWheelSlotNum];
+            TimerList slots[kWheelSlotNum];
 
             WheelState() = default;
             WheelState(uint8_t p_depth, uint64_t p_interval) { init(p_depth, p_interval); }
@@ -97,17 +92,15 @@ namespace jsb::internal
                 index = 0;
             }
 
-            uint64_t add(uint64_t p_delay, const IndexSafe64& p_timer_index)
+            TimerList& get_slot(uint64_t p_delay)
             {
                 const uint64_t offset = p_delay >= interval ? (p_delay / interval) - 1 : p_delay / interval;
-                const uint64_t slot_index = (uint64_t)((index + offset) % (uint64_t)kWheelSlotNum);
-                slots[slot_index].append(p_timer_index);
-                return slot_index;
+                return slots[(uint64_t)((index + offset) % (uint64_t)kWheelSlotNum)];
             }
 
-            void next(std::vector<IndexSafe64>& p_active_indices)
+            TimerList& next()
             {
-                slots[index++].move_to(p_active_indices);
+                return slots[index++];
             }
 
             bool round()
@@ -123,9 +116,9 @@ namespace jsb::internal
             void clear()
             {
                 index = 0;
-                for (WheelSlot& slot : slots)
+                for (TimerList& slot : slots)
                 {
-                    slot.clear();
+                    slot = {};
                 }
             }
         };
@@ -134,8 +127,7 @@ namespace jsb::internal
         uint32_t _time_slice;
         SArray<TimerData, IndexSafe64> _used_timers;
         WheelState _wheels[kWheelNum];
-        std::vector<IndexSafe64> _activated_timers;
-        std::vector<IndexSafe64> _moving_timers;
+        TimerList _activated_timers;
 
         static void check_internal_state()
         {
@@ -158,6 +150,10 @@ namespace jsb::internal
             }
         }
 
+        // the lists are referenced by address from the timers
+        TTimerManager(const TTimerManager&) = delete;
+        TTimerManager& operator=(const TTimerManager&) = delete;
+
         // the maximum range of this timer manager type (in milliseconds)
         static constexpr uint64_t get_max_range()
         {
@@ -181,7 +177,7 @@ namespace jsb::internal
         {
             jsb_check(!!p_fn);
             check_internal_state();
-            _used_timers.remove_at(inout_handle.id);
+            _clear_timer(inout_handle.id);
 
             const uint64_t delay = p_first_delay > 0 ? p_first_delay : p_rate;
             const IndexSafe64 index = _used_timers.add(TimerData());
@@ -202,6 +198,23 @@ namespace jsb::internal
 
         jsb_force_inline int size() const { return _used_timers.size(); }
 
+        // if any timer is due but not invoked yet (e.g. deferred by the budget of `invoke_timers`)
+        jsb_force_inline bool has_activated_timers() const { return !_activated_timers.is_empty(); }
+
+        // the time (in milliseconds) to `tick` before the earliest timer is due (at most `p_max`), 0 if any timer is due already
+        uint64_t get_next_delay(uint64_t p_max) const
+        {
+            if (!_activated_timers.is_empty()) return 0;
+            uint64_t delay = p_max;
+            for (const TimerData& timer : _used_timers)
+            {
+                const uint64_t remaining = timer.expires > _elapsed ? timer.expires - _elapsed : 0;
+                if (remaining <= _time_slice) return 0;
+                delay = MIN(delay, remaining - _time_slice);
+            }
+            return delay;
+        }
+
         bool clear_timer(TimerHandle& p_handle)
         {
             if (_clear_timer(p_handle.id))
@@ -220,8 +233,7 @@ namespace jsb::internal
         void clear_all()
         {
             check_internal_state();
-            _activated_timers.clear();
-            _moving_timers.clear();
+            _activated_timers = {};
             for (WheelState& wheel : _wheels)
             {
                 wheel.clear();
@@ -243,7 +255,7 @@ namespace jsb::internal
             {
                 _time_slice -= kJiffies;
                 _elapsed += kJiffies;
-                _wheels[0].next(_activated_timers);
+                _splice(_wheels[0].next(), _activated_timers);
 
                 for (int wheel_index = 0; wheel_index < kWheelNum; ++wheel_index)
                 {
@@ -257,47 +269,50 @@ namespace jsb::internal
                         continue;
                     }
 
-                    _wheels[wheel_index + 1].next(_moving_timers);
-                    for (const IndexSafe64& index : _moving_timers)
+                    // detach the whole slot first, a timer may be rearranged into the same slot again
+                    TimerList moving;
+                    _splice(_wheels[wheel_index + 1].next(), moving);
+                    while (!moving.is_empty())
                     {
-                        TimerData* timer;
-                        if (_used_timers.try_get_value_pointer(index, timer))
+                        const IndexSafe64 index = moving.head;
+                        TimerData& timer = _used_timers.get_value(index);
+                        _unlink(index, timer);
+                        if (timer.expires > _elapsed)
                         {
-                            if (timer->expires > _elapsed)
-                            {
-                                rearrange_timer(index, timer->expires - _elapsed);
-                            }
-                            else
-                            {
-                                _activated_timers.emplace_back(index);
-                            }
+                            rearrange_timer(index, timer.expires - _elapsed);
+                        }
+                        else
+                        {
+                            _link(_activated_timers, index, timer);
                         }
                     }
-                    _moving_timers.clear();
                 }
             }
 
-            return !_activated_timers.empty();
+            return !_activated_timers.is_empty();
         }
 
+        /**
+         * invoke all activated timers in the order they're due.
+         * @param p_budget_usec stop invoking (at least one timer is invoked) once the time budget is exceeded, 0 means unlimited.
+         *        the remaining activated timers are kept and invoked in the next call.
+         */
         template<typename TContext>
-        bool invoke_timers(TContext* ctx)
+        bool invoke_timers(TContext* ctx, uint64_t p_budget_usec = 0)
         {
-            if (_activated_timers.empty()) return false;
-            for (const IndexSafe64& index : _activated_timers)
+            if (_activated_timers.is_empty()) return false;
+            const uint64_t deadline = p_budget_usec != 0 ? OS::get_singleton()->get_ticks_usec() + p_budget_usec : 0;
+            do
             {
-                TimerData* timer;
-                if (!_used_timers.try_get_value_pointer(index, timer))
-                {
-                    // remnant of timer index won't be removed from wheel slots immediately when the timer is cleared.
-                    // it's usually safe to ignore them.
-                    JSB_LOG(Debug, "timer active (invalid) %d", index);
-                    continue;
-                }
-                timer->action(ctx);
+                // the activated timer is removed from the list before invoking,
+                // clearing any timer (even itself) in the action is safe.
+                const IndexSafe64 index = _activated_timers.head;
+                _unlink(index, _used_timers.get_value(index));
+                _used_timers.get_value(index).action(ctx);
 
-                // the `timer` pointer may become invalid during the .action() call (due to internal reallocation in SArray)
+                // the `timer` reference may become invalid during the .action() call (due to internal reallocation in SArray)
                 // get the pointer again for further use
+                TimerData* timer;
                 if (_used_timers.try_get_value_pointer(index, timer) && timer->loop)
                 {
                     // update the next tick time
@@ -309,7 +324,7 @@ namespace jsb::internal
                     _clear_timer(index);
                 }
             }
-            _activated_timers.clear();
+            while (!_activated_timers.is_empty() && (deadline == 0 || OS::get_singleton()->get_ticks_usec() < deadline));
             return true;
         }
 
@@ -317,23 +332,87 @@ namespace jsb::internal
         bool _clear_timer(const IndexSafe64& p_index)
         {
             check_internal_state();
+            TimerData* timer;
+            if (!_used_timers.try_get_value_pointer(p_index, timer))
+            {
+                return false;
+            }
+            _unlink(p_index, *timer);
             return _used_timers.remove_at(p_index);
         }
 
+        void _link(TimerList& p_list, const IndexSafe64& p_index, TimerData& p_timer)
+        {
+            jsb_check(!p_timer.list);
+            p_timer.list = &p_list;
+            p_timer.prev = p_list.tail;
+            p_timer.next = IndexSafe64::none();
+            if (p_list.tail)
+            {
+                _used_timers.get_value(p_list.tail).next = p_index;
+            }
+            else
+            {
+                p_list.head = p_index;
+            }
+            p_list.tail = p_index;
+        }
+
+        void _unlink(const IndexSafe64& p_index, TimerData& p_timer)
+        {
+            TimerList* list = p_timer.list;
+            if (!list)
+            {
+                return;
+            }
+            if (p_timer.prev) _used_timers.get_value(p_timer.prev).next = p_timer.next;
+            else list->head = p_timer.next;
+            if (p_timer.next) _used_timers.get_value(p_timer.next).prev = p_timer.prev;
+            else list->tail = p_timer.prev;
+            p_timer.list = nullptr;
+            p_timer.prev = p_timer.next = IndexSafe64::none();
+        }
+
+        // move all timers in `p_from` to the end of `p_to`
+        void _splice(TimerList& p_from, TimerList& p_to)
+        {
+            if (p_from.is_empty())
+            {
+                return;
+            }
+            for (IndexSafe64 it = p_from.head; it; )
+            {
+                TimerData& timer = _used_timers.get_value(it);
+                timer.list = &p_to;
+                it = timer.next;
+            }
+            if (p_to.tail)
+            {
+                _used_timers.get_value(p_to.tail).next = p_from.head;
+                _used_timers.get_value(p_from.head).prev = p_to.tail;
+            }
+            else
+            {
+                p_to.head = p_from.head;
+            }
+            p_to.tail = p_from.tail;
+            p_from = {};
+        }
+
         void rearrange_timer(const IndexSafe64& p_timer_id, uint64_t p_delay)
         {
-            jsb_check(_used_timers.is_valid_index(p_timer_id));
+            TimerData& timer = _used_timers.get_value(p_timer_id);
             for (WheelState& wheel : _wheels)
             {
                 if (p_delay < wheel.range)
                 {
-                    wheel.add(p_delay, p_timer_id);
+                    _link(wheel.get_slot(p_delay), p_timer_id, timer);
                     return;
                 }
             }
 
             JSB_LOG(Error, "out of time range %d", p_delay);
-            _wheels[kWheelNum - 1].add(p_delay, p_timer_id);
+            _link(_wheels[kWheelNum - 1].get_slot(p_delay), p_timer_id, timer);
         }
     };
 }
@@ -0,0 +1,170 @@
+#include "jsb_trace_events.h"
+#include "jsb_logger.h"
+
+#if JSB_WITH_TRACE_EVENTS
+namespace jsb::internal
+{
+    namespace
+    {
+        struct ThreadBuffer
+        {
+            uint64_t thread_id = 0;
+            bool main_thread = false;
+
+            // only contended while saving
+            SpinLock lock;
+
+            // ring buffer, `write_index` is increased monotonically
+            LocalVector<TraceEvents::Event> events;
+            uint64_t write_index = 0;
+        };
+
+        BinaryMutex buffers_lock_;
+
+        // not released until the process exits, a buffer outlives its thread to keep the events for `save`
+        LocalVector<ThreadBuffer*> buffers_;
+
+        thread_local ThreadBuffer* thread_buffer_ = nullptr;
+
+        void write_escaped(StringBuilder& sb, const String& p_str)
+        {
+            sb.append("\"");
+            sb.append(p_str.json_escape());
+            sb.append("\"");
+        }
+
+        ThreadBuffer* get_thread_buffer()
+        {
+            if (thread_buffer_) return thread_buffer_;
+
+            ThreadBuffer* buffer = memnew(ThreadBuffer);
+            buffer->thread_id = (uint64_t) Thread::get_caller_id();
+            buffer->main_thread = Thread::is_main_thread();
+            buffer->events.resize(JSB_TRACE_EVENTS_PER_THREAD);
+            {
+                MutexLock lock(buffers_lock_);
+                buffers_.push_back(buffer);
+            }
+            thread_buffer_ = buffer;
+            return buffer;
+        }
+    }
+
+    std::atomic<bool> TraceEvents::started_ = false;
+
+    void TraceEvents::_add(const Event& p_event)
+    {
+        ThreadBuffer* buffer = get_thread_buffer();
+        buffer->lock.lock();
+        buffer->events[buffer->write_index++ % JSB_TRACE_EVENTS_PER_THREAD] = p_event;
+        buffer->lock.unlock();
+    }
+
+    void TraceEvents::complete(const char* p_label, const StringName& p_name, uint32_t p_arg, uint64_t p_begin_usec, uint64_t p_end_usec)
+    {
+        if (!is_started()) return;
+        const uint64_t duration = p_end_usec - p_begin_usec;
+        _add({ p_begin_usec, (uint32_t) MIN(duration, (uint64_t) UINT32_MAX - 1), p_arg, p_label, p_name });
+    }
+
+    void TraceEvents::instant(const char* p_label, const StringName& p_name, uint32_t p_arg)
+    {
+        if (!is_started()) return;
+        _add({ OS::get_singleton()->get_ticks_usec(), UINT32_MAX, p_arg, p_label, p_name });
+    }
+
+    void TraceEvents::start()
+    {
+        {
+            MutexLock lock(buffers_lock_);
+            for (ThreadBuffer* buffer : buffers_)
+            {
+                buffer->lock.lock();
+                buffer->write_index = 0;
+                buffer->lock.unlock();
+            }
+        }
+        started_.store(true, std::memory_order_relaxed);
+        JSB_LOG(Verbose, "trace events started");
+    }
+
+    void TraceEvents::stop()
+    {
+        started_.store(false, std::memory_order_relaxed);
+        JSB_LOG(Verbose, "trace events stopped");
+    }
+
+    Error TraceEvents::save(const String& p_path)
+    {
+        StringBuilder sb;
+        sb.append("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+        bool first = true;
+        {
+            MutexLock lock(buffers_lock_);
+            for (ThreadBuffer* buffer : buffers_)
+            {
+                const String tid = itos((int64_t) buffer->thread_id);
+                if (!first) sb.append(",");
+                first = false;
+                sb.append("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":");
+                sb.append(tid);
+                sb.append(",\"args\":{\"name\":");
+                write_escaped(sb, buffer->main_thread ? String("main") : jsb_format("thread %s", tid));
+                sb.append("}}");
+
+                buffer->lock.lock();
+                const uint64_t end = buffer->write_index;
+                const uint64_t begin = end > JSB_TRACE_EVENTS_PER_THREAD ? end - JSB_TRACE_EVENTS_PER_THREAD : 0;
+                for (uint64_t index = begin; index < end; ++index)
+                {
+                    const Event& event = buffer->events[index % JSB_TRACE_EVENTS_PER_THREAD];
+                    sb.append(",{\"cat\":\"jsb\",\"pid\":1,\"tid\":");
+                    sb.append(tid);
+                    sb.append(",\"name\":");
+                    write_escaped(sb, event.label);
+                    sb.append(",\"ts\":");
+                    sb.append(itos((int64_t) event.begin_usec));
+                    if (event.duration_usec == UINT32_MAX)
+                    {
+                        sb.append(",\"ph\":\"i\",\"s\":\"t\"");
+                    }
+                    else
+                    {
+                        sb.append(",\"ph\":\"X\",\"dur\":");
+                        sb.append(itos(event.duration_usec));
+                    }
+                    if (!event.name.is_empty() || event.arg != 0)
+                    {
+                        sb.append(",\"args\":{");
+                        if (!event.name.is_empty())
+                        {
+                            sb.append("\"name\":");
+                            write_escaped(sb, event.name);
+                            if (event.arg != 0) sb.append(",");
+                        }
+                        if (event.arg != 0)
+                        {
+                            sb.append("\"arg\":");
+                            sb.append(itos(event.arg));
+                        }
+                        sb.append("}");
+                    }
+                    sb.append("}");
+                }
+                buffer->lock.unlock();
+            }
+        }
+        sb.append("]}");
+
+        const Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::WRITE);
+        if (file.is_null())
+        {
+            JSB_LOG(Error, "failed to write trace events to %s", p_path);
+            return ERR_FILE_CANT_WRITE;
+        }
+        file->store_string(sb.as_string());
+        JSB_LOG(Log, "trace events saved to %s", p_path);
+        return OK;
+    }
+}
+#endif
@@ -0,0 +1,106 @@
+#ifndef GODOTJS_TRACE_EVENTS_H
+#define GODOTJS_TRACE_EVENTS_H
+#include "jsb_internal_pch.h"
+#include "jsb_macros.h"
+
+#if JSB_WITH_TRACE_EVENTS
+// the arguments are not evaluated unless started
+#   define JSB_TRACE_SCOPE(Label, ...) \
+    ::jsb::internal::TraceScope JSB_CONCAT(__trace_scope_, __LINE__); \
+    if (::jsb::internal::TraceEvents::is_started()) JSB_CONCAT(__trace_scope_, __LINE__).begin(Label, ##__VA_ARGS__)
+#   define JSB_TRACE_INSTANT(Label, ...) \
+    if (::jsb::internal::TraceEvents::is_started()) ::jsb::internal::TraceEvents::instant(Label, ##__VA_ARGS__)
+#   define JSB_TRACE_COMPLETE(Label, BeginUsec, EndUsec) \
+    if (::jsb::internal::TraceEvents::is_started()) ::jsb::internal::TraceEvents::complete(Label, StringName(), 0, BeginUsec, EndUsec)
+#else
+#   define JSB_TRACE_SCOPE(Label, ...) (void) 0
+#   define JSB_TRACE_INSTANT(Label, ...) (void) 0
+#   define JSB_TRACE_COMPLETE(Label, BeginUsec, EndUsec) (void) 0
+#endif
+
+#if JSB_WITH_TRACE_EVENTS
+namespace jsb::internal
+{
+    /**
+     * Record the bridge activity (calls between native and JS, module loads, GC, microtasks, worker messages) as a timeline.
+     * Each thread writes compact events into its own ring buffer (the oldest ones are overwritten),
+     * and they're exported as Chrome trace JSON (which can be opened in chrome://tracing, Perfetto UI or Speedscope).
+     * It costs a relaxed atomic load per event site if not started.
+     */
+    class TraceEvents
+    {
+    public:
+        struct Event
+        {
+            uint64_t begin_usec;
+
+            // UINT32_MAX for instant events
+            uint32_t duration_usec;
+
+            // an optional number (e.g. function id, message size)
+            uint32_t arg;
+
+            // static string literal, the kind of event
+            const char* label;
+
+            // an optional detail (e.g. method name, module id)
+            StringName name;
+        };
+
+        static jsb_force_inline bool is_started() { return started_.load(std::memory_order_relaxed); }
+
+        // start recording (the events recorded before are discarded)
+        static void start();
+        static void stop();
+
+        // write all recorded events in the Chrome trace format (call it after `stop` to get a consistent snapshot)
+        static Error save(const String& p_path);
+
+        static void complete(const char* p_label, const StringName& p_name, uint32_t p_arg, uint64_t p_begin_usec, uint64_t p_end_usec);
+
+        static void instant(const char* p_label, const StringName& p_name = StringName(), uint32_t p_arg = 0);
+        static void instant(const char* p_label, uint32_t p_arg) { instant(p_label, StringName(), p_arg); }
+
+    private:
+        static void _add(const Event& p_event);
+
+        static std::atomic<bool> started_;
+    };
+
+    // record a complete event from `begin` to the end of the scope (see JSB_TRACE_SCOPE)
+    class TraceScope
+    {
+    public:
+        TraceScope() = default;
+
+        jsb_force_inline void begin(const char* p_label, const StringName& p_name = StringName(), uint32_t p_arg = 0)
+        {
+            label_ = p_label;
+            name_ = p_name;
+            arg_ = p_arg;
+            begin_usec_ = OS::get_singleton()->get_ticks_usec();
+        }
+
+        jsb_force_inline void begin(const char* p_label, uint32_t p_arg) { begin(p_label, StringName(), p_arg); }
+
+        jsb_force_inline ~TraceScope()
+        {
+            if (label_)
+            {
+                TraceEvents::complete(label_, name_, arg_, begin_usec_, OS::get_singleton()->get_ticks_usec());
+            }
+        }
+
+        TraceScope(const TraceScope&) = delete;
+        TraceScope& operator=(const TraceScope&) = delete;
+
+    private:
+        const char* label_ = nullptr;
+        StringName name_;
+        uint32_t arg_ = 0;
+        uint64_t begin_usec_ = 0;
+    };
+}
+#endif
+
+#endif
@@ -6,43 +6,75 @@
 
 namespace jsb::internal
 {
+#if JSB_WITH_V8 || JSB_WITH_JAVASCRIPTCORE
+    // v8 and jsc implementation of deleter are probably called from JS gc threads
+    #define JSB_VARIANT_ALLOCATOR_THREAD_SAFE 1
+#else
+    // web and quickjs implementation of deleter are called from owner thread only
+    #define JSB_VARIANT_ALLOCATOR_THREAD_SAFE 0
+#endif
+
     class VariantAllocator
     {
-        bool use_front_ = true;
-        Vector<Variant*> front_;
-        Vector<Variant*> back_;
-        SpinLock spin_lock_;
+        struct PendingNode
+        {
+            Variant* variant;
+            PendingNode* next;
+        };
+
+        // [multiple producers] lock-free list of variants to free, pushed from gc threads
+        std::atomic<PendingNode*> pending_ = nullptr;
+
+        // [owner thread only] variants taken from `pending_` but not freed yet (exceeded the drain budget)
+        PendingNode* backlog_ = nullptr;
 
 #if JSB_DEBUG
         SafeNumeric<uint32_t> alive_variants_num_;
+        SafeNumeric<uint64_t> total_allocs_num_;
+        SafeNumeric<uint64_t> total_frees_num_;
 #endif
 
-#if JSB_WITH_V8 || JSB_WITH_JAVASCRIPTCORE
-        // v8 and jsc implementation of deleter are probably called from JS gc threads
-        // so we need thread-safe version
-        PagedAllocator<Variant, true> paged_allocator_;
-#else
-        // web and quickjs implementation of deleter are called from owner thread only
-        PagedAllocator<Variant, false> paged_allocator_;
+#if JSB_VARIANT_ALLOCATOR_THREAD_SAFE
+        enum : uint32_t
+        {
+            kCacheBatchSize = JSB_VARIANT_ALLOCATOR_CACHE_BATCH,
+            kCacheCapacity = kCacheBatchSize * 2,
+        };
+
+        // the owner thread takes/returns the variants from the shared pool in batches (one lock for each batch),
+        // the other threads (gc) lock it for each variant.
+        // the cached variants are kept constructed as NIL.
+        const Thread::ID owner_thread_id_ = Thread::get_caller_id();
+        uint32_t cache_num_ = 0;
+        Variant* cache_[kCacheCapacity];
+
+        SpinLock lock_;
 #endif
+        PagedAllocator<Variant, false> paged_allocator_;
 
     public:
 #if JSB_DEBUG
         jsb_force_inline uint32_t get_allocated_num() const { return alive_variants_num_.get(); }
+        jsb_force_inline uint64_t get_total_allocs_num() const { return total_allocs_num_.get(); }
+        jsb_force_inline uint64_t get_total_frees_num() const { return total_frees_num_.get(); }
 #else
         // intentionally ignored in release mode
         jsb_force_inline uint32_t get_allocated_num() const { return 0; }
+        jsb_force_inline uint64_t get_total_allocs_num() const { return 0; }
+        jsb_force_inline uint64_t get_total_frees_num() const { return 0; }
 #endif
 
-#if JSB_DEBUG
         ~VariantAllocator()
         {
-            spin_lock_.lock();
-            jsb_notice(front_.is_empty() && back_.is_empty(), "the pending queue is not empty");
-            spin_lock_.unlock();
+#if JSB_DEBUG
+            jsb_notice(!pending_.load() && !backlog_, "the pending queue is not empty");
             jsb_notice(get_allocated_num() == 0, "variant pool leaked");
-        }
 #endif
+#if JSB_VARIANT_ALLOCATOR_THREAD_SAFE
+            // return the cached ones, the paged allocator checks the leaks on destruction
+            flush_cache(cache_num_);
+#endif
+        }
 
         jsb_force_inline Variant* alloc(const Variant& p_templet)
         {
@@ -51,42 +83,103 @@ namespace jsb::internal
             return rval;
         }
 
-        jsb_force_inline Variant* alloc() { increment(); return paged_allocator_.alloc(); }
+#if JSB_VARIANT_ALLOCATOR_THREAD_SAFE
+        jsb_force_inline Variant* alloc()
+        {
+            increment();
+            if (jsb_likely(Thread::get_caller_id() == owner_thread_id_))
+            {
+                if (jsb_unlikely(cache_num_ == 0)) fill_cache();
+                return cache_[--cache_num_];
+            }
+            SpinLockGuard guard(lock_);
+            return paged_allocator_.alloc();
+        }
 
         //NOTE safe to call from other threads only if p_var is not reference-based type
+        jsb_force_inline void free(Variant* p_var)
+        {
+            decrement();
+            if (jsb_likely(Thread::get_caller_id() == owner_thread_id_))
+            {
+                p_var->~Variant();
+                memnew_placement(p_var, Variant);
+                if (jsb_unlikely(cache_num_ == kCacheCapacity)) flush_cache(kCacheBatchSize);
+                cache_[cache_num_++] = p_var;
+                return;
+            }
+            SpinLockGuard guard(lock_);
+            paged_allocator_.free(p_var);
+        }
+#else
+        jsb_force_inline Variant* alloc() { increment(); return paged_allocator_.alloc(); }
+
         jsb_force_inline void free(Variant* p_var) { decrement(); paged_allocator_.free(p_var); }
+#endif
 
         // gc thread
         void free_safe(Variant* p_var)
         {
-            spin_lock_.lock();
-            if (use_front_) front_.push_back(p_var);
-            else back_.push_back(p_var);
-            spin_lock_.unlock();
+            PendingNode* node = memnew(PendingNode { p_var, pending_.load(std::memory_order_relaxed) });
+            while (!pending_.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed)) {}
         }
 
-        // should only be called on owner thread
-        void drain()
+        // should only be called on owner thread.
+        // free at most `p_budget` pending variants (0 means unlimited), the rest are left to the next call.
+        void drain(int p_budget = 0)
         {
-            spin_lock_.lock();
-            Vector<Variant*>& queue = use_front_ ? front_ : back_;
-            use_front_ = !use_front_;
-            spin_lock_.unlock();
-
-            if (!queue.is_empty())
+            int num = 0;
+            while (p_budget <= 0 || num < p_budget)
             {
-                for (Variant* variant : queue)
+                if (!backlog_)
                 {
-                    free(variant);
+                    // take all pending nodes at once, ABA-free since only the owner thread removes nodes
+                    backlog_ = pending_.exchange(nullptr, std::memory_order_acquire);
+                    if (!backlog_) break;
                 }
-                queue.clear();
+
+                PendingNode* node = backlog_;
+                backlog_ = node->next;
+                free(node->variant);
+                memdelete(node);
+                ++num;
             }
         }
 
     private:
+#if JSB_VARIANT_ALLOCATOR_THREAD_SAFE
+        struct SpinLockGuard
+        {
+            SpinLock& lock;
+            jsb_force_inline SpinLockGuard(SpinLock& p_lock) : lock(p_lock) { lock.lock(); }
+            jsb_force_inline ~SpinLockGuard() { lock.unlock(); }
+        };
+
+        void fill_cache()
+        {
+            jsb_check(cache_num_ == 0);
+            SpinLockGuard guard(lock_);
+            while (cache_num_ < kCacheBatchSize)
+            {
+                cache_[cache_num_++] = paged_allocator_.alloc();
+            }
+        }
+
+        // return the last `p_num` cached variants to the shared pool
+        void flush_cache(uint32_t p_num)
+        {
+            jsb_check(p_num <= cache_num_);
+            SpinLockGuard guard(lock_);
+            for (uint32_t index = 0; index < p_num; ++index)
+            {
+                paged_allocator_.free(cache_[--cache_num_]);
+            }
+        }
+#endif
+
 #if JSB_DEBUG
-        jsb_force_inline void increment() { alive_variants_num_.increment(); }
-        jsb_force_inline void decrement() { alive_variants_num_.decrement(); }
+        jsb_force_inline void increment() { alive_variants_num_.increment(); total_allocs_num_.increment(); }
+        jsb_force_inline void decrement() { alive_variants_num_.decrement(); total_frees_num_.increment(); }
 #else
         jsb_force_inline void increment() {}
         jsb_force_inline void decrement() {}
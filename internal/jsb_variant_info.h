@@ -2,6 +2,7 @@
 #define GODOTJS_VARIANT_INFO_H
 #include "jsb_macros.h"
 #include "jsb_variant_util.h"
+#include "jsb_typealias.h"
 
 namespace jsb::internal
 {
@@ -36,12 +37,56 @@ namespace jsb::internal
     {
         Variant::ValidatedUtilityFunction utility_func;
 
+        // (optional) the same function evaluated directly on numbers, used if all arguments are JS numbers
+        double (*number_func)(const double* p_args) = nullptr;
+
         jsb_force_inline bool check_argc(int p_argc) const
         {
             return is_vararg ? p_argc >= argument_types.size() : p_argc == argument_types.size();
         }
     };
 
+    // precomputed call info of a godot object method (MethodBind)
+    struct FMethodBindInfo : FMethodInfoBase
+    {
+        // type-erased `TypeConvert::JSToGDFunc`/`GDToJSFunc` (the js types are not visible here)
+        typedef void (*FConvertFunc)();
+
+        const MethodBind* method_bind;
+        bool is_static;
+        bool has_return;
+
+        // trailing default arguments (aligned to the end of argument_types)
+        Vector<Variant> default_arguments;
+
+        // converters selected by argument_types/return_type when binding the method
+        Vector<FConvertFunc> argument_converters;
+        FConvertFunc return_converter;
+
+        // inline caches of the StringName arguments (the string name cache entry of the last passed js string)
+        mutable Vector<StringNameID> string_name_sites;
+
+        jsb_force_inline bool check_argc(int p_argc) const
+        {
+            return VariantUtil::check_argc(is_vararg, p_argc, default_arguments.size(), argument_types.size());
+        }
+
+        jsb_force_inline int get_argument_count() const { return (int) argument_types.size(); }
+        jsb_force_inline int get_default_argument_count() const { return (int) default_arguments.size(); }
+
+        jsb_force_inline bool has_default_argument(int p_index) const
+        {
+            const int argc = get_argument_count();
+            return p_index < argc && p_index >= argc - get_default_argument_count();
+        }
+
+        jsb_force_inline const Variant& get_default_argument(int p_index) const
+        {
+            jsb_check(has_default_argument(p_index));
+            return default_arguments[p_index - (get_argument_count() - get_default_argument_count())];
+        }
+    };
+
     struct FGetSetInfo
     {
         Variant::ValidatedSetter setter_func;
@@ -57,11 +102,24 @@ namespace jsb::internal
         Vector<Variant::Type> argument_types;
     };
 
+    // the overloaded constructors with the same number of arguments
+    struct FConstructorArityInfo
+    {
+        // indices of FConstructorInfo::variants (in the original order)
+        Vector<int> variants;
+
+        // the first overload taking only numbers (INT/FLOAT), it's what the scan would select if all arguments are numbers. -1 if none.
+        int number_variant = -1;
+    };
+
     struct FConstructorInfo
     {
         // overloaded constructors for a primitive type.
         // they are matched at runtime by num/type of arguments
         Vector<FConstructorVariantInfo> variants;
+
+        // indexed by the number of arguments
+        Vector<FConstructorArityInfo> arities;
     };
 
     struct FPropertyInfo2
@@ -71,21 +129,27 @@ namespace jsb::internal
 
         // extra parameter at the first position for getter/setter (getter2/setter2)
         int index;
+
+        // value type of the property (the return type of getter, or the second argument type of setter)
+        Variant::Type type;
     };
 
     // necessary reflection info for JS func callback (transferred as index with info.Data)
     struct VariantInfoCollection
     {
-        // constructors of Variant types
+        // (only filled in SharedVariantInfo) constructors of Variant types
         Vector<FConstructorInfo> constructors;
 
-        // all global utility function in godot (lerp/ease/type_string/print.. etc.)
+        // (only filled in SharedVariantInfo) all global utility function in godot (lerp/ease/type_string/print.. etc.)
         Vector<FUtilityMethodInfo> utility_funcs;
 
-        // methods of Variant types
+        // (only filled in SharedVariantInfo) methods of Variant types
         Vector<FBuiltinMethodInfo> methods;
 
-        // properties of Variant types
+        // methods of godot object classes (including getters/setters of non-indexed properties)
+        Vector<FMethodBindInfo> method_binds;
+
+        // (only filled in SharedVariantInfo) properties of Variant types
         Vector<FGetSetInfo> getsets;
 
         // for godot properties which have an implicit (hidden) parameter for getter/setter calls
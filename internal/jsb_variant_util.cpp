@@ -5,6 +5,95 @@
 
 namespace jsb::internal
 {
+    namespace
+    {
+        // a plain copy of a variant of these types is already a deep clone (no reference to any other variant)
+        jsb_force_inline bool is_plain_value_type(Variant::Type p_type)
+        {
+            switch (p_type)
+            {
+            case Variant::OBJECT:
+            case Variant::DICTIONARY:
+            case Variant::ARRAY:
+            case Variant::PACKED_BYTE_ARRAY:
+            case Variant::PACKED_INT32_ARRAY:
+            case Variant::PACKED_INT64_ARRAY:
+            case Variant::PACKED_FLOAT32_ARRAY:
+            case Variant::PACKED_FLOAT64_ARRAY:
+            case Variant::PACKED_STRING_ARRAY:
+            case Variant::PACKED_VECTOR2_ARRAY:
+            case Variant::PACKED_VECTOR3_ARRAY:
+            case Variant::PACKED_COLOR_ARRAY:
+            case Variant::PACKED_VECTOR4_ARRAY:
+                return false;
+            default:
+                return true;
+            }
+        }
+
+        // packed arrays can't form cycles, a new packed array sharing the copy-on-write buffer is an independent clone.
+        // (the refcount of CowData is atomic, the first write on either side copies it)
+        jsb_force_inline bool try_clone_packed_array(const Variant& p_variant, Variant& r_clone)
+        {
+            switch (p_variant.get_type())
+            {
+            case Variant::PACKED_BYTE_ARRAY: r_clone = p_variant.operator Vector<uint8_t>(); return true;
+            case Variant::PACKED_INT32_ARRAY: r_clone = p_variant.operator Vector<int32_t>(); return true;
+            case Variant::PACKED_INT64_ARRAY: r_clone = p_variant.operator Vector<int64_t>(); return true;
+            case Variant::PACKED_FLOAT32_ARRAY: r_clone = p_variant.operator Vector<float>(); return true;
+            case Variant::PACKED_FLOAT64_ARRAY: r_clone = p_variant.operator Vector<double>(); return true;
+            case Variant::PACKED_STRING_ARRAY: r_clone = p_variant.operator Vector<String>(); return true;
+            case Variant::PACKED_VECTOR2_ARRAY: r_clone = p_variant.operator Vector<Vector2>(); return true;
+            case Variant::PACKED_VECTOR3_ARRAY: r_clone = p_variant.operator Vector<Vector3>(); return true;
+            case Variant::PACKED_COLOR_ARRAY: r_clone = p_variant.operator Vector<Color>(); return true;
+            case Variant::PACKED_VECTOR4_ARRAY: r_clone = p_variant.operator Vector<Vector4>(); return true;
+            default: return false;
+            }
+        }
+    }
+
+    bool VariantUtil::is_plain_data(const Variant& p_variant, int p_recursion_count)
+    {
+        switch (p_variant.get_type())
+        {
+        case Variant::OBJECT:
+        case Variant::CALLABLE:
+        case Variant::SIGNAL:
+            return false;
+        case Variant::DICTIONARY:
+            {
+                if (p_recursion_count > MAX_RECURSION) return false;
+                const Dictionary dict = p_variant;
+                const Array keys = dict.keys();
+                const Array values = dict.values();
+                for (int i = 0, n = keys.size(); i < n; ++i)
+                {
+                    if (!is_plain_data(keys[i], p_recursion_count + 1) || !is_plain_data(values[i], p_recursion_count + 1)) return false;
+                }
+                return true;
+            }
+        case Variant::ARRAY:
+            {
+                const Array arr = p_variant;
+                // typed array of values (e.g. `Array[int]`), no need to check the elements one by one
+                if (arr.is_typed())
+                {
+                    const Variant::Type element_type = (Variant::Type) arr.get_typed_builtin();
+                    if (element_type != Variant::NIL && element_type != Variant::OBJECT && element_type != Variant::CALLABLE && element_type != Variant::SIGNAL
+                        && element_type != Variant::ARRAY && element_type != Variant::DICTIONARY) return true;
+                }
+                if (p_recursion_count > MAX_RECURSION) return false;
+                for (int i = 0, n = arr.size(); i < n; ++i)
+                {
+                    if (!is_plain_data(arr[i], p_recursion_count + 1)) return false;
+                }
+                return true;
+            }
+        default:
+            return true;
+        }
+    }
+
     Variant VariantUtil::structured_clone(const Variant& p_variant, ReferentialVariantMap<Variant>& p_clone_map, bool& r_valid, int p_recursion_count)
     {
         if (p_recursion_count == 0)
@@ -12,6 +101,19 @@ namespace jsb::internal
             r_valid = true;
         }
 
+        // fast path: no cycle tracking for values which can't reference anything
+        const Variant::Type type = p_variant.get_type();
+        if (is_plain_value_type(type))
+        {
+            return p_variant;
+        }
+
+        Variant clone;
+        if (try_clone_packed_array(p_variant, clone))
+        {
+            return clone;
+        }
+
         Variant* existing_clone = p_clone_map.getptr(p_variant);
 
         if (existing_clone)
@@ -19,9 +121,7 @@ namespace jsb::internal
             return *existing_clone;
         }
 
-        Variant clone;
-
-        switch (p_variant.get_type())
+        switch (type)
         {
             case Variant::Type::OBJECT:
                 ERR_PRINT("Structured clone cannot clone Godot Objects. Godot Objects must be transferred");
@@ -31,6 +131,16 @@ namespace jsb::internal
             case Variant::Type::DICTIONARY:
             {
                 Dictionary original = p_variant;
+
+                // typed dictionary of plain values, a shallow copy is enough
+                if (original.is_typed_key() && original.is_typed_value()
+                    && is_plain_value_type((Variant::Type) original.get_typed_key_builtin())
+                    && is_plain_value_type((Variant::Type) original.get_typed_value_builtin()))
+                {
+                    clone = original.duplicate(false);
+                    break;
+                }
+
                 Dictionary dict_clone;
                 dict_clone.set_typed(original.get_key_type(), original.get_value_type());
 
@@ -68,6 +178,14 @@ namespace jsb::internal
             case Variant::Type::ARRAY:
             {
                 Array original = p_variant;
+
+                // typed array of plain values (e.g. `Array[int]`), a shallow copy is enough
+                if (original.is_typed() && is_plain_value_type((Variant::Type) original.get_typed_builtin()))
+                {
+                    clone = original.duplicate(false);
+                    break;
+                }
+
                 Array arr_clone;
                 arr_clone.set_typed(original.get_element_type());
 
@@ -91,36 +209,6 @@ namespace jsb::internal
                 clone = arr_clone;
                 break;
             }
-            case Variant::Type::PACKED_BYTE_ARRAY:
-                clone = p_variant.operator Vector<uint8_t>().duplicate();
-                break;
-            case Variant::Type::PACKED_INT32_ARRAY:
-                clone = p_variant.operator Vector<int32_t>().duplicate();
-                break;
-            case Variant::Type::PACKED_INT64_ARRAY:
-                clone = p_variant.operator Vector<int64_t>().duplicate();
-                break;
-            case Variant::Type::PACKED_FLOAT32_ARRAY:
-                clone = p_variant.operator Vector<float>().duplicate();
-                break;
-            case Variant::Type::PACKED_FLOAT64_ARRAY:
-                clone = p_variant.operator Vector<double>().duplicate();
-                break;
-            case Variant::Type::PACKED_STRING_ARRAY:
-                clone = p_variant.operator Vector<String>().duplicate();
-                break;
-            case Variant::Type::PACKED_VECTOR2_ARRAY:
-                clone = p_variant.operator Vector<Vector2>().duplicate();
-                break;
-            case Variant::Type::PACKED_VECTOR3_ARRAY:
-                clone = p_variant.operator Vector<Vector3>().duplicate();
-                break;
-            case Variant::Type::PACKED_COLOR_ARRAY:
-                clone = p_variant.operator Vector<Color>().duplicate();
-                break;
-            case Variant::Type::PACKED_VECTOR4_ARRAY:
-                clone = p_variant.operator Vector<Vector4>().duplicate();
-                break;
             default:
                 clone = p_variant;
         }
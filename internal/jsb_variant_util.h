@@ -105,6 +105,31 @@ namespace jsb::internal
 
     struct VariantUtil
     {
+        // types stored without heap allocated data in Variant (no destructor call needed)
+        jsb_force_inline static bool is_trivial_storage_type(const Variant::Type p_type)
+        {
+            switch (p_type)
+            {
+            case Variant::BOOL:
+            case Variant::INT:
+            case Variant::FLOAT:
+            case Variant::VECTOR2:
+            case Variant::VECTOR2I:
+            case Variant::RECT2:
+            case Variant::RECT2I:
+            case Variant::VECTOR3:
+            case Variant::VECTOR3I:
+            case Variant::VECTOR4:
+            case Variant::VECTOR4I:
+            case Variant::PLANE:
+            case Variant::QUATERNION:
+            case Variant::COLOR:
+            case Variant::RID:
+                return true;
+            default: return false;
+            }
+        }
+
         jsb_force_inline static StringName get_type_name(const Variant::Type p_type)
         {
             return StringNames::get_singleton().get_replaced_name(Variant::get_type_name(p_type));
@@ -186,6 +211,9 @@ namespace jsb::internal
         }
 
         static Variant structured_clone(const Variant& p_variant, ReferentialVariantMap<Variant>& p_clone_map, bool& r_valid, int p_recursion_count = 0);
+
+        // if the variant can be encoded by `encode_variant` as is (no object, callable or signal in it, and not too deeply nested)
+        static bool is_plain_data(const Variant& p_variant, int p_recursion_count = 0);
     };
 }
 #endif
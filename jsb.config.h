@@ -35,6 +35,18 @@
 #   endif
 #endif // JSB_MIN_LOG_LEVEL
 
+// collect the calls into script instances for the script profiler of godot (also in release builds, with JSB_DEBUG disabled),
+// it costs a single check of a flag on each call until the profiler is started
+#ifndef JSB_WITH_PROFILING
+#define JSB_WITH_PROFILING 1
+#endif
+
+// count the calls through each reflected binding (method binds, indexed properties, utility functions, methods of Variant types),
+// see `jsb.get_binding_counters`. it costs an increment on each call, only for finding the hot bindings
+#ifndef JSB_WITH_BINDING_COUNTERS
+#define JSB_WITH_BINDING_COUNTERS 0
+#endif
+
 // enable jsb_check
 #ifndef JSB_WITH_CHECK
 #define JSB_WITH_CHECK JSB_DEBUG
@@ -47,7 +59,7 @@
 #define JSB_BENCHMARK 1
 
 // [EXPERIMENTAL] enable auto-complete feature in the input field of REPL.
-//NOTE this feature introduces side effects since it will try to evaluate the input string before you submit.
+// the completions are listed from the members of values already evaluated (only data properties are read, no getter or function is called).
 #define JSB_REPL_AUTO_COMPLETE 1
 
 // (only available when using v8)
@@ -63,13 +75,52 @@
 #define JSB_SUPPORT_RELOAD 1
 
 // EXPERIMENTAL, LIMITED SUPPORT
-// only implemented in v8.impl, jsc.impl and quickjs.impl, temporarily.
+// only implemented in v8.impl, jsc.impl, quickjs.impl and web.impl, temporarily.
+// on the web platform, `godot.web.loader` installs a loader fetching modules over HTTP (with a persistent cache).
 // ---
 //
 // module 'godot-jsb':
 //    - set_async_module_loader
 //    - $import
-#define JSB_SUPPORT_ASYNC_MODULE_LOADER JSB_WITH_V8 || JSB_WITH_QUICKJS || JSB_WITH_JAVASCRIPTCORE
+#define JSB_SUPPORT_ASYNC_MODULE_LOADER JSB_WITH_V8 || JSB_WITH_QUICKJS || JSB_WITH_JAVASCRIPTCORE || JSB_WITH_WEB
+
+// cache the compiled modules (V8 code cache, QuickJS bytecode) under `outDir/.codecache`, and consume them on the next load
+#define JSB_WITH_CODE_CACHE JSB_WITH_V8 || JSB_WITH_QUICKJS
+
+// (in bytes) the caches of compiled modules kept in memory to share between environments (the oldest ones are evicted first)
+#define JSB_CODE_CACHE_MEMORY_LIMIT (64 * 1024 * 1024)
+
+// share the memory of SharedArrayBuffer between environments (master <-> workers) in postMessage, instead of copying it
+#define JSB_WITH_SHARED_ARRAY_BUFFER JSB_WITH_V8 || JSB_WITH_QUICKJS
+
+// clone godot objects and variants in postMessage with the serializer delegates (quickjs-ng still uses the object format of quickjs)
+#define JSB_WITH_VARIANT_SERIALIZATION JSB_WITH_V8 || (JSB_WITH_QUICKJS && !JSB_PREFER_QUICKJS_NG) || JSB_WITH_JAVASCRIPTCORE
+
+// (only available when using v8)
+// sample the JS stacks with v8::CpuProfiler while the script profiler of godot is running
+#define JSB_WITH_SAMPLING_PROFILER JSB_DEBUG && JSB_WITH_V8
+
+// define the methods of godot classes as lazy data properties, the functions are created on the first access instead of when the class is exposed
+// (only implemented in v8.impl and quickjs.impl, the lazy properties of jsc.impl and web.impl carry no data)
+#define JSB_LAZY_METHOD_BINDING JSB_WITH_V8 || JSB_WITH_QUICKJS
+
+// interrupt the JS calls exceeding `runtime/core/script_call_budget_msec` (jsc.impl and web.impl can't be interrupted from another thread)
+#define JSB_WITH_WATCHDOG JSB_WITH_V8 || JSB_WITH_QUICKJS
+
+// read the module sources and the module archive on the native filesystem through memory mappings (mmap/MapViewOfFile),
+// it falls back to FileAccess for the files in packages
+#define JSB_WITH_MAPPED_SOURCE 1
+
+// read, wrap and hash the compiled module of a GodotJSScript (and load its code cache) in the resource loading thread
+// if it's loaded with `ResourceLoader::load_threaded_request`, only the evaluation is left to the environment thread
+#define JSB_WITH_THREADED_SCRIPT_PRELOAD 1
+
+// record the bridge activity into per-thread ring buffers with `jsb.trace_events` or `runtime/debugger/trace_events_path`,
+// it costs a relaxed atomic load per event site if not started
+#define JSB_WITH_TRACE_EVENTS 1
+
+// capacity of the ring buffer of each thread (the oldest events are overwritten)
+#define JSB_TRACE_EVENTS_PER_THREAD (1024 * 64)
 
 // translate the js source stacktrace with source map (currently, the `.map` file must locate at the same filename & directory of the js source)
 #define JSB_WITH_SOURCEMAP 1
@@ -80,8 +131,9 @@
 // construct a Variant with `Variant::construct` instead of `VariantUtilityFunctions::type_convert`
 #define JSB_CONSTRUCT_DEFAULT_VARIANT_SLOW 0
 
-// NOT IMPLEMENTED YET
-#define JSB_WITH_STATIC_BINDINGS 0
+// replace the reflected builtin methods of the hot primitive types (Vector2, Vector3) with type-exact bindings,
+// other methods still fall back to reflection
+#define JSB_WITH_STATIC_BINDINGS 1
 
 // utf16 conversion may have less overhead, but uses more memory?
 #define JSB_UTF16_CONV_PREFERRED 1
@@ -89,6 +141,16 @@
 // quickjs.impl only, all Object(JSValue) must be explicitly free-ed on the Isolate disposing
 #define JSB_STRICT_DISPOSE 1
 
+// quickjs.impl only, max number of values on the handle stack (a multiple of 512, less than 65536).
+// the first 512 values are embedded in Isolate, the rest are allocated in segments of 512 values on demand.
+#ifndef JSB_QUICKJS_MAX_STACK_SIZE
+#define JSB_QUICKJS_MAX_STACK_SIZE (512 * 32)
+#endif
+
+// quickjs.impl only, allocate the small blocks (objects, shapes, properties etc.) of a QuickJS runtime from the slab allocator owned by the isolate,
+// instead of the general allocator. all slab pages of a runtime (and worker) are freed at once on disposing.
+#define JSB_QUICKJS_SLAB_ALLOCATOR 1
+
 // use bigint if a value can not represented as Integer(Number)
 #define JSB_WITH_BIGINT 1
 
@@ -100,9 +162,33 @@
 // [EXPERIMENTAL] use optimized wrapper function calls if possible
 #define JSB_FAST_REFLECTION 1
 
+// register v8 Fast API callbacks (v8::CFunction) along with the const engine methods which take and return only numbers and bools,
+// optimized code calls them without FunctionCallbackInfo. only for v8 12.8 or later (it's turned off in jsb_v8_pch.h otherwise)
+#define JSB_V8_FAST_API_CALLS JSB_WITH_V8 && JSB_FAST_REFLECTION
+
 // implicitly convert a javascript array as godot Vector<T> which is convenient but less performant if massively used
 #define JSB_IMPLICIT_PACKED_ARRAY_CONVERSION 1
 
+// [opt-in] convert Dictionary/Array values into plain javascript objects/arrays (deeply, and the reverse) instead of wrapping them,
+// it changes the behaviour of the scripts (modifications on the converted values are not reflected in godot)
+#define JSB_DEEP_CONTAINER_CONVERSION 0
+
+// max depth of the nested containers in JSB_DEEP_CONTAINER_CONVERSION (to stop on cyclic references)
+#define JSB_DEEP_CONTAINER_CONVERSION_MAX_DEPTH 64
+
+// max number of variants (released by gc threads) to free on the main thread per update, the rest are left to the next frames.
+// 0 or negative values means unlimited.
+#define JSB_VARIANT_DRAIN_BUDGET 4096
+
+// the least time (in microseconds) spent on binding the prewarmed godot classes per frame (`runtime/core/prewarm_classes`),
+// the idle time of the frame is used if there is more of it. at least one class is bound per frame.
+#define JSB_PREWARM_CLASSES_FRAME_BUDGET_USEC 1000
+
+// (only available when using v8)
+// [EXPERIMENTAL] store the Variant of plain math primitives (Vector2/Vector3/Color etc.) in the backing store owned by the JS object,
+// instead of allocating from VariantAllocator and releasing it in a deleter callback.
+#define JSB_INLINE_VALUETYPE_STORAGE 0
+
 // not to generate method declaration if already defined as get/set property
 #define JSB_EXCLUDE_GETSET_METHODS 1
 
@@ -117,14 +203,19 @@
 // [EXPERIMENTAL] DONT CHANGE IT
 #define JSB_THREADING 1
 
-// [EXPERIMENTAL] DONT CHANGE IT, AND NEED CLANG TOOLSET IF USING MSVC
-#if !defined(_MSC_VER) || defined(__clang__)
-#   define JSB_V8_CPPGC 0 // 1
-#else 
+// wrap godot objects and valuetypes with cppgc (the unified heap of v8) instead of weak handles with gc callbacks.
+// the native part of a wrapper is finalized along with the JS object, v8 is aware of the native memory it holds.
+// only for v8 (12.8 or later), and it needs clang toolset if using MSVC.
+#if !defined(JSB_V8_CPPGC)
+#   define JSB_V8_CPPGC 0
+#endif
+#if JSB_V8_CPPGC && (!JSB_WITH_V8 || (defined(_MSC_VER) && !defined(__clang__)))
+#   undef JSB_V8_CPPGC
 #   define JSB_V8_CPPGC 0
 #endif
 
 #define JSB_SHADOW_ENVIRONMENT_AS_PARSER 1
+// default value of the `shadow_environment_pool_size` setting
 #define JSB_MAX_CACHED_SHADOW_ENVIRONMENTS 2
 
 // size limitation for string name cache.
@@ -134,6 +225,7 @@
 
 // slots for object/script/class info is reallocated on heap (as a whole block of memory)
 // a suitable value can avoid unnecessary reallocation
+// (the object/script slots are the defaults of the project settings `runtime/core/initial_*_slots`)
 #define JSB_MASTER_INITIAL_OBJECT_SLOTS (1024 * 64)
 #define JSB_MASTER_INITIAL_SCRIPT_SLOTS 1024
 #define JSB_MASTER_INITIAL_CLASS_EXTRA_SLOTS 0
@@ -142,6 +234,37 @@
 #define JSB_WORKER_INITIAL_SCRIPT_SLOTS 1024
 #define JSB_WORKER_INITIAL_CLASS_SLOTS 512
 
+// (server profile) the defaults of `runtime/server/initial_*_slots` (a server has no UI or visual nodes bound to scripts)
+#define JSB_SERVER_INITIAL_OBJECT_SLOTS (1024 * 8)
+#define JSB_SERVER_INITIAL_SCRIPT_SLOTS 256
+
+// (server profile) the default of `runtime/server/tick_rate`
+#define JSB_SERVER_TICK_RATE 60
+
+// (server profile) the max number of ticks run in a frame to catch up, the rest are dropped (a stalled frame doesn't fire a burst of timers)
+#define JSB_SERVER_MAX_CATCHUP_TICKS 4
+
+// (in milliseconds) the default of `runtime/debugger/metrics_interval_msec`
+#define JSB_METRICS_INTERVAL_MSEC 1000
+
+// (v8 and jsc) the number of variants moved between the owner thread cache of VariantAllocator and its shared pool at once
+#define JSB_VARIANT_ALLOCATOR_CACHE_BATCH 64
+
+// (in bytes) the inline block of the per-thread scratch arena (argument arrays and string conversions of binding calls),
+// and the min size of the blocks allocated on demand if it's exhausted (kept for reuse until the thread exits)
+#define JSB_SCRATCH_ARENA_INLINE_SIZE (16 * 1024)
+#define JSB_SCRATCH_ARENA_BLOCK_SIZE (64 * 1024)
+
+// (in milliseconds) an idle worker sleeps until a message arrives or the earliest timer is due,
+// but wakes up at least once in this interval for housekeeping (e.g. releasing the variants freed by gc),
+// the works which can only be polled (e.g. prefetching modules) use the poll interval instead.
+#define JSB_WORKER_MAX_IDLE_TIME 100
+#define JSB_WORKER_POLL_INTERVAL 10
+
+// max number of console messages waiting for the flush of buffered console output (see `runtime/logger/buffered_console_output`),
+// the messages beyond it are dropped (and counted) instead of growing without bound if the main thread stalls
+#define JSB_CONSOLE_MAX_PENDING_MESSAGES (1024 * 8)
+
 // always exclude the worker scripts (end with `.worker.js/ts`) from ResourceLoader.
 // they should only be loaded by JSWorker.
 #define JSB_EXCLUDE_WORKER_RES_SCRIPTS 1
@@ -12105,6 +12105,46 @@ int JS_IsArrayBuffer(JSValueConst val)
         return FALSE;
     }
 }
+int JS_IsProxy(JSValueConst val)
+{
+    JSObject *p;
+    if (JS_VALUE_GET_TAG(val) == JS_TAG_OBJECT) {
+        p = JS_VALUE_GET_OBJ(val);
+        return p->class_id == JS_CLASS_PROXY;
+    } else {
+        return FALSE;
+    }
+}
+/* return the characters of a 8 bit string (valid as long as the string is alive), or NULL if it's not a 8 bit string */
+const uint8_t *JS_GetLatin1String(JSValueConst val, size_t *plen)
+{
+    JSString *p;
+    if (JS_VALUE_GET_TAG(val) != JS_TAG_STRING)
+        return NULL;
+    p = JS_VALUE_GET_PTR(val);
+    if (p->is_wide_char)
+        return NULL;
+    *plen = p->len;
+    return p->u.str8;
+}
+JSValue JS_NewLatin1String(JSContext *ctx, const uint8_t *buf, size_t len)
+{
+    return js_new_string8(ctx, buf, (int)len);
+}
+/* an ordinary object (not an array, function or any other builtin/host class) */
+int JS_IsPlainObject(JSValueConst val)
+{
+    return JS_VALUE_GET_TAG(val) == JS_TAG_OBJECT && JS_VALUE_GET_OBJ(val)->class_id == JS_CLASS_OBJECT;
+}
+int JS_IsSharedArrayBuffer(JSValueConst val)
+{
+    return JS_VALUE_GET_TAG(val) == JS_TAG_OBJECT && JS_VALUE_GET_OBJ(val)->class_id == JS_CLASS_SHARED_ARRAY_BUFFER;
+}
+/* return the elements of a fast array (invalidated if the array is modified), or FALSE if it's not a fast array */
+int JS_GetFastArray(JSValueConst obj, JSValue **parray, uint32_t *plen)
+{
+    return js_get_fast_array(NULL, obj, parray, plen);
+}
 //NOTE jsb:modified [end]
 
 static double js_pow(double a, double b)
@@ -54817,6 +54857,46 @@ static JSValue js_typed_array_constructor(JSContext *ctx,
     return obj;
 }
 
+//NOTE jsb:modified [begin]
+/* return the element type of a typed array (in the order of JS_CLASS_UINT8C_ARRAY ... JS_CLASS_FLOAT64_ARRAY), or -1 if it's not a typed array */
+int JS_GetTypedArrayType(JSValueConst obj)
+{
+    JSObject *p;
+    if (JS_VALUE_GET_TAG(obj) != JS_TAG_OBJECT)
+        return -1;
+    p = JS_VALUE_GET_OBJ(obj);
+    if (p->class_id < JS_CLASS_UINT8C_ARRAY || p->class_id > JS_CLASS_FLOAT64_ARRAY)
+        return -1;
+    return p->class_id - JS_CLASS_UINT8C_ARRAY;
+}
+/* create a typed array (type from JS_GetTypedArrayType) over a new ArrayBuffer with a copy of 'buf' */
+JSValue JS_NewTypedArrayCopy(JSContext *ctx, int type, const uint8_t *buf, size_t byte_length)
+{
+    JSValue buffer, obj;
+    int classid, size_log2;
+
+    if (type < 0 || type > JS_CLASS_FLOAT64_ARRAY - JS_CLASS_UINT8C_ARRAY)
+        return JS_ThrowRangeError(ctx, "invalid typed array type");
+    classid = JS_CLASS_UINT8C_ARRAY + type;
+    size_log2 = typed_array_size_log2(classid);
+    if ((byte_length & ((1 << size_log2) - 1)) != 0)
+        return JS_ThrowRangeError(ctx, "invalid length");
+    buffer = JS_NewArrayBufferCopy(ctx, buf, byte_length);
+    if (JS_IsException(buffer))
+        return JS_EXCEPTION;
+    obj = js_create_from_ctor(ctx, JS_UNDEFINED, classid);
+    if (JS_IsException(obj)) {
+        JS_FreeValue(ctx, buffer);
+        return JS_EXCEPTION;
+    }
+    if (typed_array_init(ctx, obj, buffer, 0, byte_length >> size_log2)) {
+        JS_FreeValue(ctx, obj);
+        return JS_EXCEPTION;
+    }
+    return obj;
+}
+//NOTE jsb:modified [end]
+
 static void js_typed_array_finalizer(JSRuntime *rt, JSValue val)
 {
     JSObject *p = JS_VALUE_GET_OBJ(val);
@@ -750,6 +750,14 @@ int JS_IsArray(JSContext *ctx, JSValueConst val);
 int JS_IsMap(JSValueConst val);
 int JS_IsPromise(JSValueConst val);
 int JS_IsArrayBuffer(JSValueConst val);
+int JS_IsProxy(JSValueConst val);
+const uint8_t *JS_GetLatin1String(JSValueConst val, size_t *plen);
+JSValue JS_NewLatin1String(JSContext *ctx, const uint8_t *buf, size_t len);
+int JS_IsPlainObject(JSValueConst val);
+int JS_IsSharedArrayBuffer(JSValueConst val);
+int JS_GetFastArray(JSValueConst obj, JSValue **parray, uint32_t *plen);
+int JS_GetTypedArrayType(JSValueConst obj);
+JSValue JS_NewTypedArrayCopy(JSContext *ctx, int type, const uint8_t *buf, size_t byte_length);
 //NOTE jsb:modified [end]
 
 JSValue JS_GetPropertyInternal(JSContext *ctx, JSValueConst obj,
@@ -1,6 +1,5 @@
 import type {
     ExtractValueKeys,
-    FileAccess,
     GArray,
     GDictionary,
     GReadProxyValueWrap,
@@ -23,6 +22,9 @@ const names = jsb.internal.names;
 
 const js_object_key_types = new Set(["string", "byte", "int32", "int64", "float32", "float64", "uint32"]);
 
+// operators which also have an in-place instance method (`<op>_into`) in primitive types
+const kIntoOperators = new Set(["ADD", "SUBTRACT", "MULTIPLY", "DIVIDE"]);
+
 function camel_property_overrides(overrides: undefined | Record<string, string[] | ((line: string) => string)>) {
     const get_member = jsb.internal.names.get_member;
     return overrides && Object.fromEntries(
@@ -97,6 +99,11 @@ function mutate_template(template: string) {
     };
 }
 
+const array_buffer_view_intro = [
+    "/** [jsb utility method] Returns an ArrayBuffer sharing the storage of this array without copying (copied on web). Writes through the buffer are visible to all copies sharing the storage, `duplicate()` first if it's not expected. */",
+    `${names.get_member("as_array_buffer")}(): ArrayBuffer`,
+];
+
 const TypeMutations: Record<string, TypeMutation> = {
     AnimationLibrary: {
         prelude: [
@@ -466,8 +473,30 @@ const TypeMutations: Record<string, TypeMutation> = {
         intro: [
             "/** [jsb utility method] Converts a PackedByteArray to a JavaScript ArrayBuffer. */",
             `${names.get_member("to_array_buffer")}(): ArrayBuffer`,
+            ...array_buffer_view_intro,
         ],
     },
+    PackedInt32Array: {
+        intro: array_buffer_view_intro,
+    },
+    PackedInt64Array: {
+        intro: array_buffer_view_intro,
+    },
+    PackedFloat32Array: {
+        intro: array_buffer_view_intro,
+    },
+    PackedFloat64Array: {
+        intro: array_buffer_view_intro,
+    },
+    PackedVector2Array: {
+        intro: array_buffer_view_intro,
+    },
+    PackedVector3Array: {
+        intro: array_buffer_view_intro,
+    },
+    PackedColorArray: {
+        intro: array_buffer_view_intro,
+    },
     PackedScene: {
         generic_parameters: {
             T: {
@@ -1355,6 +1384,34 @@ const annotation_types = {
                             ],
                         },
                     },
+                    batched: {
+                        type: DescriptorType.FunctionLiteral,
+                        parameters: [],
+                        returns: {
+                            type: DescriptorType.FunctionLiteral,
+                            parameters: [
+                                { name: "target", type: { type: DescriptorType.Godot, name: "GObjectConstructor" } },
+                                {
+                                    name: "_context",
+                                    type: { type: DescriptorType.Godot, name: "ClassDecoratorContext" },
+                                },
+                            ],
+                        },
+                    },
+                    cached_exports: {
+                        type: DescriptorType.FunctionLiteral,
+                        parameters: [],
+                        returns: {
+                            type: DescriptorType.FunctionLiteral,
+                            parameters: [
+                                { name: "target", type: { type: DescriptorType.Godot, name: "GObjectConstructor" } },
+                                {
+                                    name: "_context",
+                                    type: { type: DescriptorType.Godot, name: "ClassDecoratorContext" },
+                                },
+                            ],
+                        },
+                    },
                     icon: {
                         type: DescriptorType.FunctionLiteral,
                         parameters: [
@@ -1811,6 +1868,11 @@ const annotation_types = {
                 name: "Godot.PropertyUsageFlags",
                 optional: true,
             },
+            default: {
+                type: DescriptorType.Godot,
+                name: "any",
+                optional: true,
+            },
         },
     }),
     RPCConfig: godot.GDictionary.create<ObjectLiteralTypeDescriptor>({
@@ -2455,6 +2517,13 @@ class ClassWriter extends IndentWriter {
         }
     }
 
+    // the in-place version of arithmetic operators, e.g. `a.add_into(b, out)`
+    operator_into_(operator_info: GodotJsb.editor.OperatorInfo) {
+        const return_type_name = VariantTypeNames.get(operator_info.return_type);
+        const right_type_name = get_primitive_type_name_as_input(operator_info.right_type);
+        this.line(`${names.get_member(operator_info.name.toLowerCase() + "_into")}(right: ${right_type_name}, out: ${return_type_name}): ${return_type_name}`);
+    }
+
     virtual_method_(method_info: GodotJsb.editor.MethodBind) {
         this.method_(method_info, "/* gdvirtual */ ");
     }
@@ -2734,8 +2803,123 @@ class PropertyWriter extends BufferingWriter {
     }
 }
 
+// fnv-1a (32 bits) of the utf-16 code units, only used to detect changes of the generated units
+function content_hash(text: string): string {
+    let hash = 0x811c9dc5;
+    for (let i = 0, l = text.length; i < l; ++i) {
+        hash ^= text.charCodeAt(i);
+        hash = Math.imul(hash, 0x01000193);
+    }
+    return (hash >>> 0).toString(16) + ":" + text.length.toString(16);
+}
+
+interface CodegenManifestUnit {
+    // hash of the source data which the unit is generated from (if known)
+    input?: string;
+    // hash of the generated content
+    output: string;
+}
+
+/**
+ * Hashes of the generated units (one for each generated file) in an output directory,
+ * it's used to skip regenerating the units with unchanged source data and rewriting the files with unchanged content.
+ * Unchanged files are not touched, so that the filesystem scan and the typescript language service are not triggered for nothing.
+ */
+class CodegenManifest {
+    // bump it if the generated content changes for the same source data
+    private static readonly kVersion = 1;
+    private static readonly kFileName = ".codegen.manifest.json";
+    private static _manifests = new Map<string, CodegenManifest>();
+
+    private _path: string;
+    private _units: Record<string, CodegenManifestUnit> = {};
+    private _dirty = false;
+
+    // the manifest of an output directory is loaded only once in the editor session
+    static get(out_dir: string): CodegenManifest {
+        let manifest = this._manifests.get(out_dir);
+        if (!manifest) {
+            manifest = new CodegenManifest(out_dir);
+            this._manifests.set(out_dir, manifest);
+        }
+        return manifest;
+    }
+
+    private constructor(out_dir: string) {
+        this._path = (out_dir.length == 0 || out_dir.endsWith("/") ? out_dir : out_dir + "/") + CodegenManifest.kFileName;
+        if (!godot.FileAccess.file_exists(this._path)) {
+            return;
+        }
+        try {
+            const data = JSON.parse(godot.FileAccess.get_file_as_string(this._path));
+            if (data?.version === CodegenManifest.kVersion && typeof data.units === "object") {
+                this._units = data.units;
+            }
+        } catch (e) {
+            console.warn(`ignore the broken codegen manifest: ${this._path}`);
+        }
+    }
+
+    // whether the unit was generated from the same source data and the file is still there
+    is_up_to_date(path: string, input: string): boolean {
+        const unit = this._units[path];
+        return typeof unit === "object" && unit.input === input && godot.FileAccess.file_exists(path);
+    }
+
+    /**
+     * write the content of a unit if it's changed
+     * @returns false if the file is left untouched
+     */
+    write(path: string, content: string, input?: string): boolean {
+        const output = content_hash(content);
+        const unit = this._units[path];
+        if (typeof unit === "object" && unit.output === output && godot.FileAccess.file_exists(path)) {
+            if (unit.input !== input) {
+                unit.input = input;
+                this._dirty = true;
+            }
+            return false;
+        }
+
+        const file = godot.FileAccess.open(path, godot.FileAccess.ModeFlags.WRITE);
+        if (!file) {
+            throw new Error(`failed to open file for writing: ${path}`);
+        }
+        try {
+            file.store_string(content);
+        } finally {
+            file.close();
+        }
+        this._units[path] = { input, output };
+        this._dirty = true;
+        return true;
+    }
+
+    remove(path: string) {
+        if (typeof this._units[path] === "object") {
+            delete this._units[path];
+            this._dirty = true;
+        }
+    }
+
+    save() {
+        if (!this._dirty) {
+            return;
+        }
+        const file = godot.FileAccess.open(this._path, godot.FileAccess.ModeFlags.WRITE);
+        if (!file) {
+            console.warn(`failed to write the codegen manifest: ${this._path}`);
+            return;
+        }
+        file.store_string(JSON.stringify({ version: CodegenManifest.kVersion, units: this._units }));
+        file.close();
+        this._dirty = false;
+    }
+}
+
+// the generated content is buffered, and written by the owner through `CodegenManifest.write` at last
 class FileWriter extends AbstractWriter {
-    private _file: FileAccess;
+    private _chunks: string[] = [];
     private _size = 0;
     private _lineno = 0;
     private _types: TypeDB;
@@ -2756,11 +2940,10 @@ class FileWriter extends AbstractWriter {
         return preferred_name;
     }
 
-    constructor(path: string, types: TypeDB, file: FileAccess) {
+    constructor(path: string, types: TypeDB) {
         super();
         this._path = path;
         this._types = types;
-        this._file = file;
     }
 
     add_import(preferred_name: string, script_resource: string, export_name = "default"): void {
@@ -2800,38 +2983,44 @@ class FileWriter extends AbstractWriter {
     get types() { return this._types; }
 
     line(text: string): void {
-        this._file.store_line(text);
+        this._chunks.push(text, "\n");
         this._size += text.length + 1;
         this._lineno += 1;
     }
 
     concatenate(text: string): void {
-        this._file.store_string(text);
+        this._chunks.push(text);
         this._size += text.length;
     }
 
     finish(): void {
-        this._file.flush();
+    }
+
+    get content(): string {
+        return this._chunks.join("");
     }
 }
 
 class FileSplitter {
-    private _file: FileAccess;
+    private _path: string;
+    private _writer: FileWriter;
     private _toplevel: ModuleWriter;
     private _types: TypeDB;
+    private _manifest: CodegenManifest;
 
-    constructor(types: TypeDB, path: string) {
+    constructor(types: TypeDB, path: string, manifest: CodegenManifest) {
+        this._path = path;
         this._types = types;
-        this._file = godot.FileAccess.open(path, godot.FileAccess.ModeFlags.WRITE);
-        this._toplevel = new ModuleWriter(new FileWriter(path, this._types, this._file), "godot");
-
-        this._file.store_line("// AUTO-GENERATED");
+        this._manifest = manifest;
+        this._writer = new FileWriter(path, this._types);
+        this._writer.line("// AUTO-GENERATED");
+        this._toplevel = new ModuleWriter(this._writer, "godot");
     }
 
     close() {
         this._toplevel.finish();
-        this._file.flush();
-        this._file.close();
+        this._writer.finish();
+        this._manifest.write(this._path, this._writer.content);
     }
 
     get_writer() {
@@ -2851,6 +3040,20 @@ export class TypeDB {
 
     // `class_doc` is loaded lazily once used, and be cached in `class_docs`
     class_docs: { [name: string]: GodotJsb.editor.ClassDoc | false } = {};
+    private _class_docs_loaded = false;
+
+    private static _shared: TypeDB | undefined;
+
+    /**
+     * the engine types are queried only once in the editor session (it's expensive to collect all classes),
+     * since they're not changed unless a full generation (`refresh`) is requested.
+     */
+    static get_shared(refresh = false): TypeDB {
+        if (refresh || !this._shared) {
+            this._shared = new TypeDB();
+        }
+        return this._shared;
+    }
 
     constructor() {
         const classes = jsb.editor.get_classes();
@@ -2883,6 +3086,17 @@ export class TypeDB {
         if (typeof class_doc === "boolean") {
             return undefined;
         }
+        if (!this._class_docs_loaded) {
+            // load the docs of all known types in one query instead of one by one
+            this._class_docs_loaded = true;
+            const docs = jsb.editor.get_class_docs([...Object.keys(this.classes), ...Object.keys(this.primitive_types), "@GlobalScope"]);
+            for (const name in docs) {
+                this.class_docs[name] ??= docs[name];
+            }
+            if (typeof this.class_docs[class_name] === "object") {
+                return <GodotJsb.editor.ClassDoc>this.class_docs[class_name];
+            }
+        }
         let loaded_doc = jsb.editor.get_class_doc(class_name);
         this.class_docs[class_name] = loaded_doc || false
         return loaded_doc;
@@ -3110,13 +3324,16 @@ export class TSDCodeGen {
     private _out_dir: string;
     private _splitter: FileSplitter | undefined;
     private _types: TypeDB;
+    private _manifest: CodegenManifest;
     private _use_project_settings: boolean;
 
     constructor(outDir: string, use_project_settings: boolean) {
         this._split_index = 0;
         this._out_dir = outDir;
         this._use_project_settings = use_project_settings;
-        this._types = new TypeDB();
+        // a full generation always queries the engine types again
+        this._types = TypeDB.get_shared(true);
+        this._manifest = CodegenManifest.get(outDir);
     }
 
     private make_path(index: number) {
@@ -3136,7 +3353,7 @@ export class TSDCodeGen {
         }
         const filename = this.make_path(this._split_index++);
         console.log("new writer", filename);
-        this._splitter = new FileSplitter(this._types, filename);
+        this._splitter = new FileSplitter(this._types, filename, this._manifest);
         return this._splitter;
     }
 
@@ -3163,6 +3380,7 @@ export class TSDCodeGen {
             }
             console.log("delete file", path);
             jsb.editor.delete_file(path);
+            this._manifest.remove(path);
         }
     }
 
@@ -3221,40 +3439,31 @@ export class TSDCodeGen {
         tasks.add_task("jsb.runtime", () => {
             const path = "/jsb.runtime.gen.d.ts";
             const dir_path = this._out_dir + path;
-            const file = godot.FileAccess.open(dir_path, godot.FileAccess.ModeFlags.WRITE);
-
-            if (!file) {
-                throw new Error(`failed to open file for writing: ${dir_path}`);
-            }
-
-            const runtime_gen = new FileWriter(dir_path, this._types, file);
-
-            try {
-                const module = new ModuleWriter(
-                    runtime_gen,
-                    "godot.annotations"
-                );
-
-                module.line('import * as Godot from "godot";');
-                module.line('import * as GodotJsb from "godot-jsb";');
+            const runtime_gen = new FileWriter(dir_path, this._types);
+            const module = new ModuleWriter(
+                runtime_gen,
+                "godot.annotations"
+            );
 
-                for (const [name, descriptor] of Object.entries(annotation_types)) {
-                    module.line(`type ${names.get_class(name)} = `)
-                    const type_descriptor = new TypeDescriptorWriter(module, true);
-                    type_descriptor.serialize_type_descriptor(descriptor.proxy());
-                    type_descriptor.finish();
-                }
+            module.line('import * as Godot from "godot";');
+            module.line('import * as GodotJsb from "godot-jsb";');
 
-                module.finish();
-                runtime_gen.finish();
-            } finally {
-                file.close();
+            for (const [name, descriptor] of Object.entries(annotation_types)) {
+                module.line(`type ${names.get_class(name)} = `)
+                const type_descriptor = new TypeDescriptorWriter(module, true);
+                type_descriptor.serialize_type_descriptor(descriptor.proxy());
+                type_descriptor.finish();
             }
+
+            module.finish();
+            runtime_gen.finish();
+            this._manifest.write(dir_path, runtime_gen.content);
         })
 
         tasks.add_task("Cleanup", () => {
             this._splitter?.close();
             this.cleanup();
+            this._manifest.save();
         });
 
         return tasks.submit();
@@ -3371,6 +3580,11 @@ export class TSDCodeGen {
             for (let operator_info of cls.operators) {
                 class_cg.operator_(operator_info);
             }
+            for (let operator_info of cls.operators) {
+                if (operator_info.left_type == cls.type && kIntoOperators.has(operator_info.name)) {
+                    class_cg.operator_into_(operator_info);
+                }
+            }
         }
         if (cls.properties) {
             for (let property_info of cls.properties) {
@@ -3485,12 +3699,14 @@ export class SceneTSDCodeGen {
     private _out_dir: string;
     private _scene_paths: string[];
     private _types: TypeDB;
+    private _manifest: CodegenManifest;
 
     constructor(out_dir: string, scene_paths: string[]) {
         this._out_dir = out_dir;
         this._scene_paths = scene_paths;
 
-        this._types = new TypeDB();
+        this._types = TypeDB.get_shared();
+        this._manifest = CodegenManifest.get(out_dir);
     }
 
     private make_scene_path(scene_path: string, include_filename = true) {
@@ -3523,6 +3739,7 @@ export class SceneTSDCodeGen {
         for (const scene_path of this._scene_paths) {
             tasks.add_task(`Generating scene node types: ${scene_path}`, () => this.emit_scene_node_types(scene_path));
         }
+        tasks.add_task("Manifest", () => this._manifest.save());
 
         return tasks.submit(false);
     }
@@ -3546,12 +3763,20 @@ export class SceneTSDCodeGen {
     private emit_scene_node_types(scene_path: string) {
         try {
             const helper = godot.GodotJSEditorHelper;
-            const children = (helper.get_scene_nodes(scene_path) as undefined | NodeTypeDescriptorPathMap)?.proxy();
+            const nodes = helper.get_scene_nodes(scene_path) as undefined | NodeTypeDescriptorPathMap;
+            const children = nodes?.proxy();
 
             if (typeof children !== "object") {
                 throw new Error(`root node children unavailable: ${scene_path}`);
             }
 
+            // the scene is saved without any change of the node types
+            const file_path = this.make_scene_path(scene_path);
+            const input = nodes!.hash().toString(16);
+            if (this._manifest.is_up_to_date(file_path, input)) {
+                return;
+            }
+
             const dir_path = this.make_scene_path(scene_path, false);
             const dir_error = godot.DirAccess.make_dir_recursive_absolute(dir_path);
 
@@ -3559,26 +3784,16 @@ export class SceneTSDCodeGen {
                 console.error(`failed to create directory (error: ${dir_error}): ${dir_path}`);
             }
 
-            const file_path = this.make_scene_path(scene_path);
-            const file = godot.FileAccess.open(file_path, godot.FileAccess.ModeFlags.WRITE);
-
-            if (!file) {
-                throw new Error(`failed to open file for writing: ${dir_path}`);
-            }
-
-            try {
-                const file_writer = new FileWriter(file_path, this._types, file);
-                const module = new ModuleWriter(file_writer, "godot");
-                const scene_nodes_interface = new InterfaceWriter(module, "SceneNodes");
-                const scene_property = scene_nodes_interface.property_(scene_path.replace(/^res:\/\//, ""));
-                this.emit_children_node_types(scene_property, children);
-                scene_property.finish();
-                scene_nodes_interface.finish();
-                module.finish();
-                file_writer.finish();
-            } finally {
-                file.close();
-            }
+            const file_writer = new FileWriter(file_path, this._types);
+            const module = new ModuleWriter(file_writer, "godot");
+            const scene_nodes_interface = new InterfaceWriter(module, "SceneNodes");
+            const scene_property = scene_nodes_interface.property_(scene_path.replace(/^res:\/\//, ""));
+            this.emit_children_node_types(scene_property, children);
+            scene_property.finish();
+            scene_nodes_interface.finish();
+            module.finish();
+            file_writer.finish();
+            this._manifest.write(file_path, file_writer.content, input);
         } catch (error) {
             console.error(`failed to generate scene node types: ${scene_path}`);
             throw error;
@@ -3590,12 +3805,14 @@ export class ResourceTSDCodeGen {
     private _out_dir: string;
     private _resource_paths: string[];
     private _types: TypeDB;
+    private _manifest: CodegenManifest;
 
     constructor(out_dir: string, resource_paths: string[]) {
         this._out_dir = out_dir;
         this._resource_paths = resource_paths;
 
-        this._types = new TypeDB();
+        this._types = TypeDB.get_shared();
+        this._manifest = CodegenManifest.get(out_dir);
     }
 
     private make_resource_path(resource_path: string, include_filename = true) {
@@ -3622,6 +3839,7 @@ export class ResourceTSDCodeGen {
         for (const resource_path of this._resource_paths) {
             tasks.add_task(`Generating resource type: ${resource_path}`, () => this.emit_resource_type(resource_path));
         }
+        tasks.add_task("Manifest", () => this._manifest.save());
 
         return tasks.submit(false);
     }
@@ -3629,12 +3847,19 @@ export class ResourceTSDCodeGen {
     private emit_resource_type(resource_path: string) {
         try {
             const helper = godot.GodotJSEditorHelper;
-            const descriptor = (helper.get_resource_type_descriptor(resource_path) as undefined | TypeDescriptor)?.proxy();
+            const type_descriptor_data = helper.get_resource_type_descriptor(resource_path) as undefined | TypeDescriptor;
+            const descriptor = type_descriptor_data?.proxy();
 
             if (typeof descriptor !== "object") {
                 throw new Error(`resource type unavailable: ${resource_path}`);
             }
 
+            const file_path = this.make_resource_path(resource_path);
+            const input = type_descriptor_data!.hash().toString(16);
+            if (this._manifest.is_up_to_date(file_path, input)) {
+                return;
+            }
+
             const dir_path = this.make_resource_path(resource_path, false);
             const dir_error = godot.DirAccess.make_dir_recursive_absolute(dir_path);
 
@@ -3642,28 +3867,18 @@ export class ResourceTSDCodeGen {
                 console.error(`failed to create directory (error: ${dir_error}): ${dir_path}`);
             }
 
-            const file_path = this.make_resource_path(resource_path);
-            const file = godot.FileAccess.open(file_path, godot.FileAccess.ModeFlags.WRITE);
-
-            if (!file) {
-                throw new Error(`failed to open file for writing: ${dir_path}`);
-            }
-
-            try {
-                const file_writer = new FileWriter(file_path, this._types, file);
-                const module = new ModuleWriter(file_writer, "godot");
-                const resource_types_interface = new InterfaceWriter(module, "ResourceTypes");
-                const resource_property = resource_types_interface.property_(resource_path);
-                const type_descriptor = new TypeDescriptorWriter(resource_property, true);
-                type_descriptor.serialize_type_descriptor(descriptor);
-                type_descriptor.finish();
-                resource_property.finish();
-                resource_types_interface.finish();
-                module.finish();
-                file_writer.finish();
-            } finally {
-                file.close();
-            }
+            const file_writer = new FileWriter(file_path, this._types);
+            const module = new ModuleWriter(file_writer, "godot");
+            const resource_types_interface = new InterfaceWriter(module, "ResourceTypes");
+            const resource_property = resource_types_interface.property_(resource_path);
+            const type_descriptor = new TypeDescriptorWriter(resource_property, true);
+            type_descriptor.serialize_type_descriptor(descriptor);
+            type_descriptor.finish();
+            resource_property.finish();
+            resource_types_interface.finish();
+            module.finish();
+            file_writer.finish();
+            this._manifest.write(file_path, file_writer.content, input);
         } catch (error) {
             console.error(`failed to generate resource type: ${resource_path}`);
             throw error;
@@ -1,31 +1,78 @@
 // entry point (editor only)
 import { OS, PackedStringArray } from "godot";
 
+// the maximum number of candidates listed (the candidate list is small, and it keeps the latency bounded on huge objects)
+const kMaxCandidates = 64;
+
+// only a chain of identifiers is completed (`a.b.c` or `a.b.`), anything else (calls, indexing, operators) is ignored
+const kMemberChain = /^[A-Za-z_$][\w$]*(\.[A-Za-z_$][\w$]*)*\.?$|^$/;
+
+// the member names of prototypes (the class bindings of native and script classes are not changed after creation)
+const prototype_keys = new WeakMap<object, string[]>();
+
+function get_own_keys(target: object): string[] {
+    return Object.getOwnPropertyNames(target).filter(key => key != "constructor" && !key.startsWith("__"));
+}
+
+function get_prototype_keys(prototype: object): string[] {
+    let keys = prototype_keys.get(prototype);
+    if (!keys) {
+        keys = get_own_keys(prototype);
+        prototype_keys.set(prototype, keys);
+    }
+    return keys;
+}
+
+// read a data property without invoking any getter, undefined if it's an accessor or not found
+function read_data_property(target: any, key: string): any {
+    for (let object = target; object !== null && object !== undefined; object = Object.getPrototypeOf(object)) {
+        const descriptor = Object.getOwnPropertyDescriptor(object, key);
+        if (descriptor) {
+            return "value" in descriptor ? descriptor.value : undefined;
+        }
+    }
+    return undefined;
+}
+
+/**
+ * list the completions of a member chain from the values already evaluated (without evaluating the input),
+ * the intermediate members are only resolved through data properties, so that no getter and no function is called.
+ */
 export function auto_complete(pattern: string): PackedStringArray {
     let results = new PackedStringArray();
-    if (typeof pattern !== "string") {
+    if (typeof pattern !== "string" || !kMemberChain.test(pattern)) {
         return results;
     }
-    
-    let scope: any = null;
-    let head = '';
-    let index = pattern.lastIndexOf('.');
-    let left = '';
+
+    const index = pattern.lastIndexOf('.');
+    const left = pattern.substring(0, index + 1);
+    const prefix = pattern.substring(index + 1);
+    let scope: any = globalThis;
     if (index >= 0) {
-        left = pattern.substring(0, index + 1);
-        try {
-            scope = eval(pattern.substring(0, index));
-        } catch (e) {
-            return results;
+        for (const name of pattern.substring(0, index).split('.')) {
+            scope = read_data_property(scope, name);
+            if (scope === null || scope === undefined) {
+                return results;
+            }
         }
-        pattern = pattern.substring(index + 1);
-    } else {
-        scope = globalThis;
+    }
+    if (typeof scope !== "object" && typeof scope !== "function") {
+        scope = Object(scope);
     }
 
-    for (let k in scope) {
-        if (k.indexOf(pattern) == 0) {
-            results.append(head + left + k);
+    let num = 0;
+    const visited = new Set<string>();
+    for (let object = scope; object !== null && object !== Object.prototype && object !== Function.prototype; object = Object.getPrototypeOf(object)) {
+        // the own keys of instances are not cached, the list of an object with many members (e.g. a huge scene node) is still bounded by kMaxCandidates
+        const keys = object === scope ? get_own_keys(object) : get_prototype_keys(object);
+        for (const key of keys) {
+            if (key.startsWith(prefix) && !visited.has(key)) {
+                visited.add(key);
+                results.append(left + key);
+                if (++num == kMaxCandidates) {
+                    return results;
+                }
+            }
         }
     }
     return results;
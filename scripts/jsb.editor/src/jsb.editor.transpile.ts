@@ -0,0 +1,241 @@
+// transpile-only compilation of changed typescript sources in the editor (no type checking)
+import type * as Godot from "godot";
+
+const godot: typeof Godot = require("godot.lib.api");
+
+const kProjectConfig = "res://tsconfig.json";
+
+interface TranspileContext {
+    ts: any;
+    options: any;
+    config_modified_time: number;
+}
+
+let context: TranspileContext | undefined;
+
+// the typescript compiler is loaded from the project (node_modules) only once, the compiler options are read again if tsconfig.json changed
+function get_context(): TranspileContext | undefined {
+    const config_modified_time = godot.FileAccess.get_modified_time(kProjectConfig);
+    if (context && context.config_modified_time == config_modified_time) {
+        return context;
+    }
+
+    let ts: any = context?.ts;
+    if (!ts) {
+        try {
+            ts = require("typescript");
+        } catch (e) {
+            console.error("failed to load typescript from node_modules, please run 'npm i' at first.", e);
+            return undefined;
+        }
+    }
+
+    const parsed = ts.parseConfigFileTextToJson(kProjectConfig, godot.FileAccess.get_file_as_string(kProjectConfig));
+    if (parsed.error) {
+        console.error("failed to parse tsconfig.json:", ts.flattenDiagnosticMessageText(parsed.error.messageText, "\n"));
+        return undefined;
+    }
+    const converted = ts.convertCompilerOptionsFromJson(parsed.config?.compilerOptions ?? {}, "./");
+    const options = converted.options;
+
+    // only the emitted javascript (and source map) is needed for reloading
+    options.noEmit = false;
+    options.declaration = false;
+    options.declarationMap = false;
+    options.incremental = undefined;
+    options.tsBuildInfoFile = undefined;
+    context = { ts, options, config_modified_time };
+    return context;
+}
+
+function relative_path(from_dir: string, to: string): string {
+    const from_parts = from_dir.replace("res://", "").split("/").filter(part => part.length != 0);
+    const to_parts = to.replace("res://", "").split("/").filter(part => part.length != 0);
+    let common = 0;
+    while (common < from_parts.length && common < to_parts.length - 1 && from_parts[common] == to_parts[common]) {
+        ++common;
+    }
+    return "../".repeat(from_parts.length - common) + to_parts.slice(common).join("/");
+}
+
+function write_file(path: string, content: string): boolean {
+    const dir = path.substring(0, path.lastIndexOf("/"));
+    if (!godot.DirAccess.dir_exists_absolute(dir)) {
+        godot.DirAccess.make_dir_recursive_absolute(dir);
+    }
+    const file = godot.FileAccess.open(path, godot.FileAccess.ModeFlags.WRITE);
+    if (!file) {
+        console.error(`failed to open file for writing: ${path}`);
+        return false;
+    }
+    file.store_string(content);
+    file.close();
+    return true;
+}
+
+/**
+ * the static metadata of the script class declared in a module (`export default class`),
+ * written next to the output javascript as `<output>.meta.json` so that the class info is readable without evaluating the decorators.
+ * only the names are collected for members, the details (types, hints) are still resolved by the decorators at runtime.
+ */
+export interface ScriptClassManifest {
+    class_name: string;
+    base_type: string;
+    tool: boolean;
+    abstract: boolean;
+    icon?: string;
+    exports: string[];
+    signals: string[];
+    onready: string[];
+    rpc: string[];
+}
+
+// the last identifier of a decorator expression: `@tool()`, `@bind.tool()`, `@Tool` => "tool"
+function get_decorator_name(ts: any, decorator: any): [string, any[]] {
+    let expression = decorator.expression;
+    let args: any[] = [];
+    if (ts.isCallExpression(expression)) {
+        args = expression.arguments;
+        expression = expression.expression;
+    }
+    if (ts.isPropertyAccessExpression(expression)) {
+        expression = expression.name;
+    }
+    return [ts.isIdentifier(expression) ? (expression.text as string).toLowerCase() : "", args];
+}
+
+function get_decorators(ts: any, node: any): any[] {
+    return (typeof ts.getDecorators === "function" ? ts.getDecorators(node) : node.decorators) ?? [];
+}
+
+/**
+ * collect the manifest of the default exported class in a source file (undefined if not found).
+ * it can also be used in a custom transformer of the tsc pipeline.
+ */
+export function collect_class_manifest(ts: any, source_file: any): ScriptClassManifest | undefined {
+    for (const statement of source_file.statements) {
+        if (!ts.isClassDeclaration(statement) || !statement.name) {
+            continue;
+        }
+        const modifiers: any[] = (typeof ts.getModifiers === "function" ? ts.getModifiers(statement) : statement.modifiers) ?? [];
+        const has_modifier = (kind: any) => modifiers.some(modifier => modifier.kind == kind);
+        if (!has_modifier(ts.SyntaxKind.ExportKeyword) || !has_modifier(ts.SyntaxKind.DefaultKeyword)) {
+            continue;
+        }
+        const heritage = (statement.heritageClauses ?? []).find((clause: any) => clause.token == ts.SyntaxKind.ExtendsKeyword);
+        if (!heritage || heritage.types.length == 0) {
+            continue;
+        }
+
+        let base_expression = heritage.types[0].expression;
+        while (ts.isPropertyAccessExpression(base_expression)) {
+            base_expression = base_expression.name;
+        }
+        const manifest: ScriptClassManifest = {
+            class_name: statement.name.text,
+            base_type: ts.isIdentifier(base_expression) ? base_expression.text : "",
+            tool: false,
+            abstract: has_modifier(ts.SyntaxKind.AbstractKeyword),
+            exports: [],
+            signals: [],
+            onready: [],
+            rpc: [],
+        };
+        for (const decorator of get_decorators(ts, statement)) {
+            const [name, args] = get_decorator_name(ts, decorator);
+            if (name == "tool") {
+                manifest.tool = true;
+            } else if (name == "icon" && args.length != 0 && ts.isStringLiteralLike(args[0])) {
+                manifest.icon = args[0].text;
+            }
+        }
+        for (const member of statement.members) {
+            if (!member.name || !(ts.isIdentifier(member.name) || ts.isStringLiteral(member.name))) {
+                continue;
+            }
+            const member_name: string = member.name.text;
+            for (const decorator of get_decorators(ts, member)) {
+                const [name] = get_decorator_name(ts, decorator);
+                if (name == "signal" || name == "exportsignal") {
+                    manifest.signals.push(member_name);
+                } else if (name.startsWith("export")) {
+                    manifest.exports.push(member_name);
+                } else if (name == "onready") {
+                    manifest.onready.push(member_name);
+                } else if (name == "rpc") {
+                    manifest.rpc.push(member_name);
+                }
+            }
+        }
+        return manifest;
+    }
+    return undefined;
+}
+
+/**
+ * transpile the typescript sources to the given output paths (javascript with source map)
+ * @param files pairs of [source path, output path]
+ * @returns the number of transpiled files
+ */
+export function transpile_files(files: [string, string][]): number {
+    const ctx = get_context();
+    if (!ctx) {
+        return 0;
+    }
+
+    const ts = ctx.ts;
+    let num = 0;
+    for (const [source_path, output_path] of files) {
+        const source = godot.FileAccess.get_file_as_string(source_path);
+        if (source.length == 0 && !godot.FileAccess.file_exists(source_path)) {
+            continue;
+        }
+
+        const output_dir = output_path.substring(0, output_path.lastIndexOf("/"));
+        let manifest: ScriptClassManifest | undefined;
+        const output = ts.transpileModule(source, {
+            compilerOptions: ctx.options,
+            fileName: source_path.replace("res://", ""),
+            reportDiagnostics: true,
+            transformers: {
+                // collect the manifest from the original AST (before the decorators are lowered)
+                before: [() => (source_file: any) => {
+                    manifest = collect_class_manifest(ts, source_file);
+                    return source_file;
+                }],
+            },
+        });
+        if (output.diagnostics && output.diagnostics.length != 0) {
+            for (const diagnostic of output.diagnostics) {
+                console.error(`${source_path}: ${ts.flattenDiagnosticMessageText(diagnostic.messageText, "\n")}`);
+            }
+            continue;
+        }
+
+        let js = output.outputText as string;
+        if (output.sourceMapText) {
+            // the sources are located relative to the output file (the same as tsc does with the project config)
+            const map = JSON.parse(output.sourceMapText);
+            const map_name = output_path.substring(output_path.lastIndexOf("/") + 1) + ".map";
+            map.file = output_path.substring(output_path.lastIndexOf("/") + 1);
+            map.sourceRoot = "";
+            map.sources = [relative_path(output_dir, source_path)];
+            js = js.replace(/\/\/# sourceMappingURL=.*$/m, `//# sourceMappingURL=${map_name}`);
+            if (!write_file(output_path + ".map", JSON.stringify(map))) {
+                continue;
+            }
+        }
+        if (write_file(output_path, js)) {
+            ++num;
+        }
+
+        // written after the output, the manifest is outdated if it's older than the source
+        const manifest_path = output_path + ".meta.json";
+        if (manifest) {
+            write_file(manifest_path, JSON.stringify(manifest));
+        } else if (godot.FileAccess.file_exists(manifest_path)) {
+            godot.DirAccess.remove_absolute(manifest_path);
+        }
+    }
+    return num;
+}
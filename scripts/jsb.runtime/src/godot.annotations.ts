@@ -267,7 +267,7 @@ export const ExportObject = export_object;
  * [low level export]
  * @deprecated Use createClassBinder() instead.
  * */
-export function export_(type: Godot.Variant.Type, details?: { class_?: ClassSpecifier, hint?: Godot.PropertyHint, hint_string?: string, usage?: Godot.PropertyUsageFlags }) {
+export function export_(type: Godot.Variant.Type, details?: { class_?: ClassSpecifier, hint?: Godot.PropertyHint, hint_string?: string, usage?: Godot.PropertyUsageFlags, default?: unknown }) {
     return function(
       target: any,
       name: string
@@ -284,6 +284,8 @@ export function export_(type: Godot.Variant.Type, details?: { class_?: ClassSpec
             hint: PropertyHint.PROPERTY_HINT_NONE,
             hint_string: "",
             usage: PropertyUsageFlags.PROPERTY_USAGE_DEFAULT,
+            // the same as the initializer, the class default object is not constructed if all properties have it
+            default: details?.default,
         } satisfies GodotJsb.ScriptPropertyInfo;
 
         if (typeof details === "object") {
@@ -475,6 +477,33 @@ export function tool() {
 /** @deprecated Use createClassBinder() instead. */
 export const Tool = tool;
 
+/**
+ * Dispatch `_process` of all instances of the decorated class at once per frame.
+ * If the class provides `static _process_batch(instances, delta)`, it's called instead of `_process` of each instance.
+ * NOTE: `_process` must still be defined to let Godot enable processing for the node.
+ * @deprecated Use createClassBinder() instead.
+ */
+export function batched() {
+    return function (target: any, name: undefined) {
+        legacy_decorators_check(name);
+
+        jsb.internal.add_script_batched(target);
+    };
+}
+
+/**
+ * Cache the values of all exported properties of the decorated class on the engine side.
+ * The engine (inspector, serialization) reads the cached values without calling into JS until any script runs again.
+ * @deprecated Use createClassBinder() instead.
+ */
+export function cached_exports() {
+    return function (target: any, name: undefined) {
+        legacy_decorators_check(name);
+
+        jsb.internal.add_script_cached_exports(target);
+    };
+}
+
 /** @deprecated Use createClassBinder() instead. */
 export function icon(path: string) {
     return function (target: any, name: undefined) {
@@ -692,6 +721,8 @@ export function createClassBinder(): ClassBinder {
             hint: PropertyHint.PROPERTY_HINT_NONE,
             hint_string: "",
             usage: PropertyUsageFlags.PROPERTY_USAGE_DEFAULT,
+            // the same as the initializer, the class default object is not constructed if all properties have it
+            default: options?.default,
         } satisfies GodotJsb.ScriptPropertyInfo;
 
         if (typeof options === "object") {
@@ -794,6 +825,16 @@ export function createClassBinder(): ClassBinder {
                 jsb.internal.add_script_tool(target);
             };
         },
+        batched() {
+            return function(target: GObjectConstructor, _context: ClassDecoratorContext) {
+                jsb.internal.add_script_batched(target);
+            };
+        },
+        cached_exports() {
+            return function(target: GObjectConstructor, _context: ClassDecoratorContext) {
+                jsb.internal.add_script_cached_exports(target);
+            };
+        },
         icon(path: string) {
             return function (target: GObjectConstructor, _context: ClassDecoratorContext) {
                 jsb.internal.add_script_icon(target, path);
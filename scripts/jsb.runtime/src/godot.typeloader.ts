@@ -67,10 +67,17 @@ export function on_type_loaded(type_name: string | string[], callback: TypeLoade
     }
 }
 
-// callback on a godot type loaded by jsb_godot_module_loader
+// cache a loaded value as an own data property of the `godot` exports object
+function _define_loaded(receiver: any, prop_name: string, value: any) {
+    Object.defineProperty(receiver, prop_name, { value: value, writable: true, enumerable: true, configurable: true });
+}
+
+// the exports of `godot` module (loaded by jsb_godot_module_loader).
+// it's a plain object with the proxy as its prototype, each loaded type is defined as an own data property of it,
+// so only the first access of a name goes through the proxy traps, the later ones are ordinary (inline cached) property loads.
 exports._mod_proxy_ = function (builtin_symbols: { [key in string]?: symbol }, type_loader_func: (type_name: string) => any): any {
-    return new Proxy(type_db, {
-        set: function (target, prop_name, value) {
+    const proxy = new Proxy(type_db, {
+        set: function (target, prop_name, value, receiver) {
             if (typeof prop_name !== 'string') {
                 throw new Error(`only string key is allowed`);
             }
@@ -78,9 +85,12 @@ exports._mod_proxy_ = function (builtin_symbols: { [key in string]?: symbol }, t
                 console.warn('overwriting existing value', prop_name);
             }
             target[prop_name] = value;
+            if (receiver !== proxy) {
+                _define_loaded(receiver, prop_name, value);
+            }
             return true;
         },
-        get: function (target: any , prop_name) {
+        get: function (target: any, prop_name, receiver) {
             let o = target[prop_name];
             if (typeof o === 'undefined' && typeof prop_name === 'string') {
                 o = target[prop_name] =
@@ -88,9 +98,14 @@ exports._mod_proxy_ = function (builtin_symbols: { [key in string]?: symbol }, t
                         ? builtin_symbols[prop_name]
                         : type_loader_func(prop_name);
             }
+            // inherited values (e.g. `hasOwnProperty` of Object.prototype) are not cached
+            if (receiver !== proxy && typeof prop_name === 'string' && Object.prototype.hasOwnProperty.call(target, prop_name)) {
+                _define_loaded(receiver, prop_name, o);
+            }
             return o;
         }
     });
+    return Object.create(proxy);
 }
 
 exports._post_bind_ = function (type_name: string, type: any): void {
@@ -0,0 +1,148 @@
+import type * as GodotJsb from "godot-jsb";
+
+// An async module loader for the web platform, it fetches the sources of `jsb.$import` over HTTP on demand
+// (instead of packing them into the PCK which must be downloaded completely before anything runs).
+// The fetched sources are kept in Cache Storage keyed by the content hash from the manifest, so that they're downloaded again only if changed.
+
+// the DOM lib is not included in the runtime typings
+declare const fetch: any;
+declare const caches: any;
+declare const Response: any;
+declare const URL: any;
+declare const location: any;
+
+export interface WebModuleLoaderOptions {
+    /**
+     * The URL prefix of the modules (default "./"), `jsb.$import("chunks/level2")` fetches `${base_url}chunks/level2.js`.
+     * Absolute URLs passed to `jsb.$import` are fetched as they are.
+     */
+    base_url?: string;
+
+    /**
+     * The URL of a JSON manifest mapping module ids to the hashes of their contents: `{ "chunks/level2": "3f2a9c" }`.
+     * Only the modules listed in the manifest are persistently cached, others are left to the HTTP cache of the browser.
+     */
+    manifest?: string;
+
+    /**
+     * The name of the Cache Storage (default "godotjs-modules"), an empty string disables the persistent cache.
+     */
+    cache_name?: string;
+}
+
+let options_: Required<WebModuleLoaderOptions> | undefined;
+let manifest_: Promise<Record<string, string>> | undefined;
+const fetching_ = new Map<string, Promise<string>>();
+
+function get_url(module_id: string) {
+    if (/^[a-z]+:\/\//i.test(module_id)) {
+        return module_id;
+    }
+    return options_!.base_url + (module_id.endsWith(".js") ? module_id : module_id + ".js");
+}
+
+function get_manifest(): Promise<Record<string, string>> {
+    if (!manifest_) {
+        manifest_ = options_!.manifest.length === 0
+            ? Promise.resolve({})
+            : fetch(options_!.manifest, { cache: "no-cache" })
+                .then((response: any) => response.ok ? response.json() : {})
+                .catch((error: any) => {
+                    console.warn("failed to fetch the module manifest", options_!.manifest, error);
+                    return {};
+                });
+    }
+    return manifest_;
+}
+
+async function fetch_text(url: string): Promise<string> {
+    const response = await fetch(url);
+    if (!response.ok) {
+        throw new Error(`${url}: ${response.status} ${response.statusText}`);
+    }
+    return response.text();
+}
+
+async function open_cache(): Promise<any> {
+    // Cache Storage is only available in secure contexts
+    if (options_!.cache_name.length === 0 || typeof caches === "undefined") {
+        return undefined;
+    }
+    try {
+        return await caches.open(options_!.cache_name);
+    } catch (error) {
+        return undefined;
+    }
+}
+
+// drop the entries of older versions of the module
+async function evict_stale(cache: any, url: string, key: string) {
+    for (const request of await cache.keys()) {
+        const cached: string = request.url;
+        if (cached !== key && cached.startsWith(url + "?h=")) {
+            await cache.delete(request);
+        }
+    }
+}
+
+async function load_source(module_id: string): Promise<string> {
+    const url = get_url(module_id);
+    const hash = (await get_manifest())[module_id];
+    const cache = typeof hash === "string" ? await open_cache() : undefined;
+    if (!cache) {
+        return fetch_text(url);
+    }
+
+    // resolved against the page, so that it's comparable with `request.url` in evict_stale
+    const absolute_url = new URL(url, location.href).href;
+    const key = `${absolute_url}?h=${hash}`;
+    const cached = await cache.match(key);
+    if (cached) {
+        return cached.text();
+    }
+
+    const source = await fetch_text(url);
+    cache.put(key, new Response(source, { headers: { "Content-Type": "text/javascript" } }))
+        .then(() => evict_stale(cache, absolute_url, key))
+        .catch((error: any) => console.warn("failed to cache module", module_id, error));
+    return source;
+}
+
+function get_source(module_id: string): Promise<string> {
+    let pending = fetching_.get(module_id);
+    if (!pending) {
+        pending = load_source(module_id);
+        fetching_.set(module_id, pending);
+        pending.then(() => fetching_.delete(module_id), () => fetching_.delete(module_id));
+    }
+    return pending;
+}
+
+/**
+ * Install the loader as the async module loader (see `jsb.set_async_module_loader`) of the current environment.
+ * A module loaded by `jsb.$import` can only `require` modules which are already loaded (or available in the PCK),
+ * so it's recommended to split the scripts into self-contained bundle chunks.
+ */
+export function install(options?: WebModuleLoaderOptions) {
+    options_ = {
+        base_url: options?.base_url ?? "./",
+        manifest: options?.manifest ?? "",
+        cache_name: options?.cache_name ?? "godotjs-modules",
+    };
+    manifest_ = undefined;
+
+    const jsb: typeof GodotJsb = require("godot-jsb");
+    jsb.set_async_module_loader((module_id, resolve, reject) => {
+        get_source(module_id).then(resolve, (error: any) => reject(error instanceof Error ? error.message : String(error)));
+    });
+}
+
+/**
+ * Download the modules into the cache ahead of time (e.g. while the current scene is running), without evaluating them.
+ */
+export function prefetch(module_ids: ReadonlyArray<string>): Promise<void> {
+    if (!options_) {
+        return Promise.reject(new Error("the web module loader is not installed"));
+    }
+    return Promise.all(module_ids.map(get_source)).then(() => undefined);
+}
@@ -0,0 +1,40 @@
+import type * as GodotWorker from "godot.worker";
+
+// The entry module of the workers spawned by `JSWorkerPool`, it's not supposed to be loaded directly.
+
+const { JSWorkerParent } = require("godot.worker") as typeof GodotWorker;
+
+if (JSWorkerParent) {
+    const parent = JSWorkerParent;
+    let tasks: Record<string, unknown> | undefined;
+
+    function reply_error(id: number, error: unknown) {
+        parent.postMessage({ type: "error", id, error: error instanceof Error ? `${error.message}\n${error.stack ?? ""}` : String(error) });
+    }
+
+    parent.onmessage = function (message: any) {
+        switch (message.type) {
+            case "init":
+                tasks = require(message.module);
+                break;
+            case "run": {
+                const task = tasks?.[message.name];
+                if (typeof task !== "function") {
+                    reply_error(message.id, `no such task '${message.name}'`);
+                    break;
+                }
+                try {
+                    Promise.resolve(task(...message.args)).then(
+                        result => parent.postMessage({ type: "result", id: message.id, result }),
+                        error => reply_error(message.id, error));
+                } catch (error) {
+                    reply_error(message.id, error);
+                }
+                break;
+            }
+            default:
+                console.error("JSWorkerPool: unknown message type", message.type);
+                break;
+        }
+    };
+}
@@ -0,0 +1,147 @@
+import type * as GodotWorker from "godot.worker";
+
+import lib_api = require("godot.lib.api");
+
+// the module loaded by each worker of the pool, see `godot.worker.pool.host`
+const kHostModule = "godot.worker.pool.host";
+
+export interface JSWorkerPoolOptions {
+    /**
+     * Number of workers, defaults to `OS.get_processor_count() - 1` (at least 1).
+     */
+    size?: number;
+
+    /**
+     * Max number of tasks dispatched to a single worker at once (default 2).
+     * Pending tasks are kept by the pool and handed to whichever worker becomes available first.
+     */
+    max_in_flight?: number;
+}
+
+interface PendingTask {
+    id: number;
+    name: string;
+    args: any[];
+    transfer?: ReadonlyArray<any>;
+    resolve: (value: any) => void;
+    reject: (reason: any) => void;
+}
+
+interface PoolWorker {
+    worker: GodotWorker.JSWorker;
+    in_flight: Map<number, PendingTask>;
+}
+
+/**
+ * A fixed set of pre-spawned `JSWorker`s running the same task module.
+ * Tasks are the functions exported by the module, and their results (or returned promises) are resolved on the master side.
+ * @example
+ * ```ts
+ * const pool = new JSWorkerPool("tasks/terrain");
+ * const chunk = await pool.run("generate_chunk", x, y);
+ * ```
+ */
+export class JSWorkerPool {
+    private _workers: PoolWorker[] = [];
+    private _pending: PendingTask[] = [];
+    private _max_in_flight: number;
+    private _next_id = 1;
+    private _terminated = false;
+
+    constructor(module_id: string, options?: JSWorkerPoolOptions) {
+        const { JSWorker } = require("godot.worker") as typeof GodotWorker;
+        const size = options?.size ?? Math.max(1, lib_api.OS.get_processor_count() - 1);
+
+        this._max_in_flight = Math.max(1, options?.max_in_flight ?? 2);
+        for (let i = 0; i < size; ++i) {
+            const entry: PoolWorker = { worker: new JSWorker(kHostModule), in_flight: new Map() };
+            entry.worker.onmessage = (message: any) => this._on_message(entry, message);
+            // messages are queued until the worker is ready
+            entry.worker.postMessage({ type: "init", module: module_id });
+            this._workers.push(entry);
+        }
+    }
+
+    get size() { return this._workers.length; }
+
+    /**
+     * Number of tasks not dispatched to any worker yet.
+     */
+    get pending() { return this._pending.length; }
+
+    /**
+     * Run an exported function of the task module in any available worker.
+     */
+    run<R = any>(name: string, ...args: any[]): Promise<R> {
+        return this.run_with_transfer<R>(name, args);
+    }
+
+    /**
+     * Same as `run`, with a transfer list which is passed to `postMessage` as is.
+     */
+    run_with_transfer<R = any>(name: string, args: any[], transfer?: ReadonlyArray<any>): Promise<R> {
+        if (this._terminated) {
+            return Promise.reject(new Error("JSWorkerPool is terminated"));
+        }
+        return new Promise<R>((resolve, reject) => {
+            this._pending.push({ id: this._next_id++, name, args, transfer, resolve, reject });
+            this._dispatch();
+        });
+    }
+
+    /**
+     * Terminate all workers, unfinished tasks are rejected.
+     */
+    terminate() {
+        if (this._terminated) {
+            return;
+        }
+        this._terminated = true;
+        const error = new Error("JSWorkerPool is terminated");
+        for (const entry of this._workers) {
+            entry.worker.terminate();
+            for (const task of entry.in_flight.values()) {
+                task.reject(error);
+            }
+            entry.in_flight.clear();
+        }
+        for (const task of this._pending) {
+            task.reject(error);
+        }
+        this._pending.length = 0;
+        this._workers.length = 0;
+    }
+
+    // hand pending tasks to the least loaded workers
+    private _dispatch() {
+        while (this._pending.length > 0) {
+            let target: PoolWorker | undefined;
+            for (const entry of this._workers) {
+                if (entry.in_flight.size < this._max_in_flight && (!target || entry.in_flight.size < target.in_flight.size)) {
+                    target = entry;
+                }
+            }
+            if (!target) {
+                break;
+            }
+            const task = this._pending.shift()!;
+            target.in_flight.set(task.id, task);
+            target.worker.postMessage({ type: "run", id: task.id, name: task.name, args: task.args }, task.transfer);
+        }
+    }
+
+    private _on_message(entry: PoolWorker, message: any) {
+        const task = entry.in_flight.get(message?.id);
+        if (!task) {
+            console.error("JSWorkerPool: unexpected message", message);
+            return;
+        }
+        entry.in_flight.delete(task.id);
+        if (message.type === "result") {
+            task.resolve(message.result);
+        } else {
+            task.reject(new Error(message.error));
+        }
+        this._dispatch();
+    }
+}
@@ -0,0 +1,147 @@
+import type * as GodotWorker from "godot.worker";
+
+import lib_api = require("godot.lib.api");
+
+export interface JSRoomHostOptions {
+    /**
+     * Indices of the logical processors the rooms are distributed over.
+     * Defaults to all processors except the first one (left to the main thread), or all of them if there is only one.
+     */
+    processors?: ReadonlyArray<number>;
+
+    /**
+     * Pin the thread of each room to its processor (default true), otherwise the processor is only used for load balancing.
+     * Thread affinity is not supported on macOS/iOS.
+     */
+    pin_threads?: boolean;
+
+    /**
+     * Max number of rooms opened at once (unlimited if 0, default 0).
+     */
+    max_rooms?: number;
+}
+
+/**
+ * An isolated game room, a `JSWorker` running the room module in its own environment and thread.
+ * The scripts of the nodes instantiated by the room module are bound to the room environment,
+ * and calls to them from the main thread (e.g. `_process` if they're added to the scene tree) are queued to the room thread.
+ */
+export class JSRoom {
+    onmessage?: (message: any) => void;
+
+    /** called once the room is closed (by `close` or `JSRoomHost.close_all`) */
+    onclose?: () => void;
+
+    private _closed = false;
+
+    constructor(private _host: JSRoomHost, readonly id: number, readonly processor: number, private _worker: GodotWorker.JSWorker) {
+        _worker.onmessage = (message: any) => this.onmessage?.(message);
+    }
+
+    get closed() { return this._closed; }
+
+    postMessage(message: any, transfer?: ReadonlyArray<any>) {
+        if (this._closed) {
+            throw new Error(`room ${this.id} is closed`);
+        }
+        this._worker.postMessage(message, transfer);
+    }
+
+    close() {
+        if (this._closed) {
+            return;
+        }
+        this._closed = true;
+        this._worker.terminate();
+        this._host["_on_closed"](this);
+        this.onclose?.();
+    }
+}
+
+/**
+ * Host many isolated rooms in one process (e.g. game rooms of a dedicated server), instead of a process per room.
+ * Each room gets its own environment and thread, and rooms are assigned to the least loaded processor when opened.
+ * @example
+ * ```ts
+ * const host = new JSRoomHost();
+ * const room = host.open("rooms/arena", { map: "desert" });
+ * room.onmessage = message => console.log(room.id, message);
+ * ```
+ */
+export class JSRoomHost {
+    private _processors: number[];
+    private _load: number[];
+    private _pin_threads: boolean;
+    private _max_rooms: number;
+    private _rooms = new Map<number, { room: JSRoom, slot: number }>();
+    private _next_id = 1;
+
+    constructor(options?: JSRoomHostOptions) {
+        const count = lib_api.OS.get_processor_count();
+        this._processors = options?.processors?.slice()
+            ?? (count > 1 ? Array.from({ length: count - 1 }, (_, i) => i + 1) : [0]);
+        if (this._processors.length === 0) {
+            throw new Error("no processor to host rooms");
+        }
+        this._load = this._processors.map(() => 0);
+        this._pin_threads = options?.pin_threads ?? true;
+        this._max_rooms = Math.max(0, options?.max_rooms ?? 0);
+    }
+
+    get size() { return this._rooms.size; }
+
+    get rooms(): JSRoom[] { return Array.from(this._rooms.values(), entry => entry.room); }
+
+    /**
+     * Open a room running `module_id` as a worker script.
+     * @param init posted as the first message of the room if provided
+     */
+    open(module_id: string, init?: any, transfer?: ReadonlyArray<any>): JSRoom {
+        if (this._max_rooms !== 0 && this._rooms.size >= this._max_rooms) {
+            throw new Error(`too many rooms (max_rooms: ${this._max_rooms})`);
+        }
+        const { JSWorker } = require("godot.worker") as typeof GodotWorker;
+
+        // the least loaded processor (the first one wins a tie)
+        let slot = 0;
+        for (let i = 1; i < this._load.length; ++i) {
+            if (this._load[i] < this._load[slot]) {
+                slot = i;
+            }
+        }
+        const id = this._next_id++;
+        const processor = this._processors[slot];
+        const worker = new JSWorker(module_id, {
+            priority: "normal",
+            affinity: this._pin_threads ? [processor] : undefined,
+            name: `JSRoom_${id}`,
+            defer_script_calls: true,
+        });
+        const room = new JSRoom(this, id, processor, worker);
+        this._load[slot]++;
+        this._rooms.set(id, { room, slot });
+        if (typeof init !== "undefined") {
+            // messages are queued until the worker is ready
+            worker.postMessage(init, transfer);
+        }
+        return room;
+    }
+
+    get(id: number): JSRoom | undefined {
+        return this._rooms.get(id)?.room;
+    }
+
+    close_all() {
+        for (const room of this.rooms) {
+            room.close();
+        }
+    }
+
+    private _on_closed(room: JSRoom) {
+        const entry = this._rooms.get(room.id);
+        if (entry) {
+            this._rooms.delete(room.id);
+            this._load[entry.slot]--;
+        }
+    }
+}
@@ -0,0 +1,231 @@
+import type * as GodotWorker from "godot.worker";
+
+// The implementation of `godot.worker` on the web platform (loaded by the native module loader of `godot.worker`), it's not supposed to be loaded directly.
+// A JSWorker runs in a browser Web Worker, the engine is not available in it, so only self-contained modules can be used as worker scripts
+// (`require` in the worker only resolves "godot.worker").
+
+// the DOM lib is not included in the runtime typings
+declare const Worker: any;
+declare const Blob: any;
+declare const URL: any;
+
+type SourceReader = (module_id: string) => { source: string, filename: string };
+
+const enum MessageType {
+    Ready = 0,
+    Message = 1,
+    Messages = 2,
+    Close = 3,
+    Error = 4,
+    Task = 5,
+    Result = 6,
+}
+
+// the entry of the worker scope, it's stringified into the blob of the worker script (must not reference anything outside)
+function worker_main(scope: any, filename: string, main: Function) {
+    const enum MessageType {
+        Ready = 0,
+        Message = 1,
+        Messages = 2,
+        Close = 3,
+        Error = 4,
+        Task = 5,
+        Result = 6,
+    }
+
+    function format_error(error: any) {
+        return error instanceof Error ? `${error.message}\n${error.stack ?? ""}` : String(error);
+    }
+
+    const parent = {
+        onmessage: <((message: any) => void) | undefined>undefined,
+        onmessages: <((messages: any[]) => void) | undefined>undefined,
+        close() { scope.postMessage({ type: MessageType.Close }); scope.close(); },
+        transfer(_obj: any) { throw new Error("godot objects can not be transferred to web workers"); },
+        postMessage(message: any, transfer?: ReadonlyArray<any>) { scope.postMessage({ type: MessageType.Message, data: message }, transfer ?? []); },
+        postMessages(messages: ReadonlyArray<any>, transfer?: ReadonlyArray<any>) { scope.postMessage({ type: MessageType.Messages, data: messages }, transfer ?? []); },
+    };
+    const worker_module = { JSWorkerParent: parent, JSWorker: undefined, runTask: undefined };
+    const module = { id: filename, filename, exports: <any>{} };
+    const dirname = filename.substring(0, filename.lastIndexOf("/"));
+    function require(id: string) {
+        if (id === "godot.worker") {
+            return worker_module;
+        }
+        throw new Error(`module '${id}' is not available in web workers`);
+    }
+
+    scope.onmessage = function (event: any) {
+        const message = event.data;
+        switch (message.type) {
+            case MessageType.Message:
+                parent.onmessage?.(message.data);
+                break;
+            case MessageType.Messages:
+                if (parent.onmessages) {
+                    parent.onmessages(message.data);
+                } else if (parent.onmessage) {
+                    for (const item of message.data) {
+                        parent.onmessage(item);
+                    }
+                }
+                break;
+            case MessageType.Task: {
+                const run = module.exports?.run;
+                if (typeof run !== "function") {
+                    scope.postMessage({ type: MessageType.Error, data: `${filename} does not export 'run'` });
+                    break;
+                }
+                Promise.resolve().then(() => run(message.data)).then(
+                    result => scope.postMessage({ type: MessageType.Result, data: result }),
+                    error => scope.postMessage({ type: MessageType.Error, data: format_error(error) }));
+                break;
+            }
+            default: break;
+        }
+    };
+
+    try {
+        main.call(module.exports, module.exports, require, module, filename, dirname);
+        scope.postMessage({ type: MessageType.Ready });
+    } catch (error) {
+        scope.postMessage({ type: MessageType.Error, data: format_error(error) });
+    }
+}
+
+// only ArrayBuffers can be transferred, SharedArrayBuffers are shared anyway (if crossOriginIsolated), godot objects are never accepted
+function to_transfer_list(transfer?: ReadonlyArray<any>): any[] {
+    if (!transfer) {
+        return [];
+    }
+    const list: any[] = [];
+    for (const item of transfer) {
+        if (item instanceof ArrayBuffer) {
+            list.push(item);
+        } else if (typeof SharedArrayBuffer === "undefined" || !(item instanceof SharedArrayBuffer)) {
+            throw new Error("only ArrayBuffers can be transferred to web workers");
+        }
+    }
+    return list;
+}
+
+function spawn(read_source: SourceReader, path: string) {
+    const { source, filename } = read_source(path);
+    // the source from read_source is already wrapped as `(function(exports, require, module, __filename, __dirname) { ... })`
+    const script = `(${worker_main.toString()})(self, ${JSON.stringify(filename)}, ${source});`;
+    const url = URL.createObjectURL(new Blob([script], { type: "text/javascript" }));
+    return { worker: new Worker(url, { name: filename }), url };
+}
+
+export function create(read_source: SourceReader) {
+    class JSWorker {
+        private _worker: any;
+        private _url: string | undefined;
+        private _terminated = false;
+
+        onready?: () => void;
+        onmessage?: (message: any) => void;
+        onmessages?: (messages: any[]) => void;
+        onerror?: (error: any) => void;
+        ontransfer?: (obj: any) => void;
+
+        constructor(path: string, options?: GodotWorker.JSWorkerOptions) {
+            // priority and affinity are not applicable to web workers
+            const { worker, url } = spawn(read_source, path);
+            this._worker = worker;
+            this._url = url;
+            worker.onmessage = (event: any) => this._on_message(event.data);
+            worker.onerror = (event: any) => {
+                this._revoke();
+                this.onerror?.(event.message ?? event);
+            };
+        }
+
+        postMessage(message: any, transfer?: ReadonlyArray<any>) {
+            if (this._terminated) return;
+            this._worker.postMessage({ type: MessageType.Message, data: message }, to_transfer_list(transfer));
+        }
+
+        postMessages(messages: ReadonlyArray<any>, transfer?: ReadonlyArray<any>) {
+            if (this._terminated) return;
+            this._worker.postMessage({ type: MessageType.Messages, data: messages }, to_transfer_list(transfer));
+        }
+
+        terminate() {
+            if (this._terminated) return;
+            this._terminated = true;
+            this._revoke();
+            this._worker.terminate();
+        }
+
+        private _revoke() {
+            if (this._url) {
+                URL.revokeObjectURL(this._url);
+                this._url = undefined;
+            }
+        }
+
+        private _on_message(message: any) {
+            switch (message.type) {
+                case MessageType.Ready:
+                    this._revoke();
+                    this.onready?.();
+                    break;
+                case MessageType.Message:
+                    this.onmessage?.(message.data);
+                    break;
+                case MessageType.Messages:
+                    if (this.onmessages) {
+                        this.onmessages(message.data);
+                    } else if (this.onmessage) {
+                        for (const item of message.data) {
+                            this.onmessage(item);
+                        }
+                    }
+                    break;
+                case MessageType.Close:
+                    this._terminated = true;
+                    break;
+                case MessageType.Error:
+                    this._revoke();
+                    if (this.onerror) {
+                        this.onerror(message.data);
+                    } else {
+                        console.error(message.data);
+                    }
+                    break;
+                default: break;
+            }
+        }
+    }
+
+    // a short-lived worker for each task (there is no shared thread pool in the browser)
+    function runTask<T = any>(path: string, input?: any, transfer?: ReadonlyArray<any>): Promise<T> {
+        return new Promise<T>((resolve, reject) => {
+            const { worker, url } = spawn(read_source, path);
+            const settle = (fn: () => void) => {
+                URL.revokeObjectURL(url);
+                worker.terminate();
+                fn();
+            };
+            worker.onmessage = (event: any) => {
+                const message = event.data;
+                switch (message.type) {
+                    case MessageType.Ready:
+                        worker.postMessage({ type: MessageType.Task, data: input }, to_transfer_list(transfer));
+                        break;
+                    case MessageType.Result:
+                        settle(() => resolve(message.data));
+                        break;
+                    case MessageType.Error:
+                        settle(() => reject(new Error(message.data)));
+                        break;
+                    default: break;
+                }
+            };
+            worker.onerror = (event: any) => settle(() => reject(new Error(event.message ?? String(event))));
+        });
+    }
+
+    return { JSWorker, runTask, JSWorkerParent: undefined };
+}
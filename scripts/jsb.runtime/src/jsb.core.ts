@@ -12,24 +12,7 @@ const { jsb } = require("godot.lib.api");
  * @deprecated [WARNING] This function is deprecated. Use `SignalN<..., R>.as_promise()` instead.
  */
 exports.$wait = function (signal: any) {
-    return new Promise(resolve => {
-        let fn: any = null;
-        fn = require("godot.lib.api").create(function () {
-            signal.disconnect(fn);
-            if (arguments.length == 0) {
-                resolve(undefined);
-                return;
-            }
-            if (arguments.length == 1) {
-                resolve(arguments[0]);
-                return;
-            }
-            // return as javascript array if more than one
-            resolve(Array.from(arguments));
-            jsb.internal.notify_microtasks_run();
-        });
-        signal.connect(fn, 0);
-    })
+    return jsb.await_signal(signal);
 }
 
 /**
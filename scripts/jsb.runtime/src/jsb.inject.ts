@@ -355,30 +355,13 @@ require("godot.typeloader").on_type_loaded("Callable", function (type: any) {
 });
 
 require("godot.typeloader").on_type_loaded("Signal", function (type: any) {
-    let { jsb, Callable, Object } = require("godot.lib.api");
+    let { jsb } = require("godot.lib.api");
     const get_member = jsb.internal.names.get_member;
-    const notify_microtasks_run = jsb.internal.notify_microtasks_run;
+    const await_signal = jsb.await_signal;
 
+    // resolved natively on emission (one-shot), no callable function is created per await
     type.prototype[get_member('as_promise')] = function () {
-        let self = this;
-        return new Promise(function (resolve, reject) {
-            let fn = Callable.create(function () {
-                //self.disconnect(fn);
-                if (arguments.length == 0) {
-                    resolve(undefined);
-                    return;
-                }
-                if (arguments.length == 1) {
-                    resolve(arguments[0]);
-                    return;
-                }
-                // return as javascript array if more than one
-                resolve(Array.from(arguments));
-                notify_microtasks_run();
-            });
-            self.connect(fn, Object.ConnectFlags.CONNECT_ONE_SHOT);
-            self = undefined;
-        });
+        return await_signal(this);
     }
 });
 
@@ -36,6 +36,7 @@ declare module "godot" {
         keys(): GArray<keyof T>
         erase(key: keyof T): boolean
         has(key: keyof T): boolean
+        hash(): int64
     }
     class GArray<T extends GAny | GAny[] = GAny | GAny[]> {
         static create<A extends any[]>(elements: A): GValueWrap<A>
@@ -74,6 +75,7 @@ declare module "godot" {
 
     class OS {
         static get_name(): string
+        static get_processor_count(): int64
         static create_process(path: string, arguments_: PackedStringArray | string[], open_console?: boolean): int64
     }
 
@@ -1166,6 +1168,16 @@ declare module "godot.annotations" {
             ) => void))
         & {
             tool: () =>
+            ((
+                    target: GObjectConstructor,
+                    _context: ClassDecoratorContext
+                ) => void);
+            batched: () =>
+            ((
+                    target: GObjectConstructor,
+                    _context: ClassDecoratorContext
+                ) => void);
+            cached_exports: () =>
             ((
                     target: GObjectConstructor,
                     _context: ClassDecoratorContext
@@ -1336,7 +1348,8 @@ declare module "godot.annotations" {
         class?: ClassDescriptor,
         hint?: Godot.PropertyHint,
         hint_string?: string,
-        usage?: Godot.PropertyUsageFlags
+        usage?: Godot.PropertyUsageFlags,
+        default?: any
     }
 
     interface RPCConfig {
@@ -2,16 +2,31 @@
 
 declare module "godot-jsb" {
     import {
+        AABB,
         Callable,
+        GDictionary,
         MethodFlags,
         MultiplayerAPI,
         MultiplayerPeer,
+        Node,
+        Node2D,
+        Node3D,
         Object as GObject,
         PackedByteArray,
+        PackedFloat32Array,
+        PackedVector2Array,
+        PackedVector3Array,
         PropertyInfo,
+        Rect2,
+        Resource,
+        RID,
         Signal,
         StringName,
+        Transform2D,
+        Transform3D,
         Variant,
+        Vector2,
+        Vector3,
     } from "godot";
 
     const CAMEL_CASE_BINDINGS_ENABLED: boolean;
@@ -43,6 +58,123 @@ declare module "godot-jsb" {
      */
     function to_array_buffer(packed: PackedByteArray): ArrayBuffer;
 
+    /**
+     * Park scripted nodes out of the tree for reuse, the script instance and the JS object are kept as they are.
+     * `onPooled()`/`onUnpooled()` (`on_pooled`/`on_unpooled` without camel-case bindings) of the script class are called if implemented.
+     * `_ready` and `@onready` properties are not evaluated again when a node is unparked (unless `request_ready` is called).
+     */
+    namespace pool {
+        /** Remove the node from its parent and call `onPooled`. Returns false if it's already parked. */
+        function park(node: Node): boolean;
+
+        /** Add the node to `parent` (if given) and call `onUnpooled`. Returns false if it's not parked. */
+        function unpark(node: Node, parent?: Node): boolean;
+
+        function is_parked(node: Node): boolean;
+    }
+
+    /**
+     * Batched math operations on packed vector arrays, much cheaper than calling the primitive methods element by element.
+     */
+    namespace math {
+        function transform_points(xform: Transform3D, points: PackedVector3Array): PackedVector3Array;
+        function transform_points(xform: Transform2D, points: PackedVector2Array): PackedVector2Array;
+
+        /** Linear interpolation of each pair of elements, both arrays must have the same size. */
+        function lerp_arrays<T extends PackedVector2Array | PackedVector3Array>(from: T, to: T, weight: number): T;
+
+        function distances_to(points: PackedVector3Array, point: Vector3): PackedFloat32Array;
+        function distances_to(points: PackedVector2Array, point: Vector2): PackedFloat32Array;
+
+        /** The bounding box of all points, an empty box if no point is given. */
+        function aabb_of(points: PackedVector3Array): AABB;
+        function aabb_of(points: PackedVector2Array): Rect2;
+    }
+
+    /**
+     * Batched ray queries in one native call, with the same rules as `PhysicsDirectSpaceState3D/2D.intersect_ray`
+     * (call them in `_physics_process` if physics runs on a separate thread). Not available on the web platform.
+     * All buffers are read/written in place:
+     *   - `rays`: `Float32Array` of (from, to) per ray
+     *   - `hits`: `Float32Array` of (position, normal) per ray, zeros if not hit
+     *   - `colliders`: `BigUint64Array` of the instance id of the collider per ray, `0n` if not hit
+     *   - `collision_mask`: the mask of all rays, or `Uint32Array` of the mask per ray
+     * @returns the number of rays which hit
+     */
+    namespace physics {
+        function intersect_rays_3d(space: RID, rays: ArrayBuffer, hits: ArrayBuffer, colliders?: ArrayBuffer | null, collision_mask?: number | ArrayBuffer, collide_with_areas?: boolean): number;
+        function intersect_rays_2d(space: RID, rays: ArrayBuffer, hits: ArrayBuffer, colliders?: ArrayBuffer | null, collision_mask?: number | ArrayBuffer, collide_with_areas?: boolean): number;
+    }
+
+    /**
+     * The thread-safe subset of engine servers, callable from any environment (including workers) without bouncing through the main thread.
+     * The promises are resolved on the loop of the calling environment. Not available on the web platform.
+     *   - navigation paths and resource loads run on the WorkerThreadPool
+     *   - ray queries are batched and run natively in the next idle time of the main thread (when the physics space is not stepping)
+     */
+    namespace servers {
+        function navigation_map_get_path_3d(map: RID, origin: Vector3, destination: Vector3, optimize?: boolean, navigation_layers?: number): Promise<PackedVector3Array>;
+        function navigation_map_get_path_2d(map: RID, origin: Vector2, destination: Vector2, optimize?: boolean, navigation_layers?: number): Promise<PackedVector2Array>;
+        function intersect_ray_3d(space: RID, from: Vector3, to: Vector3, collision_mask?: number, collide_with_areas?: boolean): Promise<GDictionary<{ position: Vector3, normal: Vector3, collider_id: number, rid: RID, shape: number }> | null>;
+        function intersect_ray_2d(space: RID, from: Vector2, to: Vector2, collision_mask?: number, collide_with_areas?: boolean): Promise<GDictionary<{ position: Vector2, normal: Vector2, collider_id: number, rid: RID, shape: number }> | null>;
+        function load_resource(path: string, type_hint?: string): Promise<Resource>;
+    }
+
+    /**
+     * Asynchronous file access running on the WorkerThreadPool (the calling thread is never blocked by the disk).
+     * The requests run one by one in the order they're made, and the promises are resolved on the loop of the calling environment.
+     * Not available on the web platform.
+     */
+    namespace fs {
+        function read_file(path: string): Promise<ArrayBuffer>;
+        /** the data is copied when called, a string is written as UTF-8 */
+        function write_file(path: string, data: ArrayBuffer | string, append?: boolean): Promise<void>;
+        /** the names of entries in the directory, directories end with '/' */
+        function read_dir(path: string): Promise<string[]>;
+    }
+
+    /**
+     * Convert JSON and binary serialized data in one native pass (instead of round-trips through `JSON` or bindings of each field).
+     *   - `parse_json`: parse JSON text (or UTF-8 bytes) into JS values, the same as `JSON.parse`
+     *   - `to_variant`: convert nested plain objects/arrays into `Dictionary`/`Array`
+     *   - `from_variant`: convert nested `Dictionary`/`Array` into plain objects/arrays (only string and integer keys are accepted)
+     *   - `var_to_bytes`/`bytes_to_var`: the same as `GD.var_to_bytes`/`GD.bytes_to_var` with `ArrayBuffer`,
+     *     plain objects/arrays are accepted and returned as `to_variant`/`from_variant` (not available on the web platform)
+     */
+    namespace data {
+        function parse_json(text: string | ArrayBuffer): any;
+        function to_variant(value: any): any;
+        function from_variant(value: any): any;
+        function var_to_bytes(value: any, full_objects?: boolean): ArrayBuffer;
+        function bytes_to_var(buffer: ArrayBuffer, allow_objects?: boolean): any;
+    }
+
+    /**
+     * RenderingServer buffer writes from an `ArrayBuffer` (e.g. the storage of a `Float32Array` kept across frames),
+     * the same as the RenderingServer methods with a `PackedFloat32Array`, without converting it.
+     * Not available on the web platform.
+     */
+    namespace rendering {
+        function multimesh_set_buffer(multimesh: RID, buffer: ArrayBuffer): void;
+    }
+
+    /**
+     * Read/write the transforms of many nodes in one native call, the global transforms by default (`global` is `true`),
+     * local ones are used for the nodes out of tree. `null` (or the nodes of other types) in `nodes` are skipped.
+     * Layout of `buffer` (as a `Float32Array`, the transform of `nodes[i]` at `i * stride`):
+     *   - 3D (stride 12): row-major 3x4 as MultiMesh buffers (`basis.x.x, basis.y.x, basis.z.x, origin.x, ...`),
+     *     so that it can also be passed to `jsb.rendering.multimesh_set_buffer`
+     *   - 2D (stride 6): `x.x, x.y, y.x, y.y, origin.x, origin.y`
+     * Not available on the web platform.
+     * @returns the number of nodes read/written
+     */
+    namespace transforms {
+        function read_3d(nodes: Array<Node3D | null>, buffer: ArrayBuffer, global?: boolean): number;
+        function write_3d(nodes: Array<Node3D | null>, buffer: ArrayBuffer, global?: boolean): number;
+        function read_2d(nodes: Array<Node2D | null>, buffer: ArrayBuffer, global?: boolean): number;
+        function write_2d(nodes: Array<Node2D | null>, buffer: ArrayBuffer, global?: boolean): number;
+    }
+
     type AsyncModuleSourceLoaderResolveFunc = (source: string) => void;
     type AsyncModuleSourceLoaderRejectFunc = (error: string) => void;
 
@@ -63,6 +195,7 @@ declare module "godot-jsb" {
      *
      * NOTE: Only the source code is loaded asynchronously, the module is still evaluated on the script thread.
      * NOTE: Calling the $import() function without a async module loader set in advance will return undefined.
+     * NOTE: On the web platform, `require("godot.web.loader").install({ base_url, manifest })` sets a loader fetching modules over HTTP (cached in Cache Storage).
      * @param module_id the module id to import
      * @example
      * ```js
@@ -86,6 +219,142 @@ declare module "godot-jsb" {
      */
     function $import(module_id: string): Promise<MinimalCommonJSModule>;
 
+    type ConsoleSeverity = "all" | "verbose" | "debug" | "info" | "log" | "trace" | "warning" | "error";
+
+    /**
+     * Skip the `console.*` messages under `severity` in the current environment (workers have their own),
+     * they are filtered before the arguments are stringified, so disabled `console.debug(hugeObject)` calls are nearly free.
+     * `console.assert` is never skipped. The initial value is `runtime/logger/console_min_severity` in project settings.
+     */
+    function set_console_min_severity(severity: ConsoleSeverity): void;
+    function get_console_min_severity(): ConsoleSeverity;
+
+    /**
+     * Bind godot classes (engine names, e.g. `"RigidBody3D"`) ahead of their first use, for instance behind a loading screen.
+     * `class_names` are queued along with `runtime/core/prewarm_classes` (and the recorded ones if `runtime/core/record_touched_classes` is on),
+     * which are otherwise bound in the idle time of frames.
+     * The queued classes are bound until `budget_usec` is spent (all of them if omitted).
+     * @returns the number of classes left in the queue
+     */
+    function prewarm_classes(class_names?: string[], budget_usec?: number): number;
+
+    /**
+     * Load a resource (e.g. a `PackedScene` to instantiate) once and keep it for the lifetime of the environment,
+     * the later calls with the same path (`res://` or `uid://`) return it without going through `ResourceLoader`.
+     * Call it at the top level of a module to resolve the resources when the module is loaded:
+     * ```ts
+     * const Bullet = jsb.preload<PackedScene>("res://prefabs/bullet.tscn", "PackedScene");
+     * ```
+     * Throws if it can't be loaded (or it's not a `type_hint`).
+     */
+    function preload<T extends Resource = Resource>(path: string, type_hint?: string): T;
+
+    /**
+     * Load a resource in background with `ResourceLoader.load_threaded_request`, the promise is settled natively once it's loaded
+     * (all pending loads are polled in one pass per frame, no `load_threaded_get_status` call from scripts).
+     * Throws if the request can't be made, and the promise is rejected if it fails to load.
+     */
+    function load_threaded<T extends Resource = Resource>(path: string, type_hint?: string, use_sub_threads?: boolean): Promise<T>;
+
+    /**
+     * Wait for the next emission of a signal (the native implementation of `Signal.as_promise()`),
+     * resolved with `undefined` if no argument, the argument itself if only one, or an array of all arguments.
+     * The promise is left pending if the signal is never emitted.
+     */
+    function await_signal(signal: Signal): Promise<any>;
+
+    /**
+     * Wait for the next frame (resolved with the same timestamp in milliseconds as `requestAnimationFrame` callbacks).
+     * It's not available if essentials are disabled.
+     */
+    function next_frame(): Promise<number>;
+
+    /**
+     * Wait for the next physics frame (resolved with the physics delta as `requestPhysicsFrame` callbacks).
+     * It's not available if essentials are disabled.
+     */
+    function next_physics_frame(): Promise<number>;
+
+    /**
+     * Poll the states of input actions with one native call per frame instead of calling `Input` for each action.
+     * Not available on the web platform.
+     * ```ts
+     * const actions = ["move_left", "move_right", "jump"];
+     * const buffer = jsb.input.create_snapshot(actions);
+     * const strength = new Float32Array(buffer, 0, actions.length);
+     * const flags = new Uint8Array(buffer, actions.length * 4, actions.length);
+     * if (flags[2] & jsb.input.JUST_PRESSED) { ... }
+     * ```
+     */
+    namespace input {
+        const PRESSED: 1;
+        const JUST_PRESSED: 2;
+        const JUST_RELEASED: 4;
+
+        /**
+         * Register a set of actions (they must exist in `InputMap`), return the buffer shared with native.
+         * The buffer is refreshed at the beginning of each frame if `auto_update` (`true` by default),
+         * otherwise call `update_snapshot` to refresh it on demand.
+         */
+        function create_snapshot(actions: string[], auto_update?: boolean): ArrayBuffer;
+
+        /** Refresh a snapshot now (throws if it's not a snapshot or it's detached) */
+        function update_snapshot(buffer: ArrayBuffer): void;
+
+        /** Stop updating a snapshot, return false if it's not a snapshot */
+        function release_snapshot(buffer: ArrayBuffer): boolean;
+    }
+
+    interface BenchmarkScope {
+        /** `Region.Detail` of the native benchmark scope */
+        name: string;
+        /** index of the enclosing scope (which it's entered from at the first time) in the returned array, -1 for a root */
+        parent: number;
+        depth: number;
+        count: number;
+        total_usec: number;
+        max_usec: number;
+        /** estimated with power-of-two buckets */
+        p99_usec: number;
+    }
+
+    /**
+     * The aggregated timings of the native benchmark scopes (e.g. `JSRealm._load_module`) since startup, all threads included.
+     * Parents precede their children. Not available if `JSB_BENCHMARK` is off at compile-time.
+     */
+    function get_benchmark_scopes(): BenchmarkScope[];
+
+    interface BindingCounter {
+        /** `method` (godot object methods and plain properties), `get`/`set` (indexed properties), `utility` or `builtin` (methods of Variant types) */
+        kind: "method" | "get" | "set" | "utility" | "builtin";
+        /** empty for utility functions */
+        class_name: string;
+        name: string;
+        count: number;
+    }
+
+    /**
+     * The calls through the reflected bindings of the current environment, ranked by the number of calls.
+     * The class names of the top entries are the candidates of `prewarm_classes`. Only available if `JSB_WITH_BINDING_COUNTERS` is on at compile-time.
+     * @param limit the max number of entries returned (all by default)
+     * @param reset clear the counters after read
+     */
+    function get_binding_counters(limit?: number, reset?: boolean): BindingCounter[];
+
+    /**
+     * Record a timeline of the bridge activity (native <-> JS calls, module loads, GC, microtask checkpoints, worker messages) on all threads.
+     * The saved file is in the Chrome trace format, open it in `chrome://tracing` or https://ui.perfetto.dev.
+     * Set `runtime/debugger/trace_events_path` in project settings to record from startup to exit instead.
+     */
+    namespace trace_events {
+        /** start recording, the events recorded before are discarded */
+        function start(): void;
+        function stop(): void;
+
+        /** write the recorded events to a file (e.g. `user://trace.json`), better to call it after `stop` */
+        function save(path: string): boolean;
+    }
+
     interface ScriptPropertyInfo {
         name: string;
         type: Variant.Type;
@@ -94,6 +363,8 @@ declare module "godot-jsb" {
         hint_string?: string;
         usage?: number;
         cache?: boolean;
+        // the literal default value (the same as the initializer)
+        default?: unknown;
     }
 
     export namespace internal {
@@ -107,6 +378,8 @@ declare module "godot-jsb" {
             evaluator: string | OnReadyEvaluatorFunc
         }): void;
         function add_script_tool(constructor: GObjectConstructor): void;
+        function add_script_batched(constructor: GObjectConstructor): void;
+        function add_script_cached_exports(constructor: GObjectConstructor): void;
         function add_script_icon(constructor: GObjectConstructor, path: string): void;
         function add_script_rpc(prototype: GObject, property_key: string, config: {
             rpc_mode?: MultiplayerAPI.RPCMode,
@@ -295,6 +568,11 @@ declare module "godot-jsb" {
 
         function get_class_doc(class_name: string): ClassDoc | undefined;
 
+        /**
+         * get the docs of all the given classes in one call (classes without doc are omitted)
+         */
+        function get_class_docs(class_names: Array<string>): { [class_name: string]: ClassDoc };
+
         /**
          * get a list of all classes registered in ClassDB
          */
@@ -349,3 +627,10 @@ declare function clearTimeout(id: number | undefined): void;
 declare function setInterval(handler: () => void, timeout?: number, ...arguments: any[]): number;
 /** [MDN Reference](https://developer.mozilla.org/docs/Web/API/Window/setTimeout) */
 declare function setTimeout(handler: () => void, timeout?: number, ...arguments: any[]): number;
+/** [MDN Reference](https://developer.mozilla.org/docs/Web/API/Window/requestAnimationFrame) */
+declare function requestAnimationFrame(callback: (time: number) => void): number;
+/** [MDN Reference](https://developer.mozilla.org/docs/Web/API/Window/cancelAnimationFrame) */
+declare function cancelAnimationFrame(id: number | undefined): void;
+/** Run the callback once on the next physics frame, `delta` is the physics step in seconds. */
+declare function requestPhysicsFrame(callback: (delta: number) => void): number;
+declare function cancelPhysicsFrame(id: number | undefined): void;
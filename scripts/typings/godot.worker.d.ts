@@ -1,15 +1,48 @@
 declare module "godot.worker" {
     import { GAny, GArray, Object as GObject } from "godot";
 
+    interface JSWorkerOptions {
+        /** priority of the worker thread, "low" by default */
+        priority?: "low" | "normal" | "high";
+
+        /** indices of the logical processors the worker thread is allowed to run on (not supported on macOS/iOS) */
+        affinity?: ReadonlyArray<number>;
+
+        /** name of the worker thread (shown in debuggers and profilers) */
+        name?: string;
+
+        /**
+         * Queue the calls from other threads to the scripts of objects created in the worker (e.g. `_process` of the nodes instantiated
+         * by the worker and added to the scene tree) instead of failing them, even if `defer_threaded_script_calls` is disabled in the project settings.
+         * The queued calls run on the worker thread and return nothing to the caller. Not supported on the web platform.
+         */
+        defer_script_calls?: boolean;
+    }
+
+    /**
+     * A JS environment running on a dedicated thread.
+     * On the web platform, it runs in a browser Web Worker without the engine: the worker module must be self-contained
+     * (only "godot.worker" can be required in it), and only ArrayBuffers can be transferred.
+     */
     class JSWorker {
-        constructor(path: string);
+        constructor(path: string, options?: JSWorkerOptions);
 
         postMessage(message: any, transfer?: GArray | ReadonlyArray<NonNullable<GAny>>): void;
+
+        /**
+         * Post an array of messages at once (serialized into one buffer and received in one call if `onmessages` is provided in the worker).
+         * @param messages the messages (received in order)
+         * @param transfer objects in `messages` to transfer instead of cloning
+         */
+        postMessages(messages: ReadonlyArray<any>, transfer?: GArray | ReadonlyArray<NonNullable<GAny>>): void;
         terminate(): void;
 
         onready?: () => void;
         onmessage?: (message: any) => void;
 
+        /** receive the messages posted by `postMessages` in one call, `onmessage` is called for each of them if not provided */
+        onmessages?: (messages: any[]) => void;
+
         //TODO not implemented yet
         onerror?: (error: any) => void;
 
@@ -20,9 +53,22 @@ declare module "godot.worker" {
         ontransfer?: (obj: GObject) => void;
     }
 
+    /**
+     * Run a short-lived task on the WorkerThreadPool of godot (in a pooled environment, without a dedicated thread).
+     * The task module must export a `run(input)` function, the input and the result are passed in the same way as `postMessage`.
+     * An async `run` must settle without waiting for timers or other events.
+     * @param path the module path of the task
+     * @param input the value passed to `run` (cloned)
+     * @param transfer objects in `input` to transfer instead of cloning
+     */
+    function runTask<T = any>(path: string, input?: any, transfer?: GArray | ReadonlyArray<NonNullable<GAny>>): Promise<T>;
+
     // only available in worker scripts
     const JSWorkerParent: {
         onmessage?: (message: any) => void,
+
+        /** receive the messages posted by `postMessages` in one call, `onmessage` is called for each of them if not provided */
+        onmessages?: (messages: any[]) => void,
         
         close(): void,
 
@@ -34,6 +80,9 @@ declare module "godot.worker" {
 
         postMessage(message: any, transfer?: GArray | ReadonlyArray<NonNullable<GAny>>): void;
 
+        /** post an array of messages at once (see `JSWorker.postMessages`) */
+        postMessages(messages: ReadonlyArray<any>, transfer?: GArray | ReadonlyArray<NonNullable<GAny>>): void;
+
     } | undefined;
 
 }
@@ -0,0 +1,26 @@
+import { Mesh, MeshInstance3D, SurfaceTool, Vector3 } from "godot"
+
+// the reference scene of procedural mesh generation in each frame (tests/test_jsb_benchmark.h)
+export default class BenchMeshNode extends MeshInstance3D {
+    resolution = 32;
+    time = 0;
+
+    _process(delta: number): void {
+        this.time += delta;
+        const n = this.resolution;
+        const tool = new SurfaceTool();
+        tool.begin(Mesh.PrimitiveType.PRIMITIVE_TRIANGLES);
+        for (let z = 0; z < n; ++z) {
+            for (let x = 0; x < n; ++x) {
+                const y00 = Math.sin(x * 0.3 + this.time) * Math.cos(z * 0.3);
+                const y10 = Math.sin((x + 1) * 0.3 + this.time) * Math.cos(z * 0.3);
+                const y01 = Math.sin(x * 0.3 + this.time) * Math.cos((z + 1) * 0.3);
+                tool.add_vertex(new Vector3(x, y00, z));
+                tool.add_vertex(new Vector3(x + 1, y10, z));
+                tool.add_vertex(new Vector3(x, y01, z + 1));
+            }
+        }
+        tool.generate_normals();
+        this.mesh = tool.commit();
+    }
+}
@@ -0,0 +1,12 @@
+import { Node2D, Vector2 } from "godot"
+
+// the reference scene of scripted `_process` nodes (tests/test_jsb_benchmark.h)
+export default class BenchProcessNode extends Node2D {
+    speed = 1;
+
+    _process(delta: number): void {
+        this.rotation += delta * this.speed;
+        const position = this.position;
+        this.position = new Vector2(position.x + delta, position.y);
+    }
+}
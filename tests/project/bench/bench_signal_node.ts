@@ -0,0 +1,11 @@
+import { Node } from "godot"
+
+// the reference scene of physics callbacks emitting signals into JS handlers (tests/test_jsb_benchmark.h)
+export default class BenchSignalNode extends Node {
+    contacts = 0;
+
+    _physics_process(delta: number): void {
+        ++this.contacts;
+        this.emit_signal("bench_contact", this, this.contacts);
+    }
+}
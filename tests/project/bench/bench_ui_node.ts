@@ -0,0 +1,16 @@
+import { Color, Label, Vector2 } from "godot"
+
+// the reference scene of UI controls bound to a JS model (tests/test_jsb_benchmark.h)
+export default class BenchUINode extends Label {
+    model = { score: 0, health: 1 };
+
+    _process(delta: number): void {
+        const model = this.model;
+        model.score += 1;
+        model.health = (model.health + delta) % 1;
+        this.text = `score: ${model.score}`;
+        this.modulate = new Color(1, model.health, model.health, 1);
+        this.custom_minimum_size = new Vector2(100 + model.health * 10, 20);
+        this.visible = model.score % 2 == 0;
+    }
+}
@@ -0,0 +1,6 @@
+// echo worker for the message round-trip benchmark (tests/test_jsb_benchmark.h)
+const { JSWorkerParent } = require("godot.worker");
+
+JSWorkerParent.onmessage = function (message) {
+    JSWorkerParent.postMessage(message);
+};
@@ -0,0 +1,6 @@
+// echo worker for the long-session soak test (tests/test_jsb_soak.h)
+const { JSWorkerParent } = require("godot.worker");
+
+JSWorkerParent.onmessage = function (message) {
+    JSWorkerParent.postMessage({ tick: message.tick, payload: message.payload.slice() });
+};
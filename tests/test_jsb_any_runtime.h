@@ -116,6 +116,144 @@ namespace jsb::tests
         CHECK(ctx.counter == 12);
     }
 
+    TEST_CASE("[jsb] timer manager - clear pending timers")
+    {
+        typedef internal::TTimerManager<TimerFunction, 12, 6> JSTimerManager;
+        JSTimerManager tm;
+
+        TimerContext ctx;
+        std::vector<internal::TimerHandle> handles;
+        for (int i = 0; i < 100; ++i)
+        {
+            handles.push_back(tm.add_timer(TimerFunction(), 10 + i * 10));
+        }
+        CHECK(tm.size() == 100);
+
+        // cleared timers are unlinked from the wheel slots immediately
+        for (int i = 0; i < 100; i += 2)
+        {
+            CHECK(tm.clear_timer(handles[i]));
+        }
+        CHECK(tm.size() == 50);
+
+        for (int i = 0; i < 200; ++i)
+        {
+            if (tm.tick(10))
+            {
+                tm.invoke_timers(&ctx);
+            }
+        }
+        CHECK(ctx.counter == 50);
+        CHECK(tm.size() == 0);
+        CHECK(!tm.has_activated_timers());
+    }
+
+    TEST_CASE("[jsb.internal] VariantAllocator drain budget")
+    {
+        internal::VariantAllocator allocator;
+        for (int i = 0; i < 5; ++i)
+        {
+            Variant* variant = allocator.alloc(Array());
+            allocator.free_safe(variant);
+        }
+#if JSB_DEBUG
+        CHECK(allocator.get_allocated_num() == 5);
+#endif
+        allocator.drain(2);
+#if JSB_DEBUG
+        CHECK(allocator.get_allocated_num() == 3);
+#endif
+        // pushed after a partial drain
+        allocator.free_safe(allocator.alloc(Dictionary()));
+        allocator.drain(2);
+#if JSB_DEBUG
+        CHECK(allocator.get_allocated_num() == 2);
+#endif
+        allocator.drain();
+        CHECK(allocator.get_allocated_num() == 0);
+    }
+
+    TEST_CASE("[jsb.internal] VariantAllocator reuses freed variants")
+    {
+        internal::VariantAllocator allocator;
+        LocalVector<Variant*> variants;
+        // more than the owner thread cache holds (v8 and jsc)
+        for (int i = 0; i < 300; ++i)
+        {
+            variants.push_back(allocator.alloc(Vector2(i, i)));
+        }
+        for (int i = 0; i < 300; ++i)
+        {
+            CHECK(*variants[i] == Variant(Vector2(i, i)));
+            allocator.free(variants[i]);
+        }
+        // a freed variant comes back as NIL
+        Variant* variant = allocator.alloc();
+        CHECK(variant->get_type() == Variant::NIL);
+        allocator.free(variant);
+        CHECK(allocator.get_allocated_num() == 0);
+    }
+
+    TEST_CASE("[jsb.internal] PointerMap insert/erase")
+    {
+        internal::PointerMap<int32_t> map;
+        int32_t objects[64];
+        for (int32_t i = 0; i < 64; ++i)
+        {
+            map.insert(&objects[i], i);
+        }
+        CHECK(map.size() == 64);
+        CHECK(map.capacity() >= 128);
+
+        // erasing shifts back the colliding entries, they must be still reachable
+        for (int32_t i = 0; i < 64; i += 2)
+        {
+            CHECK(map.erase(&objects[i]));
+        }
+        CHECK(!map.erase(&objects[0]));
+        CHECK(map.size() == 32);
+        for (int32_t i = 0; i < 64; ++i)
+        {
+            const int32_t* value = map.getptr(&objects[i]);
+            CHECK((value != nullptr) == (i % 2 == 1));
+            if (value) CHECK(*value == i);
+        }
+
+        map.clear();
+        CHECK(map.size() == 0);
+        CHECK(!map.has(&objects[1]));
+    }
+
+#if JSB_BENCHMARK
+    TEST_CASE("[jsb.internal] Benchmark scopes aggregation")
+    {
+        // registered globally, they must live until exit
+        static internal::BenchmarkSite outer("test.outer", __FILE__, __LINE__);
+        static internal::BenchmarkSite inner("test.inner", __FILE__, __LINE__);
+        for (int i = 0; i < 3; ++i)
+        {
+            const internal::Benchmark outer_scope(outer);
+            const internal::Benchmark inner_scope(inner);
+        }
+
+        LocalVector<internal::BenchmarkSite::Snapshot> snapshots;
+        internal::BenchmarkSite::collect(snapshots);
+        int outer_index = -1, inner_index = -1;
+        for (int index = 0; index < (int) snapshots.size(); ++index)
+        {
+            if (snapshots[index].name == outer.name) outer_index = index;
+            if (snapshots[index].name == inner.name) inner_index = index;
+        }
+        REQUIRE(outer_index >= 0);
+        REQUIRE(inner_index > outer_index);
+        CHECK(snapshots[inner_index].parent == outer_index);
+        CHECK(snapshots[inner_index].depth == snapshots[outer_index].depth + 1);
+        CHECK(snapshots[outer_index].count == 3);
+        CHECK(snapshots[inner_index].count == 3);
+        CHECK(snapshots[inner_index].p99_usec <= snapshots[inner_index].max_usec);
+    }
+#endif
+
     TEST_CASE("[jsb] raw isolate essential tests")
     {
         impl::GlobalInitialize::init();
@@ -269,6 +407,73 @@ return 1+1;
         env.reset();
     }
 
+    TEST_CASE("[jsb] StringNameCache - eviction")
+    {
+        GodotJSScriptLanguageIniter initer;
+        std::shared_ptr<Environment> env = GodotJSScriptLanguage::get_singleton()->get_environment();
+        {
+            JSB_TESTS_EXECUTION_SCOPE(env.get());
+            v8::Isolate* isolate = env->get_isolate();
+            v8::HandleScope scope_1(isolate);
+
+            static constexpr int kCacheSize = 64;
+            TStringNameCache<kCacheSize> cache;
+            std::vector<v8::Local<v8::String>> values;
+            for (int i = 0; i < kCacheSize + 36; ++i)
+            {
+                values.push_back(cache.get_string_value(isolate, StringName(vformat("name_%d", i))));
+            }
+            CHECK(cache.size() == kCacheSize);
+            CHECK(cache.get_evictions() == 36);
+
+            // the most recently used ones are still reachable by the JS string
+            const uint64_t hits = cache.get_hits();
+            for (int i = 36; i < kCacheSize + 36; ++i)
+            {
+                StringName name;
+                CHECK(cache.try_get_string_name(isolate, values[i], name));
+                CHECK(name == StringName(vformat("name_%d", i)));
+            }
+            CHECK(!cache.is_string_value_cached(isolate, values[0]));
+            CHECK(cache.get_string_name(isolate, values[kCacheSize]) == StringName(vformat("name_%d", kCacheSize)));
+            CHECK(cache.get_hits() == hits + 1);
+        }
+        env.reset();
+    }
+
+    TEST_CASE("[jsb] StringNameCache - identity table")
+    {
+        GodotJSScriptLanguageIniter initer;
+        std::shared_ptr<Environment> env = GodotJSScriptLanguage::get_singleton()->get_environment();
+        {
+            JSB_TESTS_EXECUTION_SCOPE(env.get());
+            v8::Isolate* isolate = env->get_isolate();
+            v8::HandleScope scope_1(isolate);
+
+            static constexpr int kCacheSize = 64;
+            TStringNameCache<kCacheSize> cache;
+            const StringName name = "Player";
+            const v8::Local<v8::String> value = cache.get_string_value(isolate, name);
+            const uint64_t hits = cache.get_hits();
+            CHECK(cache.get_string_value(isolate, name) == value);
+            CHECK(cache.get_hits() == hits + 1);
+            CHECK(cache.get_misses() == 1);
+
+            // an evicted entry is not returned from the identity table
+            for (int i = 0; i < kCacheSize; ++i)
+            {
+                cache.get_string_value(isolate, StringName(vformat("name_%d", i)));
+            }
+            CHECK(!cache.is_string_value_cached(isolate, value));
+            const v8::Local<v8::String> value_2 = cache.get_string_value(isolate, name);
+            CHECK(value_2->StringEquals(value));
+            StringName name_2;
+            CHECK(cache.try_get_string_name(isolate, value_2, name_2));
+            CHECK(name_2 == name);
+        }
+        env.reset();
+    }
+
     TEST_CASE("[jsb] Godot Object Class prototype checks")
     {
         GodotJSScriptLanguageIniter initer;
@@ -508,6 +713,63 @@ file = undefined;
         CHECK(weak_ref->get_ref().is_null());
         memdelete(weak_ref);
     }
+
+    TEST_CASE("[jsb.weaver] GlobalClassCache scanners")
+    {
+        GlobalClassInfo info;
+        CHECK(GlobalClassCache::scan_typescript("import { Node2D } from \"godot\";\n@tool()\nexport default class Foo extends Node2D {\n}", info));
+        CHECK(info.class_name == "Foo");
+        CHECK(info.base_type == "Node2D");
+        CHECK(info.is_tool);
+        CHECK(!info.is_generic);
+
+        info = {};
+        CHECK(GlobalClassCache::scan_typescript("export default class Bar<T extends Resource> extends Node {\n}", info));
+        CHECK(info.class_name == "Bar");
+        CHECK(info.base_type == "Node");
+        CHECK(info.is_generic);
+
+        info = {};
+        CHECK(GlobalClassCache::scan_javascript("class Foo extends Node2D {}\nexports.default = Foo;", info));
+        CHECK(info.class_name == "Foo");
+        CHECK(info.base_type == "Node2D");
+
+        info = {};
+        CHECK(GlobalClassCache::scan_javascript("exports.default = class Baz extends Sprite2D {}", info));
+        CHECK(info.class_name == "Baz");
+        CHECK(info.base_type == "Sprite2D");
+
+        info = {};
+        CHECK(!GlobalClassCache::scan_typescript("export class Qux extends Node {}", info));
+        CHECK(!GlobalClassCache::scan_javascript("const x = 1;", info));
+    }
+
+    TEST_CASE("[jsb.internal] SourceMap lazy decoding")
+    {
+        const char mappings[] = ";;;AAAA,iCAA6B;AAC7B,MAAa,QAAQ;CAAI,GAAG";
+        internal::SourceMap map;
+        CHECK(map.parse_mappings(mappings, std::size(mappings) - 1));
+        CHECK(map.get_line_count() == 6);
+
+        internal::IndexedSourcePosition pos;
+        CHECK(!map.find(1, 0, pos));
+        CHECK(map.find(3, 40, pos));
+        CHECK(pos.line == 0);
+        CHECK(pos.column == 29);
+        CHECK(map.find(4, 5, pos));
+        CHECK(pos.line == 1);
+        CHECK(pos.column == 13);
+
+        // the lines beyond the checkpoints are restored from the accumulated fields
+        String many;
+        for (int i = 0; i < 1000; ++i) many += "AACA;";
+        const CharString many_utf8 = many.utf8();
+        CHECK(map.parse_mappings(many_utf8.get_data(), many_utf8.length()));
+        CHECK(map.find(999, 0, pos));
+        CHECK(pos.line == 1000);
+        CHECK(map.find(64, 0, pos));
+        CHECK(pos.line == 65);
+    }
 }
 
 #endif
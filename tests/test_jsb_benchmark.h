@@ -0,0 +1,442 @@
+#ifndef GODOTJS_TESTS_JSB_BENCHMARK_H
+#define GODOTJS_TESTS_JSB_BENCHMARK_H
+
+#include "jsb_test_helpers.h"
+#include "../bridge/jsb_type_convert.h"
+
+// micro/macro benchmarks of the bridge hot paths for any runtime.
+// they're skipped by default, run them explicitly with:
+//     godot --test --test-case="[jsb.bench]*" --no-skip
+// each result is printed as a JSON line, and appended to the file given by the environment variable `JSB_BENCHMARK_OUTPUT` (if set),
+// so that the results of different runtimes and releases can be compared by tools.
+// the reference scenes ("[jsb.bench] frame time*") report p50/p95/p99 frame times and the calls into JS per frame instead.
+namespace jsb::tests
+{
+    struct Benchmark
+    {
+        // the scale of iterations (environment variable `JSB_BENCHMARK_SCALE`, 1 by default)
+        static int64_t get_scale()
+        {
+            const String scale = OS::get_singleton()->get_environment("JSB_BENCHMARK_SCALE");
+            return scale.is_valid_int() ? MAX(scale.to_int(), (int64_t) 1) : 1;
+        }
+
+        static void add_result(const String& p_name, int64_t p_iterations, uint64_t p_usec)
+        {
+            Dictionary record;
+            record["name"] = p_name;
+            record["runtime"] = JSB_IMPL_VERSION_STRING;
+            record["version"] = jsb_format("%d.%d.%d", JSB_MAJOR_VERSION, JSB_MINOR_VERSION, JSB_PATCH_VERSION);
+            record["iterations"] = p_iterations;
+            record["total_usec"] = (int64_t) p_usec;
+            record["ns_per_op"] = p_iterations > 0 ? (double) p_usec * 1000.0 / (double) p_iterations : 0.0;
+            add_record(record);
+        }
+
+        // the percentiles of frame times, and the number of calls into JS in each frame
+        static void add_frame_result(const String& p_name, LocalVector<uint64_t>& p_frame_usec, uint64_t p_bridge_calls)
+        {
+            REQUIRE(!p_frame_usec.is_empty());
+            p_frame_usec.sort();
+            const uint32_t num = p_frame_usec.size();
+            Dictionary record;
+            record["name"] = p_name;
+            record["runtime"] = JSB_IMPL_VERSION_STRING;
+            record["version"] = jsb_format("%d.%d.%d", JSB_MAJOR_VERSION, JSB_MINOR_VERSION, JSB_PATCH_VERSION);
+            record["frames"] = num;
+            record["p50_usec"] = p_frame_usec[num * 50 / 100];
+            record["p95_usec"] = p_frame_usec[MIN(num - 1, num * 95 / 100)];
+            record["p99_usec"] = p_frame_usec[MIN(num - 1, num * 99 / 100)];
+            record["max_usec"] = p_frame_usec[num - 1];
+            record["bridge_calls_per_frame"] = (double) p_bridge_calls / (double) num;
+            add_record(record);
+        }
+
+        static void add_record(const Dictionary& p_record)
+        {
+            const String line = JSON::stringify(p_record, "", false);
+            MESSAGE("[jsb.bench] ", line);
+
+            const String path = OS::get_singleton()->get_environment("JSB_BENCHMARK_OUTPUT");
+            if (path.is_empty()) return;
+            const Ref<FileAccess> file = FileAccess::open(path, FileAccess::exists(path) ? FileAccess::READ_WRITE : FileAccess::WRITE);
+            CHECK(file.is_valid());
+            file->seek_end();
+            file->store_line(line);
+        }
+
+        // info[0] - name
+        // info[1] - iterations
+        // info[2] - elapsed time in microseconds
+        static void report(const v8::FunctionCallbackInfo<v8::Value>& info)
+        {
+            v8::Isolate* isolate = info.GetIsolate();
+            v8::Local<v8::Context> context = isolate->GetCurrentContext();
+            CHECK(info.Length() == 3);
+            double iterations, usec;
+            CHECK(info[1]->NumberValue(context).To(&iterations));
+            CHECK(info[2]->NumberValue(context).To(&usec));
+            add_result(impl::Helper::to_string(isolate, info[0]), (int64_t) iterations, (uint64_t) usec);
+        }
+
+        // dispatch `_process` to the script instances from the engine side (as the SceneTree does for each frame)
+        // info[0] - array of nodes
+        // info[1] - number of frames
+        static void dispatch_process(const v8::FunctionCallbackInfo<v8::Value>& info)
+        {
+            v8::Isolate* isolate = info.GetIsolate();
+            v8::Local<v8::Context> context = isolate->GetCurrentContext();
+            CHECK(info.Length() == 2);
+            CHECK(info[0]->IsArray());
+
+            const v8::Local<v8::Array> array = info[0].As<v8::Array>();
+            LocalVector<Object*> nodes;
+            for (uint32_t index = 0, num = array->Length(); index < num; ++index)
+            {
+                v8::Local<v8::Value> element;
+                Object* node = nullptr;
+                CHECK(array->Get(context, index).ToLocal(&element));
+                CHECK(TypeConvert::js_to_gd_obj(isolate, context, element, node));
+                CHECK(node);
+                nodes.push_back(node);
+            }
+
+            int32_t frames = 0;
+            CHECK(info[1]->Int32Value(context).To(&frames));
+            const StringName method = "_process";
+            const Variant delta = 1.0 / 60.0;
+            const Variant* args[] = { &delta };
+            const uint64_t start = OS::get_singleton()->get_ticks_usec();
+            for (int32_t frame = 0; frame < frames; ++frame)
+            {
+                for (Object* node : nodes)
+                {
+                    Callable::CallError error;
+                    node->callp(method, args, 1, error);
+                }
+            }
+            add_result(jsb_format("_process dispatch (%d nodes)", (int) nodes.size()), (int64_t) frames * nodes.size(), OS::get_singleton()->get_ticks_usec() - start);
+        }
+
+        static void expose(Environment* p_env)
+        {
+            v8::Isolate* isolate = p_env->get_isolate();
+            const v8::Local<v8::Context> context = p_env->get_context();
+            const v8::Local<v8::Object> global_obj = context->Global();
+            global_obj->Set(context, impl::Helper::new_string(isolate, "jsb_bench_report"), v8::Function::New(context, report).ToLocalChecked()).Check();
+            global_obj->Set(context, impl::Helper::new_string(isolate, "jsb_bench_dispatch_process"), v8::Function::New(context, dispatch_process).ToLocalChecked()).Check();
+            global_obj->Set(context, impl::Helper::new_string(isolate, "jsb_bench_scale"), impl::Helper::new_integer(isolate, get_scale())).Check();
+        }
+
+        /**
+         * Run a reference scene for a fixed number of frames, as the main loop does (headless, without a SceneTree).
+         * `p_source` creates the nodes of the scene, keeps them in `bench_scene_nodes`, and evaluates to a GArray of them.
+         * In each frame `_process` (or `_physics_process`) is dispatched to all nodes before updating the environment (timers, microtasks).
+         */
+        static void run_scene(const String& p_name, const char* p_source, bool p_physics)
+        {
+            GodotJSScriptLanguageIniter initer;
+            const std::shared_ptr<Environment> env = GodotJSScriptLanguage::get_singleton()->get_environment();
+
+            Error err;
+            Array nodes_array = GodotJSScriptLanguage::get_singleton()->eval_source(p_source, err).to_variant();
+            CHECK(err == OK);
+            LocalVector<Object*> nodes;
+            for (int index = 0; index < nodes_array.size(); ++index)
+            {
+                Object* node = nodes_array[index];
+                CHECK(node);
+                nodes.push_back(node);
+            }
+            nodes_array.clear();
+            REQUIRE(!nodes.is_empty());
+
+            const StringName method = p_physics ? "_physics_process" : "_process";
+            const Variant delta = 1.0 / 60.0;
+            const Variant* args[] = { &delta };
+            const int64_t frames = 300 * get_scale();
+            LocalVector<uint64_t> frame_usec;
+            frame_usec.resize((uint32_t) frames);
+
+            Statistics stats;
+            env->get_statistics(stats);
+            const uint64_t bridge_calls = stats.counters.bridge_calls;
+            for (int64_t frame = 0; frame < frames; ++frame)
+            {
+                const uint64_t start = OS::get_singleton()->get_ticks_usec();
+                for (Object* node : nodes)
+                {
+                    Callable::CallError error;
+                    node->callp(method, args, 1, error);
+                }
+                env->update(16);
+                frame_usec[(uint32_t) frame] = OS::get_singleton()->get_ticks_usec() - start;
+            }
+            env->get_statistics(stats);
+            add_frame_result(p_name, frame_usec, stats.counters.bridge_calls - bridge_calls);
+
+            GodotJSScriptLanguage::get_singleton()->eval_source("for (const node of bench_scene_nodes) node.free(); bench_scene_nodes = null;", err);
+            CHECK(err == OK);
+        }
+    };
+
+    // the shared harness of the benchmarks in JS (with a short warmup for the JIT enabled runtimes)
+    constexpr char kBenchmarkHarness[] = R"--(
+globalThis.bench = function (name, iterations, fn) {
+    const gd = require("godot");
+    iterations *= jsb_bench_scale;
+    for (let i = 0, n = Math.min(iterations / 10, 1000); i < n; ++i) fn(i);
+    const start = gd.Time.get_ticks_usec();
+    for (let i = 0; i < iterations; ++i) fn(i);
+    jsb_bench_report(name, iterations, gd.Time.get_ticks_usec() - start);
+};
+)--";
+
+    TEST_CASE("[jsb.bench] bridge calls and conversions" * doctest::skip())
+    {
+        GodotJSScriptLanguageIniter initer;
+        {
+            JSB_TESTS_EXECUTION_SCOPE(GodotJSScriptLanguage::get_singleton()->get_environment().get());
+            Benchmark::expose(GodotJSScriptLanguage::get_singleton()->get_environment().get());
+        }
+
+        Error err;
+        GodotJSScriptLanguage::get_singleton()->eval_source(kBenchmarkHarness, err);
+        CHECK(err == OK);
+        GodotJSScriptLanguage::get_singleton()->eval_source(R"--(
+const gd = require("godot");
+const node = new gd.Node();
+const object = new gd.Object();
+
+bench("method call (no arguments)", 200000, () => node.is_inside_tree());
+bench("method call (int argument)", 200000, i => node.set_process_priority(i));
+bench("property get (int)", 200000, () => node.process_priority);
+bench("property set (int)", 200000, i => { node.process_priority = i; });
+bench("property set (StringName)", 100000, () => { node.name = "bench"; });
+bench("static method call", 200000, () => gd.Time.get_ticks_msec());
+
+bench("construct Vector2", 200000, () => new gd.Vector2(1, 2));
+bench("construct Vector3", 200000, () => new gd.Vector3(1, 2, 3));
+bench("construct Color", 200000, () => new gd.Color(1, 0, 0, 1));
+bench("construct Transform2D", 100000, () => new gd.Transform2D());
+
+// js->variant->js round-trip for each type (through Object.set_meta/get_meta)
+const values = {
+    "bool": true,
+    "int": 123,
+    "float": 1.5,
+    "String": "hello",
+    "Vector2": new gd.Vector2(1, 2),
+    "Vector3": new gd.Vector3(1, 2, 3),
+    "Color": new gd.Color(1, 0, 0, 1),
+    "Array": gd.GArray.create([1, 2, 3]),
+    "Dictionary": gd.GDictionary.create({ a: 1 }),
+    "Object": node,
+    "PackedByteArray": new gd.PackedByteArray(),
+};
+for (const [type_name, value] of Object.entries(values)) {
+    bench(`variant conversion (${type_name})`, 100000, () => { object.set_meta("value", value); return object.get_meta("value"); });
+}
+
+object.add_user_signal("bench_signal");
+let received = 0;
+object.connect("bench_signal", gd.Callable.create(() => { ++received; }));
+bench("signal emission into js", 100000, () => object.emit_signal("bench_signal"));
+console.assert(received > 0, "signal not received");
+
+const unsorted = gd.GArray.create(Array.from({ length: 1000 }, (_, i) => (i * 7919) % 1000));
+bench("Array.sort_custom with js comparator (1000 elements)", 100, () => unsorted.duplicate().sort_custom((a, b) => a < b));
+bench("Array.filter with js callable (1000 elements)", 100, () => unsorted.filter(gd.Callable.create(v => v % 2 == 0)));
+
+node.free();
+object.free();
+)--", err);
+        CHECK(err == OK);
+    }
+
+    TEST_CASE("[jsb.bench] script _process dispatch" * doctest::skip())
+    {
+        GodotJSScriptLanguageIniter initer;
+        {
+            JSB_TESTS_EXECUTION_SCOPE(GodotJSScriptLanguage::get_singleton()->get_environment().get());
+            Benchmark::expose(GodotJSScriptLanguage::get_singleton()->get_environment().get());
+        }
+
+        Error err;
+        GodotJSScriptLanguage::get_singleton()->eval_source(R"--(
+const mod = require("test_01");
+for (const num of [1, 100, 1000]) {
+    const nodes = [];
+    for (let i = 0; i < num; ++i) nodes.push(new mod.default());
+    jsb_bench_dispatch_process(nodes, Math.max(10, 100000 / num) * jsb_bench_scale);
+    for (const node of nodes) node.free();
+}
+)--", err);
+        CHECK(err == OK);
+    }
+
+    // the reference scenes (tests/project/bench), reported as frame time percentiles
+    TEST_CASE("[jsb.bench] frame time: 10k _process nodes" * doctest::skip())
+    {
+        Benchmark::run_scene("frame time: 10k _process nodes", R"--(
+const gd = require("godot");
+const mod = require("bench/bench_process_node");
+globalThis.bench_scene_nodes = [];
+for (let i = 0; i < 10000; ++i) {
+    const node = new mod.default();
+    node.speed = 1 + (i % 7);
+    bench_scene_nodes.push(node);
+}
+gd.GArray.create(bench_scene_nodes);
+)--", false);
+    }
+
+    TEST_CASE("[jsb.bench] frame time: physics callbacks with signals" * doctest::skip())
+    {
+        Benchmark::run_scene("frame time: physics callbacks with signals", R"--(
+const gd = require("godot");
+const mod = require("bench/bench_signal_node");
+let received = 0;
+const on_contact = gd.Callable.create((node, contacts) => { received += contacts & 1; });
+globalThis.bench_scene_nodes = [];
+for (let i = 0; i < 2000; ++i) {
+    const node = new mod.default();
+    node.add_user_signal("bench_contact");
+    node.connect("bench_contact", on_contact);
+    bench_scene_nodes.push(node);
+}
+gd.GArray.create(bench_scene_nodes);
+)--", true);
+    }
+
+    TEST_CASE("[jsb.bench] frame time: UI property bindings" * doctest::skip())
+    {
+        Benchmark::run_scene("frame time: UI property bindings", R"--(
+const gd = require("godot");
+const mod = require("bench/bench_ui_node");
+globalThis.bench_scene_nodes = [];
+for (let i = 0; i < 2000; ++i) bench_scene_nodes.push(new mod.default());
+gd.GArray.create(bench_scene_nodes);
+)--", false);
+    }
+
+    TEST_CASE("[jsb.bench] frame time: procedural mesh generation" * doctest::skip())
+    {
+        Benchmark::run_scene("frame time: procedural mesh generation", R"--(
+const gd = require("godot");
+const mod = require("bench/bench_mesh_node");
+globalThis.bench_scene_nodes = [];
+for (let i = 0; i < 4; ++i) bench_scene_nodes.push(new mod.default());
+gd.GArray.create(bench_scene_nodes);
+)--", false);
+    }
+
+    TEST_CASE("[jsb.bench] module load" * doctest::skip())
+    {
+        GodotJSScriptLanguageIniter initer;
+
+        // every module is loaded only once, so they're generated as different files
+        const int64_t num = 200 * Benchmark::get_scale();
+        const String dir = "./.godot/GodotJS/jsb_bench";
+        CHECK(DirAccess::make_dir_recursive_absolute(dir) == OK);
+        for (int64_t index = 0; index < num; ++index)
+        {
+            const Ref<FileAccess> file = FileAccess::open(dir.path_join(jsb_format("m_%d.js", index)), FileAccess::WRITE);
+            CHECK(file.is_valid());
+            file->store_string(jsb_format("\"use strict\";\nObject.defineProperty(exports, \"__esModule\", { value: true });\nexports.value = %d;\nexports.call_me = function () { return exports.value; };\n", index));
+        }
+
+        const std::shared_ptr<Environment> env = GodotJSScriptLanguage::get_singleton()->get_environment();
+        {
+            JSB_TESTS_EXECUTION_SCOPE(env.get());
+            const uint64_t start = OS::get_singleton()->get_ticks_usec();
+            for (int64_t index = 0; index < num; ++index)
+            {
+                CHECK(env->load(jsb_format("jsb_bench/m_%d", index)) == OK);
+            }
+            Benchmark::add_result("module load (cold)", num, OS::get_singleton()->get_ticks_usec() - start);
+        }
+        {
+            JSB_TESTS_EXECUTION_SCOPE(env.get());
+            Benchmark::expose(env.get());
+        }
+
+        Error err;
+        GodotJSScriptLanguage::get_singleton()->eval_source(kBenchmarkHarness, err);
+        CHECK(err == OK);
+        GodotJSScriptLanguage::get_singleton()->eval_source(R"--(
+bench("module require (cached)", 100000, () => require("jsb_bench/m_0"));
+)--", err);
+        CHECK(err == OK);
+    }
+
+    TEST_CASE("[jsb.bench] gc churn" * doctest::skip())
+    {
+        GodotJSScriptLanguageIniter initer;
+        {
+            JSB_TESTS_EXECUTION_SCOPE(GodotJSScriptLanguage::get_singleton()->get_environment().get());
+            Benchmark::expose(GodotJSScriptLanguage::get_singleton()->get_environment().get());
+        }
+
+        Error err;
+        GodotJSScriptLanguage::get_singleton()->eval_source(kBenchmarkHarness, err);
+        CHECK(err == OK);
+
+        // the garbage collection of wrapped objects is included in the measurement
+        const uint64_t start = OS::get_singleton()->get_ticks_usec();
+        GodotJSScriptLanguage::get_singleton()->eval_source(R"--(
+const gd = require("godot");
+bench("allocate RefCounted", 100000, () => new gd.RefCounted());
+bench("allocate Vector3", 100000, () => new gd.Vector3(1, 2, 3));
+bench("allocate GArray", 100000, () => gd.GArray.create([]));
+)--", err);
+        CHECK(err == OK);
+        Environment::gc();
+        Benchmark::add_result("gc churn (allocation + collection)", 300000 * Benchmark::get_scale(), OS::get_singleton()->get_ticks_usec() - start);
+    }
+
+    TEST_CASE("[jsb.bench] worker message round-trip" * doctest::skip())
+    {
+        GodotJSScriptLanguageIniter initer;
+        {
+            JSB_TESTS_EXECUTION_SCOPE(GodotJSScriptLanguage::get_singleton()->get_environment().get());
+            Benchmark::expose(GodotJSScriptLanguage::get_singleton()->get_environment().get());
+        }
+
+        Error err;
+        GodotJSScriptLanguage::get_singleton()->eval_source(R"--(
+const gd = require("godot");
+const { JSWorker } = require("godot.worker");
+const state = globalThis.bench_worker_state = { done: false };
+const num = 10000 * jsb_bench_scale;
+const worker = new JSWorker("jslibs/bench_worker");
+let count = 0;
+let start = 0;
+worker.onmessage = function (message) {
+    if (++count < num) {
+        worker.postMessage({ index: count, payload: "ping" });
+        return;
+    }
+    jsb_bench_report("worker message round-trip", num, gd.Time.get_ticks_usec() - start);
+    worker.terminate();
+    state.done = true;
+};
+start = gd.Time.get_ticks_usec();
+worker.postMessage({ index: count, payload: "ping" });
+)--", err);
+        CHECK(err == OK);
+
+        // the messages from the worker are dispatched in the main loop
+        const std::shared_ptr<Environment> env = GodotJSScriptLanguage::get_singleton()->get_environment();
+        const uint64_t deadline = OS::get_singleton()->get_ticks_msec() + 60 * 1000;
+        bool done = false;
+        while (!done && OS::get_singleton()->get_ticks_msec() < deadline)
+        {
+            env->update(0);
+            done = GodotJSScriptLanguage::get_singleton()->eval_source("bench_worker_state.done", err).to_variant();
+            CHECK(err == OK);
+        }
+        CHECK(done);
+    }
+}
+#endif
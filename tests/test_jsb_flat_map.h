@@ -0,0 +1,71 @@
+#ifndef GODOTJS_TESTS_JSB_FLAT_MAP_H
+#define GODOTJS_TESTS_JSB_FLAT_MAP_H
+
+#include "jsb_test_helpers.h"
+#include "test_jsb_sarray.h"
+
+// all internal::FlatMap test cases
+namespace jsb::tests
+{
+    TEST_CASE("[jsb.internal] FlatMap insert and erase")
+    {
+        internal::FlatMap<StringName, int> map;
+        static constexpr int kCount = 200;
+        for (int i = 0; i < kCount; ++i) { map.insert(StringName(itos(i)), i); }
+        CHECK(map.size() == kCount);
+
+        // entries are iterated in insertion order before any erase
+        int expected = 0;
+        for (const auto& it : map)
+        {
+            CHECK(it.value == expected++);
+        }
+
+        for (int i = 0; i < kCount; i += 2) { CHECK(map.erase(StringName(itos(i)))); }
+        CHECK(map.size() == kCount / 2);
+        CHECK_FALSE(map.erase(StringName("0")));
+        for (int i = 0; i < kCount; ++i)
+        {
+            const int* value = map.getptr(StringName(itos(i)));
+            if (i % 2 == 0)
+            {
+                CHECK(value == nullptr);
+            }
+            else
+            {
+                REQUIRE(value != nullptr);
+                CHECK(*value == i);
+            }
+        }
+
+        map.insert(StringName("1"), -1);
+        CHECK(map.size() == kCount / 2);
+        CHECK(map.get(StringName("1")) == -1);
+
+        map.clear();
+        CHECK(map.is_empty());
+        CHECK_FALSE(map.has(StringName("1")));
+    }
+
+    TEST_CASE("[jsb.internal] FlatMap heterogeneous lookup")
+    {
+        internal::FlatMap<StringName, int> map;
+        map.insert(StringName("_process"), 1);
+        map["_ready"] = 2;
+        CHECK(map.has(String("_process")));
+        CHECK(map.get(String("_ready")) == 2);
+        CHECK_FALSE(map.has(String("_exit_tree")));
+    }
+
+    TEST_CASE("[jsb.internal] FlatMap Movable values")
+    {
+        internal::FlatMap<StringName, Movable> map;
+        for (int i = 0; i < 20; ++i) { map.insert(StringName(itos(i)), Movable(i)); }
+        CHECK(map.erase(StringName("3")));
+        REQUIRE(map.getptr(StringName("19")) != nullptr);
+        CHECK(map.getptr(StringName("19"))->anything == 19);
+        CHECK(map.find(StringName("3")) == nullptr);
+    }
+}
+
+#endif
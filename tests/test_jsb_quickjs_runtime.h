@@ -41,6 +41,61 @@ namespace jsb::tests
         JS_FreeContext(ctx);
         JS_FreeRuntime(rt);
     }
+
+#if JSB_QUICKJS_STRUCTURED_CLONE
+    TEST_CASE("[jsb] quickjs.structured clone")
+    {
+        GodotJSScriptLanguageIniter initer;
+
+        std::shared_ptr<jsb::Environment> env = GodotJSScriptLanguage::get_singleton()->get_environment();
+        {
+            JSB_TESTS_EXECUTION_SCOPE(env.get());
+            v8::Isolate* isolate = env->get_isolate();
+            const v8::Local<v8::Context> context = env->get_context();
+            JSContext* ctx = isolate->ctx();
+
+            constexpr char source[] = R"--(
+const shared = { name: "shared" };
+const value = { i: -7, f: 2.5, s: "latin1", w: "\u4e2d\u6587", n: null, u: undefined, b: true,
+    list: [1, shared, shared, [2, 3]], view: new Uint16Array([1, 2, 65535]), bytes: new Uint8Array([9, 8]).buffer,
+    date: new Date(1000), map: new Map([["k", 1]]) };
+value.self = value;
+value;
+)--";
+            const JSValue source_value = JS_Eval(ctx, source, sizeof(source) - 1, "<test>", JS_EVAL_TYPE_GLOBAL);
+            REQUIRE(!JS_IsException(source_value));
+            const v8::Local<v8::Value> value(v8::Data(isolate, isolate->push_steal(source_value)));
+
+            v8::ValueSerializer serializer(isolate);
+            serializer.WriteHeader();
+            CHECK(serializer.WriteValue(context, value).IsJust());
+            const std::pair<uint8_t*, size_t> data = serializer.Release();
+            REQUIRE(data.first);
+            const Buffer buffer = Buffer::steal(data.first, data.second);
+
+            v8::ValueDeserializer deserializer(isolate, buffer.ptr(), buffer.size());
+            bool ok;
+            CHECK((deserializer.ReadHeader(context).To(&ok) && ok));
+            v8::Local<v8::Value> cloned;
+            REQUIRE(deserializer.ReadValue(context).ToLocal(&cloned));
+
+            const JSValue global = JS_GetGlobalObject(ctx);
+            JS_SetPropertyStr(ctx, global, "cloned", JS_DupValue(ctx, (JSValue) cloned));
+            JS_FreeValue(ctx, global);
+
+            constexpr char check[] = R"--(
+cloned.self === cloned && cloned.i === -7 && cloned.f === 2.5 && cloned.s === "latin1" && cloned.w === "\u4e2d\u6587"
+    && cloned.n === null && "u" in cloned && cloned.u === undefined && cloned.b === true
+    && cloned.list[1] === cloned.list[2] && cloned.list[1].name === "shared" && cloned.list[3][1] === 3
+    && cloned.view instanceof Uint16Array && cloned.view[2] === 65535 && new Uint8Array(cloned.bytes)[1] === 8
+    && cloned.date.getTime() === 1000 && cloned.map.get("k") === 1
+)--";
+            const JSValue result = JS_Eval(ctx, check, sizeof(check) - 1, "<test>", JS_EVAL_TYPE_GLOBAL);
+            CHECK(JS_ToBool(ctx, result) == 1);
+            JS_FreeValue(ctx, result);
+        }
+    }
+#endif
 }
 #endif
 
@@ -123,6 +123,24 @@ namespace jsb::tests
             sarray.clear();
         }
     }
+
+    TEST_CASE("[jsb.internal] SArray chunked stable address")
+    {
+        internal::SArray<Movable, internal::Index64, internal::ChunkedAllocator<16>> sarray;
+        CHECK(sarray.capacity() == 16);
+        const internal::Index64 first = sarray.add(1);
+        const Movable* address = &sarray.get_value(first);
+        {
+            // growing while holding a scoped pointer is allowed
+            const auto ptr = sarray.get_value_scoped(first);
+            for (int i = 2; i <= 40; ++i) { sarray.add(i); }
+        }
+        CHECK(sarray.capacity() == 48);
+        CHECK(sarray.size() == 40);
+        CHECK(&sarray.get_value(first) == address);
+        CHECK(sarray.get_value(first).anything == 1);
+        CHECK(sarray.get_last_value().anything == 40);
+    }
 }
 
 #endif
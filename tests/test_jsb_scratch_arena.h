@@ -0,0 +1,55 @@
+#ifndef GODOTJS_TESTS_JSB_SCRATCH_ARENA_H
+#define GODOTJS_TESTS_JSB_SCRATCH_ARENA_H
+
+#include "jsb_test_helpers.h"
+
+// all internal::ScratchArena test cases
+namespace jsb::tests
+{
+    TEST_CASE("[jsb.internal] ScratchArena nested scopes")
+    {
+        internal::ScratchArena& arena = internal::ScratchArena::get();
+        const internal::ScratchArena::Marker begin = arena.mark();
+        {
+            internal::ScratchArena::Scope outer;
+            int* a = outer.alloc<int>(4);
+            REQUIRE(a != nullptr);
+            CHECK((uintptr_t) a % internal::ScratchArena::kAlignment == 0);
+            for (int i = 0; i < 4; ++i) a[i] = i;
+            {
+                internal::ScratchArena::Scope inner;
+                int* b = inner.alloc<int>(4);
+                CHECK(b != a);
+                for (int i = 0; i < 4; ++i) b[i] = -1;
+            }
+            // the memory of the outer scope is untouched by the inner one
+            for (int i = 0; i < 4; ++i) CHECK(a[i] == i);
+            CHECK(outer.alloc<int>(0) == nullptr);
+        }
+        const internal::ScratchArena::Marker end = arena.mark();
+        CHECK(end.block == begin.block);
+        CHECK(end.offset == begin.offset);
+    }
+
+    TEST_CASE("[jsb.internal] ScratchArena overflow blocks are reused")
+    {
+        internal::ScratchArena& arena = internal::ScratchArena::get();
+        const size_t large = internal::ScratchArena::kInlineSize + 1;
+        {
+            internal::ScratchArena::Scope scope;
+            uint8_t* bytes = scope.alloc<uint8_t>(large);
+            REQUIRE(bytes != nullptr);
+            memset(bytes, 0xab, large);
+        }
+        const uint32_t blocks = arena.get_block_count();
+        CHECK(blocks >= 1);
+        for (int i = 0; i < 8; ++i)
+        {
+            internal::ScratchArena::Scope scope;
+            CHECK(scope.alloc<uint8_t>(large) != nullptr);
+        }
+        CHECK(arena.get_block_count() == blocks);
+    }
+}
+
+#endif
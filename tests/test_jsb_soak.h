@@ -0,0 +1,246 @@
+#ifndef GODOTJS_TESTS_JSB_SOAK_H
+#define GODOTJS_TESTS_JSB_SOAK_H
+
+#include "jsb_test_helpers.h"
+
+// the long-session soak test, it runs the representative workloads repeatedly and fails on unbounded growth of
+// the traced objects, persistent handles, variants, engine memory and the JS heap.
+// it's skipped by default, run it explicitly with:
+//     godot --test --test-case="[jsb.soak]*" --no-skip
+// the duration is given by the environment variable `JSB_SOAK_MINUTES` (1 by default), and the samples are printed as JSON lines
+// (also appended to the file given by `JSB_SOAK_OUTPUT` if set).
+namespace jsb::tests
+{
+    struct Soak
+    {
+        struct Sample
+        {
+            uint64_t time_msec;
+            int objects;
+            uint32_t persistent_objects;
+            uint32_t allocated_variants;
+            int cached_string_names;
+            uint64_t memory;
+            uint64_t heap_used;
+            uint64_t gc_count;
+            uint64_t gc_time_usec;
+        };
+
+        static int64_t get_env_int(const char* p_name, int64_t p_default)
+        {
+            const String value = OS::get_singleton()->get_environment(p_name);
+            return value.is_valid_int() ? MAX(value.to_int(), (int64_t) 1) : p_default;
+        }
+
+        static Sample sample(Environment* p_env, uint64_t p_start_msec)
+        {
+            Statistics stats;
+            p_env->get_statistics(stats);
+
+            Sample sample = {};
+            sample.time_msec = OS::get_singleton()->get_ticks_msec() - p_start_msec;
+            sample.objects = stats.objects;
+            sample.persistent_objects = stats.persistent_objects;
+            sample.allocated_variants = stats.allocated_variants;
+            sample.cached_string_names = stats.cached_string_names;
+            sample.memory = Memory::get_mem_usage();
+            sample.gc_count = stats.counters.gc_count;
+            sample.gc_time_usec = stats.counters.gc_time_usec;
+            for (const impl::CustomField& field : stats.custom_fields)
+            {
+                // v8
+                if (field.name == "heap_size" && field.type == impl::CustomField::TYPE_UINT_CAP)
+                {
+                    sample.heap_used = field.u.u64_cap[0];
+                    break;
+                }
+                // quickjs
+                if (field.name == "memory_used_size" && field.type == impl::CustomField::TYPE_INT_VALUE)
+                {
+                    sample.heap_used = (uint64_t) MAX(field.u.i64, (int64_t) 0);
+                    break;
+                }
+            }
+            return sample;
+        }
+
+        static void add_record(const Dictionary& p_record)
+        {
+            const String line = JSON::stringify(p_record, "", false);
+            MESSAGE("[jsb.soak] ", line);
+
+            const String path = OS::get_singleton()->get_environment("JSB_SOAK_OUTPUT");
+            if (path.is_empty()) return;
+            const Ref<FileAccess> file = FileAccess::open(path, FileAccess::exists(path) ? FileAccess::READ_WRITE : FileAccess::WRITE);
+            CHECK(file.is_valid());
+            file->seek_end();
+            file->store_line(line);
+        }
+
+        static void add_sample(const Sample& p_sample, const Sample* p_previous)
+        {
+            Dictionary record;
+            record["time_msec"] = p_sample.time_msec;
+            record["objects"] = p_sample.objects;
+            record["persistent_objects"] = p_sample.persistent_objects;
+            record["allocated_variants"] = p_sample.allocated_variants;
+            record["cached_string_names"] = p_sample.cached_string_names;
+            record["memory"] = p_sample.memory;
+            record["heap_used"] = p_sample.heap_used;
+            if (p_previous)
+            {
+                const uint64_t gc_count = p_sample.gc_count - p_previous->gc_count;
+                record["gc_count"] = gc_count;
+                record["gc_pause_usec"] = gc_count ? (p_sample.gc_time_usec - p_previous->gc_time_usec) / gc_count : 0;
+            }
+            add_record(record);
+        }
+
+        // the average of a field in [p_from, p_to)
+        template<typename TGetter>
+        static double average(const LocalVector<Sample>& p_samples, uint32_t p_from, uint32_t p_to, TGetter p_getter)
+        {
+            double sum = 0;
+            for (uint32_t index = p_from; index < p_to; ++index) sum += (double) p_getter(p_samples[index]);
+            return p_to > p_from ? sum / (double) (p_to - p_from) : 0;
+        }
+
+        // compare the second quarter (after warmup) with the last quarter
+        template<typename TGetter>
+        static void check_growth(const LocalVector<Sample>& p_samples, const char* p_name, double p_slack, TGetter p_getter)
+        {
+            const uint32_t quarter = p_samples.size() / 4;
+            const double baseline = average(p_samples, quarter, quarter * 2, p_getter);
+            const double last = average(p_samples, p_samples.size() - quarter, p_samples.size(), p_getter);
+            INFO(p_name, ": ", baseline, " => ", last);
+            CHECK(last <= baseline * 1.1 + p_slack);
+        }
+
+        static void report_gc_pauses(const LocalVector<Sample>& p_samples)
+        {
+            // the average pause of each interval (the pauses are only accumulated by the runtime)
+            LocalVector<uint64_t> pauses;
+            for (uint32_t index = 1; index < p_samples.size(); ++index)
+            {
+                const uint64_t gc_count = p_samples[index].gc_count - p_samples[index - 1].gc_count;
+                if (gc_count) pauses.push_back((p_samples[index].gc_time_usec - p_samples[index - 1].gc_time_usec) / gc_count);
+            }
+            if (pauses.is_empty()) return;
+            pauses.sort();
+
+            Dictionary record;
+            record["gc_pause_p50_usec"] = pauses[pauses.size() / 2];
+            record["gc_pause_p99_usec"] = pauses[MIN(pauses.size() - 1, pauses.size() * 99 / 100)];
+            record["gc_pause_max_usec"] = pauses[pauses.size() - 1];
+            add_record(record);
+        }
+    };
+
+    TEST_CASE("[jsb.soak] long session" * doctest::skip())
+    {
+        GodotJSScriptLanguageIniter initer;
+        const std::shared_ptr<Environment> env = GodotJSScriptLanguage::get_singleton()->get_environment();
+
+        // a module rewritten and reloaded periodically (hot reload cycles, only reloadable in editor builds)
+        const String reload_dir = "./.godot/GodotJS/jsb_soak";
+        const String reload_path = reload_dir.path_join("reload.js");
+        const auto write_reload_module = [&](uint64_t p_revision)
+        {
+            const Ref<FileAccess> file = FileAccess::open(reload_path, FileAccess::WRITE);
+            CHECK(file.is_valid());
+            file->store_string(jsb_format("\"use strict\";\nObject.defineProperty(exports, \"__esModule\", { value: true });\nexports.revision = %d;\nexports.payload = new Array(256).fill(%d);\n", p_revision, p_revision));
+        };
+        CHECK(DirAccess::make_dir_recursive_absolute(reload_dir) == OK);
+        write_reload_module(0);
+
+        Error err;
+        GodotJSScriptLanguage::get_singleton()->eval_source(R"--(
+const gd = require("godot");
+const { JSWorker } = require("godot.worker");
+const mod = require("test_01");
+const state = globalThis.soak_state = { worker_replies: 0, timer_fires: 0, signals: 0 };
+const worker = new JSWorker("jslibs/soak_worker");
+worker.onmessage = function (message) { ++state.worker_replies; };
+const receiver = new gd.Object();
+receiver.add_user_signal("soak_signal");
+
+globalThis.soak_tick = function (tick) {
+    // node churn with scripts
+    const root = new gd.Node();
+    for (let i = 0; i < 32; ++i) {
+        const child = new mod.default();
+        child.name = `node_${(tick * 32 + i) % 4096}`;
+        root.add_child(child);
+    }
+    root.free();
+
+    // signal connect/disconnect
+    const callable = gd.Callable.create(() => { ++state.signals; });
+    receiver.connect("soak_signal", callable);
+    receiver.emit_signal("soak_signal");
+    receiver.disconnect("soak_signal", callable);
+
+    // primitive temporaries
+    let v = new gd.Vector3(1, 0, 0);
+    for (let i = 0; i < 256; ++i) v = v.cross(new gd.Vector3(0, 1, i)).normalized();
+    gd.GArray.create([v, `s_${tick % 1024}`, new gd.Color(1, 0, 0, 1), gd.GDictionary.create({ tick })]);
+
+    // timers and worker messages
+    setTimeout(() => { ++state.timer_fires; }, 0);
+    worker.postMessage({ tick, payload: [1, 2, 3] });
+
+    require("jsb_soak/reload");
+};
+globalThis.soak_finish = function () {
+    worker.terminate();
+    receiver.free();
+    return state.worker_replies > 0 && state.timer_fires > 0 && state.signals > 0;
+};
+)--", err);
+        CHECK(err == OK);
+
+        const uint64_t start_msec = OS::get_singleton()->get_ticks_msec();
+        const uint64_t duration_msec = Soak::get_env_int("JSB_SOAK_MINUTES", 1) * 60 * 1000;
+        const uint64_t interval_msec = MAX(duration_msec / 240, (uint64_t) 250);
+        uint64_t next_sample_msec = 0;
+        uint64_t next_reload_msec = 2000;
+        uint64_t tick = 0;
+        uint64_t reloads = 0;
+        LocalVector<Soak::Sample> samples;
+        for (uint64_t elapsed = 0; elapsed < duration_msec; elapsed = OS::get_singleton()->get_ticks_msec() - start_msec)
+        {
+            GodotJSScriptLanguage::get_singleton()->eval_source(jsb_format("soak_tick(%d)", tick++), err);
+            CHECK(err == OK);
+            env->update(16);
+
+            // the modified time is only precise to seconds
+            if (elapsed >= next_reload_msec)
+            {
+                next_reload_msec = elapsed + 2000;
+                write_reload_module(++reloads);
+                JSB_TESTS_EXECUTION_SCOPE(env.get());
+                env->mark_as_reloading("jsb_soak/reload");
+            }
+
+            if (elapsed >= next_sample_msec)
+            {
+                next_sample_msec = elapsed + interval_msec;
+                samples.push_back(Soak::sample(env.get(), start_msec));
+                Soak::add_sample(samples[samples.size() - 1], samples.size() > 1 ? &samples[samples.size() - 2] : nullptr);
+            }
+        }
+        CHECK((bool) GodotJSScriptLanguage::get_singleton()->eval_source("soak_finish()", err).to_variant());
+        CHECK(err == OK);
+        MESSAGE("[jsb.soak] ", tick, " ticks, ", reloads, " reloads, ", samples.size(), " samples");
+
+        REQUIRE(samples.size() >= 8);
+        Soak::report_gc_pauses(samples);
+        Soak::check_growth(samples, "objects", 64, [](const Soak::Sample& s) { return s.objects; });
+        Soak::check_growth(samples, "persistent_objects", 64, [](const Soak::Sample& s) { return s.persistent_objects; });
+        Soak::check_growth(samples, "allocated_variants", 64, [](const Soak::Sample& s) { return s.allocated_variants; });
+        Soak::check_growth(samples, "cached_string_names", 0, [](const Soak::Sample& s) { return s.cached_string_names; });
+        Soak::check_growth(samples, "memory", 4 * 1024 * 1024, [](const Soak::Sample& s) { return s.memory; });
+        Soak::check_growth(samples, "heap_used", 4 * 1024 * 1024, [](const Soak::Sample& s) { return s.heap_used; });
+    }
+}
+#endif
@@ -1,6 +1,7 @@
 #include "jsb_editor_plugin.h"
 #include "jsb_docked_panel.h"
 #include "jsb_export_plugin.h"
+#include "../weaver/jsb_script.h"
 
 #define JSB_TYPE_ROOT "typings"
 
@@ -51,6 +52,7 @@ void GodotJSEditorPlugin::_notification(int p_what)
         connect("scene_saved", callable_mp(this, &GodotJSEditorPlugin::_on_scene_saved));
         connect("resource_saved", callable_mp(this, &GodotJSEditorPlugin::_on_resource_saved));
         EditorFileSystem::get_singleton()->connect("resources_reimported", callable_mp(this, &GodotJSEditorPlugin::_generate_imported_resource_dts));
+        EditorFileSystem::get_singleton()->connect("resources_reload", callable_mp(this, &GodotJSEditorPlugin::_on_resources_reload));
         break;
     default: break;
     }
@@ -103,9 +105,7 @@ GodotJSEditorPlugin::GodotJSEditorPlugin()
     // VSCode treats the directory containing the jsconfig.json file as the root of a javascript project, and reads type declarations from d.ts.
     add_install_file({ "godot.minimal.d.ts", "res://" JSB_TYPE_ROOT, jsb::weaver::CH_TYPESCRIPT | jsb::weaver::CH_D_TS });
     add_install_file({ "godot.mix.d.ts", "res://" JSB_TYPE_ROOT, jsb::weaver::CH_TYPESCRIPT | jsb::weaver::CH_D_TS });
-#if !JSB_WITH_WEB && !JSB_WITH_JAVASCRIPTCORE
     add_install_file({ "godot.worker.d.ts", "res://" JSB_TYPE_ROOT, jsb::weaver::CH_TYPESCRIPT | jsb::weaver::CH_D_TS });
-#endif
     add_install_file({ "jsb.editor.bundle.d.ts", "res://" JSB_TYPE_ROOT, jsb::weaver::CH_TYPESCRIPT | jsb::weaver::CH_D_TS });
     add_install_file({ "jsb.runtime.bundle.d.ts", "res://" JSB_TYPE_ROOT, jsb::weaver::CH_TYPESCRIPT | jsb::weaver::CH_D_TS });
 
@@ -479,12 +479,23 @@ void GodotJSEditorPlugin::_on_scene_saved(const String& p_path)
 
 void GodotJSEditorPlugin::_on_resource_saved(const Ref<Resource>& p_resource)
 {
+    Vector<String> paths = { p_resource->get_path() };
+    if (Object::cast_to<GodotJSScript>(p_resource.ptr()))
+    {
+        transpile_sources(paths);
+        return;
+    }
+
     if (!jsb::internal::Settings::get_autogen_resource_dts_on_save()) return;
 
-    Vector<String> paths = { p_resource->get_path() };
     generate_resource_types(paths);
 }
 
+void GodotJSEditorPlugin::_on_resources_reload(const Vector<String>& p_resources)
+{
+    transpile_sources(p_resources);
+}
+
 void GodotJSEditorPlugin::_generate_imported_resource_dts(const Vector<String>& p_resource)
 {
     if (!jsb::internal::Settings::get_autogen_resource_dts_on_save()) return;
@@ -618,6 +629,40 @@ void GodotJSEditorPlugin::generate_all_resource_types()
     generate_resource_types(paths);
 }
 
+void GodotJSEditorPlugin::transpile_sources(const Vector<String>& p_paths)
+{
+    if (!jsb::internal::Settings::is_transpile_on_change()) return;
+
+    Vector<String> sources;
+    PackedStringArray files;
+    for (const String& path : p_paths)
+    {
+        if (!path.ends_with("." JSB_TYPESCRIPT_EXT) || path.ends_with(".d." JSB_TYPESCRIPT_EXT)) continue;
+        sources.push_back(path);
+        files.push_back(jsb_format(R"--(["%s", "%s"])--", path, jsb::internal::PathUtil::convert_typescript_path(path)));
+    }
+    if (sources.is_empty()) return;
+
+    GodotJSScriptLanguage* lang = GodotJSScriptLanguage::get_singleton();
+    jsb_check(lang);
+    Error err;
+    const String code = jsb_format(R"--(require("jsb.editor.transpile").transpile_files([%s]))--", String(", ").join(files));
+    lang->eval_source(code, err).ignore();
+    ERR_FAIL_COND_MSG(err != OK, "failed to evaluate jsb.editor.transpile");
+
+    // reload the loaded scripts right away (not waiting for the file watcher), the other changed modules are checked as usual
+    for (const String& path : sources)
+    {
+        const Ref<GodotJSScript> script = ResourceCache::get_ref(path);
+        if (script.is_null() || !jsb::internal::VariantUtil::is_valid_name(script->get_module_id())) continue;
+        if (lang->get_environment()->mark_as_reloading(script->get_module_id()) == jsb::ModuleReloadResult::Requested)
+        {
+            script->reload_module_immediately();
+        }
+    }
+    lang->scan_external_changes();
+}
+
 void GodotJSEditorPlugin::load_editor_entry_module()
 {
     GodotJSScriptLanguage* lang = GodotJSScriptLanguage::get_singleton();
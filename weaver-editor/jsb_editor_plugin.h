@@ -56,6 +56,7 @@ private:
     void _on_scene_saved(const String& p_path);
     void _on_resource_saved(const Ref<Resource>& p_resource);
     void _generate_imported_resource_dts(const Vector<String>& p_resources);
+    void _on_resources_reload(const Vector<String>& p_resources);
 
 protected:
     static void _bind_methods();
@@ -78,6 +79,9 @@ protected:
     static void generate_scene_nodes_types(const Vector<String>& p_paths);
     static void generate_resource_types(const Vector<String>& p_paths);
 
+    // transpile the typescript sources (only the `.ts` files in the list) and reload the affected modules (if `transpile_on_change` is enabled)
+    static void transpile_sources(const Vector<String>& p_paths);
+
 public:
     GodotJSEditorPlugin();
     virtual ~GodotJSEditorPlugin() override;
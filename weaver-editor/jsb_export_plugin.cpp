@@ -1,6 +1,10 @@
 ﻿#include "jsb_export_plugin.h"
 
 #include "../weaver/jsb_script.h"
+#include "../internal/jsb_code_cache.h"
+#include "../internal/jsb_content_hash.h"
+
+#include "core/object/worker_thread_pool.h"
 
 #define JSB_EXPORTER_LOG(Severity, Format, ...) JSB_LOG_IMPL(JSExporter, Severity, Format, ##__VA_ARGS__)
 
@@ -26,21 +30,71 @@ PackedStringArray GodotJSExportPlugin::_get_export_features(const Ref<EditorExpo
     return {};
 }
 
+namespace
+{
+    struct PendingFile
+    {
+        String path;
+        bool code_cache = false;
+
+        // written in WorkerThreadPool
+        Vector<uint8_t> content;
+        Error err = ERR_FILE_CANT_READ;
+    };
+
+    void _read_pending_file(void* p_userdata, uint32_t p_index)
+    {
+        PendingFile& file = ((PendingFile*) p_userdata)[p_index];
+        file.content = FileAccess::get_file_as_bytes(file.path, &file.err);
+    }
+}
+
+String GodotJSExportPlugin::get_export_cache_dir()
+{
+    return jsb::internal::Settings::get_jsb_out_res_path().path_join(".exportcache");
+}
+
 void GodotJSExportPlugin::export_raw_files(const PackedStringArray &p_paths, bool p_permit_typescript)
 {
+    // in this situation, we do not call `load module` to avoid unexpected side effects
+    // (for example, it's impossible to directly load worker scripts in main env).
+    LocalVector<PendingFile> pending;
+    HashSet<String> pending_paths;
     for (const String& file_path : p_paths)
     {
-        // in this situation, we do not call `load module` to avoid unexpected side effects
-        // (for example, it's impossible to directly load worker scripts in main env).
-
+        PendingFile file;
         if (!file_path.ends_with("." JSB_TYPESCRIPT_EXT))
         {
-            export_raw_file(file_path);
+            file.path = file_path;
+            file.code_cache = jsb::internal::PathUtil::is_recognized_javascript_extension(file_path);
         }
         else if (p_permit_typescript)
         {
-            const String compiled_script_path = jsb::internal::PathUtil::convert_typescript_path(file_path);
-            export_raw_file(compiled_script_path);
+            file.path = jsb::internal::PathUtil::convert_typescript_path(file_path);
+            file.code_cache = true;
+        }
+        else
+        {
+            continue;
+        }
+        if (exported_paths_.has(file.path) || pending_paths.has(file.path)) continue;
+        pending_paths.insert(file.path);
+        pending.push_back(file);
+    }
+    if (pending.is_empty()) return;
+
+    // reading (and hashing) is done in parallel, `add_file` is not thread-safe
+    WorkerThreadPool* pool = WorkerThreadPool::get_singleton();
+    const WorkerThreadPool::GroupID group_id = pool->add_native_group_task(&_read_pending_file, pending.ptr(), (int) pending.size(), -1, true, "jsb: read exported files");
+    pool->wait_for_group_task_completion(group_id);
+
+    for (const PendingFile& file : pending)
+    {
+        if (file.err != OK) continue;
+        const Vector<uint8_t> content = export_raw_content(file.path, file.content);
+        if (file.code_cache)
+        {
+            export_code_cache(file.path, content);
         }
     }
 }
@@ -72,9 +126,13 @@ void GodotJSExportPlugin::get_script_resources(const String &p_dir, Vector<Strin
         {
             get_script_resources(path, r_list);
         }
-        else if (ResourceLoader::get_resource_type(path) == jsb_typename(GodotJSScript) && !get_ignored_paths().has(path))
+        // only ask the resource loaders for the files which can be scripts
+        else if (jsb::internal::PathUtil::is_recognized_javascript_extension(path) || path.ends_with("." JSB_TYPESCRIPT_EXT))
         {
-            r_list.push_back(path);
+            if (ResourceLoader::get_resource_type(path) == jsb_typename(GodotJSScript) && !get_ignored_paths().has(path))
+            {
+                r_list.push_back(path);
+            }
         }
 
         filename = dir->get_next();
@@ -88,6 +146,14 @@ void GodotJSExportPlugin::_export_begin(const HashSet<String>& p_features, bool
 {
     JSB_EXPORTER_LOG(Verbose, "export_begin path: %s", p_path);
     exported_paths_.clear();
+    minified_source_maps_.clear();
+    minifier_command_ = jsb::internal::Settings::get_packaging_minifier_command();
+
+    // all modules must be collected in `_export_begin` if they're packed into the module archive (or the metadata of them is needed),
+    // since the files added after it are packed immediately.
+    archiving_ = jsb::internal::Settings::is_packaging_module_archive();
+    collecting_metadata_ = jsb::internal::Settings::is_deferred_script_loading();
+    tree_shaking_ = jsb::internal::Settings::is_packaging_tree_shaking();
 
     // add all explicitly included file paths in settings
     const PackedStringArray file_paths = jsb::internal::Settings::get_packaging_include_files();
@@ -101,33 +167,295 @@ void GodotJSExportPlugin::_export_begin(const HashSet<String>& p_features, bool
         get_script_resources(dir_path, script_paths);
         export_raw_files(script_paths, true);
     }
+
+    if (tree_shaking_)
+    {
+        export_reachable_scripts();
+    }
+    else if (archiving_ || collecting_metadata_)
+    {
+        export_all_scripts();
+    }
+
+    if (collecting_metadata_)
+    {
+        collecting_metadata_ = false;
+        const String metadata_path = jsb::ScriptMetadataCache::get_packaged_path();
+        add_file(metadata_path, script_metadata_.to_json().to_utf8_buffer(), false);
+        JSB_EXPORTER_LOG(Verbose, "include script class metadata: %s (%d classes)", metadata_path, script_metadata_.size());
+        script_metadata_ = {};
+    }
+
+    if (archiving_)
+    {
+        archiving_ = false;
+        if (archive_writer_.size() != 0)
+        {
+            const String archive_path = jsb::internal::ModuleArchive::get_packaged_path();
+            add_file(archive_path, archive_writer_.finish(), false);
+            JSB_EXPORTER_LOG(Verbose, "include module archive: %s (%d files)", archive_path, archive_writer_.size());
+        }
+        archive_writer_ = {};
+    }
+}
+
+// export all scripts in advance (instead of in `_export_file`) along with their dependencies
+void GodotJSExportPlugin::export_all_scripts()
+{
+    Vector<String> script_paths;
+    get_script_resources("res://", script_paths);
+    for (const String& script_path : script_paths)
+    {
+        if (script_path.ends_with("." JSB_TYPESCRIPT_EXT) && !script_path.ends_with("." JSB_DTS_EXT) && !script_path.begins_with("res://node_modules/"))
+        {
+            export_compiled_script(jsb::internal::PathUtil::convert_typescript_path(script_path));
+        }
+    }
+}
+
+void GodotJSExportPlugin::get_tree_shaking_roots(EditorFileSystemDirectory* p_dir, HashSet<String>& r_roots)
+{
+    for (int i = 0, n = p_dir->get_file_count(); i < n; ++i)
+    {
+        // the dependencies of scripts are resolved by loading the modules (instead of the resource dependencies)
+        if (p_dir->get_file_type(i) == jsb_typename(GodotJSScript)) continue;
+        for (const String& dep : p_dir->get_file_deps(i))
+        {
+            if (dep.ends_with("." JSB_TYPESCRIPT_EXT) || jsb::internal::PathUtil::is_recognized_javascript_extension(dep))
+            {
+                r_roots.insert(dep);
+            }
+        }
+    }
+    for (int i = 0, n = p_dir->get_subdir_count(); i < n; ++i)
+    {
+        get_tree_shaking_roots(p_dir->get_subdir(i), r_roots);
+    }
 }
 
-bool GodotJSExportPlugin::export_raw_file(const String& p_path)
+void GodotJSExportPlugin::export_reachable_scripts()
+{
+    HashSet<String> roots;
+    get_tree_shaking_roots(EditorFileSystem::get_singleton()->get_filesystem(), roots);
+    for (const KeyValue<StringName, ProjectSettings::AutoloadInfo>& it : ProjectSettings::get_singleton()->get_autoload_list())
+    {
+        roots.insert(it.value.path);
+    }
+    if (const String entry_script_path = jsb::internal::Settings::get_entry_script_path(); !entry_script_path.is_empty())
+    {
+        roots.insert(entry_script_path);
+    }
+    for (const String& module_id : jsb::internal::Settings::get_startup_prefetch_modules())
+    {
+        roots.insert(module_id);
+    }
+
+    // the dependencies are exported along with the modules (see `export_compiled_script`)
+    for (const String& root : roots)
+    {
+        if (root.ends_with("." JSB_DTS_EXT) || get_ignored_paths().has(root)) continue;
+        export_compiled_script(root.begins_with("res://") ? jsb::internal::PathUtil::convert_typescript_path(root) : root);
+    }
+    JSB_EXPORTER_LOG(Verbose, "tree shaking: %d roots, %d files exported", roots.size(), exported_paths_.size());
+}
+
+bool GodotJSExportPlugin::export_raw_file(const String& p_path, Vector<uint8_t>* r_content)
 {
     if (exported_paths_.has(p_path))
     {
         return true;
     }
-    Error err;
-    const Vector<uint8_t> content = FileAccess::get_file_as_bytes(p_path, &err);
-    if (err != OK)
+    Vector<uint8_t> content;
+    if (const HashMap<String, Vector<uint8_t>>::Iterator it = minified_source_maps_.find(p_path))
     {
-        return false;
+        // the source map generated by tsc doesn't match the minified script
+        content = it->value;
+        if (content.is_empty())
+        {
+            return false;
+        }
     }
+    else
+    {
+        Error err;
+        content = FileAccess::get_file_as_bytes(p_path, &err);
+        if (err != OK)
+        {
+            return false;
+        }
+    }
+    content = export_raw_content(p_path, content);
+    if (r_content)
+    {
+        *r_content = content;
+    }
+    return true;
+}
+
+Vector<uint8_t> GodotJSExportPlugin::export_raw_content(const String& p_path, const Vector<uint8_t>& p_content)
+{
+    jsb_check(!exported_paths_.has(p_path));
     exported_paths_.insert(p_path);
+
+    Vector<uint8_t> content = p_content;
+    if (!minifier_command_.is_empty() && jsb::internal::PathUtil::is_recognized_javascript_extension(p_path))
+    {
+        Vector<uint8_t> source_map;
+        if (minify_script(p_path, content, source_map))
+        {
+            minified_source_maps_.insert(p_path + ".map", source_map);
+            JSB_EXPORTER_LOG(Verbose, "minified: %s (%d => %d bytes)", p_path, p_content.size(), content.size());
+        }
+    }
+    if (archiving_ && (jsb::internal::PathUtil::is_recognized_javascript_extension(p_path) || p_path.ends_with("." JSB_JSON_EXT)))
+    {
+        archive_writer_.add_file(p_path, content);
+        JSB_EXPORTER_LOG(Verbose, "include raw (archived): %s", p_path);
+        return content;
+    }
     add_file(p_path, content, false);
     JSB_EXPORTER_LOG(Verbose, "include raw: %s", p_path);
+    return content;
+}
+
+bool GodotJSExportPlugin::minify_script(const String& p_path, Vector<uint8_t>& r_content, Vector<uint8_t>& r_source_map)
+{
+    if (minifier_command_.is_empty() || r_content.is_empty())
+    {
+        return false;
+    }
+
+    // the output is determined by the command, the source and the source map of it,
+    // reuse the one generated in a previous export if nothing of them changed
+    const String source_map_path = p_path + ".map";
+    const Vector<uint8_t> source_map = FileAccess::exists(source_map_path) ? FileAccess::get_file_as_bytes(source_map_path) : Vector<uint8_t>();
+    const CharString command_utf8 = String("\n").join(minifier_command_).utf8();
+    uint64_t hash = jsb::internal::ContentHash::compute((const uint8_t*) command_utf8.get_data(), command_utf8.length());
+    hash = jsb::internal::ContentHash::compute(r_content.ptr(), r_content.size(), hash);
+    hash = jsb::internal::ContentHash::compute(source_map.ptr(), source_map.size(), hash);
+    const String output_path = get_export_cache_dir().path_join(jsb_format("%s.min.js", String::num_uint64(hash, 16)));
+    const String output_map_path = output_path + ".map";
+
+    if (!FileAccess::exists(output_path))
+    {
+        DirAccess::make_dir_recursive_absolute(get_export_cache_dir());
+        ProjectSettings* settings = ProjectSettings::get_singleton();
+        const String input_abs = settings->globalize_path(p_path);
+        const String input_map_abs = settings->globalize_path(source_map_path);
+        const String output_abs = settings->globalize_path(output_path);
+
+        String program;
+        List<String> arguments;
+        for (int index = 0, num = minifier_command_.size(); index < num; ++index)
+        {
+            const String argument = minifier_command_[index]
+                .replace("{input}", input_abs)
+                .replace("{input_map}", input_map_abs)
+                .replace("{output}", output_abs);
+            if (index == 0) program = argument;
+            else arguments.push_back(argument);
+        }
+
+        String output;
+        int exit_code = -1;
+        const Error err = OS::get_singleton()->execute(program, arguments, &output, &exit_code, true);
+        if (err != OK || exit_code != 0 || !FileAccess::exists(output_path))
+        {
+            JSB_EXPORTER_LOG(Warning, "failed to minify %s (exit code %d): %s", p_path, exit_code, output);
+            if (FileAccess::exists(output_path))
+            {
+                DirAccess::remove_absolute(output_abs);
+            }
+            return false;
+        }
+    }
+    else
+    {
+        JSB_EXPORTER_LOG(Verbose, "reuse minified: %s", output_path);
+    }
+
+    const Vector<uint8_t> minified = FileAccess::get_file_as_bytes(output_path);
+    if (minified.is_empty())
+    {
+        return false;
+    }
+    r_content = minified;
+
+    // the minifier is expected to write the source map (mapped to the original sources) at `{output}.map`
+    r_source_map = FileAccess::exists(output_map_path) ? FileAccess::get_file_as_bytes(output_map_path) : Vector<uint8_t>();
     return true;
 }
 
+void GodotJSExportPlugin::export_code_cache(const String& p_path, const Vector<uint8_t>& p_content)
+{
+#if JSB_WITH_CODE_CACHE
+    if (!jsb::internal::Settings::is_packaging_precompiled_code_cache())
+    {
+        return;
+    }
+    const String cache_path = jsb::internal::CodeCache::get_cache_path(p_path);
+    if (exported_paths_.has(cache_path))
+    {
+        return;
+    }
+
+    // the source is still needed, it identifies the revision of the code cache (and it's the fallback if the code cache is rejected)
+    const Vector<uint8_t> source = p_content.is_empty() ? FileAccess::get_file_as_bytes(p_path) : p_content;
+    if (source.is_empty())
+    {
+        JSB_EXPORTER_LOG(Warning, "failed to read %s", p_path);
+        return;
+    }
+
+    // the code cache is determined by the path, the source and the runtime revision,
+    // reuse the one built in a previous export if nothing of them changed
+    const CharString path_utf8 = p_path.utf8();
+    const uint64_t path_hash = jsb::internal::ContentHash::compute((const uint8_t*) path_utf8.get_data(), path_utf8.length());
+    const String reusable_path = get_export_cache_dir().path_join(jsb_format("%s-%s.bin",
+        String::num_uint64(jsb::internal::ContentHash::compute(source.ptr(), source.size(), path_hash), 16),
+        String::num_uint64(jsb::impl::Helper::get_code_cache_version_tag(), 16)));
+
+    Vector<uint8_t> content;
+    if (FileAccess::exists(reusable_path))
+    {
+        content = FileAccess::get_file_as_bytes(reusable_path);
+    }
+    if (content.is_empty())
+    {
+        String generated_path;
+        const jsb::internal::BytesSourceReader reader(p_path, ProjectSettings::get_singleton()->globalize_path(p_path), source);
+        if (!jsb::DefaultModuleResolver::build_code_cache(env_.get(), p_path, reader, generated_path, content))
+        {
+            JSB_EXPORTER_LOG(Warning, "failed to precompile %s", p_path);
+            return;
+        }
+        jsb_check(generated_path == cache_path);
+
+        DirAccess::make_dir_recursive_absolute(get_export_cache_dir());
+        if (const Ref<FileAccess> file = FileAccess::open(reusable_path, FileAccess::WRITE); file.is_valid())
+        {
+            file->store_buffer(content.ptr(), content.size());
+        }
+    }
+    else
+    {
+        JSB_EXPORTER_LOG(Verbose, "reuse code cache: %s", reusable_path);
+    }
+    exported_paths_.insert(cache_path);
+    add_file(cache_path, content, false);
+    JSB_EXPORTER_LOG(Verbose, "include code cache: %s => %s", p_path, cache_path);
+#endif
+}
+
 bool GodotJSExportPlugin::export_module_files(const jsb::JavaScriptModule& p_module)
 {
-    if (!export_raw_file(p_module.source_info.source_filepath))
+    Vector<uint8_t> content;
+    if (!export_raw_file(p_module.source_info.source_filepath, &content))
     {
         JSB_EXPORTER_LOG(Error, "can't read JS source from %s, please ensure that 'tsc' has being executed properly.", p_module.source_info.source_filepath);
         return false;
     }
+    export_code_cache(p_module.source_info.source_filepath, content);
 
     if (jsb::internal::Settings::is_packaging_with_source_map())
     {
@@ -199,6 +527,17 @@ bool GodotJSExportPlugin::export_compiled_script(const String& p_path)
         v8::Context::Scope context_scope(context);
 
         export_module_files(*module);
+        if (collecting_metadata_)
+        {
+            if (const jsb::ScriptClassInfoPtr class_info = env_->find_script_class(module->script_class_id))
+            {
+                jsb::ScriptClassMetadata metadata;
+                metadata.js_class_name = class_info->js_class_name;
+                metadata.native_class_name = class_info->native_class_name;
+                metadata.flags = (jsb::ScriptClassFlags::Type) (class_info->flags & (jsb::ScriptClassFlags::Tool | jsb::ScriptClassFlags::Abstract));
+                script_metadata_.add(p_path, metadata);
+            }
+        }
         jsb::Environment* environment = jsb::Environment::wrap(isolate);
         const v8::Local<v8::Object> module_obj = module->module.Get(isolate);
         if (v8::Local<v8::Value> temp; module_obj->Get(context, jsb_name(environment, children)).ToLocal(&temp) && temp->IsArray())
@@ -233,7 +572,13 @@ void GodotJSExportPlugin::_export_file(const String& p_path, const String& p_typ
 {
     //TODO when exporting for web.impl, need to reorganize all scripts into a monolithic script (like webpack)? and preload it before everything get run.
 
-    if (p_path.ends_with("." JSB_TYPESCRIPT_EXT))
+    if (tree_shaking_ && p_type == jsb_typename(GodotJSScript))
+    {
+        // all reachable scripts are already exported in `_export_begin`
+        skip();
+        JSB_EXPORTER_LOG(Verbose, "export source (tree shaking): %s %s", p_path, exported_paths_.has(jsb::internal::PathUtil::convert_typescript_path(p_path)) ? "included" : "stripped");
+    }
+    else if (p_path.ends_with("." JSB_TYPESCRIPT_EXT))
     {
         const String compiled_script_path = jsb::internal::PathUtil::convert_typescript_path(p_path);
         export_compiled_script(compiled_script_path);
@@ -2,6 +2,8 @@
 #define GODOTJS_EXPORT_PLUGIN_H
 
 #include "jsb_editor_pch.h"
+#include "../internal/jsb_module_archive.h"
+#include "../weaver/jsb_script_metadata.h"
 
 namespace jsb
 {
@@ -32,11 +34,46 @@ private:
 
     bool export_compiled_script(const String& p_path);
     bool export_module_files(const jsb::JavaScriptModule& p_module);
-    bool export_raw_file(const String& p_path);
+    // `r_content` is the exported content (it's minified if the minifier is enabled)
+    bool export_raw_file(const String& p_path, Vector<uint8_t>* r_content = nullptr);
+    Vector<uint8_t> export_raw_content(const String& p_path, const Vector<uint8_t>& p_content);
+
+    // run the minifier command on a script, return false if it's not minified (`r_content` is kept as is)
+    bool minify_script(const String& p_path, Vector<uint8_t>& r_content, Vector<uint8_t>& r_source_map);
+
+    // `p_content` is the source of the module (read from `p_path` if empty)
+    void export_code_cache(const String& p_path, const Vector<uint8_t>& p_content);
+
+    // files are read in WorkerThreadPool, and added in the order of `p_paths`
     void export_raw_files(const PackedStringArray& p_paths, bool p_permit_typescript);
+    void export_all_scripts();
+
+    // collect the scripts referenced by the resources in project, the autoloads and the startup modules
+    void get_tree_shaking_roots(EditorFileSystemDirectory* p_dir, HashSet<String>& r_roots);
+    void export_reachable_scripts();
     void get_script_resources(const String &p_dir, Vector<String> &r_list);
 
+    // the precompiled code caches of previous exports, keyed by the content of sources
+    static String get_export_cache_dir();
+
     HashSet<String> exported_paths_;
+
+    // only the reachable scripts are exported (they're all exported in `_export_begin`)
+    bool tree_shaking_ = false;
+
+    // see `Settings::get_packaging_minifier_command`
+    PackedStringArray minifier_command_;
+
+    // the source maps of minified scripts (keyed by the path of the source map), exported instead of the files generated by tsc
+    HashMap<String, Vector<uint8_t>> minified_source_maps_;
+
+    // the module archive being packed (only during `_export_begin`)
+    bool archiving_ = false;
+    jsb::internal::ModuleArchive::Writer archive_writer_;
+
+    // the class metadata of exported scripts (only during `_export_begin`)
+    bool collecting_metadata_ = false;
+    jsb::ScriptMetadataCache script_metadata_;
     std::shared_ptr<jsb::Environment> env_;
 };
 
@@ -212,14 +212,14 @@ void GodotJSREPL::_generate_dts_pressed()
 
 String GodotJSREPL::encode_string(const String& p_text)
 {
-    return p_text.replace("'", "\\'");
+    return p_text.replace("\\", "\\\\").replace("'", "\\'");
 }
 
 static bool is_auto_complete_allowed(const String& p_text)
 {
 #if JSB_REPL_AUTO_COMPLETE
-    // a rough rule to allow auto-complete
-    return !p_text.is_empty() && !p_text.contains("(");
+    // a rough rule to allow auto-complete (only member chains are completed, see `auto_complete` in jsb.editor.main.ts)
+    return !p_text.is_empty() && !p_text.contains("(") && !p_text.contains("\n");
 #else
     return false;
 #endif
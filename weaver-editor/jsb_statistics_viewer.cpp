@@ -26,6 +26,34 @@ GodotJSStatisticsViewer::GodotJSStatisticsViewer()
     tree->set_hide_root(true);
 
     tree_root = tree->create_item();
+
+    HBoxContainer* tool_bar_box = memnew(HBoxContainer);
+    add_child(tool_bar_box);
+    {
+        snapshot_button = memnew(Button);
+        tool_bar_box->add_child(snapshot_button);
+        snapshot_button->set_text(TTR("Take Heap Snapshot"));
+        snapshot_button->set_tooltip_text(TTR("Count the bound objects per native class and summarize the JS heap, compared with the previous snapshot"));
+        snapshot_button->connect("pressed", callable_mp(this, &GodotJSStatisticsViewer::on_snapshot_pressed));
+    }
+    {
+        snapshot_label = memnew(Label);
+        tool_bar_box->add_child(snapshot_label);
+    }
+
+    heap_tree = memnew(Tree);
+    heap_tree->set_v_size_flags(SIZE_EXPAND_FILL);
+    heap_tree->set_h_size_flags(SIZE_EXPAND_FILL);
+    add_child(heap_tree);
+    heap_tree->set_columns(5);
+    heap_tree->set_column_titles_visible(true);
+    heap_tree->set_column_title(0, TTR("Name"));
+    heap_tree->set_column_expand(0, true);
+    heap_tree->set_column_title(1, TTR("Count"));
+    heap_tree->set_column_title(2, TTR("Size"));
+    heap_tree->set_column_title(3, TTR("Count Delta"));
+    heap_tree->set_column_title(4, TTR("Size Delta"));
+    heap_tree->set_hide_root(true);
 }
 
 GodotJSStatisticsViewer::~GodotJSStatisticsViewer()
@@ -54,12 +82,25 @@ void GodotJSStatisticsViewer::on_timer()
     {
         add_row(index++, field);
     }
-    add_row(index++, "jsb:objects", jsb_format("%d (%s)", stats.objects, String::humanize_size(stats.objects * jsb::internal::SArray<jsb::ObjectHandle>::get_slot_size())));
+    add_row(index++, "jsb:objects", jsb_format("%d (%s)", stats.objects, String::humanize_size(stats.objects * jsb::ObjectDB::get_slot_size())));
     add_row(index++, "jsb:native_classes", itos(stats.native_classes));
     add_row(index++, "jsb:script_classes", itos(stats.script_classes));
     add_row(index++, "jsb:cached_string_names", itos(stats.cached_string_names));
     add_row(index++, "jsb:persistent_objects", uitos(stats.persistent_objects));
     add_row(index++, "jsb:allocated_variants", uitos(stats.allocated_variants));
+#if JSB_BENCHMARK
+    {
+        // the native benchmark scopes (all threads, since startup)
+        LocalVector<jsb::internal::BenchmarkSite::Snapshot> snapshots;
+        jsb::internal::BenchmarkSite::collect(snapshots);
+        for (const jsb::internal::BenchmarkSite::Snapshot& snapshot : snapshots)
+        {
+            add_row(index++, String("  ").repeat(snapshot.depth) + "bench:" + snapshot.name,
+                jsb_format("%d calls, total %.2f ms, max %.2f ms, p99 %.2f ms",
+                    (int64_t) snapshot.count, (double) snapshot.total_usec / 1000.0, (double) snapshot.max_usec / 1000.0, (double) snapshot.p99_usec / 1000.0));
+        }
+    }
+#endif
     for (; index < tree_root->get_child_count(); ++index)
     {
         tree_root->get_child(index)->set_visible(false);
@@ -87,6 +128,65 @@ namespace
     }
 }
 
+void GodotJSStatisticsViewer::on_snapshot_pressed()
+{
+    const GodotJSScriptLanguage* lang = GodotJSScriptLanguage::get_singleton();
+    if (!lang) return;
+    const std::shared_ptr<jsb::Environment> env = lang->get_environment();
+    if (!env) return;
+
+    jsb::HeapSnapshot snapshot;
+    env->get_heap_snapshot(snapshot);
+
+    HashMap<String, SnapshotValue> values;
+    heap_tree->clear();
+    TreeItem* root = heap_tree->create_item();
+    {
+        TreeItem* section = heap_tree->create_item(root);
+        section->set_text(0, TTR("Bound Objects (strong)"));
+        for (const jsb::HeapSnapshot::NativeClassEntry& entry : snapshot.native_objects)
+        {
+            add_snapshot_row(section, "native:" + entry.name, jsb_format("%s (%d)", entry.name, entry.strong), entry.objects, 0, false, values);
+        }
+    }
+    if (!snapshot.js_heap.is_empty())
+    {
+        TreeItem* section = heap_tree->create_item(root);
+        section->set_text(0, TTR("JS Heap"));
+        for (const jsb::impl::HeapSummaryEntry& entry : snapshot.js_heap)
+        {
+            add_snapshot_row(section, "js:" + entry.name, entry.name, entry.count, entry.size, true, values);
+        }
+    }
+    add_snapshot_row(root, "string_names", TTR("Cached String Names"), snapshot.cached_string_names, snapshot.string_name_cache_capacity, false, values);
+
+    snapshot_label->set_text(last_snapshot_time_usec == 0
+        ? String()
+        : jsb_format(TTR("compared with the snapshot %.1f s ago"), (double) (snapshot.time_usec - last_snapshot_time_usec) / 1000000.0));
+    last_snapshot = std::move(values);
+    last_snapshot_time_usec = snapshot.time_usec;
+}
+
+void GodotJSStatisticsViewer::add_snapshot_row(TreeItem* p_parent, const String& p_key, const String& p_name, int64_t p_count, int64_t p_size, bool p_has_size, HashMap<String, SnapshotValue>& r_snapshot)
+{
+    TreeItem* item = heap_tree->create_item(p_parent);
+    item->set_text(0, p_name);
+    item->set_text(1, itos(p_count));
+    item->set_text(2, p_has_size ? String::humanize_size(p_size) : (p_size != 0 ? jsb_format("/ %d", p_size) : String()));
+    if (const SnapshotValue* last = last_snapshot.getptr(p_key))
+    {
+        const int64_t count_delta = p_count - last->count;
+        const int64_t size_delta = p_size - last->size;
+        item->set_text(3, count_delta > 0 ? "+" + itos(count_delta) : itos(count_delta));
+        if (p_has_size) item->set_text(4, size_delta > 0 ? "+" + String::humanize_size(size_delta) : size_delta < 0 ? "-" + String::humanize_size(-size_delta) : "0");
+    }
+    else if (last_snapshot_time_usec != 0)
+    {
+        item->set_text(3, TTR("(new)"));
+    }
+    r_snapshot.insert(p_key, { p_count, p_size });
+}
+
 void GodotJSStatisticsViewer::add_row(int p_index, const jsb::impl::CustomField& p_field)
 {
     switch (p_field.type)
@@ -7,6 +7,8 @@
 class Tree;
 class TreeItem;
 class Timer;
+class Button;
+class Label;
 
 class GodotJSStatisticsViewer : public VBoxContainer
 {
@@ -17,6 +19,18 @@ private:
     TreeItem* tree_root;
     Timer* timer;
 
+    // heap snapshots taken on demand, each one is compared with the previous one
+    struct SnapshotValue
+    {
+        int64_t count;
+        int64_t size;
+    };
+    Button* snapshot_button;
+    Label* snapshot_label;
+    Tree* heap_tree;
+    HashMap<String, SnapshotValue> last_snapshot;
+    uint64_t last_snapshot_time_usec = 0;
+
 public:
     GodotJSStatisticsViewer();
     virtual ~GodotJSStatisticsViewer() override;
@@ -25,6 +39,8 @@ public:
 
 private:
     void on_timer();
+    void on_snapshot_pressed();
+    void add_snapshot_row(TreeItem* p_parent, const String& p_key, const String& p_name, int64_t p_count, int64_t p_size, bool p_has_size, HashMap<String, SnapshotValue>& r_snapshot);
     void add_row(int p_index, const jsb::impl::CustomField& p_field);
     void add_row(int p_index, const String& p_name, const String& p_text);
 };
@@ -0,0 +1,351 @@
+#include "jsb_global_class_cache.h"
+#include "../internal/jsb_internal.h"
+
+namespace jsb
+{
+    namespace
+    {
+        constexpr uint32_t kGlobalClassCacheMagic = 0x43434A47; // GJCC
+        constexpr uint32_t kGlobalClassCacheVersion = 2;
+
+        // cursor over the source text (all matches are ASCII only, as `\s` and `\w` in the previous regex)
+        struct Cursor
+        {
+            const char32_t* ptr;
+            int len;
+            int pos = 0;
+
+            static jsb_force_inline bool is_space(char32_t c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f'; }
+            static jsb_force_inline bool is_word(char32_t c) { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_'; }
+
+            jsb_force_inline bool eof() const { return pos >= len; }
+            jsb_force_inline char32_t peek() const { return pos < len ? ptr[pos] : 0; }
+
+            // skip whitespaces, return the number of skipped characters
+            int skip_spaces()
+            {
+                const int start = pos;
+                while (pos < len && is_space(ptr[pos])) ++pos;
+                return pos - start;
+            }
+
+            bool match(const char* p_literal)
+            {
+                int n = 0;
+                for (; p_literal[n]; ++n)
+                {
+                    if (pos + n >= len || ptr[pos + n] != (char32_t) p_literal[n]) return false;
+                }
+                pos += n;
+                return true;
+            }
+
+            bool match_char(char32_t p_char)
+            {
+                if (peek() != p_char) return false;
+                ++pos;
+                return true;
+            }
+
+            String read_word()
+            {
+                const int start = pos;
+                while (pos < len && is_word(ptr[pos])) ++pos;
+                return String(ptr + start, pos - start);
+            }
+
+            // find the next occurrence of the literal from the current position (the cursor is placed at the beginning of it)
+            bool find(const char* p_literal)
+            {
+                const char32_t first = (char32_t) p_literal[0];
+                for (; pos < len; ++pos)
+                {
+                    if (ptr[pos] != first) continue;
+                    const int start = pos;
+                    if (match(p_literal))
+                    {
+                        pos = start;
+                        return true;
+                    }
+                }
+                return false;
+            }
+        };
+
+        // check the `@tool()` decorator right before `p_pos` (only whitespaces in between)
+        bool has_tool_decorator(const char32_t* p_ptr, int p_pos)
+        {
+            int i = p_pos - 1;
+            while (i >= 0 && Cursor::is_space(p_ptr[i])) --i;
+            if (i < 0 || p_ptr[i--] != ')') return false;
+            while (i >= 0 && Cursor::is_space(p_ptr[i])) --i;
+            if (i < 0 || p_ptr[i--] != '(') return false;
+            while (i >= 0 && Cursor::is_space(p_ptr[i])) --i;
+            if (i < 4 || p_ptr[i] != 'l' || p_ptr[i - 1] != 'o' || p_ptr[i - 2] != 'o' || (p_ptr[i - 3] != 't' && p_ptr[i - 3] != 'T')) return false;
+            return p_ptr[i - 4] == '@';
+        }
+    }
+
+    bool GlobalClassCache::scan_typescript(const String& p_source, GlobalClassInfo& r_info)
+    {
+        // [@tool()] export default class ClassName[<T>] ... extends BaseClassName (in the same line)
+        Cursor cursor { p_source.ptr(), p_source.length() };
+        while (cursor.find("export"))
+        {
+            const int export_pos = cursor.pos;
+            cursor.pos += 6;
+            if (!cursor.skip_spaces() || !cursor.match("default") || !cursor.skip_spaces() || !cursor.match("class") || !cursor.skip_spaces())
+            {
+                cursor.pos = export_pos + 1;
+                continue;
+            }
+            const String class_name = cursor.read_word();
+            if (class_name.is_empty())
+            {
+                cursor.pos = export_pos + 1;
+                continue;
+            }
+
+            const int after_name = cursor.pos;
+            cursor.skip_spaces();
+            const bool is_generic = cursor.peek() == '<';
+            cursor.pos = after_name;
+
+            // the last `extends` in the line (skip the constraints of type parameters), preceded by a whitespace or `>`, and followed by whitespaces
+            String base_type;
+            for (; !cursor.eof() && cursor.peek() != '\n'; ++cursor.pos)
+            {
+                const char32_t prev = cursor.ptr[cursor.pos - 1];
+                if (prev != '>' && !Cursor::is_space(prev)) continue;
+                const int pos = cursor.pos;
+                if (cursor.match("extends") && cursor.skip_spaces() && Cursor::is_word(cursor.peek()))
+                {
+                    base_type = cursor.read_word();
+                }
+                cursor.pos = pos;
+            }
+            if (base_type.is_empty())
+            {
+                cursor.pos = export_pos + 1;
+                continue;
+            }
+
+            r_info.class_name = class_name;
+            r_info.base_type = base_type;
+            r_info.is_generic = is_generic;
+            r_info.is_tool = has_tool_decorator(cursor.ptr, export_pos);
+            return true;
+        }
+        return false;
+    }
+
+    bool GlobalClassCache::scan_javascript(const String& p_source, GlobalClassInfo& r_info)
+    {
+        // match `exports.default = <rest>` and return the cursor at <rest>
+        const auto find_default_export = [](Cursor& p_cursor) -> bool
+        {
+            while (p_cursor.find("exports"))
+            {
+                const int start = p_cursor.pos;
+                p_cursor.pos += 7;
+                if (!p_cursor.eof()) ++p_cursor.pos; // any character between `exports` and `default`
+                if (p_cursor.match("default"))
+                {
+                    p_cursor.skip_spaces();
+                    if (p_cursor.match_char('='))
+                    {
+                        p_cursor.skip_spaces();
+                        return true;
+                    }
+                }
+                p_cursor.pos = start + 1;
+            }
+            return false;
+        };
+
+        // defined in a single line: exports.default = class ClassName extends BaseClassName
+        Cursor cursor { p_source.ptr(), p_source.length() };
+        while (find_default_export(cursor))
+        {
+            const int start = cursor.pos;
+            if (cursor.match("class"))
+            {
+                cursor.skip_spaces();
+                const String class_name = cursor.read_word();
+                if (!class_name.is_empty() && cursor.skip_spaces() && cursor.match("extends") && cursor.skip_spaces())
+                {
+                    const String base_type = cursor.read_word();
+                    if (!base_type.is_empty())
+                    {
+                        r_info.class_name = class_name;
+                        r_info.base_type = base_type;
+                        return true;
+                    }
+                }
+            }
+            cursor.pos = start;
+        }
+
+        // defined in separated lines: exports.default = ClassName + class ClassName extends BaseClassName
+        cursor.pos = 0;
+        String class_name;
+        while (class_name.is_empty())
+        {
+            if (!find_default_export(cursor)) return false;
+            class_name = cursor.read_word();
+        }
+        r_info.class_name = class_name;
+
+        cursor.pos = 0;
+        while (cursor.find("class"))
+        {
+            cursor.pos += 5;
+            const int next = cursor.pos;
+            cursor.skip_spaces();
+            if (cursor.read_word() == class_name)
+            {
+                cursor.skip_spaces();
+                if (cursor.match("extends"))
+                {
+                    cursor.skip_spaces();
+                    r_info.base_type = cursor.read_word();
+                    if (!r_info.base_type.is_empty()) break;
+                }
+            }
+            cursor.pos = next;
+        }
+        return true;
+    }
+
+    bool GlobalClassCache::read_manifest(const String& p_manifest, GlobalClassInfo& r_info)
+    {
+        const Variant json = JSON::parse_string(p_manifest);
+        if (json.get_type() != Variant::DICTIONARY) return false;
+        const Dictionary manifest = json;
+        const String class_name = manifest.get("class_name", String());
+        const String base_type = manifest.get("base_type", String());
+        if (class_name.is_empty() || base_type.is_empty()) return false;
+
+        r_info.class_name = class_name;
+        r_info.base_type = base_type;
+        r_info.icon_path = manifest.get("icon", String());
+        r_info.is_tool = manifest.get("tool", false);
+        r_info.is_abstract = manifest.get("abstract", false);
+        return true;
+    }
+
+    String GlobalClassCache::get_cache_path()
+    {
+        return internal::Settings::get_jsb_out_res_path().path_join(".global_classes.bin");
+    }
+
+    void GlobalClassCache::load()
+    {
+        loaded_ = true;
+        const Ref<FileAccess> file = FileAccess::open(get_cache_path(), FileAccess::READ);
+        if (file.is_null()) return;
+        if (file->get_32() != kGlobalClassCacheMagic || file->get_32() != kGlobalClassCacheVersion) return;
+
+        const uint32_t num = file->get_32();
+        for (uint32_t i = 0; i < num && !file->eof_reached(); ++i)
+        {
+            const String path = file->get_pascal_string();
+            Entry entry;
+            entry.time_modified = file->get_64();
+            entry.size = file->get_64();
+            entry.manifest_time_modified = file->get_64();
+            entry.info.class_name = file->get_pascal_string();
+            entry.info.base_type = file->get_pascal_string();
+            entry.info.icon_path = file->get_pascal_string();
+            const uint8_t flags = file->get_8();
+            entry.info.is_tool = flags & 1;
+            entry.info.is_generic = flags & 2;
+            entry.info.is_abstract = flags & 4;
+            entries_.insert(path, entry);
+        }
+        JSB_LOG(Verbose, "global class cache loaded (%d entries)", (int) entries_.size());
+    }
+
+    void GlobalClassCache::save()
+    {
+        MutexLock lock(mutex_);
+        if (!dirty_) return;
+        dirty_ = false;
+
+        const String path = get_cache_path();
+        const String dir = path.get_base_dir();
+        if (!DirAccess::exists(dir) && DirAccess::make_dir_recursive_absolute(dir) != OK) return;
+        const Ref<FileAccess> file = FileAccess::open(path, FileAccess::WRITE);
+        if (file.is_null()) return;
+
+        file->store_32(kGlobalClassCacheMagic);
+        file->store_32(kGlobalClassCacheVersion);
+        file->store_32((uint32_t) entries_.size());
+        for (const KeyValue<String, Entry>& it : entries_)
+        {
+            file->store_pascal_string(it.key);
+            file->store_64(it.value.time_modified);
+            file->store_64(it.value.size);
+            file->store_64(it.value.manifest_time_modified);
+            file->store_pascal_string(it.value.info.class_name);
+            file->store_pascal_string(it.value.info.base_type);
+            file->store_pascal_string(it.value.info.icon_path);
+            file->store_8((it.value.info.is_tool ? 1 : 0) | (it.value.info.is_generic ? 2 : 0) | (it.value.info.is_abstract ? 4 : 0));
+        }
+    }
+
+    GlobalClassInfo GlobalClassCache::get(const String& p_path)
+    {
+        const Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::READ);
+        if (file.is_null()) return {};
+        const uint64_t time_modified = FileAccess::get_modified_time(p_path);
+        const uint64_t size = file->get_length();
+        const bool is_javascript = internal::PathUtil::is_recognized_javascript_extension(p_path);
+
+        // the manifest is outdated if it's older than the source (written after the transpiled output)
+        String manifest_path;
+        uint64_t manifest_time_modified = 0;
+        if (!is_javascript)
+        {
+            manifest_path = internal::PathUtil::convert_typescript_path(p_path) + ".meta.json";
+            if (FileAccess::exists(manifest_path))
+            {
+                manifest_time_modified = FileAccess::get_modified_time(manifest_path);
+                if (manifest_time_modified < time_modified) manifest_time_modified = 0;
+            }
+        }
+
+        {
+            MutexLock lock(mutex_);
+            if (!loaded_) load();
+            if (const Entry* entry = entries_.getptr(p_path);
+                entry && entry->time_modified == time_modified && entry->size == size && entry->manifest_time_modified == manifest_time_modified)
+            {
+                return entry->info;
+            }
+        }
+
+        // scan outside of the lock, the file is read only if changed
+        Entry entry;
+        entry.time_modified = time_modified;
+        entry.size = size;
+        if (manifest_time_modified != 0 && read_manifest(FileAccess::get_file_as_string(manifest_path), entry.info))
+        {
+            entry.manifest_time_modified = manifest_time_modified;
+        }
+        else if (is_javascript)
+        {
+            scan_javascript(file->get_as_utf8_string(), entry.info);
+        }
+        else
+        {
+            // hope it's a typescript file
+            scan_typescript(file->get_as_utf8_string(), entry.info);
+        }
+
+        MutexLock lock(mutex_);
+        entries_.insert(p_path, entry);
+        dirty_ = true;
+        return entry.info;
+    }
+}
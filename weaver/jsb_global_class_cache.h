@@ -0,0 +1,65 @@
+#ifndef GODOTJS_GLOBAL_CLASS_CACHE_H
+#define GODOTJS_GLOBAL_CLASS_CACHE_H
+#include "../compat/jsb_compat.h"
+#include "../internal/jsb_macros.h"
+
+namespace jsb
+{
+    // the global class declared in a script source
+    struct GlobalClassInfo
+    {
+        String class_name;
+        String base_type;
+        // only available from the manifest generated by the editor transpiler (`<output>.js.meta.json`)
+        String icon_path;
+        bool is_tool = false;
+        bool is_generic = false;
+        bool is_abstract = false;
+    };
+
+    /**
+     * The results of scanning the global classes in script sources (keyed by the path, invalidated by time modified and size).
+     * EditorFileSystem queries every script on each scan, the sources are only read again if they changed.
+     * For typescript sources, the static manifest written by the editor transpiler is preferred if it's not older than the source,
+     * the textual scan is only the fallback (not transpiled yet, or transpiled by a plain `tsc` without the manifest transformer).
+     * The cache is persisted in the project data dir.
+     */
+    class GlobalClassCache
+    {
+        struct Entry
+        {
+            uint64_t time_modified = 0;
+            uint64_t size = 0;
+            // time modified of the manifest read, 0 if scanned from the source
+            uint64_t manifest_time_modified = 0;
+            GlobalClassInfo info;
+        };
+
+        Mutex mutex_;
+        HashMap<String, Entry> entries_;
+        bool loaded_ = false;
+        bool dirty_ = false;
+
+        static String get_cache_path();
+        void load();
+
+    public:
+        // (thread-safe) scan the global class in the script (read from the cache if the file is not changed)
+        GlobalClassInfo get(const String& p_path);
+
+        // write the cache file if anything changed
+        void save();
+
+        /**
+         * single-pass scanners of the class declarations (see comments in `GodotJSScriptLanguage::get_global_class_name` for the rules)
+         * \return true if a class declaration is found
+         */
+        static bool scan_typescript(const String& p_source, GlobalClassInfo& r_info);
+        static bool scan_javascript(const String& p_source, GlobalClassInfo& r_info);
+
+        // read the class info from the json manifest (see `ScriptClassManifest` in jsb.editor.transpile.ts)
+        static bool read_manifest(const String& p_manifest, GlobalClassInfo& r_info);
+    };
+}
+
+#endif
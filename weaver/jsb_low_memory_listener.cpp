@@ -0,0 +1,11 @@
+#include "jsb_low_memory_listener.h"
+#include "../bridge/jsb_environment.h"
+
+void GodotJSLowMemoryListener::_notification(int p_what)
+{
+    if (p_what == NOTIFICATION_OS_MEMORY_WARNING)
+    {
+        JSB_LOG(Warning, "received a memory warning from the OS");
+        jsb::Environment::low_memory();
+    }
+}
@@ -0,0 +1,15 @@
+#ifndef GODOTJS_LOW_MEMORY_LISTENER_H
+#define GODOTJS_LOW_MEMORY_LISTENER_H
+#include "../compat/jsb_compat.h"
+
+// an internal node under the root of SceneTree, `NOTIFICATION_OS_MEMORY_WARNING` is only propagated to the nodes in the tree.
+// all environments (workers included) trim their memory on the warning (see jsb::Environment::low_memory)
+class GodotJSLowMemoryListener : public Node
+{
+    GDCLASS(GodotJSLowMemoryListener, Node)
+
+protected:
+    void _notification(int p_what);
+};
+
+#endif
@@ -16,6 +16,13 @@
         return stats_.MonitorName;\
     }
 
+#define JSB_DEFINE_RATE_MONITOR(CounterName) \
+    Variant GodotJSMonitor::get_value_ ## CounterName ## _per_frame()\
+    {\
+        flush();\
+        return rates_.CounterName;\
+    }
+
 #define JSB_DEFINE_CUSTOM_MONITOR(MonitorName, Accessor) \
     Variant GodotJSMonitor::get_value_ ## MonitorName()\
     {\
@@ -31,6 +38,16 @@ GodotJSMonitor::GodotJSMonitor()
     JSB_NEW_MONITOR(cached_string_names);
     JSB_NEW_MONITOR(persistent_objects);
     JSB_NEW_MONITOR(allocated_variants);
+    JSB_NEW_MONITOR(variant_allocs_per_frame);
+    JSB_NEW_MONITOR(variant_frees_per_frame);
+    JSB_NEW_MONITOR(valuetype_bindings_per_frame);
+    JSB_NEW_MONITOR(object_bindings_per_frame);
+    JSB_NEW_MONITOR(gc_count_per_frame);
+    JSB_NEW_MONITOR(gc_time_usec_per_frame);
+    JSB_NEW_MONITOR(string_name_hits_per_frame);
+    JSB_NEW_MONITOR(string_name_misses_per_frame);
+    JSB_NEW_MONITOR(string_name_evictions_per_frame);
+    JSB_NEW_MONITOR(microtask_time_usec_per_frame);
 #if JSB_WITH_V8
     JSB_NEW_MONITOR(heap_size);
 #elif JSB_WITH_QUICKJS
@@ -46,6 +63,16 @@ void GodotJSMonitor::_bind_methods()
     JSB_BIND_MONITOR(cached_string_names);
     JSB_BIND_MONITOR(persistent_objects);
     JSB_BIND_MONITOR(allocated_variants);
+    JSB_BIND_MONITOR(variant_allocs_per_frame);
+    JSB_BIND_MONITOR(variant_frees_per_frame);
+    JSB_BIND_MONITOR(valuetype_bindings_per_frame);
+    JSB_BIND_MONITOR(object_bindings_per_frame);
+    JSB_BIND_MONITOR(gc_count_per_frame);
+    JSB_BIND_MONITOR(gc_time_usec_per_frame);
+    JSB_BIND_MONITOR(string_name_hits_per_frame);
+    JSB_BIND_MONITOR(string_name_misses_per_frame);
+    JSB_BIND_MONITOR(string_name_evictions_per_frame);
+    JSB_BIND_MONITOR(microtask_time_usec_per_frame);
 #if JSB_WITH_V8
     JSB_BIND_MONITOR(heap_size);
 #elif JSB_WITH_QUICKJS
@@ -59,6 +86,16 @@ JSB_DEFINE_MONITOR(script_classes);
 JSB_DEFINE_MONITOR(cached_string_names);
 JSB_DEFINE_MONITOR(persistent_objects);
 JSB_DEFINE_MONITOR(allocated_variants);
+JSB_DEFINE_RATE_MONITOR(variant_allocs);
+JSB_DEFINE_RATE_MONITOR(variant_frees);
+JSB_DEFINE_RATE_MONITOR(valuetype_bindings);
+JSB_DEFINE_RATE_MONITOR(object_bindings);
+JSB_DEFINE_RATE_MONITOR(gc_count);
+JSB_DEFINE_RATE_MONITOR(gc_time_usec);
+JSB_DEFINE_RATE_MONITOR(string_name_hits);
+JSB_DEFINE_RATE_MONITOR(string_name_misses);
+JSB_DEFINE_RATE_MONITOR(string_name_evictions);
+JSB_DEFINE_RATE_MONITOR(microtask_time_usec);
 
 #if JSB_WITH_V8
     JSB_DEFINE_CUSTOM_MONITOR(heap_size, u.u64_cap[0]);
@@ -88,4 +125,25 @@ void GodotJSMonitor::flush()
     const std::shared_ptr<jsb::Environment> env = lang->get_environment();
     if (!env) return;
     env->get_statistics(stats_);
+
+    // the counters are accumulated since the environment created, convert them into per-frame rates
+    const uint64_t frame = Engine::get_singleton()->get_process_frames();
+    const jsb::StatisticsCounters& counters = stats_.counters;
+    // the counters go backwards if the environment is recreated (e.g. reloading), skip the rates once in this case
+    if (frame > last_flush_frame_ && counters.object_bindings >= last_counters_.object_bindings)
+    {
+        const double frames = (double) (frame - last_flush_frame_);
+        rates_.variant_allocs = (double) (counters.variant_allocs - last_counters_.variant_allocs) / frames;
+        rates_.variant_frees = (double) (counters.variant_frees - last_counters_.variant_frees) / frames;
+        rates_.valuetype_bindings = (double) (counters.valuetype_bindings - last_counters_.valuetype_bindings) / frames;
+        rates_.object_bindings = (double) (counters.object_bindings - last_counters_.object_bindings) / frames;
+        rates_.gc_count = (double) (counters.gc_count - last_counters_.gc_count) / frames;
+        rates_.gc_time_usec = (double) (counters.gc_time_usec - last_counters_.gc_time_usec) / frames;
+        rates_.string_name_hits = (double) (counters.string_name_hits - last_counters_.string_name_hits) / frames;
+        rates_.string_name_misses = (double) (counters.string_name_misses - last_counters_.string_name_misses) / frames;
+        rates_.string_name_evictions = (double) (counters.string_name_evictions - last_counters_.string_name_evictions) / frames;
+        rates_.microtask_time_usec = (double) (counters.microtask_time_usec - last_counters_.microtask_time_usec) / frames;
+    }
+    last_counters_ = counters;
+    last_flush_frame_ = frame;
 }
@@ -4,6 +4,7 @@
 #include "../bridge/jsb_statistics.h"
 
 #define JSB_DECLARE_MONITOR(MonitorName) Variant get_value_## MonitorName()
+#define JSB_DECLARE_RATE_MONITOR(CounterName) Variant get_value_## CounterName ##_per_frame()
 
 class GodotJSMonitor : public Object
 {
@@ -14,6 +15,23 @@ private:
     jsb::Statistics stats_;
     uint64_t last_flush_tick_ = 0;
 
+    // per-frame rates of `stats_.counters` (averaged over the frames since the last flush)
+    struct
+    {
+        double variant_allocs = 0;
+        double variant_frees = 0;
+        double valuetype_bindings = 0;
+        double object_bindings = 0;
+        double gc_count = 0;
+        double gc_time_usec = 0;
+        double string_name_hits = 0;
+        double string_name_misses = 0;
+        double string_name_evictions = 0;
+        double microtask_time_usec = 0;
+    } rates_;
+    jsb::StatisticsCounters last_counters_;
+    uint64_t last_flush_frame_ = 0;
+
 protected:
     static void _bind_methods();
 
@@ -25,6 +43,16 @@ protected:
     JSB_DECLARE_MONITOR(cached_string_names);
     JSB_DECLARE_MONITOR(persistent_objects);
     JSB_DECLARE_MONITOR(allocated_variants);
+    JSB_DECLARE_RATE_MONITOR(variant_allocs);
+    JSB_DECLARE_RATE_MONITOR(variant_frees);
+    JSB_DECLARE_RATE_MONITOR(valuetype_bindings);
+    JSB_DECLARE_RATE_MONITOR(object_bindings);
+    JSB_DECLARE_RATE_MONITOR(gc_count);
+    JSB_DECLARE_RATE_MONITOR(gc_time_usec);
+    JSB_DECLARE_RATE_MONITOR(string_name_hits);
+    JSB_DECLARE_RATE_MONITOR(string_name_misses);
+    JSB_DECLARE_RATE_MONITOR(string_name_evictions);
+    JSB_DECLARE_RATE_MONITOR(microtask_time_usec);
 
 #if JSB_WITH_V8
     JSB_DECLARE_MONITOR(heap_size);
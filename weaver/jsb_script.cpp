@@ -1,764 +1,1042 @@
-#include "jsb_script.h"
-#include "jsb_script_language.h"
-#include "jsb_script_instance.h"
-#include "../internal/jsb_path_util.h"
-
-GodotJSScript::GodotJSScript(): script_list_(this)
-{
-    {
-        JSB_BENCHMARK_SCOPE(GodotJSScript, Construct);
-        MutexLock lock(GodotJSScriptLanguage::get_singleton()->mutex_);
-        GodotJSScriptLanguage::get_singleton()->script_list_.add(&script_list_);
-    }
-    JSB_LOG(VeryVerbose, "new GodotJSScript addr:%d", (uintptr_t) this);
-}
-
-GodotJSScript::~GodotJSScript()
-{
-    JSB_LOG(VeryVerbose, "delete GodotJSScript addr:%d", (uintptr_t) this);
-
-    {
-        JSB_BENCHMARK_SCOPE(GodotJSScript, Destruct);
-        MutexLock lock(GodotJSScriptLanguage::get_singleton()->mutex_);
-
-        script_list_.remove_from_list();
-    }
-}
-
-// GDScript::can_instantiate()
-bool GodotJSScript::can_instantiate() const
-{
-#ifdef TOOLS_ENABLED
-    return is_valid() && (is_tool() || ScriptServer::is_scripting_enabled());
-#else
-    return is_valid();
-#endif
-}
-
-void GodotJSScript::set_source_code(const String& p_code)
-{
-    if (source_ == p_code) return;
-
-    source_ = p_code;
-#ifdef TOOLS_ENABLED
-    source_changed_cache = true;
-#endif
-}
-
-void GodotJSScript::set_path(const String& p_path, bool p_take_over)
-{
-    super::set_path(p_path, p_take_over);
-}
-
-Ref<Script> GodotJSScript::get_base_script() const
-{
-    ensure_module_loaded();
-    //jsb_notice(loaded_, "script not loaded");
-
-    // return the base script in order to traverse methods/properties from inheritance hierarchy
-    return base;
-}
-
-StringName GodotJSScript::get_global_name() const
-{
-    ensure_module_loaded();
-    return is_valid() ? script_class_info_.js_class_name : StringName();
-}
-
-bool GodotJSScript::inherits_script(const Ref<Script>& p_script) const
-{
-    jsb_check(loaded_);
-
-    // check if the current script inherits from `p_script`
-    //TODO `inherits_script` seems to be called only by Array::assign, it's enough for now without an implementation.
-    //TODO iterate the prototype chain, check if the current script inherits from `p_script`
-
-    return false;
-}
-
-// this method is called in `EditorStandardSyntaxHighlighter::_update_cache()` without checking `script->is_valid()`
-StringName GodotJSScript::get_instance_base_type() const
-{
-    ensure_module_loaded();
-    return is_valid() ? script_class_info_.native_class_name : StringName();
-}
-
-ScriptInstance* GodotJSScript::instance_and_native_object_create(const v8::Local<v8::Object>& p_this, bool p_is_temp_allowed)
-{
-    jsb_check(is_valid());
-    jsb_check(loaded_);
-
-    Object* owner = ClassDB::instantiate(script_class_info_.native_class_name);
-    ScriptInstance* instance = instance_create(p_this, owner, p_is_temp_allowed);
-    if (!instance)
-    {
-        memdelete(owner);
-    }
-    return instance;
-}
-
-ScriptInstance* GodotJSScript::instance_create(const v8::Local<v8::Object>& p_this, Object* p_owner, bool p_is_temp_allowed)
-{
-    jsb_check(is_valid());
-    jsb_check(loaded_);
-
-    jsb::JSEnvironment env(get_path(), p_is_temp_allowed);
-    jsb::JavaScriptModule* module = nullptr;
-    const Error err = env->load(script_class_info_.module_id, &module);
-    jsb_ensuref(module && err == OK, "JS Module not found: %s", script_class_info_.module_id);
-    const jsb::NativeClassID native_class_id = env->get_script_class(module->script_class_id)->native_class_id;
-
-    /* STEP 1, CREATE */
-    GodotJSScriptInstance* instance = memnew(GodotJSScriptInstance);
-
-    instance->owner_ = p_owner;
-    instance->script_ = Ref(this); // must set before 'set_script_instance'
-    instance->env_ = env;
-    instance->class_id_ = module->script_class_id;
-    instance->owner_->set_script_instance(instance);
-
-    /* STEP 2, INITIALIZE AND CONSTRUCT */
-    {
-        MutexLock lock(GodotJSScriptLanguage::get_singleton()->mutex_);
-        instances_.insert(p_owner);
-    }
-    instance->object_id_ = env->bind_godot_object(native_class_id, p_owner, p_this);
-    if (!instance->object_id_)
-    {
-        instance->script_ = Ref<GodotJSScript>();
-        instance->owner_->set_script_instance(nullptr);
-        //NOTE `instance` becomes an invalid pointer since it's deleted in `set_script_instance`
-        {
-            MutexLock lock(GodotJSScriptLanguage::get_singleton()->mutex_);
-            instances_.erase(p_owner);
-        }
-        JSB_LOG(Error, "Error constructing a GodotJSScriptInstance");
-        return nullptr;
-    }
-
-    return instance;
-}
-
-ScriptInstance* GodotJSScript::instance_construct(Object* p_this, bool p_is_temp_allowed, const Variant** p_args, int p_argcount)
-{
-    jsb_check(is_valid());
-    jsb_check(loaded_);
-    JSB_LOG(Verbose, "create instance %d of %s(%s)", (uintptr_t) p_this, script_class_info_.native_class_name, script_class_info_.module_id);
-
-    if (!ClassDB::is_parent_class(p_this->get_class_name(), script_class_info_.native_class_name))
-    {
-        JSB_LOG(Error, "GodotJS class %s (%s) cannot be instantiated for a %s, it requires a %s", script_class_info_.js_class_name, script_class_info_.module_id, p_this->get_class_name(), script_class_info_.native_class_name);
-        return nullptr;
-    }
-
-    jsb::JSEnvironment env(get_path(), p_is_temp_allowed);
-    if (env.is_shadow())
-    {
-        GodotJSShadowScriptInstance* shadow_instance = memnew(GodotJSShadowScriptInstance);
-        shadow_instance->owner_ = p_this;
-        shadow_instance->script_ = Ref(this);
-
-        // ensure `GodotJSScript::instance_has(obj)` works properly even if a shadow instance is used.
-        {
-            MutexLock lock(GodotJSScriptLanguage::get_singleton()->mutex_);
-            instances_.insert(shadow_instance->owner_);
-        }
-        return shadow_instance;
-    }
-
-    jsb::JavaScriptModule* module = nullptr;
-    const Error err = env->load(script_class_info_.module_id, &module);
-    jsb_ensuref(module && err == OK, "JS Module not found: %s", script_class_info_.module_id);
-
-    /* STEP 1, CREATE */
-    GodotJSScriptInstance* instance = memnew(GodotJSScriptInstance);
-
-    instance->owner_ = p_this;
-    instance->script_ = Ref(this); // must set before 'set_script_instance'
-    instance->env_ = env;
-    instance->class_id_ = module->script_class_id;
-    instance->owner_->set_script_instance(instance);
-
-    /* STEP 2, INITIALIZE AND CONSTRUCT */
-    {
-        MutexLock lock(GodotJSScriptLanguage::get_singleton()->mutex_);
-        instances_.insert(instance->owner_);
-    }
-
-    instance->object_id_ = env->crossbind(p_this, instance->class_id_, p_args, p_argcount);
-
-    if (!instance->object_id_)
-    {
-        instance->script_ = Ref<GodotJSScript>();
-        instance->owner_->set_script_instance(nullptr);
-        //NOTE `instance` becomes an invalid pointer since it's deleted in `set_script_instance`
-        {
-            MutexLock lock(GodotJSScriptLanguage::get_singleton()->mutex_);
-            instances_.erase(p_this);
-        }
-        JSB_LOG(Error, "Error constructing a GodotJSScriptInstance");
-        return nullptr;
-    }
-
-    instance->postbind();
-
-    return instance;
-}
-
-Error GodotJSScript::reload(bool p_keep_state)
-{
-    if (!loaded_) return OK;
-    if (!_is_valid()) return ERR_UNAVAILABLE;
-
-    if (!p_keep_state)
-    {
-        MutexLock lock(GodotJSScriptLanguage::get_singleton()->mutex_);
-        if (instances_.size())
-        {
-            return ERR_ALREADY_IN_USE;
-        }
-    }
-
-    if (!p_keep_state)
-    {
-        //TODO discard the object and crossbind again, but for now we just reload it normally
-    }
-
-    // (common situation) preserve the object and change its prototype
-    const StringName& module_id = script_class_info_.module_id;
-    jsb::JSEnvironment env(get_path(), true);
-
-    //TODO different env has different module state, we need to refresh the state in all envs when marking a module as dirty somewhere
-    const jsb::ModuleReloadResult::Type result = env->mark_as_reloading(module_id);
-    if (result == jsb::ModuleReloadResult::Requested)
-    {
-        //TODO `Callable` objects bound with this script should be invalidated somehow?
-        // ...
-
-        loaded_ = false;
-    }
-    else if (result != jsb::ModuleReloadResult::NoChanges)
-    {
-        JSB_LOG(Warning, "failed to mark module as reloading: %s (%d)", module_id, result);
-    }
-
-    return OK;
-}
-
-#ifdef TOOLS_ENABLED
-#if GODOT_4_4_OR_NEWER
-StringName GodotJSScript::get_doc_class_name() const
-{
-    //TODO not verified
-    Vector<DocData::ClassDoc> docs = get_documentation();
-    if (!docs.is_empty()) return docs[0].name;
-    return {};
-}
-#endif
-
-Vector<DocData::ClassDoc> GodotJSScript::get_documentation() const
-{
-    ensure_module_loaded();
-    if (!loaded_ || !_is_valid()) return {};
-
-    String base_type;
-    const String class_name = GodotJSScriptLanguage::get_singleton()->get_global_class_name(get_path(), &base_type);
-    DocData::ClassDoc class_doc_data;
-
-    class_doc_data.name = class_name;
-    class_doc_data.inherits = base_type.is_empty() ? "Object" : base_type;
-    class_doc_data.is_script_doc = true;
-    class_doc_data.brief_description = script_class_info_.doc.brief_description;
-    class_doc_data.is_deprecated = script_class_info_.doc.is_deprecated;
-    class_doc_data.is_experimental = script_class_info_.doc.is_experimental;
-#if GODOT_4_3_OR_NEWER
-    class_doc_data.deprecated_message = script_class_info_.doc.deprecated_message;
-    class_doc_data.experimental_message = script_class_info_.doc.experimental_message;
-#endif
-    class_doc_data.script_path = get_path();
-    for (const auto& item : script_class_info_.properties)
-    {
-        DocData::PropertyDoc property_doc_data;
-        property_doc_data.name = item.key;
-        property_doc_data.description = item.value.doc.brief_description;
-        property_doc_data.is_deprecated = item.value.doc.is_deprecated;
-        property_doc_data.is_experimental = item.value.doc.is_experimental;
-#if GODOT_4_3_OR_NEWER
-        property_doc_data.deprecated_message = item.value.doc.deprecated_message;
-        property_doc_data.experimental_message = item.value.doc.experimental_message;
-#endif
-        class_doc_data.properties.append(property_doc_data);
-    }
-
-    return { class_doc_data };
-}
-
-String GodotJSScript::get_class_icon_path() const
-{
-    ensure_module_loaded();
-    jsb_check(loaded_);
-    return script_class_info_.icon;
-}
-
-PropertyInfo GodotJSScript::get_class_category() const
-{
-    ensure_module_loaded();
-    jsb_check(loaded_);
-    return super::get_class_category();
-}
-#endif // TOOLS_ENABLED
-
-bool GodotJSScript::has_method(const StringName& p_method) const
-{
-    ensure_module_loaded();
-    jsb_check(loaded_);
-
-    String exposed_name = p_method;
-
-    if (exposed_name.begins_with("_"))
-    {
-        exposed_name = jsb::internal::NamingUtil::get_member_name(exposed_name);
-    }
-
-    const GodotJSScript* current = this;
-    while (current)
-    {
-        //TODO temp fix
-        if (!current->loaded_) const_cast<GodotJSScript*>(current)->load_module_immediately();
-        if (current->is_valid() && current->script_class_info_.methods.has(exposed_name)) return true;
-        current = current->base.ptr();
-    }
-
-    // ensure `_ready` called even if it's not actually defined in scripts
-    if (p_method == SceneStringNames::get_singleton()->_ready)
-    {
-        // only a `Node` class has `_ready` call
-        if (ClassDB::is_parent_class(get_instance_base_type(), jsb_string_name(Node)))
-        {
-            return true;
-        }
-    }
-    return false;
-}
-
-MethodInfo GodotJSScript::get_method_info(const StringName& p_method) const
-{
-    jsb_check(loaded_);
-    jsb_check(has_method(p_method));
-    //TODO details?
-    MethodInfo item = {};
-    item.name = p_method;
-    return item;
-}
-
-ScriptLanguage* GodotJSScript::get_language() const
-{
-    return GodotJSScriptLanguage::get_singleton();
-}
-
-bool GodotJSScript::has_script_signal(const StringName& p_signal) const
-{
-    return is_valid() ? script_class_info_.signals.has(p_signal) : false;
-}
-
-void GodotJSScript::get_script_signal_list(List<MethodInfo>* r_signals) const
-{
-    if (!is_valid()) return;
-
-    for (const auto& it : script_class_info_.signals)
-    {
-        //TODO details?
-        MethodInfo item = {};
-        item.name = it.key;
-        r_signals->push_back(item);
-    }
-
-    if (base.is_valid())
-    {
-        base->get_script_signal_list(r_signals);
-    }
-}
-
-void GodotJSScript::get_script_method_list(List<MethodInfo>* p_list) const
-{
-    ensure_module_loaded();
-    jsb_check(loaded_);
-
-    for (const auto& it : script_class_info_.methods)
-    {
-        //TODO details?
-        MethodInfo item = {};
-        item.name = it.key;
-        p_list->push_back(item);
-    }
-
-    if (base.is_valid() && base->is_valid())
-    {
-        base->get_script_method_list(p_list);
-    }
-}
-
-void GodotJSScript::get_script_property_list(List<PropertyInfo>* p_list) const
-{
-    ensure_module_loaded();
-    jsb_check(loaded_);
-
-#ifdef TOOLS_ENABLED
-    p_list->push_back(get_class_category());
-#endif
-    for (const auto& it : script_class_info_.properties)
-    {
-        p_list->push_back((PropertyInfo) it.value);
-    }
-
-    if (base.is_valid() && base->is_valid())
-    {
-        base->get_script_property_list(p_list);
-    }
-}
-
-bool GodotJSScript::get_property_default_value(const StringName& p_property, Variant& r_value) const
-{
-    ensure_module_loaded();
-    if (const HashMap<StringName, Variant>::ConstIterator it = member_default_values_cache.find(p_property))
-    {
-        r_value = it->value;
-        return true;
-    }
-
-    return base.is_valid() && base->is_valid()
-        ? base->get_property_default_value(p_property, r_value)
-        : false;
-}
-
-#if GODOT_4_5_OR_NEWER
-const Variant GodotJSScript::get_rpc_config() const
-#elif GODOT_4_4_OR_NEWER
-Variant GodotJSScript::get_rpc_config() const
-#else
-const Variant GodotJSScript::get_rpc_config() const
-#endif
-{
-    ensure_module_loaded();
-    jsb_check(loaded_);
-
-    return script_class_info_.rpc_config;
-}
-
-bool GodotJSScript::has_static_method(const StringName& p_method) const
-{
-    ensure_module_loaded();
-    jsb_check(loaded_);
-    //TODO
-    return false;
-}
-
-bool GodotJSScript::instance_has(const Object* p_this) const
-{
-    jsb_check(loaded_);
-    MutexLock lock(GodotJSScriptLanguage::get_singleton()->mutex_);
-    return instances_.has(const_cast<Object*>(p_this));
-}
-
-Error GodotJSScript::load_source_code(const String &p_path)
-{
-    Error err;
-#ifdef TOOLS_ENABLED
-	const String source_code = FileAccess::get_file_as_string(p_path, &err);
-#else
-
-#if JSB_USE_TYPESCRIPT
-	const String path = jsb::internal::PathUtil::convert_typescript_path(p_path);
-	const String source_code = FileAccess::get_file_as_string(path, &err);
-#else
-	const String path = jsb::internal::PathUtil::convert_javascript_path(p_path);
-	const String source_code = FileAccess::get_file_as_string(path, &err);
-#endif
-
-#endif
-    if (err != OK)
-    {
-        JSB_LOG(Warning, "can not read source from %s", p_path);
-    }
-    else
-    {
-        set_source_code(source_code);
-    }
-    return err;
-}
-
-void GodotJSScript::load_module_if_missing()
-{
-    if (!loaded_ || _is_valid()) return;
-
-    JSB_LOG(Verbose, "force to load missing script %s", get_path());
-    loaded_ = false;
-    load_module_immediately();
-}
-
-void GodotJSScript::load_module_immediately()
-{
-    if (loaded_) return;
-    JSB_BENCHMARK_SCOPE(GodotJSScript, load_module);
-
-    const String path = jsb::internal::PathUtil::convert_typescript_path(get_path());
-    jsb::JSEnvironment env(get_path(), true);
-
-    loaded_ = true;
-    base.unref();
-    source_changed_cache = true;
-    jsb::JavaScriptModule* module;
-    if (const Error err = env->load(path, &module); err != OK)
-    {
-        script_class_info_ = {};
-#ifdef TOOLS_ENABLED
-        if (FileAccess::exists(get_path()) && !FileAccess::exists(path))
-        {
-            JSB_LOG(Error,
-                "the javascript file is missing: %s (source: %s), "
-                "please ensure that all typescript source files have already been compiled "
-                "using the typescript compiler ('tsc').",
-                path, get_path());
-            return;
-        }
-#endif
-        JSB_LOG(Error, "failed to attach module %s (%d)", path, err);
-        return;
-    }
-    jsb_check(module);
-    {
-        const jsb::ScriptClassInfoPtr class_info_ptr = env->find_script_class(module->script_class_id);
-        script_class_info_ = class_info_ptr ? (jsb::StatelessScriptClassInfo) *class_info_ptr : jsb::StatelessScriptClassInfo();
-    }
-    if (_is_valid())
-    {
-        JSB_LOG(VeryVerbose, "GodotJSScript module loaded %s", path);
-        {
-            //TODO a dirty but approaching solution for hot-reloading
-            //TODO will crash if reloading script instances in worker threads
-            MutexLock lock(GodotJSScriptLanguage::get_singleton()->mutex_); // necessary?
-            for (RBSet<Object *>::Element *E = instances_.front(); E;)
-            {
-                RBSet<Object *>::Element *N = E->next();
-                Object* obj = E->get();
-                jsb_check(obj->get_script() == Ref(this));
-                jsb_check(env->verify_object(obj));
-
-                if (ClassDB::is_parent_class(env->get_script_class(module->script_class_id)->native_class_name, obj->get_class_name()))
-                {
-                    env->rebind(obj, module->script_class_id);
-                }
-                else
-                {
-                    JSB_LOG(Warning, "Cannot rebind class %s (%s) on %s, it requires a %s", script_class_info_.js_class_name, script_class_info_.module_id, obj->get_class_name(), env->get_script_class(module->script_class_id)->native_class_name);
-                    obj->set_script(Ref<Script>());
-                }
-
-                E = N;
-            }
-        }
-
-        // setup base script
-        {
-            //TODO do not rely on ResourceLoader
-            if (script_class_info_.base_script_module_id)
-            {
-                jsb::JavaScriptModule* base_module = nullptr;
-                const Error err = env->load(script_class_info_.base_script_module_id, &base_module);
-                jsb_ensuref(base_module && err == OK, "JS Module not found: %s", script_class_info_.base_script_module_id);
-                const Ref<Resource> base_res = ResourceLoader::load(jsb::internal::PathUtil::convert_javascript_path(base_module->source_info.source_filepath));
-                jsb_check(base_res->get_class() == jsb_typename(GodotJSScript));
-                base = base_res;
-            }
-        }
-
-        // update the default value cache
-        update_exports();
-#ifdef TOOLS_ENABLED
-        // temp and tricky workaround to avoid missing doc when showing on inspector the first time after load
-        if (DocTools* doc_tools = EditorHelp::get_doc_data())
-        {
-            const Vector<DocData::ClassDoc> documentations = get_documentation();
-            for (int i = 0; i < documentations.size(); i++)
-            {
-                const DocData::ClassDoc& doc = documentations.get(i);
-                doc_tools->add_doc(doc);
-            }
-        }
-#endif
-        return;
-    }
-    JSB_LOG(Debug, "a stub script loaded which does not contain a GodotJS class %s", path);
-}
-
-PlaceHolderScriptInstance* GodotJSScript::placeholder_instance_create(Object* p_this)
-{
-#ifdef TOOLS_ENABLED
-    if (!is_valid())
-    {
-        JSB_LOG(Warning, "creating placeholder instance on invalid script (%s)", get_path());
-    }
-    PlaceHolderScriptInstance *si = memnew(PlaceHolderScriptInstance(GodotJSScriptLanguage::get_singleton(), Ref<Script>(this), p_this));
-    placeholders.insert(si);
-    _update_exports(si);
-    return si;
-#else
-    return nullptr;
-#endif
-}
-
-#ifdef TOOLS_ENABLED
-void GodotJSScript::_placeholder_erased(PlaceHolderScriptInstance* p_placeholder)
-{
-    placeholders.erase(p_placeholder);
-}
-#endif
-
-void GodotJSScript::update_exports()
-{
-    ensure_module_loaded();
-    jsb_check(loaded_);
-#ifdef TOOLS_ENABLED
-    if (!is_valid()) return;
-    _update_exports(nullptr);
-#endif
-}
-
-void GodotJSScript::_update_exports_values(List<PropertyInfo>& r_props, HashMap<StringName, Variant>& r_values)
-{
-    for (const KeyValue<StringName, Variant> &E : member_default_values_cache)
-    {
-        r_values[E.key] = E.value;
-    }
-
-#ifdef TOOLS_ENABLED
-    r_props.push_back(get_class_category());
-#endif
-    for (const PropertyInfo &E : members_cache)
-    {
-        r_props.push_back(E);
-    }
-
-    if (base.is_valid() && base->is_valid())
-    {
-        base->_update_exports_values(r_props, r_values);
-    }
-}
-
-Variant GodotJSScript::_new(const Variant** p_args, int p_argcount, Callable::CallError &r_error)
-{
-    if (!is_valid())
-    {
-        JSB_LOG(Error, "Unable to create new instance. The script was not properly loaded (%s)", get_path());
-        return Variant();
-    }
-
-    r_error.error = Callable::CallError::CALL_OK;
-    Object *owner = ClassDB::instantiate(script_class_info_.native_class_name);
-
-    ScriptInstance *script_instance = instance_construct(owner, false, p_args, p_argcount);
-
-    if (!script_instance)
-    {
-        memdelete(owner);
-        return Variant();
-    }
-
-    return owner;
-}
-
-bool GodotJSScript::_update_exports(PlaceHolderScriptInstance* p_instance_to_update)
-{
-    // do not crash the engine if the script not loaded successfully
-    if (!is_valid())
-    {
-        JSB_LOG(Error, "script failed to load (%s)", get_path());
-        return false;
-    }
-
-    bool changed = false;
-
-    if (source_changed_cache)
-    {
-        source_changed_cache = false;
-        changed = true;
-
-        members_cache.clear();
-        member_default_values_cache.clear();
-
-        jsb::JSEnvironment env(get_path(), true);
-        env->check_internal_state();
-
-        jsb::JavaScriptModule* module = nullptr;
-        const Error err = env->load(script_class_info_.module_id, &module);
-        jsb_ensuref(module && err == OK, "JS Module not found: %s", script_class_info_.module_id);
-
-        if (const jsb::ScriptClassInfoPtr class_info = env->find_script_class(module->script_class_id))
-        {
-            for (const KeyValue<StringName, jsb::ScriptPropertyInfo> &pair : script_class_info_.properties)
-            {
-                const jsb::ScriptPropertyInfo &pi = pair.value;
-                members_cache.push_back((PropertyInfo) pi);
-                // values[pair.key] = jsb_ext_type_convert({}, pi.type);
-
-                //TODO maybe this behaviour is not expected
-                Variant default_value;
-                env->get_default_property_value(*class_info, pi.name, default_value);
-                member_default_values_cache[pi.name] = default_value;
-                JSB_LOG(VeryVerbose, "GodotJS script default %s.%s = %s",
-                    _is_valid() ? script_class_info_.js_class_name : "(unknown)",
-                    pi.name,
-                    default_value);
-            }
-        }
-        else
-        {
-            JSB_LOG(Warning, "ScriptClassInfo is invalid, fallback to empty default values (script %s)", get_path());
-            for (const KeyValue<StringName, jsb::ScriptPropertyInfo> &pair : script_class_info_.properties)
-            {
-                const jsb::ScriptPropertyInfo &pi = pair.value;
-                members_cache.push_back({ pi.type, pi.name, pi.hint, pi.hint_string, pi.usage, pi.class_name });
-
-                Variant default_value;
-                jsb::internal::VariantUtil::construct_variant(default_value, pi.type);
-                member_default_values_cache[pi.name] = default_value;
-            }
-        }
-    }
-
-    if (base.is_valid() && base->_update_exports(p_instance_to_update))
-    {
-        changed = true;
-    }
-
-    if ((changed || p_instance_to_update) && placeholders.size())
-    {
-        List<PropertyInfo> props;
-        HashMap<StringName, Variant> values;
-        _update_exports_values(props, values);
-
-        if (changed)
-        {
-            for (PlaceHolderScriptInstance *s : placeholders)
-            {
-                s->update(props, values);
-            }
-        }
-        else
-        {
-            p_instance_to_update->update(props, values);
-        }
-    }
-
-    return changed;
-}
-
-void GodotJSScript::_bind_methods() {
-    ClassDB::bind_vararg_method(METHOD_FLAGS_DEFAULT, "new", &GodotJSScript::_new, MethodInfo("new"));
-}
-
-void GodotJSScript::reload_from_file()
-{
-    //TODO reload, maybe it's OK?
-    reload(true);
-}
+#include "jsb_script.h"
+#include "jsb_script_language.h"
+#include "jsb_script_instance.h"
+#include "../internal/jsb_path_util.h"
+#include "../internal/jsb_module_archive.h"
+#include "../bridge/jsb_module_prefetcher.h"
+
+GodotJSScript::GodotJSScript(): script_list_(this)
+{
+    {
+        JSB_BENCHMARK_SCOPE(GodotJSScript, Construct);
+        MutexLock lock(GodotJSScriptLanguage::get_singleton()->mutex_);
+        GodotJSScriptLanguage::get_singleton()->script_list_.add(&script_list_);
+    }
+    JSB_LOG(VeryVerbose, "new GodotJSScript addr:%d", (uintptr_t) this);
+}
+
+GodotJSScript::~GodotJSScript()
+{
+    JSB_LOG(VeryVerbose, "delete GodotJSScript addr:%d", (uintptr_t) this);
+
+    {
+        JSB_BENCHMARK_SCOPE(GodotJSScript, Destruct);
+        MutexLock lock(GodotJSScriptLanguage::get_singleton()->mutex_);
+
+        script_list_.remove_from_list();
+    }
+}
+
+// GDScript::can_instantiate()
+bool GodotJSScript::can_instantiate() const
+{
+#ifdef TOOLS_ENABLED
+    // check `is_tool` first, non-tool scripts are not loaded in editor until they're really used (see `get_cached_class_info`)
+    return (is_tool() || ScriptServer::is_scripting_enabled()) && is_valid();
+#else
+    return is_valid();
+#endif
+}
+
+void GodotJSScript::set_source_code(const String& p_code)
+{
+    if (source_ == p_code) return;
+
+    source_ = p_code;
+#ifdef TOOLS_ENABLED
+    source_changed_cache = true;
+    invalidate_class_cache();
+#endif
+}
+
+void GodotJSScript::set_path(const String& p_path, bool p_take_over)
+{
+    super::set_path(p_path, p_take_over);
+}
+
+Ref<Script> GodotJSScript::get_base_script() const
+{
+    if (get_cached_class_info()) return Ref<Script>(get_query_base());
+    ensure_module_loaded();
+    //jsb_notice(loaded_, "script not loaded");
+
+    // return the base script in order to traverse methods/properties from inheritance hierarchy
+    return base;
+}
+
+const jsb::ScriptClassMetadata* GodotJSScript::get_deferred_metadata() const
+{
+    if (loaded_) return nullptr;
+    const jsb::ScriptMetadataCache* cache = jsb::ScriptMetadataCache::get_packaged();
+    return cache ? cache->find(jsb::internal::PathUtil::convert_typescript_path(get_path())) : nullptr;
+}
+
+const jsb::StatelessScriptClassInfo* GodotJSScript::get_cached_class_info() const
+{
+#ifdef TOOLS_ENABLED
+    if (loaded_) return nullptr;
+    if (!class_cache_checked_)
+    {
+        class_cache_checked_ = true;
+        if (!Engine::get_singleton()->is_editor_hint() || !jsb::internal::Settings::is_script_class_cache_enabled()) return nullptr;
+
+        jsb::ScriptClassCacheEntry entry;
+        if (!jsb::ScriptClassCache::load(jsb::internal::PathUtil::convert_typescript_path(get_path()), entry)) return nullptr;
+        if (!entry.base_script_path.is_empty())
+        {
+            // the base script is resolved with the cache of itself
+            const Ref<GodotJSScript> base_script = ResourceLoader::load(entry.base_script_path);
+            if (base_script.is_null() || !base_script->get_cached_class_info()) return nullptr;
+            class_cache_base_ = base_script;
+        }
+        JSB_LOG(VeryVerbose, "script class info read from cache %s", get_path());
+        class_cache_.emplace(std::move(entry));
+    }
+    return class_cache_ ? &class_cache_->class_info : nullptr;
+#else
+    return nullptr;
+#endif
+}
+
+GodotJSScript* GodotJSScript::get_query_base() const
+{
+#ifdef TOOLS_ENABLED
+    if (get_cached_class_info()) return class_cache_base_.ptr();
+#endif
+    return base.ptr();
+}
+
+std::atomic<uint32_t> GodotJSScript::class_info_revision_ = 1;
+
+void GodotJSScript::invalidate_class_cache()
+{
+    class_info_revision_.fetch_add(1, std::memory_order_relaxed);
+#ifdef TOOLS_ENABLED
+    class_cache_checked_ = false;
+    class_cache_.reset();
+    class_cache_base_.unref();
+    documentation_cached_ = false;
+    documentation_cache_.clear();
+#endif
+}
+
+void GodotJSScript::save_class_cache(jsb::JSEnvironment& p_env)
+{
+#ifdef TOOLS_ENABLED
+    if (!Engine::get_singleton()->is_editor_hint() || !jsb::internal::Settings::is_script_class_cache_enabled()) return;
+
+    const String path = jsb::internal::PathUtil::convert_typescript_path(get_path());
+    if (!_is_valid())
+    {
+        jsb::ScriptClassCache::remove(path);
+        return;
+    }
+
+    const std::shared_ptr<jsb::Environment> env = p_env;
+    jsb::ScriptClassCache::save(env.get(), path, script_class_info_, source_changed_cache ? nullptr : &member_default_values_cache);
+#endif
+}
+
+bool GodotJSScript::is_tool() const
+{
+    if (const jsb::ScriptClassMetadata* metadata = get_deferred_metadata()) return metadata->is_tool();
+    if (const jsb::StatelessScriptClassInfo* cached = get_cached_class_info()) return cached->is_tool();
+    return is_valid() && script_class_info_.is_tool();
+}
+
+bool GodotJSScript::is_abstract() const
+{
+    if (const jsb::ScriptClassMetadata* metadata = get_deferred_metadata()) return metadata->is_abstract();
+    if (const jsb::StatelessScriptClassInfo* cached = get_cached_class_info()) return cached->is_abstract();
+    return is_valid() && script_class_info_.is_abstract();
+}
+
+StringName GodotJSScript::get_global_name() const
+{
+    if (const jsb::ScriptClassMetadata* metadata = get_deferred_metadata()) return metadata->js_class_name;
+    if (const jsb::StatelessScriptClassInfo* cached = get_cached_class_info()) return cached->js_class_name;
+    ensure_module_loaded();
+    return is_valid() ? script_class_info_.js_class_name : StringName();
+}
+
+bool GodotJSScript::inherits_script(const Ref<Script>& p_script) const
+{
+    jsb_check(loaded_ || get_cached_class_info());
+
+    // check if the current script inherits from `p_script`
+    //TODO `inherits_script` seems to be called only by Array::assign, it's enough for now without an implementation.
+    //TODO iterate the prototype chain, check if the current script inherits from `p_script`
+
+    return false;
+}
+
+// this method is called in `EditorStandardSyntaxHighlighter::_update_cache()` without checking `script->is_valid()`
+StringName GodotJSScript::get_instance_base_type() const
+{
+    if (const jsb::ScriptClassMetadata* metadata = get_deferred_metadata()) return metadata->native_class_name;
+    if (const jsb::StatelessScriptClassInfo* cached = get_cached_class_info()) return cached->native_class_name;
+    ensure_module_loaded();
+    return is_valid() ? script_class_info_.native_class_name : StringName();
+}
+
+ScriptInstance* GodotJSScript::instance_and_native_object_create(const v8::Local<v8::Object>& p_this, bool p_is_temp_allowed)
+{
+    ensure_module_loaded();
+    jsb_check(is_valid());
+    jsb_check(loaded_);
+
+    Object* owner = ClassDB::instantiate(script_class_info_.native_class_name);
+    ScriptInstance* instance = instance_create(p_this, owner, p_is_temp_allowed);
+    if (!instance)
+    {
+        memdelete(owner);
+    }
+    return instance;
+}
+
+ScriptInstance* GodotJSScript::instance_create(const v8::Local<v8::Object>& p_this, Object* p_owner, bool p_is_temp_allowed)
+{
+    ensure_module_loaded();
+    jsb_check(is_valid());
+    jsb_check(loaded_);
+
+    jsb::JSEnvironment env(get_path(), p_is_temp_allowed);
+    jsb::JavaScriptModule* module = nullptr;
+    const Error err = env->load(script_class_info_.module_id, &module);
+    jsb_ensuref(module && err == OK, "JS Module not found: %s", script_class_info_.module_id);
+    const jsb::NativeClassID native_class_id = env->get_script_class(module->script_class_id)->native_class_id;
+
+    /* STEP 1, CREATE */
+    GodotJSScriptInstance* instance = memnew(GodotJSScriptInstance);
+
+    instance->owner_ = p_owner;
+    instance->script_ = Ref(this); // must set before 'set_script_instance'
+    instance->env_ = env;
+    instance->class_id_ = module->script_class_id;
+    instance->owner_->set_script_instance(instance);
+
+    /* STEP 2, INITIALIZE AND CONSTRUCT */
+    {
+        MutexLock lock(GodotJSScriptLanguage::get_singleton()->mutex_);
+        instances_.insert(p_owner);
+    }
+    instance->object_id_ = env->bind_godot_object(native_class_id, p_owner, p_this);
+    if (!instance->object_id_)
+    {
+        instance->script_ = Ref<GodotJSScript>();
+        instance->owner_->set_script_instance(nullptr);
+        //NOTE `instance` becomes an invalid pointer since it's deleted in `set_script_instance`
+        {
+            MutexLock lock(GodotJSScriptLanguage::get_singleton()->mutex_);
+            instances_.erase(p_owner);
+        }
+        JSB_LOG(Error, "Error constructing a GodotJSScriptInstance");
+        return nullptr;
+    }
+
+    return instance;
+}
+
+ScriptInstance* GodotJSScript::instance_construct(Object* p_this, bool p_is_temp_allowed, const Variant** p_args, int p_argcount)
+{
+    ensure_module_loaded();
+    jsb_check(is_valid());
+    jsb_check(loaded_);
+    JSB_LOG(Verbose, "create instance %d of %s(%s)", (uintptr_t) p_this, script_class_info_.native_class_name, script_class_info_.module_id);
+
+    if (!ClassDB::is_parent_class(p_this->get_class_name(), script_class_info_.native_class_name))
+    {
+        JSB_LOG(Error, "GodotJS class %s (%s) cannot be instantiated for a %s, it requires a %s", script_class_info_.js_class_name, script_class_info_.module_id, p_this->get_class_name(), script_class_info_.native_class_name);
+        return nullptr;
+    }
+
+    jsb::JSEnvironment env(get_path(), p_is_temp_allowed);
+    if (env.is_shadow())
+    {
+        GodotJSShadowScriptInstance* shadow_instance = memnew(GodotJSShadowScriptInstance);
+        shadow_instance->owner_ = p_this;
+        shadow_instance->script_ = Ref(this);
+
+        // ensure `GodotJSScript::instance_has(obj)` works properly even if a shadow instance is used.
+        {
+            MutexLock lock(GodotJSScriptLanguage::get_singleton()->mutex_);
+            instances_.insert(shadow_instance->owner_);
+        }
+        return shadow_instance;
+    }
+
+    jsb::JavaScriptModule* module = nullptr;
+    const Error err = env->load(script_class_info_.module_id, &module);
+    jsb_ensuref(module && err == OK, "JS Module not found: %s", script_class_info_.module_id);
+
+    /* STEP 1, CREATE */
+    GodotJSScriptInstance* instance = memnew(GodotJSScriptInstance);
+
+    instance->owner_ = p_this;
+    instance->script_ = Ref(this); // must set before 'set_script_instance'
+    instance->env_ = env;
+    instance->class_id_ = module->script_class_id;
+    instance->owner_->set_script_instance(instance);
+
+    /* STEP 2, INITIALIZE AND CONSTRUCT */
+    {
+        MutexLock lock(GodotJSScriptLanguage::get_singleton()->mutex_);
+        instances_.insert(instance->owner_);
+    }
+
+    instance->object_id_ = env->crossbind(p_this, instance->class_id_, p_args, p_argcount);
+
+    if (!instance->object_id_)
+    {
+        instance->script_ = Ref<GodotJSScript>();
+        instance->owner_->set_script_instance(nullptr);
+        //NOTE `instance` becomes an invalid pointer since it's deleted in `set_script_instance`
+        {
+            MutexLock lock(GodotJSScriptLanguage::get_singleton()->mutex_);
+            instances_.erase(p_this);
+        }
+        JSB_LOG(Error, "Error constructing a GodotJSScriptInstance");
+        return nullptr;
+    }
+
+    instance->postbind();
+
+    return instance;
+}
+
+Error GodotJSScript::reload(bool p_keep_state)
+{
+    if (!loaded_)
+    {
+        // the module may be changed, the cache is validated again on the next query
+        invalidate_class_cache();
+        return OK;
+    }
+    if (!_is_valid()) return ERR_UNAVAILABLE;
+
+    if (!p_keep_state)
+    {
+        MutexLock lock(GodotJSScriptLanguage::get_singleton()->mutex_);
+        if (instances_.size())
+        {
+            return ERR_ALREADY_IN_USE;
+        }
+    }
+
+    if (!p_keep_state)
+    {
+        //TODO discard the object and crossbind again, but for now we just reload it normally
+    }
+
+    // (common situation) preserve the object and change its prototype
+    const StringName& module_id = script_class_info_.module_id;
+    jsb::JSEnvironment env(get_path(), true);
+
+    //TODO different env has different module state, we need to refresh the state in all envs when marking a module as dirty somewhere
+    const jsb::ModuleReloadResult::Type result = env->mark_as_reloading(module_id);
+    if (result == jsb::ModuleReloadResult::Requested)
+    {
+        //TODO `Callable` objects bound with this script should be invalidated somehow?
+        // ...
+
+        loaded_ = false;
+    }
+    else if (result != jsb::ModuleReloadResult::NoChanges)
+    {
+        JSB_LOG(Warning, "failed to mark module as reloading: %s (%d)", module_id, result);
+    }
+
+    return OK;
+}
+
+#ifdef TOOLS_ENABLED
+#if GODOT_4_4_OR_NEWER
+StringName GodotJSScript::get_doc_class_name() const
+{
+    //TODO not verified
+    const Vector<DocData::ClassDoc> docs = get_documentation();
+    if (!docs.is_empty()) return docs[0].name;
+    return {};
+}
+#endif
+
+Vector<DocData::ClassDoc> GodotJSScript::get_documentation() const
+{
+    ensure_module_loaded();
+    if (!loaded_ || !_is_valid()) return {};
+
+    // the editor asks on every hover, help search and inspector refresh, the cache is dropped when the module is (re)loaded
+    if (!documentation_cached_)
+    {
+        _build_documentation(documentation_cache_);
+        documentation_cached_ = true;
+    }
+    return documentation_cache_;
+}
+
+void GodotJSScript::_build_documentation(Vector<DocData::ClassDoc>& r_docs) const
+{
+    String base_type;
+    const String class_name = GodotJSScriptLanguage::get_singleton()->get_global_class_name(get_path(), &base_type);
+    DocData::ClassDoc class_doc_data;
+
+    class_doc_data.name = class_name;
+    class_doc_data.inherits = base_type.is_empty() ? "Object" : base_type;
+    class_doc_data.is_script_doc = true;
+    class_doc_data.brief_description = script_class_info_.doc.brief_description;
+    class_doc_data.is_deprecated = script_class_info_.doc.is_deprecated;
+    class_doc_data.is_experimental = script_class_info_.doc.is_experimental;
+#if GODOT_4_3_OR_NEWER
+    class_doc_data.deprecated_message = script_class_info_.doc.deprecated_message;
+    class_doc_data.experimental_message = script_class_info_.doc.experimental_message;
+#endif
+    class_doc_data.script_path = get_path();
+    for (const auto& item : script_class_info_.properties)
+    {
+        DocData::PropertyDoc property_doc_data;
+        property_doc_data.name = item.key;
+        property_doc_data.description = item.value.doc.brief_description;
+        property_doc_data.is_deprecated = item.value.doc.is_deprecated;
+        property_doc_data.is_experimental = item.value.doc.is_experimental;
+#if GODOT_4_3_OR_NEWER
+        property_doc_data.deprecated_message = item.value.doc.deprecated_message;
+        property_doc_data.experimental_message = item.value.doc.experimental_message;
+#endif
+        class_doc_data.properties.append(property_doc_data);
+    }
+
+    r_docs.clear();
+    r_docs.append(class_doc_data);
+}
+
+String GodotJSScript::get_class_icon_path() const
+{
+    if (const jsb::StatelessScriptClassInfo* cached = get_cached_class_info()) return cached->icon;
+    ensure_module_loaded();
+    jsb_check(loaded_);
+    return script_class_info_.icon;
+}
+
+PropertyInfo GodotJSScript::get_class_category() const
+{
+    if (get_cached_class_info()) return super::get_class_category();
+    ensure_module_loaded();
+    jsb_check(loaded_);
+    return super::get_class_category();
+}
+#endif // TOOLS_ENABLED
+
+void GodotJSScript::_update_method_set() const
+{
+    // loading a module below bumps the revision, the set is considered stale and rebuilt once more on the next query in this case
+    const uint32_t revision = class_info_revision_.load(std::memory_order_relaxed);
+    method_set_.clear();
+
+    const GodotJSScript* current = this;
+    while (current)
+    {
+        const jsb::StatelessScriptClassInfo* class_info = current->get_cached_class_info();
+        const GodotJSScript* next;
+        if (class_info)
+        {
+            next = current->get_query_base();
+        }
+        else
+        {
+            //TODO temp fix
+            if (!current->loaded_) const_cast<GodotJSScript*>(current)->load_module_immediately();
+            class_info = current->is_valid() ? &current->script_class_info_ : nullptr;
+            next = current->base.ptr();
+        }
+        if (class_info)
+        {
+            for (const KeyValue<StringName, jsb::ScriptMethodInfo>& it : class_info->methods)
+            {
+                method_set_.insert(it.key);
+
+                // the engine name of godot virtuals (e.g. `_unhandledInput` is queried as `_unhandled_input`)
+                const String name = it.key;
+                if (name.begins_with("_"))
+                {
+                    const StringName engine_name = name.to_snake_case();
+                    if (jsb::internal::NamingUtil::get_script_method_name(engine_name) == it.key)
+                    {
+                        method_set_.insert(engine_name);
+                    }
+                }
+            }
+        }
+        current = next;
+    }
+    method_set_revision_ = revision;
+}
+
+bool GodotJSScript::has_method(const StringName& p_method) const
+{
+    if (jsb_unlikely(method_set_revision_ != class_info_revision_.load(std::memory_order_relaxed)))
+    {
+        _update_method_set();
+    }
+    if (method_set_.has(p_method)) return true;
+
+    // the engine names which can't be recovered from the exposed names by `to_snake_case`
+    if (const StringName exposed_name = jsb::internal::NamingUtil::get_script_method_name(p_method);
+        exposed_name != p_method && method_set_.has(exposed_name))
+    {
+        return true;
+    }
+
+    // ensure `_ready` called even if it's not actually defined in scripts
+    if (p_method == SceneStringNames::get_singleton()->_ready)
+    {
+        // only a `Node` class has `_ready` call
+        if (ClassDB::is_parent_class(get_instance_base_type(), jsb_string_name(Node)))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+MethodInfo GodotJSScript::get_method_info(const StringName& p_method) const
+{
+    jsb_check(loaded_ || get_cached_class_info());
+    jsb_check(has_method(p_method));
+    //TODO details?
+    MethodInfo item = {};
+    item.name = p_method;
+    return item;
+}
+
+ScriptLanguage* GodotJSScript::get_language() const
+{
+    return GodotJSScriptLanguage::get_singleton();
+}
+
+bool GodotJSScript::has_script_signal(const StringName& p_signal) const
+{
+    if (const jsb::StatelessScriptClassInfo* cached = get_cached_class_info()) return cached->signals.has(p_signal);
+    return is_valid() ? script_class_info_.signals.has(p_signal) : false;
+}
+
+void GodotJSScript::get_script_signal_list(List<MethodInfo>* r_signals) const
+{
+    const jsb::StatelessScriptClassInfo* class_info = get_cached_class_info();
+    if (!class_info)
+    {
+        if (!is_valid()) return;
+        class_info = &script_class_info_;
+    }
+
+    for (const auto& it : class_info->signals)
+    {
+        //TODO details?
+        MethodInfo item = {};
+        item.name = it.key;
+        r_signals->push_back(item);
+    }
+
+    if (const GodotJSScript* base_script = get_query_base())
+    {
+        base_script->get_script_signal_list(r_signals);
+    }
+}
+
+void GodotJSScript::get_script_method_list(List<MethodInfo>* p_list) const
+{
+    const jsb::StatelessScriptClassInfo* class_info = get_cached_class_info();
+    if (!class_info)
+    {
+        ensure_module_loaded();
+        jsb_check(loaded_);
+        class_info = &script_class_info_;
+    }
+
+    for (const auto& it : class_info->methods)
+    {
+        //TODO details?
+        MethodInfo item = {};
+        item.name = it.key;
+        p_list->push_back(item);
+    }
+
+    if (const GodotJSScript* base_script = get_query_base(); base_script && base_script->is_valid())
+    {
+        base_script->get_script_method_list(p_list);
+    }
+}
+
+void GodotJSScript::get_script_property_list(List<PropertyInfo>* p_list) const
+{
+    const jsb::StatelessScriptClassInfo* class_info = get_cached_class_info();
+    if (!class_info)
+    {
+        ensure_module_loaded();
+        jsb_check(loaded_);
+        class_info = &script_class_info_;
+    }
+
+#ifdef TOOLS_ENABLED
+    p_list->push_back(get_class_category());
+#endif
+    for (const auto& it : class_info->properties)
+    {
+        p_list->push_back((PropertyInfo) it.value);
+    }
+
+    if (const GodotJSScript* base_script = get_query_base(); base_script && base_script->is_valid())
+    {
+        base_script->get_script_property_list(p_list);
+    }
+}
+
+bool GodotJSScript::get_property_default_value(const StringName& p_property, Variant& r_value) const
+{
+#ifdef TOOLS_ENABLED
+    // the default values are restored from the class cache if available (see `_update_exports`)
+    if (get_cached_class_info() && source_changed_cache) const_cast<GodotJSScript*>(this)->_update_exports(nullptr);
+#endif
+    if (!get_cached_class_info()) ensure_module_loaded();
+    if (const HashMap<StringName, Variant>::ConstIterator it = member_default_values_cache.find(p_property))
+    {
+        r_value = it->value;
+        return true;
+    }
+
+    const GodotJSScript* base_script = get_query_base();
+    return base_script && base_script->is_valid()
+        ? base_script->get_property_default_value(p_property, r_value)
+        : false;
+}
+
+#if GODOT_4_5_OR_NEWER
+const Variant GodotJSScript::get_rpc_config() const
+#elif GODOT_4_4_OR_NEWER
+Variant GodotJSScript::get_rpc_config() const
+#else
+const Variant GodotJSScript::get_rpc_config() const
+#endif
+{
+    if (const jsb::StatelessScriptClassInfo* cached = get_cached_class_info()) return cached->rpc_config;
+    ensure_module_loaded();
+    jsb_check(loaded_);
+
+    return script_class_info_.rpc_config;
+}
+
+bool GodotJSScript::has_static_method(const StringName& p_method) const
+{
+    ensure_module_loaded();
+    jsb_check(loaded_);
+    //TODO
+    return false;
+}
+
+bool GodotJSScript::instance_has(const Object* p_this) const
+{
+    jsb_check(loaded_ || get_cached_class_info());
+    MutexLock lock(GodotJSScriptLanguage::get_singleton()->mutex_);
+    return instances_.has(const_cast<Object*>(p_this));
+}
+
+Error GodotJSScript::load_source_code(const String &p_path)
+{
+    Error err;
+#ifdef TOOLS_ENABLED
+	const String source_code = FileAccess::get_file_as_string(p_path, &err);
+#if JSB_WITH_THREADED_SCRIPT_PRELOAD
+    // the compiled module is read in the resource loading thread if it's not the editor
+    if (err == OK && !Thread::is_main_thread() && !Engine::get_singleton()->is_editor_hint())
+    {
+        jsb::ModulePrefetcher::preload(jsb::internal::PathUtil::convert_typescript_path(p_path));
+    }
+#endif
+#else
+
+#if JSB_USE_TYPESCRIPT
+	const String path = jsb::internal::PathUtil::convert_typescript_path(p_path);
+#else
+	const String path = jsb::internal::PathUtil::convert_javascript_path(p_path);
+#endif
+	// the compiled source is not packed as an individual file if the module archive is used
+	const jsb::internal::ModuleArchive* archive = jsb::internal::ModuleArchive::get_packaged();
+	err = OK;
+	String source_code;
+	if (archive && archive->has_file(path))
+	{
+		source_code = archive->get_file_as_string(path);
+	}
+#if JSB_WITH_THREADED_SCRIPT_PRELOAD
+	// read once in the resource loading thread for both the source code and the module evaluated later
+	else if (Vector<uint8_t> bytes; !Thread::is_main_thread() && jsb::ModulePrefetcher::preload(path, &bytes))
+	{
+		source_code.parse_utf8((const char*) bytes.ptr(), bytes.size());
+	}
+#endif
+	else
+	{
+		source_code = FileAccess::get_file_as_string(path, &err);
+	}
+
+#endif
+    if (err != OK)
+    {
+        JSB_LOG(Warning, "can not read source from %s", p_path);
+    }
+    else
+    {
+        set_source_code(source_code);
+    }
+    return err;
+}
+
+void GodotJSScript::load_module_if_missing()
+{
+    if (!loaded_ || _is_valid()) return;
+
+    JSB_LOG(Verbose, "force to load missing script %s", get_path());
+    loaded_ = false;
+    load_module_immediately();
+}
+
+void GodotJSScript::reload_module_immediately()
+{
+    // not loaded yet, it'll be loaded with the latest dependencies on demand
+    if (!loaded_) return;
+
+    JSB_LOG(Verbose, "reload script %s", get_path());
+    loaded_ = false;
+    load_module_immediately();
+}
+
+void GodotJSScript::load_module_immediately()
+{
+    if (loaded_) return;
+    JSB_BENCHMARK_SCOPE(GodotJSScript, load_module);
+
+    const String path = jsb::internal::PathUtil::convert_typescript_path(get_path());
+    jsb::JSEnvironment env(get_path(), true);
+
+    loaded_ = true;
+    base.unref();
+    source_changed_cache = true;
+    invalidate_class_cache();
+    jsb::JavaScriptModule* module;
+    if (const Error err = env->load(path, &module); err != OK)
+    {
+        script_class_info_ = {};
+        save_class_cache(env);
+#ifdef TOOLS_ENABLED
+        if (FileAccess::exists(get_path()) && !FileAccess::exists(path))
+        {
+            JSB_LOG(Error,
+                "the javascript file is missing: %s (source: %s), "
+                "please ensure that all typescript source files have already been compiled "
+                "using the typescript compiler ('tsc').",
+                path, get_path());
+            return;
+        }
+#endif
+        JSB_LOG(Error, "failed to attach module %s (%d)", path, err);
+        return;
+    }
+    jsb_check(module);
+    {
+        const jsb::ScriptClassInfoPtr class_info_ptr = env->find_script_class(module->script_class_id);
+        script_class_info_ = class_info_ptr ? (jsb::StatelessScriptClassInfo) *class_info_ptr : jsb::StatelessScriptClassInfo();
+    }
+    if (_is_valid())
+    {
+        JSB_LOG(VeryVerbose, "GodotJSScript module loaded %s", path);
+        {
+            //TODO a dirty but approaching solution for hot-reloading
+            //TODO will crash if reloading script instances in worker threads
+            MutexLock lock(GodotJSScriptLanguage::get_singleton()->mutex_); // necessary?
+            for (RBSet<Object *>::Element *E = instances_.front(); E;)
+            {
+                RBSet<Object *>::Element *N = E->next();
+                Object* obj = E->get();
+                jsb_check(obj->get_script() == Ref(this));
+                jsb_check(env->verify_object(obj));
+
+                if (ClassDB::is_parent_class(env->get_script_class(module->script_class_id)->native_class_name, obj->get_class_name()))
+                {
+                    env->rebind(obj, module->script_class_id);
+
+                    // the reloaded class may define different properties
+                    if (GodotJSScriptInstanceBase* instance = (GodotJSScriptInstanceBase*) obj->get_script_instance(); instance && !instance->is_shadow())
+                    {
+                        ((GodotJSScriptInstance*) instance)->invalidate_property_cache();
+                    }
+                }
+                else
+                {
+                    JSB_LOG(Warning, "Cannot rebind class %s (%s) on %s, it requires a %s", script_class_info_.js_class_name, script_class_info_.module_id, obj->get_class_name(), env->get_script_class(module->script_class_id)->native_class_name);
+                    obj->set_script(Ref<Script>());
+                }
+
+                E = N;
+            }
+        }
+
+        // setup base script
+        {
+            //TODO do not rely on ResourceLoader
+            if (script_class_info_.base_script_module_id)
+            {
+                jsb::JavaScriptModule* base_module = nullptr;
+                const Error err = env->load(script_class_info_.base_script_module_id, &base_module);
+                jsb_ensuref(base_module && err == OK, "JS Module not found: %s", script_class_info_.base_script_module_id);
+                const Ref<Resource> base_res = ResourceLoader::load(jsb::internal::PathUtil::convert_javascript_path(base_module->source_info.source_filepath));
+                jsb_check(base_res->get_class() == jsb_typename(GodotJSScript));
+                base = base_res;
+            }
+        }
+        // the method sets built while loading are incomplete
+        class_info_revision_.fetch_add(1, std::memory_order_relaxed);
+
+        // update the default value cache
+        update_exports();
+#ifdef TOOLS_ENABLED
+        // temp and tricky workaround to avoid missing doc when showing on inspector the first time after load
+        if (DocTools* doc_tools = EditorHelp::get_doc_data())
+        {
+            const Vector<DocData::ClassDoc> documentations = get_documentation();
+            for (int i = 0; i < documentations.size(); i++)
+            {
+                const DocData::ClassDoc& doc = documentations.get(i);
+                doc_tools->add_doc(doc);
+            }
+        }
+#endif
+        save_class_cache(env);
+        return;
+    }
+    save_class_cache(env);
+    JSB_LOG(Debug, "a stub script loaded which does not contain a GodotJS class %s", path);
+}
+
+PlaceHolderScriptInstance* GodotJSScript::placeholder_instance_create(Object* p_this)
+{
+#ifdef TOOLS_ENABLED
+    if (!is_valid())
+    {
+        JSB_LOG(Warning, "creating placeholder instance on invalid script (%s)", get_path());
+    }
+    PlaceHolderScriptInstance *si = memnew(PlaceHolderScriptInstance(GodotJSScriptLanguage::get_singleton(), Ref<Script>(this), p_this));
+    placeholders.insert(si);
+    _update_exports(si);
+    return si;
+#else
+    return nullptr;
+#endif
+}
+
+#ifdef TOOLS_ENABLED
+void GodotJSScript::_placeholder_erased(PlaceHolderScriptInstance* p_placeholder)
+{
+    placeholders.erase(p_placeholder);
+}
+#endif
+
+void GodotJSScript::update_exports()
+{
+    ensure_module_loaded();
+    jsb_check(loaded_);
+#ifdef TOOLS_ENABLED
+    if (!is_valid()) return;
+    _update_exports(nullptr);
+#endif
+}
+
+void GodotJSScript::_update_exports_values(List<PropertyInfo>& r_props, HashMap<StringName, Variant>& r_values)
+{
+    for (const KeyValue<StringName, Variant> &E : member_default_values_cache)
+    {
+        r_values[E.key] = E.value;
+    }
+
+#ifdef TOOLS_ENABLED
+    r_props.push_back(get_class_category());
+#endif
+    for (const PropertyInfo &E : members_cache)
+    {
+        r_props.push_back(E);
+    }
+
+    if (GodotJSScript* base_script = get_query_base(); base_script && base_script->is_valid())
+    {
+        base_script->_update_exports_values(r_props, r_values);
+    }
+}
+
+Variant GodotJSScript::_new(const Variant** p_args, int p_argcount, Callable::CallError &r_error)
+{
+    ensure_module_loaded();
+    if (!is_valid())
+    {
+        JSB_LOG(Error, "Unable to create new instance. The script was not properly loaded (%s)", get_path());
+        return Variant();
+    }
+
+    r_error.error = Callable::CallError::CALL_OK;
+    Object *owner = ClassDB::instantiate(script_class_info_.native_class_name);
+
+    ScriptInstance *script_instance = instance_construct(owner, false, p_args, p_argcount);
+
+    if (!script_instance)
+    {
+        memdelete(owner);
+        return Variant();
+    }
+
+    return owner;
+}
+
+namespace
+{
+    bool is_same_exports(const List<PropertyInfo>& p_props_a, const HashMap<StringName, Variant>& p_values_a,
+        const List<PropertyInfo>& p_props_b, const HashMap<StringName, Variant>& p_values_b)
+    {
+        if (p_props_a.size() != p_props_b.size() || p_values_a.size() != p_values_b.size()) return false;
+        for (const List<PropertyInfo>::Element *a = p_props_a.front(), *b = p_props_b.front(); a; a = a->next(), b = b->next())
+        {
+            if (!(a->get() == b->get())) return false;
+        }
+        for (const KeyValue<StringName, Variant>& it : p_values_a)
+        {
+            const Variant* value = p_values_b.getptr(it.key);
+            if (!value || !it.value.hash_compare(*value)) return false;
+        }
+        return true;
+    }
+}
+
+bool GodotJSScript::_update_exports(PlaceHolderScriptInstance* p_instance_to_update)
+{
+    // do not crash the engine if the script not loaded successfully
+    if (!is_valid())
+    {
+        JSB_LOG(Error, "script failed to load (%s)", get_path());
+        return false;
+    }
+
+#ifdef TOOLS_ENABLED
+    // the default values can not be restored from the class cache, evaluate them with the loaded module
+    if (class_cache_ && !loaded_ && !class_cache_->has_default_values) ensure_module_loaded();
+#endif
+
+    bool changed = false;
+
+    if (source_changed_cache)
+    {
+        source_changed_cache = false;
+        changed = true;
+
+        members_cache.clear();
+        member_default_values_cache.clear();
+
+#ifdef TOOLS_ENABLED
+        if (const jsb::StatelessScriptClassInfo* cached = get_cached_class_info())
+        {
+            for (const auto& pair : cached->properties)
+            {
+                members_cache.push_back((PropertyInfo) pair.value);
+                member_default_values_cache[pair.key] = class_cache_->default_values.get(pair.key, Variant());
+            }
+        }
+        else
+#endif
+        {
+            jsb::JSEnvironment env(get_path(), true);
+            env->check_internal_state();
+
+            jsb::JavaScriptModule* module = nullptr;
+            const Error err = env->load(script_class_info_.module_id, &module);
+            jsb_ensuref(module && err == OK, "JS Module not found: %s", script_class_info_.module_id);
+
+            if (const jsb::ScriptClassInfoPtr class_info = env->find_script_class(module->script_class_id))
+            {
+                for (const auto& pair : script_class_info_.properties)
+                {
+                    const jsb::ScriptPropertyInfo &pi = pair.value;
+                    members_cache.push_back((PropertyInfo) pi);
+                    // values[pair.key] = jsb_ext_type_convert({}, pi.type);
+
+                    //TODO maybe this behaviour is not expected
+                    Variant default_value;
+                    env->get_default_property_value(*class_info, pi.name, default_value);
+                    member_default_values_cache[pi.name] = default_value;
+                    JSB_LOG(VeryVerbose, "GodotJS script default %s.%s = %s",
+                        _is_valid() ? script_class_info_.js_class_name : "(unknown)",
+                        pi.name,
+                        default_value);
+                }
+            }
+            else
+            {
+                JSB_LOG(Warning, "ScriptClassInfo is invalid, fallback to empty default values (script %s)", get_path());
+                for (const auto& pair : script_class_info_.properties)
+                {
+                    const jsb::ScriptPropertyInfo &pi = pair.value;
+                    members_cache.push_back({ pi.type, pi.name, pi.hint, pi.hint_string, pi.usage, pi.class_name });
+
+                    Variant default_value;
+                    jsb::internal::VariantUtil::construct_variant(default_value, pi.type);
+                    member_default_values_cache[pi.name] = default_value;
+                }
+            }
+        }
+    }
+
+    // the placeholders of the base script are updated by itself, `p_instance_to_update` is only updated with the flattened exports of this script
+    if (GodotJSScript* base_script = get_query_base(); base_script && base_script->_update_exports(nullptr))
+    {
+        changed = true;
+    }
+
+    // computed once per change for all placeholders, instead of flattening the script chain for each placeholder
+    if (changed || !exports_cache_valid_)
+    {
+        List<PropertyInfo> props;
+        HashMap<StringName, Variant> values;
+        _update_exports_values(props, values);
+
+        // e.g. saved without touching any export, the placeholders are not updated at all
+        if (exports_cache_valid_ && is_same_exports(props, values, exports_props_cache_, exports_values_cache_))
+        {
+            changed = false;
+        }
+        else
+        {
+            changed = true;
+            exports_props_cache_ = props;
+            exports_values_cache_ = values;
+            exports_cache_valid_ = true;
+        }
+    }
+
+    if (changed)
+    {
+        for (PlaceHolderScriptInstance *s : placeholders)
+        {
+            s->update(exports_props_cache_, exports_values_cache_);
+        }
+    }
+    else if (p_instance_to_update)
+    {
+        p_instance_to_update->update(exports_props_cache_, exports_values_cache_);
+    }
+
+    return changed;
+}
+
+void GodotJSScript::_bind_methods() {
+    ClassDB::bind_vararg_method(METHOD_FLAGS_DEFAULT, "new", &GodotJSScript::_new, MethodInfo("new"));
+}
+
+void GodotJSScript::reload_from_file()
+{
+    //TODO reload, maybe it's OK?
+    reload(true);
+}
@@ -3,12 +3,17 @@
 
 #include "../compat/jsb_compat.h"
 #include "../bridge/jsb_bridge.h"
+#include "jsb_script_metadata.h"
+#include "jsb_script_class_cache.h"
+
+namespace jsb { struct JSEnvironment; }
 
 class GodotJSScript : public Script
 {
     friend class GodotJSScriptInstance;
     friend class GodotJSScriptInstanceBase;
     friend class GodotJSShadowScriptInstance;
+    friend class GodotJSScriptLanguage;
     typedef Script super;
 
     GDCLASS(GodotJSScript, Script)
@@ -27,6 +32,11 @@ private:
     HashMap<StringName, Variant> member_default_values_cache;
     List<PropertyInfo> members_cache;
 
+    // the exports flattened along the script chain (applied to all placeholders as is), rebuilt only if this or any base script changed
+    bool exports_cache_valid_ = false;
+    List<PropertyInfo> exports_props_cache_;
+    HashMap<StringName, Variant> exports_values_cache_;
+
     // [INTERNAL] a self linked list to all GodotJSScript (lock is required to access)
     // 'script_class_info_' may be got from another environment,
     // so, explicitly load the module again if you want to create a GodotJSScriptInstance (instead of finding from module cache)
@@ -42,11 +52,50 @@ private:
      */
     jsb::StatelessScriptClassInfo script_class_info_;
 
+#ifdef TOOLS_ENABLED
+    // [EDITOR ONLY] the class info persisted on the last load of the module, used only before the module is loaded (see `jsb::ScriptClassCache`)
+    mutable bool class_cache_checked_ = false;
+    mutable std::optional<jsb::ScriptClassCacheEntry> class_cache_;
+    mutable Ref<GodotJSScript> class_cache_base_;
+
+    // [EDITOR ONLY] the docs generated from `script_class_info_` (built once after loaded, Vector is copy-on-write so it's shared with the callers)
+    mutable bool documentation_cached_ = false;
+    mutable Vector<DocData::ClassDoc> documentation_cache_;
+#endif
+
+    // all methods callable on this script (including the inherited ones) by both the exposed names and the engine names,
+    // rebuilt on the first query after any script is (re)loaded since the base scripts may change
+    mutable HashSet<StringName> method_set_;
+    mutable uint32_t method_set_revision_ = 0;
+
+    // bumped whenever the class info of any script changes (0 is reserved for never built)
+    static std::atomic<uint32_t> class_info_revision_;
+
 private:
     void load_module_immediately();
     jsb_force_inline void ensure_module_loaded() const { if (jsb_unlikely(!loaded_)) const_cast<GodotJSScript*>(this)->load_module_immediately(); }
     jsb_force_inline bool _is_valid() const { return jsb::internal::VariantUtil::is_valid_name(script_class_info_.module_id); }
 
+    // the class metadata collected by the exporter, only available before the module is loaded (see `Settings::is_deferred_script_loading`)
+    const jsb::ScriptClassMetadata* get_deferred_metadata() const;
+
+    // the persisted class info, only available in editor before the module is loaded (always null without TOOLS_ENABLED)
+    const jsb::StatelessScriptClassInfo* get_cached_class_info() const;
+
+    // the base script (without loading the module if the class info is cached)
+    GodotJSScript* get_query_base() const;
+
+    // drop the persisted class info in memory (it's checked again on the next query)
+    void invalidate_class_cache();
+
+    // flatten the methods of the script chain into `method_set_`
+    void _update_method_set() const;
+
+#ifdef TOOLS_ENABLED
+    void _build_documentation(Vector<DocData::ClassDoc>& r_docs) const;
+#endif
+    void save_class_cache(jsb::JSEnvironment& p_env);
+
     Variant _new(const Variant** p_args, int p_argcount, Callable::CallError &r_error);
 
     bool _update_exports(PlaceHolderScriptInstance *p_instance_to_update);
@@ -62,6 +111,9 @@ public:
     Error load_source_code(const String &p_path);
     void load_module_if_missing();
 
+    // load the module again and rebind the instances to the latest class (e.g. after some dependencies of the module reloaded)
+    void reload_module_immediately();
+
     // Creates a ScriptInstance (for an existing Godot native object) and associates the ScriptInstance with an existing JS object (instance of the script's JS class).
     ScriptInstance* instance_create(const v8::Local<v8::Object>& p_this, Object* p_owner, bool p_is_temp_allowed);
 
@@ -108,9 +160,9 @@ public:
     // we expect Godot calling this after loaded_?
     // is_valid() will ensure the module is loaded.
     // [INTERNAL] if it's not expected, call `_is_valid` instead.
-    virtual bool is_valid() const override { ensure_module_loaded(); return _is_valid(); }
-    virtual bool is_tool() const override { return is_valid() && script_class_info_.is_tool(); }
-    virtual bool is_abstract() const override { return is_valid() && script_class_info_.is_abstract(); }
+    virtual bool is_valid() const override { if (get_cached_class_info()) return true; ensure_module_loaded(); return _is_valid(); }
+    virtual bool is_tool() const override;
+    virtual bool is_abstract() const override;
 
     virtual ScriptLanguage* get_language() const override;
 
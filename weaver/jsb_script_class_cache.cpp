@@ -0,0 +1,291 @@
+#include "jsb_script_class_cache.h"
+
+#ifdef TOOLS_ENABLED
+#include "../internal/jsb_internal.h"
+#include "../bridge/jsb_environment.h"
+
+namespace jsb
+{
+    namespace
+    {
+        constexpr uint32_t kScriptClassCacheMagic = 0x43534A47; // GJSC
+        constexpr uint32_t kScriptClassCacheVersion = 1;
+
+        Array encode_doc(const ScriptBaseDoc& p_doc)
+        {
+            Array array;
+            array.push_back(p_doc.brief_description);
+            array.push_back(p_doc.deprecated_message);
+            array.push_back(p_doc.experimental_message);
+            array.push_back(p_doc.is_deprecated);
+            array.push_back(p_doc.is_experimental);
+            return array;
+        }
+
+        bool decode_doc(const Variant& p_value, ScriptBaseDoc& r_doc)
+        {
+            if (p_value.get_type() != Variant::ARRAY) return false;
+            const Array array = p_value;
+            if (array.size() != 5) return false;
+            r_doc.brief_description = array[0];
+            r_doc.deprecated_message = array[1];
+            r_doc.experimental_message = array[2];
+            r_doc.is_deprecated = array[3];
+            r_doc.is_experimental = array[4];
+            return true;
+        }
+
+        // whether the value can be restored without any object
+        bool is_plain_value(const Variant& p_value)
+        {
+            switch (p_value.get_type())
+            {
+            case Variant::OBJECT: return p_value.is_null();
+            case Variant::ARRAY:
+                {
+                    const Array array = p_value;
+                    for (int i = 0, n = array.size(); i < n; ++i)
+                    {
+                        if (!is_plain_value(array[i])) return false;
+                    }
+                    return true;
+                }
+            case Variant::DICTIONARY:
+                {
+                    const Dictionary dict = p_value;
+                    for (const KeyValue<Variant, Variant>& kv : dict)
+                    {
+                        if (!is_plain_value(kv.key) || !is_plain_value(kv.value)) return false;
+                    }
+                    return true;
+                }
+            default: return true;
+            }
+        }
+
+        Array encode_class_info(const ScriptClassCacheEntry& p_entry)
+        {
+            const StatelessScriptClassInfo& info = p_entry.class_info;
+            Array methods;
+            for (const KeyValue<StringName, ScriptMethodInfo>& it : info.methods)
+            {
+                methods.push_back(it.key);
+                methods.push_back(it.value.flags);
+                methods.push_back(encode_doc(it.value.doc));
+            }
+
+            Array signals;
+            for (const KeyValue<StringName, ScriptSignalInfo>& it : info.signals)
+            {
+                signals.push_back(it.key);
+            }
+
+            Array properties;
+            for (const auto& it : info.properties)
+            {
+                const ScriptPropertyInfo& property = it.value;
+                properties.push_back(property.name);
+                properties.push_back(property.type);
+                properties.push_back(property.hint);
+                properties.push_back(property.usage);
+                properties.push_back(property.class_name);
+                properties.push_back(property.hint_string);
+                properties.push_back(encode_doc(property.doc));
+                properties.push_back(property.has_literal_default);
+                properties.push_back(property.has_literal_default ? property.default_value : Variant());
+                properties.push_back(property.cache);
+                properties.push_back(property.index);
+            }
+
+            Array array;
+            array.push_back(info.module_id);
+            array.push_back(info.js_class_name);
+            array.push_back(info.native_class_name);
+            array.push_back(info.base_script_module_id);
+            array.push_back(info.icon);
+            array.push_back(encode_doc(info.doc));
+            array.push_back(info.rpc_config);
+            array.push_back(methods);
+            array.push_back(signals);
+            array.push_back(properties);
+            // the default values are evaluated again after the module is loaded
+            array.push_back(info.flags & ~ScriptClassFlags::_Evaluated);
+            array.push_back(p_entry.base_script_path);
+            const bool has_default_values = p_entry.has_default_values && is_plain_value(p_entry.default_values);
+            array.push_back(has_default_values);
+            array.push_back(has_default_values ? p_entry.default_values : Dictionary());
+            return array;
+        }
+
+        bool decode_class_info(const Variant& p_value, ScriptClassCacheEntry& r_entry)
+        {
+            if (p_value.get_type() != Variant::ARRAY) return false;
+            const Array array = p_value;
+            if (array.size() != 14) return false;
+
+            StatelessScriptClassInfo& info = r_entry.class_info;
+            info.module_id = array[0];
+            info.js_class_name = array[1];
+            info.native_class_name = array[2];
+            info.base_script_module_id = array[3];
+            info.icon = array[4];
+            if (!decode_doc(array[5], info.doc)) return false;
+            info.rpc_config = array[6];
+
+            const Array methods = array[7];
+            if (methods.size() % 3 != 0) return false;
+            for (int i = 0, n = methods.size(); i < n; i += 3)
+            {
+                ScriptMethodInfo& method = info.methods.insert(methods[i], {})->value;
+                method.flags = (ScriptMethodFlags::Type) (int) methods[i + 1];
+                if (!decode_doc(methods[i + 2], method.doc)) return false;
+            }
+
+            const Array signals = array[8];
+            for (int i = 0, n = signals.size(); i < n; ++i)
+            {
+                info.signals.insert(signals[i], {});
+            }
+
+            const Array properties = array[9];
+            if (properties.size() % 11 != 0) return false;
+            for (int i = 0, n = properties.size(); i < n; i += 11)
+            {
+                const StringName name = properties[i];
+                ScriptPropertyInfo& property = info.properties.insert(name, {})->value;
+                property.name = name;
+                property.type = (Variant::Type) (int) properties[i + 1];
+                property.hint = (PropertyHint) (int) properties[i + 2];
+                property.usage = properties[i + 3];
+                property.class_name = properties[i + 4];
+                property.hint_string = properties[i + 5];
+                if (!decode_doc(properties[i + 6], property.doc)) return false;
+                property.has_literal_default = properties[i + 7];
+                property.default_value = properties[i + 8];
+                property.cache = properties[i + 9];
+                property.index = properties[i + 10];
+            }
+
+            info.flags = (ScriptClassFlags::Type) (int) array[10];
+            r_entry.base_script_path = array[11];
+            r_entry.has_default_values = array[12];
+            r_entry.default_values = array[13];
+            return true;
+        }
+    }
+
+    String ScriptClassCache::get_cache_dir()
+    {
+        return internal::Settings::get_jsb_out_res_path().path_join(".classcache");
+    }
+
+    String ScriptClassCache::get_cache_path(const String& p_module_path)
+    {
+        return get_cache_dir().path_join(p_module_path.md5_text() + ".bin");
+    }
+
+    uint64_t ScriptClassCache::get_source_hash(const String& p_module_path)
+    {
+        Error err;
+        const Vector<uint8_t> source = FileAccess::get_file_as_bytes(p_module_path, &err);
+        if (err != OK) return 0;
+        return internal::ContentHash::compute(source.ptr(), source.size(), (uint64_t) source.size());
+    }
+
+    bool ScriptClassCache::load(const String& p_module_path, ScriptClassCacheEntry& r_entry)
+    {
+        const Ref<FileAccess> file = FileAccess::open(get_cache_path(p_module_path), FileAccess::READ);
+        if (file.is_null()) return false;
+        if (file->get_32() != kScriptClassCacheMagic || file->get_32() != kScriptClassCacheVersion) return false;
+
+        // the module itself is the first dependency
+        const uint32_t num = file->get_32();
+        for (uint32_t i = 0; i < num; ++i)
+        {
+            const String path = file->get_pascal_string();
+            const uint64_t hash = file->get_64();
+            if (file->eof_reached() || (i == 0 && path != p_module_path)) return false;
+            if (hash == 0 || get_source_hash(path) != hash)
+            {
+                JSB_LOG(Verbose, "outdated script class cache %s (%s changed)", p_module_path, path);
+                return false;
+            }
+        }
+
+        r_entry = {};
+        if (num == 0 || !decode_class_info(file->get_var(), r_entry))
+        {
+            JSB_LOG(Warning, "corrupted script class cache %s", p_module_path);
+            r_entry = {};
+            return false;
+        }
+        return true;
+    }
+
+    void ScriptClassCache::save(const String& p_module_path, const Vector<String>& p_dependencies, const ScriptClassCacheEntry& p_entry)
+    {
+        const String cache_dir = get_cache_dir();
+        if (!DirAccess::exists(cache_dir) && DirAccess::make_dir_recursive_absolute(cache_dir) != OK)
+        {
+            JSB_LOG(Verbose, "script class cache is not writable %s", cache_dir);
+            return;
+        }
+        const Ref<FileAccess> file = FileAccess::open(get_cache_path(p_module_path), FileAccess::WRITE);
+        if (file.is_null()) return;
+
+        file->store_32(kScriptClassCacheMagic);
+        file->store_32(kScriptClassCacheVersion);
+        file->store_32((uint32_t) p_dependencies.size() + 1);
+        file->store_pascal_string(p_module_path);
+        file->store_64(get_source_hash(p_module_path));
+        for (const String& path : p_dependencies)
+        {
+            file->store_pascal_string(path);
+            file->store_64(get_source_hash(path));
+        }
+        file->store_var(encode_class_info(p_entry));
+        JSB_LOG(VeryVerbose, "script class cache saved %s", p_module_path);
+    }
+
+    void ScriptClassCache::save(Environment* p_env, const String& p_module_path, const StatelessScriptClassInfo& p_class_info, const HashMap<StringName, Variant>* p_default_values)
+    {
+        ScriptClassCacheEntry entry;
+        entry.class_info = p_class_info;
+
+        // the class info depends on the whole chain of the base script classes
+        Vector<String> dependencies;
+        StringName base_module_id = p_class_info.base_script_module_id;
+        while (internal::VariantUtil::is_valid_name(base_module_id))
+        {
+            JavaScriptModule* base_module = nullptr;
+            if (p_env->load(base_module_id, &base_module) != OK || !base_module) return;
+            if (dependencies.is_empty())
+            {
+                entry.base_script_path = internal::PathUtil::convert_javascript_path(base_module->source_info.source_filepath);
+            }
+            dependencies.push_back(base_module->source_info.source_filepath);
+            const ScriptClassInfoPtr base_class_info = p_env->find_script_class(base_module->script_class_id);
+            base_module_id = base_class_info ? base_class_info->base_script_module_id : StringName();
+        }
+
+        if (p_default_values)
+        {
+            for (const KeyValue<StringName, Variant>& it : *p_default_values)
+            {
+                entry.default_values[it.key] = it.value;
+            }
+            entry.has_default_values = true;
+        }
+        save(p_module_path, dependencies, entry);
+    }
+
+    void ScriptClassCache::remove(const String& p_module_path)
+    {
+        const String path = get_cache_path(p_module_path);
+        if (FileAccess::exists(path))
+        {
+            DirAccess::remove_absolute(path);
+        }
+    }
+}
+#endif
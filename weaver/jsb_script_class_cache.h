@@ -0,0 +1,58 @@
+#ifndef GODOTJS_SCRIPT_CLASS_CACHE_H
+#define GODOTJS_SCRIPT_CLASS_CACHE_H
+#include "../compat/jsb_compat.h"
+#include "../bridge/jsb_class_info.h"
+
+#ifdef TOOLS_ENABLED
+namespace jsb
+{
+    // the parsed class info of a script module (as it was when the module was loaded last time)
+    struct ScriptClassCacheEntry
+    {
+        StatelessScriptClassInfo class_info;
+
+        // resource path of the base script (empty if the class does not extend a script class)
+        String base_script_path;
+
+        // the evaluated default values of properties (for placeholder instances), not available if any of them is not serializable (e.g. objects)
+        Dictionary default_values;
+        bool has_default_values = false;
+    };
+
+    /**
+     * Persistent storage of the parsed class info of script modules (one file for each module, keyed by the module path).
+     * An entry is valid only if the compiled sources of the module and all its base script modules are not changed (by content hash),
+     * it lets the editor answer the queries on the class info (property/method/signal list) without evaluating the module.
+     * @note the default values are cached only if they are plain values (objects can not be restored without the module)
+     */
+    struct ScriptClassCache
+    {
+        // read the cached class info of a module, return false if not available or outdated
+        static bool load(const String& p_module_path, ScriptClassCacheEntry& r_entry);
+
+        /**
+         * write the class info of a module (silently ignored if the cache directory is not writable)
+         * \param p_dependencies module paths of the base script classes (the module itself is always included)
+         */
+        static void save(const String& p_module_path, const Vector<String>& p_dependencies, const ScriptClassCacheEntry& p_entry);
+
+        /**
+         * write the class info of a module loaded in `p_env` (the base script modules are resolved in it)
+         * \param p_default_values the evaluated default values of properties, null if not available
+         */
+        static void save(Environment* p_env, const String& p_module_path, const StatelessScriptClassInfo& p_class_info, const HashMap<StringName, Variant>* p_default_values);
+
+        // remove the cache of a module (e.g. the module failed to load)
+        static void remove(const String& p_module_path);
+
+    private:
+        static String get_cache_dir();
+        static String get_cache_path(const String& p_module_path);
+
+        // content hash of the module source file, 0 if not readable
+        static uint64_t get_source_hash(const String& p_module_path);
+    };
+}
+#endif
+
+#endif
@@ -1,21 +1,31 @@
 #include "jsb_script_instance.h"
 #include "jsb_script_language.h"
 
-GodotJSScriptInstanceBase::ScriptCallProfilingScope::ScriptCallProfilingScope(const ScriptProfilingInfo& p_info, const StringName& p_method)
-            : info_(p_info), method_(p_method)
+#if JSB_WITH_PROFILING
+GodotJSScriptInstanceBase::ScriptCallProfilingScope::ScriptCallProfilingScope(uint32_t p_id)
+            : id_(p_id)
 {
     start_time_ = OS::get_singleton()->get_ticks_usec();
 }
 
 GodotJSScriptInstanceBase::ScriptCallProfilingScope::~ScriptCallProfilingScope()
 {
-    GodotJSScriptLanguage::get_singleton()->add_script_call_profile_info(
-        info_.path_,
-        info_.class_,
-        method_,
-        OS::get_singleton()->get_ticks_usec() - start_time_);
+    GodotJSScriptLanguage::get_singleton()->add_script_call_profile_info(id_, OS::get_singleton()->get_ticks_usec() - start_time_);
 }
 
+uint32_t GodotJSScriptInstanceBase::get_profile_id(const StringName& p_method, jsb::ScriptVirtualMethod::Type p_vm)
+{
+    uint32_t* slot = p_vm != jsb::ScriptVirtualMethod::kNum
+        ? &profiling_info_.virtual_ids_[p_vm]
+        : &profiling_info_.method_ids_[p_method];
+    if (jsb_unlikely(*slot == 0))
+    {
+        *slot = GodotJSScriptLanguage::get_singleton()->get_script_call_profile_id(profiling_info_.path_, profiling_info_.class_, p_method) + 1;
+    }
+    return *slot - 1;
+}
+#endif
+
 GodotJSScriptInstanceBase::~GodotJSScriptInstanceBase()
 {
     jsb_check(owner_);
@@ -37,45 +47,107 @@ jsb::ScriptClassInfoPtr GodotJSScriptInstance::get_script_class() const
 
 void GodotJSScriptInstance::postbind()
 {
-    // Store initial value for cached props
-    for (auto& it : this->script_->script_class_info_.properties)
+    // Store initial value for cached props (read in a single scope)
+    LocalVector<const jsb::ScriptPropertyInfo*> cached_properties;
+    for (const auto& it : this->script_->script_class_info_.properties)
     {
         if (it.value.cache)
         {
-            Variant value;
-            env_->get_script_property_value(object_id_, it.value, value);
-            property_cache_.insert(it.key, value);
+            cached_properties.push_back(&it.value);
         }
     }
+    if (cached_properties.is_empty()) return;
+
+    LocalVector<Variant> values;
+    env_->get_script_property_values(object_id_, cached_properties, values);
+    for (uint32_t index = 0, num = cached_properties.size(); index < num; ++index)
+    {
+        property_cache_.insert(cached_properties[index]->name, { values[index], 0 });
+    }
 }
 
 void GodotJSScriptInstance::cache_property(const StringName& name, const Variant& value)
 {
-    property_cache_.insert(name, value);
+    property_cache_.insert(name, { value, 0 });
+}
+
+void GodotJSScriptInstance::invalidate_property_cache(const StringName& p_name)
+{
+    if (p_name == StringName()) property_cache_.clear();
+    else property_cache_.erase(p_name);
+}
+
+void GodotJSScriptInstance::bind_property_slot(uint32_t p_index, uint32_t p_num, const Variant& p_value)
+{
+    jsb_check(p_index < p_num);
+    if (property_slotted_.size() != p_num)
+    {
+        property_slots_.resize(p_num);
+        property_slotted_.resize(p_num);
+        for (bool& slotted : property_slotted_) slotted = false;
+    }
+    property_slotted_[p_index] = true;
+    property_slots_[p_index] = p_value;
 }
 
 bool GodotJSScriptInstance::set(const StringName& p_name, const Variant& p_value)
 {
     if (const auto& it = script_->script_class_info_.properties.find(p_name); it)
     {
-        return env_->set_script_property_value(object_id_, it->value, p_value);
+        if (Variant* slot = get_property_slot(it->value.index))
+        {
+            *slot = p_value;
+            return true;
+        }
+
+        // write-through, readable without calling into JS before the value is really applied
+        if (it->value.cache)
+        {
+            property_cache_.insert(p_name, { p_value, 0 });
+        }
+        else if (script_->script_class_info_.is_cached_exports())
+        {
+            property_cache_.insert(p_name, { p_value, env_->get_script_epoch() });
+        }
+
+        // deferred if it's not called from scripts (e.g. restoring the states of a scene), and applied with the other values in a single scope
+        return env_->set_script_property_value_deferred(object_id_, class_id_, it->value, p_value);
     }
     return false;
 }
 
 bool GodotJSScriptInstance::get(const StringName& p_name, Variant& r_ret) const
 {
-    const Variant* cached_value = property_cache_.getptr(p_name);
+    const auto& it = script_->script_class_info_.properties.find(p_name);
+    if (it)
+    {
+        if (const Variant* slot = get_property_slot(it->value.index))
+        {
+            r_ret = *slot;
+            return true;
+        }
+    }
 
-    if (cached_value)
+    if (const CachedPropertyValue* cached_value = property_cache_.getptr(p_name);
+        cached_value && (cached_value->epoch == 0 || cached_value->epoch == env_->get_script_epoch()))
     {
-        r_ret = *cached_value;
+        r_ret = cached_value->value;
         return true;
     }
 
-    if (const auto& it = script_->script_class_info_.properties.find(p_name); it)
+    if (it)
     {
-        return env_->get_script_property_value(object_id_, it->value, r_ret);
+        if (!env_->get_script_property_value(object_id_, it->value, r_ret))
+        {
+            return false;
+        }
+
+        // valid until any script runs (reading properties does not count)
+        if (!it->value.cache && script_->script_class_info_.is_cached_exports())
+        {
+            property_cache_.insert(p_name, { r_ret, env_->get_script_epoch() });
+        }
+        return true;
     }
 
     return false;
@@ -94,7 +166,7 @@ const Variant GodotJSScriptInstance::get_rpc_config() const
 Variant::Type GodotJSScriptInstance::get_property_type(const StringName& p_name, bool* r_is_valid) const
 {
     const jsb::ScriptClassInfoPtr class_info = get_script_class();
-    if (const HashMap<StringName, jsb::ScriptPropertyInfo>::ConstIterator it = class_info->properties.find(p_name))
+    if (const auto* it = class_info->properties.find(p_name))
     {
         if (r_is_valid) *r_is_valid = true;
         return it->value.type;
@@ -127,18 +199,48 @@ void GodotJSScriptInstance::get_method_list(List<MethodInfo>* p_list) const
 
 bool GodotJSScriptInstance::has_method(const StringName& p_method) const
 {
+    // `_ready` is excluded since it's always considered existing for Node classes (see GodotJSScript::has_method)
+    if (const jsb::ScriptVirtualMethod::Type vm = jsb::ScriptVirtualMethod::find(p_method);
+        vm != jsb::ScriptVirtualMethod::kNum && vm != jsb::ScriptVirtualMethod::VM_ready)
+    {
+        return get_script_class()->has_virtual_method(vm);
+    }
     return script_->has_method(p_method);
 }
 
 Variant GodotJSScriptInstance::callp(const StringName& p_method, const Variant** p_args, int p_argcount, Callable::CallError& r_error)
 {
-#if JSB_DEBUG
-    if (profiling_info_.path_.is_empty())
+    const jsb::ScriptVirtualMethod::Type vm = jsb::ScriptVirtualMethod::find(p_method);
+    if (vm != jsb::ScriptVirtualMethod::kNum)
+    {
+        const jsb::ScriptClassInfoPtr script_class = get_script_class();
+
+        // return immediately for unimplemented virtuals without entering any JS scope (`_ready` always needs the prelude call)
+        if (vm != jsb::ScriptVirtualMethod::VM_ready && !script_class->has_virtual_method(vm))
+        {
+            r_error.error = Callable::CallError::CALL_ERROR_INVALID_METHOD;
+            return {};
+        }
+
+        // `_process` of a batched script class is dispatched along with all other instances later in this frame
+        if (vm == jsb::ScriptVirtualMethod::VM_process && script_class->is_batched() && p_argcount == 1 && env_->is_caller_thread())
+        {
+            env_->enqueue_batched_process(class_id_, object_id_, *p_args[0]);
+            r_error.error = Callable::CallError::CALL_OK;
+            return {};
+        }
+    }
+#if JSB_WITH_PROFILING
+    if (jsb_unlikely(GodotJSScriptLanguage::get_singleton()->is_profiling()))
     {
-        profiling_info_.path_ = script_->get_path();
-        profiling_info_.class_ = get_script_class()->js_class_name;
+        if (profiling_info_.path_.is_empty())
+        {
+            profiling_info_.path_ = script_->get_path();
+            profiling_info_.class_ = get_script_class()->js_class_name;
+        }
+        const ScriptCallProfilingScope profiling_scope(get_profile_id(p_method, vm));
+        return env_->call_script_method(class_id_, object_id_, p_method, p_args, p_argcount, r_error);
     }
-    ScriptCallProfilingScope profiling_scope(profiling_info_, p_method);
 #endif
     return env_->call_script_method(class_id_, object_id_, p_method, p_args, p_argcount, r_error);
 }
@@ -157,7 +259,12 @@ void GodotJSScriptInstance::notification(int p_notification, bool p_reversed)
     // since `NOTIFICATION_READY` is not reversed, `notification` will be posted after `callp`.
     // so, we can't `call_prelude` here with `NOTIFICATION_READY`
 
-    //TODO find the method named `_notification`, cal it with `p_notification` as `argv`
+    // skip the dispatch if `_notification` is not implemented at all
+    if (!get_script_class()->has_virtual_method(jsb::ScriptVirtualMethod::VM_notification))
+    {
+        return;
+    }
+
     //TODO call it at all type levels? @seealso `GDScriptInstance::notification`
     Variant value = p_notification;
     const Variant* argv[] = {&value};
@@ -12,23 +12,29 @@ protected:
     {
         String path_;
         StringName class_;
+
+        // the (id + 1) of profile counters of the methods, 0 if not registered yet
+        uint32_t virtual_ids_[jsb::ScriptVirtualMethod::kNum] = {};
+        HashMap<StringName, uint32_t> method_ids_;
     };
 
     struct ScriptCallProfilingScope
     {
-        const ScriptProfilingInfo& info_;
-        StringName method_;
+        uint32_t id_;
         uint64_t start_time_;
 
-        ScriptCallProfilingScope(const ScriptProfilingInfo& p_info, const StringName& p_method);
+        ScriptCallProfilingScope(uint32_t p_id);
         ~ScriptCallProfilingScope();
     };
 
 protected:
     Object* owner_ = nullptr;
     Ref<GodotJSScript> script_;
-#if JSB_DEBUG
+#if JSB_WITH_PROFILING
     ScriptProfilingInfo profiling_info_;
+
+    // the id of the profile counter of a method (`p_vm` is the virtual method index of `p_method` if it's a virtual method)
+    uint32_t get_profile_id(const StringName& p_method, jsb::ScriptVirtualMethod::Type p_vm);
 #endif
 
 public:
@@ -126,7 +132,22 @@ private:
     // object handle (the JS object binding id)
     jsb::NativeObjectID object_id_;
 
-    HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator> property_cache_;
+    struct CachedPropertyValue
+    {
+        Variant value;
+
+        // the script epoch (see Environment::get_script_epoch) when the value was read or assigned by the engine,
+        // valid only if no script has run since then. 0 if it's updated by scripts (@export.cache), always valid.
+        uint64_t epoch = 0;
+    };
+
+    // the exported property values readable without calling into JS (write-through on `set`)
+    mutable HashMap<Variant, CachedPropertyValue, VariantHasher, StringLikeVariantComparator> property_cache_;
+
+    // [exported_property_slots] values of the slotted exported fields (indexed by ScriptPropertyInfo::index),
+    // the JS object accesses them through native accessors, so that the engine reads/writes them without entering JS
+    LocalVector<Variant> property_slots_;
+    LocalVector<bool> property_slotted_;
 
 private:
     jsb::ScriptClassInfoPtr get_script_class() const;
@@ -140,6 +161,23 @@ public:
     void postbind();
     void cache_property(const StringName& name, const Variant& value);
 
+    // invalidate the cached value of a property (all of them if `p_name` is empty)
+    void invalidate_property_cache(const StringName& p_name = StringName());
+
+    // store the exported property at `p_index` in a native slot (of `p_num` slots in total), initialized with `p_value`
+    void bind_property_slot(uint32_t p_index, uint32_t p_num, const Variant& p_value);
+
+    // nullptr if the exported property is not slotted
+    jsb_force_inline Variant* get_property_slot(uint32_t p_index)
+    {
+        return p_index < property_slotted_.size() && property_slotted_[p_index] ? &property_slots_[p_index] : nullptr;
+    }
+
+    jsb_force_inline const Variant* get_property_slot(uint32_t p_index) const
+    {
+        return p_index < property_slotted_.size() && property_slotted_[p_index] ? &property_slots_[p_index] : nullptr;
+    }
+
 #pragma region ScriptIntance Implementation
 
     virtual bool set(const StringName& p_name, const Variant& p_value) override;
@@ -1,626 +1,956 @@
-#include "jsb_script_language.h"
-
-#include <iterator>
-
-#include "jsb_monitor.h"
-#include "../jsb_project_preset.h"
-#include "../internal/jsb_internal.h"
-#include "../bridge/jsb_worker.h"
-
-#include "jsb_script.h"
-
-#ifdef TOOLS_ENABLED
-#include "../weaver-editor/templates/templates.gen.h"
-#endif
-
-GodotJSScriptLanguage* GodotJSScriptLanguage::singleton_ = nullptr;
-
-namespace jsb
-{
-    void JSEnvironment::init()
-    {
-        if (is_shadow_ && !target_)
-        {
-            target_ = GodotJSScriptLanguage::get_singleton()->create_shadow_environment();
-        }
-    }
-
-    JSEnvironment::JSEnvironment(const String& p_path_hint, bool p_is_shadow_allowed)
-    {
-        target_ = jsb::Environment::_access();
-        if (target_)
-        {
-            is_shadow_ = false;
-        }
-        else
-        {
-            jsb_ensuref(p_is_shadow_allowed, "no available Environment on thread %d for %s: %s", Thread::get_caller_id(), jsb_typename(GodotJSScript), p_path_hint);
-            is_shadow_ = true;
-        }
-    }
-
-    JSEnvironment::~JSEnvironment()
-    {
-        if (is_shadow_ && target_)
-        {
-            GodotJSScriptLanguage::get_singleton()->destroy_shadow_environment(target_);
-        }
-    }
-}
-
-GodotJSScriptLanguage::GodotJSScriptLanguage()
-{
-    JSB_BENCHMARK_SCOPE(GodotJSScriptLanguage, Construct);
-    jsb_check(!singleton_);
-    singleton_ = this;
-    js_class_name_matcher1_ = RegEx::create_from_string(R"(\s*exports.default\s*=\s*class\s*(\w+)\s+extends\s+(\w+))");
-    js_class_name_matcher2_ = RegEx::create_from_string(R"(\s*exports.default\s*=\s*(\w+)\s*;?)");
-    ts_class_name_matcher_ = RegEx::create_from_string(R"(\s*(@[tT]ool\s*\(\s*\)\s*\n*\s*)?export\s+default\s+class\s+(\w+)(\s*<)?[^\n]*(?:>|\s+)extends\s+(\w+))");
-    jsb::internal::StringNames::create();
-}
-
-GodotJSScriptLanguage::~GodotJSScriptLanguage()
-{
-    jsb::internal::StringNames::free();
-    jsb_check(singleton_ == this);
-    singleton_ = nullptr;
-
-    //TODO manage script list in a safer way (access and ref with script.id)
-    MutexLock lock(mutex_);
-    while (SelfList<GodotJSScript>* script_el = script_list_.first())
-    {
-        script_el->remove_from_list();
-    }
-}
-
-void GodotJSScriptLanguage::init()
-{
-    if (once_inited_) return;
-
-    JSB_BENCHMARK_SCOPE(GodotJSScriptLanguage, init);
-    once_inited_ = true;
-    JSB_LOG(Verbose, "Runtime: %s", JSB_IMPL_VERSION_STRING);
-    JSB_LOG(VeryVerbose, "jsb lang init");
-
-    jsb::Environment::CreateParams params;
-    params.initial_class_slots = (int) ClassDB::classes.size() + JSB_MASTER_INITIAL_CLASS_EXTRA_SLOTS;
-    params.initial_object_slots = JSB_MASTER_INITIAL_OBJECT_SLOTS;
-    params.initial_script_slots = JSB_MASTER_INITIAL_SCRIPT_SLOTS;
-    params.debugger_port = jsb::internal::Settings::get_debugger_port();
-    params.thread_id = Thread::get_caller_id();
-
-    // main environment
-    environment_ = std::make_shared<jsb::Environment>(params);
-    environment_->init();
-
-    if (const String entry_script_path = jsb::internal::Settings::get_entry_script_path();
-        !entry_script_path.is_empty())
-    {
-        environment_->load(entry_script_path);
-    }
-
-#if JSB_DEBUG
-    if (jsb::compat::Performance::get_singleton()) monitor_ = memnew(GodotJSMonitor);
-#endif
-}
-
-void GodotJSScriptLanguage::finish()
-{
-    jsb_check(once_inited_);
-#if JSB_DEBUG
-    if (monitor_) memdelete(monitor_);
-#endif
-    once_inited_ = false;
-    environment_->dispose();
-    environment_.reset();
-#if !JSB_WITH_WEB && !JSB_WITH_JAVASCRIPTCORE
-    jsb::Worker::finish();
-#endif
-    {
-        std::vector<ShadowEnvironment> shadow_environments;
-        {
-            MutexLock shadow_lock(shadow_mutex_);
-            shadow_environments = shadow_environments_;
-            shadow_environments_.clear();
-        }
-        for (const ShadowEnvironment& env : shadow_environments)
-        {
-            env.holder->dispose();
-        }
-    }
-    JSB_LOG(VeryVerbose, "jsb lang finish");
-}
-
-void GodotJSScriptLanguage::frame()
-{
-    const uint64_t base_ticks = Engine::get_singleton()->get_frame_ticks();
-    const uint64_t elapsed_milli = (base_ticks - last_ticks_) / 1000ULL; // milliseconds
-
-    last_ticks_ = base_ticks;
-    environment_->update(elapsed_milli);
-
-#if JSB_DEBUG
-    {
-        MutexLock lock(mutex_);
-        if (profile_info_map_.enabled)
-        {
-            for (auto& class_kv : profile_info_map_.classes)
-            {
-                for (auto& method_kv : class_kv.value.methods)
-                {
-                    method_kv.value.last_frame_calls = method_kv.value.frame_calls;
-                    method_kv.value.last_frame_time = method_kv.value.frame_time;
-                    method_kv.value.frame_calls = 0;
-                    method_kv.value.frame_time = 0;
-                }
-            }
-        }
-    }
-#endif
-}
-
-struct JavaScriptControlFlowKeywords
-{
-    HashSet<String> values;
-    jsb_force_inline JavaScriptControlFlowKeywords()
-    {
-        constexpr static const char* _keywords[] =
-        {
-            "if", "else", "switch", "case", "do", "while", "for", "foreach",
-            "return", "break", "continue",
-            "try", "throw", "catch", "finally",
-        };
-        for (size_t index = 0; index < ::std::size(_keywords); ++index)
-        {
-            values.insert(_keywords[index]);
-        }
-    }
-};
-
-bool GodotJSScriptLanguage::is_control_flow_keyword(ConstStringRefCompat p_keyword) const
-{
-    static JavaScriptControlFlowKeywords collection;
-    return collection.values.has(p_keyword);
-}
-
-Vector<String> GodotJSScriptLanguage::get_reserved_words() const
-{
-    return Vector<String> {
-        "return", "function", "interface", "class", "let", "break", "as", "any", "switch", "case", "if", "enum",
-        "throw", "else", "var", "number", "string", "get", "module", "instanceof", "typeof", "public", "private",
-        "while", "void", "null", "super", "this", "new", "in", "await", "async", "extends", "static",
-        "package", "implements", "interface", "continue", "yield", "const", "export", "finally", "for",
-        "import", "byte", "delete", "goto",
-        "default",
-    };
-}
-
-#if GODOT_4_5_OR_NEWER
-Vector<String> GodotJSScriptLanguage::get_doc_comment_delimiters() const
-{
-    return Vector<String> { "///" };
-}
-
-Vector<String> GodotJSScriptLanguage::get_comment_delimiters() const
-{
-    return Vector<String> { "//", "/* */" };
-}
-
-Vector<String> GodotJSScriptLanguage::get_string_delimiters() const
-{
-    return Vector<String> { "' '", "\" \"", "` `" };
-}
-#else
-void GodotJSScriptLanguage::get_reserved_words(List<String>* p_words) const
-{
-    for (String keyword : get_reserved_words())
-    {
-        p_words->push_back(keyword);
-    }
-}
-
-void GodotJSScriptLanguage::get_doc_comment_delimiters(List<String>* p_delimiters) const
-{
-    p_delimiters->push_back("///");
-}
-
-void GodotJSScriptLanguage::get_comment_delimiters(List<String>* p_delimiters) const
-{
-    p_delimiters->push_back("//");
-    p_delimiters->push_back("/* */");
-}
-
-void GodotJSScriptLanguage::get_string_delimiters(List<String>* p_delimiters) const
-{
-    p_delimiters->push_back("' '");
-    p_delimiters->push_back("\" \"");
-    p_delimiters->push_back("` `");
-}
-#endif
-
-//TODO this virtual method seems never used in godot?
-Script* GodotJSScriptLanguage::create_script() const
-{
-    return memnew(GodotJSScript);
-}
-
-bool GodotJSScriptLanguage::validate(const String& p_script, const String& p_path, List<String>* r_functions, List<ScriptError>* r_errors, List<Warning>* r_warnings, HashSet<int>* r_safe_lines) const
-{
-    if (environment_->validate_script(p_path))
-    {
-        return true;
-    }
-
-    //TODO parse error info
-    ScriptError err;
-    err.line = 0;
-    err.column = 0;
-    err.message = "NOT_IMPLEMENTED";
-    r_errors->push_back(err);
-    return false;
-}
-
-Ref<Script> GodotJSScriptLanguage::make_template(const String& p_template, const String& p_class_name, const String& p_base_class_name) const
-{
-    Ref<GodotJSScript> spt;
-    spt.instantiate();
-    String processed_template = p_template;
-    processed_template = processed_template.replace("_BASE_", p_base_class_name)
-                                 .replace("_CLASS_SNAKE_CASE_", jsb::internal::VariantUtil::to_snake_case_id(p_class_name))
-                                 .replace("_CLASS_", jsb::internal::VariantUtil::to_pascal_case_id(p_class_name))
-                                 .replace("_TS_", jsb::internal::Settings::get_indentation());
-    spt->set_source_code(processed_template);
-    return spt;
-}
-
-Vector<ScriptLanguage::ScriptTemplate> GodotJSScriptLanguage::get_built_in_templates(ConstStringNameRefCompat p_object)
-{
-    Vector<ScriptTemplate> templates;
-#ifdef TOOLS_ENABLED
-    for (int i = 0; i < TEMPLATES_ARRAY_SIZE; i++) {
-        if (TEMPLATES[i].inherit == p_object) {
-            templates.append(TEMPLATES[i]);
-        }
-    }
-#endif
-    return templates;
-}
-
-#if GODOT_4_3_OR_NEWER
-void GodotJSScriptLanguage::reload_scripts(const Array& p_scripts, bool p_soft_reload)
-{
-    JSB_LOG(Verbose, "TODO [GodotJSScriptLanguage::reload_scripts] NOT IMPLEMENTED");
-}
-
-void GodotJSScriptLanguage::profiling_set_save_native_calls(bool p_enable)
-{
-    JSB_LOG(Verbose, "TODO [GodotJSScriptLanguage::profiling_set_save_native_calls] NOT IMPLEMENTED");
-}
-#endif
-
-void GodotJSScriptLanguage::reload_all_scripts()
-{
-    //TODO temporarily ignored because it's only called from `RemoteDebugger`
-    JSB_LOG(Verbose, "TODO [GodotJSScriptLanguage::reload_all_scripts] temporarily ignored because it's only called from `RemoteDebugger`");
-}
-
-void GodotJSScriptLanguage::reload_tool_script(const Ref<Script>& p_script, bool p_soft_reload)
-{
-    //TODO temporarily ignored because it's only called from `ResourceSaver` (we usually write typescripts in vscode)
-    JSB_LOG(Verbose, "TODO [GodotJSScriptLanguage::reload_tool_script] temporarily ignored because it's only called from `ResourceSaver` (we usually write typescripts in vscode)");
-}
-
-void GodotJSScriptLanguage::get_recognized_extensions(List<String>* p_extensions) const
-{
-#if JSB_USE_TYPESCRIPT
-    p_extensions->push_back(JSB_TYPESCRIPT_EXT);
-#endif
-    p_extensions->push_back(JSB_JAVASCRIPT_EXT);
-}
-
-
-#if GODOT_4_4_OR_NEWER
-String GodotJSScriptLanguage::get_global_class_name(const String &p_path, String *r_base_type, String *r_icon_path, bool *r_is_abstract, bool *r_is_tool) const
-#else
-String GodotJSScriptLanguage::get_global_class_name(const String& p_path, String* r_base_type, String* r_icon_path) const
-#endif
-{
-    // GodotJSScript implementation do not really support threaded access for now.
-    // So, we can not load the script module in-place because `get_global_class_name` could be called from EditorFileSystem (background) scan.
-    // And for simplicity, we use regex to extract the class name from the source code instead of using ANTLR or similar.
-    // Please follow the rules of the class name declaration in the source code.
-    //     * .ts files: `export default class ClassName extends BaseClassName`
-    //     * .js files: `class ClassName extends BaseClassName` and `exports.default = ClassName` (with or without `;`)
-
-    // And, we do not support `r_is_abstract` here, please define all abstract class by not exporting it as `default`.
-    // It should be equivalent and enough for TS/JS since we do not rely on GodotJSScript to use abstract classes in TS/JS sources.
-
-    Error err;
-    const Ref<FileAccess> file_access = FileAccess::open(p_path, FileAccess::READ, &err);
-    if (err)
-    {
-        return String();
-    }
-
-    const String source = file_access->get_as_utf8_string();
-    if (jsb::internal::PathUtil::is_recognized_javascript_extension(p_path))
-    {
-        // check if the class id defined in a single line (export default class ClassName extends BaseClassName)
-        jsb_check(!js_class_name_matcher1_.is_null());
-        const Ref<RegExMatch> match1 = js_class_name_matcher1_->search(source);
-        if (match1.is_valid() && match1->get_group_count() == 2)
-        {
-            const String class_name = match1->get_string(1);
-            if (r_base_type) *r_base_type = match1->get_string(2);
-            return class_name;
-        }
-
-        // otherwise, it probably defined in separated lines (firstly, check 'class ClassName extends BaseClassName')
-        jsb_check(!js_class_name_matcher2_.is_null());
-        const Ref<RegExMatch> match2 = js_class_name_matcher2_->search(source);
-        if (match2.is_valid() && match2->get_group_count() == 1)
-        {
-            const String class_name = match2->get_string(1);
-            if (r_base_type)
-            {
-                // then, check 'exports.default = ClassName'
-                const Ref<RegEx> base_matcher = RegEx::create_from_string(jsb::internal::format(R"(\s*class\s*%s\s*extends\s*(\w+)\s*\{?)", class_name));
-                const Ref<RegExMatch> base_match = base_matcher->search(source);
-                if (base_match.is_valid() && base_match->get_group_count() == 1)
-                {
-                    *r_base_type = base_match->get_string(1);
-                }
-            }
-            return class_name;
-        }
-    }
-    else
-    {
-        // hope it's a typescript file
-        jsb_check(!ts_class_name_matcher_.is_null());
-
-        Ref<RegExMatch> match =  ts_class_name_matcher_->search(source);
-        if (match.is_valid() && match->get_group_count() == 4)
-        {
-#if GODOT_4_4_OR_NEWER
-            if (r_is_tool) *r_is_tool = match->get_string(1).size() > 0;
-#endif
-
-            const String class_name = match->get_string(2);
-            if (r_base_type) *r_base_type = match->get_string(4);
-            return class_name;
-        }
-    }
-    return {};
-}
-
-bool GodotJSScriptLanguage::handles_global_class_type(const String& p_type) const
-{
-    return p_type == jsb_typename(GodotJSScript);
-}
-
-String GodotJSScriptLanguage::get_name() const
-{
-    return jsb_typename(GodotJSScript);
-}
-
-String GodotJSScriptLanguage::get_type() const
-{
-    return jsb_typename(GodotJSScript);
-}
-
-void GodotJSScriptLanguage::scan_external_changes()
-{
-    environment_->scan_external_changes();
-
-#ifdef TOOLS_ENABLED
-    // fix scripts with no .js counterpart found (only missing scripts)
-    {
-        MutexLock lock(mutex_);
-        const SelfList<GodotJSScript>* elem = script_list_.first();
-        while (elem)
-        {
-            elem->self()->load_module_if_missing();
-            elem = elem->next();
-        }
-    }
-#endif
-}
-
-void GodotJSScriptLanguage::thread_enter()
-{
-#if !JSB_WITH_WEB && !JSB_WITH_JAVASCRIPTCORE
-    jsb::Worker::on_thread_enter();
-#endif
-}
-
-void GodotJSScriptLanguage::thread_exit()
-{
-#if !JSB_WITH_WEB && !JSB_WITH_JAVASCRIPTCORE
-    jsb::Worker::on_thread_exit();
-#endif
-}
-
-void GodotJSScriptLanguage::profiling_start()
-{
-#if JSB_DEBUG
-    MutexLock lock(mutex_);
-    profile_info_map_.enabled = true;
-#endif
-}
-
-void GodotJSScriptLanguage::profiling_stop()
-{
-#if JSB_DEBUG
-    MutexLock lock(mutex_);
-    profile_info_map_.enabled = false;
-#endif
-}
-
-void GodotJSScriptLanguage::add_script_call_profile_info(const String& p_path, const StringName& p_class, const StringName& p_method, uint64_t p_time)
-{
-    // we only collect GodotJSScriptInstance function profiling data instead of the deep profiling data from JS runtime.
-    // please use Chrome DevTools for deep JS profiling.
-
-#if JSB_DEBUG
-    MutexLock lock(mutex_);
-    if (!profile_info_map_.enabled) return;
-
-    ScriptClassProfileInfo& prof = profile_info_map_.classes[p_class];
-    prof.path = p_path;
-    prof.methods[p_method].frame_calls++;
-    prof.methods[p_method].frame_time += p_time;
-    prof.methods[p_method].total_calls++;
-    prof.methods[p_method].total_time += p_time;
-#endif
-}
-
-bool GodotJSScriptLanguage::is_global_class_generic(const String &p_path) const
-{
-    Error err;
-    const Ref<FileAccess> file_access = FileAccess::open(p_path, FileAccess::READ, &err);
-    if (err)
-    {
-        return false;
-    }
-
-    const String source = file_access->get_as_utf8_string();
-
-    if (jsb::internal::PathUtil::is_recognized_javascript_extension(p_path))
-    {
-        return false;
-    }
-
-    jsb_check(!ts_class_name_matcher_.is_null());
-
-    Ref<RegExMatch> match =  ts_class_name_matcher_->search(source);
-    return match.is_valid() && match->get_group_count() == 4 && match->get_string(3).length() > 0;
-}
-
-namespace
-{
-    String to_signature(const String& p_path, const StringName& p_class, const StringName& p_method)
-    {
-        // path :: line :: class :: method
-        return jsb_format("%s::0::%s::%s", p_path, p_class, p_method);
-    }
-}
-
-int GodotJSScriptLanguage::profiling_get_accumulated_data(ProfilingInfo* p_info_arr, int p_info_max)
-{
-#if JSB_DEBUG
-    MutexLock lock(mutex_);
-    if (!profile_info_map_.enabled) return 0;
-
-    int current = 0;
-    for (const auto& class_kv : profile_info_map_.classes)
-    {
-        for (const auto& method_kv : class_kv.value.methods)
-        {
-            if (current >= p_info_max)
-            {
-                return current;
-            }
-            p_info_arr[current].signature = to_signature(class_kv.value.path, class_kv.key, method_kv.key);
-            p_info_arr[current].self_time = method_kv.value.total_time;
-            p_info_arr[current].total_time = method_kv.value.total_time;
-            p_info_arr[current].call_count = method_kv.value.total_calls;
-            current++;
-        }
-    }
-    return current;
-#else
-    return 0;
-#endif
-}
-
-int GodotJSScriptLanguage::profiling_get_frame_data(ProfilingInfo* p_info_arr, int p_info_max)
-{
-#if JSB_DEBUG
-    MutexLock lock(mutex_);
-    if (!profile_info_map_.enabled) return 0;
-
-    int current = 0;
-    for (const auto& class_kv : profile_info_map_.classes)
-    {
-        for (const auto& method_kv : class_kv.value.methods)
-        {
-            if (current >= p_info_max)
-            {
-                return current;
-            }
-            p_info_arr[current].signature = to_signature(class_kv.value.path, class_kv.key, method_kv.key);
-            p_info_arr[current].self_time = method_kv.value.last_frame_time;
-            p_info_arr[current].total_time = method_kv.value.last_frame_time;
-            p_info_arr[current].call_count = method_kv.value.last_frame_calls;
-            current++;
-        }
-    }
-    return current;
-#else
-    return 0;
-#endif
-}
-
-std::shared_ptr<jsb::Environment> GodotJSScriptLanguage::create_shadow_environment()
-{
-    const Thread::ID caller_id = Thread::get_caller_id();
-    {
-        MutexLock shadow_lock(shadow_mutex_);
-
-        for (ShadowEnvironment& shadow : shadow_environments_)
-        {
-            if (shadow.rc == 0 || shadow.thread_id == caller_id)
-            {
-                shadow.rc++;
-                return shadow.holder;
-            }
-        }
-    }
-
-    jsb::Environment::CreateParams params;
-    params.initial_class_slots = 128;
-    params.initial_object_slots = 512;
-    params.initial_script_slots = 32;
-    params.type = jsb::Environment::Type::Shadow;
-    params.thread_id = Thread::UNASSIGNED_ID;
-
-    std::shared_ptr<jsb::Environment> env = std::make_shared<jsb::Environment>(params);
-    JSB_LOG(Log, "creating a shadow Environment on thread %d for %s [env %s]",
-        Thread::get_caller_id(),
-        jsb_typename(GodotJSScript),
-        (uintptr_t) env->id());
-    env->init();
-    {
-        MutexLock shadow_lock(shadow_mutex_);
-        shadow_environments_.push_back({caller_id, env, 1});
-    }
-    return env;
-}
-
-void GodotJSScriptLanguage::destroy_shadow_environment(const std::shared_ptr<jsb::Environment>& p_env)
-{
-    bool found = false;
-    bool should_dispose = false;
-    {
-        MutexLock shadow_lock(shadow_mutex_);
-        const size_t num = shadow_environments_.size();
-        for (auto it = shadow_environments_.begin();
-            it != shadow_environments_.end();
-            ++it)
-        {
-            if (it->holder == p_env)
-            {
-                found = true;
-                if (--it->rc == 0 && num > JSB_MAX_CACHED_SHADOW_ENVIRONMENTS)
-                {
-                    should_dispose = true;
-                    shadow_environments_.erase(it);
-                }
-                break;
-            }
-        }
-    }
-    jsb_checkf(found, "not a registered shadow environment");
-    if (should_dispose) p_env->dispose();
-}
+#include "jsb_script_language.h"
+
+#include <iterator>
+
+#include "jsb_monitor.h"
+#include "jsb_low_memory_listener.h"
+#include "../jsb_project_preset.h"
+#include "../internal/jsb_internal.h"
+#include "../bridge/jsb_worker.h"
+#include "../bridge/jsb_worker_task.h"
+#include "../bridge/jsb_server_queries.h"
+#include "../bridge/jsb_file_io.h"
+#include "../bridge/jsb_metrics.h"
+#include "../bridge/jsb_shared_variant_info.h"
+#include "../internal/jsb_code_cache.h"
+
+#include "jsb_script.h"
+
+#include "scene/main/scene_tree.h"
+#include "core/io/config_file.h"
+#include "core/object/worker_thread_pool.h"
+
+#ifdef TOOLS_ENABLED
+#include "../weaver-editor/templates/templates.gen.h"
+#endif
+
+GodotJSScriptLanguage* GodotJSScriptLanguage::singleton_ = nullptr;
+
+#ifdef TOOLS_ENABLED
+namespace
+{
+    struct PendingScriptParse
+    {
+        String module_path;
+
+        // written in WorkerThreadPool
+        bool parsed = false;
+    };
+
+    // [WorkerThreadPool] evaluate the module in a shadow environment and persist the parsed class info
+    void _parse_pending_script(void* p_userdata, uint32_t p_index)
+    {
+        PendingScriptParse& pending = ((PendingScriptParse*) p_userdata)[p_index];
+        jsb::JSEnvironment env(pending.module_path, true);
+
+        // the module (and its base classes) may be loaded in this shadow environment before, reload them if changed
+        StringName module_id = pending.module_path;
+        while (const jsb::JavaScriptModule* loaded_module = env->get_module_cache().find(module_id))
+        {
+            env->mark_as_reloading(loaded_module->id);
+            const jsb::ScriptClassInfoPtr loaded_class_info = env->find_script_class(loaded_module->script_class_id);
+            module_id = loaded_class_info ? loaded_class_info->base_script_module_id : StringName();
+        }
+
+        jsb::JavaScriptModule* module = nullptr;
+        if (env->load(pending.module_path, &module) != OK || !module) return;
+        const jsb::ScriptClassInfoPtr class_info = env->find_script_class(module->script_class_id);
+        if (!class_info) return;
+
+        HashMap<StringName, Variant> default_values;
+        for (const auto& it : class_info->properties)
+        {
+            Variant default_value;
+            env->get_default_property_value(*class_info, it.key, default_value);
+            default_values.insert(it.key, default_value);
+        }
+        const std::shared_ptr<jsb::Environment> holder = env;
+        jsb::ScriptClassCache::save(holder.get(), pending.module_path, *class_info, &default_values);
+        pending.parsed = true;
+    }
+}
+#endif
+
+namespace jsb
+{
+    void JSEnvironment::init()
+    {
+        if (is_shadow_ && !target_)
+        {
+            target_ = GodotJSScriptLanguage::get_singleton()->create_shadow_environment();
+        }
+    }
+
+    JSEnvironment::JSEnvironment(const String& p_path_hint, bool p_is_shadow_allowed)
+    {
+        target_ = jsb::Environment::_access();
+        if (target_)
+        {
+            is_shadow_ = false;
+        }
+        else
+        {
+            jsb_ensuref(p_is_shadow_allowed, "no available Environment on thread %d for %s: %s", Thread::get_caller_id(), jsb_typename(GodotJSScript), p_path_hint);
+            is_shadow_ = true;
+        }
+    }
+
+    JSEnvironment::~JSEnvironment()
+    {
+        if (is_shadow_ && target_)
+        {
+            GodotJSScriptLanguage::get_singleton()->destroy_shadow_environment(target_);
+        }
+    }
+}
+
+GodotJSScriptLanguage::GodotJSScriptLanguage()
+{
+    JSB_BENCHMARK_SCOPE(GodotJSScriptLanguage, Construct);
+    jsb_check(!singleton_);
+    singleton_ = this;
+    jsb::internal::StringNames::create();
+}
+
+GodotJSScriptLanguage::~GodotJSScriptLanguage()
+{
+    jsb::internal::StringNames::free();
+    jsb_check(singleton_ == this);
+    singleton_ = nullptr;
+
+    //TODO manage script list in a safer way (access and ref with script.id)
+    MutexLock lock(mutex_);
+    while (SelfList<GodotJSScript>* script_el = script_list_.first())
+    {
+        script_el->remove_from_list();
+    }
+}
+
+void GodotJSScriptLanguage::init()
+{
+    if (once_inited_) return;
+
+    JSB_BENCHMARK_SCOPE(GodotJSScriptLanguage, init);
+    once_inited_ = true;
+    JSB_LOG(Verbose, "Runtime: %s", JSB_IMPL_VERSION_STRING);
+    JSB_LOG(VeryVerbose, "jsb lang init");
+
+    jsb::Environment::CreateParams params;
+    params.initial_class_slots = (int) ClassDB::classes.size() + JSB_MASTER_INITIAL_CLASS_EXTRA_SLOTS;
+    server_profile_ = jsb::internal::Settings::is_server_profile();
+    params.initial_object_slots = server_profile_ ? jsb::internal::Settings::get_server_initial_object_slots() : jsb::internal::Settings::get_initial_object_slots();
+    params.initial_script_slots = server_profile_ ? jsb::internal::Settings::get_server_initial_script_slots() : jsb::internal::Settings::get_initial_script_slots();
+    if (jsb::internal::Settings::is_adaptive_initial_slots())
+    {
+        _read_slots_high_water_mark(params);
+    }
+    params.max_heap_size_mb = jsb::internal::Settings::get_max_heap_size_mb(false);
+    params.initial_heap_size_mb = jsb::internal::Settings::get_initial_heap_size_mb(false);
+    params.debugger_port = server_profile_ ? 0 : jsb::internal::Settings::get_debugger_port();
+    params.thread_id = Thread::get_caller_id();
+    if (server_profile_)
+    {
+        const int tick_rate = jsb::internal::Settings::get_server_tick_rate();
+        server_tick_usec_ = tick_rate > 0 ? 1000000ULL / (uint64_t) tick_rate : 0;
+        JSB_LOG(Verbose, "server profile (tick rate: %d)", tick_rate);
+    }
+
+    jsb::internal::IConsoleOutput::set_buffered(jsb::internal::Settings::is_buffered_console_output());
+#if JSB_WITH_TRACE_EVENTS
+    if (!jsb::internal::Settings::get_trace_events_path().is_empty())
+    {
+        jsb::internal::TraceEvents::start();
+    }
+#endif
+
+    // built once here for all environments (workers and shadow environments only create their templates)
+    jsb::SharedVariantInfo::get();
+
+    // main environment
+    environment_ = std::make_shared<jsb::Environment>(params);
+    environment_->init();
+    shadow_pool_size_ = jsb::internal::Settings::get_shadow_environment_pool_size();
+#ifdef TOOLS_ENABLED
+    // the shadow environments are created in background before the editor parses scripts in parallel (see `reload_scripts`),
+    // so the first reparse doesn't pay for the initialization
+    if (Engine::get_singleton()->is_editor_hint() && jsb::internal::Settings::is_script_class_cache_enabled() && shadow_pool_size_ > 0)
+    {
+        shadow_prewarm_group_ = WorkerThreadPool::get_singleton()->add_native_group_task(&_prewarm_shadow_environment, this, shadow_pool_size_, shadow_pool_size_, false, "jsb: prewarm shadow environments");
+    }
+#endif
+
+    // the modules are not evaluated until required, only their sources are loaded in advance
+    for (const String& module_id : jsb::internal::Settings::get_startup_prefetch_modules())
+    {
+        environment_->prefetch_module(module_id);
+    }
+
+    // bound in the idle time of the first frames, the entry script still touches its classes on demand
+    environment_->prewarm_classes(jsb::internal::Settings::get_prewarm_classes());
+    if (jsb::internal::Settings::is_record_touched_classes())
+    {
+        environment_->prewarm_classes(_read_touched_classes());
+    }
+
+    if (const String entry_script_path = jsb::internal::Settings::get_entry_script_path();
+        !entry_script_path.is_empty())
+    {
+        environment_->load(entry_script_path);
+    }
+
+#if JSB_DEBUG
+    if (!server_profile_ && jsb::compat::Performance::get_singleton()) monitor_ = memnew(GodotJSMonitor);
+#endif
+
+    // opt-in (even in the server profile), it's for monitoring in production
+    if (const uint16_t metrics_port = jsb::internal::Settings::get_metrics_port(); metrics_port != 0)
+    {
+        metrics_interval_usec_ = (uint64_t) jsb::internal::Settings::get_metrics_interval_msec() * 1000ULL;
+        jsb::Metrics::start_server(metrics_port);
+    }
+}
+
+void GodotJSScriptLanguage::finish()
+{
+    jsb_check(once_inited_);
+#if JSB_DEBUG
+    if (monitor_) memdelete(monitor_);
+#endif
+#if JSB_WITH_SAMPLING_PROFILER
+    sampling_profiler_.stop();
+#endif
+    once_inited_ = false;
+    if (metrics_interval_usec_ != 0)
+    {
+        jsb::Metrics::stop_server();
+        metrics_interval_usec_ = 0;
+    }
+    if (jsb::internal::Settings::is_adaptive_initial_slots())
+    {
+        _write_slots_high_water_mark();
+    }
+    if (jsb::internal::Settings::is_record_touched_classes())
+    {
+        _write_touched_classes();
+    }
+#ifdef TOOLS_ENABLED
+    global_class_cache_.save();
+#endif
+#ifdef TOOLS_ENABLED
+    if (shadow_prewarm_group_ != WorkerThreadPool::INVALID_TASK_ID)
+    {
+        WorkerThreadPool::get_singleton()->wait_for_group_task_completion(shadow_prewarm_group_);
+        shadow_prewarm_group_ = WorkerThreadPool::INVALID_TASK_ID;
+    }
+#endif
+    environment_->dispose();
+    environment_.reset();
+#if JSB_WITH_THREADED_SCRIPT_PRELOAD
+    jsb::ModulePrefetcher::clear_preloaded();
+#endif
+#if !JSB_WITH_WEB
+    jsb::Worker::finish();
+    jsb::WorkerTaskPool::finish();
+    jsb::ServerQueries::finish();
+    jsb::AsyncFileIO::finish();
+#endif
+#if JSB_WITH_WATCHDOG
+    jsb::Watchdog::finish();
+#endif
+    {
+        std::vector<ShadowEnvironment> shadow_environments;
+        {
+            MutexLock shadow_lock(shadow_mutex_);
+            shadow_environments = shadow_environments_;
+            shadow_environments_.clear();
+        }
+        for (const ShadowEnvironment& env : shadow_environments)
+        {
+            env.holder->dispose();
+        }
+    }
+    jsb::SharedVariantInfo::release();
+    jsb::internal::CodeCache::clear_memory();
+    // all producers are gone, write the rest of console messages
+    jsb::internal::IConsoleOutput::set_buffered(false);
+#if JSB_WITH_TRACE_EVENTS
+    if (const String trace_events_path = jsb::internal::Settings::get_trace_events_path(); !trace_events_path.is_empty())
+    {
+        jsb::internal::TraceEvents::stop();
+        jsb::internal::TraceEvents::save(trace_events_path);
+    }
+#endif
+    JSB_LOG(VeryVerbose, "jsb lang finish");
+}
+
+String GodotJSScriptLanguage::_get_touched_classes_path()
+{
+    return OS::get_singleton()->get_user_data_dir().path_join("godotjs_classes.cfg");
+}
+
+PackedStringArray GodotJSScriptLanguage::_read_touched_classes()
+{
+    const Ref<ConfigFile> file = memnew(ConfigFile);
+    if (file->load(_get_touched_classes_path()) != OK)
+    {
+        return {};
+    }
+    return file->get_value("classes", "touched", PackedStringArray());
+}
+
+void GodotJSScriptLanguage::_write_touched_classes() const
+{
+    const String path = _get_touched_classes_path();
+    const Ref<ConfigFile> file = memnew(ConfigFile);
+    file->load(path);
+
+    // merged with the previous runs, a short run should not drop the classes of the other scenes
+    HashSet<String> touched;
+    PackedStringArray class_names = file->get_value("classes", "touched", PackedStringArray());
+    for (const String& class_name : class_names)
+    {
+        touched.insert(class_name);
+    }
+    for (const String& class_name : environment_->get_exposed_godot_classes())
+    {
+        if (!touched.has(class_name))
+        {
+            touched.insert(class_name);
+            class_names.push_back(class_name);
+        }
+    }
+    file->set_value("classes", "touched", class_names);
+    if (file->save(path) != OK)
+    {
+        JSB_LOG(Warning, "failed to save %s", path);
+    }
+}
+
+String GodotJSScriptLanguage::_get_slots_high_water_mark_path()
+{
+    return OS::get_singleton()->get_user_data_dir().path_join("godotjs_slots.cfg");
+}
+
+void GodotJSScriptLanguage::_read_slots_high_water_mark(jsb::Environment::CreateParams& r_params)
+{
+    const Ref<ConfigFile> file = memnew(ConfigFile);
+    if (file->load(_get_slots_high_water_mark_path()) != OK)
+    {
+        return;
+    }
+
+    // leave some room for growth, the project settings are still the lower bound
+    const int objects = file->get_value("slots", "objects", 0);
+    const int scripts = file->get_value("slots", "scripts", 0);
+    r_params.initial_object_slots = MAX(r_params.initial_object_slots, objects + objects / 4);
+    r_params.initial_script_slots = MAX(r_params.initial_script_slots, scripts + scripts / 4);
+    JSB_LOG(Verbose, "initial slots (objects: %d, scripts: %d)", r_params.initial_object_slots, r_params.initial_script_slots);
+}
+
+void GodotJSScriptLanguage::_write_slots_high_water_mark() const
+{
+    const String path = _get_slots_high_water_mark_path();
+    const Ref<ConfigFile> file = memnew(ConfigFile);
+    file->load(path);
+
+    // only raised, the peak of a short run should not shrink the slots of the next launch
+    const int objects = MAX((int) file->get_value("slots", "objects", 0), environment_->get_object_slots_peak());
+    const int scripts = MAX((int) file->get_value("slots", "scripts", 0), environment_->get_script_slots_peak());
+    file->set_value("slots", "objects", objects);
+    file->set_value("slots", "scripts", scripts);
+    if (file->save(path) != OK)
+    {
+        JSB_LOG(Warning, "failed to save %s", path);
+    }
+}
+
+void GodotJSScriptLanguage::_on_physics_frame()
+{
+    environment_->physics_update(1.0 / (double) Engine::get_singleton()->get_physics_ticks_per_second());
+}
+
+void GodotJSScriptLanguage::_update_fixed_ticks(uint64_t p_elapsed_usec)
+{
+    server_tick_lag_usec_ += p_elapsed_usec;
+    for (int ticks = 0; server_tick_lag_usec_ >= server_tick_usec_; ++ticks)
+    {
+        if (ticks == JSB_SERVER_MAX_CATCHUP_TICKS)
+        {
+            server_tick_lag_usec_ %= server_tick_usec_;
+            break;
+        }
+        server_tick_lag_usec_ -= server_tick_usec_;
+
+        // derived from the total time to avoid accumulating the rounding error of milliseconds
+        const uint64_t clock_usec = server_clock_usec_ + server_tick_usec_;
+        environment_->update(clock_usec / 1000ULL - server_clock_usec_ / 1000ULL);
+        server_clock_usec_ = clock_usec;
+    }
+}
+
+void GodotJSScriptLanguage::frame()
+{
+    const uint64_t base_ticks = Engine::get_singleton()->get_frame_ticks();
+    if (server_tick_usec_ != 0)
+    {
+        _update_fixed_ticks(base_ticks - last_ticks_);
+    }
+    else
+    {
+        const uint64_t elapsed_milli = (base_ticks - last_ticks_) / 1000ULL; // milliseconds
+        environment_->update(elapsed_milli);
+    }
+    last_ticks_ = base_ticks;
+#if JSB_WITH_SAMPLING_PROFILER
+    sampling_profiler_.frame();
+#endif
+    environment_->notify_frame_idle(base_ticks);
+    if (metrics_interval_usec_ != 0 && base_ticks - metrics_published_usec_ >= metrics_interval_usec_)
+    {
+        metrics_published_usec_ = base_ticks;
+        jsb::Metrics::publish(environment_.get());
+    }
+
+    if (!physics_frame_connected_)
+    {
+        if (SceneTree* scene_tree = Object::cast_to<SceneTree>(OS::get_singleton()->get_main_loop()))
+        {
+            scene_tree->connect(SNAME("physics_frame"), callable_mp(this, &GodotJSScriptLanguage::_on_physics_frame));
+            physics_frame_connected_ = true;
+
+            // hidden from get_children() of the root
+            scene_tree->get_root()->add_child(memnew(GodotJSLowMemoryListener), false, Node::INTERNAL_MODE_BACK);
+        }
+    }
+
+#if JSB_WITH_PROFILING
+    if (profile_info_map_.enabled.is_set())
+    {
+        // the counters are monotonic, the frame data is the difference from the last frame
+        MutexLock lock(mutex_);
+        profile_info_map_.counters.collect(profile_info_map_.calls.size(), profile_info_map_.collected);
+        for (uint32_t index = 0, n = profile_info_map_.collected.size(); index < n; ++index)
+        {
+            const jsb::internal::ProfileCounters::Value& value = profile_info_map_.collected[index];
+            ScriptCallProfileInfo& info = profile_info_map_.calls[index];
+            info.last_frame_time = value.time - info.total_time;
+            info.last_frame_calls = value.calls - info.total_calls;
+            info.total_time = value.time;
+            info.total_calls = value.calls;
+        }
+    }
+#endif
+
+    // console messages (from all threads) are written at once at the end of frame
+    jsb::internal::IConsoleOutput::flush();
+}
+
+struct JavaScriptControlFlowKeywords
+{
+    HashSet<String> values;
+    jsb_force_inline JavaScriptControlFlowKeywords()
+    {
+        constexpr static const char* _keywords[] =
+        {
+            "if", "else", "switch", "case", "do", "while", "for", "foreach",
+            "return", "break", "continue",
+            "try", "throw", "catch", "finally",
+        };
+        for (size_t index = 0; index < ::std::size(_keywords); ++index)
+        {
+            values.insert(_keywords[index]);
+        }
+    }
+};
+
+bool GodotJSScriptLanguage::is_control_flow_keyword(ConstStringRefCompat p_keyword) const
+{
+    static JavaScriptControlFlowKeywords collection;
+    return collection.values.has(p_keyword);
+}
+
+Vector<String> GodotJSScriptLanguage::get_reserved_words() const
+{
+    return Vector<String> {
+        "return", "function", "interface", "class", "let", "break", "as", "any", "switch", "case", "if", "enum",
+        "throw", "else", "var", "number", "string", "get", "module", "instanceof", "typeof", "public", "private",
+        "while", "void", "null", "super", "this", "new", "in", "await", "async", "extends", "static",
+        "package", "implements", "interface", "continue", "yield", "const", "export", "finally", "for",
+        "import", "byte", "delete", "goto",
+        "default",
+    };
+}
+
+#if GODOT_4_5_OR_NEWER
+Vector<String> GodotJSScriptLanguage::get_doc_comment_delimiters() const
+{
+    return Vector<String> { "///" };
+}
+
+Vector<String> GodotJSScriptLanguage::get_comment_delimiters() const
+{
+    return Vector<String> { "//", "/* */" };
+}
+
+Vector<String> GodotJSScriptLanguage::get_string_delimiters() const
+{
+    return Vector<String> { "' '", "\" \"", "` `" };
+}
+#else
+void GodotJSScriptLanguage::get_reserved_words(List<String>* p_words) const
+{
+    for (String keyword : get_reserved_words())
+    {
+        p_words->push_back(keyword);
+    }
+}
+
+void GodotJSScriptLanguage::get_doc_comment_delimiters(List<String>* p_delimiters) const
+{
+    p_delimiters->push_back("///");
+}
+
+void GodotJSScriptLanguage::get_comment_delimiters(List<String>* p_delimiters) const
+{
+    p_delimiters->push_back("//");
+    p_delimiters->push_back("/* */");
+}
+
+void GodotJSScriptLanguage::get_string_delimiters(List<String>* p_delimiters) const
+{
+    p_delimiters->push_back("' '");
+    p_delimiters->push_back("\" \"");
+    p_delimiters->push_back("` `");
+}
+#endif
+
+//TODO this virtual method seems never used in godot?
+Script* GodotJSScriptLanguage::create_script() const
+{
+    return memnew(GodotJSScript);
+}
+
+bool GodotJSScriptLanguage::validate(const String& p_script, const String& p_path, List<String>* r_functions, List<ScriptError>* r_errors, List<Warning>* r_warnings, HashSet<int>* r_safe_lines) const
+{
+    if (environment_->validate_script(p_path))
+    {
+        return true;
+    }
+
+    //TODO parse error info
+    ScriptError err;
+    err.line = 0;
+    err.column = 0;
+    err.message = "NOT_IMPLEMENTED";
+    r_errors->push_back(err);
+    return false;
+}
+
+Ref<Script> GodotJSScriptLanguage::make_template(const String& p_template, const String& p_class_name, const String& p_base_class_name) const
+{
+    Ref<GodotJSScript> spt;
+    spt.instantiate();
+    String processed_template = p_template;
+    processed_template = processed_template.replace("_BASE_", p_base_class_name)
+                                 .replace("_CLASS_SNAKE_CASE_", jsb::internal::VariantUtil::to_snake_case_id(p_class_name))
+                                 .replace("_CLASS_", jsb::internal::VariantUtil::to_pascal_case_id(p_class_name))
+                                 .replace("_TS_", jsb::internal::Settings::get_indentation());
+    spt->set_source_code(processed_template);
+    return spt;
+}
+
+Vector<ScriptLanguage::ScriptTemplate> GodotJSScriptLanguage::get_built_in_templates(ConstStringNameRefCompat p_object)
+{
+    Vector<ScriptTemplate> templates;
+#ifdef TOOLS_ENABLED
+    for (int i = 0; i < TEMPLATES_ARRAY_SIZE; i++) {
+        if (TEMPLATES[i].inherit == p_object) {
+            templates.append(TEMPLATES[i]);
+        }
+    }
+#endif
+    return templates;
+}
+
+#if GODOT_4_3_OR_NEWER
+void GodotJSScriptLanguage::reload_scripts(const Array& p_scripts, bool p_soft_reload)
+{
+#ifdef TOOLS_ENABLED
+    // the scripts not loaded yet are parsed in parallel (in shadow environments),
+    // and the results are merged on the main thread through the class cache (see `GodotJSScript::get_cached_class_info`)
+    const bool parallel = Engine::get_singleton()->is_editor_hint() && jsb::internal::Settings::is_script_class_cache_enabled();
+    LocalVector<PendingScriptParse> pending;
+    LocalVector<Ref<GodotJSScript>> pending_scripts;
+#endif
+    for (int i = 0, n = p_scripts.size(); i < n; ++i)
+    {
+        const Ref<GodotJSScript> script = p_scripts[i];
+        if (script.is_null()) continue;
+#ifdef TOOLS_ENABLED
+        if (parallel && !script->loaded_)
+        {
+            pending.push_back({ jsb::internal::PathUtil::convert_typescript_path(script->get_path()) });
+            pending_scripts.push_back(script);
+            continue;
+        }
+#endif
+        script->reload(p_soft_reload);
+    }
+
+#ifdef TOOLS_ENABLED
+    if (pending.is_empty()) return;
+    JSB_BENCHMARK_SCOPE(GodotJSScriptLanguage, reload_scripts);
+    WorkerThreadPool* pool = WorkerThreadPool::get_singleton();
+    const WorkerThreadPool::GroupID group_id = pool->add_native_group_task(&_parse_pending_script, pending.ptr(), (int) pending.size(), shadow_pool_size_, true, "jsb: parse scripts");
+    pool->wait_for_group_task_completion(group_id);
+
+    int parsed = 0;
+    for (uint32_t i = 0; i < pending.size(); ++i)
+    {
+        // read again from the cache, or load on demand if failed to parse
+        pending_scripts[i]->invalidate_class_cache();
+        if (pending[i].parsed) ++parsed;
+    }
+    JSB_LOG(Verbose, "%d/%d scripts parsed in parallel", parsed, (int) pending.size());
+#endif
+}
+
+void GodotJSScriptLanguage::profiling_set_save_native_calls(bool p_enable)
+{
+    JSB_LOG(Verbose, "TODO [GodotJSScriptLanguage::profiling_set_save_native_calls] NOT IMPLEMENTED");
+}
+#endif
+
+void GodotJSScriptLanguage::reload_all_scripts()
+{
+    //TODO temporarily ignored because it's only called from `RemoteDebugger`
+    JSB_LOG(Verbose, "TODO [GodotJSScriptLanguage::reload_all_scripts] temporarily ignored because it's only called from `RemoteDebugger`");
+}
+
+void GodotJSScriptLanguage::reload_tool_script(const Ref<Script>& p_script, bool p_soft_reload)
+{
+    //TODO temporarily ignored because it's only called from `ResourceSaver` (we usually write typescripts in vscode)
+    JSB_LOG(Verbose, "TODO [GodotJSScriptLanguage::reload_tool_script] temporarily ignored because it's only called from `ResourceSaver` (we usually write typescripts in vscode)");
+}
+
+void GodotJSScriptLanguage::get_recognized_extensions(List<String>* p_extensions) const
+{
+#if JSB_USE_TYPESCRIPT
+    p_extensions->push_back(JSB_TYPESCRIPT_EXT);
+#endif
+    p_extensions->push_back(JSB_JAVASCRIPT_EXT);
+}
+
+
+#if GODOT_4_4_OR_NEWER
+String GodotJSScriptLanguage::get_global_class_name(const String &p_path, String *r_base_type, String *r_icon_path, bool *r_is_abstract, bool *r_is_tool) const
+#else
+String GodotJSScriptLanguage::get_global_class_name(const String& p_path, String* r_base_type, String* r_icon_path) const
+#endif
+{
+    // GodotJSScript implementation do not really support threaded access for now.
+    // So, we can not load the script module in-place because `get_global_class_name` could be called from EditorFileSystem (background) scan.
+    // And for simplicity, we scan the class declaration in the source code instead of using ANTLR or similar (cached until the file changed).
+    // Please follow the rules of the class name declaration in the source code.
+    //     * .ts files: `export default class ClassName extends BaseClassName`
+    //     * .js files: `class ClassName extends BaseClassName` and `exports.default = ClassName` (with or without `;`)
+    // The manifest generated by the editor transpiler is used instead if available (`<output>.js.meta.json`),
+    // it's extracted from the TS syntax tree, so that `@icon(...)` and `export default abstract class` are also recognized.
+
+    const jsb::GlobalClassInfo info = global_class_cache_.get(p_path);
+#if GODOT_4_4_OR_NEWER
+    if (r_is_tool) *r_is_tool = info.is_tool;
+    if (r_is_abstract) *r_is_abstract = info.is_abstract;
+#endif
+    if (r_base_type && !info.class_name.is_empty()) *r_base_type = info.base_type;
+    if (r_icon_path && !info.icon_path.is_empty()) *r_icon_path = info.icon_path;
+    return info.class_name;
+}
+
+bool GodotJSScriptLanguage::handles_global_class_type(const String& p_type) const
+{
+    return p_type == jsb_typename(GodotJSScript);
+}
+
+String GodotJSScriptLanguage::get_name() const
+{
+    return jsb_typename(GodotJSScript);
+}
+
+String GodotJSScriptLanguage::get_type() const
+{
+    return jsb_typename(GodotJSScript);
+}
+
+void GodotJSScriptLanguage::scan_external_changes()
+{
+    Vector<StringName> script_modules;
+    environment_->scan_external_changes(&script_modules);
+
+    // the scripts affected by the changed dependencies (in the same order as the modules reloaded)
+    if (!script_modules.is_empty())
+    {
+        MutexLock lock(mutex_);
+        HashMap<StringName, GodotJSScript*> scripts;
+        for (const SelfList<GodotJSScript>* elem = script_list_.first(); elem; elem = elem->next())
+        {
+            const StringName module_id = elem->self()->get_module_id();
+            if (jsb::internal::VariantUtil::is_valid_name(module_id)) scripts.insert(module_id, elem->self());
+        }
+        for (const StringName& module_id : script_modules)
+        {
+            if (GodotJSScript** script = scripts.getptr(module_id))
+            {
+                (*script)->reload_module_immediately();
+            }
+        }
+    }
+
+#ifdef TOOLS_ENABLED
+    // fix scripts with no .js counterpart found (only missing scripts)
+    {
+        MutexLock lock(mutex_);
+        const SelfList<GodotJSScript>* elem = script_list_.first();
+        while (elem)
+        {
+            elem->self()->load_module_if_missing();
+            elem = elem->next();
+        }
+    }
+#endif
+}
+
+void GodotJSScriptLanguage::thread_enter()
+{
+#if !JSB_WITH_WEB
+    jsb::Worker::on_thread_enter();
+#endif
+}
+
+void GodotJSScriptLanguage::thread_exit()
+{
+#if !JSB_WITH_WEB
+    jsb::Worker::on_thread_exit();
+#endif
+}
+
+void GodotJSScriptLanguage::profiling_start()
+{
+    if (server_profile_) return;
+#if JSB_WITH_PROFILING
+    profile_info_map_.enabled.set();
+#endif
+#if JSB_WITH_SAMPLING_PROFILER
+    if (const int interval_usec = jsb::internal::Settings::get_sampling_profiler_interval_usec(); interval_usec > 0 && environment_)
+    {
+        sampling_profiler_.start(environment_.get(), interval_usec);
+    }
+#endif
+}
+
+void GodotJSScriptLanguage::profiling_stop()
+{
+#if JSB_WITH_PROFILING
+    profile_info_map_.enabled.clear();
+#endif
+#if JSB_WITH_SAMPLING_PROFILER
+    sampling_profiler_.stop();
+#endif
+}
+
+#if JSB_WITH_PROFILING
+uint32_t GodotJSScriptLanguage::get_script_call_profile_id(const String& p_path, const StringName& p_class, const StringName& p_method)
+{
+    // only the top-level calls into GodotJSScriptInstance are collected here,
+    // the JS functions are sampled by `sampling_profiler_` if `sampling_profiler_interval_usec` is set (v8 only).
+    MutexLock lock(mutex_);
+    HashMap<StringName, uint32_t>& methods = profile_info_map_.ids[p_class];
+    if (const uint32_t* id = methods.getptr(p_method))
+    {
+        return *id;
+    }
+    const uint32_t id = profile_info_map_.calls.size();
+    ScriptCallProfileInfo info;
+    info.path = p_path;
+    info.class_name = p_class;
+    info.method = p_method;
+    profile_info_map_.calls.push_back(info);
+    methods.insert(p_method, id);
+    return id;
+}
+#endif
+
+bool GodotJSScriptLanguage::is_global_class_generic(const String &p_path) const
+{
+    return global_class_cache_.get(p_path).is_generic;
+}
+
+namespace
+{
+    String to_signature(const String& p_path, const StringName& p_class, const StringName& p_method)
+    {
+        // path :: line :: class :: method
+        return jsb_format("%s::0::%s::%s", p_path, p_class, p_method);
+    }
+}
+
+int GodotJSScriptLanguage::profiling_get_accumulated_data(ProfilingInfo* p_info_arr, int p_info_max)
+{
+#if JSB_WITH_PROFILING
+    MutexLock lock(mutex_);
+    if (!profile_info_map_.enabled.is_set()) return 0;
+
+    int current = 0;
+    for (const ScriptCallProfileInfo& info : profile_info_map_.calls)
+    {
+        if (current >= p_info_max)
+        {
+            return current;
+        }
+        p_info_arr[current].signature = to_signature(info.path, info.class_name, info.method);
+        p_info_arr[current].self_time = info.total_time;
+        p_info_arr[current].total_time = info.total_time;
+        p_info_arr[current].call_count = info.total_calls;
+        current++;
+    }
+#if JSB_WITH_SAMPLING_PROFILER
+    current += sampling_profiler_.get_accumulated_data(p_info_arr + current, p_info_max - current);
+#endif
+    return current;
+#else
+    return 0;
+#endif
+}
+
+int GodotJSScriptLanguage::profiling_get_frame_data(ProfilingInfo* p_info_arr, int p_info_max)
+{
+#if JSB_WITH_PROFILING
+    MutexLock lock(mutex_);
+    if (!profile_info_map_.enabled.is_set()) return 0;
+
+    int current = 0;
+    for (const ScriptCallProfileInfo& info : profile_info_map_.calls)
+    {
+        if (current >= p_info_max)
+        {
+            return current;
+        }
+        p_info_arr[current].signature = to_signature(info.path, info.class_name, info.method);
+        p_info_arr[current].self_time = info.last_frame_time;
+        p_info_arr[current].total_time = info.last_frame_time;
+        p_info_arr[current].call_count = info.last_frame_calls;
+        current++;
+    }
+#if JSB_WITH_SAMPLING_PROFILER
+    current += sampling_profiler_.get_frame_data(p_info_arr + current, p_info_max - current);
+#endif
+    return current;
+#else
+    return 0;
+#endif
+}
+
+std::shared_ptr<jsb::Environment> GodotJSScriptLanguage::create_shadow_environment()
+{
+    const Thread::ID caller_id = Thread::get_caller_id();
+    {
+        MutexLock shadow_lock(shadow_mutex_);
+
+        // reentrant on the same thread, otherwise take an idle one (never share an environment between threads)
+        ShadowEnvironment* idle = nullptr;
+        for (ShadowEnvironment& shadow : shadow_environments_)
+        {
+            if (shadow.rc != 0 && shadow.thread_id == caller_id)
+            {
+                shadow.rc++;
+                return shadow.holder;
+            }
+            if (shadow.rc == 0 && !idle) idle = &shadow;
+        }
+        if (idle)
+        {
+            idle->thread_id = caller_id;
+            idle->rc = 1;
+            return idle->holder;
+        }
+    }
+
+    std::shared_ptr<jsb::Environment> env = _new_shadow_environment();
+    {
+        MutexLock shadow_lock(shadow_mutex_);
+        shadow_environments_.push_back({caller_id, env, 1});
+    }
+    return env;
+}
+
+std::shared_ptr<jsb::Environment> GodotJSScriptLanguage::_new_shadow_environment()
+{
+    jsb::Environment::CreateParams params;
+    params.initial_class_slots = 128;
+    params.initial_object_slots = 512;
+    params.initial_script_slots = 32;
+    params.type = jsb::Environment::Type::Shadow;
+    params.thread_id = Thread::UNASSIGNED_ID;
+
+    std::shared_ptr<jsb::Environment> env = std::make_shared<jsb::Environment>(params);
+    JSB_LOG(Log, "creating a shadow Environment on thread %d for %s [env %s]",
+        Thread::get_caller_id(),
+        jsb_typename(GodotJSScript),
+        (uintptr_t) env->id());
+    env->init();
+    return env;
+}
+
+#ifdef TOOLS_ENABLED
+void GodotJSScriptLanguage::_prewarm_shadow_environment(void* p_userdata, uint32_t p_index)
+{
+    GodotJSScriptLanguage* self = (GodotJSScriptLanguage*) p_userdata;
+    {
+        MutexLock shadow_lock(self->shadow_mutex_);
+        if (self->shadow_environments_.size() >= (size_t) self->shadow_pool_size_) return;
+    }
+
+    const std::shared_ptr<jsb::Environment> env = _new_shadow_environment();
+    {
+        MutexLock shadow_lock(self->shadow_mutex_);
+        if (self->shadow_environments_.size() < (size_t) self->shadow_pool_size_)
+        {
+            self->shadow_environments_.push_back({Thread::UNASSIGNED_ID, env, 0});
+            return;
+        }
+    }
+    // the pool is filled by the scripts parsed in the meantime
+    env->dispose();
+}
+#endif
+
+void GodotJSScriptLanguage::destroy_shadow_environment(const std::shared_ptr<jsb::Environment>& p_env)
+{
+    bool found = false;
+    bool should_dispose = false;
+    {
+        MutexLock shadow_lock(shadow_mutex_);
+        const size_t num = shadow_environments_.size();
+        for (auto it = shadow_environments_.begin();
+            it != shadow_environments_.end();
+            ++it)
+        {
+            if (it->holder == p_env)
+            {
+                found = true;
+                if (--it->rc == 0)
+                {
+                    it->thread_id = Thread::UNASSIGNED_ID;
+                    if (num > (size_t) shadow_pool_size_)
+                    {
+                        should_dispose = true;
+                        shadow_environments_.erase(it);
+                    }
+                }
+                break;
+            }
+        }
+    }
+    jsb_checkf(found, "not a registered shadow environment");
+    if (should_dispose) p_env->dispose();
+}
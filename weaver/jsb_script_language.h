@@ -3,6 +3,9 @@
 
 #include "../bridge/jsb_bridge.h"
 #include "../compat/jsb_compat.h"
+#include "jsb_global_class_cache.h"
+#include "../bridge/jsb_sampling_profiler.h"
+#include "core/object/worker_thread_pool.h"
 
 class GodotJSScript;
 class GodotJSMonitor;
@@ -60,32 +63,41 @@ private:
 
     struct ShadowEnvironment
     {
+        // the thread using it, UNASSIGNED_ID if it's idle
         Thread::ID thread_id = Thread::UNASSIGNED_ID;
         std::shared_ptr<jsb::Environment> holder;
         int rc = 0;
     };
 
-#if JSB_DEBUG
+#if JSB_WITH_PROFILING
     struct ScriptCallProfileInfo
     {
+        String path;
+        StringName class_name;
+        StringName method;
+
         uint64_t total_time = 0;
         uint64_t total_calls = 0;
-        uint64_t frame_time = 0;
-        uint64_t frame_calls = 0;
         uint64_t last_frame_time = 0;
         uint64_t last_frame_calls = 0;
     };
 
-    struct ScriptClassProfileInfo
-    {
-        String path;
-        HashMap<StringName, ScriptCallProfileInfo> methods;
-    };
-
     struct ScriptCallProfileInfoMap
     {
-        bool enabled = false;
-        HashMap<StringName, ScriptClassProfileInfo> classes;
+        // checked on each script call without lock
+        SafeFlag enabled;
+
+        // [any thread] indexed by the profile id, aggregated in `frame()`
+        jsb::internal::ProfileCounters counters;
+
+        // [mutex_] indexed by the profile id
+        LocalVector<ScriptCallProfileInfo> calls;
+
+        // [mutex_] class => method => profile id
+        HashMap<StringName, HashMap<StringName, uint32_t>> ids;
+
+        // [mutex_] the counters collected in the last frame
+        LocalVector<jsb::internal::ProfileCounters::Value> collected;
     };
 #endif
 
@@ -98,21 +110,62 @@ private:
     uint64_t last_ticks_ = 0;
     std::shared_ptr<jsb::Environment> environment_;
 
+    // requestPhysicsFrame callbacks are driven by the physics_frame signal of the SceneTree (connected lazily)
+    bool physics_frame_connected_ = false;
+
+    // see `Settings::is_server_profile`
+    bool server_profile_ = false;
+
+    // (server profile) the interval of updating the main environment, 0 to update it every frame
+    uint64_t server_tick_usec_ = 0;
+
+    // (server profile) the elapsed time not consumed by ticks yet, and the total time consumed
+    uint64_t server_tick_lag_usec_ = 0;
+    uint64_t server_clock_usec_ = 0;
+
+    // the interval of publishing the metrics snapshot (see `Settings::get_metrics_port`), 0 if disabled
+    uint64_t metrics_interval_usec_ = 0;
+    uint64_t metrics_published_usec_ = 0;
+
     Mutex shadow_mutex_;
     std::vector<ShadowEnvironment> shadow_environments_;
 
+    // the max number of idle shadow environments kept (see `Settings::get_shadow_environment_pool_size`)
+    int shadow_pool_size_ = JSB_MAX_CACHED_SHADOW_ENVIRONMENTS;
+
+#ifdef TOOLS_ENABLED
+    // the background task filling the shadow pool in editor (waited in `finish`)
+    WorkerThreadPool::GroupID shadow_prewarm_group_ = WorkerThreadPool::INVALID_TASK_ID;
+#endif
+
 #if JSB_DEBUG
     GodotJSMonitor* monitor_ = nullptr;
+#endif
+#if JSB_WITH_PROFILING
     ScriptCallProfileInfoMap profile_info_map_;
 #endif
+#if JSB_WITH_SAMPLING_PROFILER
+    // the JS functions sampled in the main environment (only if `sampling_profiler_interval_usec` is set)
+    jsb::SamplingProfiler sampling_profiler_;
+#endif
+
+    // the class declarations scanned from script sources (queried by EditorFileSystem on every scan)
+    mutable jsb::GlobalClassCache global_class_cache_;
 
-    Ref<RegEx> ts_class_name_matcher_;
+    void _on_physics_frame();
 
-    // [JS] export & declare in two lines, matches 'class ClassName extends BaseName' + 'exports.default = ClassName'
-    Ref<RegEx> js_class_name_matcher2_;
+    // (server profile) update the main environment by fixed ticks (it's not updated in the frames shorter than a tick)
+    void _update_fixed_ticks(uint64_t p_elapsed_usec);
 
-    // [JS] export & declare in a single line, matches 'exports.default = class ClassName extends BaseName'
-    Ref<RegEx> js_class_name_matcher1_;
+    // the godot classes exposed to scripts in the previous runs (`record_touched_classes`)
+    static String _get_touched_classes_path();
+    static PackedStringArray _read_touched_classes();
+    void _write_touched_classes() const;
+
+    // the high-water mark of the registries of the main environment (`adaptive_initial_slots`)
+    static String _get_slots_high_water_mark_path();
+    static void _read_slots_high_water_mark(jsb::Environment::CreateParams& r_params);
+    void _write_slots_high_water_mark() const;
 
 public:
     jsb_force_inline static GodotJSScriptLanguage* get_singleton() { return singleton_; }
@@ -130,7 +183,15 @@ public:
 
     void scan_external_changes();
 
-    void add_script_call_profile_info(const String& p_path, const StringName& p_class, const StringName& p_method, uint64_t p_time);
+#if JSB_WITH_PROFILING
+    jsb_force_inline bool is_profiling() const { return profile_info_map_.enabled.is_set(); }
+
+    // the id of the profile counter of a script method (registered on the first call)
+    uint32_t get_script_call_profile_id(const String& p_path, const StringName& p_class, const StringName& p_method);
+
+    // [any thread] lock-free
+    jsb_force_inline void add_script_call_profile_info(uint32_t p_id, uint64_t p_time) { profile_info_map_.counters.add(p_id, p_time); }
+#endif
 
     bool is_global_class_generic(const String &p_path) const;
 
@@ -260,6 +321,14 @@ public:
 private:
     std::shared_ptr<jsb::Environment> create_shadow_environment();
     void destroy_shadow_environment(const std::shared_ptr<jsb::Environment>& p_env);
+
+    // construct and initialize a shadow environment (not registered in the pool)
+    static std::shared_ptr<jsb::Environment> _new_shadow_environment();
+
+#ifdef TOOLS_ENABLED
+    // [WorkerThreadPool] add an idle shadow environment to the pool if it's not full
+    static void _prewarm_shadow_environment(void* p_userdata, uint32_t p_index);
+#endif
 };
 
 #endif
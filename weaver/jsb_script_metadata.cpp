@@ -0,0 +1,84 @@
+#include "jsb_script_metadata.h"
+#include "../internal/jsb_internal.h"
+
+namespace jsb
+{
+    String ScriptMetadataCache::get_packaged_path()
+    {
+        return internal::Settings::get_jsb_out_res_path().path_join("script_classes.json");
+    }
+
+    const ScriptMetadataCache* ScriptMetadataCache::get_packaged()
+    {
+#ifdef TOOLS_ENABLED
+        // the modules are always evaluated in editor (the metadata may be changed at any time)
+        return nullptr;
+#else
+        // loaded once for all scripts (it's immutable after loading)
+        static const std::unique_ptr<ScriptMetadataCache> cache = []
+        {
+            const String path = get_packaged_path();
+            if (!internal::Settings::is_deferred_script_loading() || !FileAccess::exists(path))
+            {
+                return std::unique_ptr<ScriptMetadataCache>();
+            }
+            std::unique_ptr<ScriptMetadataCache> loaded = std::make_unique<ScriptMetadataCache>();
+            if (loaded->parse(FileAccess::get_file_as_string(path)) != OK)
+            {
+                JSB_LOG(Warning, "bad script class metadata %s", path);
+                return std::unique_ptr<ScriptMetadataCache>();
+            }
+            JSB_LOG(Verbose, "script class metadata loaded %s (%d classes)", path, loaded->size());
+            return loaded;
+        }();
+        return cache.get();
+#endif
+    }
+
+    Error ScriptMetadataCache::parse(const String& p_json)
+    {
+        const Ref json = memnew(JSON);
+        if (const Error err = json->parse(p_json); err != OK)
+        {
+            return err;
+        }
+        const Variant data = json->get_data();
+        if (data.get_type() != Variant::DICTIONARY)
+        {
+            return ERR_PARSE_ERROR;
+        }
+
+        // { module_path: [js_class_name, native_class_name, flags] }
+        const Dictionary dict = data;
+        const Array keys = dict.keys();
+        for (int i = 0, n = keys.size(); i < n; ++i)
+        {
+            const Array item = dict[keys[i]];
+            if (item.size() != 3)
+            {
+                return ERR_PARSE_ERROR;
+            }
+            ScriptClassMetadata metadata;
+            metadata.js_class_name = item[0];
+            metadata.native_class_name = item[1];
+            metadata.flags = (ScriptClassFlags::Type) (int) item[2];
+            entries_.insert(keys[i], metadata);
+        }
+        return OK;
+    }
+
+    String ScriptMetadataCache::to_json() const
+    {
+        Dictionary dict;
+        for (const KeyValue<String, ScriptClassMetadata>& it : entries_)
+        {
+            Array item;
+            item.push_back(it.value.js_class_name);
+            item.push_back(it.value.native_class_name);
+            item.push_back((int) it.value.flags);
+            dict[it.key] = item;
+        }
+        return JSON::stringify(dict, "", false);
+    }
+
+}
@@ -0,0 +1,50 @@
+#ifndef GODOTJS_SCRIPT_METADATA_H
+#define GODOTJS_SCRIPT_METADATA_H
+#include "../compat/jsb_compat.h"
+#include "../bridge/jsb_class_info.h"
+
+namespace jsb
+{
+    // the essential info of a script class which is available before the module is evaluated
+    struct ScriptClassMetadata
+    {
+        StringName js_class_name;
+        StringName native_class_name;
+        ScriptClassFlags::Type flags = ScriptClassFlags::None;
+
+        jsb_force_inline bool is_tool() const { return flags & ScriptClassFlags::Tool; }
+        jsb_force_inline bool is_abstract() const { return flags & ScriptClassFlags::Abstract; }
+    };
+
+    /**
+     * The metadata of all script classes collected by the exporter (keyed by the module path).
+     * With `deferred_script_loading` enabled, GodotJSScript answers the queries on class metadata with it,
+     * and the module is not evaluated until it's really used (e.g. instantiated).
+     */
+    class ScriptMetadataCache
+    {
+        HashMap<String, ScriptClassMetadata> entries_;
+
+    public:
+        // the metadata packed in the exported project, null if not available or `deferred_script_loading` is disabled (always null in editor)
+        static const ScriptMetadataCache* get_packaged();
+
+        // the path of the metadata packed in the exported project
+        static String get_packaged_path();
+
+        jsb_force_inline int size() const { return (int) entries_.size(); }
+
+        const ScriptClassMetadata* find(const String& p_module_path) const
+        {
+            const HashMap<String, ScriptClassMetadata>::ConstIterator it = entries_.find(p_module_path);
+            return it != entries_.end() ? &it->value : nullptr;
+        }
+
+        void add(const String& p_module_path, const ScriptClassMetadata& p_metadata) { entries_[p_module_path] = p_metadata; }
+
+        Error parse(const String& p_json);
+        String to_json() const;
+    };
+}
+
+#endif